@@ -0,0 +1,20 @@
+#ifndef DOLAS_BINDLESS_HLSLI
+#define DOLAS_BINDLESS_HLSLI
+
+// 注意：register(t0, space1) 要和 C++ 侧 bindless 根参数（kRootBindlessSrvTable）保持一致
+// 该表从 SRV heap 起始处开始，数组下标即 Texture::GetBindlessIndex()，下标 0 是 null SRV
+// DOLAS_BINDLESS_TEXTURES 由 C++ 侧在 SM5.1 编译时定义；未定义时回退到按槽位绑定的纹理
+#ifndef DOLAS_BINDLESS_TEXTURES
+#define DOLAS_BINDLESS_TEXTURES 0
+#endif
+
+#if DOLAS_BINDLESS_TEXTURES
+Texture2D g_bindless_textures[] : register(t0, space1);
+
+// 材质下标来自 GlobalConstants，对一次 draw 是常量，不需要 NonUniformResourceIndex
+#define DOLAS_BINDLESS_TEXTURE_2D(slot_texture, index) g_bindless_textures[index]
+#else
+#define DOLAS_BINDLESS_TEXTURE_2D(slot_texture, index) slot_texture
+#endif
+
+#endif
@@ -23,7 +23,5 @@ struct PS_OUTPUT
 {
     float4 gbuffer_a : SV_TARGET0;
     float4 gbuffer_b : SV_TARGET1;
-    float4 gbuffer_c : SV_TARGET2;
-    float4 gbuffer_d : SV_TARGET3;
 };
 #endif
\ No newline at end of file
@@ -1,15 +1,13 @@
 #include "blinn_phong/blinn_phong_common.hlsli"
 #include "global_constants.hlsli"
+#include "object_transform.hlsli"
 
 // Basic vertex shader
 VS_OUTPUT VS(VS_INPUT input)
 {
     VS_OUTPUT output = (VS_OUTPUT)0;
-    float4 world_position = mul(float4(input.position, 1.0f), g_WorldMatrix);
-    float4 view_position = mul(world_position, g_ViewMatrix);
-    float4 proj_position = mul(view_position, g_ProjectionMatrix);
-    
-    output.position = proj_position;
+    // 同样在 GBuffer pass 中绘制，与深度预通道共用位置变换
+    output.position = TransformObjectToClip(input.position);
     output.normal = mul(float4(input.normal, 0.0f), g_WorldMatrix).xyz;
     return output;
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef CASCADED_SHADOW_HLSLI
+#define CASCADED_SHADOW_HLSLI
+
+#define MAX_SHADOW_CASCADE_COUNT 4
+
+// 由 RenderPipeline::ShadowDepthPass 渲染：所有 cascade 在同一张深度图集中按 2 列排布，
+// 与 CascadeShadowDesc::GetCascadeAtlasOffset 一致
+Texture2D<float> g_shadow_map : register(t6);
+// 比较采样器（LESS_EQUAL，边界为 1），RHI 以静态采样器提供
+SamplerComparisonState g_shadow_sampler : register(s12);
+
+// cascade_matrices: 世界 -> 各 cascade 的光源裁剪空间; splits: 各 cascade 覆盖的最远视空间深度;
+// atlas: x / y 单个 cascade 占图集的比例, z / w 一个 texel 的 uv 大小; params: x cascade 数量（0 表示关闭阴影）
+float SampleCascadedShadow(float3 world_position, float view_depth,
+    float4x4 cascade_matrices[MAX_SHADOW_CASCADE_COUNT], float4 splits, float4 atlas, float4 params)
+{
+    uint cascade_count = min((uint)params.x, MAX_SHADOW_CASCADE_COUNT);
+    uint cascade_index = 0;
+    [unroll]
+    for (uint i = 0; i < MAX_SHADOW_CASCADE_COUNT; ++i)
+    {
+        cascade_index += (i < cascade_count && view_depth > splits[i]) ? 1 : 0;
+    }
+    if (cascade_index >= cascade_count)
+    {
+        return 1.0f;
+    }
+
+    // 正交投影，w 恒为 1
+    float4 shadow_position = mul(float4(world_position, 1.0f), cascade_matrices[cascade_index]);
+    float2 cascade_uv = float2(shadow_position.x * 0.5f + 0.5f, 0.5f - shadow_position.y * 0.5f);
+    if (any(cascade_uv < 0.0f) || any(cascade_uv > 1.0f) || shadow_position.z > 1.0f)
+    {
+        return 1.0f;
+    }
+
+    // 3x3 PCF 的采样点不能越过当前 cascade 的边界，否则会读到相邻 cascade 的深度
+    float2 cascade_offset = float2(cascade_index % 2, cascade_index / 2) * atlas.xy;
+    float2 atlas_uv = cascade_offset + cascade_uv * atlas.xy;
+    atlas_uv = clamp(atlas_uv, cascade_offset + atlas.zw * 1.5f, cascade_offset + atlas.xy - atlas.zw * 1.5f);
+
+    float shadow = 0.0f;
+    [unroll]
+    for (int y = -1; y <= 1; ++y)
+    {
+        [unroll]
+        for (int x = -1; x <= 1; ++x)
+        {
+            shadow += g_shadow_map.SampleCmpLevelZero(g_shadow_sampler, atlas_uv + float2(x, y) * atlas.zw, shadow_position.z);
+        }
+    }
+    return shadow / 9.0f;
+}
+
+#endif
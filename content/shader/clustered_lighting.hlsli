@@ -0,0 +1,43 @@
+#ifndef CLUSTERED_LIGHTING_HLSLI
+#define CLUSTERED_LIGHTING_HLSLI
+#include "light.hlsli"
+
+// 由 RenderPipeline::DeferredShadingPass 在 CPU 上分配并上传：
+//   t3 光源数组，t4 每个 cluster 在索引表中的 (offset, count)，t5 紧凑的光源索引表
+StructuredBuffer<LocalLightData> g_local_lights : register(t3);
+StructuredBuffer<uint2> g_light_cluster_ranges : register(t4);
+StructuredBuffer<uint> g_light_cluster_indices : register(t5);
+
+// 与 LightClusterGrid::GetClusterIndex 一致。
+// grid: x tiles_x, y tiles_y, z slice_count, w 光源数量; depth_params: x 近平面, y slice scale（slice = log2(depth / near) * scale）
+uint GetLightClusterIndex(float2 screen_uv, float view_depth, float4 grid, float4 depth_params)
+{
+    uint tiles_x = (uint)grid.x;
+    uint tiles_y = (uint)grid.y;
+    uint slice_count = (uint)grid.z;
+
+    uint column = min((uint)max(floor(screen_uv.x * grid.x), 0.0f), tiles_x - 1);
+    uint row = min((uint)max(floor(screen_uv.y * grid.y), 0.0f), tiles_y - 1);
+    float slice = view_depth > depth_params.x ? floor(log2(view_depth / depth_params.x) * depth_params.y) : 0.0f;
+    uint slice_index = min((uint)slice, slice_count - 1);
+    return (slice_index * tiles_y + row) * tiles_x + column;
+}
+
+// screen_uv 以视口左上角为原点，view_depth 为视空间深度（-view_z）
+float3 ClusteredLocalLightShading(SurfaceData surface_data, float3 N, float3 V, float2 screen_uv, float view_depth, float4 grid, float4 depth_params)
+{
+    float3 lighting = float3(0.0f, 0.0f, 0.0f);
+    if (grid.w < 0.5f)
+    {
+        return lighting;
+    }
+
+    uint2 cluster_range = g_light_cluster_ranges[GetLightClusterIndex(screen_uv, view_depth, grid, depth_params)];
+    for (uint i = 0; i < cluster_range.y; ++i)
+    {
+        LocalLightData light = g_local_lights[g_light_cluster_indices[cluster_range.x + i]];
+        lighting += LocalLightShading(surface_data, N, V, light);
+    }
+    return lighting;
+}
+#endif
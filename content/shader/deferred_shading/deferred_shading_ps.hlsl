@@ -2,91 +2,73 @@
 #include "global_constants.hlsli"
 #include "surface_common.hlsli"
 #include "light.hlsli"
+#include "clustered_lighting.hlsli"
+#include "cascaded_shadow.hlsli"
+#include "image_based_lighting.hlsli"
+#include "gbuffer_packing.hlsli"
+#include "dolas_hlsl_support.hlsli"
 
 Texture2D g_gbuffer_a : register(t0);
-SamplerState g_sampler_a : register(s0);
-
 Texture2D g_gbuffer_b : register(t1);
-SamplerState g_sampler_b : register(s1);
-
-Texture2D g_gbuffer_c : register(t2);
-SamplerState g_sampler_c : register(s2);
-
-Texture2D g_gbuffer_d : register(t3);
-SamplerState g_sampler_d : register(s3);
-
-Texture2D g_depth_map : register(t4);
-SamplerState g_depth_map_sampler : register(s4);
-
-struct GBufferData
-{
-    float4 gbuffer_a;
-    float4 gbuffer_b;
-    float4 gbuffer_c;
-    float4 gbuffer_d;
-};
+Texture2D g_depth_map : register(t2);
 
-void DecodeGBufferData(inout GBufferData gbuffer_data, float2 texcoord)
+DOLAS_GLOBAL_CONSTANTS
 {
-    gbuffer_data.gbuffer_a = g_gbuffer_a.Sample(g_sampler_a, texcoord);
-    gbuffer_data.gbuffer_b = g_gbuffer_b.Sample(g_sampler_b, texcoord);
-    gbuffer_data.gbuffer_c = g_gbuffer_c.Sample(g_sampler_c, texcoord);
-    gbuffer_data.gbuffer_d = g_gbuffer_d.Sample(g_sampler_d, texcoord);
+    float4 g_LightClusterGrid;   // x tiles_x, y tiles_y, z slice_count, w 光源数量
+    float4 g_LightClusterDepth;  // x 近平面, y slice scale
+    float4x4 g_ShadowCascadeMatrices[MAX_SHADOW_CASCADE_COUNT];
+    float4 g_ShadowCascadeSplits; // 各 cascade 的远端视空间深度
+    float4 g_ShadowAtlas;         // xy 单个 cascade 占图集的比例, zw texel 的 uv 大小
+    float4 g_ShadowParams;        // x cascade 数量，0 表示关闭阴影
+    float4 g_SkyIrradianceSH[SH_L2_COEFFICIENT_COUNT];
+    float4 g_SkyLightingParams;   // x 为 1 时使用预积分的天空光照，否则为常量环境光
 }
 
-float3 DecodeNormal(float3 normal_positive)
+// GBuffer 与输出同分辨率，逐像素 Load：八面体编码的法线不能做双线性插值
+void DecodeGBufferData(inout SurfaceData surface_data, int2 pixel)
 {
-    return normalize(normal_positive * 2.0f - 1.0f);
-}
+    float4 gbuffer_a = g_gbuffer_a.Load(int3(pixel, 0));
+    float4 gbuffer_b = g_gbuffer_b.Load(int3(pixel, 0));
+    GBufferSurface gbuffer_surface = GBufferUnpack(gbuffer_a, gbuffer_b);
 
-float DecodeShininess(float shininess_positive)
-{
-    return shininess_positive * 255.0f;
-}
-
-void ConvertGBufferToSurfaceData(inout SurfaceData surface_data, in GBufferData gbuffer_data)
-{
-    float shade_mode_float = gbuffer_data.gbuffer_c.w;
-    int shade_mode = DecodeShadeMode(shade_mode_float);
-    surface_data.shade_mode = shade_mode;
+    surface_data.shade_mode = gbuffer_surface.shade_mode;
+    surface_data.world_normal = gbuffer_surface.world_normal;
 
-    if (shade_mode == SHADE_MODE_OPAQUE)
+    if (gbuffer_surface.shade_mode == SHADE_MODE_OPAQUE)
     {
-        surface_data.albedo = gbuffer_data.gbuffer_b.rgb;
-        surface_data.specular = gbuffer_data.gbuffer_d.rgb;
+        surface_data.albedo = gbuffer_surface.albedo;
+        surface_data.specular = gbuffer_surface.specular.xxx;
         surface_data.roughness = 1.0f;
         surface_data.metallic = 0.0f;
-        surface_data.world_position = gbuffer_data.gbuffer_a.xyz;
     }
-    else if (shade_mode == SHADE_MODE_BLINN_PHONG)
+    else if (gbuffer_surface.shade_mode == SHADE_MODE_BLINN_PHONG)
     {
-        surface_data.world_normal = DecodeNormal(gbuffer_data.gbuffer_a.xyz);
-        surface_data.k_a = gbuffer_data.gbuffer_b.rgb;
-        surface_data.k_d = gbuffer_data.gbuffer_c.rgb;
-        surface_data.k_s = gbuffer_data.gbuffer_d.rgb;
-        surface_data.shininess = DecodeShininess(gbuffer_data.gbuffer_d.a);
+        // 紧凑布局不再单独存 k_a，环境光系数取漫反射颜色
+        surface_data.k_a = gbuffer_surface.albedo;
+        surface_data.k_d = gbuffer_surface.albedo;
+        surface_data.k_s = gbuffer_surface.specular.xxx;
+        surface_data.shininess = gbuffer_surface.shininess;
     }
 }
 
-float3 reconstruct_world_position(float2 texcoord, float depth)
+// 纹理坐标 v 轴向下，NDC y 轴向上
+float3 ReconstructWorldPosition(float2 texcoord, float depth)
 {
-    float4 ndc_position = float4(texcoord * 2.0f - 1.0f, depth, 1.0f);
-    float4 world_position = mul(ndc_position, g_ViewMatrix);
-    return world_position.xyz;
+    float4 ndc_position = float4(texcoord.x * 2.0f - 1.0f, 1.0f - texcoord.y * 2.0f, depth, 1.0f);
+    float4 world_position = mul(ndc_position, g_InverseViewProjectionMatrix);
+    return world_position.xyz / world_position.w;
 }
 
 float4 PS(PS_INPUT input) : SV_TARGET0
-{   
-    GBufferData gbuffer_data = (GBufferData)0;
-    DecodeGBufferData(gbuffer_data, input.texcoord);
+{
+    float depth = g_depth_map.Load(int3(input.posH.xy, 0)).x;
 
     SurfaceData surface_data = (SurfaceData)0;
-    ConvertGBufferToSurfaceData(surface_data, gbuffer_data);
+    DecodeGBufferData(surface_data, int2(input.posH.xy));
 
-    float depth = g_depth_map.Sample(g_depth_map_sampler, input.texcoord).x;
-    float3 world_position = reconstruct_world_position(input.texcoord, depth);
+    float3 world_position = ReconstructWorldPosition(input.texcoord, depth);
     surface_data.world_position = world_position;
-    
+
     LightData light_data = (LightData)0;
     light_data.direction = g_LightDirectionIntensity.xyz;
     light_data.intensity = g_LightDirectionIntensity.w;
@@ -97,10 +79,23 @@ float4 PS(PS_INPUT input) : SV_TARGET0
     float3 V = normalize(g_CameraPosition.xyz - world_position);
 
     SurfaceContext surface_context = EvaluateSurfaceContext(N, L, V);
-    
+
     float3 main_light_shading = MainLightShading(surface_data, surface_context, light_data);
-    float3 I_a = float3(0.01f, 0.01f, 0.01f);
-    float3 ambient_lighting = surface_data.k_a * I_a;
-    float3 final_color = main_light_shading + ambient_lighting;
+
+    float view_depth = -mul(float4(world_position, 1.0f), g_ViewMatrix).z;
+    main_light_shading *= SampleCascadedShadow(world_position, view_depth, g_ShadowCascadeMatrices, g_ShadowCascadeSplits, g_ShadowAtlas, g_ShadowParams);
+    float3 local_light_shading = ClusteredLocalLightShading(surface_data, N, V, input.texcoord, view_depth, g_LightClusterGrid, g_LightClusterDepth);
+
+    float3 ambient_lighting;
+    if (g_SkyLightingParams.x > 0.0f)
+    {
+        ambient_lighting = SkyLighting(surface_data, N, V, g_SkyIrradianceSH);
+    }
+    else
+    {
+        float3 I_a = float3(0.01f, 0.01f, 0.01f);
+        ambient_lighting = surface_data.k_a * I_a;
+    }
+    float3 final_color = main_light_shading + local_light_shading + ambient_lighting;
     return float4(final_color, 1.0f);
-}
\ No newline at end of file
+}
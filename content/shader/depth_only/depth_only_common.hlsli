@@ -0,0 +1,17 @@
+#ifndef DOLAS_DEPTH_ONLY_COMMON_HLSLI
+#define DOLAS_DEPTH_ONLY_COMMON_HLSLI
+
+// 只读取位置：各网格的输入布局可以带更多属性，未使用的元素不影响 PSO
+struct VS_INPUT
+{
+    float3 position : POSITION;
+};
+
+struct VS_OUTPUT
+{
+    float4 position : SV_POSITION;
+};
+
+typedef VS_OUTPUT PS_INPUT;
+
+#endif
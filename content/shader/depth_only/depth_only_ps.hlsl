@@ -0,0 +1,6 @@
+#include "depth_only/depth_only_common.hlsli"
+
+// 没有颜色输出，只写深度
+void PS(PS_INPUT input)
+{
+}
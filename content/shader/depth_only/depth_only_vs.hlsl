@@ -0,0 +1,11 @@
+#include "depth_only/depth_only_common.hlsli"
+#include "object_transform.hlsli"
+
+// per-view 常量为当前 cascade 的光源视图与正交投影，或深度预渲染时的相机。
+// 位置变换与 GBuffer 的 VS 共用 TransformObjectToClip，深度逐位相同，GBuffer 才能用 EQUAL 测试
+VS_OUTPUT VS(VS_INPUT input)
+{
+    VS_OUTPUT output = (VS_OUTPUT)0;
+    output.position = TransformObjectToClip(input.position);
+    return output;
+}
@@ -0,0 +1,117 @@
+#ifndef GBUFFER_PACKING_HLSLI
+#define GBUFFER_PACKING_HLSLI
+
+#include "shade_mode.hlsli"
+
+// 紧凑 GBuffer 布局（每像素 8 字节，原来四张 RGBA8 为 16 字节）：
+//   GBuffer A  R10G10B10A2_UNORM  rg: 八面体编码的世界法线  b: 高光强度  a: shade mode（2 bit）
+//   GBuffer B  R8G8B8A8_UNORM     rgb: albedo / 漫反射颜色  a: 高光指数（对数编码）
+// 世界坐标不写入 GBuffer，在 deferred shading 中由深度和逆视图投影矩阵重建。
+//
+// C++ 侧通过 dolas_gbuffer_packing.h 包含本文件做单元测试，这里只能使用两边都支持的写法：
+// 不用 swizzle 和向量运算，向量用 floatN(...) 构造、按分量读写，取整用 floor(x + 0.5f)
+
+#define GBUFFER_SHADE_MODE_MAX 3.0f         // 2 bit alpha 能表示 0..3
+#define GBUFFER_SHININESS_MAX_LOG2 10.0f    // 高光指数范围 [1, 1024]
+
+#if SHADE_MODE_COUNT > 4
+#error "GBuffer A 的 alpha 只有 2 bit，最多容纳 4 种 shade mode"
+#endif
+
+struct GBufferSurface
+{
+    float3 world_normal;
+    float3 albedo;
+    float specular;
+    float shininess;
+    int shade_mode;
+};
+
+struct GBufferPacked
+{
+    float4 gbuffer_a;
+    float4 gbuffer_b;
+};
+
+float GBufferSignNotZero(float value)
+{
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+// 单位向量投影到八面体 |x| + |y| + |z| = 1 上，下半球沿对角线折叠到外侧三角形，结果映射到 [0, 1]^2
+float2 GBufferEncodeNormal(float3 normal)
+{
+    float l1_norm = abs(normal.x) + abs(normal.y) + abs(normal.z);
+    float x = normal.x / l1_norm;
+    float y = normal.y / l1_norm;
+    if (normal.z < 0.0f)
+    {
+        float folded_x = (1.0f - abs(y)) * GBufferSignNotZero(x);
+        float folded_y = (1.0f - abs(x)) * GBufferSignNotZero(y);
+        x = folded_x;
+        y = folded_y;
+    }
+    return float2(x * 0.5f + 0.5f, y * 0.5f + 0.5f);
+}
+
+float3 GBufferDecodeNormal(float2 encoded)
+{
+    float x = encoded.x * 2.0f - 1.0f;
+    float y = encoded.y * 2.0f - 1.0f;
+    float z = 1.0f - abs(x) - abs(y);
+    float t = saturate(-z);
+    x += x >= 0.0f ? -t : t;
+    y += y >= 0.0f ? -t : t;
+    return normalize(float3(x, y, z));
+}
+
+// shade mode 直接存成 k / 3，正好落在 2 bit UNORM 的四个可表示值上
+float GBufferEncodeShadeMode(int shade_mode)
+{
+    return (float)clamp(shade_mode, 0, SHADE_MODE_COUNT - 1) / GBUFFER_SHADE_MODE_MAX;
+}
+
+int GBufferDecodeShadeMode(float encoded)
+{
+    int shade_mode = (int)floor(saturate(encoded) * GBUFFER_SHADE_MODE_MAX + 0.5f);
+    return min(shade_mode, SHADE_MODE_COUNT - 1);
+}
+
+// 对数编码：8 bit 下相邻两档的相对误差约 2.7%，比线性 /255 在低指数段精度高得多，范围也更大
+float GBufferEncodeShininess(float shininess)
+{
+    return saturate(log2(max(shininess, 1.0f)) / GBUFFER_SHININESS_MAX_LOG2);
+}
+
+float GBufferDecodeShininess(float encoded)
+{
+    return exp2(saturate(encoded) * GBUFFER_SHININESS_MAX_LOG2);
+}
+
+// 彩色高光（Blinn-Phong 的 k_s）压成一个标量，按亮度取值
+float GBufferSpecularIntensity(float3 specular_color)
+{
+    return saturate(specular_color.x * 0.2126f + specular_color.y * 0.7152f + specular_color.z * 0.0722f);
+}
+
+GBufferPacked GBufferPack(GBufferSurface surface)
+{
+    float2 encoded_normal = GBufferEncodeNormal(surface.world_normal);
+
+    GBufferPacked packed;
+    packed.gbuffer_a = float4(encoded_normal.x, encoded_normal.y, saturate(surface.specular), GBufferEncodeShadeMode(surface.shade_mode));
+    packed.gbuffer_b = float4(saturate(surface.albedo.x), saturate(surface.albedo.y), saturate(surface.albedo.z), GBufferEncodeShininess(surface.shininess));
+    return packed;
+}
+
+GBufferSurface GBufferUnpack(float4 gbuffer_a, float4 gbuffer_b)
+{
+    GBufferSurface surface;
+    surface.world_normal = GBufferDecodeNormal(float2(gbuffer_a.x, gbuffer_a.y));
+    surface.specular = gbuffer_a.z;
+    surface.shade_mode = GBufferDecodeShadeMode(gbuffer_a.w);
+    surface.albedo = float3(gbuffer_b.x, gbuffer_b.y, gbuffer_b.z);
+    surface.shininess = GBufferDecodeShininess(gbuffer_b.w);
+    return surface;
+}
+#endif
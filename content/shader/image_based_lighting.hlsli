@@ -0,0 +1,59 @@
+#ifndef IMAGE_BASED_LIGHTING_HLSLI
+#define IMAGE_BASED_LIGHTING_HLSLI
+#include "surface_common.hlsli"
+#include "shade_mode.hlsli"
+#include "global_sampler.hlsli"
+
+// 由 TextureManager::CreateImageBasedLighting 在 CPU 上预积分，RenderPipeline::DeferredShadingPass 绑定：
+//   t7 GGX 预过滤的天空立方体（mip i 的粗糙度为 i / (mip 数 - 1)），t8 split sum 的 BRDF LUT（RG: scale, bias）
+TextureCube g_sky_specular_map : register(t7);
+Texture2D<float2> g_brdf_lut : register(t8);
+
+#define SH_L2_COEFFICIENT_COUNT 9
+
+// 与 PackIrradianceSHForShader 一致：系数已乘入基函数常数与 1/π，结果是白色漫反射表面的出射辐射度
+float3 EvaluateSkyIrradianceSH(float3 n, float4 sh[SH_L2_COEFFICIENT_COUNT])
+{
+    float3 result = sh[0].rgb;
+    result += sh[1].rgb * n.y;
+    result += sh[2].rgb * n.z;
+    result += sh[3].rgb * n.x;
+    result += sh[4].rgb * (n.x * n.y);
+    result += sh[5].rgb * (n.y * n.z);
+    result += sh[6].rgb * (3.0f * n.z * n.z - 1.0f);
+    result += sh[7].rgb * (n.x * n.z);
+    result += sh[8].rgb * (n.x * n.x - n.y * n.y);
+    // L2 截断在高对比的天空下可能出现小的负值
+    return max(result, 0.0f);
+}
+
+// split sum：prefiltered(R, roughness) * (F0 * scale + bias)
+float3 SkySpecularLighting(float3 N, float3 V, float3 F0, float roughness)
+{
+    uint width, height, mip_count;
+    g_sky_specular_map.GetDimensions(0, width, height, mip_count);
+    float lod = roughness * (max(mip_count, 1) - 1);
+
+    float NoV = saturate(dot(N, V));
+    float3 R = reflect(-V, N);
+    float2 env_brdf = g_brdf_lut.SampleLevel(g_linear_sampler, float2(NoV, roughness), 0.0f);
+    return g_sky_specular_map.SampleLevel(g_linear_sampler, R, lod).rgb * (F0 * env_brdf.x + env_brdf.y);
+}
+
+float3 SkyLighting(SurfaceData surface_data, float3 N, float3 V, float4 sh[SH_L2_COEFFICIENT_COUNT])
+{
+    if (surface_data.shade_mode == SHADE_MODE_OPAQUE)
+    {
+        // 非金属的 F0 = 0.08 * specular（specular 默认 0.5 时为 0.04）
+        float3 F0 = lerp(0.08f * surface_data.specular, surface_data.albedo, surface_data.metallic);
+        float3 diffuse = surface_data.albedo * (1.0f - surface_data.metallic) * EvaluateSkyIrradianceSH(N, sh);
+        return diffuse + SkySpecularLighting(N, V, F0, surface_data.roughness);
+    }
+    else if (surface_data.shade_mode == SHADE_MODE_BLINN_PHONG)
+    {
+        // Blinn-Phong 没有粗糙度，只接收漫反射的天空光
+        return surface_data.k_a * EvaluateSkyIrradianceSH(N, sh);
+    }
+    return float3(0.0f, 0.0f, 0.0f);
+}
+#endif
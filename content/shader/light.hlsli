@@ -11,6 +11,18 @@ struct LightData
     float3 color;
 };
 
+// 局部光源，布局与 C++ 侧 LocalLightData（dolas_rhi_common.h）一致
+#define LOCAL_LIGHT_TYPE_POINT 0
+#define LOCAL_LIGHT_TYPE_SPOT 1
+
+struct LocalLightData
+{
+    float4 position_range;      // xyz: 世界坐标, w: 作用范围
+    float4 color_type;          // rgb: 颜色 * 强度, w: 光源类型
+    float4 direction;           // xyz: 聚光朝向
+    float4 spot_scale_offset;   // 锥形衰减 saturate(cos * x + y)，点光为 (0, 1)
+};
+
 struct LightAccumulation
 {
     float3 diffuse;
@@ -57,4 +69,31 @@ float3 MainLightShading(SurfaceData surface_data, SurfaceContext surface_context
     LightAccumulation light_accumulation = EvaluateBxDF(surface_data, surface_context);
     return light_accumulation.diffuse * light_data.color * light_data.intensity + light_accumulation.specular * light_data.color * light_data.intensity;
 }
+
+// 平方反比衰减，乘以窗口函数使其在 range 处平滑降到 0（与 CPU 侧用 range 划分 cluster 保持一致）
+float LocalLightDistanceAttenuation(float distance_squared, float range)
+{
+    float ratio = distance_squared / (range * range);
+    float window = saturate(1.0f - ratio * ratio);
+    return window * window / max(distance_squared, 0.0001f);
+}
+
+float3 LocalLightShading(SurfaceData surface_data, float3 N, float3 V, LocalLightData light)
+{
+    float3 to_light = light.position_range.xyz - surface_data.world_position;
+    float distance_squared = dot(to_light, to_light);
+    float range = light.position_range.w;
+    if (distance_squared >= range * range)
+    {
+        return float3(0.0f, 0.0f, 0.0f);
+    }
+
+    float3 L = to_light * rsqrt(max(distance_squared, 1e-8f));
+    float spot_attenuation = saturate(dot(-L, light.direction.xyz) * light.spot_scale_offset.x + light.spot_scale_offset.y);
+    float attenuation = LocalLightDistanceAttenuation(distance_squared, range) * spot_attenuation * spot_attenuation;
+
+    SurfaceContext surface_context = EvaluateSurfaceContext(N, L, V);
+    LightAccumulation light_accumulation = EvaluateBxDF(surface_data, surface_context);
+    return (light_accumulation.diffuse + light_accumulation.specular) * light.color_type.rgb * attenuation;
+}
 #endif
\ No newline at end of file
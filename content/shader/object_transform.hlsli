@@ -0,0 +1,17 @@
+#ifndef OBJECT_TRANSFORM_HLSLI
+#define OBJECT_TRANSFORM_HLSLI
+
+#include "global_constants.hlsli"
+
+// 物体空间位置 -> 裁剪空间，深度预通道（depth_only_vs）与 GBuffer（opaque_vs）共用。
+// GBuffer 在预通道之后用 EQUAL 深度测试，两个分别编译的 VS 必须得到逐位相同的 SV_Position：
+// precise 禁止编译器对这段运算重排或合并成 mad，两边又是同一份代码，结果不会因各自的优化而不同
+float4 TransformObjectToClip(float3 object_position)
+{
+    precise float4 world_position = mul(float4(object_position, 1.0f), g_WorldMatrix);
+    precise float4 view_position = mul(world_position, g_ViewMatrix);
+    precise float4 clip_position = mul(view_position, g_ProjectionMatrix);
+    return clip_position;
+}
+
+#endif // OBJECT_TRANSFORM_HLSLI
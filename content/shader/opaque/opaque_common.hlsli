@@ -23,10 +23,8 @@ typedef VS_OUTPUT PS_INPUT;
 
 struct PS_OUTPUT
 {
-    float4 gbuffer_a : SV_TARGET0; // Normal
-    float4 gbuffer_b : SV_TARGET1; // Albedo / Ambient
-    float4 gbuffer_c : SV_TARGET2; // Diffuse / ShadeMode
-    float4 gbuffer_d : SV_TARGET3; // Specular / Shininess
+    float4 gbuffer_a : SV_TARGET0; // Octahedral Normal / Specular / ShadeMode
+    float4 gbuffer_b : SV_TARGET1; // Albedo / Shininess
 };
 
 #endif
\ No newline at end of file
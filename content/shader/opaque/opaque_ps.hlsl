@@ -1,7 +1,11 @@
 #include "opaque/opaque_common.hlsli"
 #include "global_constants.hlsli"
-#include "shade_mode.hlsli"
+#include "gbuffer_packing.hlsli"
 #include "dolas_hlsl_support.hlsli"
+#include "bindless.hlsli"
+
+// 材质通过 "shader_keywords": ["NORMAL_MAP"] 启用法线贴图，没有法线贴图的材质直接使用顶点法线
+// #pragma dolas_keywords _ NORMAL_MAP
 
 // 定义材质参数（根据你的 MaterialManager，slot 0 是 albedo，slot 1 是 normal）
 Texture2D g_albedo_map : register(t0);
@@ -14,34 +18,39 @@ DOLAS_GLOBAL_CONSTANTS
     float4 k_a;             // 材质环境光颜色
     float4 k_d;             // 材质漫反射颜色
     float4 k_s_shininess;   // rgb: 镜面反射, a: 高光指数
-}
-
-float3 EncodeNormal(float3 n)
-{
-    return n * 0.5f + 0.5f;
+    uint albedo_map_index;  // bindless 纹理下标（由 MaterialManager 写入）
+    uint normal_map_index;
 }
 
 PS_OUTPUT PS(PS_INPUT input)
 {
     float3 N = normalize(input.world_normal);
+#if defined(NORMAL_MAP)
     float3 T = normalize(input.world_tangent);
     float3 B = normalize(input.world_bitangent);
     float3x3 TBN = float3x3(T, B, N);
 
-    float3 tangent_normal = g_normal_map.Sample(g_sampler, input.texcoord).rgb * 2.0f - 1.0f;
+    // 只使用 XY 重建 Z：烘焙后的法线贴图为 BC5（B 通道为 0），未烘焙的 PNG 结果相同
+    float3 tangent_normal;
+    tangent_normal.xy = DOLAS_BINDLESS_TEXTURE_2D(g_normal_map, normal_map_index).Sample(g_sampler, input.texcoord).rg * 2.0f - 1.0f;
+    tangent_normal.z = sqrt(saturate(1.0f - dot(tangent_normal.xy, tangent_normal.xy)));
     float3 world_normal = normalize(mul(tangent_normal, TBN));
+#else
+    float3 world_normal = N;
+#endif
 
-    PS_OUTPUT output = (PS_OUTPUT)0;
-    
-    output.gbuffer_a = float4(EncodeNormal(world_normal), 1.0f);
-    
-    float4 albedo = g_albedo_map.Sample(g_sampler, input.texcoord);
-    output.gbuffer_b = float4(albedo.rgb, 1.0f);
-    
-    float shade_mode_float = EncodeShadeMode(SHADE_MODE_OPAQUE);
-    output.gbuffer_c = float4(1.0f, 1.0f, 1.0f, shade_mode_float);
-    
-    output.gbuffer_d = float4(1.0f, 1.0f, 1.0f, 1.0f);
+    float4 albedo = DOLAS_BINDLESS_TEXTURE_2D(g_albedo_map, albedo_map_index).Sample(g_sampler, input.texcoord);
+
+    GBufferSurface surface = (GBufferSurface)0;
+    surface.world_normal = world_normal;
+    surface.albedo = albedo.rgb;
+    surface.specular = 1.0f;
+    surface.shininess = 1.0f;
+    surface.shade_mode = SHADE_MODE_OPAQUE;
+    GBufferPacked packed = GBufferPack(surface);
 
+    PS_OUTPUT output = (PS_OUTPUT)0;
+    output.gbuffer_a = packed.gbuffer_a;
+    output.gbuffer_b = packed.gbuffer_b;
     return output;
-}
\ No newline at end of file
+}
@@ -1,14 +1,13 @@
 #include "opaque/opaque_common.hlsli"
 #include "global_constants.hlsli"
+#include "object_transform.hlsli"
 
 VS_OUTPUT VS(VS_INPUT input)
 {
     VS_OUTPUT output = (VS_OUTPUT)0;
 
-    // 1. 变换顶点位置到裁切空间
-    float4 world_pos = mul(float4(input.position, 1.0f), g_WorldMatrix);
-    float4 view_pos  = mul(world_pos, g_ViewMatrix);
-    output.position  = mul(view_pos, g_ProjectionMatrix);
+    // 1. 变换顶点位置到裁切空间（与深度预通道共用，保证 EQUAL 深度测试逐位一致）
+    output.position = TransformObjectToClip(input.position);
 
     // 2. 传递纹理坐标
     output.texcoord = input.texcoord;
@@ -20,7 +20,6 @@ struct PS_OUTPUT
 {
     float4 gbuffer_a : SV_TARGET0;
     float4 gbuffer_b : SV_TARGET1;
-    float4 gbuffer_c : SV_TARGET2;
 };
 
 #endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "plain_color/plain_color_common.hlsli"
 #include "global_constants.hlsli"
 #include "dolas_hlsl_support.hlsli"
+#include "gbuffer_packing.hlsli"
 DOLAS_GLOBAL_CONSTANTS
 {
     float4 g_PlainColor;
@@ -8,9 +9,17 @@ DOLAS_GLOBAL_CONSTANTS
 // Simple color output
 PS_OUTPUT PS(PS_INPUT input)
 {
+    // 没有顶点法线，按不受光照角度影响的 opaque 模式输出纯色
+    GBufferSurface surface = (GBufferSurface)0;
+    surface.world_normal = float3(0.0f, 0.0f, 1.0f);
+    surface.albedo = g_PlainColor.rgb;
+    surface.specular = 0.0f;
+    surface.shininess = 1.0f;
+    surface.shade_mode = SHADE_MODE_OPAQUE;
+    GBufferPacked packed = GBufferPack(surface);
+
     PS_OUTPUT output = (PS_OUTPUT)0;
-    output.gbuffer_a = float4(1.0, 1.0, 1.0, 1.0);
-    output.gbuffer_b = g_PlainColor;
-    output.gbuffer_c = float4(0.8f, 0.5f, 1.0f, 0.5f);
+    output.gbuffer_a = packed.gbuffer_a;
+    output.gbuffer_b = packed.gbuffer_b;
     return output;
 }
\ No newline at end of file
@@ -1,19 +1,15 @@
 #ifndef DOLAS_SKY_BOX_COMMON_HLSLI
 #define DOLAS_SKY_BOX_COMMON_HLSLI
-struct VS_INPUT
-{
-    float3 posL : POSITION;
-};
-
+// 全屏三角形没有顶点输入，VS 只输出 NDC 坐标，PS 据此重建视线方向
 struct VS_OUTPUT
 {
     float4 posH : SV_POSITION;
-    float3 posL : TEXCOORD0;
+    float2 ndc : TEXCOORD0;
 };
 
 struct PS_INPUT
 {
     float4 posH : SV_POSITION;
-    float3 posL : TEXCOORD0;
+    float2 ndc : TEXCOORD0;
 };
 #endif
\ No newline at end of file
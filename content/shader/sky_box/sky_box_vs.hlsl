@@ -1,16 +1,13 @@
 // 参考 deferred_shading_vs.hlsl
 #include "global_constants.hlsli"
 #include "sky_box/sky_box_common.hlsli"
-// Basic vertex shader
-VS_OUTPUT VS(VS_INPUT input)
+// 全屏三角形：不绑定顶点缓冲，由 SV_VertexID 生成 (-1, 1), (3, 1), (-1, -3) 三个顶点覆盖整个视口，
+// 深度测试关闭，只在模板中标记为天空的像素上执行 PS
+VS_OUTPUT VS(uint vertex_id : SV_VertexID)
 {
     VS_OUTPUT output = (VS_OUTPUT)0;
-    float4 local_position = float4(input.posL, 1.0f);
-    float4 world_position = mul(local_position, g_WorldMatrix);
-    float4 view_position = mul(world_position, g_ViewMatrix);
-    float4 proj_position = mul(view_position, g_ProjectionMatrix);
-    
-    output.posH = proj_position;
-    output.posL = input.posL;
+    float2 uv = float2((vertex_id << 1) & 2, vertex_id & 2);
+    output.ndc = float2(uv.x * 2.0f - 1.0f, 1.0f - uv.y * 2.0f);
+    output.posH = float4(output.ndc, 1.0f, 1.0f);
     return output;
-}
\ No newline at end of file
+}
@@ -1,5 +1,6 @@
 #include "solid/solid_common.hlsli"
 #include "global_constants.hlsli"
+#include "gbuffer_packing.hlsli"
 
 Texture2D base_color_map : register(t0);
 SamplerState base_color_map_sampler : register(s0);
@@ -7,10 +8,18 @@ SamplerState base_color_map_sampler : register(s0);
 // Simple color output
 PS_OUTPUT PS(PS_INPUT input)
 {   
-    PS_OUTPUT output = (PS_OUTPUT)0;
-    output.gbuffer_a = float4(1.0, 1.0, 1.0, 1.0);
     float4 base_color = base_color_map.Sample(base_color_map_sampler, input.texcoord);
-    output.gbuffer_b = base_color;
-    output.gbuffer_c = float4(0.8f, 0.5f, 1.0f, 0.5f);
+
+    GBufferSurface surface = (GBufferSurface)0;
+    surface.world_normal = normalize(input.normal);
+    surface.albedo = base_color.rgb;
+    surface.specular = 0.0f;
+    surface.shininess = 1.0f;
+    surface.shade_mode = SHADE_MODE_BLINN_PHONG;
+    GBufferPacked packed = GBufferPack(surface);
+
+    PS_OUTPUT output = (PS_OUTPUT)0;
+    output.gbuffer_a = packed.gbuffer_a;
+    output.gbuffer_b = packed.gbuffer_b;
     return output;
-}
\ No newline at end of file
+}
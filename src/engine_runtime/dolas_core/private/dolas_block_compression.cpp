@@ -0,0 +1,1113 @@
+#include "dolas_block_compression.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define DOLAS_BLOCK_COMPRESSION_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DOLAS_BLOCK_COMPRESSION_SSE 1
+#endif
+
+namespace Dolas
+{
+	namespace
+	{
+#if defined(DOLAS_BLOCK_COMPRESSION_AVX) || defined(DOLAS_BLOCK_COMPRESSION_SSE)
+		constexpr Bool kHasSimd = true;
+#else
+		constexpr Bool kHasSimd = false;
+#endif
+
+		// 端点拟合之后再做几轮最小二乘修正（每轮都按量化后的真实误差保留最好的结果）
+		constexpr UInt kRefineIterations = 2;
+		// BC6H / BC7 4 位下标的插值权重（总和 64）
+		constexpr UInt kWeights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+		// BC6H 半精度位模式的上限（65504）
+		constexpr Float kMaxHalfBits = 31743.0f;
+
+		// 一个块的纹素，按通道分开保存（SoA），SIMD 一次处理相邻的 4/8 个纹素
+		struct BlockTexels
+		{
+			Float channels[4][BLOCK_TEXEL_COUNT] = {};
+		};
+
+		inline Float Saturate(Float value, Float max_value)
+		{
+			// NaN 也落到 0
+			return value > 0.0f ? (value < max_value ? value : max_value) : 0.0f;
+		}
+
+		inline UInt RoundToUInt(Float value, Float max_value)
+		{
+			return static_cast<UInt>(Saturate(value, max_value) + 0.5f);
+		}
+
+		// 纹素投影到直线 origin + t * axis 上的参数 t = dot(p - origin, axis)。SIMD 与标量使用相同的运算顺序
+		template <Bool kSimd>
+		void ProjectTexels(const BlockTexels& block, const Float* origin, const Float* axis, Float* out_t)
+		{
+#if defined(DOLAS_BLOCK_COMPRESSION_AVX)
+			if constexpr (kSimd)
+			{
+				for (UInt i = 0; i < BLOCK_TEXEL_COUNT; i += 8)
+				{
+					__m256 t = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(block.channels[0] + i), _mm256_set1_ps(origin[0])), _mm256_set1_ps(axis[0]));
+					for (UInt c = 1; c < 4; ++c)
+					{
+						t = _mm256_add_ps(t, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(block.channels[c] + i), _mm256_set1_ps(origin[c])), _mm256_set1_ps(axis[c])));
+					}
+					_mm256_storeu_ps(out_t + i, t);
+				}
+				return;
+			}
+#elif defined(DOLAS_BLOCK_COMPRESSION_SSE)
+			if constexpr (kSimd)
+			{
+				for (UInt i = 0; i < BLOCK_TEXEL_COUNT; i += 4)
+				{
+					__m128 t = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(block.channels[0] + i), _mm_set1_ps(origin[0])), _mm_set1_ps(axis[0]));
+					for (UInt c = 1; c < 4; ++c)
+					{
+						t = _mm_add_ps(t, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(block.channels[c] + i), _mm_set1_ps(origin[c])), _mm_set1_ps(axis[c])));
+					}
+					_mm_storeu_ps(out_t + i, t);
+				}
+				return;
+			}
+#endif
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				Float t = (block.channels[0][i] - origin[0]) * axis[0];
+				for (UInt c = 1; c < 4; ++c)
+				{
+					t = t + (block.channels[c][i] - origin[c]) * axis[c];
+				}
+				out_t[i] = t;
+			}
+		}
+
+		// 投影并量化为 [0, max_index] 的下标：index = (UInt)(clamp(t, 0, max_index) + 0.5)
+		template <Bool kSimd>
+		void QuantizeTexels(const BlockTexels& block, const Float* origin, const Float* axis, Float max_index, UInt* out_index)
+		{
+			Float t[BLOCK_TEXEL_COUNT];
+			ProjectTexels<kSimd>(block, origin, axis, t);
+#if defined(DOLAS_BLOCK_COMPRESSION_AVX)
+			if constexpr (kSimd)
+			{
+				for (UInt i = 0; i < BLOCK_TEXEL_COUNT; i += 8)
+				{
+					__m256 value = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(t + i), _mm256_setzero_ps()), _mm256_set1_ps(max_index));
+					value = _mm256_add_ps(value, _mm256_set1_ps(0.5f));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out_index + i), _mm256_cvttps_epi32(value));
+				}
+				return;
+			}
+#elif defined(DOLAS_BLOCK_COMPRESSION_SSE)
+			if constexpr (kSimd)
+			{
+				for (UInt i = 0; i < BLOCK_TEXEL_COUNT; i += 4)
+				{
+					__m128 value = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(t + i), _mm_setzero_ps()), _mm_set1_ps(max_index));
+					value = _mm_add_ps(value, _mm_set1_ps(0.5f));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out_index + i), _mm_cvttps_epi32(value));
+				}
+				return;
+			}
+#endif
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				const Float value = std::min(std::max(t[i], 0.0f), max_index);
+				out_index[i] = static_cast<UInt>(value + 0.5f);
+			}
+		}
+
+		// 前 channel_count 个通道的主成分方向（幂迭代，固定次数保证结果确定）
+		void ComputePrincipalAxis(const BlockTexels& block, UInt channel_count, Float* out_mean, Float* out_axis)
+		{
+			Float mean[4] = {};
+			for (UInt c = 0; c < channel_count; ++c)
+			{
+				for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+				{
+					mean[c] += block.channels[c][i];
+				}
+				mean[c] /= BLOCK_TEXEL_COUNT;
+			}
+
+			Float covariance[4][4] = {};
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				for (UInt a = 0; a < channel_count; ++a)
+				{
+					for (UInt b = 0; b < channel_count; ++b)
+					{
+						covariance[a][b] += (block.channels[a][i] - mean[a]) * (block.channels[b][i] - mean[b]);
+					}
+				}
+			}
+
+			// 以方差最大的通道所在的列作为初值，(1, 1, 1) 会与负相关的通道（如红绿渐变）正交
+			UInt largest = 0;
+			for (UInt c = 1; c < channel_count; ++c)
+			{
+				if (covariance[c][c] > covariance[largest][largest])
+				{
+					largest = c;
+				}
+			}
+			Float axis[4] = {};
+			for (UInt c = 0; c < channel_count; ++c)
+			{
+				axis[c] = covariance[c][largest];
+			}
+			for (UInt iteration = 0; iteration < 8; ++iteration)
+			{
+				Float next[4] = {};
+				Float max_component = 0.0f;
+				for (UInt a = 0; a < channel_count; ++a)
+				{
+					for (UInt b = 0; b < channel_count; ++b)
+					{
+						next[a] += covariance[a][b] * axis[b];
+					}
+					max_component = std::max(max_component, std::fabs(next[a]));
+				}
+				if (max_component <= 0.0f)
+				{
+					break;
+				}
+				for (UInt c = 0; c < channel_count; ++c)
+				{
+					axis[c] = next[c] / max_component;
+				}
+			}
+
+			Float length_squared = 0.0f;
+			for (UInt c = 0; c < channel_count; ++c)
+			{
+				length_squared += axis[c] * axis[c];
+			}
+			for (UInt c = 0; c < 4; ++c)
+			{
+				out_mean[c] = mean[c];
+				if (c >= channel_count)
+				{
+					out_axis[c] = 0.0f;
+				}
+				else if (length_squared > 1.0e-20f)
+				{
+					out_axis[c] = axis[c] / std::sqrt(length_squared);
+				}
+				else
+				{
+					// 纯色块
+					out_axis[c] = 1.0f / std::sqrt(static_cast<Float>(channel_count));
+				}
+			}
+		}
+
+		// 沿主成分方向取投影的最小 / 最大值作为初始端点，截断到 [0, max_value]
+		template <Bool kSimd>
+		void FitEndpoints(const BlockTexels& block, UInt channel_count, Float max_value, Float* out_endpoint0, Float* out_endpoint1)
+		{
+			Float mean[4];
+			Float axis[4];
+			ComputePrincipalAxis(block, channel_count, mean, axis);
+
+			Float t[BLOCK_TEXEL_COUNT];
+			ProjectTexels<kSimd>(block, mean, axis, t);
+			Float t_min = t[0];
+			Float t_max = t[0];
+			for (UInt i = 1; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				t_min = std::min(t_min, t[i]);
+				t_max = std::max(t_max, t[i]);
+			}
+			for (UInt c = 0; c < 4; ++c)
+			{
+				out_endpoint0[c] = c < channel_count ? Saturate(mean[c] + axis[c] * t_min, max_value) : 0.0f;
+				out_endpoint1[c] = c < channel_count ? Saturate(mean[c] + axis[c] * t_max, max_value) : 0.0f;
+			}
+		}
+
+		// 固定每个纹素的插值权重 weights[i]（0 为 endpoint0，1 为 endpoint1），求平方误差最小的两个端点；
+		// 所有权重相同时无解，返回 false
+		Bool SolveEndpoints(const BlockTexels& block, UInt channel_count, const Float* weights, Float max_value, Float* out_endpoint0, Float* out_endpoint1)
+		{
+			Float aa = 0.0f;
+			Float bb = 0.0f;
+			Float ab = 0.0f;
+			Float ax[4] = {};
+			Float bx[4] = {};
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				const Float b = weights[i];
+				const Float a = 1.0f - b;
+				aa += a * a;
+				bb += b * b;
+				ab += a * b;
+				for (UInt c = 0; c < channel_count; ++c)
+				{
+					ax[c] += a * block.channels[c][i];
+					bx[c] += b * block.channels[c][i];
+				}
+			}
+			const Float determinant = aa * bb - ab * ab;
+			if (std::fabs(determinant) < 1.0e-6f)
+			{
+				return false;
+			}
+			for (UInt c = 0; c < 4; ++c)
+			{
+				out_endpoint0[c] = c < channel_count ? Saturate((ax[c] * bb - bx[c] * ab) / determinant, max_value) : 0.0f;
+				out_endpoint1[c] = c < channel_count ? Saturate((bx[c] * aa - ax[c] * ab) / determinant, max_value) : 0.0f;
+			}
+			return true;
+		}
+
+		// 按调色板 palette[index] 计算的平方误差
+		Float ComputePaletteError(const BlockTexels& block, UInt channel_count, const Float (*palette)[4], const UInt* indices)
+		{
+			Float error = 0.0f;
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				for (UInt c = 0; c < channel_count; ++c)
+				{
+					const Float difference = block.channels[c][i] - palette[indices[i]][c];
+					error += difference * difference;
+				}
+			}
+			return error;
+		}
+
+		// 调色板不是严格等距时（BC6H / BC7 的权重经过取整），投影量化得到的下标再与相邻的两个比较
+		void RefineIndices(const BlockTexels& block, UInt channel_count, const Float (*palette)[4], UInt max_index, UInt* indices)
+		{
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				const UInt first = indices[i] > 0 ? indices[i] - 1 : 0;
+				const UInt last = std::min(indices[i] + 1, max_index);
+				Float best_error = std::numeric_limits<Float>::max();
+				for (UInt index = first; index <= last; ++index)
+				{
+					Float error = 0.0f;
+					for (UInt c = 0; c < channel_count; ++c)
+					{
+						const Float difference = block.channels[c][i] - palette[index][c];
+						error += difference * difference;
+					}
+					if (error < best_error)
+					{
+						best_error = error;
+						indices[i] = index;
+					}
+				}
+			}
+		}
+
+		// 把纹素投影到两个量化后的端点之间并量化为 [0, max_index] 的下标
+		template <Bool kSimd>
+		void ComputeIndices(const BlockTexels& block, UInt channel_count, const Float* endpoint0, const Float* endpoint1, UInt max_index, UInt* out_indices)
+		{
+			Float direction[4] = {};
+			Float length_squared = 0.0f;
+			for (UInt c = 0; c < channel_count; ++c)
+			{
+				direction[c] = endpoint1[c] - endpoint0[c];
+				length_squared += direction[c] * direction[c];
+			}
+			if (length_squared <= 0.0f)
+			{
+				std::fill(out_indices, out_indices + BLOCK_TEXEL_COUNT, 0u);
+				return;
+			}
+			Float axis[4] = {};
+			for (UInt c = 0; c < channel_count; ++c)
+			{
+				axis[c] = direction[c] * (static_cast<Float>(max_index) / length_squared);
+			}
+			QuantizeTexels<kSimd>(block, endpoint0, axis, static_cast<Float>(max_index), out_indices);
+		}
+
+		void IndexWeights(const UInt* indices, Float max_index, Float* out_weights)
+		{
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				out_weights[i] = indices[i] / max_index;
+			}
+		}
+
+		void Weights4(const UInt* indices, Float* out_weights)
+		{
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				out_weights[i] = kWeights4[indices[i]] / 64.0f;
+			}
+		}
+
+		class BlockBitWriter
+		{
+		public:
+			BlockBitWriter(UByte* block, UInt byte_count)
+				: m_block(block)
+			{
+				std::memset(block, 0, byte_count);
+			}
+
+			// 低位在前
+			void Write(UInt value, UInt bit_count)
+			{
+				while (bit_count > 0)
+				{
+					const UInt bit_offset = m_position & 7u;
+					const UInt written = std::min(bit_count, 8u - bit_offset);
+					m_block[m_position >> 3] |= static_cast<UByte>((value & ((1u << written) - 1u)) << bit_offset);
+					value >>= written;
+					bit_count -= written;
+					m_position += written;
+				}
+			}
+
+		private:
+			UByte* m_block = nullptr;
+			UInt m_position = 0;
+		};
+
+		class BlockBitReader
+		{
+		public:
+			explicit BlockBitReader(const UByte* block)
+				: m_block(block)
+			{
+			}
+
+			UInt Read(UInt bit_count)
+			{
+				UInt value = 0;
+				for (UInt bit = 0; bit < bit_count; ++bit, ++m_position)
+				{
+					value |= ((m_block[m_position >> 3] >> (m_position & 7u)) & 1u) << bit;
+				}
+				return value;
+			}
+
+		private:
+			const UByte* m_block = nullptr;
+			UInt m_position = 0;
+		};
+
+		// ---------------- BC1 ----------------
+
+		UInt QuantizeColor565(const Float* color)
+		{
+			return (RoundToUInt(color[0] * (31.0f / 255.0f), 31.0f) << 11) |
+				(RoundToUInt(color[1] * (63.0f / 255.0f), 63.0f) << 5) |
+				RoundToUInt(color[2] * (31.0f / 255.0f), 31.0f);
+		}
+
+		void ExpandColor565(UInt color, Float* out_color)
+		{
+			const UInt r = (color >> 11) & 31u;
+			const UInt g = (color >> 5) & 63u;
+			const UInt b = color & 31u;
+			out_color[0] = static_cast<Float>((r << 3) | (r >> 2));
+			out_color[1] = static_cast<Float>((g << 2) | (g >> 4));
+			out_color[2] = static_cast<Float>((b << 3) | (b >> 2));
+			out_color[3] = 0.0f;
+		}
+
+		// block 的 RGB 为 [0, 255]；总是 4 色模式（color0 >= color1 时 BC3 也按 4 色解码）
+		template <Bool kSimd>
+		void EncodeColorBlock(const BlockTexels& block, UByte* out_block)
+		{
+			// 沿端点方向的顺序 k 到 BC1 下标：0 为 color0，1 为 color1，2 / 3 为 1/3、2/3 处
+			constexpr UInt kOrderedToIndex[4] = { 0, 2, 3, 1 };
+
+			Float endpoint0[4];
+			Float endpoint1[4];
+			FitEndpoints<kSimd>(block, 3, 255.0f, endpoint0, endpoint1);
+
+			Float best_error = std::numeric_limits<Float>::max();
+			UInt best_colors[2] = {};
+			UInt best_ordered[BLOCK_TEXEL_COUNT] = {};
+			for (UInt iteration = 0; iteration <= kRefineIterations; ++iteration)
+			{
+				UInt color0 = QuantizeColor565(endpoint0);
+				UInt color1 = QuantizeColor565(endpoint1);
+				if (color0 < color1)
+				{
+					std::swap(color0, color1);
+				}
+
+				Float palette[4][4];
+				ExpandColor565(color0, palette[0]);
+				ExpandColor565(color1, palette[3]);
+				for (UInt c = 0; c < 4; ++c)
+				{
+					palette[1][c] = (2.0f * palette[0][c] + palette[3][c]) / 3.0f;
+					palette[2][c] = (palette[0][c] + 2.0f * palette[3][c]) / 3.0f;
+				}
+
+				UInt ordered[BLOCK_TEXEL_COUNT];
+				ComputeIndices<kSimd>(block, 3, palette[0], palette[3], 3, ordered);
+				const Float error = ComputePaletteError(block, 3, palette, ordered);
+				if (error < best_error)
+				{
+					best_error = error;
+					best_colors[0] = color0;
+					best_colors[1] = color1;
+					std::copy(ordered, ordered + BLOCK_TEXEL_COUNT, best_ordered);
+				}
+				if (best_error <= 0.0f || iteration == kRefineIterations)
+				{
+					break;
+				}
+
+				Float weights[BLOCK_TEXEL_COUNT];
+				IndexWeights(ordered, 3.0f, weights);
+				if (!SolveEndpoints(block, 3, weights, 255.0f, endpoint0, endpoint1))
+				{
+					break;
+				}
+			}
+
+			BlockBitWriter writer(out_block, 8);
+			writer.Write(best_colors[0], 16);
+			writer.Write(best_colors[1], 16);
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				writer.Write(kOrderedToIndex[best_ordered[i]], 2);
+			}
+		}
+
+		// ---------------- BC4 ----------------
+
+		// block 的通道 0 为 [0, 255]；总是 8 值模式（端点相同时所有下标为 0）
+		template <Bool kSimd>
+		void EncodeAlphaBlock(const BlockTexels& block, UByte* out_block)
+		{
+			// 沿端点方向的顺序 k 到 BC4 下标：0 为 red0，7 为 red1，中间为 k + 1
+			constexpr UInt kOrderedToIndex[8] = { 0, 2, 3, 4, 5, 6, 7, 1 };
+
+			Float endpoint0[4] = { block.channels[0][0], 0.0f, 0.0f, 0.0f };
+			Float endpoint1[4] = { block.channels[0][0], 0.0f, 0.0f, 0.0f };
+			for (UInt i = 1; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				endpoint0[0] = std::max(endpoint0[0], block.channels[0][i]);
+				endpoint1[0] = std::min(endpoint1[0], block.channels[0][i]);
+			}
+
+			Float best_error = std::numeric_limits<Float>::max();
+			UInt best_reds[2] = {};
+			UInt best_ordered[BLOCK_TEXEL_COUNT] = {};
+			for (UInt iteration = 0; iteration <= kRefineIterations; ++iteration)
+			{
+				UInt red0 = RoundToUInt(endpoint0[0], 255.0f);
+				UInt red1 = RoundToUInt(endpoint1[0], 255.0f);
+				if (red0 < red1)
+				{
+					std::swap(red0, red1);
+				}
+
+				Float palette[8][4] = {};
+				for (UInt k = 0; k < 8; ++k)
+				{
+					palette[k][0] = static_cast<Float>((7 - k) * red0 + k * red1) / 7.0f;
+				}
+
+				UInt ordered[BLOCK_TEXEL_COUNT];
+				ComputeIndices<kSimd>(block, 1, palette[0], palette[7], 7, ordered);
+				const Float error = ComputePaletteError(block, 1, palette, ordered);
+				if (error < best_error)
+				{
+					best_error = error;
+					best_reds[0] = red0;
+					best_reds[1] = red1;
+					std::copy(ordered, ordered + BLOCK_TEXEL_COUNT, best_ordered);
+				}
+				if (best_error <= 0.0f || iteration == kRefineIterations)
+				{
+					break;
+				}
+
+				Float weights[BLOCK_TEXEL_COUNT];
+				IndexWeights(ordered, 7.0f, weights);
+				if (!SolveEndpoints(block, 1, weights, 255.0f, endpoint0, endpoint1))
+				{
+					break;
+				}
+			}
+
+			BlockBitWriter writer(out_block, 8);
+			writer.Write(best_reds[0], 8);
+			writer.Write(best_reds[1], 8);
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				writer.Write(kOrderedToIndex[best_ordered[i]], 3);
+			}
+		}
+
+		// ---------------- BC7 mode 6 ----------------
+
+		// 7 位端点 + 每个端点一个共享的 p 位：选误差较小的 p
+		void QuantizeEndpointBC7(const Float* endpoint, UInt* out_quantized, UInt& out_p_bit, Float* out_decoded)
+		{
+			Float best_error = std::numeric_limits<Float>::max();
+			for (UInt p_bit = 0; p_bit < 2; ++p_bit)
+			{
+				UInt quantized[4];
+				Float error = 0.0f;
+				for (UInt c = 0; c < 4; ++c)
+				{
+					quantized[c] = RoundToUInt((endpoint[c] - p_bit) * 0.5f, 127.0f);
+					const Float difference = static_cast<Float>((quantized[c] << 1) | p_bit) - endpoint[c];
+					error += difference * difference;
+				}
+				if (error < best_error)
+				{
+					best_error = error;
+					out_p_bit = p_bit;
+					for (UInt c = 0; c < 4; ++c)
+					{
+						out_quantized[c] = quantized[c];
+						out_decoded[c] = static_cast<Float>((quantized[c] << 1) | p_bit);
+					}
+				}
+			}
+		}
+
+		// block 的 RGBA 为 [0, 255]
+		template <Bool kSimd>
+		void EncodeBlockBC7(const BlockTexels& block, UByte* out_block)
+		{
+			Float endpoint0[4];
+			Float endpoint1[4];
+			FitEndpoints<kSimd>(block, 4, 255.0f, endpoint0, endpoint1);
+
+			Float best_error = std::numeric_limits<Float>::max();
+			UInt best_quantized[2][4] = {};
+			UInt best_p_bits[2] = {};
+			UInt best_indices[BLOCK_TEXEL_COUNT] = {};
+			for (UInt iteration = 0; iteration <= kRefineIterations; ++iteration)
+			{
+				UInt quantized[2][4];
+				UInt p_bits[2];
+				Float decoded[2][4];
+				QuantizeEndpointBC7(endpoint0, quantized[0], p_bits[0], decoded[0]);
+				QuantizeEndpointBC7(endpoint1, quantized[1], p_bits[1], decoded[1]);
+
+				Float palette[16][4];
+				for (UInt k = 0; k < 16; ++k)
+				{
+					for (UInt c = 0; c < 4; ++c)
+					{
+						const UInt e0 = static_cast<UInt>(decoded[0][c]);
+						const UInt e1 = static_cast<UInt>(decoded[1][c]);
+						palette[k][c] = static_cast<Float>(((64 - kWeights4[k]) * e0 + kWeights4[k] * e1 + 32) >> 6);
+					}
+				}
+
+				UInt indices[BLOCK_TEXEL_COUNT];
+				ComputeIndices<kSimd>(block, 4, decoded[0], decoded[1], 15, indices);
+				RefineIndices(block, 4, palette, 15, indices);
+				const Float error = ComputePaletteError(block, 4, palette, indices);
+				if (error < best_error)
+				{
+					best_error = error;
+					std::copy(&quantized[0][0], &quantized[0][0] + 8, &best_quantized[0][0]);
+					best_p_bits[0] = p_bits[0];
+					best_p_bits[1] = p_bits[1];
+					std::copy(indices, indices + BLOCK_TEXEL_COUNT, best_indices);
+				}
+				if (best_error <= 0.0f || iteration == kRefineIterations)
+				{
+					break;
+				}
+
+				Float weights[BLOCK_TEXEL_COUNT];
+				Weights4(indices, weights);
+				if (!SolveEndpoints(block, 4, weights, 255.0f, endpoint0, endpoint1))
+				{
+					break;
+				}
+			}
+
+			// 第一个纹素的下标只存 3 位，最高位必须为 0：交换端点并反转下标（权重表对称）
+			const UInt first = best_indices[0] >= 8 ? 1 : 0;
+			const UInt second = 1 - first;
+			BlockBitWriter writer(out_block, 16);
+			writer.Write(1u << 6, 7);
+			for (UInt c = 0; c < 4; ++c)
+			{
+				writer.Write(best_quantized[first][c], 7);
+				writer.Write(best_quantized[second][c], 7);
+			}
+			writer.Write(best_p_bits[first], 1);
+			writer.Write(best_p_bits[second], 1);
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				writer.Write(first == 0 ? best_indices[i] : 15 - best_indices[i], i == 0 ? 3 : 4);
+			}
+		}
+
+		// ---------------- BC6H mode 11 ----------------
+
+		UInt UnquantizeBC6H(UInt quantized)
+		{
+			if (quantized == 0)
+			{
+				return 0;
+			}
+			if (quantized == 1023)
+			{
+				return 0xFFFF;
+			}
+			return ((quantized << 16) + 0x8000) >> 10;
+		}
+
+		// 插值之后缩放回半精度位模式（无符号格式乘 31/64）
+		UInt FinishBC6H(UInt interpolated)
+		{
+			return (interpolated * 31) >> 6;
+		}
+
+		// 位模式的最终值约为 31 * q，在 round(h / 31) 附近找最接近的
+		UInt QuantizeEndpointBC6H(Float half_bits)
+		{
+			const UInt center = RoundToUInt(half_bits / 31.0f, 1023.0f);
+			UInt best = center;
+			Float best_error = std::numeric_limits<Float>::max();
+			for (UInt quantized = center > 0 ? center - 1 : 0; quantized <= std::min(center + 1, 1023u); ++quantized)
+			{
+				const Float error = std::fabs(static_cast<Float>(FinishBC6H(UnquantizeBC6H(quantized))) - half_bits);
+				if (error < best_error)
+				{
+					best_error = error;
+					best = quantized;
+				}
+			}
+			return best;
+		}
+
+		// block 的 RGB 为半精度位模式（[0, 31743]）。BC6H 在位模式上线性插值，误差也按位模式计算，近似于相对误差
+		template <Bool kSimd>
+		void EncodeBlockBC6H(const BlockTexels& block, UByte* out_block)
+		{
+			Float endpoint0[4];
+			Float endpoint1[4];
+			FitEndpoints<kSimd>(block, 3, kMaxHalfBits, endpoint0, endpoint1);
+
+			Float best_error = std::numeric_limits<Float>::max();
+			UInt best_quantized[2][3] = {};
+			UInt best_indices[BLOCK_TEXEL_COUNT] = {};
+			for (UInt iteration = 0; iteration <= kRefineIterations; ++iteration)
+			{
+				UInt quantized[2][3];
+				UInt unquantized[2][3];
+				Float decoded[2][4] = {};
+				for (UInt c = 0; c < 3; ++c)
+				{
+					quantized[0][c] = QuantizeEndpointBC6H(endpoint0[c]);
+					quantized[1][c] = QuantizeEndpointBC6H(endpoint1[c]);
+					for (UInt e = 0; e < 2; ++e)
+					{
+						unquantized[e][c] = UnquantizeBC6H(quantized[e][c]);
+						decoded[e][c] = static_cast<Float>(FinishBC6H(unquantized[e][c]));
+					}
+				}
+
+				Float palette[16][4] = {};
+				for (UInt k = 0; k < 16; ++k)
+				{
+					for (UInt c = 0; c < 3; ++c)
+					{
+						palette[k][c] = static_cast<Float>(FinishBC6H(((64 - kWeights4[k]) * unquantized[0][c] + kWeights4[k] * unquantized[1][c] + 32) >> 6));
+					}
+				}
+
+				UInt indices[BLOCK_TEXEL_COUNT];
+				ComputeIndices<kSimd>(block, 3, decoded[0], decoded[1], 15, indices);
+				RefineIndices(block, 3, palette, 15, indices);
+				const Float error = ComputePaletteError(block, 3, palette, indices);
+				if (error < best_error)
+				{
+					best_error = error;
+					std::copy(&quantized[0][0], &quantized[0][0] + 6, &best_quantized[0][0]);
+					std::copy(indices, indices + BLOCK_TEXEL_COUNT, best_indices);
+				}
+				if (best_error <= 0.0f || iteration == kRefineIterations)
+				{
+					break;
+				}
+
+				Float weights[BLOCK_TEXEL_COUNT];
+				Weights4(indices, weights);
+				if (!SolveEndpoints(block, 3, weights, kMaxHalfBits, endpoint0, endpoint1))
+				{
+					break;
+				}
+			}
+
+			// 与 BC7 相同，第一个纹素的下标最高位必须为 0
+			const UInt first = best_indices[0] >= 8 ? 1 : 0;
+			BlockBitWriter writer(out_block, 16);
+			writer.Write(0x03, 5);
+			for (UInt e = 0; e < 2; ++e)
+			{
+				for (UInt c = 0; c < 3; ++c)
+				{
+					writer.Write(best_quantized[e ^ first][c], 10);
+				}
+			}
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				writer.Write(first == 0 ? best_indices[i] : 15 - best_indices[i], i == 0 ? 3 : 4);
+			}
+		}
+
+		// ---------------- 格式分派 ----------------
+
+		// source 的通道：LDR 为 [0, 1]，BC6H 为线性 HDR 值
+		template <Bool kSimd>
+		void EncodeBlockTexels(BlockFormat format, const BlockTexels& source, UByte* out_block)
+		{
+			BlockTexels block;
+			auto copy_channel = [&source, &block](UInt source_channel, UInt channel)
+			{
+				for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+				{
+					block.channels[channel][i] = Saturate(source.channels[source_channel][i], 1.0f) * 255.0f;
+				}
+			};
+
+			switch (format)
+			{
+			case BlockFormat::BC1:
+				for (UInt c = 0; c < 3; ++c) copy_channel(c, c);
+				EncodeColorBlock<kSimd>(block, out_block);
+				break;
+			case BlockFormat::BC3:
+				copy_channel(3, 0);
+				EncodeAlphaBlock<kSimd>(block, out_block);
+				for (UInt c = 0; c < 3; ++c) copy_channel(c, c);
+				EncodeColorBlock<kSimd>(block, out_block + 8);
+				break;
+			case BlockFormat::BC4:
+				copy_channel(0, 0);
+				EncodeAlphaBlock<kSimd>(block, out_block);
+				break;
+			case BlockFormat::BC5:
+				copy_channel(0, 0);
+				EncodeAlphaBlock<kSimd>(block, out_block);
+				copy_channel(1, 0);
+				EncodeAlphaBlock<kSimd>(block, out_block + 8);
+				break;
+			case BlockFormat::BC6H:
+				for (UInt c = 0; c < 3; ++c)
+				{
+					for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+					{
+						// 位模式大于 0x7BFF 的是无穷大，截断到最大有限值
+						block.channels[c][i] = static_cast<Float>(std::min(FloatToHalf(Saturate(source.channels[c][i], 65504.0f)), 0x7BFFu));
+					}
+				}
+				EncodeBlockBC6H<kSimd>(block, out_block);
+				break;
+			case BlockFormat::BC7:
+			default:
+				for (UInt c = 0; c < 4; ++c) copy_channel(c, c);
+				EncodeBlockBC7<kSimd>(block, out_block);
+				break;
+			}
+		}
+
+		template <Bool kSimd>
+		void CompressBlockRowsImpl(BlockFormat format, const Float* pixels, UInt width, UInt height, UInt block_row_begin, UInt block_row_end, UByte* out_blocks)
+		{
+			const UInt block_columns = (width + 3) / 4;
+			const UInt block_bytes = GetBlockFormatBytes(format);
+			BlockTexels block;
+			for (UInt block_y = block_row_begin; block_y < block_row_end; ++block_y)
+			{
+				for (UInt block_x = 0; block_x < block_columns; ++block_x)
+				{
+					for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+					{
+						const UInt x = std::min(block_x * 4 + (i & 3u), width - 1);
+						const UInt y = std::min(block_y * 4 + (i >> 2), height - 1);
+						const Float* pixel = pixels + (static_cast<std::size_t>(y) * width + x) * 4;
+						for (UInt c = 0; c < 4; ++c)
+						{
+							block.channels[c][i] = pixel[c];
+						}
+					}
+					EncodeBlockTexels<kSimd>(format, block, out_blocks + (static_cast<std::size_t>(block_y) * block_columns + block_x) * block_bytes);
+				}
+			}
+		}
+
+		// ---------------- 解码 ----------------
+
+		void DecodeColorBlock(const UByte* block, Bool allow_three_color, Float* out_texels)
+		{
+			BlockBitReader reader(block);
+			const UInt color0 = reader.Read(16);
+			const UInt color1 = reader.Read(16);
+			Float palette[4][4];
+			ExpandColor565(color0, palette[0]);
+			ExpandColor565(color1, palette[1]);
+			palette[0][3] = 255.0f;
+			palette[1][3] = 255.0f;
+			if (color0 > color1 || !allow_three_color)
+			{
+				for (UInt c = 0; c < 4; ++c)
+				{
+					palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+					palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+				}
+			}
+			else
+			{
+				for (UInt c = 0; c < 4; ++c)
+				{
+					palette[2][c] = (palette[0][c] + palette[1][c]) / 2.0f;
+					palette[3][c] = 0.0f;
+				}
+			}
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				const UInt index = reader.Read(2);
+				for (UInt c = 0; c < 4; ++c)
+				{
+					out_texels[i * 4 + c] = palette[index][c] / 255.0f;
+				}
+			}
+		}
+
+		void DecodeAlphaBlock(const UByte* block, Float* out_values, UInt stride)
+		{
+			BlockBitReader reader(block);
+			const UInt red0 = reader.Read(8);
+			const UInt red1 = reader.Read(8);
+			Float palette[8];
+			palette[0] = static_cast<Float>(red0);
+			palette[1] = static_cast<Float>(red1);
+			if (red0 > red1)
+			{
+				for (UInt index = 2; index < 8; ++index)
+				{
+					palette[index] = static_cast<Float>((8 - index) * red0 + (index - 1) * red1) / 7.0f;
+				}
+			}
+			else
+			{
+				for (UInt index = 2; index < 6; ++index)
+				{
+					palette[index] = static_cast<Float>((6 - index) * red0 + (index - 1) * red1) / 5.0f;
+				}
+				palette[6] = 0.0f;
+				palette[7] = 255.0f;
+			}
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				out_values[i * stride] = palette[reader.Read(3)] / 255.0f;
+			}
+		}
+	}
+
+	UInt GetBlockFormatBytes(BlockFormat format)
+	{
+		return format == BlockFormat::BC1 || format == BlockFormat::BC4 ? 8 : 16;
+	}
+
+	const char* GetBlockFormatName(BlockFormat format)
+	{
+		switch (format)
+		{
+		case BlockFormat::BC1:  return "BC1";
+		case BlockFormat::BC3:  return "BC3";
+		case BlockFormat::BC4:  return "BC4";
+		case BlockFormat::BC5:  return "BC5";
+		case BlockFormat::BC6H: return "BC6H";
+		case BlockFormat::BC7:  return "BC7";
+		default:                return "Unknown";
+		}
+	}
+
+	ULongLong ComputeBlockCompressedSize(BlockFormat format, UInt width, UInt height)
+	{
+		return static_cast<ULongLong>((width + 3) / 4) * ((height + 3) / 4) * GetBlockFormatBytes(format);
+	}
+
+	BlockCompressionPath GetBlockCompressionPath()
+	{
+#if defined(DOLAS_BLOCK_COMPRESSION_AVX)
+		return BlockCompressionPath::AVX;
+#elif defined(DOLAS_BLOCK_COMPRESSION_SSE)
+		return BlockCompressionPath::SSE;
+#else
+		return BlockCompressionPath::Scalar;
+#endif
+	}
+
+	void EncodeBlock(BlockFormat format, const Float* texels, UByte* out_block)
+	{
+		BlockTexels block;
+		for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+		{
+			for (UInt c = 0; c < 4; ++c)
+			{
+				block.channels[c][i] = texels[i * 4 + c];
+			}
+		}
+		EncodeBlockTexels<kHasSimd>(format, block, out_block);
+	}
+
+	Bool DecodeBlock(BlockFormat format, const UByte* block, Float* out_texels)
+	{
+		switch (format)
+		{
+		case BlockFormat::BC1:
+			DecodeColorBlock(block, true, out_texels);
+			return true;
+		case BlockFormat::BC3:
+			DecodeColorBlock(block + 8, false, out_texels);
+			DecodeAlphaBlock(block, out_texels + 3, 4);
+			return true;
+		case BlockFormat::BC4:
+		case BlockFormat::BC5:
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				out_texels[i * 4 + 1] = 0.0f;
+				out_texels[i * 4 + 2] = 0.0f;
+				out_texels[i * 4 + 3] = 1.0f;
+			}
+			DecodeAlphaBlock(block, out_texels, 4);
+			if (format == BlockFormat::BC5)
+			{
+				DecodeAlphaBlock(block + 8, out_texels + 1, 4);
+			}
+			return true;
+		case BlockFormat::BC6H:
+		{
+			BlockBitReader reader(block);
+			if (reader.Read(5) != 0x03)
+			{
+				return false;
+			}
+			UInt endpoints[2][3];
+			for (UInt e = 0; e < 2; ++e)
+			{
+				for (UInt c = 0; c < 3; ++c)
+				{
+					endpoints[e][c] = UnquantizeBC6H(reader.Read(10));
+				}
+			}
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				const UInt weight = kWeights4[reader.Read(i == 0 ? 3 : 4)];
+				for (UInt c = 0; c < 3; ++c)
+				{
+					out_texels[i * 4 + c] = HalfToFloat(FinishBC6H(((64 - weight) * endpoints[0][c] + weight * endpoints[1][c] + 32) >> 6));
+				}
+				out_texels[i * 4 + 3] = 1.0f;
+			}
+			return true;
+		}
+		case BlockFormat::BC7:
+		{
+			BlockBitReader reader(block);
+			if (reader.Read(7) != (1u << 6))
+			{
+				return false;
+			}
+			UInt endpoints[2][4];
+			for (UInt c = 0; c < 4; ++c)
+			{
+				endpoints[0][c] = reader.Read(7) << 1;
+				endpoints[1][c] = reader.Read(7) << 1;
+			}
+			for (UInt e = 0; e < 2; ++e)
+			{
+				const UInt p_bit = reader.Read(1);
+				for (UInt c = 0; c < 4; ++c)
+				{
+					endpoints[e][c] |= p_bit;
+				}
+			}
+			for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+			{
+				const UInt weight = kWeights4[reader.Read(i == 0 ? 3 : 4)];
+				for (UInt c = 0; c < 4; ++c)
+				{
+					out_texels[i * 4 + c] = static_cast<Float>(((64 - weight) * endpoints[0][c] + weight * endpoints[1][c] + 32) >> 6) / 255.0f;
+				}
+			}
+			return true;
+		}
+		default:
+			return false;
+		}
+	}
+
+	void CompressBlockRows(BlockFormat format, const Float* pixels, UInt width, UInt height, UInt block_row_begin, UInt block_row_end, UByte* out_blocks)
+	{
+		CompressBlockRowsImpl<kHasSimd>(format, pixels, width, height, block_row_begin, block_row_end, out_blocks);
+	}
+
+	void CompressBlockRowsScalar(BlockFormat format, const Float* pixels, UInt width, UInt height, UInt block_row_begin, UInt block_row_end, UByte* out_blocks)
+	{
+		CompressBlockRowsImpl<false>(format, pixels, width, height, block_row_begin, block_row_end, out_blocks);
+	}
+
+	UInt FloatToHalf(Float value)
+	{
+		if (std::isnan(value))
+		{
+			return 0x7E00;
+		}
+		const UInt sign = std::signbit(value) ? 0x8000u : 0u;
+		const Float magnitude = std::fabs(value);
+		// 65520 及以上舍入为无穷大
+		if (magnitude >= 65520.0f)
+		{
+			return sign | 0x7C00u;
+		}
+		// 非规格化数：以 2^-24 为单位舍入（舍入到 1024 时恰好是最小的规格化数）
+		if (magnitude < 6.103515625e-05f)
+		{
+			return sign | static_cast<UInt>(std::nearbyint(magnitude * 16777216.0f));
+		}
+		int exponent = 0;
+		const Float fraction = std::frexp(magnitude, &exponent);   // [0.5, 1)
+		UInt mantissa = static_cast<UInt>(std::nearbyint((fraction * 2.0f - 1.0f) * 1024.0f));
+		UInt half_exponent = static_cast<UInt>(exponent - 1 + 15);
+		if (mantissa == 1024)
+		{
+			mantissa = 0;
+			++half_exponent;
+		}
+		return sign | (half_exponent << 10) | mantissa;
+	}
+
+	Float HalfToFloat(UInt half)
+	{
+		const Float sign = (half & 0x8000u) ? -1.0f : 1.0f;
+		const UInt exponent = (half >> 10) & 31u;
+		const UInt mantissa = half & 1023u;
+		if (exponent == 0)
+		{
+			return sign * std::ldexp(static_cast<Float>(mantissa), -24);
+		}
+		if (exponent == 31)
+		{
+			return mantissa == 0 ? sign * std::numeric_limits<Float>::infinity() : std::numeric_limits<Float>::quiet_NaN();
+		}
+		return sign * std::ldexp(1.0f + mantissa / 1024.0f, static_cast<int>(exponent) - 15);
+	}
+}
@@ -0,0 +1,273 @@
+#include "dolas_bounds.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Dolas
+{
+	Float BoundingBox::GetSurfaceArea() const
+	{
+		if (!IsValid())
+		{
+			return 0.0f;
+		}
+		const Float size_x = max_point.x - min_point.x;
+		const Float size_y = max_point.y - min_point.y;
+		const Float size_z = max_point.z - min_point.z;
+		return 2.0f * (size_x * size_y + size_y * size_z + size_z * size_x);
+	}
+
+	Bool BoundingBox::Contains(const BoundingBox& other) const
+	{
+		return min_point.x <= other.min_point.x && min_point.y <= other.min_point.y && min_point.z <= other.min_point.z &&
+			max_point.x >= other.max_point.x && max_point.y >= other.max_point.y && max_point.z >= other.max_point.z;
+	}
+
+	Bool BoundingBox::Intersects(const BoundingBox& other) const
+	{
+		return min_point.x <= other.max_point.x && max_point.x >= other.min_point.x &&
+			min_point.y <= other.max_point.y && max_point.y >= other.min_point.y &&
+			min_point.z <= other.max_point.z && max_point.z >= other.min_point.z;
+	}
+
+	Bool BoundingBox::IntersectsRay(const Vector3& origin, const Vector3& direction, Float max_distance, Float& out_distance) const
+	{
+		Float t_min = 0.0f;
+		Float t_max = max_distance;
+		for (UInt axis = 0; axis < 3; ++axis)
+		{
+			if (std::fabs(direction[axis]) < DOLAS_FLOAT_EPSILON)
+			{
+				// 与该轴平行：起点必须落在 slab 内
+				if (origin[axis] < min_point[axis] || origin[axis] > max_point[axis])
+				{
+					return false;
+				}
+				continue;
+			}
+
+			const Float inverse_direction = 1.0f / direction[axis];
+			Float t_near = (min_point[axis] - origin[axis]) * inverse_direction;
+			Float t_far = (max_point[axis] - origin[axis]) * inverse_direction;
+			if (t_near > t_far)
+			{
+				std::swap(t_near, t_far);
+			}
+			t_min = std::max(t_min, t_near);
+			t_max = std::min(t_max, t_far);
+			if (t_min > t_max)
+			{
+				return false;
+			}
+		}
+		out_distance = t_min;
+		return true;
+	}
+
+	BoundingBox BoundingBox::Union(const BoundingBox& a, const BoundingBox& b)
+	{
+		return BoundingBox(
+			Vector3(std::min(a.min_point.x, b.min_point.x), std::min(a.min_point.y, b.min_point.y), std::min(a.min_point.z, b.min_point.z)),
+			Vector3(std::max(a.max_point.x, b.max_point.x), std::max(a.max_point.y, b.max_point.y), std::max(a.max_point.z, b.max_point.z)));
+	}
+
+	void BoundingBox::Merge(const Vector3& point)
+	{
+		min_point.x = std::min(min_point.x, point.x);
+		min_point.y = std::min(min_point.y, point.y);
+		min_point.z = std::min(min_point.z, point.z);
+		max_point.x = std::max(max_point.x, point.x);
+		max_point.y = std::max(max_point.y, point.y);
+		max_point.z = std::max(max_point.z, point.z);
+	}
+
+	void BoundingBox::Merge(const BoundingBox& other)
+	{
+		if (!other.IsValid())
+		{
+			return;
+		}
+		Merge(other.min_point);
+		Merge(other.max_point);
+	}
+
+	BoundingBox BoundingBox::Transform(const Matrix4x4& matrix) const
+	{
+		if (!IsValid())
+		{
+			return BoundingBox();
+		}
+
+		// 新中心 = M * c，新半长的每个分量 = |M| 对应行与半长的点积
+		const Vector3 center = GetCenter();
+		const Vector3 extents = GetExtents();
+		Vector3 world_center;
+		Vector3 world_extents;
+		for (UInt row = 0; row < 3; ++row)
+		{
+			world_center[row] = matrix.data[row][0] * center.x + matrix.data[row][1] * center.y + matrix.data[row][2] * center.z + matrix.data[row][3];
+			world_extents[row] = std::fabs(matrix.data[row][0]) * extents.x + std::fabs(matrix.data[row][1]) * extents.y + std::fabs(matrix.data[row][2]) * extents.z;
+		}
+		return BoundingBox(world_center - world_extents, world_center + world_extents);
+	}
+
+	BoundingBox BoundingBox::FromPositions(const Float* positions, std::size_t vertex_count, std::size_t stride /*= 3*/)
+	{
+		BoundingBox box;
+		if (!positions || stride < 3)
+		{
+			return box;
+		}
+
+		for (std::size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+		{
+			const Float* position = positions + vertex_index * stride;
+			box.Merge(Vector3(position[0], position[1], position[2]));
+		}
+		return box;
+	}
+
+	BoundingSphere BoundingSphere::Transform(const Matrix4x4& matrix) const
+	{
+		if (!IsValid())
+		{
+			return BoundingSphere();
+		}
+
+		Vector3 world_center;
+		for (UInt row = 0; row < 3; ++row)
+		{
+			world_center[row] = matrix.data[row][0] * center.x + matrix.data[row][1] * center.y + matrix.data[row][2] * center.z + matrix.data[row][3];
+		}
+
+		Float max_scale_squared = 0.0f;
+		for (UInt column = 0; column < 3; ++column)
+		{
+			const Float scale_squared =
+				matrix.data[0][column] * matrix.data[0][column] +
+				matrix.data[1][column] * matrix.data[1][column] +
+				matrix.data[2][column] * matrix.data[2][column];
+			max_scale_squared = std::max(max_scale_squared, scale_squared);
+		}
+		return BoundingSphere(world_center, radius * std::sqrt(max_scale_squared));
+	}
+
+	BoundingSphere BoundingSphere::FromPositions(const Float* positions, std::size_t vertex_count, std::size_t stride /*= 3*/)
+	{
+		const BoundingBox box = BoundingBox::FromPositions(positions, vertex_count, stride);
+		if (!box.IsValid())
+		{
+			return BoundingSphere();
+		}
+
+		const Vector3 center = box.GetCenter();
+		Float max_distance_squared = 0.0f;
+		for (std::size_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+		{
+			const Float* position = positions + vertex_index * stride;
+			const Vector3 offset(position[0] - center.x, position[1] - center.y, position[2] - center.z);
+			max_distance_squared = std::max(max_distance_squared, offset.LengthSquared());
+		}
+		return BoundingSphere(center, std::sqrt(max_distance_squared));
+	}
+
+	BoundingSphere BoundingSphere::FromBox(const BoundingBox& box)
+	{
+		if (!box.IsValid())
+		{
+			return BoundingSphere();
+		}
+		return BoundingSphere(box.GetCenter(), box.GetExtents().Length());
+	}
+
+	Frustum Frustum::FromViewProjection(const Matrix4x4& view_projection)
+	{
+		// Gribb-Hartmann：由 VP 的行组合出六个平面
+		const Vector4 row0 = view_projection.GetRow(0);
+		const Vector4 row1 = view_projection.GetRow(1);
+		const Vector4 row2 = view_projection.GetRow(2);
+		const Vector4 row3 = view_projection.GetRow(3);
+
+		Frustum frustum;
+		frustum.planes[PlaneIndex_LEFT] = row3 + row0;
+		frustum.planes[PlaneIndex_RIGHT] = row3 - row0;
+		frustum.planes[PlaneIndex_BOTTOM] = row3 + row1;
+		frustum.planes[PlaneIndex_TOP] = row3 - row1;
+		frustum.planes[PlaneIndex_NEAR] = row2;
+		frustum.planes[PlaneIndex_FAR] = row3 - row2;
+
+		for (Vector4& plane : frustum.planes)
+		{
+			const Float normal_length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+			if (normal_length > DOLAS_FLOAT_EPSILON)
+			{
+				plane /= normal_length;
+			}
+		}
+		return frustum;
+	}
+
+	Bool Frustum::IntersectsBox(const BoundingBox& box) const
+	{
+		if (!box.IsValid())
+		{
+			return false;
+		}
+
+		const Vector3 center = box.GetCenter();
+		const Vector3 extents = box.GetExtents();
+		for (const Vector4& plane : planes)
+		{
+			const Float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+			const Float radius = std::fabs(plane.x) * extents.x + std::fabs(plane.y) * extents.y + std::fabs(plane.z) * extents.z;
+			if (distance < -radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	Bool Frustum::IntersectsSphere(const BoundingSphere& sphere) const
+	{
+		if (!sphere.IsValid())
+		{
+			return false;
+		}
+
+		for (const Vector4& plane : planes)
+		{
+			const Float distance = plane.x * sphere.center.x + plane.y * sphere.center.y + plane.z * sphere.center.z + plane.w;
+			if (distance < -sphere.radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	ContainmentType Frustum::ClassifyBox(const BoundingBox& box) const
+	{
+		if (!box.IsValid())
+		{
+			return ContainmentType::Disjoint;
+		}
+
+		const Vector3 center = box.GetCenter();
+		const Vector3 extents = box.GetExtents();
+		ContainmentType result = ContainmentType::Contains;
+		for (const Vector4& plane : planes)
+		{
+			const Float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+			const Float radius = std::fabs(plane.x) * extents.x + std::fabs(plane.y) * extents.y + std::fabs(plane.z) * extents.z;
+			if (distance < -radius)
+			{
+				return ContainmentType::Disjoint;
+			}
+			if (distance < radius)
+			{
+				result = ContainmentType::Intersects;
+			}
+		}
+		return result;
+	}
+}
@@ -0,0 +1,132 @@
+#include "dolas_cascaded_shadow.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Dolas
+{
+	namespace
+	{
+		// 包围球半径向上取整的粒度（世界单位），切片形状相同的帧得到完全相同的半径
+		constexpr Float kCascadeRadiusQuantum = 1.0f / 16.0f;
+	}
+
+	void ComputeCascadeSplits(Float near_plane, Float far_plane, UInt cascade_count, Float lambda, Float* out_splits)
+	{
+		if (!out_splits || cascade_count == 0)
+		{
+			return;
+		}
+
+		near_plane = std::max(near_plane, DOLAS_FLOAT_EPSILON);
+		far_plane = std::max(far_plane, near_plane);
+		lambda = std::clamp(lambda, 0.0f, 1.0f);
+		const Float ratio = far_plane / near_plane;
+		for (UInt i = 1; i < cascade_count; ++i)
+		{
+			const Float t = static_cast<Float>(i) / static_cast<Float>(cascade_count);
+			const Float log_split = near_plane * std::pow(ratio, t);
+			const Float uniform_split = near_plane + (far_plane - near_plane) * t;
+			out_splits[i] = lambda * log_split + (1.0f - lambda) * uniform_split;
+		}
+		// 首尾直接赋值，不受 pow 的舍入影响
+		out_splits[0] = near_plane;
+		out_splits[cascade_count] = far_plane;
+	}
+
+	BoundingSphere ComputeCascadeBoundingSphere(const CascadeShadowView& view, Float split_near, Float split_far)
+	{
+		// 切片关于视线轴对称，最小包围球的球心在视线轴上。角点到视线轴的距离为 depth * k，
+		// 令近、远平面角点到球心等距可解出球心深度；超出远平面时（宽视角的薄切片）球心取在远平面中心
+		const Float tan_x = 1.0f / std::max(std::abs(view.projection_scale_x), DOLAS_FLOAT_EPSILON);
+		const Float tan_y = 1.0f / std::max(std::abs(view.projection_scale_y), DOLAS_FLOAT_EPSILON);
+		const Float k_squared = tan_x * tan_x + tan_y * tan_y;
+
+		const Float center_depth = std::min(0.5f * (split_near + split_far) * (1.0f + k_squared), split_far);
+		const Float far_offset = split_far - center_depth;
+		Float radius = std::sqrt(split_far * split_far * k_squared + far_offset * far_offset);
+		radius = std::ceil(radius / kCascadeRadiusQuantum) * kCascadeRadiusQuantum;
+
+		const Vector4 world_center = view.view.GetInverse() * Vector4(0.0f, 0.0f, -center_depth, 1.0f);
+		return BoundingSphere(Vector3(world_center.x, world_center.y, world_center.z), radius);
+	}
+
+	Matrix4x4 MakeShadowLightView(const Vector3& light_direction)
+	{
+		Vector3 back = -light_direction.Normalized();
+		// 光线接近竖直时改用世界 Z 作为参考上方向
+		const Vector3 reference_up = std::abs(back.y) > 0.99f ? Vector3(0.0f, 0.0f, 1.0f) : Vector3(0.0f, 1.0f, 0.0f);
+		const Vector3 right = reference_up.Cross(back).Normalized();
+		const Vector3 up = back.Cross(right);
+
+		Matrix4x4 light_view = Matrix4x4::IDENTITY;
+		light_view.SetRow(0, Vector4(right, 0.0f));
+		light_view.SetRow(1, Vector4(up, 0.0f));
+		light_view.SetRow(2, Vector4(back, 0.0f));
+		return light_view;
+	}
+
+	ShadowCascade FitShadowCascade(const BoundingSphere& sphere, const Vector3& light_direction, UInt resolution, const BoundingBox& caster_bounds)
+	{
+		ShadowCascade cascade;
+		cascade.bounding_sphere = sphere;
+		cascade.light_view = MakeShadowLightView(light_direction);
+
+		const Float radius = std::max(sphere.radius, kCascadeRadiusQuantum);
+		const Float texel_size = 2.0f * radius / static_cast<Float>(std::max<UInt>(resolution, 1));
+		cascade.texel_size = texel_size;
+
+		// 球心变换到光源空间后 x / y 对齐到 texel 网格：光源空间原点固定在世界原点，
+		// 投影窗口总是以整 texel 平移，同一个世界点每帧落在同一个 texel 内的相同位置
+		const Vector4 center = cascade.light_view * Vector4(sphere.center, 1.0f);
+		const Float center_x = std::floor(center.x / texel_size + 0.5f) * texel_size;
+		const Float center_y = std::floor(center.y / texel_size + 0.5f) * texel_size;
+
+		// 光源空间看向 -Z：z 越大越靠近光源
+		Float near_z = center.z + radius;
+		const Float far_z = center.z - radius;
+		if (caster_bounds.IsValid())
+		{
+			const Vector4 back = cascade.light_view.GetRow(2);
+			const Vector3 caster_center = caster_bounds.GetCenter();
+			const Vector3 caster_extents = caster_bounds.GetExtents();
+			const Float caster_near_z = back.x * caster_center.x + back.y * caster_center.y + back.z * caster_center.z
+				+ std::abs(back.x) * caster_extents.x + std::abs(back.y) * caster_extents.y + std::abs(back.z) * caster_extents.z;
+			near_z = std::max(near_z, caster_near_z);
+		}
+
+		cascade.projection = Matrix4x4::Orthographic(
+			center_x - radius, center_x + radius,
+			center_y + radius, center_y - radius,
+			far_z, near_z);
+		cascade.view_projection = cascade.projection * cascade.light_view;
+		cascade.frustum = Frustum::FromViewProjection(cascade.view_projection);
+		return cascade;
+	}
+
+	void ComputeShadowCascades(const CascadeShadowDesc& desc, const CascadeShadowView& view, const Vector3& light_direction,
+		const BoundingBox& caster_bounds, ShadowCascade* out_cascades)
+	{
+		const UInt cascade_count = std::min(desc.cascade_count, kMaxShadowCascadeCount);
+		if (!out_cascades || cascade_count == 0)
+		{
+			return;
+		}
+
+		Float splits[kMaxShadowCascadeCount + 1] = {};
+		const Float shadow_far = std::max(std::min(desc.max_distance, view.far_plane), view.near_plane);
+		ComputeCascadeSplits(view.near_plane, shadow_far, cascade_count, desc.split_lambda, splits);
+		for (UInt cascade_index = 0; cascade_index < cascade_count; ++cascade_index)
+		{
+			const BoundingSphere sphere = ComputeCascadeBoundingSphere(view, splits[cascade_index], splits[cascade_index + 1]);
+			out_cascades[cascade_index] = FitShadowCascade(sphere, light_direction, desc.resolution, caster_bounds);
+			out_cascades[cascade_index].split_near = splits[cascade_index];
+			out_cascades[cascade_index].split_far = splits[cascade_index + 1];
+		}
+	}
+
+	UInt CullShadowCasters(const ShadowCascade& cascade, const CullingBoundsSoA& bounds, UInt begin, UInt end, UByte* out_visibility)
+	{
+		// 近平面已延伸到所有投射体，正交视锥之外的物体不可能把阴影投进这个 cascade
+		return FrustumCullBoxes(cascade.frustum, bounds, begin, end, out_visibility);
+	}
+}
@@ -0,0 +1,97 @@
+#include "dolas_constant_buffer_arena.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Dolas
+{
+	UInt ConstantBufferArena::Allocate(UInt size)
+	{
+		if (size == 0)
+		{
+			return INVALID_BLOCK;
+		}
+
+		Block block;
+		block.offset = static_cast<UInt>(m_bytes.size());
+		block.size = size;
+		const UInt aligned_size = (size + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+		m_bytes.resize(m_bytes.size() + aligned_size, 0);
+
+		const UInt block_index = static_cast<UInt>(m_blocks.size());
+		m_blocks.push_back(block);
+		// GPU 端还没有这块的数据
+		MarkDirty(block_index, 0, size);
+		return block_index;
+	}
+
+	void ConstantBufferArena::Clear()
+	{
+		m_bytes.clear();
+		m_blocks.clear();
+		m_dirty_blocks.clear();
+	}
+
+	Bool ConstantBufferArena::Write(UInt block, ConstantBufferVariableHandle handle, const void* data, std::size_t size)
+	{
+		if (!IsValidBlock(block) || !handle.IsValid() || data == nullptr || handle.offset + handle.size > m_blocks[block].size)
+		{
+			return false;
+		}
+
+		const UInt copy_bytes = static_cast<UInt>(std::min<std::size_t>(size, handle.size));
+		UByte* destination = m_bytes.data() + m_blocks[block].offset + handle.offset;
+		if (copy_bytes == 0 || std::memcmp(destination, data, copy_bytes) == 0)
+		{
+			return false;
+		}
+		std::memcpy(destination, data, copy_bytes);
+		MarkDirty(block, handle.offset, handle.offset + copy_bytes);
+		return true;
+	}
+
+	void ConstantBufferArena::MarkDirty(UInt block, UInt begin, UInt end)
+	{
+		Block& target = m_blocks[block];
+		if (target.dirty_end > target.dirty_begin)
+		{
+			target.dirty_begin = std::min(target.dirty_begin, begin);
+			target.dirty_end = std::max(target.dirty_end, end);
+		}
+		else
+		{
+			target.dirty_begin = begin;
+			target.dirty_end = end;
+			m_dirty_blocks.push_back(block);
+		}
+	}
+
+	void ConstantBufferArena::TakeDirtyRanges(std::vector<ConstantBufferRange>& out_ranges)
+	{
+		out_ranges.clear();
+		out_ranges.reserve(m_dirty_blocks.size());
+		for (UInt block_index : m_dirty_blocks)
+		{
+			Block& block = m_blocks[block_index];
+			out_ranges.push_back({ block.offset + block.dirty_begin, block.offset + block.dirty_end });
+			block.dirty_begin = 0;
+			block.dirty_end = 0;
+		}
+		m_dirty_blocks.clear();
+
+		// 加载阶段连续分配的材质会产生大量相邻区间，合并后每段只需要一次拷贝
+		std::sort(out_ranges.begin(), out_ranges.end(), [](const ConstantBufferRange& a, const ConstantBufferRange& b) { return a.begin < b.begin; });
+		std::size_t merged_count = 0;
+		for (const ConstantBufferRange& range : out_ranges)
+		{
+			if (merged_count > 0 && range.begin <= out_ranges[merged_count - 1].end)
+			{
+				out_ranges[merged_count - 1].end = std::max(out_ranges[merged_count - 1].end, range.end);
+			}
+			else
+			{
+				out_ranges[merged_count++] = range;
+			}
+		}
+		out_ranges.resize(merged_count);
+	}
+}
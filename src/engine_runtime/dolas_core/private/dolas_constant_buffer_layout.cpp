@@ -0,0 +1,75 @@
+#include "dolas_constant_buffer_layout.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Dolas
+{
+	Bool ConstantBufferLayout::Build(const ConstantBufferInfo& info)
+	{
+		Clear();
+		m_size = info.size;
+		m_variables.reserve(info.variable_descs.size());
+
+		Bool unique = true;
+		for (const ConstantBufferVariableInfo& variable : info.variable_descs)
+		{
+			// 越界的变量来自损坏的反射数据，写入时会越过 CPU 缓冲区
+			if (variable.size == 0 || variable.start_offset + variable.size > info.size)
+			{
+				continue;
+			}
+			const ConstantBufferVariableHandle handle{ variable.start_offset, variable.size };
+			unique = m_variables.emplace(HashConverter::StringHash(variable.name), handle).second && unique;
+		}
+		return unique;
+	}
+
+	void ConstantBufferLayout::Clear()
+	{
+		m_variables.clear();
+		m_size = 0;
+	}
+
+	ConstantBufferVariableHandle ConstantBufferLayout::FindVariable(UInt name_id) const
+	{
+		auto it = m_variables.find(name_id);
+		return it != m_variables.end() ? it->second : ConstantBufferVariableHandle{};
+	}
+
+	void ConstantBufferData::Resize(UInt size)
+	{
+		m_bytes.assign(size, 0);
+		m_dirty_begin = 0;
+		m_dirty_end = size;
+	}
+
+	Bool ConstantBufferData::Write(ConstantBufferVariableHandle handle, const void* data, std::size_t size)
+	{
+		if (!handle.IsValid() || data == nullptr || handle.offset + handle.size > m_bytes.size())
+		{
+			return false;
+		}
+
+		const UInt copy_bytes = static_cast<UInt>(std::min<std::size_t>(size, handle.size));
+		UByte* destination = m_bytes.data() + handle.offset;
+		// 材质参数与大部分 per-pass 常量每帧写入的值都不变，比较一次可以省掉整次上传
+		if (copy_bytes == 0 || std::memcmp(destination, data, copy_bytes) == 0)
+		{
+			return false;
+		}
+		std::memcpy(destination, data, copy_bytes);
+
+		const UInt end = handle.offset + copy_bytes;
+		if (IsDirty())
+		{
+			m_dirty_begin = std::min(m_dirty_begin, handle.offset);
+			m_dirty_end = std::max(m_dirty_end, end);
+		}
+		else
+		{
+			m_dirty_begin = handle.offset;
+			m_dirty_end = end;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,278 @@
+#include "dolas_cubemap.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace Dolas
+{
+	namespace
+	{
+		constexpr Double kPi = 3.14159265358979323846;
+
+		void Run(const TextureCookParallelFor& parallel_for, UInt count, const std::function<void(UInt, UInt)>& task)
+		{
+			if (parallel_for)
+			{
+				parallel_for(count, task);
+			}
+			else
+			{
+				task(0, count);
+			}
+		}
+
+		// [begin, end) 是六个面首尾相接的行下标，拆成每个面内的连续区间
+		void ForEachFaceRows(UInt rows_per_face, UInt begin, UInt end, const std::function<void(UInt face, UInt row_begin, UInt row_end)>& function)
+		{
+			while (begin < end)
+			{
+				const UInt face = begin / rows_per_face;
+				const UInt face_end = std::min(end, (face + 1) * rows_per_face);
+				function(face, begin - face * rows_per_face, face_end - face * rows_per_face);
+				begin = face_end;
+			}
+		}
+
+		// 面上 [-1, 1]^2 中从原点到 (x, y) 的矩形投影到单位球上的面积
+		Double AreaElement(Double x, Double y)
+		{
+			return std::atan2(x * y, std::sqrt(x * x + y * y + 1.0));
+		}
+
+		UInt FloorPowerOfTwo(UInt value)
+		{
+			UInt result = 1;
+			while (result <= value / 2)
+			{
+				result <<= 1;
+			}
+			return result;
+		}
+	}
+
+	void ComputeCubemapDirection(UInt face, Float s, Float t, Float out_direction[3])
+	{
+		Float x = 0.0f;
+		Float y = 0.0f;
+		Float z = 0.0f;
+		switch (static_cast<CubeFace>(face))
+		{
+		case CubeFace::PositiveX: x = 1.0f;  y = -t;    z = -s;    break;
+		case CubeFace::NegativeX: x = -1.0f; y = -t;    z = s;     break;
+		case CubeFace::PositiveY: x = s;     y = 1.0f;  z = t;     break;
+		case CubeFace::NegativeY: x = s;     y = -1.0f; z = -t;    break;
+		case CubeFace::PositiveZ: x = s;     y = -t;    z = 1.0f;  break;
+		case CubeFace::NegativeZ:
+		default:                  x = -s;    y = -t;    z = -1.0f; break;
+		}
+		const Float inverse_length = 1.0f / std::sqrt(x * x + y * y + z * z);
+		out_direction[0] = x * inverse_length;
+		out_direction[1] = y * inverse_length;
+		out_direction[2] = z * inverse_length;
+	}
+
+	Float ComputeCubemapTexelSolidAngle(UInt x, UInt y, UInt face_size)
+	{
+		const Double texel = 2.0 / face_size;
+		const Double x0 = -1.0 + x * texel;
+		const Double y0 = -1.0 + y * texel;
+		const Double x1 = x0 + texel;
+		const Double y1 = y0 + texel;
+		return static_cast<Float>(AreaElement(x0, y0) - AreaElement(x0, y1) - AreaElement(x1, y0) + AreaElement(x1, y1));
+	}
+
+	void ComputeEquirectUV(const Float direction[3], Float& out_u, Float& out_v)
+	{
+		const Float theta = std::acos(std::clamp(direction[2], -1.0f, 1.0f));
+		const Float phi = std::atan2(direction[1], direction[0]);
+		out_u = phi / static_cast<Float>(2.0 * kPi) + 0.5f;
+		out_v = theta / static_cast<Float>(kPi);
+	}
+
+	void SampleEquirect(const TextureImage& equirect, Float u, Float v, Float out_color[4])
+	{
+		const Float px = u * equirect.width - 0.5f;
+		const Float py = v * equirect.height - 0.5f;
+		const Float fx0 = std::floor(px);
+		const Float fy0 = std::floor(py);
+		const Float fx = px - fx0;
+		const Float fy = py - fy0;
+
+		const Int width = static_cast<Int>(equirect.width);
+		const Int height = static_cast<Int>(equirect.height);
+		const Int x0 = ((static_cast<Int>(fx0) % width) + width) % width;
+		const Int x1 = (x0 + 1) % width;
+		const Int y0 = std::clamp(static_cast<Int>(fy0), 0, height - 1);
+		const Int y1 = std::clamp(static_cast<Int>(fy0) + 1, 0, height - 1);
+
+		const Float* p00 = equirect.GetPixel(x0, y0);
+		const Float* p10 = equirect.GetPixel(x1, y0);
+		const Float* p01 = equirect.GetPixel(x0, y1);
+		const Float* p11 = equirect.GetPixel(x1, y1);
+		for (UInt c = 0; c < 4; ++c)
+		{
+			const Float top = p00[c] + (p10[c] - p00[c]) * fx;
+			const Float bottom = p01[c] + (p11[c] - p01[c]) * fx;
+			out_color[c] = top + (bottom - top) * fy;
+		}
+	}
+
+	void ConvertEquirectToCubemapRows(const TextureImage& equirect, UInt face, UInt samples_per_axis, UInt row_begin, UInt row_end, TextureImage& out_face)
+	{
+		const UInt face_size = out_face.width;
+		const UInt sample_count = std::max(1u, samples_per_axis);
+		const Float texel = 2.0f / face_size;
+		const Float weight = 1.0f / (sample_count * sample_count);
+		for (UInt y = row_begin; y < row_end; ++y)
+		{
+			for (UInt x = 0; x < face_size; ++x)
+			{
+				Float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+				for (UInt j = 0; j < sample_count; ++j)
+				{
+					const Float t = -1.0f + (y + (j + 0.5f) / sample_count) * texel;
+					for (UInt i = 0; i < sample_count; ++i)
+					{
+						const Float s = -1.0f + (x + (i + 0.5f) / sample_count) * texel;
+						Float direction[3];
+						ComputeCubemapDirection(face, s, t, direction);
+						Float u = 0.0f;
+						Float v = 0.0f;
+						ComputeEquirectUV(direction, u, v);
+						Float color[4];
+						SampleEquirect(equirect, u, v, color);
+						for (UInt c = 0; c < 4; ++c)
+						{
+							sum[c] += color[c];
+						}
+					}
+				}
+				Float* pixel = out_face.GetPixel(x, y);
+				for (UInt c = 0; c < 4; ++c)
+				{
+					pixel[c] = sum[c] * weight;
+				}
+			}
+		}
+	}
+
+	void DownsampleCubemapFaceRows(const TextureImage& source, UInt row_begin, UInt row_end, TextureImage& destination)
+	{
+		const UInt source_size = source.width;
+		for (UInt y = row_begin; y < row_end; ++y)
+		{
+			for (UInt x = 0; x < destination.width; ++x)
+			{
+				Float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+				Float weight_sum = 0.0f;
+				for (UInt j = 0; j < 2; ++j)
+				{
+					const UInt source_y = std::min(y * 2 + j, source_size - 1);
+					for (UInt i = 0; i < 2; ++i)
+					{
+						const UInt source_x = std::min(x * 2 + i, source_size - 1);
+						const Float weight = ComputeCubemapTexelSolidAngle(source_x, source_y, source_size);
+						const Float* pixel = source.GetPixel(source_x, source_y);
+						for (UInt c = 0; c < 4; ++c)
+						{
+							sum[c] += pixel[c] * weight;
+						}
+						weight_sum += weight;
+					}
+				}
+				Float* pixel = destination.GetPixel(x, y);
+				for (UInt c = 0; c < 4; ++c)
+				{
+					pixel[c] = sum[c] / weight_sum;
+				}
+			}
+		}
+	}
+
+	Bool BuildCubemapFromEquirect(const TextureImage& equirect, const CubemapBuildSettings& settings, Cubemap& out_cubemap, const TextureCookParallelFor& parallel_for /*= {}*/)
+	{
+		if (equirect.IsEmpty() || equirect.pixels.size() < static_cast<std::size_t>(equirect.width) * equirect.height * 4)
+		{
+			return false;
+		}
+
+		// 按 2 的幂取整，每一级 mip 都是上一级的一半，降采样的 2x2 纹素总是落在同一个面内
+		const UInt face_size = FloorPowerOfTwo(settings.face_size > 0 ? settings.face_size : std::max(1u, equirect.width / 4));
+		UInt mip_count = ComputeFullMipCount(face_size, face_size);
+		if (settings.max_mip_count > 0)
+		{
+			mip_count = std::min(mip_count, settings.max_mip_count);
+		}
+
+		out_cubemap.face_size = face_size;
+		out_cubemap.mip_count = mip_count;
+		out_cubemap.faces.assign(CUBE_FACE_COUNT * mip_count, {});
+		for (UInt face = 0; face < CUBE_FACE_COUNT; ++face)
+		{
+			for (UInt mip = 0; mip < mip_count; ++mip)
+			{
+				const UInt size = std::max(1u, face_size >> mip);
+				out_cubemap.GetFace(face, mip).Resize(size, size);
+			}
+		}
+
+		Run(parallel_for, CUBE_FACE_COUNT * face_size, [&](UInt begin, UInt end)
+		{
+			ForEachFaceRows(face_size, begin, end, [&](UInt face, UInt row_begin, UInt row_end)
+			{
+				ConvertEquirectToCubemapRows(equirect, face, settings.samples_per_axis, row_begin, row_end, out_cubemap.GetFace(face, 0));
+			});
+		});
+
+		for (UInt mip = 1; mip < mip_count; ++mip)
+		{
+			const UInt size = std::max(1u, face_size >> mip);
+			Run(parallel_for, CUBE_FACE_COUNT * size, [&](UInt begin, UInt end)
+			{
+				ForEachFaceRows(size, begin, end, [&](UInt face, UInt row_begin, UInt row_end)
+				{
+					DownsampleCubemapFaceRows(out_cubemap.GetFace(face, mip - 1), row_begin, row_end, out_cubemap.GetFace(face, mip));
+				});
+			});
+		}
+		return true;
+	}
+
+	Bool CookCubemap(const Cubemap& cubemap, CookedTexture& out_texture, const TextureCookParallelFor& parallel_for /*= {}*/)
+	{
+		if (cubemap.face_size == 0 || cubemap.mip_count == 0 || cubemap.faces.size() != static_cast<std::size_t>(CUBE_FACE_COUNT) * cubemap.mip_count)
+		{
+			return false;
+		}
+
+		out_texture.format = BlockFormat::BC6H;
+		out_texture.width = cubemap.face_size;
+		out_texture.height = cubemap.face_size;
+		out_texture.face_count = CUBE_FACE_COUNT;
+		out_texture.mips.assign(CUBE_FACE_COUNT * cubemap.mip_count, {});
+		out_texture.mip_milliseconds = 0.0;
+		out_texture.encoded_texel_count = 0;
+
+		const auto encode_start_time = std::chrono::high_resolution_clock::now();
+		for (UInt mip = 0; mip < cubemap.mip_count; ++mip)
+		{
+			const UInt size = std::max(1u, cubemap.face_size >> mip);
+			const UInt block_rows = (size + 3) / 4;
+			for (UInt face = 0; face < CUBE_FACE_COUNT; ++face)
+			{
+				out_texture.mips[face * cubemap.mip_count + mip].resize(static_cast<std::size_t>(ComputeBlockCompressedSize(out_texture.format, size, size)));
+			}
+			Run(parallel_for, CUBE_FACE_COUNT * block_rows, [&](UInt begin, UInt end)
+			{
+				ForEachFaceRows(block_rows, begin, end, [&](UInt face, UInt row_begin, UInt row_end)
+				{
+					const TextureImage& level = cubemap.GetFace(face, mip);
+					CompressBlockRows(out_texture.format, level.pixels.data(), level.width, level.height, row_begin, row_end, out_texture.mips[face * cubemap.mip_count + mip].data());
+				});
+			});
+			out_texture.encoded_texel_count += static_cast<ULongLong>(size) * size * CUBE_FACE_COUNT;
+		}
+		out_texture.encode_milliseconds = std::chrono::duration<Double, std::milli>(std::chrono::high_resolution_clock::now() - encode_start_time).count();
+		return true;
+	}
+}
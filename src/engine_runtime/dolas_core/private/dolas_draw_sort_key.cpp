@@ -0,0 +1,137 @@
+#include "dolas_draw_sort_key.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Dolas
+{
+	namespace
+	{
+		constexpr ULongLong MaskOf(UInt bits)
+		{
+			return (bits >= 64) ? ~0ull : ((1ull << bits) - 1ull);
+		}
+
+		ULongLong Saturate(UInt value, UInt bits)
+		{
+			const ULongLong max_value = MaskOf(bits);
+			return (static_cast<ULongLong>(value) > max_value) ? max_value : static_cast<ULongLong>(value);
+		}
+
+		constexpr UInt kRadixBits = 8;
+		constexpr UInt kRadixBuckets = 1u << kRadixBits;
+		constexpr UInt kRadixPasses = 64 / kRadixBits;
+	}
+
+	ULongLong DrawSortKey::Encode(UInt pass, UInt pipeline, UInt material, UInt mesh, UInt depth)
+	{
+		ULongLong key = 0;
+		key |= Saturate(pass, PASS_BITS) << PASS_SHIFT;
+		key |= Saturate(pipeline, PIPELINE_BITS) << PIPELINE_SHIFT;
+		key |= Saturate(material, MATERIAL_BITS) << MATERIAL_SHIFT;
+		key |= Saturate(mesh, MESH_BITS) << MESH_SHIFT;
+		key |= Saturate(depth, DEPTH_BITS) << DEPTH_SHIFT;
+		return key;
+	}
+
+	ULongLong DrawSortKey::EncodeDepthFirst(UInt pass, UInt pipeline, UInt depth, UInt mesh)
+	{
+		static_assert(DEPTH_BITS == MATERIAL_BITS, "depth-first keys store the depth in the material field");
+		return Encode(pass, pipeline, depth, mesh, 0);
+	}
+
+	UInt DrawSortKey::GetPass(ULongLong key)
+	{
+		return static_cast<UInt>((key >> PASS_SHIFT) & MaskOf(PASS_BITS));
+	}
+
+	UInt DrawSortKey::GetPipeline(ULongLong key)
+	{
+		return static_cast<UInt>((key >> PIPELINE_SHIFT) & MaskOf(PIPELINE_BITS));
+	}
+
+	UInt DrawSortKey::GetMaterial(ULongLong key)
+	{
+		return static_cast<UInt>((key >> MATERIAL_SHIFT) & MaskOf(MATERIAL_BITS));
+	}
+
+	UInt DrawSortKey::GetMesh(ULongLong key)
+	{
+		return static_cast<UInt>((key >> MESH_SHIFT) & MaskOf(MESH_BITS));
+	}
+
+	UInt DrawSortKey::GetDepth(ULongLong key)
+	{
+		return static_cast<UInt>((key >> DEPTH_SHIFT) & MaskOf(DEPTH_BITS));
+	}
+
+	UInt DrawSortKey::QuantizeDepth(Float view_depth, Float near_plane, Float far_plane, Bool front_to_back /*= true*/)
+	{
+		const Float range = far_plane - near_plane;
+		Float normalized = (range > 0.0f) ? (view_depth - near_plane) / range : 0.0f;
+		normalized = std::clamp(normalized, 0.0f, 1.0f);
+		if (!front_to_back)
+		{
+			normalized = 1.0f - normalized;
+		}
+
+		const Float max_value = static_cast<Float>(MaskOf(DEPTH_BITS));
+		return static_cast<UInt>(normalized * max_value + 0.5f);
+	}
+
+	void RadixSortDrawEntries(std::vector<DrawSortEntry>& entries, std::vector<DrawSortEntry>& scratch)
+	{
+		const std::size_t count = entries.size();
+		if (count < 2)
+		{
+			return;
+		}
+		scratch.resize(count);
+
+		// 一次遍历统计 8 趟的直方图
+		UInt histograms[kRadixPasses][kRadixBuckets];
+		std::memset(histograms, 0, sizeof(histograms));
+		for (const DrawSortEntry& entry : entries)
+		{
+			for (UInt pass = 0; pass < kRadixPasses; ++pass)
+			{
+				const UInt byte = static_cast<UInt>((entry.m_key >> (pass * kRadixBits)) & (kRadixBuckets - 1));
+				++histograms[pass][byte];
+			}
+		}
+
+		DrawSortEntry* src = entries.data();
+		DrawSortEntry* dst = scratch.data();
+		for (UInt pass = 0; pass < kRadixPasses; ++pass)
+		{
+			UInt* histogram = histograms[pass];
+
+			// 该字节上所有 key 都相同，这一趟不会改变顺序
+			const UInt first_byte = static_cast<UInt>((src[0].m_key >> (pass * kRadixBits)) & (kRadixBuckets - 1));
+			if (histogram[first_byte] == count)
+			{
+				continue;
+			}
+
+			UInt offset = 0;
+			for (UInt bucket = 0; bucket < kRadixBuckets; ++bucket)
+			{
+				const UInt bucket_count = histogram[bucket];
+				histogram[bucket] = offset;
+				offset += bucket_count;
+			}
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const UInt byte = static_cast<UInt>((src[i].m_key >> (pass * kRadixBits)) & (kRadixBuckets - 1));
+				dst[histogram[byte]++] = src[i];
+			}
+			std::swap(src, dst);
+		}
+
+		// 奇数趟时结果落在 scratch 中
+		if (src != entries.data())
+		{
+			entries.swap(scratch);
+		}
+	}
+}
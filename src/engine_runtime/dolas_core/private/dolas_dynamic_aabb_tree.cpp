@@ -0,0 +1,379 @@
+#include "dolas_dynamic_aabb_tree.h"
+#include <algorithm>
+
+namespace Dolas
+{
+	DynamicAABBTree::DynamicAABBTree(Float fat_margin /*= 0.1f*/) : m_fat_margin(fat_margin)
+	{
+	}
+
+	void DynamicAABBTree::Clear()
+	{
+		m_nodes.clear();
+		m_root = NULL_NODE;
+		m_free_list = NULL_NODE;
+		m_node_count = 0;
+		m_proxy_count = 0;
+	}
+
+	Int DynamicAABBTree::Insert(const BoundingBox& box, ULongLong user_data)
+	{
+		const Int proxy_id = AllocateNode();
+		TreeNode& node = m_nodes[proxy_id];
+		const Vector3 margin(m_fat_margin, m_fat_margin, m_fat_margin);
+		node.box = BoundingBox(box.min_point - margin, box.max_point + margin);
+		node.user_data = user_data;
+		node.height = 0;
+		InsertLeaf(proxy_id);
+		++m_proxy_count;
+		return proxy_id;
+	}
+
+	void DynamicAABBTree::Remove(Int proxy_id)
+	{
+		if (proxy_id < 0 || proxy_id >= static_cast<Int>(m_nodes.size()) || !m_nodes[proxy_id].IsLeaf() || m_nodes[proxy_id].height < 0)
+		{
+			return;
+		}
+		RemoveLeaf(proxy_id);
+		FreeNode(proxy_id);
+		--m_proxy_count;
+	}
+
+	Bool DynamicAABBTree::Refit(Int proxy_id, const BoundingBox& box)
+	{
+		if (proxy_id < 0 || proxy_id >= static_cast<Int>(m_nodes.size()) || !m_nodes[proxy_id].IsLeaf() || m_nodes[proxy_id].height < 0)
+		{
+			return false;
+		}
+
+		if (m_nodes[proxy_id].box.Contains(box))
+		{
+			return false;
+		}
+
+		RemoveLeaf(proxy_id);
+		const Vector3 margin(m_fat_margin, m_fat_margin, m_fat_margin);
+		m_nodes[proxy_id].box = BoundingBox(box.min_point - margin, box.max_point + margin);
+		InsertLeaf(proxy_id);
+		return true;
+	}
+
+	Float DynamicAABBTree::GetAreaRatio() const
+	{
+		if (m_root == NULL_NODE)
+		{
+			return 0.0f;
+		}
+
+		const Float root_area = m_nodes[m_root].box.GetSurfaceArea();
+		if (root_area <= 0.0f)
+		{
+			return 0.0f;
+		}
+
+		Float total_area = 0.0f;
+		for (const TreeNode& node : m_nodes)
+		{
+			if (node.height >= 0)
+			{
+				total_area += node.box.GetSurfaceArea();
+			}
+		}
+		return total_area / root_area;
+	}
+
+	Bool DynamicAABBTree::Validate() const
+	{
+		if (m_root == NULL_NODE)
+		{
+			return m_proxy_count == 0 && m_node_count == 0;
+		}
+		if (m_nodes[m_root].parent != NULL_NODE)
+		{
+			return false;
+		}
+
+		UInt leaf_count = 0;
+		if (ValidateSubtree(m_root, leaf_count) < 0)
+		{
+			return false;
+		}
+		return leaf_count == m_proxy_count && m_node_count == leaf_count * 2 - 1;
+	}
+
+	Int DynamicAABBTree::ValidateSubtree(Int node_index, UInt& out_leaf_count) const
+	{
+		const TreeNode& node = m_nodes[node_index];
+		if (node.IsLeaf())
+		{
+			++out_leaf_count;
+			return node.height == 0 ? 0 : -1;
+		}
+
+		const TreeNode& child1 = m_nodes[node.child1];
+		const TreeNode& child2 = m_nodes[node.child2];
+		if (child1.parent != node_index || child2.parent != node_index)
+		{
+			return -1;
+		}
+		if (!node.box.Contains(child1.box) || !node.box.Contains(child2.box))
+		{
+			return -1;
+		}
+
+		const Int height1 = ValidateSubtree(node.child1, out_leaf_count);
+		const Int height2 = ValidateSubtree(node.child2, out_leaf_count);
+		if (height1 < 0 || height2 < 0 || node.height != 1 + std::max(height1, height2))
+		{
+			return -1;
+		}
+		return node.height;
+	}
+
+	Int DynamicAABBTree::AllocateNode()
+	{
+		Int node_index = m_free_list;
+		if (node_index == NULL_NODE)
+		{
+			node_index = static_cast<Int>(m_nodes.size());
+			m_nodes.emplace_back();
+		}
+		else
+		{
+			m_free_list = m_nodes[node_index].parent;
+		}
+
+		m_nodes[node_index] = TreeNode();
+		++m_node_count;
+		return node_index;
+	}
+
+	void DynamicAABBTree::FreeNode(Int node_index)
+	{
+		TreeNode& node = m_nodes[node_index];
+		node.parent = m_free_list;
+		node.child1 = NULL_NODE;
+		node.child2 = NULL_NODE;
+		node.height = -1;
+		m_free_list = node_index;
+		--m_node_count;
+	}
+
+	void DynamicAABBTree::InsertLeaf(Int leaf)
+	{
+		if (m_root == NULL_NODE)
+		{
+			m_root = leaf;
+			m_nodes[leaf].parent = NULL_NODE;
+			return;
+		}
+
+		// SAH 下降：比较"在当前节点处创建新父节点"与"继续下降到某个子节点"的表面积代价
+		const BoundingBox leaf_box = m_nodes[leaf].box;
+		Int index = m_root;
+		while (!m_nodes[index].IsLeaf())
+		{
+			const TreeNode& node = m_nodes[index];
+			const Float area = node.box.GetSurfaceArea();
+			const Float combined_area = BoundingBox::Union(node.box, leaf_box).GetSurfaceArea();
+
+			const Float cost = 2.0f * combined_area;
+			// 下降时所有祖先都会因为新叶子而扩大
+			const Float inheritance_cost = 2.0f * (combined_area - area);
+
+			auto descend_cost = [this, &leaf_box, inheritance_cost](Int child_index)
+			{
+				const TreeNode& child = m_nodes[child_index];
+				const Float union_area = BoundingBox::Union(child.box, leaf_box).GetSurfaceArea();
+				return child.IsLeaf() ? union_area + inheritance_cost : union_area - child.box.GetSurfaceArea() + inheritance_cost;
+			};
+			const Float cost1 = descend_cost(node.child1);
+			const Float cost2 = descend_cost(node.child2);
+
+			if (cost < cost1 && cost < cost2)
+			{
+				break;
+			}
+			index = cost1 < cost2 ? node.child1 : node.child2;
+		}
+
+		const Int sibling = index;
+		const Int old_parent = m_nodes[sibling].parent;
+		const Int new_parent = AllocateNode();
+		m_nodes[new_parent].parent = old_parent;
+		m_nodes[new_parent].box = BoundingBox::Union(leaf_box, m_nodes[sibling].box);
+		m_nodes[new_parent].height = m_nodes[sibling].height + 1;
+		m_nodes[new_parent].child1 = sibling;
+		m_nodes[new_parent].child2 = leaf;
+		m_nodes[sibling].parent = new_parent;
+		m_nodes[leaf].parent = new_parent;
+
+		if (old_parent == NULL_NODE)
+		{
+			m_root = new_parent;
+		}
+		else if (m_nodes[old_parent].child1 == sibling)
+		{
+			m_nodes[old_parent].child1 = new_parent;
+		}
+		else
+		{
+			m_nodes[old_parent].child2 = new_parent;
+		}
+
+		RefitAncestors(m_nodes[leaf].parent);
+	}
+
+	void DynamicAABBTree::RemoveLeaf(Int leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = NULL_NODE;
+			return;
+		}
+
+		// 兄弟节点顶替父节点的位置，父节点回收
+		const Int parent = m_nodes[leaf].parent;
+		const Int grand_parent = m_nodes[parent].parent;
+		const Int sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+		if (grand_parent == NULL_NODE)
+		{
+			m_root = sibling;
+			m_nodes[sibling].parent = NULL_NODE;
+			FreeNode(parent);
+			return;
+		}
+
+		if (m_nodes[grand_parent].child1 == parent)
+		{
+			m_nodes[grand_parent].child1 = sibling;
+		}
+		else
+		{
+			m_nodes[grand_parent].child2 = sibling;
+		}
+		m_nodes[sibling].parent = grand_parent;
+		FreeNode(parent);
+
+		RefitAncestors(grand_parent);
+	}
+
+	void DynamicAABBTree::RefitAncestors(Int node_index)
+	{
+		while (node_index != NULL_NODE)
+		{
+			UpdateNode(node_index);
+			Rotate(node_index);
+			node_index = m_nodes[node_index].parent;
+		}
+	}
+
+	void DynamicAABBTree::UpdateNode(Int node_index)
+	{
+		TreeNode& node = m_nodes[node_index];
+		const TreeNode& child1 = m_nodes[node.child1];
+		const TreeNode& child2 = m_nodes[node.child2];
+		node.box = BoundingBox::Union(child1.box, child2.box);
+		node.height = 1 + std::max(child1.height, child2.height);
+	}
+
+	void DynamicAABBTree::Rotate(Int node_index)
+	{
+		// node 的子节点为 B、C；B 的子节点为 D、E，C 的子节点为 F、G。
+		// 候选：B<->F、B<->G（改变 C 的包围盒）、C<->D、C<->E（改变 B 的包围盒），
+		// node 自身的包围盒不变，选择能最多减少被改变节点表面积的一种
+		const TreeNode& node = m_nodes[node_index];
+		const Int b = node.child1;
+		const Int c = node.child2;
+		const TreeNode& node_b = m_nodes[b];
+		const TreeNode& node_c = m_nodes[c];
+		if (node_b.IsLeaf() && node_c.IsLeaf())
+		{
+			return;
+		}
+
+		enum RotateType { RotateType_None, RotateType_BF, RotateType_BG, RotateType_CD, RotateType_CE };
+		RotateType best_rotate = RotateType_None;
+		Float best_cost_delta = 0.0f;
+
+		if (!node_c.IsLeaf())
+		{
+			const Float area_c = node_c.box.GetSurfaceArea();
+			const Float cost_bf = BoundingBox::Union(node_b.box, m_nodes[node_c.child2].box).GetSurfaceArea() - area_c;
+			const Float cost_bg = BoundingBox::Union(node_b.box, m_nodes[node_c.child1].box).GetSurfaceArea() - area_c;
+			if (cost_bf < best_cost_delta)
+			{
+				best_rotate = RotateType_BF;
+				best_cost_delta = cost_bf;
+			}
+			if (cost_bg < best_cost_delta)
+			{
+				best_rotate = RotateType_BG;
+				best_cost_delta = cost_bg;
+			}
+		}
+		if (!node_b.IsLeaf())
+		{
+			const Float area_b = node_b.box.GetSurfaceArea();
+			const Float cost_cd = BoundingBox::Union(node_c.box, m_nodes[node_b.child2].box).GetSurfaceArea() - area_b;
+			const Float cost_ce = BoundingBox::Union(node_c.box, m_nodes[node_b.child1].box).GetSurfaceArea() - area_b;
+			if (cost_cd < best_cost_delta)
+			{
+				best_rotate = RotateType_CD;
+				best_cost_delta = cost_cd;
+			}
+			if (cost_ce < best_cost_delta)
+			{
+				best_rotate = RotateType_CE;
+				best_cost_delta = cost_ce;
+			}
+		}
+
+		// 把 node 的直接子节点 child 与孙节点 grand_child（属于 other）交换
+		auto swap_with_grand_child = [this, node_index](Int child, Int other, Int grand_child)
+		{
+			TreeNode& parent_node = m_nodes[node_index];
+			TreeNode& other_node = m_nodes[other];
+			if (parent_node.child1 == child)
+			{
+				parent_node.child1 = grand_child;
+			}
+			else
+			{
+				parent_node.child2 = grand_child;
+			}
+			if (other_node.child1 == grand_child)
+			{
+				other_node.child1 = child;
+			}
+			else
+			{
+				other_node.child2 = child;
+			}
+			m_nodes[grand_child].parent = node_index;
+			m_nodes[child].parent = other;
+			UpdateNode(other);
+			UpdateNode(node_index);
+		};
+
+		switch (best_rotate)
+		{
+		case RotateType_BF:
+			swap_with_grand_child(b, c, m_nodes[c].child1);
+			break;
+		case RotateType_BG:
+			swap_with_grand_child(b, c, m_nodes[c].child2);
+			break;
+		case RotateType_CD:
+			swap_with_grand_child(c, b, m_nodes[b].child1);
+			break;
+		case RotateType_CE:
+			swap_with_grand_child(c, b, m_nodes[b].child2);
+			break;
+		default:
+			break;
+		}
+	}
+}
@@ -0,0 +1,240 @@
+#include "dolas_frustum_culling.h"
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define DOLAS_FRUSTUM_CULLING_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DOLAS_FRUSTUM_CULLING_SSE 1
+#endif
+
+namespace Dolas
+{
+	namespace
+	{
+		// 空盒的半长：与任何单位法线的点积都远小于场景坐标，保证被剔除，又不会像无穷大那样产生 0 * inf
+		constexpr Float kEmptyBoxExtent = -1.0e30f;
+
+		// 与 SIMD 路径使用相同的运算顺序，保证结果逐位一致
+		inline Bool IsBoxVisible(const Frustum& frustum, Float center_x, Float center_y, Float center_z, Float extent_x, Float extent_y, Float extent_z)
+		{
+			for (const Vector4& plane : frustum.planes)
+			{
+				const Float distance = ((plane.x * center_x + plane.y * center_y) + plane.z * center_z) + plane.w;
+				const Float radius = (std::fabs(plane.x) * extent_x + std::fabs(plane.y) * extent_y) + std::fabs(plane.z) * extent_z;
+				if (distance < 0.0f - radius)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		UInt CullBoxesTail(const Frustum& frustum, const CullingBoundsSoA& bounds, UInt begin, UInt end, UByte* out_visibility)
+		{
+			UInt visible_count = 0;
+			for (UInt index = begin; index < end; ++index)
+			{
+				const Bool visible = IsBoxVisible(frustum,
+					bounds.GetCenterX()[index], bounds.GetCenterY()[index], bounds.GetCenterZ()[index],
+					bounds.GetExtentX()[index], bounds.GetExtentY()[index], bounds.GetExtentZ()[index]);
+				out_visibility[index] = visible ? 1 : 0;
+				visible_count += visible ? 1 : 0;
+			}
+			return visible_count;
+		}
+	}
+
+	void CullingBoundsSoA::Clear()
+	{
+		m_center_x.clear();
+		m_center_y.clear();
+		m_center_z.clear();
+		m_extent_x.clear();
+		m_extent_y.clear();
+		m_extent_z.clear();
+		m_count = 0;
+	}
+
+	void CullingBoundsSoA::Reserve(UInt count)
+	{
+		m_center_x.reserve(count);
+		m_center_y.reserve(count);
+		m_center_z.reserve(count);
+		m_extent_x.reserve(count);
+		m_extent_y.reserve(count);
+		m_extent_z.reserve(count);
+	}
+
+	UInt CullingBoundsSoA::Add(const BoundingBox& box)
+	{
+		const UInt index = m_count++;
+		m_center_x.push_back(0.0f);
+		m_center_y.push_back(0.0f);
+		m_center_z.push_back(0.0f);
+		m_extent_x.push_back(kEmptyBoxExtent);
+		m_extent_y.push_back(kEmptyBoxExtent);
+		m_extent_z.push_back(kEmptyBoxExtent);
+		Set(index, box);
+		return index;
+	}
+
+	void CullingBoundsSoA::Set(UInt index, const BoundingBox& box)
+	{
+		if (index >= m_count)
+		{
+			return;
+		}
+
+		if (!box.IsValid())
+		{
+			m_center_x[index] = 0.0f;
+			m_center_y[index] = 0.0f;
+			m_center_z[index] = 0.0f;
+			m_extent_x[index] = kEmptyBoxExtent;
+			m_extent_y[index] = kEmptyBoxExtent;
+			m_extent_z[index] = kEmptyBoxExtent;
+			return;
+		}
+
+		const Vector3 center = box.GetCenter();
+		const Vector3 extents = box.GetExtents();
+		m_center_x[index] = center.x;
+		m_center_y[index] = center.y;
+		m_center_z[index] = center.z;
+		m_extent_x[index] = extents.x;
+		m_extent_y[index] = extents.y;
+		m_extent_z[index] = extents.z;
+	}
+
+	FrustumCullingPath GetFrustumCullingPath()
+	{
+#if defined(DOLAS_FRUSTUM_CULLING_AVX)
+		return FrustumCullingPath::AVX;
+#elif defined(DOLAS_FRUSTUM_CULLING_SSE)
+		return FrustumCullingPath::SSE;
+#else
+		return FrustumCullingPath::Scalar;
+#endif
+	}
+
+	UInt FrustumCullBoxes(const Frustum& frustum, const CullingBoundsSoA& bounds, UInt begin, UInt end, UByte* out_visibility)
+	{
+		if (!out_visibility || end > bounds.GetCount() || begin >= end)
+		{
+			return 0;
+		}
+
+		const Float* center_x = bounds.GetCenterX();
+		const Float* center_y = bounds.GetCenterY();
+		const Float* center_z = bounds.GetCenterZ();
+		const Float* extent_x = bounds.GetExtentX();
+		const Float* extent_y = bounds.GetExtentY();
+		const Float* extent_z = bounds.GetExtentZ();
+		UInt visible_count = 0;
+		UInt index = begin;
+
+#if defined(DOLAS_FRUSTUM_CULLING_AVX)
+		constexpr UInt kLaneCount = 8;
+		__m256 plane_x[Frustum::PlaneIndex_COUNT], plane_y[Frustum::PlaneIndex_COUNT], plane_z[Frustum::PlaneIndex_COUNT], plane_w[Frustum::PlaneIndex_COUNT];
+		__m256 abs_x[Frustum::PlaneIndex_COUNT], abs_y[Frustum::PlaneIndex_COUNT], abs_z[Frustum::PlaneIndex_COUNT];
+		for (UInt plane_index = 0; plane_index < Frustum::PlaneIndex_COUNT; ++plane_index)
+		{
+			const Vector4& plane = frustum.planes[plane_index];
+			plane_x[plane_index] = _mm256_set1_ps(plane.x);
+			plane_y[plane_index] = _mm256_set1_ps(plane.y);
+			plane_z[plane_index] = _mm256_set1_ps(plane.z);
+			plane_w[plane_index] = _mm256_set1_ps(plane.w);
+			abs_x[plane_index] = _mm256_set1_ps(std::fabs(plane.x));
+			abs_y[plane_index] = _mm256_set1_ps(std::fabs(plane.y));
+			abs_z[plane_index] = _mm256_set1_ps(std::fabs(plane.z));
+		}
+
+		const __m256 zero = _mm256_setzero_ps();
+		for (; index + kLaneCount <= end; index += kLaneCount)
+		{
+			const __m256 cx = _mm256_loadu_ps(center_x + index);
+			const __m256 cy = _mm256_loadu_ps(center_y + index);
+			const __m256 cz = _mm256_loadu_ps(center_z + index);
+			const __m256 ex = _mm256_loadu_ps(extent_x + index);
+			const __m256 ey = _mm256_loadu_ps(extent_y + index);
+			const __m256 ez = _mm256_loadu_ps(extent_z + index);
+
+			__m256 outside = zero;
+			for (UInt plane_index = 0; plane_index < Frustum::PlaneIndex_COUNT; ++plane_index)
+			{
+				__m256 distance = _mm256_add_ps(_mm256_mul_ps(plane_x[plane_index], cx), _mm256_mul_ps(plane_y[plane_index], cy));
+				distance = _mm256_add_ps(_mm256_add_ps(distance, _mm256_mul_ps(plane_z[plane_index], cz)), plane_w[plane_index]);
+				__m256 radius = _mm256_add_ps(_mm256_mul_ps(abs_x[plane_index], ex), _mm256_mul_ps(abs_y[plane_index], ey));
+				radius = _mm256_add_ps(radius, _mm256_mul_ps(abs_z[plane_index], ez));
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, _mm256_sub_ps(zero, radius), _CMP_LT_OQ));
+			}
+
+			const Int outside_mask = _mm256_movemask_ps(outside);
+			for (UInt lane = 0; lane < kLaneCount; ++lane)
+			{
+				const UByte visible = ((outside_mask >> lane) & 1) ? 0 : 1;
+				out_visibility[index + lane] = visible;
+				visible_count += visible;
+			}
+		}
+#elif defined(DOLAS_FRUSTUM_CULLING_SSE)
+		constexpr UInt kLaneCount = 4;
+		__m128 plane_x[Frustum::PlaneIndex_COUNT], plane_y[Frustum::PlaneIndex_COUNT], plane_z[Frustum::PlaneIndex_COUNT], plane_w[Frustum::PlaneIndex_COUNT];
+		__m128 abs_x[Frustum::PlaneIndex_COUNT], abs_y[Frustum::PlaneIndex_COUNT], abs_z[Frustum::PlaneIndex_COUNT];
+		for (UInt plane_index = 0; plane_index < Frustum::PlaneIndex_COUNT; ++plane_index)
+		{
+			const Vector4& plane = frustum.planes[plane_index];
+			plane_x[plane_index] = _mm_set1_ps(plane.x);
+			plane_y[plane_index] = _mm_set1_ps(plane.y);
+			plane_z[plane_index] = _mm_set1_ps(plane.z);
+			plane_w[plane_index] = _mm_set1_ps(plane.w);
+			abs_x[plane_index] = _mm_set1_ps(std::fabs(plane.x));
+			abs_y[plane_index] = _mm_set1_ps(std::fabs(plane.y));
+			abs_z[plane_index] = _mm_set1_ps(std::fabs(plane.z));
+		}
+
+		const __m128 zero = _mm_setzero_ps();
+		for (; index + kLaneCount <= end; index += kLaneCount)
+		{
+			const __m128 cx = _mm_loadu_ps(center_x + index);
+			const __m128 cy = _mm_loadu_ps(center_y + index);
+			const __m128 cz = _mm_loadu_ps(center_z + index);
+			const __m128 ex = _mm_loadu_ps(extent_x + index);
+			const __m128 ey = _mm_loadu_ps(extent_y + index);
+			const __m128 ez = _mm_loadu_ps(extent_z + index);
+
+			__m128 outside = zero;
+			for (UInt plane_index = 0; plane_index < Frustum::PlaneIndex_COUNT; ++plane_index)
+			{
+				__m128 distance = _mm_add_ps(_mm_mul_ps(plane_x[plane_index], cx), _mm_mul_ps(plane_y[plane_index], cy));
+				distance = _mm_add_ps(_mm_add_ps(distance, _mm_mul_ps(plane_z[plane_index], cz)), plane_w[plane_index]);
+				__m128 radius = _mm_add_ps(_mm_mul_ps(abs_x[plane_index], ex), _mm_mul_ps(abs_y[plane_index], ey));
+				radius = _mm_add_ps(radius, _mm_mul_ps(abs_z[plane_index], ez));
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, _mm_sub_ps(zero, radius)));
+			}
+
+			const Int outside_mask = _mm_movemask_ps(outside);
+			for (UInt lane = 0; lane < kLaneCount; ++lane)
+			{
+				const UByte visible = ((outside_mask >> lane) & 1) ? 0 : 1;
+				out_visibility[index + lane] = visible;
+				visible_count += visible;
+			}
+		}
+#endif
+
+		// 不足一组 SIMD 宽度的尾部
+		return visible_count + CullBoxesTail(frustum, bounds, index, end, out_visibility);
+	}
+
+	UInt FrustumCullBoxesScalar(const Frustum& frustum, const CullingBoundsSoA& bounds, UInt begin, UInt end, UByte* out_visibility)
+	{
+		if (!out_visibility || end > bounds.GetCount() || begin >= end)
+		{
+			return 0;
+		}
+		return CullBoxesTail(frustum, bounds, begin, end, out_visibility);
+	}
+}
@@ -44,6 +44,22 @@ namespace Dolas
 		return hash;
 	}
 
+	ULongLong HashConverter::BytesHash64(const void* data, std::size_t size, ULongLong seed)
+	{
+		// Same FNV-1a scheme as StringHash, widened to 64 bits so content keys stay collision-free
+		// across thousands of shader/pipeline combinations
+		const ULongLong FNV_PRIME_64 = 1099511628211ULL;
+
+		ULongLong hash = seed;
+		const UByte* bytes = static_cast<const UByte*>(data);
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			hash ^= static_cast<ULongLong>(bytes[i]);
+			hash *= FNV_PRIME_64;
+		}
+		return hash;
+	}
+
 	//void HashConverter::RegisterString(const std::string& str)
 	//{
 	//	// Manually register a string for reverse lookup
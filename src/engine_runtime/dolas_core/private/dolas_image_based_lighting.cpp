@@ -0,0 +1,722 @@
+#include "dolas_image_based_lighting.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "dolas_hash.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DOLAS_IMAGE_BASED_LIGHTING_SSE 1
+#endif
+
+namespace Dolas
+{
+	namespace
+	{
+		constexpr Double kPi = 3.14159265358979323846;
+		// 积分算法或缓存内容改变时加 1，旧的缓存文件自然失效
+		constexpr UInt kCacheVersion = 1;
+		constexpr UByte kSHFileMagic[4] = { 'D', 'S', 'H', '2' };
+		constexpr UInt kSHFileVersion = 1;
+
+		// 基函数常数：1/(2√π), √(3/(4π)), √(15/π)/2, √(5/π)/4, √(15/π)/4
+		constexpr Float kSHBasis0 = 0.282094792f;
+		constexpr Float kSHBasis1 = 0.488602512f;
+		constexpr Float kSHBasis2 = 1.092548431f;
+		constexpr Float kSHBasis3 = 0.315391565f;
+		constexpr Float kSHBasis4 = 0.546274215f;
+		constexpr Float kSHBasisScale[SH_L2_COEFFICIENT_COUNT] = {
+			kSHBasis0, kSHBasis1, kSHBasis1, kSHBasis1, kSHBasis2, kSHBasis2, kSHBasis3, kSHBasis2, kSHBasis4 };
+
+		// 4 个 Float：一个 RGBA 纹素，或相邻的 4 个样本。SSE 与标量逐分量执行相同的 IEEE 运算，结果逐位一致
+#if defined(DOLAS_IMAGE_BASED_LIGHTING_SSE)
+		struct Float4
+		{
+			__m128 value;
+		};
+
+		inline Float4 Load4(const Float* data) { return { _mm_loadu_ps(data) }; }
+		inline void Store4(Float4 a, Float* data) { _mm_storeu_ps(data, a.value); }
+		inline Float4 Splat4(Float value) { return { _mm_set1_ps(value) }; }
+		inline Float4 operator+(Float4 a, Float4 b) { return { _mm_add_ps(a.value, b.value) }; }
+		inline Float4 operator-(Float4 a, Float4 b) { return { _mm_sub_ps(a.value, b.value) }; }
+		inline Float4 operator*(Float4 a, Float4 b) { return { _mm_mul_ps(a.value, b.value) }; }
+		inline Float4 operator/(Float4 a, Float4 b) { return { _mm_div_ps(a.value, b.value) }; }
+		inline Float4 Sqrt4(Float4 a) { return { _mm_sqrt_ps(a.value) }; }
+		inline Float4 Max4(Float4 a, Float4 b) { return { _mm_max_ps(a.value, b.value) }; }
+		// a > 0 的分量为 1，否则为 0
+		inline Float4 PositiveMask4(Float4 a) { return { _mm_and_ps(_mm_cmpgt_ps(a.value, _mm_setzero_ps()), _mm_set1_ps(1.0f)) }; }
+#else
+		struct Float4
+		{
+			Float value[4];
+		};
+
+		inline Float4 Load4(const Float* data) { return { { data[0], data[1], data[2], data[3] } }; }
+		inline void Store4(Float4 a, Float* data) { std::memcpy(data, a.value, sizeof(a.value)); }
+		inline Float4 Splat4(Float value) { return { { value, value, value, value } }; }
+		inline Float4 operator+(Float4 a, Float4 b) { return { { a.value[0] + b.value[0], a.value[1] + b.value[1], a.value[2] + b.value[2], a.value[3] + b.value[3] } }; }
+		inline Float4 operator-(Float4 a, Float4 b) { return { { a.value[0] - b.value[0], a.value[1] - b.value[1], a.value[2] - b.value[2], a.value[3] - b.value[3] } }; }
+		inline Float4 operator*(Float4 a, Float4 b) { return { { a.value[0] * b.value[0], a.value[1] * b.value[1], a.value[2] * b.value[2], a.value[3] * b.value[3] } }; }
+		inline Float4 operator/(Float4 a, Float4 b) { return { { a.value[0] / b.value[0], a.value[1] / b.value[1], a.value[2] / b.value[2], a.value[3] / b.value[3] } }; }
+		inline Float4 Sqrt4(Float4 a) { return { { std::sqrt(a.value[0]), std::sqrt(a.value[1]), std::sqrt(a.value[2]), std::sqrt(a.value[3]) } }; }
+		// 与 maxps 相同：a > b 时取 a，否则取 b
+		inline Float4 Max4(Float4 a, Float4 b)
+		{
+			return { { a.value[0] > b.value[0] ? a.value[0] : b.value[0], a.value[1] > b.value[1] ? a.value[1] : b.value[1],
+				a.value[2] > b.value[2] ? a.value[2] : b.value[2], a.value[3] > b.value[3] ? a.value[3] : b.value[3] } };
+		}
+		inline Float4 PositiveMask4(Float4 a)
+		{
+			return { { a.value[0] > 0.0f ? 1.0f : 0.0f, a.value[1] > 0.0f ? 1.0f : 0.0f, a.value[2] > 0.0f ? 1.0f : 0.0f, a.value[3] > 0.0f ? 1.0f : 0.0f } };
+		}
+#endif
+
+		// 固定的合并顺序
+		inline Float Sum4(Float4 a)
+		{
+			Float lanes[4];
+			Store4(a, lanes);
+			return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+		}
+
+		void Run(const TextureCookParallelFor& parallel_for, UInt count, const std::function<void(UInt, UInt)>& task)
+		{
+			if (parallel_for)
+			{
+				parallel_for(count, task);
+			}
+			else
+			{
+				task(0, count);
+			}
+		}
+
+		UInt FloorPowerOfTwo(UInt value)
+		{
+			UInt result = 1;
+			while (result <= value / 2)
+			{
+				result <<= 1;
+			}
+			return result;
+		}
+
+		// 按 D3D 的规则选择主轴所在的面，返回面上 [-1, 1] 的坐标（ComputeCubemapDirection 的逆）
+		void SelectCubemapFace(const Float direction[3], UInt& out_face, Float& out_s, Float& out_t)
+		{
+			const Float ax = std::fabs(direction[0]);
+			const Float ay = std::fabs(direction[1]);
+			const Float az = std::fabs(direction[2]);
+			if (ax >= ay && ax >= az)
+			{
+				out_face = direction[0] > 0.0f ? 0 : 1;
+				out_s = (direction[0] > 0.0f ? -direction[2] : direction[2]) / ax;
+				out_t = -direction[1] / ax;
+			}
+			else if (ay >= az)
+			{
+				out_face = direction[1] > 0.0f ? 2 : 3;
+				out_s = direction[0] / ay;
+				out_t = (direction[1] > 0.0f ? direction[2] : -direction[2]) / ay;
+			}
+			else
+			{
+				out_face = direction[2] > 0.0f ? 4 : 5;
+				out_s = (direction[2] > 0.0f ? direction[0] : -direction[0]) / az;
+				out_t = -direction[1] / az;
+			}
+		}
+
+		// 面内双线性，边缘 clamp（预积分的源数据在面之间是连续的，接缝处的误差远小于滤波核）
+		Float4 SampleFaceBilinear(const TextureImage& level, Float s, Float t)
+		{
+			const UInt size = level.width;
+			const Float max_coordinate = static_cast<Float>(size - 1);
+			const Float px = std::clamp((s + 1.0f) * 0.5f * size - 0.5f, 0.0f, max_coordinate);
+			const Float py = std::clamp((t + 1.0f) * 0.5f * size - 0.5f, 0.0f, max_coordinate);
+			const UInt x0 = static_cast<UInt>(px);
+			const UInt y0 = static_cast<UInt>(py);
+			const UInt x1 = std::min(x0 + 1, size - 1);
+			const UInt y1 = std::min(y0 + 1, size - 1);
+			const Float4 fx = Splat4(px - x0);
+			const Float4 fy = Splat4(py - y0);
+
+			const Float4 p00 = Load4(level.GetPixel(x0, y0));
+			const Float4 p10 = Load4(level.GetPixel(x1, y0));
+			const Float4 p01 = Load4(level.GetPixel(x0, y1));
+			const Float4 p11 = Load4(level.GetPixel(x1, y1));
+			const Float4 top = p00 + (p10 - p00) * fx;
+			const Float4 bottom = p01 + (p11 - p01) * fx;
+			return top + (bottom - top) * fy;
+		}
+
+		// 三线性：lod 为源立方体的 mip 下标（可以是小数）
+		Float4 SampleCubemapLevel(const Cubemap& cubemap, const Float direction[3], Float lod)
+		{
+			UInt face = 0;
+			Float s = 0.0f;
+			Float t = 0.0f;
+			SelectCubemapFace(direction, face, s, t);
+
+			const Float clamped_lod = std::clamp(lod, 0.0f, static_cast<Float>(cubemap.mip_count - 1));
+			const UInt mip = static_cast<UInt>(clamped_lod);
+			const Float fraction = clamped_lod - mip;
+			const Float4 color = SampleFaceBilinear(cubemap.GetFace(face, mip), s, t);
+			if (fraction <= 0.0f || mip + 1 >= cubemap.mip_count)
+			{
+				return color;
+			}
+			const Float4 next_color = SampleFaceBilinear(cubemap.GetFace(face, mip + 1), s, t);
+			return color + (next_color - color) * Splat4(fraction);
+		}
+
+		inline Float ComputeFaceCoordinate(UInt texel, UInt size)
+		{
+			return (texel + 0.5f) * (2.0f / size) - 1.0f;
+		}
+
+		// 一行纹素对 9 个基函数的积分（RGBA），按行保存后再按固定顺序合并
+		struct SHRowSum
+		{
+			Double coefficients[SH_L2_COEFFICIENT_COUNT][4] = {};
+		};
+
+		void ProjectSHRow(const TextureImage& level, UInt face, UInt y, const std::vector<Float>& solid_angles, SHRowSum& out_sum)
+		{
+			const UInt size = level.width;
+			Float4 sums[SH_L2_COEFFICIENT_COUNT];
+			for (Float4& sum : sums)
+			{
+				sum = Splat4(0.0f);
+			}
+
+			const Float t = ComputeFaceCoordinate(y, size);
+			for (UInt x = 0; x < size; ++x)
+			{
+				Float direction[3];
+				ComputeCubemapDirection(face, ComputeFaceCoordinate(x, size), t, direction);
+				Float basis[SH_L2_COEFFICIENT_COUNT];
+				EvaluateSHBasisL2(direction, basis);
+
+				const Float solid_angle = solid_angles[static_cast<std::size_t>(y) * size + x];
+				const Float4 color = Load4(level.GetPixel(x, y));
+				for (UInt i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+				{
+					sums[i] = sums[i] + color * Splat4(basis[i] * solid_angle);
+				}
+			}
+
+			for (UInt i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+			{
+				Float lanes[4];
+				Store4(sums[i], lanes);
+				for (UInt c = 0; c < 4; ++c)
+				{
+					out_sum.coefficients[i][c] = lanes[c];
+				}
+			}
+		}
+
+		// N = V 时一个粗糙度下的 GGX 样本：切线空间的 L、NoL 权重与源 mip（SoA，长度补齐到 4 的倍数，补齐的权重为 0）
+		struct SpecularSampleSet
+		{
+			std::vector<Float> x;
+			std::vector<Float> y;
+			std::vector<Float> z;
+			std::vector<Float> weight;
+			std::vector<Float> lod;
+			Float weight_sum = 0.0f;
+		};
+
+		SpecularSampleSet BuildSpecularSampleSet(Float roughness, UInt sample_count, UInt source_face_size)
+		{
+			SpecularSampleSet samples;
+			const Double alpha = static_cast<Double>(roughness) * roughness;
+			const Double alpha2 = alpha * alpha;
+			// 源 mip 0 一个纹素的平均立体角
+			const Double texel_solid_angle = 4.0 * kPi / (6.0 * source_face_size * source_face_size);
+			for (UInt i = 0; i < sample_count; ++i)
+			{
+				const Double phi = 2.0 * kPi * i / sample_count;
+				const Double xi = ComputeHammersleySequence(i);
+				const Double cos_theta = std::sqrt((1.0 - xi) / (1.0 + (alpha2 - 1.0) * xi));
+				const Double sin_theta = std::sqrt(std::max(0.0, 1.0 - cos_theta * cos_theta));
+				const Double NoL = 2.0 * cos_theta * cos_theta - 1.0;
+				if (NoL <= 0.0)
+				{
+					continue;
+				}
+
+				// pdf(l) = D(h) * NoH / (4 * VoH)，N = V 时 NoH = VoH
+				const Double denominator = cos_theta * cos_theta * (alpha2 - 1.0) + 1.0;
+				const Double D = alpha2 / (kPi * denominator * denominator);
+				const Double sample_solid_angle = 1.0 / (sample_count * D * 0.25 + 1e-12);
+				const Double lod = std::max(0.0, 0.5 * std::log2(sample_solid_angle / texel_solid_angle) + 1.0);
+
+				samples.x.push_back(static_cast<Float>(2.0 * cos_theta * sin_theta * std::cos(phi)));
+				samples.y.push_back(static_cast<Float>(2.0 * cos_theta * sin_theta * std::sin(phi)));
+				samples.z.push_back(static_cast<Float>(NoL));
+				samples.weight.push_back(static_cast<Float>(NoL));
+				samples.lod.push_back(static_cast<Float>(lod));
+			}
+
+			for (Float weight : samples.weight)
+			{
+				samples.weight_sum += weight;
+			}
+			while (samples.weight.size() % 4 != 0)
+			{
+				samples.x.push_back(0.0f);
+				samples.y.push_back(0.0f);
+				samples.z.push_back(1.0f);
+				samples.weight.push_back(0.0f);
+				samples.lod.push_back(0.0f);
+			}
+			return samples;
+		}
+
+		void PrefilterSpecularRows(const Cubemap& source, const SpecularSampleSet& samples, UInt face, UInt row_begin, UInt row_end, TextureImage& out_level)
+		{
+			const UInt size = out_level.width;
+			const Float4 inverse_weight_sum = Splat4(samples.weight_sum > 0.0f ? 1.0f / samples.weight_sum : 0.0f);
+			for (UInt y = row_begin; y < row_end; ++y)
+			{
+				const Float t = ComputeFaceCoordinate(y, size);
+				for (UInt x = 0; x < size; ++x)
+				{
+					Float N[3];
+					ComputeCubemapDirection(face, ComputeFaceCoordinate(x, size), t, N);
+
+					// 切线空间：T = normalize(up × N)，B = N × T
+					const Float up[3] = { std::fabs(N[2]) < 0.999f ? 0.0f : 1.0f, 0.0f, std::fabs(N[2]) < 0.999f ? 1.0f : 0.0f };
+					Float T[3] = { up[1] * N[2] - up[2] * N[1], up[2] * N[0] - up[0] * N[2], up[0] * N[1] - up[1] * N[0] };
+					const Float inverse_length = 1.0f / std::sqrt(T[0] * T[0] + T[1] * T[1] + T[2] * T[2]);
+					T[0] *= inverse_length;
+					T[1] *= inverse_length;
+					T[2] *= inverse_length;
+					const Float B[3] = { N[1] * T[2] - N[2] * T[1], N[2] * T[0] - N[0] * T[2], N[0] * T[1] - N[1] * T[0] };
+
+					Float4 sum = Splat4(0.0f);
+					for (std::size_t k = 0; k < samples.weight.size(); k += 4)
+					{
+						// 4 个样本一起变换到世界空间，再逐个采样
+						const Float4 lx = Load4(samples.x.data() + k);
+						const Float4 ly = Load4(samples.y.data() + k);
+						const Float4 lz = Load4(samples.z.data() + k);
+						Float world[3][4];
+						for (UInt c = 0; c < 3; ++c)
+						{
+							Store4(Splat4(T[c]) * lx + Splat4(B[c]) * ly + Splat4(N[c]) * lz, world[c]);
+						}
+						for (UInt lane = 0; lane < 4; ++lane)
+						{
+							const Float weight = samples.weight[k + lane];
+							if (weight <= 0.0f)
+							{
+								continue;
+							}
+							const Float direction[3] = { world[0][lane], world[1][lane], world[2][lane] };
+							sum = sum + SampleCubemapLevel(source, direction, samples.lod[k + lane]) * Splat4(weight);
+						}
+					}
+					Store4(sum * inverse_weight_sum, out_level.GetPixel(x, y));
+				}
+			}
+		}
+
+		// BRDF 积分的样本：Hammersley 的第二维与 cos(φ)，长度补齐到 4 的倍数（valid 为 0 的样本不计入）
+		struct BRDFSampleTable
+		{
+			std::vector<Float> xi;
+			std::vector<Float> cos_phi;
+			std::vector<Float> valid;
+			UInt sample_count = 0;
+		};
+
+		BRDFSampleTable BuildBRDFSampleTable(UInt sample_count)
+		{
+			BRDFSampleTable table;
+			table.sample_count = std::max(1u, sample_count);
+			const UInt padded_count = (table.sample_count + 3) / 4 * 4;
+			table.xi.resize(padded_count, 0.0f);
+			table.cos_phi.resize(padded_count, 1.0f);
+			table.valid.resize(padded_count, 0.0f);
+			for (UInt i = 0; i < table.sample_count; ++i)
+			{
+				table.xi[i] = ComputeHammersleySequence(i);
+				table.cos_phi[i] = static_cast<Float>(std::cos(2.0 * kPi * i / table.sample_count));
+				table.valid[i] = 1.0f;
+			}
+			return table;
+		}
+
+		void IntegrateBRDF(Float NoV, Float roughness, const BRDFSampleTable& table, Float& out_scale, Float& out_bias)
+		{
+			const Float alpha = roughness * roughness;
+			const Float4 one = Splat4(1.0f);
+			const Float4 zero = Splat4(0.0f);
+			const Float4 alpha2_minus_one = Splat4(alpha * alpha - 1.0f);
+			// IBL 的 Smith-Schlick：k = α / 2（不是解析光源使用的 (roughness + 1)² / 8）
+			const Float k = std::max(alpha * 0.5f, 1e-6f);
+			const Float4 one_minus_k = Splat4(1.0f - k);
+			const Float4 k4 = Splat4(k);
+			// V 在 xz 平面内，N = +Z
+			const Float4 Vx = Splat4(std::sqrt(std::max(0.0f, 1.0f - NoV * NoV)));
+			const Float4 Vz = Splat4(NoV);
+			const Float4 G_V = Vz / (Vz * one_minus_k + k4);
+			const Float4 two = Splat4(2.0f);
+
+			Float4 scale = zero;
+			Float4 bias = zero;
+			for (std::size_t i = 0; i < table.xi.size(); i += 4)
+			{
+				const Float4 xi = Load4(table.xi.data() + i);
+				const Float4 cos_theta = Sqrt4((one - xi) / (one + alpha2_minus_one * xi));
+				const Float4 sin_theta = Sqrt4(Max4(zero, one - cos_theta * cos_theta));
+				const Float4 Hx = sin_theta * Load4(table.cos_phi.data() + i);
+				const Float4 VoH = Vx * Hx + Vz * cos_theta;
+				const Float4 NoL = two * VoH * cos_theta - Vz;
+				const Float4 mask = PositiveMask4(NoL) * Load4(table.valid.data() + i);
+
+				const Float4 clamped_NoL = Max4(NoL, zero);
+				const Float4 G = G_V * (clamped_NoL / (clamped_NoL * one_minus_k + k4));
+				const Float4 G_vis = G * VoH / (cos_theta * Vz) * mask;
+				const Float4 one_minus_VoH = one - VoH;
+				const Float4 one_minus_VoH2 = one_minus_VoH * one_minus_VoH;
+				const Float4 Fc = one_minus_VoH2 * one_minus_VoH2 * one_minus_VoH;
+				scale = scale + (one - Fc) * G_vis;
+				bias = bias + Fc * G_vis;
+			}
+			out_scale = Sum4(scale) / table.sample_count;
+			out_bias = Sum4(bias) / table.sample_count;
+		}
+
+		void WriteBytes(std::vector<UByte>& bytes, const void* data, std::size_t size)
+		{
+			const UByte* begin = static_cast<const UByte*>(data);
+			bytes.insert(bytes.end(), begin, begin + size);
+		}
+	}
+
+	void EvaluateSHBasisL2(const Float direction[3], Float out_basis[SH_L2_COEFFICIENT_COUNT])
+	{
+		const Float x = direction[0];
+		const Float y = direction[1];
+		const Float z = direction[2];
+		out_basis[0] = kSHBasis0;
+		out_basis[1] = kSHBasis1 * y;
+		out_basis[2] = kSHBasis1 * z;
+		out_basis[3] = kSHBasis1 * x;
+		out_basis[4] = kSHBasis2 * x * y;
+		out_basis[5] = kSHBasis2 * y * z;
+		out_basis[6] = kSHBasis3 * (3.0f * z * z - 1.0f);
+		out_basis[7] = kSHBasis2 * x * z;
+		out_basis[8] = kSHBasis4 * (x * x - y * y);
+	}
+
+	void EvaluateSHL2(const SphericalHarmonicsL2& sh, const Float direction[3], Float out_color[3])
+	{
+		Float basis[SH_L2_COEFFICIENT_COUNT];
+		EvaluateSHBasisL2(direction, basis);
+		for (UInt c = 0; c < 3; ++c)
+		{
+			out_color[c] = 0.0f;
+			for (UInt i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+			{
+				out_color[c] += sh.coefficients[i][c] * basis[i];
+			}
+		}
+	}
+
+	Bool ProjectCubemapToSH(const Cubemap& cubemap, UInt mip, SphericalHarmonicsL2& out_sh, const TextureCookParallelFor& parallel_for /*= {}*/)
+	{
+		if (mip >= cubemap.mip_count || cubemap.faces.size() != static_cast<std::size_t>(CUBE_FACE_COUNT) * cubemap.mip_count)
+		{
+			return false;
+		}
+
+		const UInt size = cubemap.GetFace(0, mip).width;
+		std::vector<Float> solid_angles(static_cast<std::size_t>(size) * size);
+		for (UInt y = 0; y < size; ++y)
+		{
+			for (UInt x = 0; x < size; ++x)
+			{
+				solid_angles[static_cast<std::size_t>(y) * size + x] = ComputeCubemapTexelSolidAngle(x, y, size);
+			}
+		}
+
+		std::vector<SHRowSum> row_sums(static_cast<std::size_t>(CUBE_FACE_COUNT) * size);
+		Run(parallel_for, CUBE_FACE_COUNT * size, [&](UInt begin, UInt end)
+		{
+			for (UInt row = begin; row < end; ++row)
+			{
+				ProjectSHRow(cubemap.GetFace(row / size, mip), row / size, row % size, solid_angles, row_sums[row]);
+			}
+		});
+
+		Double totals[SH_L2_COEFFICIENT_COUNT][3] = {};
+		for (const SHRowSum& row_sum : row_sums)
+		{
+			for (UInt i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+			{
+				for (UInt c = 0; c < 3; ++c)
+				{
+					totals[i][c] += row_sum.coefficients[i][c];
+				}
+			}
+		}
+		for (UInt i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+		{
+			for (UInt c = 0; c < 3; ++c)
+			{
+				out_sh.coefficients[i][c] = static_cast<Float>(totals[i][c]);
+			}
+		}
+		return true;
+	}
+
+	SphericalHarmonicsL2 ConvolveSHWithCosineLobe(const SphericalHarmonicsL2& radiance)
+	{
+		const Float band_scale[3] = { static_cast<Float>(kPi), static_cast<Float>(2.0 * kPi / 3.0), static_cast<Float>(kPi / 4.0) };
+		SphericalHarmonicsL2 irradiance;
+		for (UInt i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+		{
+			const UInt band = i == 0 ? 0 : (i < 4 ? 1 : 2);
+			for (UInt c = 0; c < 3; ++c)
+			{
+				irradiance.coefficients[i][c] = radiance.coefficients[i][c] * band_scale[band];
+			}
+		}
+		return irradiance;
+	}
+
+	void PackIrradianceSHForShader(const SphericalHarmonicsL2& irradiance, Float out_constants[SH_L2_COEFFICIENT_COUNT][4])
+	{
+		const Float inverse_pi = static_cast<Float>(1.0 / kPi);
+		for (UInt i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+		{
+			for (UInt c = 0; c < 3; ++c)
+			{
+				out_constants[i][c] = irradiance.coefficients[i][c] * kSHBasisScale[i] * inverse_pi;
+			}
+			out_constants[i][3] = 0.0f;
+		}
+	}
+
+	Float ComputeHammersleySequence(UInt index)
+	{
+		UInt bits = index;
+		bits = (bits << 16u) | (bits >> 16u);
+		bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+		bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+		bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+		bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+		return static_cast<Float>(bits * 2.3283064365386963e-10);
+	}
+
+	ImageBasedLightingPath GetImageBasedLightingPath()
+	{
+#if defined(DOLAS_IMAGE_BASED_LIGHTING_SSE)
+		return ImageBasedLightingPath::SSE;
+#else
+		return ImageBasedLightingPath::Scalar;
+#endif
+	}
+
+	Bool PrefilterSpecularCubemap(const Cubemap& source, const ImageBasedLightingSettings& settings, Cubemap& out_specular, const TextureCookParallelFor& parallel_for /*= {}*/)
+	{
+		if (source.face_size == 0 || source.mip_count == 0 || source.faces.size() != static_cast<std::size_t>(CUBE_FACE_COUNT) * source.mip_count)
+		{
+			return false;
+		}
+
+		// 源立方体的 mip 链是 2 的幂，mip 0 总能找到同样大小的一级
+		UInt source_mip = 0;
+		const UInt face_size = std::min(FloorPowerOfTwo(std::max(1u, settings.specular_face_size)), source.face_size);
+		while ((source.face_size >> source_mip) > face_size && source_mip + 1 < source.mip_count)
+		{
+			++source_mip;
+		}
+		const UInt mip_count = std::max(1u, std::min(settings.specular_mip_count, ComputeFullMipCount(face_size, face_size)));
+
+		out_specular.face_size = face_size;
+		out_specular.mip_count = mip_count;
+		out_specular.faces.assign(CUBE_FACE_COUNT * mip_count, {});
+		for (UInt face = 0; face < CUBE_FACE_COUNT; ++face)
+		{
+			out_specular.GetFace(face, 0) = source.GetFace(face, source_mip);
+			for (UInt mip = 1; mip < mip_count; ++mip)
+			{
+				const UInt size = std::max(1u, face_size >> mip);
+				out_specular.GetFace(face, mip).Resize(size, size);
+			}
+		}
+
+		for (UInt mip = 1; mip < mip_count; ++mip)
+		{
+			const Float roughness = static_cast<Float>(mip) / (mip_count - 1);
+			const SpecularSampleSet samples = BuildSpecularSampleSet(roughness, std::max(1u, settings.specular_sample_count), source.face_size);
+			const UInt size = std::max(1u, face_size >> mip);
+			Run(parallel_for, CUBE_FACE_COUNT * size, [&](UInt begin, UInt end)
+			{
+				while (begin < end)
+				{
+					const UInt face = begin / size;
+					const UInt face_end = std::min(end, (face + 1) * size);
+					PrefilterSpecularRows(source, samples, face, begin - face * size, face_end - face * size, out_specular.GetFace(face, mip));
+					begin = face_end;
+				}
+			});
+		}
+		return true;
+	}
+
+	void ComputeBRDFIntegration(Float NoV, Float roughness, UInt sample_count, Float& out_scale, Float& out_bias)
+	{
+		IntegrateBRDF(NoV, roughness, BuildBRDFSampleTable(sample_count), out_scale, out_bias);
+	}
+
+	Bool BuildBRDFLUT(UInt size, UInt sample_count, TextureImage& out_lut, const TextureCookParallelFor& parallel_for /*= {}*/)
+	{
+		if (size == 0)
+		{
+			return false;
+		}
+
+		const BRDFSampleTable table = BuildBRDFSampleTable(sample_count);
+		out_lut.Resize(size, size);
+		Run(parallel_for, size, [&](UInt begin, UInt end)
+		{
+			for (UInt y = begin; y < end; ++y)
+			{
+				const Float roughness = (y + 0.5f) / size;
+				for (UInt x = 0; x < size; ++x)
+				{
+					Float* pixel = out_lut.GetPixel(x, y);
+					IntegrateBRDF((x + 0.5f) / size, roughness, table, pixel[0], pixel[1]);
+					pixel[2] = 0.0f;
+					pixel[3] = 1.0f;
+				}
+			}
+		});
+		return true;
+	}
+
+	Bool CookBRDFLUT(const TextureImage& lut, CookedTexture& out_texture)
+	{
+		if (lut.IsEmpty())
+		{
+			return false;
+		}
+
+		out_texture.format = BlockFormat::BC5;
+		out_texture.width = lut.width;
+		out_texture.height = lut.height;
+		out_texture.face_count = 1;
+		out_texture.mips.assign(1, std::vector<UByte>(static_cast<std::size_t>(ComputeBlockCompressedSize(out_texture.format, lut.width, lut.height))));
+		CompressBlockRows(out_texture.format, lut.pixels.data(), lut.width, lut.height, 0, (lut.height + 3) / 4, out_texture.mips[0].data());
+		out_texture.mip_milliseconds = 0.0;
+		out_texture.encode_milliseconds = 0.0;
+		out_texture.encoded_texel_count = static_cast<ULongLong>(lut.width) * lut.height;
+		return true;
+	}
+
+	Bool PrecomputeImageBasedLighting(const TextureImage& equirect, const ImageBasedLightingSettings& settings, ImageBasedLighting& out_lighting, const TextureCookParallelFor& parallel_for /*= {}*/)
+	{
+		CubemapBuildSettings cubemap_settings;
+		cubemap_settings.face_size = settings.source_face_size;
+		Cubemap source;
+		if (!BuildCubemapFromEquirect(equirect, cubemap_settings, source, parallel_for))
+		{
+			return false;
+		}
+
+		UInt irradiance_mip = 0;
+		while ((source.face_size >> irradiance_mip) > std::max(1u, settings.irradiance_face_size) && irradiance_mip + 1 < source.mip_count)
+		{
+			++irradiance_mip;
+		}
+		SphericalHarmonicsL2 radiance;
+		if (!ProjectCubemapToSH(source, irradiance_mip, radiance, parallel_for))
+		{
+			return false;
+		}
+		out_lighting.irradiance = ConvolveSHWithCosineLobe(radiance);
+		return PrefilterSpecularCubemap(source, settings, out_lighting.specular, parallel_for);
+	}
+
+	ULongLong ComputeImageBasedLightingCacheKey(ULongLong source_hash, const ImageBasedLightingSettings& settings)
+	{
+		const UInt values[] = { kCacheVersion, settings.source_face_size, settings.irradiance_face_size,
+			settings.specular_face_size, settings.specular_mip_count, settings.specular_sample_count };
+		return HashConverter::BytesHash64(values, sizeof(values), source_hash);
+	}
+
+	ULongLong ComputeBRDFLUTCacheKey(const ImageBasedLightingSettings& settings)
+	{
+		const UInt values[] = { kCacheVersion, settings.brdf_lut_size, settings.brdf_lut_sample_count };
+		return HashConverter::BytesHash64(values, sizeof(values));
+	}
+
+	std::vector<UByte> BuildSphericalHarmonicsFile(const SphericalHarmonicsL2& sh)
+	{
+		std::vector<UByte> bytes;
+		WriteBytes(bytes, kSHFileMagic, sizeof(kSHFileMagic));
+		WriteBytes(bytes, &kSHFileVersion, sizeof(kSHFileVersion));
+		WriteBytes(bytes, sh.coefficients, sizeof(sh.coefficients));
+		return bytes;
+	}
+
+	Bool ParseSphericalHarmonicsFile(const UByte* data, std::size_t size, SphericalHarmonicsL2& out_sh)
+	{
+		constexpr std::size_t kHeaderSize = sizeof(kSHFileMagic) + sizeof(kSHFileVersion);
+		if (!data || size != kHeaderSize + sizeof(out_sh.coefficients) || std::memcmp(data, kSHFileMagic, sizeof(kSHFileMagic)) != 0)
+		{
+			return false;
+		}
+		UInt version = 0;
+		std::memcpy(&version, data + sizeof(kSHFileMagic), sizeof(version));
+		if (version != kSHFileVersion)
+		{
+			return false;
+		}
+		std::memcpy(out_sh.coefficients, data + kHeaderSize, sizeof(out_sh.coefficients));
+		return true;
+	}
+
+	Bool SaveSphericalHarmonicsFile(const SphericalHarmonicsL2& sh, const std::filesystem::path& file_path)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(file_path.parent_path(), error);
+		const std::filesystem::path temp_path = file_path.string() + ".tmp";
+		{
+			std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+			if (!file)
+			{
+				return false;
+			}
+			const std::vector<UByte> bytes = BuildSphericalHarmonicsFile(sh);
+			file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+			if (!file)
+			{
+				return false;
+			}
+		}
+		std::filesystem::rename(temp_path, file_path, error);
+		return !error;
+	}
+
+	Bool LoadSphericalHarmonicsFile(const std::filesystem::path& file_path, SphericalHarmonicsL2& out_sh)
+	{
+		std::ifstream file(file_path, std::ios::binary);
+		if (!file)
+		{
+			return false;
+		}
+		const std::vector<UByte> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		return ParseSphericalHarmonicsFile(bytes.data(), bytes.size(), out_sh);
+	}
+}
@@ -0,0 +1,390 @@
+#include "dolas_light_clustering.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define DOLAS_LIGHT_CLUSTERING_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DOLAS_LIGHT_CLUSTERING_SSE 1
+#endif
+
+namespace Dolas
+{
+	namespace
+	{
+		// 列 / 行数组补齐到 8 的倍数，AVX 可以整组读取
+		constexpr UInt kTileLaneAlignment = 8;
+		// 补齐部分的边界：到任何光源的距离都是无穷大，测试结果总是不相交
+		constexpr Float kPaddingBoundMin = 1.0e30f;
+		constexpr Float kPaddingBoundMax = -1.0e30f;
+
+		// 点到区间 [min_value, max_value] 的距离平方，SIMD 路径使用相同的运算顺序
+		inline Float IntervalDistanceSquared(Float value, Float min_value, Float max_value)
+		{
+			const Float distance = std::max(std::max(min_value - value, value - max_value), 0.0f);
+			return distance * distance;
+		}
+
+		inline UInt AlignTileCount(UInt count)
+		{
+			return (count + kTileLaneAlignment - 1) / kTileLaneAlignment * kTileLaneAlignment;
+		}
+
+		inline void AppendPair(LightClusterChunk& out_chunk, UInt cluster_index, UInt light_index)
+		{
+			out_chunk.cluster_indices.push_back(cluster_index);
+			out_chunk.light_indices.push_back(light_index);
+		}
+	}
+
+	BoundingSphere LocalLight::GetBoundingSphere() const
+	{
+		if (range <= 0.0f)
+		{
+			return BoundingSphere();
+		}
+		if (type != LocalLightType_Spot)
+		{
+			return BoundingSphere(position, range);
+		}
+
+		// 圆锥（顶点 position、母线长 range、半角 theta）的最小包围球：
+		// 半角大于 45 度时是底面圆的外接球，否则是过顶点和底面圆的球
+		const Float cos_theta = std::clamp(spot_outer_cos, 0.0f, 1.0f);
+		const Float sin_theta = std::sqrt(1.0f - cos_theta * cos_theta);
+		if (cos_theta < 0.70710678f)
+		{
+			return BoundingSphere(position + direction * (range * cos_theta), range * sin_theta);
+		}
+		const Float radius = range / (2.0f * cos_theta);
+		return BoundingSphere(position + direction * radius, radius);
+	}
+
+	LightClusteringPath GetLightClusteringPath()
+	{
+#if defined(DOLAS_LIGHT_CLUSTERING_AVX)
+		return LightClusteringPath::AVX;
+#elif defined(DOLAS_LIGHT_CLUSTERING_SSE)
+		return LightClusteringPath::SSE;
+#else
+		return LightClusteringPath::Scalar;
+#endif
+	}
+
+	void LightClusterGrid::Setup(const LightClusterGridDesc& desc, const LightClusterView& view)
+	{
+		m_desc = desc;
+		m_desc.tiles_x = std::max<UInt>(desc.tiles_x, 1);
+		m_desc.tiles_y = std::max<UInt>(desc.tiles_y, 1);
+		m_desc.slice_count = std::max<UInt>(desc.slice_count, 1);
+		m_near_plane = std::max(view.near_plane, 1.0e-4f);
+		m_far_plane = std::max(view.far_plane, m_near_plane * 1.001f);
+		m_slice_scale = static_cast<Float>(m_desc.slice_count) / std::log2(m_far_plane / m_near_plane);
+
+		const UInt slice_count = m_desc.slice_count;
+		m_slice_depths.resize(slice_count + 1);
+		for (UInt slice = 0; slice <= slice_count; ++slice)
+		{
+			m_slice_depths[slice] = m_near_plane * std::pow(m_far_plane / m_near_plane, static_cast<Float>(slice) / slice_count);
+		}
+		// 两端精确等于近 / 远平面，避免 pow 的舍入让 froxel 漏掉边界
+		m_slice_depths[0] = m_near_plane;
+		m_slice_depths[slice_count] = m_far_plane;
+
+		m_column_stride = AlignTileCount(m_desc.tiles_x);
+		m_row_stride = AlignTileCount(m_desc.tiles_y);
+		m_column_min_x.assign(static_cast<size_t>(m_column_stride) * slice_count, kPaddingBoundMin);
+		m_column_max_x.assign(static_cast<size_t>(m_column_stride) * slice_count, kPaddingBoundMax);
+		m_row_min_y.assign(static_cast<size_t>(m_row_stride) * slice_count, kPaddingBoundMin);
+		m_row_max_y.assign(static_cast<size_t>(m_row_stride) * slice_count, kPaddingBoundMax);
+
+		// 视空间 x = ndc_x * depth / projection_scale_x，froxel 在 x 上的范围取其近、远两端的并
+		const Float inverse_scale_x = 1.0f / view.projection_scale_x;
+		const Float inverse_scale_y = 1.0f / view.projection_scale_y;
+		for (UInt slice = 0; slice < slice_count; ++slice)
+		{
+			const Float near_depth = m_slice_depths[slice];
+			const Float far_depth = m_slice_depths[slice + 1];
+			for (UInt column = 0; column < m_desc.tiles_x; ++column)
+			{
+				const Float ndc_left = -1.0f + 2.0f * column / m_desc.tiles_x;
+				const Float ndc_right = -1.0f + 2.0f * (column + 1) / m_desc.tiles_x;
+				const size_t index = static_cast<size_t>(slice) * m_column_stride + column;
+				m_column_min_x[index] = ndc_left * (ndc_left >= 0.0f ? near_depth : far_depth) * inverse_scale_x;
+				m_column_max_x[index] = ndc_right * (ndc_right >= 0.0f ? far_depth : near_depth) * inverse_scale_x;
+			}
+			// row 0 在屏幕顶部，对应 ndc_y = 1
+			for (UInt row = 0; row < m_desc.tiles_y; ++row)
+			{
+				const Float ndc_top = 1.0f - 2.0f * row / m_desc.tiles_y;
+				const Float ndc_bottom = 1.0f - 2.0f * (row + 1) / m_desc.tiles_y;
+				const size_t index = static_cast<size_t>(slice) * m_row_stride + row;
+				m_row_min_y[index] = ndc_bottom * (ndc_bottom >= 0.0f ? near_depth : far_depth) * inverse_scale_y;
+				m_row_max_y[index] = ndc_top * (ndc_top >= 0.0f ? far_depth : near_depth) * inverse_scale_y;
+			}
+		}
+
+		m_view = view.view;
+	}
+
+	void LightClusterGrid::PrepareLights(const LocalLight* lights, UInt light_count)
+	{
+		m_light_count = lights ? light_count : 0;
+		m_light_x.resize(m_light_count);
+		m_light_y.resize(m_light_count);
+		m_light_depth.resize(m_light_count);
+		m_light_radius.resize(m_light_count);
+
+		for (UInt light_index = 0; light_index < m_light_count; ++light_index)
+		{
+			const BoundingSphere sphere = lights[light_index].GetBoundingSphere();
+			const Vector4 view_center = m_view * Vector4(sphere.center, 1.0f);
+			m_light_x[light_index] = view_center.x;
+			m_light_y[light_index] = view_center.y;
+			m_light_depth[light_index] = -view_center.z;
+			m_light_radius[light_index] = sphere.radius;
+		}
+	}
+
+	UInt LightClusterGrid::GetSliceIndex(Float depth) const
+	{
+		if (!(depth > m_near_plane))
+		{
+			return 0;
+		}
+		const Float slice = std::floor(std::log2(depth / m_near_plane) * m_slice_scale);
+		return static_cast<UInt>(std::min(slice, static_cast<Float>(m_desc.slice_count - 1)));
+	}
+
+	UInt LightClusterGrid::GetClusterIndex(Float screen_u, Float screen_v, Float depth) const
+	{
+		const Int column = std::clamp(static_cast<Int>(std::floor(screen_u * m_desc.tiles_x)), 0, static_cast<Int>(m_desc.tiles_x) - 1);
+		const Int row = std::clamp(static_cast<Int>(std::floor(screen_v * m_desc.tiles_y)), 0, static_cast<Int>(m_desc.tiles_y) - 1);
+		return (GetSliceIndex(depth) * m_desc.tiles_y + static_cast<UInt>(row)) * m_desc.tiles_x + static_cast<UInt>(column);
+	}
+
+	void LightClusterGrid::GetLightSliceRange(UInt light_index, UInt& out_first_slice, UInt& out_last_slice) const
+	{
+		// 对数的舍入可能让 slice 差一，两端各放宽一片，是否相交由 GetDepthDistanceSquared 精确判断
+		const Float depth = m_light_depth[light_index];
+		const Float radius = m_light_radius[light_index];
+		const UInt first_slice = GetSliceIndex(std::max(depth - radius, m_near_plane));
+		const UInt last_slice = GetSliceIndex(std::min(depth + radius, m_far_plane));
+		out_first_slice = first_slice > 0 ? first_slice - 1 : 0;
+		out_last_slice = std::min(last_slice + 1, m_desc.slice_count - 1);
+	}
+
+	Float LightClusterGrid::GetDepthDistanceSquared(UInt light_index, UInt slice) const
+	{
+		return IntervalDistanceSquared(m_light_depth[light_index], m_slice_depths[slice], m_slice_depths[slice + 1]);
+	}
+
+	void LightClusterGrid::ComputeTileDistances(UInt light_index, UInt slice, Float* out_column_distances, Float* out_row_distances) const
+	{
+		const Float light_x = m_light_x[light_index];
+		const Float light_y = m_light_y[light_index];
+		const Float* min_x = m_column_min_x.data() + static_cast<size_t>(slice) * m_column_stride;
+		const Float* max_x = m_column_max_x.data() + static_cast<size_t>(slice) * m_column_stride;
+		const Float* min_y = m_row_min_y.data() + static_cast<size_t>(slice) * m_row_stride;
+		const Float* max_y = m_row_max_y.data() + static_cast<size_t>(slice) * m_row_stride;
+		UInt column = 0;
+
+#if defined(DOLAS_LIGHT_CLUSTERING_AVX)
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256 x = _mm256_set1_ps(light_x);
+		for (; column < m_column_stride; column += 8)
+		{
+			const __m256 below = _mm256_sub_ps(_mm256_loadu_ps(min_x + column), x);
+			const __m256 above = _mm256_sub_ps(x, _mm256_loadu_ps(max_x + column));
+			const __m256 distance = _mm256_max_ps(_mm256_max_ps(below, above), zero);
+			_mm256_storeu_ps(out_column_distances + column, _mm256_mul_ps(distance, distance));
+		}
+#elif defined(DOLAS_LIGHT_CLUSTERING_SSE)
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 x = _mm_set1_ps(light_x);
+		for (; column < m_column_stride; column += 4)
+		{
+			const __m128 below = _mm_sub_ps(_mm_loadu_ps(min_x + column), x);
+			const __m128 above = _mm_sub_ps(x, _mm_loadu_ps(max_x + column));
+			const __m128 distance = _mm_max_ps(_mm_max_ps(below, above), zero);
+			_mm_storeu_ps(out_column_distances + column, _mm_mul_ps(distance, distance));
+		}
+#endif
+		for (; column < m_column_stride; ++column)
+		{
+			out_column_distances[column] = IntervalDistanceSquared(light_x, min_x[column], max_x[column]);
+		}
+
+		// 行数较少（默认 9），逐个计算
+		for (UInt row = 0; row < m_desc.tiles_y; ++row)
+		{
+			out_row_distances[row] = IntervalDistanceSquared(light_y, min_y[row], max_y[row]);
+		}
+	}
+
+	UInt LightClusterGrid::AssignLights(UInt begin, UInt end, LightClusterChunk& out_chunk) const
+	{
+		end = std::min(end, m_light_count);
+		if (begin >= end)
+		{
+			return 0;
+		}
+
+		const size_t pair_count_before = out_chunk.cluster_indices.size();
+		std::vector<Float> column_distances(m_column_stride);
+		std::vector<Float> row_distances(m_row_stride);
+		const UInt tiles_x = m_desc.tiles_x;
+		const UInt tiles_y = m_desc.tiles_y;
+
+		for (UInt light_index = begin; light_index < end; ++light_index)
+		{
+			const Float radius = m_light_radius[light_index];
+			if (radius < 0.0f)
+			{
+				continue;
+			}
+			const Float radius_squared = radius * radius;
+
+			UInt first_slice = 0;
+			UInt last_slice = 0;
+			GetLightSliceRange(light_index, first_slice, last_slice);
+			for (UInt slice = first_slice; slice <= last_slice; ++slice)
+			{
+				const Float depth_distance = GetDepthDistanceSquared(light_index, slice);
+				if (depth_distance > radius_squared)
+				{
+					continue;
+				}
+
+				ComputeTileDistances(light_index, slice, column_distances.data(), row_distances.data());
+				for (UInt row = 0; row < tiles_y; ++row)
+				{
+					const Float row_depth_distance = row_distances[row] + depth_distance;
+					if (row_depth_distance > radius_squared)
+					{
+						continue;
+					}
+
+					const UInt cluster_base = (slice * tiles_y + row) * tiles_x;
+					UInt column = 0;
+#if defined(DOLAS_LIGHT_CLUSTERING_AVX)
+					const __m256 offset = _mm256_set1_ps(row_depth_distance);
+					const __m256 limit = _mm256_set1_ps(radius_squared);
+					for (; column < tiles_x; column += 8)
+					{
+						const __m256 distance = _mm256_add_ps(_mm256_loadu_ps(column_distances.data() + column), offset);
+						const Int mask = _mm256_movemask_ps(_mm256_cmp_ps(distance, limit, _CMP_LE_OQ));
+						for (UInt lane = 0; lane < 8 && column + lane < tiles_x; ++lane)
+						{
+							if ((mask >> lane) & 1)
+							{
+								AppendPair(out_chunk, cluster_base + column + lane, light_index);
+							}
+						}
+					}
+#elif defined(DOLAS_LIGHT_CLUSTERING_SSE)
+					const __m128 offset = _mm_set1_ps(row_depth_distance);
+					const __m128 limit = _mm_set1_ps(radius_squared);
+					for (; column < tiles_x; column += 4)
+					{
+						const __m128 distance = _mm_add_ps(_mm_loadu_ps(column_distances.data() + column), offset);
+						const Int mask = _mm_movemask_ps(_mm_cmple_ps(distance, limit));
+						for (UInt lane = 0; lane < 4 && column + lane < tiles_x; ++lane)
+						{
+							if ((mask >> lane) & 1)
+							{
+								AppendPair(out_chunk, cluster_base + column + lane, light_index);
+							}
+						}
+					}
+#else
+					for (; column < tiles_x; ++column)
+					{
+						if (column_distances[column] + row_depth_distance <= radius_squared)
+						{
+							AppendPair(out_chunk, cluster_base + column, light_index);
+						}
+					}
+#endif
+				}
+			}
+		}
+		return static_cast<UInt>(out_chunk.cluster_indices.size() - pair_count_before);
+	}
+
+	UInt LightClusterGrid::AssignLightsBruteForce(UInt begin, UInt end, LightClusterChunk& out_chunk) const
+	{
+		end = std::min(end, m_light_count);
+		if (begin >= end)
+		{
+			return 0;
+		}
+
+		const size_t pair_count_before = out_chunk.cluster_indices.size();
+		for (UInt light_index = begin; light_index < end; ++light_index)
+		{
+			const Float radius = m_light_radius[light_index];
+			if (radius < 0.0f)
+			{
+				continue;
+			}
+			const Float radius_squared = radius * radius;
+
+			for (UInt slice = 0; slice < m_desc.slice_count; ++slice)
+			{
+				const Float depth_distance = GetDepthDistanceSquared(light_index, slice);
+				for (UInt row = 0; row < m_desc.tiles_y; ++row)
+				{
+					const size_t row_index = static_cast<size_t>(slice) * m_row_stride + row;
+					const Float row_distance = IntervalDistanceSquared(m_light_y[light_index], m_row_min_y[row_index], m_row_max_y[row_index]);
+					for (UInt column = 0; column < m_desc.tiles_x; ++column)
+					{
+						const size_t column_index = static_cast<size_t>(slice) * m_column_stride + column;
+						const Float column_distance = IntervalDistanceSquared(m_light_x[light_index], m_column_min_x[column_index], m_column_max_x[column_index]);
+						if (column_distance + (row_distance + depth_distance) <= radius_squared)
+						{
+							AppendPair(out_chunk, (slice * m_desc.tiles_y + row) * m_desc.tiles_x + column, light_index);
+						}
+					}
+				}
+			}
+		}
+		return static_cast<UInt>(out_chunk.cluster_indices.size() - pair_count_before);
+	}
+
+	void LightClusterGrid::BuildLightLists(const LightClusterChunk* chunks, UInt chunk_count, std::vector<LightClusterRange>& out_ranges, std::vector<UInt>& out_light_indices) const
+	{
+		const UInt cluster_count = GetClusterCount();
+		out_ranges.assign(cluster_count, LightClusterRange());
+
+		// 计数 -> 前缀和 -> 按块顺序写入（块内的光源已按顺序排列）
+		for (UInt chunk_index = 0; chunk_index < chunk_count; ++chunk_index)
+		{
+			for (UInt cluster_index : chunks[chunk_index].cluster_indices)
+			{
+				++out_ranges[cluster_index].count;
+			}
+		}
+
+		UInt offset = 0;
+		for (LightClusterRange& range : out_ranges)
+		{
+			range.offset = offset;
+			offset += range.count;
+			range.count = 0;
+		}
+
+		out_light_indices.resize(offset);
+		for (UInt chunk_index = 0; chunk_index < chunk_count; ++chunk_index)
+		{
+			const LightClusterChunk& chunk = chunks[chunk_index];
+			for (size_t pair_index = 0; pair_index < chunk.cluster_indices.size(); ++pair_index)
+			{
+				LightClusterRange& range = out_ranges[chunk.cluster_indices[pair_index]];
+				out_light_indices[range.offset + range.count++] = chunk.light_indices[pair_index];
+			}
+		}
+	}
+}
@@ -1139,4 +1139,35 @@ namespace Dolas
     }
 
 	const Float MathUtil::PI = 3.14159265358979323846f;
-}
\ No newline at end of file
+
+	Matrix4x4 Pose::ToMatrix() const
+	{
+		// 归一化四元数（确保是单位四元数）
+		Quaternion quat = m_rotation;
+		Float quat_length = std::sqrt(quat.x * quat.x + quat.y * quat.y + quat.z * quat.z + quat.w * quat.w);
+		if (quat_length > 0.0001f)
+		{
+			quat.x /= quat_length;
+			quat.y /= quat_length;
+			quat.z /= quat_length;
+			quat.w /= quat_length;
+		}
+
+		Float xx = quat.x * quat.x;
+		Float yy = quat.y * quat.y;
+		Float zz = quat.z * quat.z;
+		Float xy = quat.x * quat.y;
+		Float xz = quat.x * quat.z;
+		Float yz = quat.y * quat.z;
+		Float wx = quat.w * quat.x;
+		Float wy = quat.w * quat.y;
+		Float wz = quat.w * quat.z;
+
+		// 旋转矩阵的每一列乘以对应的缩放，再放入平移
+		return Matrix4x4(
+			(1.0f - 2.0f * (yy + zz)) * m_scale.x, 2.0f * (xy - wz) * m_scale.y,          2.0f * (xz + wy) * m_scale.z,          m_postion.x,
+			2.0f * (xy + wz) * m_scale.x,          (1.0f - 2.0f * (xx + zz)) * m_scale.y, 2.0f * (yz - wx) * m_scale.z,          m_postion.y,
+			2.0f * (xz - wy) * m_scale.x,          2.0f * (yz + wx) * m_scale.y,          (1.0f - 2.0f * (xx + yy)) * m_scale.z, m_postion.z,
+			0.0f,                                  0.0f,                                  0.0f,                                  1.0f);
+	}
+}
@@ -0,0 +1,409 @@
+#include "dolas_mesh_lod.h"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+namespace Dolas
+{
+	namespace
+	{
+		struct SimplifyVector
+		{
+			Double x = 0.0;
+			Double y = 0.0;
+			Double z = 0.0;
+		};
+
+		SimplifyVector Sub(const SimplifyVector& a, const SimplifyVector& b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+		SimplifyVector Cross(const SimplifyVector& a, const SimplifyVector& b) { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+		Double Dot(const SimplifyVector& a, const SimplifyVector& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+		// 对称 4x4 二次型的上三角 10 个分量：Q(p) = p^T A p + 2 b^T p + c
+		struct Quadric
+		{
+			Double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+			Double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+			Double c = 0.0;
+			Double weight = 0.0;
+
+			void AddPlane(const SimplifyVector& n, Double d, Double w)
+			{
+				a00 += w * n.x * n.x; a01 += w * n.x * n.y; a02 += w * n.x * n.z;
+				a11 += w * n.y * n.y; a12 += w * n.y * n.z; a22 += w * n.z * n.z;
+				b0 += w * n.x * d; b1 += w * n.y * d; b2 += w * n.z * d;
+				c += w * d * d;
+				weight += w;
+			}
+
+			void Add(const Quadric& other)
+			{
+				a00 += other.a00; a01 += other.a01; a02 += other.a02;
+				a11 += other.a11; a12 += other.a12; a22 += other.a22;
+				b0 += other.b0; b1 += other.b1; b2 += other.b2;
+				c += other.c;
+				weight += other.weight;
+			}
+
+			Double Evaluate(const SimplifyVector& p) const
+			{
+				const Double value =
+					a00 * p.x * p.x + 2.0 * a01 * p.x * p.y + 2.0 * a02 * p.x * p.z +
+					a11 * p.y * p.y + 2.0 * a12 * p.y * p.z + a22 * p.z * p.z +
+					2.0 * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+				return std::max(value, 0.0);
+			}
+		};
+
+		// 两个端点二次型之和在目标点处的值除以面积权重，即到相关平面的面积加权均方距离
+		Double CollapseError(const Quadric& from, const Quadric& to, const SimplifyVector& target)
+		{
+			Quadric combined = from;
+			combined.Add(to);
+			if (combined.weight <= 0.0)
+			{
+				return 0.0;
+			}
+			return combined.Evaluate(target) / combined.weight;
+		}
+
+		struct CollapseCandidate
+		{
+			Double error;
+			UInt from;
+			UInt to;
+
+			Bool operator>(const CollapseCandidate& other) const { return error > other.error; }
+		};
+
+		// 翻转角度超过约 75 度或退化成线段的三角形视为翻转
+		constexpr Double kFlipDotThreshold = 0.25;
+	}
+
+	Float SimplifyMesh(
+		const Float* positions, UInt vertex_count, UInt stride,
+		const std::vector<UInt>& indices,
+		UInt target_index_count, Float target_error,
+		std::vector<UInt>& out_indices)
+	{
+		out_indices.clear();
+		const UInt triangle_count = static_cast<UInt>(indices.size() / 3);
+		if (positions == nullptr || vertex_count == 0 || triangle_count == 0)
+		{
+			return 0.0f;
+		}
+
+		// 归一化到包围盒对角线为 1，误差与网格尺寸无关
+		std::vector<SimplifyVector> points(vertex_count);
+		SimplifyVector min_point{ DOLAS_FLOAT_MAX, DOLAS_FLOAT_MAX, DOLAS_FLOAT_MAX };
+		SimplifyVector max_point{ DOLAS_FLOAT_MIN, DOLAS_FLOAT_MIN, DOLAS_FLOAT_MIN };
+		for (UInt i = 0; i < vertex_count; ++i)
+		{
+			const Float* p = positions + static_cast<std::size_t>(i) * stride;
+			points[i] = { p[0], p[1], p[2] };
+			min_point = { std::min(min_point.x, points[i].x), std::min(min_point.y, points[i].y), std::min(min_point.z, points[i].z) };
+			max_point = { std::max(max_point.x, points[i].x), std::max(max_point.y, points[i].y), std::max(max_point.z, points[i].z) };
+		}
+		const SimplifyVector diagonal = Sub(max_point, min_point);
+		const Double diagonal_length = std::sqrt(Dot(diagonal, diagonal));
+		const Double inverse_scale = diagonal_length > 0.0 ? 1.0 / diagonal_length : 1.0;
+		for (SimplifyVector& point : points)
+		{
+			point = { (point.x - min_point.x) * inverse_scale, (point.y - min_point.y) * inverse_scale, (point.z - min_point.z) * inverse_scale };
+		}
+
+		// 位置相同的顶点归为一组：组内有多个顶点说明存在 UV / 法线接缝
+		std::vector<UInt> sorted_vertices(vertex_count);
+		for (UInt i = 0; i < vertex_count; ++i) sorted_vertices[i] = i;
+		auto position_less = [&points](UInt a, UInt b)
+		{
+			if (points[a].x != points[b].x) return points[a].x < points[b].x;
+			if (points[a].y != points[b].y) return points[a].y < points[b].y;
+			return points[a].z < points[b].z;
+		};
+		std::sort(sorted_vertices.begin(), sorted_vertices.end(), position_less);
+
+		std::vector<UInt> position_group(vertex_count);
+		std::vector<Bool> locked(vertex_count, false);
+		for (UInt begin = 0; begin < vertex_count;)
+		{
+			UInt end = begin + 1;
+			while (end < vertex_count && !position_less(sorted_vertices[begin], sorted_vertices[end])) ++end;
+			for (UInt i = begin; i < end; ++i)
+			{
+				position_group[sorted_vertices[i]] = sorted_vertices[begin];
+				locked[sorted_vertices[i]] = (end - begin) > 1;
+			}
+			begin = end;
+		}
+
+		// 按位置统计边的引用次数：只被一个三角形引用的是开放边界，多于两个的是非流形边，端点都锁定
+		std::vector<std::pair<ULongLong, UInt>> edges;
+		edges.reserve(triangle_count * 3);
+		for (UInt t = 0; t < triangle_count; ++t)
+		{
+			for (UInt e = 0; e < 3; ++e)
+			{
+				const UInt a = indices[t * 3 + e];
+				const UInt b = indices[t * 3 + (e + 1) % 3];
+				const UInt group_a = position_group[a];
+				const UInt group_b = position_group[b];
+				const ULongLong key = (static_cast<ULongLong>(std::min(group_a, group_b)) << 32) | std::max(group_a, group_b);
+				edges.emplace_back(key, t * 3 + e);
+			}
+		}
+		std::sort(edges.begin(), edges.end());
+		for (std::size_t begin = 0; begin < edges.size();)
+		{
+			std::size_t end = begin + 1;
+			while (end < edges.size() && edges[end].first == edges[begin].first) ++end;
+			if (end - begin != 2)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					const UInt corner = edges[i].second;
+					locked[indices[corner]] = true;
+					locked[indices[corner - corner % 3 + (corner % 3 + 1) % 3]] = true;
+				}
+			}
+			begin = end;
+		}
+
+		// 面积加权的平面二次型
+		std::vector<Quadric> quadrics(vertex_count);
+		std::vector<std::vector<UInt>> vertex_triangles(vertex_count);
+		std::vector<UInt> triangles(indices.begin(), indices.begin() + triangle_count * 3);
+		std::vector<Bool> triangle_alive(triangle_count, true);
+		UInt alive_triangle_count = 0;
+		for (UInt t = 0; t < triangle_count; ++t)
+		{
+			const UInt i0 = triangles[t * 3 + 0];
+			const UInt i1 = triangles[t * 3 + 1];
+			const UInt i2 = triangles[t * 3 + 2];
+			if (i0 == i1 || i1 == i2 || i0 == i2)
+			{
+				triangle_alive[t] = false;
+				continue;
+			}
+			++alive_triangle_count;
+			vertex_triangles[i0].push_back(t);
+			vertex_triangles[i1].push_back(t);
+			vertex_triangles[i2].push_back(t);
+
+			const SimplifyVector normal = Cross(Sub(points[i1], points[i0]), Sub(points[i2], points[i0]));
+			const Double double_area = std::sqrt(Dot(normal, normal));
+			if (double_area <= 0.0)
+			{
+				continue;
+			}
+			const SimplifyVector unit_normal{ normal.x / double_area, normal.y / double_area, normal.z / double_area };
+			const Double d = -Dot(unit_normal, points[i0]);
+			const Double area = double_area * 0.5;
+			quadrics[position_group[i0]].AddPlane(unit_normal, d, area);
+			quadrics[position_group[i1]].AddPlane(unit_normal, d, area);
+			quadrics[position_group[i2]].AddPlane(unit_normal, d, area);
+		}
+		for (UInt i = 0; i < vertex_count; ++i)
+		{
+			quadrics[i] = quadrics[position_group[i]];
+		}
+
+		std::priority_queue<CollapseCandidate, std::vector<CollapseCandidate>, std::greater<CollapseCandidate>> heap;
+		auto push_candidate = [&](UInt from, UInt to)
+		{
+			if (locked[from] || from == to) return;
+			heap.push({ CollapseError(quadrics[from], quadrics[to], points[to]), from, to });
+		};
+		for (UInt t = 0; t < triangle_count; ++t)
+		{
+			if (!triangle_alive[t]) continue;
+			for (UInt e = 0; e < 3; ++e)
+			{
+				const UInt a = triangles[t * 3 + e];
+				const UInt b = triangles[t * 3 + (e + 1) % 3];
+				push_candidate(a, b);
+				push_candidate(b, a);
+			}
+		}
+
+		std::vector<Bool> collapsed(vertex_count, false);
+		const Double target_error_squared = static_cast<Double>(target_error) * target_error;
+		Double max_error_squared = 0.0;
+		const UInt target_triangle_count = target_index_count / 3;
+
+		while (alive_triangle_count > target_triangle_count && !heap.empty())
+		{
+			const CollapseCandidate candidate = heap.top();
+			heap.pop();
+			const UInt from = candidate.from;
+			const UInt to = candidate.to;
+			if (collapsed[from] || collapsed[to])
+			{
+				continue;
+			}
+
+			// 端点的二次型在入堆之后可能已经合并过，误差变大的重新入堆
+			const Double error = CollapseError(quadrics[from], quadrics[to], points[to]);
+			if (error > candidate.error * (1.0 + 1e-9) + 1e-18)
+			{
+				heap.push({ error, from, to });
+				continue;
+			}
+			if (error > target_error_squared)
+			{
+				break;
+			}
+
+			Bool shares_edge = false;
+			Bool flipped = false;
+			for (UInt t : vertex_triangles[from])
+			{
+				if (!triangle_alive[t]) continue;
+				const UInt* corners = &triangles[t * 3];
+				if (corners[0] == to || corners[1] == to || corners[2] == to)
+				{
+					shares_edge = true;
+					continue;
+				}
+
+				SimplifyVector p[3];
+				SimplifyVector q[3];
+				for (UInt c = 0; c < 3; ++c)
+				{
+					p[c] = points[corners[c]];
+					q[c] = corners[c] == from ? points[to] : p[c];
+				}
+				const SimplifyVector old_normal = Cross(Sub(p[1], p[0]), Sub(p[2], p[0]));
+				const SimplifyVector new_normal = Cross(Sub(q[1], q[0]), Sub(q[2], q[0]));
+				const Double old_length = std::sqrt(Dot(old_normal, old_normal));
+				const Double new_length = std::sqrt(Dot(new_normal, new_normal));
+				if (new_length <= 0.0 || Dot(old_normal, new_normal) < kFlipDotThreshold * old_length * new_length)
+				{
+					flipped = true;
+					break;
+				}
+			}
+			if (!shares_edge || flipped)
+			{
+				continue;
+			}
+
+			// 折叠：包含整条边的三角形退化删除，其余三角形改为引用 to
+			for (UInt t : vertex_triangles[from])
+			{
+				if (!triangle_alive[t]) continue;
+				UInt* corners = &triangles[t * 3];
+				if (corners[0] == to || corners[1] == to || corners[2] == to)
+				{
+					triangle_alive[t] = false;
+					--alive_triangle_count;
+					continue;
+				}
+				for (UInt c = 0; c < 3; ++c)
+				{
+					if (corners[c] == from) corners[c] = to;
+				}
+				vertex_triangles[to].push_back(t);
+			}
+			vertex_triangles[from].clear();
+			collapsed[from] = true;
+			quadrics[to].Add(quadrics[from]);
+			max_error_squared = std::max(max_error_squared, error);
+
+			// 清理 to 的失效三角形并为新的一圈边生成候选
+			std::vector<UInt>& around = vertex_triangles[to];
+			around.erase(std::remove_if(around.begin(), around.end(), [&triangle_alive](UInt t) { return !triangle_alive[t]; }), around.end());
+			for (UInt t : around)
+			{
+				for (UInt c = 0; c < 3; ++c)
+				{
+					const UInt other = triangles[t * 3 + c];
+					if (other == to) continue;
+					push_candidate(other, to);
+					push_candidate(to, other);
+				}
+			}
+		}
+
+		out_indices.reserve(alive_triangle_count * 3);
+		for (UInt t = 0; t < triangle_count; ++t)
+		{
+			if (!triangle_alive[t]) continue;
+			out_indices.insert(out_indices.end(), triangles.begin() + t * 3, triangles.begin() + t * 3 + 3);
+		}
+		return static_cast<Float>(std::sqrt(max_error_squared));
+	}
+
+	std::vector<MeshLOD> GenerateMeshLODChain(
+		const Float* positions, UInt vertex_count, UInt stride,
+		const std::vector<UInt>& indices,
+		const MeshLODChainSettings& settings /*= MeshLODChainSettings()*/)
+	{
+		std::vector<MeshLOD> lods;
+		const std::vector<UInt>* previous_indices = &indices;
+		Float previous_error = 0.0f;
+		Float screen_size = settings.first_screen_size;
+		for (UInt lod_index = 0; lod_index < settings.max_lod_count; ++lod_index)
+		{
+			const UInt previous_triangle_count = static_cast<UInt>(previous_indices->size() / 3);
+			const UInt target_triangle_count = static_cast<UInt>(previous_triangle_count * settings.reduction_ratio);
+			if (target_triangle_count == 0)
+			{
+				break;
+			}
+
+			MeshLOD lod;
+			const Float error = SimplifyMesh(positions, vertex_count, stride, *previous_indices, target_triangle_count * 3, settings.max_error, lod.indices);
+			if (lod.indices.empty() || lod.indices.size() > previous_indices->size() * settings.min_reduction)
+			{
+				break;
+			}
+
+			// 每级在上一级上简化，误差累加作为相对原始网格的保守上界
+			lod.error = previous_error + error;
+			lod.screen_size = screen_size;
+			previous_error = lod.error;
+			screen_size *= 0.5f;
+			lods.push_back(std::move(lod));
+			previous_indices = &lods.back().indices;
+		}
+		return lods;
+	}
+
+	Float ComputeScreenSize(const BoundingSphere& world_sphere, const Vector3& camera_position, Float projection_scale)
+	{
+		const Float distance = (world_sphere.center - camera_position).Length();
+		if (distance <= world_sphere.radius)
+		{
+			return DOLAS_FLOAT_MAX;
+		}
+		// NDC 中投影半径为 r * P11 / d，屏幕高度为 2
+		return world_sphere.radius * projection_scale / distance;
+	}
+
+	Float ComputeOrthographicScreenSize(const BoundingSphere& world_sphere, Float view_half_height)
+	{
+		if (view_half_height <= 0.0f)
+		{
+			return DOLAS_FLOAT_MAX;
+		}
+		return world_sphere.radius / view_half_height;
+	}
+
+	UInt SelectMeshLOD(Float screen_size, const Float* lod_screen_sizes, UInt lod_count, UInt current_lod, Float hysteresis)
+	{
+		if (lod_count == 0 || lod_screen_sizes == nullptr)
+		{
+			return 0;
+		}
+		UInt lod = std::min(current_lod, lod_count - 1);
+		while (lod + 1 < lod_count && screen_size < lod_screen_sizes[lod + 1] * (1.0f - hysteresis))
+		{
+			++lod;
+		}
+		while (lod > 0 && screen_size > lod_screen_sizes[lod] * (1.0f + hysteresis))
+		{
+			--lod;
+		}
+		return lod;
+	}
+}
@@ -0,0 +1,302 @@
+#include "dolas_meshlet.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Dolas
+{
+	namespace
+	{
+		// 法线锥半角超过约 84 度时背面剔除几乎不可能成功，直接视为无效
+		constexpr Float kMinConeDot = 0.1f;
+
+		Vector3 GetPosition(const Float* positions, UInt stride, UInt index)
+		{
+			const Float* p = positions + static_cast<std::size_t>(index) * stride;
+			return Vector3(p[0], p[1], p[2]);
+		}
+
+		void ComputeMeshletCone(const Float* positions, UInt stride, const MeshletData& meshlet_data, Meshlet& meshlet)
+		{
+			std::vector<Vector3> normals;
+			std::vector<Vector3> first_corners;
+			normals.reserve(meshlet.triangle_count);
+			first_corners.reserve(meshlet.triangle_count);
+
+			Vector3 normal_sum = Vector3::ZERO;
+			for (UInt t = 0; t < meshlet.triangle_count; ++t)
+			{
+				const UByte* local = &meshlet_data.triangles[(meshlet.triangle_offset + t) * 3];
+				const Vector3 p0 = GetPosition(positions, stride, meshlet_data.vertices[meshlet.vertex_offset + local[0]]);
+				const Vector3 p1 = GetPosition(positions, stride, meshlet_data.vertices[meshlet.vertex_offset + local[1]]);
+				const Vector3 p2 = GetPosition(positions, stride, meshlet_data.vertices[meshlet.vertex_offset + local[2]]);
+				const Vector3 normal = (p1 - p0).Cross(p2 - p0);
+				const Float length = normal.Length();
+				if (length <= 0.0f)
+				{
+					// 零面积三角形不会被光栅化，不影响法线锥
+					continue;
+				}
+				normals.push_back(normal * (1.0f / length));
+				first_corners.push_back(p0);
+				normal_sum = normal_sum + normals.back();
+			}
+
+			meshlet.cone_apex = meshlet.bounds.center;
+			meshlet.cone_axis = Vector3::ZERO;
+			meshlet.cone_cutoff = 2.0f;
+			const Float sum_length = normal_sum.Length();
+			if (normals.empty() || sum_length <= 0.0f)
+			{
+				return;
+			}
+
+			const Vector3 axis = normal_sum * (1.0f / sum_length);
+			Float min_dot = 1.0f;
+			for (const Vector3& normal : normals)
+			{
+				min_dot = std::min(min_dot, normal.Dot(axis));
+			}
+			if (min_dot <= kMinConeDot)
+			{
+				return;
+			}
+
+			// 沿 -axis 从包围球心后退，直到位于所有三角形平面的背面一侧：
+			// 相机在 apex 之后的锥体内时，它也在每个三角形平面的背面
+			Float max_t = 0.0f;
+			for (std::size_t i = 0; i < normals.size(); ++i)
+			{
+				const Float t = (meshlet.bounds.center - first_corners[i]).Dot(normals[i]) / normals[i].Dot(axis);
+				max_t = std::max(max_t, t);
+			}
+
+			meshlet.cone_apex = meshlet.bounds.center - axis * max_t;
+			meshlet.cone_axis = axis;
+			meshlet.cone_cutoff = std::sqrt(std::max(0.0f, 1.0f - min_dot * min_dot));
+		}
+	}
+
+	void MeshletData::Clear()
+	{
+		meshlets.clear();
+		vertices.clear();
+		triangles.clear();
+	}
+
+	Bool BuildMeshlets(
+		const Float* positions, UInt vertex_count, UInt stride,
+		const std::vector<UInt>& indices,
+		MeshletData& out_meshlets,
+		UInt max_vertices /*= kMeshletMaxVertices*/,
+		UInt max_triangles /*= kMeshletMaxTriangles*/)
+	{
+		out_meshlets.Clear();
+		// 局部下标以 UByte 存储
+		if (positions == nullptr || stride < 3 || max_vertices < 3 || max_vertices > 256 || max_triangles == 0 || indices.size() % 3 != 0)
+		{
+			return false;
+		}
+		for (UInt index : indices)
+		{
+			if (index >= vertex_count) return false;
+		}
+
+		const UInt triangle_count = static_cast<UInt>(indices.size() / 3);
+
+		// 顶点 -> 三角形邻接表（CSR）
+		std::vector<UInt> adjacency_offsets(vertex_count + 1, 0);
+		for (UInt index : indices) ++adjacency_offsets[index + 1];
+		for (UInt v = 0; v < vertex_count; ++v) adjacency_offsets[v + 1] += adjacency_offsets[v];
+		std::vector<UInt> adjacency(indices.size());
+		{
+			std::vector<UInt> fill = adjacency_offsets;
+			for (UInt t = 0; t < triangle_count; ++t)
+			{
+				for (UInt c = 0; c < 3; ++c) adjacency[fill[indices[t * 3 + c]]++] = t;
+			}
+		}
+
+		std::vector<Vector3> centroids(triangle_count);
+		std::vector<Bool> emitted(triangle_count, false);
+		UInt remaining = triangle_count;
+		for (UInt t = 0; t < triangle_count; ++t)
+		{
+			const UInt i0 = indices[t * 3 + 0];
+			const UInt i1 = indices[t * 3 + 1];
+			const UInt i2 = indices[t * 3 + 2];
+			centroids[t] = (GetPosition(positions, stride, i0) + GetPosition(positions, stride, i1) + GetPosition(positions, stride, i2)) * (1.0f / 3.0f);
+			if (i0 == i1 || i1 == i2 || i0 == i2)
+			{
+				emitted[t] = true;
+				--remaining;
+			}
+		}
+
+		std::vector<Int> local_index(vertex_count, -1);
+		std::vector<UInt> current_vertices;
+		std::vector<UInt> current_triangles;
+		std::vector<UInt> candidates;
+		Vector3 centroid_sum = Vector3::ZERO;
+		UInt next_seed = 0;
+
+		auto count_new_vertices = [&](UInt t)
+		{
+			UInt count = 0;
+			for (UInt c = 0; c < 3; ++c) count += local_index[indices[t * 3 + c]] < 0 ? 1 : 0;
+			return count;
+		};
+
+		auto add_triangle = [&](UInt t)
+		{
+			for (UInt c = 0; c < 3; ++c)
+			{
+				const UInt vertex = indices[t * 3 + c];
+				if (local_index[vertex] >= 0) continue;
+				local_index[vertex] = static_cast<Int>(current_vertices.size());
+				current_vertices.push_back(vertex);
+				for (UInt a = adjacency_offsets[vertex]; a < adjacency_offsets[vertex + 1]; ++a)
+				{
+					if (!emitted[adjacency[a]]) candidates.push_back(adjacency[a]);
+				}
+			}
+			current_triangles.push_back(t);
+			centroid_sum = centroid_sum + centroids[t];
+			emitted[t] = true;
+			--remaining;
+		};
+
+		auto flush = [&]()
+		{
+			if (current_triangles.empty()) return;
+
+			Meshlet meshlet;
+			meshlet.vertex_offset = static_cast<UInt>(out_meshlets.vertices.size());
+			meshlet.vertex_count = static_cast<UInt>(current_vertices.size());
+			meshlet.triangle_offset = static_cast<UInt>(out_meshlets.triangles.size() / 3);
+			meshlet.triangle_count = static_cast<UInt>(current_triangles.size());
+
+			std::vector<Float> meshlet_positions;
+			meshlet_positions.reserve(current_vertices.size() * 3);
+			for (UInt vertex : current_vertices)
+			{
+				out_meshlets.vertices.push_back(vertex);
+				const Vector3 p = GetPosition(positions, stride, vertex);
+				meshlet_positions.insert(meshlet_positions.end(), { p.x, p.y, p.z });
+			}
+			for (UInt t : current_triangles)
+			{
+				for (UInt c = 0; c < 3; ++c) out_meshlets.triangles.push_back(static_cast<UByte>(local_index[indices[t * 3 + c]]));
+			}
+			meshlet.bounds = BoundingSphere::FromPositions(meshlet_positions.data(), current_vertices.size());
+			ComputeMeshletCone(positions, stride, out_meshlets, meshlet);
+			out_meshlets.meshlets.push_back(meshlet);
+
+			for (UInt vertex : current_vertices) local_index[vertex] = -1;
+			current_vertices.clear();
+			current_triangles.clear();
+			candidates.clear();
+			centroid_sum = Vector3::ZERO;
+		};
+
+		while (remaining > 0)
+		{
+			if (current_triangles.empty())
+			{
+				while (emitted[next_seed]) ++next_seed;
+				add_triangle(next_seed);
+				continue;
+			}
+
+			// 在邻接候选中选择新增顶点最少、离 meshlet 中心最近的三角形；顺便压缩掉已输出的候选
+			const Vector3 center = centroid_sum * (1.0f / static_cast<Float>(current_triangles.size()));
+			Int best_triangle = -1;
+			UInt best_new_vertices = 4;
+			Float best_distance = 0.0f;
+			std::size_t write = 0;
+			for (std::size_t read = 0; read < candidates.size(); ++read)
+			{
+				const UInt t = candidates[read];
+				if (emitted[t]) continue;
+				candidates[write++] = t;
+
+				const UInt new_vertices = count_new_vertices(t);
+				if (current_vertices.size() + new_vertices > max_vertices) continue;
+				const Float distance = (centroids[t] - center).LengthSquared();
+				if (new_vertices < best_new_vertices || (new_vertices == best_new_vertices && (distance < best_distance || (distance == best_distance && static_cast<Int>(t) < best_triangle))))
+				{
+					best_triangle = static_cast<Int>(t);
+					best_new_vertices = new_vertices;
+					best_distance = distance;
+				}
+			}
+			candidates.resize(write);
+
+			if (best_triangle < 0)
+			{
+				// 没有相邻三角形（网格不连通或顶点未共享）时按索引顺序继续填充，避免生成大量很小的 meshlet
+				while (emitted[next_seed]) ++next_seed;
+				if (candidates.empty() && current_vertices.size() + count_new_vertices(next_seed) <= max_vertices)
+				{
+					best_triangle = static_cast<Int>(next_seed);
+				}
+				else
+				{
+					flush();
+					continue;
+				}
+			}
+			add_triangle(static_cast<UInt>(best_triangle));
+			if (current_triangles.size() >= max_triangles)
+			{
+				flush();
+			}
+		}
+		flush();
+		return true;
+	}
+
+	Bool IsMeshletBackfacing(const Meshlet& meshlet, const Vector3& camera_position)
+	{
+		if (!meshlet.HasValidCone())
+		{
+			return false;
+		}
+		const Vector3 to_apex = meshlet.cone_apex - camera_position;
+		return to_apex.Dot(meshlet.cone_axis) >= meshlet.cone_cutoff * to_apex.Length();
+	}
+
+	MeshletCullingResult CullMeshlets(
+		const MeshletData& meshlet_data,
+		const Matrix4x4& world,
+		const Frustum& world_frustum,
+		const Vector3& model_space_camera_position,
+		Bool enable_backface,
+		std::vector<UInt>& out_indices)
+	{
+		MeshletCullingResult result;
+		const std::size_t start_size = out_indices.size();
+		for (const Meshlet& meshlet : meshlet_data.meshlets)
+		{
+			if (!world_frustum.IntersectsSphere(meshlet.bounds.Transform(world)))
+			{
+				++result.frustum_culled_count;
+				continue;
+			}
+			if (enable_backface && IsMeshletBackfacing(meshlet, model_space_camera_position))
+			{
+				++result.backface_culled_count;
+				continue;
+			}
+
+			++result.visible_meshlet_count;
+			const UInt* vertices = &meshlet_data.vertices[meshlet.vertex_offset];
+			const UByte* triangles = &meshlet_data.triangles[meshlet.triangle_offset * 3];
+			for (UInt i = 0; i < meshlet.triangle_count * 3; ++i)
+			{
+				out_indices.push_back(vertices[triangles[i]]);
+			}
+		}
+		result.index_count = static_cast<UInt>(out_indices.size() - start_size);
+		return result;
+	}
+}
@@ -1,8 +1,12 @@
 #include "dolas_paths.h"
+#include <cstdio>
 
 namespace Dolas
 {
 #define SHADER_DIR_NAME "shader/"
+#define CACHE_DIR_NAME "cache/"
+#define TEXTURE_DIR_NAME "texture/"
+#define IBL_DIR_NAME "ibl/"
 	std::string PathUtils::g_engine_content_directory_path = ENGINE_CONTENT_DIR;
 	std::string PathUtils::g_project_content_directory_path = "";
 
@@ -46,6 +50,32 @@ namespace Dolas
 		return GetEngineContentDir() + SHADER_DIR_NAME;
 	}
 
+	std::string PathUtils::GetEngineCacheDir() {
+		return GetEngineContentDir() + CACHE_DIR_NAME;
+	}
+
+	std::string PathUtils::GetCompiledShadersDir() {
+		return GetEngineCacheDir() + SHADER_DIR_NAME;
+	}
+
+	std::string PathUtils::GetCookedTexturesDir() {
+		return GetEngineCacheDir() + TEXTURE_DIR_NAME;
+	}
+
+	std::filesystem::path PathUtils::GetCookedTexturePath(const AssetPath& asset_path) {
+		return std::filesystem::path{GetCookedTexturesDir() + asset_path.GetCanonicalPath() + ".dds"}.lexically_normal();
+	}
+
+	std::filesystem::path PathUtils::GetCookedCubemapPath(const AssetPath& asset_path) {
+		return std::filesystem::path{GetCookedTexturesDir() + asset_path.GetCanonicalPath() + ".cube.dds"}.lexically_normal();
+	}
+
+	std::filesystem::path PathUtils::GetImageBasedLightingCachePath(ULongLong cache_key, const std::string& extension) {
+		char key_string[17];
+		std::snprintf(key_string, sizeof(key_string), "%016llx", cache_key);
+		return std::filesystem::path{GetEngineCacheDir() + IBL_DIR_NAME + key_string + "." + extension}.lexically_normal();
+	}
+
 #if !defined(NDEBUG)
 	void PathUtils::SetEngineContentDirForDebug(const std::string& engine_content_dir)
 	{
@@ -0,0 +1,279 @@
+#include "dolas_pipeline_cache.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "dolas_hash.h"
+
+namespace Dolas
+{
+	namespace
+	{
+		struct PipelineCacheFileHeader
+		{
+			UInt magic = 0;
+			UInt version = 0;
+			ULongLong device_identity = 0;
+			ULongLong payload_size = 0;
+			ULongLong payload_hash = 0;
+		};
+
+		class ByteWriter
+		{
+		public:
+			explicit ByteWriter(std::vector<UByte>& bytes) : m_bytes(bytes) {}
+
+			void WriteRaw(const void* data, std::size_t size)
+			{
+				const UByte* begin = static_cast<const UByte*>(data);
+				m_bytes.insert(m_bytes.end(), begin, begin + size);
+			}
+
+			void WriteUInt(UInt value) { WriteRaw(&value, sizeof(value)); }
+
+			void WriteString(const std::string& value)
+			{
+				WriteUInt(static_cast<UInt>(value.size()));
+				WriteRaw(value.data(), value.size());
+			}
+
+		private:
+			std::vector<UByte>& m_bytes;
+		};
+
+		class ByteReader
+		{
+		public:
+			ByteReader(const UByte* data, std::size_t size) : m_data(data), m_size(size) {}
+
+			Bool ReadRaw(void* out, std::size_t size)
+			{
+				if (m_offset + size > m_size)
+				{
+					return false;
+				}
+				std::memcpy(out, m_data + m_offset, size);
+				m_offset += size;
+				return true;
+			}
+
+			Bool ReadUInt(UInt& value) { return ReadRaw(&value, sizeof(value)); }
+
+			Bool ReadString(std::string& value)
+			{
+				UInt length = 0;
+				if (!ReadUInt(length) || m_offset + length > m_size)
+				{
+					return false;
+				}
+				value.assign(reinterpret_cast<const char*>(m_data + m_offset), length);
+				m_offset += length;
+				return true;
+			}
+
+			std::size_t GetRemaining() const { return m_size - m_offset; }
+			const UByte* GetCurrent() const { return m_data + m_offset; }
+
+		private:
+			const UByte* m_data = nullptr;
+			std::size_t m_size = 0;
+			std::size_t m_offset = 0;
+		};
+
+		ULongLong HashUInt(ULongLong seed, UInt value)
+		{
+			return HashConverter::BytesHash64(&value, sizeof(value), seed);
+		}
+
+		ULongLong HashString(ULongLong seed, const std::string& value)
+		{
+			seed = HashUInt(seed, static_cast<UInt>(value.size()));
+			return HashConverter::BytesHash64(value.data(), value.size(), seed);
+		}
+	}
+
+	Bool PipelineStateRecord::operator==(const PipelineStateRecord& other) const
+	{
+		if (vertex_shader_path != other.vertex_shader_path ||
+			vertex_entry_point != other.vertex_entry_point ||
+			pixel_shader_path != other.pixel_shader_path ||
+			pixel_entry_point != other.pixel_entry_point)
+		{
+			return false;
+		}
+		return HashPipelineStateRecordStates(*this) == HashPipelineStateRecordStates(other);
+	}
+
+	ULongLong HashPipelineStateRecordStates(const PipelineStateRecord& record)
+	{
+		ULongLong hash = HashConverter::BytesHash64(nullptr, 0);
+		hash = HashUInt(hash, record.input_layout);
+		hash = HashUInt(hash, record.rasterizer_state);
+		hash = HashUInt(hash, record.depth_stencil_state);
+		hash = HashUInt(hash, record.blend_state);
+		hash = HashUInt(hash, record.primitive_topology);
+		hash = HashUInt(hash, record.render_target_count);
+		// 只有前 render_target_count 个格式有意义
+		const UInt render_target_count = record.render_target_count < PipelineStateRecord::MAX_RENDER_TARGETS
+			? record.render_target_count
+			: PipelineStateRecord::MAX_RENDER_TARGETS;
+		for (UInt i = 0; i < render_target_count; ++i)
+		{
+			hash = HashUInt(hash, record.render_target_formats[i]);
+		}
+		hash = HashUInt(hash, record.depth_stencil_format);
+		return hash;
+	}
+
+	ULongLong ComputePipelineStateKey(ULongLong vertex_bytecode_hash, ULongLong pixel_bytecode_hash, const PipelineStateRecord& record)
+	{
+		ULongLong key = HashPipelineStateRecordStates(record);
+		key = HashConverter::BytesHash64(&vertex_bytecode_hash, sizeof(vertex_bytecode_hash), key);
+		key = HashConverter::BytesHash64(&pixel_bytecode_hash, sizeof(pixel_bytecode_hash), key);
+		return key;
+	}
+
+	Bool PipelineCacheFile::Load(const std::string& file_path, ULongLong device_identity)
+	{
+		Clear();
+
+		std::ifstream file(file_path, std::ios::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+		std::vector<UByte> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		PipelineCacheFileHeader header;
+		if (bytes.size() < sizeof(header))
+		{
+			return false;
+		}
+		std::memcpy(&header, bytes.data(), sizeof(header));
+		if (header.magic != FILE_MAGIC ||
+			header.version != FILE_VERSION ||
+			header.device_identity != device_identity ||
+			header.payload_size != bytes.size() - sizeof(header))
+		{
+			return false;
+		}
+
+		const UByte* payload = bytes.data() + sizeof(header);
+		const std::size_t payload_size = static_cast<std::size_t>(header.payload_size);
+		if (HashConverter::BytesHash64(payload, payload_size) != header.payload_hash)
+		{
+			return false;
+		}
+
+		ByteReader reader(payload, payload_size);
+		UInt record_count = 0;
+		if (!reader.ReadUInt(record_count))
+		{
+			return false;
+		}
+
+		std::vector<PipelineStateRecord> records;
+		for (UInt i = 0; i < record_count; ++i)
+		{
+			PipelineStateRecord record;
+			Bool ok = reader.ReadString(record.vertex_shader_path) &&
+				reader.ReadString(record.vertex_entry_point) &&
+				reader.ReadString(record.pixel_shader_path) &&
+				reader.ReadString(record.pixel_entry_point) &&
+				reader.ReadUInt(record.input_layout) &&
+				reader.ReadUInt(record.rasterizer_state) &&
+				reader.ReadUInt(record.depth_stencil_state) &&
+				reader.ReadUInt(record.blend_state) &&
+				reader.ReadUInt(record.primitive_topology) &&
+				reader.ReadUInt(record.render_target_count) &&
+				reader.ReadRaw(record.render_target_formats, sizeof(record.render_target_formats)) &&
+				reader.ReadUInt(record.depth_stencil_format);
+			if (!ok)
+			{
+				return false;
+			}
+			records.push_back(std::move(record));
+		}
+
+		for (const PipelineStateRecord& record : records)
+		{
+			AddRecord(record);
+		}
+		m_library_blob.assign(reader.GetCurrent(), reader.GetCurrent() + reader.GetRemaining());
+		m_dirty = false;
+		return true;
+	}
+
+	Bool PipelineCacheFile::Save(const std::string& file_path, ULongLong device_identity) const
+	{
+		std::vector<UByte> payload;
+		ByteWriter writer(payload);
+		writer.WriteUInt(static_cast<UInt>(m_records.size()));
+		for (const PipelineStateRecord& record : m_records)
+		{
+			writer.WriteString(record.vertex_shader_path);
+			writer.WriteString(record.vertex_entry_point);
+			writer.WriteString(record.pixel_shader_path);
+			writer.WriteString(record.pixel_entry_point);
+			writer.WriteUInt(record.input_layout);
+			writer.WriteUInt(record.rasterizer_state);
+			writer.WriteUInt(record.depth_stencil_state);
+			writer.WriteUInt(record.blend_state);
+			writer.WriteUInt(record.primitive_topology);
+			writer.WriteUInt(record.render_target_count);
+			writer.WriteRaw(record.render_target_formats, sizeof(record.render_target_formats));
+			writer.WriteUInt(record.depth_stencil_format);
+		}
+		writer.WriteRaw(m_library_blob.data(), m_library_blob.size());
+
+		PipelineCacheFileHeader header;
+		header.magic = FILE_MAGIC;
+		header.version = FILE_VERSION;
+		header.device_identity = device_identity;
+		header.payload_size = payload.size();
+		header.payload_hash = HashConverter::BytesHash64(payload.data(), payload.size());
+
+		std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+		return file.good();
+	}
+
+	void PipelineCacheFile::Clear()
+	{
+		m_records.clear();
+		m_record_hashes.clear();
+		m_library_blob.clear();
+		m_dirty = false;
+	}
+
+	Bool PipelineCacheFile::AddRecord(const PipelineStateRecord& record)
+	{
+		if (!m_record_hashes.insert(HashRecord(record)).second)
+		{
+			return false;
+		}
+		m_records.push_back(record);
+		m_dirty = true;
+		return true;
+	}
+
+	void PipelineCacheFile::SetLibraryBlob(std::vector<UByte>&& library_blob)
+	{
+		m_library_blob = std::move(library_blob);
+		m_dirty = true;
+	}
+
+	ULongLong PipelineCacheFile::HashRecord(const PipelineStateRecord& record)
+	{
+		ULongLong hash = HashPipelineStateRecordStates(record);
+		hash = HashString(hash, record.vertex_shader_path);
+		hash = HashString(hash, record.vertex_entry_point);
+		hash = HashString(hash, record.pixel_shader_path);
+		hash = HashString(hash, record.pixel_entry_point);
+		return hash;
+	}
+}
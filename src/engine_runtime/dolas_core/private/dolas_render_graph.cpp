@@ -0,0 +1,375 @@
+#include "dolas_render_graph.h"
+#include <algorithm>
+
+namespace Dolas
+{
+	namespace
+	{
+		Bool IsSingleBit(UInt value)
+		{
+			return value != 0 && (value & (value - 1)) == 0;
+		}
+
+		ULongLong AlignUp(ULongLong value, ULongLong alignment)
+		{
+			return alignment <= 1 ? value : (value + alignment - 1) / alignment * alignment;
+		}
+
+		// 资源在执行顺序中的一次使用
+		struct ResourceUse
+		{
+			UInt execution_index = 0;
+			UInt state = RenderGraphAccess_None;
+		};
+	}
+
+	void RenderGraphCompileResult::Clear()
+	{
+		passes.clear();
+		final_barriers.clear();
+		resources.clear();
+		pass_culled.clear();
+		transient_heap_size = 0;
+		unaliased_heap_size = 0;
+		transition_barrier_count = 0;
+		aliasing_barrier_count = 0;
+		barrier_batch_count = 0;
+		culled_pass_count = 0;
+	}
+
+	void RenderGraph::Reset()
+	{
+		m_resources.clear();
+		m_passes.clear();
+		m_has_invalid_access = false;
+	}
+
+	RenderGraphResourceHandle RenderGraph::CreateTexture(const std::string& name, const RenderGraphTextureDesc& desc)
+	{
+		ResourceNode node;
+		node.name = name;
+		node.imported = false;
+		node.desc = desc;
+		m_resources.push_back(node);
+		return static_cast<RenderGraphResourceHandle>(m_resources.size() - 1);
+	}
+
+	RenderGraphResourceHandle RenderGraph::ImportTexture(const std::string& name, UInt initial_state, UInt final_state /*= RenderGraphAccess_None*/)
+	{
+		ResourceNode node;
+		node.name = name;
+		node.imported = true;
+		node.initial_state = initial_state;
+		node.final_state = final_state;
+		m_resources.push_back(node);
+		return static_cast<RenderGraphResourceHandle>(m_resources.size() - 1);
+	}
+
+	RenderGraphPassHandle RenderGraph::AddPass(const std::string& name, Bool has_side_effects /*= false*/)
+	{
+		PassNode node;
+		node.name = name;
+		node.has_side_effects = has_side_effects;
+		m_passes.push_back(node);
+		return static_cast<RenderGraphPassHandle>(m_passes.size() - 1);
+	}
+
+	void RenderGraph::Read(RenderGraphPassHandle pass, RenderGraphResourceHandle resource, UInt access)
+	{
+		const Bool valid_read = access == RenderGraphAccess_Present || (access != 0 && (access & ~kRenderGraphReadAccessMask) == 0);
+		if (!valid_read)
+		{
+			m_has_invalid_access = true;
+			return;
+		}
+		AddAccess(pass, resource, access, false);
+	}
+
+	void RenderGraph::Write(RenderGraphPassHandle pass, RenderGraphResourceHandle resource, UInt access)
+	{
+		if (!IsSingleBit(access) || (access & kRenderGraphWriteAccessMask) == 0)
+		{
+			m_has_invalid_access = true;
+			return;
+		}
+		AddAccess(pass, resource, access, true);
+	}
+
+	void RenderGraph::AddAccess(RenderGraphPassHandle pass, RenderGraphResourceHandle resource, UInt access, Bool write)
+	{
+		if (pass >= m_passes.size() || resource >= m_resources.size())
+		{
+			m_has_invalid_access = true;
+			return;
+		}
+
+		for (ResourceAccess& existing : m_passes[pass].accesses)
+		{
+			if (existing.resource != resource)
+			{
+				continue;
+			}
+			// 一个 pass 内资源只能处于一个状态：读与写、两种不同的写、Present 与其他读都不能共存
+			const UInt merged = existing.access | access;
+			if (existing.write != write || (write && existing.access != access) || ((merged & RenderGraphAccess_Present) && merged != RenderGraphAccess_Present))
+			{
+				m_has_invalid_access = true;
+				return;
+			}
+			existing.access = merged;
+			return;
+		}
+
+		ResourceAccess new_access;
+		new_access.resource = resource;
+		new_access.access = access;
+		new_access.write = write;
+		m_passes[pass].accesses.push_back(new_access);
+	}
+
+	Bool RenderGraph::Compile(RenderGraphCompileResult& out_result) const
+	{
+		out_result.Clear();
+		if (m_has_invalid_access)
+		{
+			return false;
+		}
+
+		const UInt pass_count = static_cast<UInt>(m_passes.size());
+		const UInt resource_count = static_cast<UInt>(m_resources.size());
+
+		// 1. 剔除：反向遍历，被保留的 pass 访问过的资源都视为需要（写按读-改-写处理，因此更早的写入者也需要保留）
+		out_result.pass_culled.assign(pass_count, true);
+		std::vector<Bool> resource_needed(resource_count, false);
+		for (UInt p = pass_count; p-- > 0;)
+		{
+			const PassNode& pass = m_passes[p];
+			Bool keep = pass.has_side_effects;
+			for (const ResourceAccess& access : pass.accesses)
+			{
+				if (access.write && (m_resources[access.resource].imported || resource_needed[access.resource]))
+				{
+					keep = true;
+				}
+			}
+			if (!keep)
+			{
+				++out_result.culled_pass_count;
+				continue;
+			}
+			out_result.pass_culled[p] = false;
+			for (const ResourceAccess& access : pass.accesses)
+			{
+				resource_needed[access.resource] = true;
+			}
+		}
+
+		std::vector<RenderGraphPassHandle> executed_passes;
+		for (UInt p = 0; p < pass_count; ++p)
+		{
+			if (!out_result.pass_culled[p]) executed_passes.push_back(p);
+		}
+		const UInt executed_count = static_cast<UInt>(executed_passes.size());
+
+		// 2. 每个资源的使用序列；连续的只读使用合并为一个组合状态
+		std::vector<std::vector<ResourceUse>> uses(resource_count);
+		for (UInt e = 0; e < executed_count; ++e)
+		{
+			for (const ResourceAccess& access : m_passes[executed_passes[e]].accesses)
+			{
+				ResourceUse use;
+				use.execution_index = e;
+				use.state = access.access;
+				uses[access.resource].push_back(use);
+			}
+		}
+		for (std::vector<ResourceUse>& resource_uses : uses)
+		{
+			std::size_t begin = 0;
+			while (begin < resource_uses.size())
+			{
+				const UInt state = resource_uses[begin].state;
+				const Bool is_read = (state & kRenderGraphWriteAccessMask) == 0 && state != RenderGraphAccess_Present;
+				std::size_t end = begin + 1;
+				if (!is_read)
+				{
+					begin = end;
+					continue;
+				}
+				UInt combined = state;
+				while (end < resource_uses.size() && (resource_uses[end].state & kRenderGraphWriteAccessMask) == 0 && resource_uses[end].state != RenderGraphAccess_Present)
+				{
+					combined |= resource_uses[end].state;
+					++end;
+				}
+				for (std::size_t i = begin; i < end; ++i) resource_uses[i].state = combined;
+				begin = end;
+			}
+		}
+
+		// 3. 瞬态资源的生命周期与堆内偏移（按首次使用排序，在存活的分配之间首次适配）
+		out_result.resources.resize(resource_count);
+		std::vector<UInt> first_use(resource_count, 0);
+		std::vector<UInt> last_use(resource_count, 0);
+		std::vector<RenderGraphResourceHandle> transients;
+		for (UInt r = 0; r < resource_count; ++r)
+		{
+			RenderGraphResourceAllocation& allocation = out_result.resources[r];
+			allocation.transient = !m_resources[r].imported;
+			allocation.used = !uses[r].empty();
+			if (!allocation.used)
+			{
+				continue;
+			}
+			first_use[r] = uses[r].front().execution_index;
+			last_use[r] = uses[r].back().execution_index;
+			allocation.first_pass = executed_passes[first_use[r]];
+			allocation.last_pass = executed_passes[last_use[r]];
+			if (allocation.transient)
+			{
+				allocation.size = m_resources[r].desc.size;
+				transients.push_back(r);
+			}
+		}
+		std::stable_sort(transients.begin(), transients.end(), [&](RenderGraphResourceHandle a, RenderGraphResourceHandle b)
+		{
+			return first_use[a] < first_use[b];
+		});
+
+		std::vector<RenderGraphResourceHandle> live;
+		for (RenderGraphResourceHandle r : transients)
+		{
+			const ULongLong alignment = std::max<ULongLong>(1, m_resources[r].desc.alignment);
+			RenderGraphResourceAllocation& allocation = out_result.resources[r];
+			out_result.unaliased_heap_size = AlignUp(out_result.unaliased_heap_size, alignment) + allocation.size;
+
+			live.erase(std::remove_if(live.begin(), live.end(), [&](RenderGraphResourceHandle other) { return last_use[other] < first_use[r]; }), live.end());
+			std::sort(live.begin(), live.end(), [&](RenderGraphResourceHandle a, RenderGraphResourceHandle b)
+			{
+				return out_result.resources[a].heap_offset < out_result.resources[b].heap_offset;
+			});
+
+			ULongLong offset = 0;
+			for (RenderGraphResourceHandle other : live)
+			{
+				const RenderGraphResourceAllocation& other_allocation = out_result.resources[other];
+				if (offset + allocation.size <= other_allocation.heap_offset)
+				{
+					break;
+				}
+				offset = std::max(offset, AlignUp(other_allocation.heap_offset + other_allocation.size, alignment));
+			}
+			allocation.heap_offset = offset;
+			out_result.transient_heap_size = std::max(out_result.transient_heap_size, offset + allocation.size);
+			live.push_back(r);
+		}
+
+		// 与 resource 共用内存的资源中，本帧最后一个在 resource 之前结束的（没有则为无效句柄）。
+		// 只要与任何瞬态资源重叠就需要别名屏障：内存可能在上一帧被之后的资源占用
+		auto find_aliasing_before = [&](RenderGraphResourceHandle resource, Bool& out_overlaps)
+		{
+			out_overlaps = false;
+			RenderGraphResourceHandle before = kRenderGraphInvalidHandle;
+			const RenderGraphResourceAllocation& allocation = out_result.resources[resource];
+			for (RenderGraphResourceHandle other : transients)
+			{
+				const RenderGraphResourceAllocation& other_allocation = out_result.resources[other];
+				if (other == resource || allocation.size == 0 || other_allocation.size == 0 ||
+					other_allocation.heap_offset >= allocation.heap_offset + allocation.size ||
+					allocation.heap_offset >= other_allocation.heap_offset + other_allocation.size)
+				{
+					continue;
+				}
+				out_overlaps = true;
+				if (last_use[other] < first_use[resource] && (before == kRenderGraphInvalidHandle || last_use[other] > last_use[before]))
+				{
+					before = other;
+				}
+			}
+			return before;
+		};
+
+		// 4. 屏障：导入资源从 initial 状态开始；瞬态资源的帧首状态即稳态下本帧最后的状态
+		std::vector<UInt> current_state(resource_count, RenderGraphAccess_None);
+		for (UInt r = 0; r < resource_count; ++r)
+		{
+			if (m_resources[r].imported)
+			{
+				current_state[r] = m_resources[r].initial_state;
+			}
+			else if (!uses[r].empty())
+			{
+				current_state[r] = uses[r].back().state;
+			}
+		}
+
+		std::vector<UInt> next_use(resource_count, 0);
+		out_result.passes.reserve(executed_count);
+		for (UInt e = 0; e < executed_count; ++e)
+		{
+			RenderGraphCompiledPass compiled;
+			compiled.pass = executed_passes[e];
+			std::vector<RenderGraphBarrier> transitions;
+			for (const ResourceAccess& access : m_passes[compiled.pass].accesses)
+			{
+				const RenderGraphResourceHandle r = access.resource;
+				const ResourceUse& use = uses[r][next_use[r]++];
+
+				if (out_result.resources[r].transient && use.execution_index == first_use[r])
+				{
+					Bool overlaps = false;
+					const RenderGraphResourceHandle before = find_aliasing_before(r, overlaps);
+					if (overlaps)
+					{
+						RenderGraphBarrier barrier;
+						barrier.type = RenderGraphBarrierType_Aliasing;
+						barrier.resource = r;
+						barrier.resource_before = before;
+						compiled.barriers.push_back(barrier);
+						++out_result.aliasing_barrier_count;
+					}
+				}
+
+				if (current_state[r] != use.state)
+				{
+					RenderGraphBarrier barrier;
+					barrier.type = RenderGraphBarrierType_Transition;
+					barrier.resource = r;
+					barrier.state_before = current_state[r];
+					barrier.state_after = use.state;
+					transitions.push_back(barrier);
+					current_state[r] = use.state;
+					++out_result.transition_barrier_count;
+				}
+			}
+			// 别名屏障在同一批次中先于状态转换
+			compiled.barriers.insert(compiled.barriers.end(), transitions.begin(), transitions.end());
+			if (!compiled.barriers.empty())
+			{
+				++out_result.barrier_batch_count;
+			}
+			out_result.passes.push_back(compiled);
+		}
+
+		for (UInt r = 0; r < resource_count; ++r)
+		{
+			const ResourceNode& resource = m_resources[r];
+			if (!resource.imported || resource.final_state == RenderGraphAccess_None || current_state[r] == resource.final_state)
+			{
+				continue;
+			}
+			RenderGraphBarrier barrier;
+			barrier.type = RenderGraphBarrierType_Transition;
+			barrier.resource = r;
+			barrier.state_before = current_state[r];
+			barrier.state_after = resource.final_state;
+			out_result.final_barriers.push_back(barrier);
+			++out_result.transition_barrier_count;
+		}
+		if (!out_result.final_barriers.empty())
+		{
+			++out_result.barrier_batch_count;
+		}
+		return true;
+	}
+}
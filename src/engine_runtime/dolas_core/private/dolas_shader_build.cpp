@@ -0,0 +1,511 @@
+#include "dolas_shader_build.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include "dolas_hash.h"
+
+namespace Dolas
+{
+	namespace
+	{
+		const char* const kManifestHeader = "dolas_shader_manifest";
+
+		Bool HasExtension(const std::string& path, const std::string& extension)
+		{
+			return path.size() >= extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+		}
+
+		std::string GetDirectory(const std::string& path)
+		{
+			const std::size_t slash = path.find_last_of('/');
+			return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+		}
+
+		std::vector<std::string> SplitTabs(const std::string& line)
+		{
+			std::vector<std::string> fields;
+			std::size_t begin = 0;
+			while (true)
+			{
+				const std::size_t tab = line.find('\t', begin);
+				fields.push_back(line.substr(begin, tab == std::string::npos ? std::string::npos : tab - begin));
+				if (tab == std::string::npos)
+				{
+					break;
+				}
+				begin = tab + 1;
+			}
+			return fields;
+		}
+	}
+
+	void ShaderDependencyGraph::Clear()
+	{
+		m_files.clear();
+	}
+
+	void ShaderDependencyGraph::AddFile(const std::string& path, const std::string& content)
+	{
+		FileNode& node = m_files[NormalizePath(path)];
+		node.content_hash = HashConverter::BytesHash64(content.data(), content.size());
+		node.raw_includes = ParseIncludes(content);
+	}
+
+	Bool ShaderDependencyGraph::BuildFromDirectory(const std::string& root_directory)
+	{
+		Clear();
+
+		std::error_code error;
+		const std::filesystem::path root(root_directory);
+		if (!std::filesystem::is_directory(root, error))
+		{
+			return false;
+		}
+
+		Bool all_read = true;
+		for (std::filesystem::recursive_directory_iterator it(root, error), end; !error && it != end; it.increment(error))
+		{
+			if (!it->is_regular_file(error))
+			{
+				continue;
+			}
+			const std::string extension = it->path().extension().string();
+			if (extension != ".hlsl" && extension != ".hlsli")
+			{
+				continue;
+			}
+
+			std::ifstream file(it->path(), std::ios::binary);
+			if (!file.is_open())
+			{
+				all_read = false;
+				continue;
+			}
+			std::ostringstream content;
+			content << file.rdbuf();
+			AddFile(std::filesystem::relative(it->path(), root, error).generic_string(), content.str());
+		}
+		return all_read && !error;
+	}
+
+	std::vector<std::string> ShaderDependencyGraph::GetFiles(const std::string& extension /*= ""*/) const
+	{
+		std::vector<std::string> files;
+		for (const auto& [path, node] : m_files)
+		{
+			if (extension.empty() || HasExtension(path, extension))
+			{
+				files.push_back(path);
+			}
+		}
+		return files;
+	}
+
+	std::vector<std::string> ShaderDependencyGraph::GetDirectIncludes(const std::string& path) const
+	{
+		std::vector<std::string> includes;
+		auto it = m_files.find(path);
+		if (it == m_files.end())
+		{
+			return includes;
+		}
+		for (const std::string& raw_include : it->second.raw_includes)
+		{
+			std::string resolved = ResolveInclude(path, raw_include);
+			if (!resolved.empty() && std::find(includes.begin(), includes.end(), resolved) == includes.end())
+			{
+				includes.push_back(std::move(resolved));
+			}
+		}
+		return includes;
+	}
+
+	std::vector<std::string> ShaderDependencyGraph::GetTransitiveIncludes(const std::string& path) const
+	{
+		std::set<std::string> visited;
+		std::vector<std::string> pending = GetDirectIncludes(path);
+		while (!pending.empty())
+		{
+			std::string current = std::move(pending.back());
+			pending.pop_back();
+			if (current == path || !visited.insert(current).second)
+			{
+				continue;
+			}
+			for (std::string& include : GetDirectIncludes(current))
+			{
+				pending.push_back(std::move(include));
+			}
+		}
+		return std::vector<std::string>(visited.begin(), visited.end());
+	}
+
+	std::vector<std::string> ShaderDependencyGraph::GetDependents(const std::string& path) const
+	{
+		// 反向边只在这里用到，现建即可：文件数在百量级
+		std::map<std::string, std::vector<std::string>> includers;
+		for (const auto& [file, node] : m_files)
+		{
+			for (const std::string& include : GetDirectIncludes(file))
+			{
+				includers[include].push_back(file);
+			}
+		}
+
+		std::set<std::string> visited;
+		std::vector<std::string> pending = { path };
+		while (!pending.empty())
+		{
+			const std::string current = std::move(pending.back());
+			pending.pop_back();
+			auto it = includers.find(current);
+			if (it == includers.end())
+			{
+				continue;
+			}
+			for (const std::string& includer : it->second)
+			{
+				if (includer != path && visited.insert(includer).second)
+				{
+					pending.push_back(includer);
+				}
+			}
+		}
+		return std::vector<std::string>(visited.begin(), visited.end());
+	}
+
+	std::vector<std::pair<std::string, std::string>> ShaderDependencyGraph::GetMissingIncludes() const
+	{
+		std::vector<std::pair<std::string, std::string>> missing;
+		for (const auto& [path, node] : m_files)
+		{
+			for (const std::string& raw_include : node.raw_includes)
+			{
+				if (ResolveInclude(path, raw_include).empty())
+				{
+					missing.emplace_back(path, raw_include);
+				}
+			}
+		}
+		return missing;
+	}
+
+	ULongLong ShaderDependencyGraph::ComputeInputHash(const std::string& path, ULongLong seed) const
+	{
+		auto it = m_files.find(path);
+		if (it == m_files.end())
+		{
+			return 0;
+		}
+
+		// 路径参与哈希：include 改指向另一个内容相同的文件也算输入变化
+		auto hash_file = [this](const std::string& file, ULongLong hash)
+		{
+			hash = HashConverter::BytesHash64(file.data(), file.size(), hash);
+			const ULongLong content_hash = m_files.at(file).content_hash;
+			return HashConverter::BytesHash64(&content_hash, sizeof(content_hash), hash);
+		};
+
+		ULongLong hash = hash_file(path, seed);
+		for (const std::string& include : GetTransitiveIncludes(path))
+		{
+			hash = hash_file(include, hash);
+		}
+		// 找不到的 include 也要参与：文件补上之后结果改变
+		for (const std::string& raw_include : it->second.raw_includes)
+		{
+			if (ResolveInclude(path, raw_include).empty())
+			{
+				hash = HashConverter::BytesHash64(raw_include.data(), raw_include.size(), hash);
+			}
+		}
+		return hash;
+	}
+
+	std::string ShaderDependencyGraph::NormalizePath(const std::string& path)
+	{
+		std::string normalized = path;
+		std::replace(normalized.begin(), normalized.end(), '\\', '/');
+
+		// 折叠 "./" 与 "dir/../"，保持相对路径
+		std::vector<std::string> parts;
+		std::size_t begin = 0;
+		while (begin <= normalized.size())
+		{
+			const std::size_t slash = normalized.find('/', begin);
+			const std::string part = normalized.substr(begin, slash == std::string::npos ? std::string::npos : slash - begin);
+			if (part == "..")
+			{
+				if (!parts.empty() && parts.back() != "..")
+				{
+					parts.pop_back();
+				}
+				else
+				{
+					parts.push_back(part);
+				}
+			}
+			else if (!part.empty() && part != ".")
+			{
+				parts.push_back(part);
+			}
+			if (slash == std::string::npos)
+			{
+				break;
+			}
+			begin = slash + 1;
+		}
+
+		std::string result;
+		for (const std::string& part : parts)
+		{
+			if (!result.empty())
+			{
+				result += '/';
+			}
+			result += part;
+		}
+		return result;
+	}
+
+	std::vector<std::string> ShaderDependencyGraph::ParseIncludes(const std::string& content)
+	{
+		std::vector<std::string> includes;
+		Bool in_block_comment = false;
+		Bool at_line_start = true;
+		const std::size_t size = content.size();
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			const char ch = content[i];
+			if (in_block_comment)
+			{
+				if (ch == '*' && i + 1 < size && content[i + 1] == '/')
+				{
+					in_block_comment = false;
+					++i;
+				}
+				continue;
+			}
+			if (ch == '\n')
+			{
+				at_line_start = true;
+				continue;
+			}
+			if (ch == ' ' || ch == '\t' || ch == '\r')
+			{
+				continue;
+			}
+			if (ch == '/' && i + 1 < size && content[i + 1] == '/')
+			{
+				i = content.find('\n', i);
+				if (i == std::string::npos)
+				{
+					break;
+				}
+				at_line_start = true;
+				continue;
+			}
+			if (ch == '/' && i + 1 < size && content[i + 1] == '*')
+			{
+				in_block_comment = true;
+				++i;
+				continue;
+			}
+
+			const Bool directive = at_line_start && ch == '#';
+			at_line_start = false;
+			if (!directive)
+			{
+				continue;
+			}
+
+			// '#' 与 "include" 之间允许空白
+			std::size_t cursor = i + 1;
+			while (cursor < size && (content[cursor] == ' ' || content[cursor] == '\t'))
+			{
+				++cursor;
+			}
+			if (content.compare(cursor, 7, "include") != 0)
+			{
+				continue;
+			}
+			cursor += 7;
+			while (cursor < size && (content[cursor] == ' ' || content[cursor] == '\t'))
+			{
+				++cursor;
+			}
+			if (cursor >= size || (content[cursor] != '"' && content[cursor] != '<'))
+			{
+				continue;
+			}
+			const char terminator = content[cursor] == '"' ? '"' : '>';
+			const std::size_t close = content.find_first_of(std::string(1, terminator) + "\n", cursor + 1);
+			if (close != std::string::npos && content[close] == terminator && close > cursor + 1)
+			{
+				includes.push_back(content.substr(cursor + 1, close - cursor - 1));
+				i = close;
+			}
+			else
+			{
+				i = cursor;
+			}
+		}
+		return includes;
+	}
+
+	std::string ShaderDependencyGraph::ResolveInclude(const std::string& includer, const std::string& raw_include) const
+	{
+		const std::string from_root = NormalizePath(raw_include);
+		if (m_files.find(from_root) != m_files.end())
+		{
+			return from_root;
+		}
+		const std::string from_includer = NormalizePath(GetDirectory(includer) + raw_include);
+		if (m_files.find(from_includer) != m_files.end())
+		{
+			return from_includer;
+		}
+		return std::string();
+	}
+
+	std::string MakeShaderDefinesString(std::vector<std::pair<std::string, std::string>> defines)
+	{
+		std::sort(defines.begin(), defines.end());
+		std::string result;
+		for (const auto& [name, value] : defines)
+		{
+			if (!result.empty())
+			{
+				result += ';';
+			}
+			result += name;
+			result += '=';
+			result += value;
+		}
+		return result;
+	}
+
+	ULongLong ComputeShaderVariantSeed(const std::string& compiler_identity, const std::string& target, const std::string& entry_point, const std::string& defines)
+	{
+		const std::string parameters = compiler_identity + "\n" + target + "\n" + entry_point + "\n" + defines;
+		return HashConverter::BytesHash64(parameters.data(), parameters.size());
+	}
+
+	Bool ShaderBuildManifest::Load(const std::string& file_path)
+	{
+		Clear();
+
+		std::ifstream file(file_path);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		std::string line;
+		if (!std::getline(file, line))
+		{
+			return false;
+		}
+		if (!line.empty() && line.back() == '\r')
+		{
+			line.pop_back();
+		}
+		const std::vector<std::string> header = SplitTabs(line);
+		if (header.size() != 3 || header[0] != kManifestHeader || header[1] != std::to_string(FILE_VERSION))
+		{
+			return false;
+		}
+		m_compiler_identity = header[2];
+
+		while (std::getline(file, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+			{
+				line.pop_back();
+			}
+			if (line.empty())
+			{
+				continue;
+			}
+			const std::vector<std::string> fields = SplitTabs(line);
+			if (fields.size() != 8)
+			{
+				Clear();
+				return false;
+			}
+
+			ShaderBuildManifestEntry entry;
+			entry.source = fields[0];
+			entry.entry_point = fields[1];
+			entry.target = fields[2];
+			entry.defines = fields[3];
+			entry.output = fields[4];
+			try
+			{
+				entry.input_hash = std::stoull(fields[5], nullptr, 16);
+				entry.bytecode_size = std::stoull(fields[6]);
+				entry.compile_milliseconds = std::stod(fields[7]);
+			}
+			catch (const std::exception&)
+			{
+				Clear();
+				return false;
+			}
+			m_entries[entry.output] = std::move(entry);
+		}
+		return true;
+	}
+
+	Bool ShaderBuildManifest::Save(const std::string& file_path) const
+	{
+		std::ofstream file(file_path, std::ios::trunc);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		file << kManifestHeader << '\t' << FILE_VERSION << '\t' << m_compiler_identity << '\n';
+		for (const auto& [output, entry] : m_entries)
+		{
+			char hash_text[17] = {};
+			std::snprintf(hash_text, sizeof(hash_text), "%016llx", entry.input_hash);
+			char time_text[32] = {};
+			std::snprintf(time_text, sizeof(time_text), "%.3f", entry.compile_milliseconds);
+			file << entry.source << '\t' << entry.entry_point << '\t' << entry.target << '\t' << entry.defines << '\t' << entry.output << '\t'
+				<< hash_text << '\t' << entry.bytecode_size << '\t' << time_text << '\n';
+		}
+		return file.good();
+	}
+
+	void ShaderBuildManifest::SetEntry(const ShaderBuildManifestEntry& entry)
+	{
+		m_entries[entry.output] = entry;
+	}
+
+	const ShaderBuildManifestEntry* ShaderBuildManifest::FindEntry(const std::string& output) const
+	{
+		auto it = m_entries.find(output);
+		return it == m_entries.end() ? nullptr : &it->second;
+	}
+
+	const ShaderBuildManifestEntry* ShaderBuildManifest::FindVariant(const std::string& source, const std::string& entry_point, const std::string& target, const std::string& defines) const
+	{
+		for (const auto& [output, entry] : m_entries)
+		{
+			if (entry.source == source && entry.entry_point == entry_point && entry.target == target && entry.defines == defines)
+			{
+				return &entry;
+			}
+		}
+		return nullptr;
+	}
+
+	Bool ShaderBuildManifest::IsStale(const std::string& output, ULongLong input_hash) const
+	{
+		const ShaderBuildManifestEntry* entry = FindEntry(output);
+		return !entry || entry->input_hash != input_hash;
+	}
+}
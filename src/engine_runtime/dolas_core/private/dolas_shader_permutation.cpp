@@ -0,0 +1,148 @@
+#include "dolas_shader_permutation.h"
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include "dolas_hash.h"
+
+namespace Dolas
+{
+	namespace
+	{
+		const char* const kKeywordDirective = "#pragma dolas_keywords";
+		const char* const kNoKeyword = "_";
+
+		Bool IsKeywordName(const std::string& token)
+		{
+			if (token.empty() || !(std::isalpha(static_cast<unsigned char>(token[0])) || token[0] == '_'))
+			{
+				return false;
+			}
+			return std::all_of(token.begin(), token.end(), [](char ch) { return std::isalnum(static_cast<unsigned char>(ch)) || ch == '_'; });
+		}
+	}
+
+	ShaderKeywordDeclaration ShaderKeywordDeclaration::Parse(const std::string& content)
+	{
+		ShaderKeywordDeclaration declaration;
+		std::istringstream stream(content);
+		std::string line;
+		while (std::getline(stream, line))
+		{
+			// 只认行首的 "//"，避免把字符串或代码后面的注释当作声明
+			const std::size_t begin = line.find_first_not_of(" \t");
+			if (begin == std::string::npos || line.compare(begin, 2, "//") != 0)
+			{
+				continue;
+			}
+			const std::size_t directive = line.find_first_not_of(" \t", begin + 2);
+			if (directive == std::string::npos || line.compare(directive, std::char_traits<char>::length(kKeywordDirective), kKeywordDirective) != 0)
+			{
+				continue;
+			}
+
+			std::istringstream tokens(line.substr(directive + std::char_traits<char>::length(kKeywordDirective)));
+			std::vector<std::string> keyword_set;
+			std::string token;
+			while (tokens >> token)
+			{
+				if (token != kNoKeyword && IsKeywordName(token) && !declaration.IsDeclared(token) &&
+					std::find(keyword_set.begin(), keyword_set.end(), token) == keyword_set.end())
+				{
+					keyword_set.push_back(token);
+				}
+			}
+			if (!keyword_set.empty())
+			{
+				declaration.m_keyword_sets.push_back(std::move(keyword_set));
+			}
+		}
+		return declaration;
+	}
+
+	Bool ShaderKeywordDeclaration::IsDeclared(const std::string& keyword) const
+	{
+		for (const std::vector<std::string>& keyword_set : m_keyword_sets)
+		{
+			if (std::find(keyword_set.begin(), keyword_set.end(), keyword) != keyword_set.end())
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	ULongLong ShaderKeywordDeclaration::GetPermutationCount() const
+	{
+		ULongLong count = 1;
+		for (const std::vector<std::string>& keyword_set : m_keyword_sets)
+		{
+			count *= keyword_set.size() + 1;
+		}
+		return count;
+	}
+
+	Bool ShaderKeywordDeclaration::Resolve(const std::vector<std::string>& requested, std::vector<std::string>& out_keywords, std::string* out_error /*= nullptr*/) const
+	{
+		out_keywords.clear();
+		Bool success = true;
+		for (const std::vector<std::string>& keyword_set : m_keyword_sets)
+		{
+			const std::string* selected = nullptr;
+			for (const std::string& keyword : keyword_set)
+			{
+				if (std::find(requested.begin(), requested.end(), keyword) == requested.end())
+				{
+					continue;
+				}
+				if (selected)
+				{
+					if (out_error)
+					{
+						*out_error = "keywords " + *selected + " and " + keyword + " are mutually exclusive";
+					}
+					success = false;
+					continue;
+				}
+				selected = &keyword;
+			}
+			if (selected)
+			{
+				out_keywords.push_back(*selected);
+			}
+		}
+		std::sort(out_keywords.begin(), out_keywords.end());
+		return success;
+	}
+
+	ShaderPermutationKey ComputeShaderPermutationKey(std::vector<std::string> keywords)
+	{
+		if (keywords.empty())
+		{
+			return 0;
+		}
+		std::sort(keywords.begin(), keywords.end());
+		keywords.erase(std::unique(keywords.begin(), keywords.end()), keywords.end());
+
+		ULongLong key = HashConverter::BytesHash64(nullptr, 0);
+		for (const std::string& keyword : keywords)
+		{
+			// 以 '\0' 分隔，{"AB"} 与 {"A", "B"} 不会得到相同的结果
+			key = HashConverter::BytesHash64(keyword.data(), keyword.size(), key);
+			key = HashConverter::BytesHash64("", 1, key);
+		}
+		// 0 留给默认变体
+		return key == 0 ? 1 : key;
+	}
+
+	std::vector<std::pair<std::string, std::string>> MakeShaderKeywordDefines(const std::vector<std::string>& keywords)
+	{
+		std::vector<std::pair<std::string, std::string>> defines;
+		for (const std::string& keyword : keywords)
+		{
+			defines.emplace_back(keyword, "1");
+		}
+		std::sort(defines.begin(), defines.end());
+		defines.erase(std::unique(defines.begin(), defines.end()), defines.end());
+		return defines;
+	}
+}
@@ -0,0 +1,244 @@
+#include "dolas_shader_reflection.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "dolas_hash.h"
+
+namespace Dolas
+{
+	namespace
+	{
+		struct ShaderReflectionFileHeader
+		{
+			UInt magic = 0;
+			UInt version = 0;
+			ULongLong bytecode_hash = 0;
+			ULongLong payload_size = 0;
+			ULongLong payload_hash = 0;
+		};
+
+		class ByteWriter
+		{
+		public:
+			explicit ByteWriter(std::vector<UByte>& bytes) : m_bytes(bytes) {}
+
+			void WriteRaw(const void* data, std::size_t size)
+			{
+				const UByte* begin = static_cast<const UByte*>(data);
+				m_bytes.insert(m_bytes.end(), begin, begin + size);
+			}
+
+			void WriteUInt(UInt value) { WriteRaw(&value, sizeof(value)); }
+
+			void WriteString(const std::string& value)
+			{
+				WriteUInt(static_cast<UInt>(value.size()));
+				WriteRaw(value.data(), value.size());
+			}
+
+		private:
+			std::vector<UByte>& m_bytes;
+		};
+
+		class ByteReader
+		{
+		public:
+			ByteReader(const UByte* data, std::size_t size) : m_data(data), m_size(size) {}
+
+			Bool ReadRaw(void* out, std::size_t size)
+			{
+				if (m_offset + size > m_size)
+				{
+					return false;
+				}
+				std::memcpy(out, m_data + m_offset, size);
+				m_offset += size;
+				return true;
+			}
+
+			Bool ReadUInt(UInt& value) { return ReadRaw(&value, sizeof(value)); }
+
+			Bool ReadString(std::string& value)
+			{
+				UInt length = 0;
+				if (!ReadUInt(length) || m_offset + length > m_size)
+				{
+					return false;
+				}
+				value.assign(reinterpret_cast<const char*>(m_data + m_offset), length);
+				m_offset += length;
+				return true;
+			}
+
+			// 元素数量来自文件，先用剩余字节数粗略校验，避免损坏的数据触发巨大的 reserve
+			Bool ReadCount(UInt& count, std::size_t min_element_size)
+			{
+				return ReadUInt(count) && static_cast<std::size_t>(count) * min_element_size <= m_size - m_offset;
+			}
+
+			std::size_t GetRemaining() const { return m_size - m_offset; }
+
+		private:
+			const UByte* m_data = nullptr;
+			std::size_t m_size = 0;
+			std::size_t m_offset = 0;
+		};
+	}
+
+	void ShaderReflectionFile::Serialize(const ShaderReflectionInfo& info, ULongLong bytecode_hash, std::vector<UByte>& out_bytes)
+	{
+		std::vector<UByte> payload;
+		ByteWriter writer(payload);
+		writer.WriteUInt(info.constant_buffer_count);
+		writer.WriteUInt(info.bound_resource_count);
+		writer.WriteUInt(info.instruction_count);
+
+		writer.WriteUInt(static_cast<UInt>(info.constant_buffer_descs.size()));
+		for (const ConstantBufferInfo& constant_buffer : info.constant_buffer_descs)
+		{
+			writer.WriteString(constant_buffer.name);
+			writer.WriteUInt(constant_buffer.size);
+			writer.WriteUInt(constant_buffer.variable_count);
+			writer.WriteUInt(static_cast<UInt>(constant_buffer.variable_descs.size()));
+			for (const ConstantBufferVariableInfo& variable : constant_buffer.variable_descs)
+			{
+				writer.WriteString(variable.name);
+				writer.WriteUInt(variable.start_offset);
+				writer.WriteUInt(variable.size);
+				writer.WriteUInt(variable.flags);
+			}
+		}
+
+		writer.WriteUInt(static_cast<UInt>(info.bound_resource_descs.size()));
+		for (const ShaderBoundResourceInfo& resource : info.bound_resource_descs)
+		{
+			writer.WriteString(resource.name);
+			writer.WriteUInt(resource.type);
+			writer.WriteUInt(resource.dimension);
+			writer.WriteUInt(resource.bind_point);
+			writer.WriteUInt(resource.bind_count);
+		}
+
+		ShaderReflectionFileHeader header;
+		header.magic = FILE_MAGIC;
+		header.version = FILE_VERSION;
+		header.bytecode_hash = bytecode_hash;
+		header.payload_size = payload.size();
+		header.payload_hash = HashConverter::BytesHash64(payload.data(), payload.size());
+
+		out_bytes.resize(sizeof(header));
+		std::memcpy(out_bytes.data(), &header, sizeof(header));
+		out_bytes.insert(out_bytes.end(), payload.begin(), payload.end());
+	}
+
+	Bool ShaderReflectionFile::Deserialize(const UByte* data, std::size_t size, ShaderReflectionInfo& out_info, ULongLong& out_bytecode_hash)
+	{
+		ShaderReflectionFileHeader header;
+		if (data == nullptr || size < sizeof(header))
+		{
+			return false;
+		}
+		std::memcpy(&header, data, sizeof(header));
+		if (header.magic != FILE_MAGIC ||
+			header.version != FILE_VERSION ||
+			header.payload_size != size - sizeof(header))
+		{
+			return false;
+		}
+
+		const UByte* payload = data + sizeof(header);
+		const std::size_t payload_size = static_cast<std::size_t>(header.payload_size);
+		if (HashConverter::BytesHash64(payload, payload_size) != header.payload_hash)
+		{
+			return false;
+		}
+
+		ByteReader reader(payload, payload_size);
+		ShaderReflectionInfo info;
+		UInt constant_buffer_count = 0;
+		if (!reader.ReadUInt(info.constant_buffer_count) ||
+			!reader.ReadUInt(info.bound_resource_count) ||
+			!reader.ReadUInt(info.instruction_count) ||
+			!reader.ReadCount(constant_buffer_count, sizeof(UInt) * 4))
+		{
+			return false;
+		}
+
+		info.constant_buffer_descs.resize(constant_buffer_count);
+		for (ConstantBufferInfo& constant_buffer : info.constant_buffer_descs)
+		{
+			UInt variable_count = 0;
+			if (!reader.ReadString(constant_buffer.name) ||
+				!reader.ReadUInt(constant_buffer.size) ||
+				!reader.ReadUInt(constant_buffer.variable_count) ||
+				!reader.ReadCount(variable_count, sizeof(UInt) * 4))
+			{
+				return false;
+			}
+			constant_buffer.variable_descs.resize(variable_count);
+			for (ConstantBufferVariableInfo& variable : constant_buffer.variable_descs)
+			{
+				if (!reader.ReadString(variable.name) ||
+					!reader.ReadUInt(variable.start_offset) ||
+					!reader.ReadUInt(variable.size) ||
+					!reader.ReadUInt(variable.flags))
+				{
+					return false;
+				}
+			}
+		}
+
+		UInt resource_count = 0;
+		if (!reader.ReadCount(resource_count, sizeof(UInt) * 5))
+		{
+			return false;
+		}
+		info.bound_resource_descs.resize(resource_count);
+		for (ShaderBoundResourceInfo& resource : info.bound_resource_descs)
+		{
+			if (!reader.ReadString(resource.name) ||
+				!reader.ReadUInt(resource.type) ||
+				!reader.ReadUInt(resource.dimension) ||
+				!reader.ReadUInt(resource.bind_point) ||
+				!reader.ReadUInt(resource.bind_count))
+			{
+				return false;
+			}
+		}
+
+		// 多余的尾部数据说明写入端与读取端格式不一致
+		if (reader.GetRemaining() != 0)
+		{
+			return false;
+		}
+
+		out_info = std::move(info);
+		out_bytecode_hash = header.bytecode_hash;
+		return true;
+	}
+
+	Bool ShaderReflectionFile::Save(const std::string& file_path, const ShaderReflectionInfo& info, ULongLong bytecode_hash)
+	{
+		std::vector<UByte> bytes;
+		Serialize(info, bytecode_hash, bytes);
+
+		std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		return file.good();
+	}
+
+	Bool ShaderReflectionFile::Load(const std::string& file_path, ShaderReflectionInfo& out_info, ULongLong& out_bytecode_hash)
+	{
+		std::ifstream file(file_path, std::ios::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+		std::vector<UByte> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		return Deserialize(bytes.data(), bytes.size(), out_info, out_bytecode_hash);
+	}
+}
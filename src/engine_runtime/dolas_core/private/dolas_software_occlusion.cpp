@@ -0,0 +1,464 @@
+#include "dolas_software_occlusion.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DOLAS_SOFTWARE_OCCLUSION_SSE 1
+#endif
+
+namespace Dolas
+{
+	namespace
+	{
+		constexpr Float kMinClipW = 1.0e-5f;
+		constexpr UInt kMaxClippedVertexCount = 4;
+
+		inline Vector4 TransformPoint(const Matrix4x4& matrix, Float x, Float y, Float z)
+		{
+			return Vector4(
+				matrix.data[0][0] * x + matrix.data[0][1] * y + matrix.data[0][2] * z + matrix.data[0][3],
+				matrix.data[1][0] * x + matrix.data[1][1] * y + matrix.data[1][2] * z + matrix.data[1][3],
+				matrix.data[2][0] * x + matrix.data[2][1] * y + matrix.data[2][2] * z + matrix.data[2][3],
+				matrix.data[3][0] * x + matrix.data[3][1] * y + matrix.data[3][2] * z + matrix.data[3][3]);
+		}
+
+		inline Vector4 LerpClip(const Vector4& a, const Vector4& b, Float t)
+		{
+			return Vector4(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t);
+		}
+
+		// Sutherland-Hodgman：用近平面 z >= 0 裁剪三角形，最多得到 4 个顶点
+		UInt ClipTriangleAgainstNearPlane(const Vector4 (&input)[3], Vector4 (&output)[kMaxClippedVertexCount])
+		{
+			UInt output_count = 0;
+			for (UInt i = 0; i < 3; ++i)
+			{
+				const Vector4& current = input[i];
+				const Vector4& next = input[(i + 1) % 3];
+				const Bool current_inside = current.z >= 0.0f;
+				const Bool next_inside = next.z >= 0.0f;
+				if (current_inside)
+				{
+					output[output_count++] = current;
+				}
+				if (current_inside != next_inside)
+				{
+					const Float t = current.z / (current.z - next.z);
+					output[output_count++] = LerpClip(current, next, t);
+				}
+			}
+			return output_count;
+		}
+	}
+
+	void SoftwareOcclusionBuffer::Initialize(UInt width, UInt height, UInt band_height /*= 16*/)
+	{
+		m_width = std::max<UInt>(4, (width + 3) & ~3u);
+		m_height = std::max<UInt>(1, height);
+		m_band_height = std::max<UInt>(1, band_height);
+		m_band_triangles.assign((m_height + m_band_height - 1) / m_band_height, std::vector<UInt>());
+		m_triangles.clear();
+
+		m_levels.clear();
+		UInt level_width = m_width;
+		UInt level_height = m_height;
+		while (true)
+		{
+			DepthLevel level;
+			level.width = level_width;
+			level.height = level_height;
+			level.depth.assign(static_cast<std::size_t>(level_width) * level_height, 1.0f);
+			m_levels.push_back(std::move(level));
+			if (level_width == 1 && level_height == 1)
+			{
+				break;
+			}
+			level_width = (level_width + 1) / 2;
+			level_height = (level_height + 1) / 2;
+		}
+	}
+
+	void SoftwareOcclusionBuffer::BeginFrame(const Matrix4x4& view_projection)
+	{
+		m_view_projection = view_projection;
+		m_triangles.clear();
+		for (std::vector<UInt>& band : m_band_triangles)
+		{
+			band.clear();
+		}
+		for (DepthLevel& level : m_levels)
+		{
+			std::fill(level.depth.begin(), level.depth.end(), 1.0f);
+		}
+	}
+
+	UInt SoftwareOcclusionBuffer::AddOccluder(const Matrix4x4& world, const Float* positions, UInt vertex_count, UInt stride, const UInt* indices, UInt index_count)
+	{
+		if (!positions || !indices || stride < 3 || m_levels.empty())
+		{
+			return 0;
+		}
+
+		const Matrix4x4 world_view_projection = m_view_projection * world;
+		const UInt first_triangle = GetTriangleCount();
+		for (UInt index = 0; index + 2 < index_count; index += 3)
+		{
+			Vector4 clip[3];
+			Bool valid = true;
+			for (UInt corner = 0; corner < 3; ++corner)
+			{
+				const UInt vertex_index = indices[index + corner];
+				if (vertex_index >= vertex_count)
+				{
+					valid = false;
+					break;
+				}
+				const Float* position = positions + static_cast<std::size_t>(vertex_index) * stride;
+				clip[corner] = TransformPoint(world_view_projection, position[0], position[1], position[2]);
+			}
+			if (!valid)
+			{
+				continue;
+			}
+
+			if (clip[0].z >= 0.0f && clip[1].z >= 0.0f && clip[2].z >= 0.0f)
+			{
+				SetupTriangle(clip[0], clip[1], clip[2]);
+				continue;
+			}
+
+			Vector4 clipped[kMaxClippedVertexCount];
+			const UInt clipped_count = ClipTriangleAgainstNearPlane(clip, clipped);
+			for (UInt fan = 1; fan + 1 < clipped_count; ++fan)
+			{
+				SetupTriangle(clipped[0], clipped[fan], clipped[fan + 1]);
+			}
+		}
+		return GetTriangleCount() - first_triangle;
+	}
+
+	void SoftwareOcclusionBuffer::SetupTriangle(const Vector4& clip0, const Vector4& clip1, const Vector4& clip2)
+	{
+		const Vector4* clips[3] = { &clip0, &clip1, &clip2 };
+		Float screen_x[3];
+		Float screen_y[3];
+		Float depth[3];
+		for (UInt corner = 0; corner < 3; ++corner)
+		{
+			const Vector4& clip = *clips[corner];
+			if (clip.w < kMinClipW)
+			{
+				return;
+			}
+			const Float inverse_w = 1.0f / clip.w;
+			screen_x[corner] = (clip.x * inverse_w * 0.5f + 0.5f) * static_cast<Float>(m_width);
+			screen_y[corner] = (0.5f - clip.y * inverse_w * 0.5f) * static_cast<Float>(m_height);
+			depth[corner] = clip.z * inverse_w;
+		}
+
+		// 整个三角形在远平面之后，不可能遮挡任何东西
+		if (depth[0] > 1.0f && depth[1] > 1.0f && depth[2] > 1.0f)
+		{
+			return;
+		}
+
+		const Float determinant = (screen_x[1] - screen_x[0]) * (screen_y[2] - screen_y[0]) - (screen_x[2] - screen_x[0]) * (screen_y[1] - screen_y[0]);
+		if (std::fabs(determinant) < 1.0e-8f)
+		{
+			return;
+		}
+
+		ScreenTriangle triangle;
+		// 像素中心 (x + 0.5, y + 0.5) 落在 [min, max] 内的像素范围
+		const Float min_screen_x = std::min({ screen_x[0], screen_x[1], screen_x[2] });
+		const Float max_screen_x = std::max({ screen_x[0], screen_x[1], screen_x[2] });
+		const Float min_screen_y = std::min({ screen_y[0], screen_y[1], screen_y[2] });
+		const Float max_screen_y = std::max({ screen_y[0], screen_y[1], screen_y[2] });
+		triangle.min_x = std::max(0, static_cast<Int>(std::ceil(min_screen_x - 0.5f)));
+		triangle.max_x = std::min(static_cast<Int>(m_width) - 1, static_cast<Int>(std::floor(max_screen_x - 0.5f)));
+		triangle.min_y = std::max(0, static_cast<Int>(std::ceil(min_screen_y - 0.5f)));
+		triangle.max_y = std::min(static_cast<Int>(m_height) - 1, static_cast<Int>(std::floor(max_screen_y - 0.5f)));
+		if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y)
+		{
+			return;
+		}
+
+		// 边 i 从顶点 i 指向顶点 i + 1；逆时针（屏幕空间）时统一取反，使内部总是非负
+		const Float orientation = determinant > 0.0f ? 1.0f : -1.0f;
+		for (UInt edge = 0; edge < 3; ++edge)
+		{
+			const UInt next = (edge + 1) % 3;
+			triangle.edge_a[edge] = (screen_y[edge] - screen_y[next]) * orientation;
+			triangle.edge_b[edge] = (screen_x[next] - screen_x[edge]) * orientation;
+			triangle.edge_c[edge] = (screen_x[edge] * screen_y[next] - screen_y[edge] * screen_x[next]) * orientation;
+		}
+
+		// z / w 在屏幕空间线性，解出深度平面
+		const Float inverse_determinant = 1.0f / determinant;
+		const Float delta_depth1 = depth[1] - depth[0];
+		const Float delta_depth2 = depth[2] - depth[0];
+		triangle.depth_a = (delta_depth1 * (screen_y[2] - screen_y[0]) - delta_depth2 * (screen_y[1] - screen_y[0])) * inverse_determinant;
+		triangle.depth_b = (delta_depth2 * (screen_x[1] - screen_x[0]) - delta_depth1 * (screen_x[2] - screen_x[0])) * inverse_determinant;
+		triangle.depth_c = depth[0] - triangle.depth_a * screen_x[0] - triangle.depth_b * screen_y[0];
+
+		const UInt triangle_index = GetTriangleCount();
+		m_triangles.push_back(triangle);
+		const UInt first_band = static_cast<UInt>(triangle.min_y) / m_band_height;
+		const UInt last_band = static_cast<UInt>(triangle.max_y) / m_band_height;
+		for (UInt band = first_band; band <= last_band; ++band)
+		{
+			m_band_triangles[band].push_back(triangle_index);
+		}
+	}
+
+	void SoftwareOcclusionBuffer::GetBandRows(UInt band_index, Int& out_begin_row, Int& out_end_row) const
+	{
+		out_begin_row = static_cast<Int>(band_index * m_band_height);
+		out_end_row = std::min(static_cast<Int>(m_height), out_begin_row + static_cast<Int>(m_band_height));
+	}
+
+	void SoftwareOcclusionBuffer::RasterizeBand(UInt band_index)
+	{
+#if defined(DOLAS_SOFTWARE_OCCLUSION_SSE)
+		if (band_index >= GetBandCount())
+		{
+			return;
+		}
+
+		Int begin_row = 0;
+		Int end_row = 0;
+		GetBandRows(band_index, begin_row, end_row);
+		Float* depth_buffer = m_levels[0].depth.data();
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128i lane_offsets = _mm_set_epi32(3, 2, 1, 0);
+
+		for (UInt triangle_index : m_band_triangles[band_index])
+		{
+			const ScreenTriangle& triangle = m_triangles[triangle_index];
+			const Int first_row = std::max(triangle.min_y, begin_row);
+			const Int last_row = std::min(triangle.max_y, end_row - 1);
+			// 从 4 对齐的列开始，超出 [min_x, max_x] 的通道用列掩码排除，保证与标量路径一致
+			const Int first_column = triangle.min_x & ~3;
+			const __m128i min_column = _mm_set1_epi32(triangle.min_x - 1);
+			const __m128i max_column = _mm_set1_epi32(triangle.max_x + 1);
+
+			const __m128 edge_a0 = _mm_set1_ps(triangle.edge_a[0]);
+			const __m128 edge_a1 = _mm_set1_ps(triangle.edge_a[1]);
+			const __m128 edge_a2 = _mm_set1_ps(triangle.edge_a[2]);
+			const __m128 depth_a = _mm_set1_ps(triangle.depth_a);
+
+			for (Int row = first_row; row <= last_row; ++row)
+			{
+				const Float pixel_y = static_cast<Float>(row) + 0.5f;
+				const __m128 row_edge0 = _mm_set1_ps(triangle.edge_b[0] * pixel_y);
+				const __m128 row_edge1 = _mm_set1_ps(triangle.edge_b[1] * pixel_y);
+				const __m128 row_edge2 = _mm_set1_ps(triangle.edge_b[2] * pixel_y);
+				const __m128 row_depth = _mm_set1_ps(triangle.depth_b * pixel_y);
+				const __m128 edge_c0 = _mm_set1_ps(triangle.edge_c[0]);
+				const __m128 edge_c1 = _mm_set1_ps(triangle.edge_c[1]);
+				const __m128 edge_c2 = _mm_set1_ps(triangle.edge_c[2]);
+				const __m128 depth_c = _mm_set1_ps(triangle.depth_c);
+				Float* row_depth_buffer = depth_buffer + static_cast<std::size_t>(row) * m_width;
+
+				for (Int column = first_column; column <= triangle.max_x; column += 4)
+				{
+					const __m128i columns = _mm_add_epi32(_mm_set1_epi32(column), lane_offsets);
+					const __m128 pixel_x = _mm_add_ps(_mm_cvtepi32_ps(columns), half);
+
+					const __m128 edge0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(edge_a0, pixel_x), row_edge0), edge_c0);
+					const __m128 edge1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(edge_a1, pixel_x), row_edge1), edge_c1);
+					const __m128 edge2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(edge_a2, pixel_x), row_edge2), edge_c2);
+					__m128 mask = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge0, zero), _mm_cmpge_ps(edge1, zero)), _mm_cmpge_ps(edge2, zero));
+					const __m128i column_mask = _mm_and_si128(_mm_cmpgt_epi32(columns, min_column), _mm_cmplt_epi32(columns, max_column));
+					mask = _mm_and_ps(mask, _mm_castsi128_ps(column_mask));
+					if (_mm_movemask_ps(mask) == 0)
+					{
+						continue;
+					}
+
+					const __m128 depth = _mm_add_ps(_mm_add_ps(_mm_mul_ps(depth_a, pixel_x), row_depth), depth_c);
+					const __m128 old_depth = _mm_loadu_ps(row_depth_buffer + column);
+					mask = _mm_and_ps(mask, _mm_cmplt_ps(depth, old_depth));
+					_mm_storeu_ps(row_depth_buffer + column, _mm_or_ps(_mm_and_ps(mask, depth), _mm_andnot_ps(mask, old_depth)));
+				}
+			}
+		}
+#else
+		RasterizeBandScalar(band_index);
+#endif
+	}
+
+	void SoftwareOcclusionBuffer::RasterizeBandScalar(UInt band_index)
+	{
+		if (band_index >= GetBandCount())
+		{
+			return;
+		}
+
+		Int begin_row = 0;
+		Int end_row = 0;
+		GetBandRows(band_index, begin_row, end_row);
+		Float* depth_buffer = m_levels[0].depth.data();
+
+		for (UInt triangle_index : m_band_triangles[band_index])
+		{
+			const ScreenTriangle& triangle = m_triangles[triangle_index];
+			const Int first_row = std::max(triangle.min_y, begin_row);
+			const Int last_row = std::min(triangle.max_y, end_row - 1);
+			for (Int row = first_row; row <= last_row; ++row)
+			{
+				// 与 SIMD 路径相同的运算顺序：(a * x + b * y) + c，其中 b * y 按行预先计算
+				const Float pixel_y = static_cast<Float>(row) + 0.5f;
+				const Float row_edge[3] = { triangle.edge_b[0] * pixel_y, triangle.edge_b[1] * pixel_y, triangle.edge_b[2] * pixel_y };
+				const Float row_depth = triangle.depth_b * pixel_y;
+				Float* row_depth_buffer = depth_buffer + static_cast<std::size_t>(row) * m_width;
+
+				for (Int column = triangle.min_x; column <= triangle.max_x; ++column)
+				{
+					const Float pixel_x = static_cast<Float>(column) + 0.5f;
+					const Float edge0 = (triangle.edge_a[0] * pixel_x + row_edge[0]) + triangle.edge_c[0];
+					const Float edge1 = (triangle.edge_a[1] * pixel_x + row_edge[1]) + triangle.edge_c[1];
+					const Float edge2 = (triangle.edge_a[2] * pixel_x + row_edge[2]) + triangle.edge_c[2];
+					if (!(edge0 >= 0.0f && edge1 >= 0.0f && edge2 >= 0.0f))
+					{
+						continue;
+					}
+
+					const Float depth = (triangle.depth_a * pixel_x + row_depth) + triangle.depth_c;
+					if (depth < row_depth_buffer[column])
+					{
+						row_depth_buffer[column] = depth;
+					}
+				}
+			}
+		}
+	}
+
+	void SoftwareOcclusionBuffer::RasterizeAll()
+	{
+		for (UInt band_index = 0; band_index < GetBandCount(); ++band_index)
+		{
+			RasterizeBand(band_index);
+		}
+	}
+
+	void SoftwareOcclusionBuffer::BuildHierarchicalZ()
+	{
+		for (std::size_t level_index = 1; level_index < m_levels.size(); ++level_index)
+		{
+			const DepthLevel& source = m_levels[level_index - 1];
+			DepthLevel& target = m_levels[level_index];
+			for (UInt y = 0; y < target.height; ++y)
+			{
+				const UInt source_y0 = y * 2;
+				const UInt source_y1 = std::min(source_y0 + 1, source.height - 1);
+				for (UInt x = 0; x < target.width; ++x)
+				{
+					const UInt source_x0 = x * 2;
+					const UInt source_x1 = std::min(source_x0 + 1, source.width - 1);
+					const Float depth = std::max(
+						std::max(source.depth[source_y0 * source.width + source_x0], source.depth[source_y0 * source.width + source_x1]),
+						std::max(source.depth[source_y1 * source.width + source_x0], source.depth[source_y1 * source.width + source_x1]));
+					target.depth[y * target.width + x] = depth;
+				}
+			}
+		}
+	}
+
+	Bool SoftwareOcclusionBuffer::IsOccluded(const BoundingBox& world_box) const
+	{
+		if (m_levels.empty() || !world_box.IsValid())
+		{
+			return false;
+		}
+
+		Float min_screen_x = DOLAS_FLOAT_MAX;
+		Float max_screen_x = DOLAS_FLOAT_MIN;
+		Float min_screen_y = DOLAS_FLOAT_MAX;
+		Float max_screen_y = DOLAS_FLOAT_MIN;
+		Float min_depth = DOLAS_FLOAT_MAX;
+		for (UInt corner = 0; corner < 8; ++corner)
+		{
+			const Float x = (corner & 1) ? world_box.max_point.x : world_box.min_point.x;
+			const Float y = (corner & 2) ? world_box.max_point.y : world_box.min_point.y;
+			const Float z = (corner & 4) ? world_box.max_point.z : world_box.min_point.z;
+			const Vector4 clip = TransformPoint(m_view_projection, x, y, z);
+			// 跨越近平面时投影不可靠，保守地认为可见
+			if (clip.w < kMinClipW || clip.z < 0.0f)
+			{
+				return false;
+			}
+
+			const Float inverse_w = 1.0f / clip.w;
+			const Float screen_x = (clip.x * inverse_w * 0.5f + 0.5f) * static_cast<Float>(m_width);
+			const Float screen_y = (0.5f - clip.y * inverse_w * 0.5f) * static_cast<Float>(m_height);
+			min_screen_x = std::min(min_screen_x, screen_x);
+			max_screen_x = std::max(max_screen_x, screen_x);
+			min_screen_y = std::min(min_screen_y, screen_y);
+			max_screen_y = std::max(max_screen_y, screen_y);
+			min_depth = std::min(min_depth, clip.z * inverse_w);
+		}
+
+		if (min_depth > 1.0f)
+		{
+			return false;
+		}
+
+		// 包围盒屏幕矩形接触到的所有像素
+		const Int min_x = std::max(0, static_cast<Int>(std::floor(min_screen_x)));
+		const Int max_x = std::min(static_cast<Int>(m_width) - 1, static_cast<Int>(std::floor(max_screen_x)));
+		const Int min_y = std::max(0, static_cast<Int>(std::floor(min_screen_y)));
+		const Int max_y = std::min(static_cast<Int>(m_height) - 1, static_cast<Int>(std::floor(max_screen_y)));
+		if (min_x > max_x || min_y > max_y)
+		{
+			return false;
+		}
+
+		// 选择使矩形最多覆盖 2x2 个 texel 的层级
+		UInt level_index = 0;
+		while (level_index + 1 < m_levels.size() &&
+			(((max_x >> level_index) - (min_x >> level_index)) > 1 || ((max_y >> level_index) - (min_y >> level_index)) > 1))
+		{
+			++level_index;
+		}
+
+		const DepthLevel& level = m_levels[level_index];
+		Float max_occluder_depth = 0.0f;
+		for (Int y = min_y >> level_index; y <= (max_y >> level_index); ++y)
+		{
+			for (Int x = min_x >> level_index; x <= (max_x >> level_index); ++x)
+			{
+				max_occluder_depth = std::max(max_occluder_depth, level.depth[static_cast<std::size_t>(y) * level.width + x]);
+			}
+		}
+		return min_depth > max_occluder_depth;
+	}
+
+	UInt SoftwareOcclusionBuffer::CullOccludedBoxes(const CullingBoundsSoA& bounds, UInt begin, UInt end, UByte* in_out_visibility) const
+	{
+		if (!in_out_visibility || end > bounds.GetCount() || begin >= end)
+		{
+			return 0;
+		}
+
+		UInt occluded_count = 0;
+		for (UInt index = begin; index < end; ++index)
+		{
+			if (in_out_visibility[index] == 0)
+			{
+				continue;
+			}
+
+			const Vector3 center(bounds.GetCenterX()[index], bounds.GetCenterY()[index], bounds.GetCenterZ()[index]);
+			const Vector3 extents(bounds.GetExtentX()[index], bounds.GetExtentY()[index], bounds.GetExtentZ()[index]);
+			if (IsOccluded(BoundingBox(center - extents, center + extents)))
+			{
+				in_out_visibility[index] = 0;
+				++occluded_count;
+			}
+		}
+		return occluded_count;
+	}
+}
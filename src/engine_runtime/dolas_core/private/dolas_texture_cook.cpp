@@ -0,0 +1,610 @@
+#include "dolas_texture_cook.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace Dolas
+{
+	namespace
+	{
+		constexpr Float kPi = 3.14159265358979323846f;
+		constexpr UInt kLanczosLobes = 3;
+
+		// DXGI_FORMAT 的取值（core 不依赖 Windows 头文件）
+		UInt GetDXGIFormat(BlockFormat format)
+		{
+			switch (format)
+			{
+			case BlockFormat::BC1:  return 71;  // DXGI_FORMAT_BC1_UNORM
+			case BlockFormat::BC3:  return 77;  // DXGI_FORMAT_BC3_UNORM
+			case BlockFormat::BC4:  return 80;  // DXGI_FORMAT_BC4_UNORM
+			case BlockFormat::BC5:  return 83;  // DXGI_FORMAT_BC5_UNORM
+			case BlockFormat::BC6H: return 95;  // DXGI_FORMAT_BC6H_UF16
+			case BlockFormat::BC7:
+			default:                return 98;  // DXGI_FORMAT_BC7_UNORM
+			}
+		}
+
+		Float Sinc(Float x)
+		{
+			const Float angle = kPi * x;
+			return std::sin(angle) / angle;
+		}
+
+		Float Lanczos(Float x)
+		{
+			x = std::fabs(x);
+			if (x < 1.0e-6f)
+			{
+				return 1.0f;
+			}
+			return x < static_cast<Float>(kLanczosLobes) ? Sinc(x) * Sinc(x / kLanczosLobes) : 0.0f;
+		}
+
+		// 一个轴向上每个目标像素的滤波抽头（源下标已按 clamp 折叠，权重已归一化）
+		struct FilterTaps
+		{
+			std::vector<UInt> first;    // first[d] .. first[d + 1] 为目标像素 d 的抽头
+			std::vector<UInt> source;
+			std::vector<Float> weights;
+		};
+
+		FilterTaps BuildFilterTaps(UInt source_size, UInt destination_size, Bool tent)
+		{
+			FilterTaps taps;
+			taps.first.reserve(destination_size + 1);
+			const Float scale = static_cast<Float>(source_size) / destination_size;
+			const Float radius = tent ? scale : kLanczosLobes * scale;
+			for (UInt d = 0; d < destination_size; ++d)
+			{
+				const UInt first = static_cast<UInt>(taps.source.size());
+				taps.first.push_back(first);
+				if (source_size == destination_size)
+				{
+					taps.source.push_back(d);
+					taps.weights.push_back(1.0f);
+					continue;
+				}
+
+				// 像素中心在 (i + 0.5)，目标像素中心对应源坐标 (d + 0.5) * scale
+				const Float center = (d + 0.5f) * scale;
+				const int begin = static_cast<int>(std::floor(center - radius));
+				const int end = static_cast<int>(std::ceil(center + radius));
+				Float weight_sum = 0.0f;
+				for (int s = begin; s <= end; ++s)
+				{
+					const Float x = ((s + 0.5f) - center) / scale;
+					const Float weight = tent ? std::max(0.0f, 1.0f - std::fabs(x)) : Lanczos(x);
+					if (weight == 0.0f)
+					{
+						continue;
+					}
+					const UInt index = static_cast<UInt>(std::clamp(s, 0, static_cast<int>(source_size) - 1));
+					weight_sum += weight;
+					// 边缘外的抽头折叠到边缘像素上
+					if (taps.source.size() > first && taps.source.back() == index)
+					{
+						taps.weights.back() += weight;
+					}
+					else
+					{
+						taps.source.push_back(index);
+						taps.weights.push_back(weight);
+					}
+				}
+				for (std::size_t tap = first; tap < taps.weights.size(); ++tap)
+				{
+					taps.weights[tap] /= weight_sum;
+				}
+			}
+			taps.first.push_back(static_cast<UInt>(taps.source.size()));
+			return taps;
+		}
+
+		Float SRGBToLinear(Float value)
+		{
+			return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+		}
+
+		Float LinearToSRGB(Float value)
+		{
+			value = std::clamp(value, 0.0f, 1.0f);
+			return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+		}
+
+		void PostProcessPixel(TextureCookUsage usage, Float* pixel)
+		{
+			switch (usage)
+			{
+			case TextureCookUsage::Normal:
+			{
+				Float normal[3] = { pixel[0] * 2.0f - 1.0f, pixel[1] * 2.0f - 1.0f, pixel[2] * 2.0f - 1.0f };
+				const Float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+				if (length > 1.0e-6f)
+				{
+					for (Float& component : normal) component /= length;
+				}
+				else
+				{
+					normal[0] = 0.0f;
+					normal[1] = 0.0f;
+					normal[2] = 1.0f;
+				}
+				for (UInt c = 0; c < 3; ++c)
+				{
+					pixel[c] = normal[c] * 0.5f + 0.5f;
+				}
+				pixel[3] = std::clamp(pixel[3], 0.0f, 1.0f);
+				break;
+			}
+			case TextureCookUsage::HDR:
+				for (UInt c = 0; c < 4; ++c)
+				{
+					pixel[c] = std::max(pixel[c], 0.0f);
+				}
+				break;
+			case TextureCookUsage::Albedo:
+			case TextureCookUsage::Mask:
+			default:
+				for (UInt c = 0; c < 4; ++c)
+				{
+					pixel[c] = std::clamp(pixel[c], 0.0f, 1.0f);
+				}
+				break;
+			}
+		}
+
+		void WriteUInt(std::vector<UByte>& bytes, UInt value)
+		{
+			for (UInt shift = 0; shift < 32; shift += 8)
+			{
+				bytes.push_back(static_cast<UByte>(value >> shift));
+			}
+		}
+
+		// 读取一行（不含换行符），到达末尾返回 false
+		Bool ReadHeaderLine(const UByte* data, std::size_t size, std::size_t& offset, std::string& out_line)
+		{
+			out_line.clear();
+			while (offset < size)
+			{
+				const char ch = static_cast<char>(data[offset++]);
+				if (ch == '\n')
+				{
+					return true;
+				}
+				out_line.push_back(ch);
+			}
+			return false;
+		}
+
+		// 新式 RLE 扫描线：每个通道单独游程编码
+		Bool DecodeRLEScanline(const UByte* data, std::size_t size, std::size_t& offset, UInt width, UByte* out_scanline)
+		{
+			offset += 4;
+			for (UInt channel = 0; channel < 4; ++channel)
+			{
+				UInt x = 0;
+				while (x < width)
+				{
+					if (offset >= size)
+					{
+						return false;
+					}
+					UInt count = data[offset++];
+					if (count > 128)
+					{
+						count -= 128;
+						if (offset >= size || x + count > width)
+						{
+							return false;
+						}
+						const UByte value = data[offset++];
+						for (UInt i = 0; i < count; ++i, ++x)
+						{
+							out_scanline[x * 4 + channel] = value;
+						}
+					}
+					else
+					{
+						if (count == 0 || offset + count > size || x + count > width)
+						{
+							return false;
+						}
+						for (UInt i = 0; i < count; ++i, ++x)
+						{
+							out_scanline[x * 4 + channel] = data[offset++];
+						}
+					}
+				}
+			}
+			return true;
+		}
+	}
+
+	void TextureImage::Resize(UInt new_width, UInt new_height)
+	{
+		width = new_width;
+		height = new_height;
+		pixels.assign(static_cast<std::size_t>(new_width) * new_height * 4, 0.0f);
+	}
+
+	const char* GetTextureCookUsageName(TextureCookUsage usage)
+	{
+		switch (usage)
+		{
+		case TextureCookUsage::Albedo: return "albedo";
+		case TextureCookUsage::Normal: return "normal";
+		case TextureCookUsage::Mask:   return "mask";
+		case TextureCookUsage::HDR:    return "hdr";
+		default:                       return "unknown";
+		}
+	}
+
+	BlockFormat SelectTextureBlockFormat(TextureCookUsage usage, Bool has_alpha, Bool high_quality)
+	{
+		switch (usage)
+		{
+		case TextureCookUsage::Normal: return BlockFormat::BC5;
+		case TextureCookUsage::Mask:   return BlockFormat::BC4;
+		case TextureCookUsage::HDR:    return BlockFormat::BC6H;
+		case TextureCookUsage::Albedo:
+		default:
+			if (high_quality)
+			{
+				return BlockFormat::BC7;
+			}
+			return has_alpha ? BlockFormat::BC3 : BlockFormat::BC1;
+		}
+	}
+
+	Bool HasTranslucentAlpha(const TextureImage& image)
+	{
+		for (std::size_t i = 3; i < image.pixels.size(); i += 4)
+		{
+			// 留出浮点误差：8 位源图像中不是 255 的 alpha
+			if (image.pixels[i] < 0.998f)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	UInt ComputeFullMipCount(UInt width, UInt height)
+	{
+		UInt mip_count = 1;
+		for (UInt size = std::max(width, height); size > 1; size >>= 1)
+		{
+			++mip_count;
+		}
+		return mip_count;
+	}
+
+	void DownsampleImageRows(const TextureImage& source, TextureCookUsage usage, UInt row_begin, UInt row_end, TextureImage& destination)
+	{
+		const Bool tent = usage == TextureCookUsage::HDR;
+		const FilterTaps horizontal = BuildFilterTaps(source.width, destination.width, tent);
+		const FilterTaps vertical = BuildFilterTaps(source.height, destination.height, tent);
+
+		std::vector<Float> row(static_cast<std::size_t>(source.width) * 4);
+		for (UInt y = row_begin; y < row_end; ++y)
+		{
+			std::fill(row.begin(), row.end(), 0.0f);
+			for (UInt tap = vertical.first[y]; tap < vertical.first[y + 1]; ++tap)
+			{
+				const Float weight = vertical.weights[tap];
+				const Float* source_row = source.GetPixel(0, vertical.source[tap]);
+				for (std::size_t i = 0; i < row.size(); ++i)
+				{
+					row[i] += weight * source_row[i];
+				}
+			}
+
+			for (UInt x = 0; x < destination.width; ++x)
+			{
+				Float* pixel = destination.GetPixel(x, y);
+				Float value[4] = {};
+				for (UInt tap = horizontal.first[x]; tap < horizontal.first[x + 1]; ++tap)
+				{
+					const Float weight = horizontal.weights[tap];
+					const Float* source_pixel = row.data() + static_cast<std::size_t>(horizontal.source[tap]) * 4;
+					for (UInt c = 0; c < 4; ++c)
+					{
+						value[c] += weight * source_pixel[c];
+					}
+				}
+				std::copy(value, value + 4, pixel);
+				PostProcessPixel(usage, pixel);
+			}
+		}
+	}
+
+	void ConvertImageRowsSRGBToLinear(TextureImage& image, UInt row_begin, UInt row_end)
+	{
+		for (UInt y = row_begin; y < row_end; ++y)
+		{
+			for (UInt x = 0; x < image.width; ++x)
+			{
+				Float* pixel = image.GetPixel(x, y);
+				for (UInt c = 0; c < 3; ++c)
+				{
+					pixel[c] = SRGBToLinear(pixel[c]);
+				}
+			}
+		}
+	}
+
+	void ConvertImageRowsLinearToSRGB(TextureImage& image, UInt row_begin, UInt row_end)
+	{
+		for (UInt y = row_begin; y < row_end; ++y)
+		{
+			for (UInt x = 0; x < image.width; ++x)
+			{
+				Float* pixel = image.GetPixel(x, y);
+				for (UInt c = 0; c < 3; ++c)
+				{
+					pixel[c] = LinearToSRGB(pixel[c]);
+				}
+			}
+		}
+	}
+
+	ULongLong CookedTexture::GetByteSize() const
+	{
+		ULongLong bytes = 0;
+		for (const std::vector<UByte>& mip : mips)
+		{
+			bytes += mip.size();
+		}
+		return bytes;
+	}
+
+	Bool CookTexture(const TextureImage& image, const TextureCookSettings& settings, CookedTexture& out_texture, const TextureCookParallelFor& parallel_for /*= {}*/)
+	{
+		if (image.IsEmpty() || image.pixels.size() < static_cast<std::size_t>(image.width) * image.height * 4)
+		{
+			return false;
+		}
+
+		auto run = [&parallel_for](UInt count, const std::function<void(UInt, UInt)>& task)
+		{
+			if (parallel_for)
+			{
+				parallel_for(count, task);
+			}
+			else
+			{
+				task(0, count);
+			}
+		};
+
+		const Bool has_alpha = settings.usage == TextureCookUsage::Albedo && HasTranslucentAlpha(image);
+		const Bool linear_filtering = settings.usage == TextureCookUsage::Albedo;
+		UInt mip_count = ComputeFullMipCount(image.width, image.height);
+		if (settings.max_mip_count > 0)
+		{
+			mip_count = std::min(mip_count, settings.max_mip_count);
+		}
+
+		out_texture.format = SelectTextureBlockFormat(settings.usage, has_alpha, settings.high_quality);
+		out_texture.width = image.width;
+		out_texture.height = image.height;
+		out_texture.face_count = 1;
+		out_texture.mips.assign(mip_count, {});
+		out_texture.encoded_texel_count = 0;
+
+		// chain[0] 只作为滤波的输入（Albedo 转到线性空间），mip 0 直接压缩原图
+		const auto mip_start_time = std::chrono::high_resolution_clock::now();
+		std::vector<TextureImage> chain(mip_count);
+		if (mip_count > 1)
+		{
+			chain[0] = image;
+			if (linear_filtering)
+			{
+				run(chain[0].height, [&chain](UInt begin, UInt end) { ConvertImageRowsSRGBToLinear(chain[0], begin, end); });
+			}
+		}
+		for (UInt mip = 1; mip < mip_count; ++mip)
+		{
+			const TextureImage& source = chain[mip - 1];
+			TextureImage& destination = chain[mip];
+			destination.Resize(std::max(1u, source.width >> 1), std::max(1u, source.height >> 1));
+			run(destination.height, [&source, &destination, usage = settings.usage](UInt begin, UInt end)
+			{
+				DownsampleImageRows(source, usage, begin, end, destination);
+			});
+		}
+		if (linear_filtering)
+		{
+			for (UInt mip = 1; mip < mip_count; ++mip)
+			{
+				TextureImage& level = chain[mip];
+				run(level.height, [&level](UInt begin, UInt end) { ConvertImageRowsLinearToSRGB(level, begin, end); });
+			}
+		}
+		const auto encode_start_time = std::chrono::high_resolution_clock::now();
+		out_texture.mip_milliseconds = std::chrono::duration<Double, std::milli>(encode_start_time - mip_start_time).count();
+
+		for (UInt mip = 0; mip < mip_count; ++mip)
+		{
+			const TextureImage& level = mip == 0 ? image : chain[mip];
+			std::vector<UByte>& blocks = out_texture.mips[mip];
+			blocks.resize(static_cast<std::size_t>(ComputeBlockCompressedSize(out_texture.format, level.width, level.height)));
+			run((level.height + 3) / 4, [&level, &blocks, format = out_texture.format](UInt begin, UInt end)
+			{
+				CompressBlockRows(format, level.pixels.data(), level.width, level.height, begin, end, blocks.data());
+			});
+			out_texture.encoded_texel_count += static_cast<ULongLong>(level.width) * level.height;
+		}
+		out_texture.encode_milliseconds = std::chrono::duration<Double, std::milli>(std::chrono::high_resolution_clock::now() - encode_start_time).count();
+		return true;
+	}
+
+	std::vector<UByte> BuildCookedTextureDDS(const CookedTexture& texture)
+	{
+		constexpr UInt kMagic = 0x20534444;            // "DDS "
+		constexpr UInt kFourCCDX10 = 0x30315844;       // "DX10"
+		constexpr UInt kHeaderFlags = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000; // CAPS | HEIGHT | WIDTH | PIXELFORMAT | MIPMAPCOUNT | LINEARSIZE
+		constexpr UInt kPixelFormatFourCC = 0x4;
+		constexpr UInt kCapsTexture = 0x1000;
+		constexpr UInt kCapsMipmap = 0x8 | 0x400000;   // COMPLEX | MIPMAP
+		constexpr UInt kCapsComplex = 0x8;
+		constexpr UInt kCaps2Cubemap = 0x200 | 0xFC00; // CUBEMAP | 全部六个面
+		constexpr UInt kMiscTextureCube = 0x4;
+		constexpr UInt kDimensionTexture2D = 3;
+
+		std::vector<UByte> bytes;
+		bytes.reserve(4 + 124 + 20 + static_cast<std::size_t>(texture.GetByteSize()));
+		const UInt mip_count = texture.GetMipCount();
+		const Bool is_cube = texture.face_count == 6;
+
+		WriteUInt(bytes, kMagic);
+		// DDS_HEADER
+		WriteUInt(bytes, 124);
+		WriteUInt(bytes, kHeaderFlags);
+		WriteUInt(bytes, texture.height);
+		WriteUInt(bytes, texture.width);
+		WriteUInt(bytes, texture.mips.empty() ? 0 : static_cast<UInt>(texture.mips[0].size()));
+		WriteUInt(bytes, 0);                   // depth
+		WriteUInt(bytes, mip_count);
+		for (UInt i = 0; i < 11; ++i)
+		{
+			WriteUInt(bytes, 0);               // reserved1
+		}
+		// DDS_PIXELFORMAT
+		WriteUInt(bytes, 32);
+		WriteUInt(bytes, kPixelFormatFourCC);
+		WriteUInt(bytes, kFourCCDX10);
+		for (UInt i = 0; i < 5; ++i)
+		{
+			WriteUInt(bytes, 0);               // bit count 与各通道掩码
+		}
+		WriteUInt(bytes, kCapsTexture | (mip_count > 1 ? kCapsMipmap : 0) | (is_cube ? kCapsComplex : 0));
+		WriteUInt(bytes, is_cube ? kCaps2Cubemap : 0);
+		for (UInt i = 0; i < 3; ++i)
+		{
+			WriteUInt(bytes, 0);               // caps3, caps4, reserved2
+		}
+		// DDS_HEADER_DXT10
+		WriteUInt(bytes, GetDXGIFormat(texture.format));
+		WriteUInt(bytes, kDimensionTexture2D);
+		WriteUInt(bytes, is_cube ? kMiscTextureCube : 0);
+		WriteUInt(bytes, 1);                   // array size（立方体为立方体的个数）
+		WriteUInt(bytes, 0);                   // alpha mode unknown
+
+		for (const std::vector<UByte>& mip : texture.mips)
+		{
+			bytes.insert(bytes.end(), mip.begin(), mip.end());
+		}
+		return bytes;
+	}
+
+	Bool SaveCookedTextureDDS(const CookedTexture& texture, const std::filesystem::path& file_path)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(file_path.parent_path(), error);
+		// 先写临时文件再改名，运行时不会读到写了一半的文件
+		const std::filesystem::path temp_path = file_path.string() + ".tmp";
+		{
+			std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+			if (!file)
+			{
+				return false;
+			}
+			const std::vector<UByte> bytes = BuildCookedTextureDDS(texture);
+			file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+			if (!file)
+			{
+				return false;
+			}
+		}
+		std::filesystem::rename(temp_path, file_path, error);
+		return !error;
+	}
+
+	Bool DecodeRadianceHDR(const UByte* data, std::size_t size, TextureImage& out_image)
+	{
+		std::size_t offset = 0;
+		std::string line;
+		if (!ReadHeaderLine(data, size, offset, line) || line.compare(0, 2, "#?") != 0)
+		{
+			return false;
+		}
+		while (true)
+		{
+			if (!ReadHeaderLine(data, size, offset, line))
+			{
+				return false;
+			}
+			if (line.empty())
+			{
+				break;
+			}
+			if (line.compare(0, 7, "FORMAT=") == 0 && line != "FORMAT=32-bit_rle_rgbe")
+			{
+				return false;
+			}
+		}
+
+		UInt width = 0;
+		UInt height = 0;
+		if (!ReadHeaderLine(data, size, offset, line) || std::sscanf(line.c_str(), "-Y %u +X %u", &height, &width) != 2 || width == 0 || height == 0)
+		{
+			return false;
+		}
+
+		out_image.Resize(width, height);
+		std::vector<UByte> scanline(static_cast<std::size_t>(width) * 4);
+		for (UInt y = 0; y < height; ++y)
+		{
+			const Bool rle = width >= 8 && width < 0x8000 && offset + 4 <= size &&
+				data[offset] == 2 && data[offset + 1] == 2 && (data[offset + 2] & 0x80) == 0 &&
+				((static_cast<UInt>(data[offset + 2]) << 8) | data[offset + 3]) == width;
+			if (rle)
+			{
+				if (!DecodeRLEScanline(data, size, offset, width, scanline.data()))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				if (offset + scanline.size() > size)
+				{
+					return false;
+				}
+				std::memcpy(scanline.data(), data + offset, scanline.size());
+				offset += scanline.size();
+			}
+
+			for (UInt x = 0; x < width; ++x)
+			{
+				const UByte* rgbe = scanline.data() + static_cast<std::size_t>(x) * 4;
+				Float* pixel = out_image.GetPixel(x, y);
+				const Float scale = rgbe[3] == 0 ? 0.0f : std::ldexp(1.0f, static_cast<int>(rgbe[3]) - (128 + 8));
+				pixel[0] = rgbe[0] * scale;
+				pixel[1] = rgbe[1] * scale;
+				pixel[2] = rgbe[2] * scale;
+				pixel[3] = 1.0f;
+			}
+		}
+		return true;
+	}
+
+	Bool LoadRadianceHDRFile(const std::filesystem::path& file_path, TextureImage& out_image)
+	{
+		std::ifstream file(file_path, std::ios::binary);
+		if (!file)
+		{
+			return false;
+		}
+		const std::vector<UByte> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		return DecodeRadianceHDR(bytes.data(), bytes.size(), out_image);
+	}
+}
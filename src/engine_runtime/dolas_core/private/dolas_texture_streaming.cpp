@@ -0,0 +1,344 @@
+#include "dolas_texture_streaming.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace Dolas
+{
+	UInt ComputeTailFirstMip(UInt width, UInt height, UInt mip_count, UInt tail_mip_size)
+	{
+		if (mip_count == 0)
+		{
+			return 0;
+		}
+		UInt mip = 0;
+		while (mip + 1 < mip_count && std::max(width >> mip, height >> mip) > tail_mip_size)
+		{
+			++mip;
+		}
+		return mip;
+	}
+
+	UInt ComputeDesiredMip(UInt width, UInt height, UInt mip_count, Float screen_pixels_per_uv, Float mip_bias /*= 0.0f*/)
+	{
+		if (mip_count == 0)
+		{
+			return 0;
+		}
+		if (!(screen_pixels_per_uv > 0.0f))
+		{
+			return mip_count - 1;
+		}
+		const Float texels_per_pixel = static_cast<Float>(std::max(width, height)) / screen_pixels_per_uv;
+		const Float level = std::floor(std::log2(texels_per_pixel) + mip_bias);
+		if (!(level > 0.0f))
+		{
+			return 0;
+		}
+		return std::min(mip_count - 1, static_cast<UInt>(std::min(level, 31.0f)));
+	}
+
+	Float EstimateScreenPixelsPerUV(Float world_radius, Float view_distance, Float projection_scale, Float viewport_height)
+	{
+		if (view_distance <= world_radius)
+		{
+			return std::numeric_limits<Float>::max();
+		}
+		// 投影后的直径（NDC）乘以半个视口高度
+		return world_radius * projection_scale * viewport_height / view_distance;
+	}
+
+	void TextureStreamingFeedback::Record(TextureID texture_id, Float screen_pixels_per_uv)
+	{
+		Float& value = m_screen_pixels_per_uv[texture_id];
+		value = std::max(value, screen_pixels_per_uv);
+	}
+
+	Float TextureStreamingFeedback::Get(TextureID texture_id) const
+	{
+		auto iter = m_screen_pixels_per_uv.find(texture_id);
+		return iter != m_screen_pixels_per_uv.end() ? iter->second : 0.0f;
+	}
+
+	void TextureStreamingPolicy::Initialize(const TextureStreamingDesc& desc)
+	{
+		Clear();
+		m_desc = desc;
+	}
+
+	void TextureStreamingPolicy::Clear()
+	{
+		m_textures.clear();
+		m_frame = 0;
+		m_resident_bytes = 0;
+		m_streamed_in_bytes = 0;
+		m_streamed_out_bytes = 0;
+	}
+
+	void TextureStreamingPolicy::RegisterTexture(TextureID texture_id, UInt width, UInt height, const std::vector<ULongLong>& mip_bytes)
+	{
+		if (mip_bytes.empty())
+		{
+			return;
+		}
+		UnregisterTexture(texture_id);
+
+		const UInt mip_count = static_cast<UInt>(mip_bytes.size());
+		Entry entry;
+		entry.width = width;
+		entry.height = height;
+		entry.mip_bytes = mip_bytes;
+		entry.bytes_from_mip.assign(mip_count + 1, 0);
+		for (UInt mip = mip_count; mip-- > 0;)
+		{
+			entry.bytes_from_mip[mip] = entry.bytes_from_mip[mip + 1] + mip_bytes[mip];
+		}
+		entry.tail_first_mip = ComputeTailFirstMip(width, height, mip_count, m_desc.tail_mip_size);
+		// 尾部加载完成之前没有常驻的 mip
+		entry.resident_first_mip = mip_count;
+		entry.wanted_first_mip = entry.tail_first_mip;
+		entry.target_first_mip = entry.tail_first_mip;
+		entry.streaming_first_mip = entry.tail_first_mip;
+		entry.streaming = true;
+		entry.last_used_frame = m_frame;
+		m_textures[texture_id] = std::move(entry);
+	}
+
+	void TextureStreamingPolicy::UnregisterTexture(TextureID texture_id)
+	{
+		auto iter = m_textures.find(texture_id);
+		if (iter == m_textures.end())
+		{
+			return;
+		}
+		m_resident_bytes -= iter->second.bytes_from_mip[iter->second.resident_first_mip];
+		m_textures.erase(iter);
+	}
+
+	UInt TextureStreamingPolicy::GetTailFirstMip(TextureID texture_id) const
+	{
+		auto iter = m_textures.find(texture_id);
+		return iter != m_textures.end() ? iter->second.tail_first_mip : 0;
+	}
+
+	UInt TextureStreamingPolicy::GetResidentFirstMip(TextureID texture_id) const
+	{
+		auto iter = m_textures.find(texture_id);
+		return iter != m_textures.end() ? iter->second.resident_first_mip : 0;
+	}
+
+	void TextureStreamingPolicy::UpdateWanted(Entry& entry, UInt desired_first_mip) const
+	{
+		if (desired_first_mip < entry.wanted_first_mip)
+		{
+			// 需要更高精度时立即响应
+			entry.wanted_first_mip = desired_first_mip;
+			entry.coarser_frames = 0;
+		}
+		else if (desired_first_mip > entry.wanted_first_mip)
+		{
+			if (++entry.coarser_frames >= m_desc.drop_delay_frames)
+			{
+				entry.wanted_first_mip = desired_first_mip;
+				entry.coarser_frames = 0;
+			}
+		}
+		else
+		{
+			entry.coarser_frames = 0;
+		}
+	}
+
+	void TextureStreamingPolicy::SolveBudget()
+	{
+		ULongLong total_bytes = 0;
+		for (auto& texture_pair : m_textures)
+		{
+			Entry& entry = texture_pair.second;
+			entry.target_first_mip = entry.wanted_first_mip;
+			total_bytes += entry.bytes_from_mip[entry.target_first_mip];
+		}
+		if (total_bytes <= m_desc.budget_bytes)
+		{
+			return;
+		}
+
+		// 分数 = 最高一级 mip 的字节数 / 屏幕覆盖面积 * (1 + 距离上次使用的帧数)：
+		// 先丢弃每字节影响像素最少、久未使用的 mip。分数相同时按纹理 ID 决定，结果与遍历顺序无关
+		using Candidate = std::pair<Double, TextureID>;
+		auto score = [this](const Entry& entry)
+		{
+			const Double age = static_cast<Double>(m_frame - entry.last_used_frame);
+			const Double screen_pixels = std::clamp(static_cast<Double>(entry.screen_pixels_per_uv), 1.0, 1.0e6);
+			return static_cast<Double>(entry.mip_bytes[entry.target_first_mip]) / (screen_pixels * screen_pixels) * (1.0 + age);
+		};
+		std::priority_queue<Candidate> candidates;
+		for (const auto& texture_pair : m_textures)
+		{
+			const Entry& entry = texture_pair.second;
+			if (entry.target_first_mip < entry.tail_first_mip)
+			{
+				candidates.emplace(score(entry), texture_pair.first);
+			}
+		}
+
+		while (total_bytes > m_desc.budget_bytes && !candidates.empty())
+		{
+			const TextureID texture_id = candidates.top().second;
+			candidates.pop();
+			Entry& entry = m_textures[texture_id];
+			total_bytes -= entry.mip_bytes[entry.target_first_mip];
+			++entry.target_first_mip;
+			if (entry.target_first_mip < entry.tail_first_mip)
+			{
+				candidates.emplace(score(entry), texture_id);
+			}
+		}
+	}
+
+	void TextureStreamingPolicy::Update(const TextureStreamingFeedback& feedback, std::vector<TextureStreamingRequest>& out_requests)
+	{
+		out_requests.clear();
+		++m_frame;
+
+		for (auto& texture_pair : m_textures)
+		{
+			Entry& entry = texture_pair.second;
+			const UInt mip_count = static_cast<UInt>(entry.mip_bytes.size());
+			const Float screen_pixels_per_uv = feedback.Get(texture_pair.first);
+			UInt desired_first_mip = entry.tail_first_mip;
+			if (screen_pixels_per_uv > 0.0f)
+			{
+				entry.last_used_frame = m_frame;
+				entry.screen_pixels_per_uv = screen_pixels_per_uv;
+				desired_first_mip = std::min(entry.tail_first_mip,
+					ComputeDesiredMip(entry.width, entry.height, mip_count, screen_pixels_per_uv, m_desc.mip_bias));
+			}
+			UpdateWanted(entry, desired_first_mip);
+		}
+
+		SolveBudget();
+
+		// 正在进行的请求按完成后的大小计入，保证流入之后仍在预算之内
+		ULongLong committed_bytes = 0;
+		std::vector<std::pair<TextureID, Entry*>> stream_in_candidates;
+		for (auto& texture_pair : m_textures)
+		{
+			Entry& entry = texture_pair.second;
+			if (!entry.streaming && entry.target_first_mip > entry.resident_first_mip)
+			{
+				entry.streaming = true;
+				entry.streaming_first_mip = entry.target_first_mip;
+				out_requests.push_back({ texture_pair.first, entry.target_first_mip });
+			}
+			else if (!entry.streaming && entry.target_first_mip < entry.resident_first_mip)
+			{
+				stream_in_candidates.emplace_back(texture_pair.first, &entry);
+			}
+			committed_bytes += entry.bytes_from_mip[entry.streaming ? entry.streaming_first_mip : entry.resident_first_mip];
+		}
+		std::sort(out_requests.begin(), out_requests.end(),
+			[](const TextureStreamingRequest& a, const TextureStreamingRequest& b) { return a.texture_id < b.texture_id; });
+
+		// 先流入最近用到、差距最大的纹理
+		std::sort(stream_in_candidates.begin(), stream_in_candidates.end(),
+			[](const std::pair<TextureID, Entry*>& a, const std::pair<TextureID, Entry*>& b)
+			{
+				const Entry& entry_a = *a.second;
+				const Entry& entry_b = *b.second;
+				if (entry_a.last_used_frame != entry_b.last_used_frame)
+				{
+					return entry_a.last_used_frame > entry_b.last_used_frame;
+				}
+				const UInt deficit_a = entry_a.resident_first_mip - entry_a.target_first_mip;
+				const UInt deficit_b = entry_b.resident_first_mip - entry_b.target_first_mip;
+				if (deficit_a != deficit_b)
+				{
+					return deficit_a > deficit_b;
+				}
+				return a.first < b.first;
+			});
+
+		ULongLong stream_in_bytes = 0;
+		Bool any_stream_in = false;
+		for (auto& candidate : stream_in_candidates)
+		{
+			Entry& entry = *candidate.second;
+			const ULongLong resident_bytes = entry.bytes_from_mip[entry.resident_first_mip];
+			// 从目标开始找放得下的最高精度；本次还没有流入时，至少前进一级，大 mip 也能流入
+			UInt first_mip = entry.resident_first_mip;
+			for (UInt mip = entry.target_first_mip; mip < entry.resident_first_mip; ++mip)
+			{
+				const ULongLong increment = entry.bytes_from_mip[mip] - resident_bytes;
+				if (stream_in_bytes + increment <= m_desc.max_stream_in_bytes_per_update || (!any_stream_in && mip + 1 == entry.resident_first_mip))
+				{
+					first_mip = mip;
+					break;
+				}
+			}
+			if (first_mip == entry.resident_first_mip)
+			{
+				continue;
+			}
+
+			const ULongLong increment = entry.bytes_from_mip[first_mip] - resident_bytes;
+			if (committed_bytes + increment > m_desc.budget_bytes)
+			{
+				continue;
+			}
+			committed_bytes += increment;
+			stream_in_bytes += increment;
+			any_stream_in = true;
+			entry.streaming = true;
+			entry.streaming_first_mip = first_mip;
+			out_requests.push_back({ candidate.first, first_mip });
+		}
+	}
+
+	void TextureStreamingPolicy::OnStreamingFinished(TextureID texture_id, UInt first_mip)
+	{
+		auto iter = m_textures.find(texture_id);
+		if (iter == m_textures.end())
+		{
+			return;
+		}
+		Entry& entry = iter->second;
+		const UInt mip_count = static_cast<UInt>(entry.mip_bytes.size());
+		first_mip = std::min(first_mip, mip_count - 1);
+
+		const ULongLong old_bytes = entry.bytes_from_mip[entry.resident_first_mip];
+		const ULongLong new_bytes = entry.bytes_from_mip[first_mip];
+		if (new_bytes > old_bytes)
+		{
+			m_streamed_in_bytes += new_bytes - old_bytes;
+		}
+		else
+		{
+			m_streamed_out_bytes += old_bytes - new_bytes;
+		}
+		m_resident_bytes = m_resident_bytes - old_bytes + new_bytes;
+		entry.resident_first_mip = first_mip;
+		entry.streaming = false;
+	}
+
+	TextureStreamingStatistics TextureStreamingPolicy::GetStatistics() const
+	{
+		TextureStreamingStatistics statistics;
+		statistics.texture_count = static_cast<UInt>(m_textures.size());
+		statistics.budget_bytes = m_desc.budget_bytes;
+		statistics.resident_bytes = m_resident_bytes;
+		statistics.streamed_in_bytes = m_streamed_in_bytes;
+		statistics.streamed_out_bytes = m_streamed_out_bytes;
+		for (const auto& texture_pair : m_textures)
+		{
+			const Entry& entry = texture_pair.second;
+			statistics.streaming_count += entry.streaming ? 1 : 0;
+			statistics.target_bytes += entry.bytes_from_mip[entry.target_first_mip];
+			statistics.wanted_bytes += entry.bytes_from_mip[entry.wanted_first_mip];
+			statistics.tail_bytes += entry.bytes_from_mip[entry.tail_first_mip];
+		}
+		return statistics;
+	}
+}
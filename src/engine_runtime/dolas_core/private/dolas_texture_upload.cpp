@@ -0,0 +1,333 @@
+#include "dolas_texture_upload.h"
+#include <algorithm>
+
+namespace Dolas
+{
+	void UploadRingAllocator::Initialize(ULongLong capacity)
+	{
+		m_capacity = capacity;
+		m_head = 0;
+		m_tail = 0;
+		m_used = 0;
+		m_open_bytes = 0;
+		m_batches.clear();
+	}
+
+	ULongLong UploadRingAllocator::Allocate(ULongLong size, ULongLong alignment)
+	{
+		if (size == 0 || size > m_capacity)
+		{
+			return INVALID_OFFSET;
+		}
+		if (m_used == 0)
+		{
+			m_head = 0;
+			m_tail = 0;
+		}
+
+		const ULongLong aligned_head = (m_head + alignment - 1) & ~(alignment - 1);
+		const Bool wrapped = m_head < m_tail || (m_head == m_tail && m_used > 0);
+		if (!wrapped)
+		{
+			if (aligned_head + size <= m_capacity)
+			{
+				Consume(aligned_head + size - m_head);
+				m_head = aligned_head + size;
+				return aligned_head;
+			}
+			// 末尾放不下时从头开始，跳过的尾部算作本批次占用，回收时一起释放
+			if (size <= m_tail)
+			{
+				Consume(m_capacity - m_head + size);
+				m_head = size;
+				return 0;
+			}
+			return INVALID_OFFSET;
+		}
+
+		if (aligned_head + size <= m_tail)
+		{
+			Consume(aligned_head + size - m_head);
+			m_head = aligned_head + size;
+			return aligned_head;
+		}
+		return INVALID_OFFSET;
+	}
+
+	void UploadRingAllocator::Consume(ULongLong bytes)
+	{
+		m_used += bytes;
+		m_open_bytes += bytes;
+	}
+
+	void UploadRingAllocator::Submit(ULongLong fence_value)
+	{
+		if (m_open_bytes == 0)
+		{
+			return;
+		}
+		m_batches.push_back({ m_head, m_open_bytes, fence_value });
+		m_open_bytes = 0;
+	}
+
+	void UploadRingAllocator::Retire(ULongLong completed_fence_value)
+	{
+		while (!m_batches.empty() && m_batches.front().fence_value <= completed_fence_value)
+		{
+			m_tail = m_batches.front().end;
+			m_used -= m_batches.front().bytes;
+			m_batches.pop_front();
+		}
+	}
+
+	void TextureLoadScheduler::Initialize(const TextureLoadSchedulerDesc& desc)
+	{
+		Clear();
+		m_desc = desc;
+		m_desc.max_concurrent_decodes = std::max<UInt>(1, m_desc.max_concurrent_decodes);
+		m_ring.Initialize(m_desc.staging_capacity);
+	}
+
+	void TextureLoadScheduler::Clear()
+	{
+		m_ring.Initialize(m_desc.staging_capacity);
+		m_requests.clear();
+		m_queued.clear();
+		m_decoded.clear();
+		m_open_copies.clear();
+		m_batches.clear();
+		m_decoding_count = 0;
+		m_submitted_batches = 0;
+		m_dedicated_copies = 0;
+		m_submitted_bytes = 0;
+	}
+
+	TextureLoadScheduler::RequestID TextureLoadScheduler::AddRequest()
+	{
+		const RequestID request = m_next_request++;
+		m_requests.emplace(request, Request());
+		m_queued.push_back(request);
+		return request;
+	}
+
+	void TextureLoadScheduler::Cancel(RequestID request)
+	{
+		auto it = m_requests.find(request);
+		if (it == m_requests.end())
+		{
+			return;
+		}
+
+		Request& entry = it->second;
+		switch (entry.state)
+		{
+		case TextureLoadState::Queued:
+			m_queued.erase(std::find(m_queued.begin(), m_queued.end(), request));
+			Erase(request);
+			break;
+		case TextureLoadState::Decoding:
+			// 解码任务无法中断，完成时丢弃结果
+			entry.cancelled = true;
+			break;
+		default:
+		{
+			auto decoded_it = std::find(m_decoded.begin(), m_decoded.end(), request);
+			if (decoded_it != m_decoded.end())
+			{
+				m_decoded.erase(decoded_it);
+			}
+			const Bool in_open_batch = std::any_of(m_open_copies.begin(), m_open_copies.end(),
+				[request](const TextureUploadCopy& copy) { return copy.request == request; });
+			if (entry.in_flight_subresources == 0 && !in_open_batch)
+			{
+				Erase(request);
+			}
+			else
+			{
+				// GPU 还在读取上传缓冲，批次完成后再移除
+				entry.cancelled = true;
+			}
+			break;
+		}
+		}
+	}
+
+	void TextureLoadScheduler::TakeDecodeRequests(std::vector<RequestID>& out_requests)
+	{
+		out_requests.clear();
+		while (!m_queued.empty() && m_decoding_count < m_desc.max_concurrent_decodes)
+		{
+			const RequestID request = m_queued.front();
+			m_queued.pop_front();
+			m_requests[request].state = TextureLoadState::Decoding;
+			++m_decoding_count;
+			out_requests.push_back(request);
+		}
+	}
+
+	void TextureLoadScheduler::OnDecoded(RequestID request, const std::vector<ULongLong>& subresource_sizes)
+	{
+		auto it = m_requests.find(request);
+		if (it == m_requests.end() || it->second.state != TextureLoadState::Decoding)
+		{
+			return;
+		}
+		--m_decoding_count;
+
+		Request& entry = it->second;
+		if (entry.cancelled || subresource_sizes.empty())
+		{
+			Erase(request);
+			return;
+		}
+		entry.state = TextureLoadState::Decoded;
+		entry.subresource_sizes = subresource_sizes;
+		m_decoded.push_back(request);
+	}
+
+	void TextureLoadScheduler::OnDecodeFailed(RequestID request)
+	{
+		auto it = m_requests.find(request);
+		if (it == m_requests.end() || it->second.state != TextureLoadState::Decoding)
+		{
+			return;
+		}
+		--m_decoding_count;
+		Erase(request);
+	}
+
+	void TextureLoadScheduler::BuildBatch(std::vector<TextureUploadCopy>& out_copies)
+	{
+		out_copies.clear();
+		ULongLong batch_bytes = 0;
+		while (!m_decoded.empty())
+		{
+			const RequestID request = m_decoded.front();
+			Request& entry = m_requests[request];
+			while (entry.next_subresource < entry.subresource_sizes.size())
+			{
+				TextureUploadCopy copy;
+				copy.request = request;
+				copy.subresource = entry.next_subresource;
+				copy.size = entry.subresource_sizes[entry.next_subresource];
+				if (!out_copies.empty() && batch_bytes + copy.size > m_desc.max_batch_bytes)
+				{
+					m_open_copies = out_copies;
+					return;
+				}
+				if (copy.size > m_ring.GetCapacity())
+				{
+					copy.dedicated = true;
+				}
+				else
+				{
+					copy.ring_offset = m_ring.Allocate(copy.size, m_desc.placement_alignment);
+					if (copy.ring_offset == UploadRingAllocator::INVALID_OFFSET)
+					{
+						// 上传环已满，等之前的批次完成
+						m_open_copies = out_copies;
+						return;
+					}
+				}
+				out_copies.push_back(copy);
+				batch_bytes += copy.size;
+				++entry.next_subresource;
+			}
+			entry.state = TextureLoadState::Uploading;
+			m_decoded.pop_front();
+		}
+		m_open_copies = out_copies;
+	}
+
+	void TextureLoadScheduler::SubmitBatch(ULongLong fence_value)
+	{
+		if (m_open_copies.empty())
+		{
+			return;
+		}
+
+		m_ring.Submit(fence_value);
+		Batch batch;
+		batch.fence_value = fence_value;
+		for (const TextureUploadCopy& copy : m_open_copies)
+		{
+			++m_requests[copy.request].in_flight_subresources;
+			if (batch.subresource_counts.empty() || batch.subresource_counts.back().first != copy.request)
+			{
+				batch.subresource_counts.emplace_back(copy.request, 0);
+			}
+			++batch.subresource_counts.back().second;
+			m_submitted_bytes += copy.size;
+			if (copy.dedicated)
+			{
+				++m_dedicated_copies;
+			}
+		}
+		m_batches.push_back(std::move(batch));
+		++m_submitted_batches;
+		m_open_copies.clear();
+	}
+
+	void TextureLoadScheduler::Retire(ULongLong completed_fence_value, std::vector<RequestID>& out_completed)
+	{
+		out_completed.clear();
+		m_ring.Retire(completed_fence_value);
+		while (!m_batches.empty() && m_batches.front().fence_value <= completed_fence_value)
+		{
+			for (const auto& [request, count] : m_batches.front().subresource_counts)
+			{
+				auto it = m_requests.find(request);
+				if (it == m_requests.end())
+				{
+					continue;
+				}
+				Request& entry = it->second;
+				entry.in_flight_subresources -= count;
+				const Bool all_submitted = entry.next_subresource == entry.subresource_sizes.size();
+				if (entry.in_flight_subresources == 0 && (entry.cancelled || all_submitted))
+				{
+					if (!entry.cancelled)
+					{
+						out_completed.push_back(request);
+					}
+					Erase(request);
+				}
+			}
+			m_batches.pop_front();
+		}
+	}
+
+	TextureLoadState TextureLoadScheduler::GetState(RequestID request) const
+	{
+		auto it = m_requests.find(request);
+		return it != m_requests.end() ? it->second.state : TextureLoadState::None;
+	}
+
+	TextureLoadSchedulerStatistics TextureLoadScheduler::GetStatistics() const
+	{
+		TextureLoadSchedulerStatistics statistics;
+		statistics.queued_count = static_cast<UInt>(m_queued.size());
+		statistics.decoding_count = m_decoding_count;
+		for (const auto& [request, entry] : m_requests)
+		{
+			if (entry.state == TextureLoadState::Decoded)
+			{
+				++statistics.decoded_count;
+			}
+			else if (entry.state == TextureLoadState::Uploading)
+			{
+				++statistics.uploading_count;
+			}
+		}
+		statistics.submitted_batches = m_submitted_batches;
+		statistics.dedicated_copies = m_dedicated_copies;
+		statistics.submitted_bytes = m_submitted_bytes;
+		statistics.staging_used_bytes = m_ring.GetUsedBytes();
+		return statistics;
+	}
+
+	void TextureLoadScheduler::Erase(RequestID request)
+	{
+		m_requests.erase(request);
+	}
+}
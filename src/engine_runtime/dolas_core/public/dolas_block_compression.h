@@ -0,0 +1,54 @@
+#ifndef DOLAS_BLOCK_COMPRESSION_H
+#define DOLAS_BLOCK_COMPRESSION_H
+
+#include "dolas_base.h"
+
+namespace Dolas
+{
+    // 4x4 块压缩格式。LDR 格式的输入为 [0, 1] 的 RGBA，BC6H 为非负的线性 HDR 值
+    enum class BlockFormat : UInt
+    {
+        BC1 = 0,  // RGB，8 字节 / 块
+        BC3,      // RGB + 独立的 alpha，16 字节 / 块
+        BC4,      // 单通道（R），8 字节 / 块
+        BC5,      // 双通道（RG），16 字节 / 块
+        BC6H,     // 无符号 HDR RGB（UF16），16 字节 / 块
+        BC7,      // 高质量 RGBA，16 字节 / 块
+    };
+
+    static constexpr UInt BLOCK_TEXEL_COUNT = 16;
+
+    UInt GetBlockFormatBytes(BlockFormat format);
+    const char* GetBlockFormatName(BlockFormat format);
+    // width x height 的一个 mip 压缩后的字节数（不足 4 的边按一个块计）
+    ULongLong ComputeBlockCompressedSize(BlockFormat format, UInt width, UInt height);
+
+    enum class BlockCompressionPath : UInt
+    {
+        Scalar = 0,
+        SSE,  // 4 路
+        AVX,  // 8 路
+    };
+
+    // 编译期可用的最宽路径（MSVC /arch:AVX 或 -mavx 时为 AVX，x64 默认为 SSE）
+    BlockCompressionPath GetBlockCompressionPath();
+
+    // texels 为一个块的 16 个 RGBA 纹素（行优先，每个纹素 4 个 Float）。
+    // 各格式只编码一部分模式：BC1 总是 4 色模式，BC6H 只用单区域 10 位端点（mode 11），BC7 只用 mode 6
+    void EncodeBlock(BlockFormat format, const Float* texels, UByte* out_block);
+    // 解码为 16 个 RGBA 纹素，用于验证与测试。BC6H / BC7 只支持编码器产生的模式，其他模式返回 false
+    Bool DecodeBlock(BlockFormat format, const UByte* block, Float* out_texels);
+
+    // 压缩 RGBA 浮点图像 pixels（width x height，行优先）第 [block_row_begin, block_row_end) 行的块，
+    // 写入整幅图像的块数组 out_blocks（行优先）；图像边缘不足一个块时重复边缘纹素。
+    // 每个块只由自身的 4x4 纹素决定（端点不做跨块优化），按块行分给多个线程的结果与串行压缩逐位一致
+    void CompressBlockRows(BlockFormat format, const Float* pixels, UInt width, UInt height, UInt block_row_begin, UInt block_row_end, UByte* out_blocks);
+    // 不使用 SIMD 的版本，结果与 CompressBlockRows 逐位一致，用于验证与性能对比
+    void CompressBlockRowsScalar(BlockFormat format, const Float* pixels, UInt width, UInt height, UInt block_row_begin, UInt block_row_end, UByte* out_blocks);
+
+    // IEEE 半精度（BC6H 在半精度的位模式上插值）
+    UInt FloatToHalf(Float value);
+    Float HalfToFloat(UInt half);
+}
+
+#endif // DOLAS_BLOCK_COMPRESSION_H
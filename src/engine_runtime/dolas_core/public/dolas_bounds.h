@@ -0,0 +1,90 @@
+#ifndef DOLAS_BOUNDS_H
+#define DOLAS_BOUNDS_H
+
+#include <cstddef>
+#include "dolas_base.h"
+#include "dolas_math.h"
+
+namespace Dolas
+{
+    enum class ContainmentType : UInt
+    {
+        Disjoint = 0,
+        Intersects,
+        Contains,
+    };
+
+    // 轴对齐包围盒，默认构造为空盒（min > max），Merge 任意点后变为有效
+    struct BoundingBox
+    {
+        Vector3 min_point = Vector3(DOLAS_FLOAT_MAX, DOLAS_FLOAT_MAX, DOLAS_FLOAT_MAX);
+        Vector3 max_point = Vector3(DOLAS_FLOAT_MIN, DOLAS_FLOAT_MIN, DOLAS_FLOAT_MIN);
+
+        BoundingBox() = default;
+        BoundingBox(const Vector3& in_min_point, const Vector3& in_max_point) : min_point(in_min_point), max_point(in_max_point) {}
+
+        Bool IsValid() const { return min_point.x <= max_point.x && min_point.y <= max_point.y && min_point.z <= max_point.z; }
+        Vector3 GetCenter() const { return (min_point + max_point) * 0.5f; }
+        Vector3 GetExtents() const { return (max_point - min_point) * 0.5f; }
+
+        Float GetSurfaceArea() const;
+        Bool Contains(const BoundingBox& other) const;
+        Bool Intersects(const BoundingBox& other) const;
+        // slab 测试，direction 不要求归一化，out_distance 以 direction 长度为单位；起点在盒内时距离为 0
+        Bool IntersectsRay(const Vector3& origin, const Vector3& direction, Float max_distance, Float& out_distance) const;
+
+        void Merge(const Vector3& point);
+        void Merge(const BoundingBox& other);
+        static BoundingBox Union(const BoundingBox& a, const BoundingBox& b);
+        // 变换后的包围盒仍然轴对齐（Arvo 方法），会比原物体稍大但保证保守
+        BoundingBox Transform(const Matrix4x4& matrix) const;
+
+        // positions 按 stride（单位：Float）排列，每个顶点前三个分量为 xyz
+        static BoundingBox FromPositions(const Float* positions, std::size_t vertex_count, std::size_t stride = 3);
+    };
+
+    struct BoundingSphere
+    {
+        Vector3 center = Vector3::ZERO;
+        Float radius = -1.0f;
+
+        BoundingSphere() = default;
+        BoundingSphere(const Vector3& in_center, Float in_radius) : center(in_center), radius(in_radius) {}
+
+        Bool IsValid() const { return radius >= 0.0f; }
+        // 非均匀缩放时取最大缩放轴，结果保守
+        BoundingSphere Transform(const Matrix4x4& matrix) const;
+
+        // 以 AABB 中心为球心、最远顶点距离为半径
+        static BoundingSphere FromPositions(const Float* positions, std::size_t vertex_count, std::size_t stride = 3);
+        static BoundingSphere FromBox(const BoundingBox& box);
+    };
+
+    // 六个平面 (n, d)，n 指向视锥内部，满足 dot(n, p) + d >= 0 的点在平面内侧
+    struct Frustum
+    {
+        enum PlaneIndex : UInt
+        {
+            PlaneIndex_LEFT = 0,
+            PlaneIndex_RIGHT,
+            PlaneIndex_BOTTOM,
+            PlaneIndex_TOP,
+            PlaneIndex_NEAR,
+            PlaneIndex_FAR,
+            PlaneIndex_COUNT,
+        };
+
+        Vector4 planes[PlaneIndex_COUNT];
+
+        // view_projection 为列向量约定（clip = VP * p），裁剪空间深度范围 [0, w]
+        static Frustum FromViewProjection(const Matrix4x4& view_projection);
+
+        // 保守测试：返回 false 时一定在视锥外，返回 true 时可能与视锥相交
+        Bool IntersectsBox(const BoundingBox& box) const;
+        Bool IntersectsSphere(const BoundingSphere& sphere) const;
+        // 区分完全在内与跨越平面，层次结构遍历时完全在内的子树不再逐个测试
+        ContainmentType ClassifyBox(const BoundingBox& box) const;
+    };
+}
+
+#endif // DOLAS_BOUNDS_H
@@ -0,0 +1,77 @@
+#ifndef DOLAS_CASCADED_SHADOW_H
+#define DOLAS_CASCADED_SHADOW_H
+
+#include "dolas_base.h"
+#include "dolas_bounds.h"
+#include "dolas_frustum_culling.h"
+
+namespace Dolas
+{
+    constexpr UInt kMaxShadowCascadeCount = 4;
+
+    // 方向光的级联阴影。所有 cascade 放在同一张深度图集中，按 2 列排布
+    struct CascadeShadowDesc
+    {
+        UInt cascade_count = 4;           // 不超过 kMaxShadowCascadeCount
+        UInt resolution = 2048;           // 每个 cascade 的边长（texel）
+        Float max_distance = 150.0f;      // 阴影覆盖的最远视空间深度，超过相机远平面时取远平面
+        Float split_lambda = 0.8f;        // 0 为均匀划分，1 为对数划分
+
+        UInt GetAtlasWidth() const { return resolution * (cascade_count > 1 ? 2 : 1); }
+        UInt GetAtlasHeight() const { return resolution * ((cascade_count + 1) / 2); }
+        // cascade 在图集中左上角的 texel 坐标
+        void GetCascadeAtlasOffset(UInt cascade_index, UInt& out_x, UInt& out_y) const
+        {
+            out_x = (cascade_index % 2) * resolution;
+            out_y = (cascade_index / 2) * resolution;
+        }
+    };
+
+    // 透视相机：视空间右手系、看向 -Z，深度 = -view_z
+    struct CascadeShadowView
+    {
+        Matrix4x4 view;
+        Float projection_scale_x = 1.0f;   // 投影矩阵 [0][0]
+        Float projection_scale_y = 1.0f;   // 投影矩阵 [1][1]
+        Float near_plane = 0.1f;
+        Float far_plane = 1000.0f;
+    };
+
+    struct ShadowCascade
+    {
+        Float split_near = 0.0f;           // 覆盖的视空间深度区间
+        Float split_far = 0.0f;
+        BoundingSphere bounding_sphere;    // 世界空间，包含整段视锥切片
+        Float texel_size = 0.0f;           // 一个阴影 texel 的世界空间边长
+        Matrix4x4 light_view;              // 世界 -> 光源空间（只有旋转，不随相机变化）
+        Matrix4x4 projection;              // 正交投影，深度 0 最靠近光源
+        Matrix4x4 view_projection;
+        Frustum frustum;                   // view_projection 的六个平面，用于剔除投射体
+    };
+
+    // 实用划分（practical split scheme）：对数划分与均匀划分按 lambda 混合。
+    // out_splits 写入 cascade_count + 1 个深度，首尾分别为 near_plane 与 far_plane
+    void ComputeCascadeSplits(Float near_plane, Float far_plane, UInt cascade_count, Float lambda, Float* out_splits);
+
+    // 视锥切片 [split_near, split_far] 的最小包围球（世界空间）。半径只取决于切片形状，
+    // 相机平移 / 旋转时保持不变，并向上取整到 1/16 单位以消除浮点抖动
+    BoundingSphere ComputeCascadeBoundingSphere(const CascadeShadowView& view, Float split_near, Float split_far);
+
+    // light_direction 为光线传播方向（与 per-frame 常量中的 g_LightDirectionIntensity.xyz 一致）。
+    // 光源空间与相机一样看向 -Z
+    Matrix4x4 MakeShadowLightView(const Vector3& light_direction);
+
+    // 稳定的 cascade 拟合：正交投影以包围球为边界，球心在光源空间的 x / y 对齐到整数 texel，
+    // 相机移动时阴影图只做整 texel 的平移，边缘不闪烁。caster_bounds 有效时近平面向光源方向延伸到
+    // 包含所有投射体，使切片外、挡在光源与切片之间的物体仍然投射阴影
+    ShadowCascade FitShadowCascade(const BoundingSphere& sphere, const Vector3& light_direction, UInt resolution, const BoundingBox& caster_bounds);
+
+    // 划分 + 逐个 cascade 拟合，out_cascades 至少 desc.cascade_count 个
+    void ComputeShadowCascades(const CascadeShadowDesc& desc, const CascadeShadowView& view, const Vector3& light_direction,
+        const BoundingBox& caster_bounds, ShadowCascade* out_cascades);
+
+    // 用 cascade 的正交视锥剔除 [begin, end) 范围内的投射体，语义与 FrustumCullBoxes 相同，可分块并行
+    UInt CullShadowCasters(const ShadowCascade& cascade, const CullingBoundsSoA& bounds, UInt begin, UInt end, UByte* out_visibility);
+}
+
+#endif // DOLAS_CASCADED_SHADOW_H
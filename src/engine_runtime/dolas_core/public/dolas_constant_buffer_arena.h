@@ -0,0 +1,67 @@
+#ifndef DOLAS_CONSTANT_BUFFER_ARENA_H
+#define DOLAS_CONSTANT_BUFFER_ARENA_H
+
+#include <cstddef>
+#include <vector>
+#include "dolas_base.h"
+#include "dolas_constant_buffer_layout.h"
+
+namespace Dolas
+{
+    // arena 中的字节区间 [begin, end)
+    struct ConstantBufferRange
+    {
+        UInt begin = 0;
+        UInt end = 0;
+
+        Bool operator==(const ConstantBufferRange& other) const = default;
+    };
+
+    // 多个常量块（例如每个材质的 GlobalConstants）连续存放在同一段内存中，GPU 端对应一个大缓冲区，
+    // 绑定时只需要 "基地址 + 块偏移"。每块单独记录脏区间，上传时只拷贝改动过的字节
+    class ConstantBufferArena
+    {
+    public:
+        // D3D12 的 CBV 地址必须 256 字节对齐
+        static constexpr UInt BLOCK_ALIGNMENT = 256;
+        static constexpr UInt INVALID_BLOCK = 0xFFFFFFFFu;
+
+        // 新块清零并整块标记为脏；size 为 0 时返回 INVALID_BLOCK
+        UInt Allocate(UInt size);
+        void Clear();
+
+        // 写入不超过 handle.size 的字节（handle 的 offset 相对于块起始），内容没有变化时不标记；返回是否有字节被改动
+        Bool Write(UInt block, ConstantBufferVariableHandle handle, const void* data, std::size_t size);
+
+        Bool IsValidBlock(UInt block) const { return block < m_blocks.size(); }
+        UInt GetBlockOffset(UInt block) const { return IsValidBlock(block) ? m_blocks[block].offset : 0; }
+        UInt GetBlockSize(UInt block) const { return IsValidBlock(block) ? m_blocks[block].size : 0; }
+        const UByte* GetBlockData(UInt block) const { return IsValidBlock(block) ? m_bytes.data() + m_blocks[block].offset : nullptr; }
+        UInt GetBlockCount() const { return static_cast<UInt>(m_blocks.size()); }
+
+        // 所有块占用的字节数（含对齐填充），GPU 缓冲区至少需要这么大
+        UInt GetSize() const { return static_cast<UInt>(m_bytes.size()); }
+        const std::vector<UByte>& GetBytes() const { return m_bytes; }
+        Bool IsDirty() const { return !m_dirty_blocks.empty(); }
+
+        // 取出所有脏区间（arena 内的绝对偏移，按 begin 排序，相邻或重叠的区间合并）并清除脏标记
+        void TakeDirtyRanges(std::vector<ConstantBufferRange>& out_ranges);
+
+    private:
+        struct Block
+        {
+            UInt offset = 0;
+            UInt size = 0;
+            UInt dirty_begin = 0;
+            UInt dirty_end = 0;
+        };
+
+        void MarkDirty(UInt block, UInt begin, UInt end);
+
+        std::vector<UByte> m_bytes;
+        std::vector<Block> m_blocks;
+        std::vector<UInt> m_dirty_blocks;
+    };
+}
+
+#endif // DOLAS_CONSTANT_BUFFER_ARENA_H
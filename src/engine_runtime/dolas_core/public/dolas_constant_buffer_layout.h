@@ -0,0 +1,66 @@
+#ifndef DOLAS_CONSTANT_BUFFER_LAYOUT_H
+#define DOLAS_CONSTANT_BUFFER_LAYOUT_H
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "dolas_base.h"
+#include "dolas_hash.h"
+#include "dolas_shader_reflection.h"
+
+namespace Dolas
+{
+    // cbuffer 中一个变量的位置，由 ConstantBufferLayout::FindVariable 解析一次后反复使用
+    struct ConstantBufferVariableHandle
+    {
+        UInt offset = 0;
+        UInt size = 0;
+
+        Bool IsValid() const { return size != 0; }
+    };
+
+    // 由反射建立的 cbuffer 布局：变量名的 STRING_ID -> (offset, size)。
+    // 每帧写入的变量应提前解析成 handle，避免每次按名字查找
+    class ConstantBufferLayout
+    {
+    public:
+        // 名字哈希冲突时保留先出现的变量并返回 false
+        Bool Build(const ConstantBufferInfo& info);
+        void Clear();
+
+        ConstantBufferVariableHandle FindVariable(UInt name_id) const;
+        ConstantBufferVariableHandle FindVariable(const std::string& name) const { return FindVariable(HashConverter::StringHash(name)); }
+        UInt GetSize() const { return m_size; }
+        UInt GetVariableCount() const { return static_cast<UInt>(m_variables.size()); }
+
+    private:
+        std::unordered_map<UInt, ConstantBufferVariableHandle> m_variables;
+        UInt m_size = 0;
+    };
+
+    // cbuffer 的 CPU 端数据，记录自上次上传以来改动过的字节区间 [dirty_begin, dirty_end)
+    class ConstantBufferData
+    {
+    public:
+        // 清零并把整块标记为脏（GPU 端还没有任何数据）
+        void Resize(UInt size);
+
+        // 写入不超过 handle.size 的字节，内容没有变化时不标记；返回是否有字节被改动
+        Bool Write(ConstantBufferVariableHandle handle, const void* data, std::size_t size);
+
+        const std::vector<UByte>& GetBytes() const { return m_bytes; }
+        Bool IsEmpty() const { return m_bytes.empty(); }
+        Bool IsDirty() const { return m_dirty_end > m_dirty_begin; }
+        UInt GetDirtyBegin() const { return m_dirty_begin; }
+        UInt GetDirtyEnd() const { return m_dirty_end; }
+        void ClearDirty() { m_dirty_begin = 0; m_dirty_end = 0; }
+
+    private:
+        std::vector<UByte> m_bytes;
+        UInt m_dirty_begin = 0;
+        UInt m_dirty_end = 0;
+    };
+}
+
+#endif // DOLAS_CONSTANT_BUFFER_LAYOUT_H
@@ -0,0 +1,63 @@
+#ifndef DOLAS_CUBEMAP_H
+#define DOLAS_CUBEMAP_H
+
+#include <vector>
+#include "dolas_base.h"
+#include "dolas_texture_cook.h"
+
+namespace Dolas
+{
+    // 与 D3D 立方体纹理数组切片的顺序一致
+    enum class CubeFace : UInt
+    {
+        PositiveX = 0,
+        NegativeX,
+        PositiveY,
+        NegativeY,
+        PositiveZ,
+        NegativeZ,
+    };
+
+    static constexpr UInt CUBE_FACE_COUNT = 6;
+
+    struct Cubemap
+    {
+        UInt face_size = 0;
+        UInt mip_count = 0;
+        std::vector<TextureImage> faces;    // 按面主序：faces[face * mip_count + mip]，与 DDS 中子资源的顺序一致
+
+        TextureImage& GetFace(UInt face, UInt mip) { return faces[face * mip_count + mip]; }
+        const TextureImage& GetFace(UInt face, UInt mip) const { return faces[face * mip_count + mip]; }
+    };
+
+    // s, t 为面上的坐标（[-1, 1]，t 向下），返回单位方向；采样时硬件按相同的约定选择面与纹素
+    void ComputeCubemapDirection(UInt face, Float s, Float t, Float out_direction[3]);
+    // 纹素 (x, y) 在单位球上张成的立体角，一个立方体所有纹素之和为 4π
+    Float ComputeCubemapTexelSolidAngle(UInt x, UInt y, UInt face_size);
+
+    // 等距柱状投影（equirect）：Z 轴向上，u 随 atan2(y, x) 增大，v = 0 为 +Z，与原来的球形天空盒 shader 一致
+    void ComputeEquirectUV(const Float direction[3], Float& out_u, Float& out_v);
+    // 双线性采样，u 方向环绕，v 方向 clamp
+    void SampleEquirect(const TextureImage& equirect, Float u, Float v, Float out_color[4]);
+
+    struct CubemapBuildSettings
+    {
+        UInt face_size = 0;         // 0 为 equirect 宽度的 1/4，向下取 2 的幂（纹素的角分辨率与赤道附近的源图相当）
+        UInt max_mip_count = 0;     // 0 为完整的 mip 链
+        UInt samples_per_axis = 2;  // mip 0 每个纹素在面内均匀取 n x n 个双线性样本，避免两极附近的源图欠采样
+    };
+
+    // 从 equirect 生成立方体一个面（已按 face_size Resize）的第 [row_begin, row_end) 行。
+    // 每个纹素只按自己的方向读取 equirect，六个面的各行之间没有依赖
+    void ConvertEquirectToCubemapRows(const TextureImage& equirect, UInt face, UInt samples_per_axis, UInt row_begin, UInt row_end, TextureImage& out_face);
+    // 由上一级 mip 生成 destination 的第 [row_begin, row_end) 行：2x2 纹素按立体角加权平均。
+    // 只读取同一个面上一级 mip 的 2x2 纹素，不跨越面的边界，所以每一级的各面各行可以同时生成
+    void DownsampleCubemapFaceRows(const TextureImage& source, UInt row_begin, UInt row_end, TextureImage& destination);
+
+    // 六个面的所有行一起交给 parallel_for，结果与分段方式无关
+    Bool BuildCubemapFromEquirect(const TextureImage& equirect, const CubemapBuildSettings& settings, Cubemap& out_cubemap, const TextureCookParallelFor& parallel_for = {});
+    // 逐面逐级压缩为 BC6H，out_texture.face_count 为 6，可直接用 SaveCookedTextureDDS 写成立方体 DDS
+    Bool CookCubemap(const Cubemap& cubemap, CookedTexture& out_texture, const TextureCookParallelFor& parallel_for = {});
+}
+
+#endif // DOLAS_CUBEMAP_H
@@ -0,0 +1,60 @@
+#ifndef DOLAS_DRAW_SORT_KEY_H
+#define DOLAS_DRAW_SORT_KEY_H
+
+#include <vector>
+#include "dolas_base.h"
+
+namespace Dolas
+{
+    // 64 位绘制排序键，从高位到低位依次为：
+    //   [63..60] pass      (4 bits)
+    //   [59..48] pipeline  (12 bits)
+    //   [47..32] material  (16 bits)
+    //   [31..16] mesh      (16 bits)
+    //   [15.. 0] depth     (16 bits)
+    // pipeline / material / mesh 期望传入每帧分配的紧凑索引（而不是 32 位哈希），
+    // 这样状态相同的 draw 排序后一定相邻；超出位宽的索引会被饱和到最大值。
+    class DrawSortKey
+    {
+    public:
+        static constexpr UInt PASS_BITS = 4;
+        static constexpr UInt PIPELINE_BITS = 12;
+        static constexpr UInt MATERIAL_BITS = 16;
+        static constexpr UInt MESH_BITS = 16;
+        static constexpr UInt DEPTH_BITS = 16;
+
+        static constexpr UInt DEPTH_SHIFT = 0;
+        static constexpr UInt MESH_SHIFT = DEPTH_SHIFT + DEPTH_BITS;
+        static constexpr UInt MATERIAL_SHIFT = MESH_SHIFT + MESH_BITS;
+        static constexpr UInt PIPELINE_SHIFT = MATERIAL_SHIFT + MATERIAL_BITS;
+        static constexpr UInt PASS_SHIFT = PIPELINE_SHIFT + PIPELINE_BITS;
+
+        static ULongLong Encode(UInt pass, UInt pipeline, UInt material, UInt mesh, UInt depth);
+        // 深度优先的布局，用于深度预通道这类只有一个材质的 pass：depth 占用 material 字段，
+        // mesh 紧随其后，depth 字段为 0。同一 pipeline 内严格由近及远，深度相同时再按 mesh 聚合
+        static ULongLong EncodeDepthFirst(UInt pass, UInt pipeline, UInt depth, UInt mesh);
+
+        static UInt GetPass(ULongLong key);
+        static UInt GetPipeline(ULongLong key);
+        static UInt GetMaterial(ULongLong key);
+        static UInt GetMesh(ULongLong key);
+        static UInt GetDepth(ULongLong key);
+
+        // 将视空间深度线性量化到 DEPTH_BITS 位
+        // front_to_back = true  : 近处的值更小（不透明物体由近及远，利于 early-z）
+        // front_to_back = false : 远处的值更小（半透明物体由远及近）
+        static UInt QuantizeDepth(Float view_depth, Float near_plane, Float far_plane, Bool front_to_back = true);
+    };
+
+    struct DrawSortEntry
+    {
+        ULongLong m_key = 0;
+        UInt m_index = 0; // 指向调用方 draw packet 数组的下标
+    };
+
+    // 对 entries 按 m_key 升序做 LSD 基数排序（每趟 8 bit，稳定排序）。
+    // 所有 key 在某个字节上都相同时直接跳过该趟；scratch 作为双缓冲复用，避免每帧分配。
+    void RadixSortDrawEntries(std::vector<DrawSortEntry>& entries, std::vector<DrawSortEntry>& scratch);
+}
+
+#endif // DOLAS_DRAW_SORT_KEY_H
@@ -0,0 +1,186 @@
+#ifndef DOLAS_DYNAMIC_AABB_TREE_H
+#define DOLAS_DYNAMIC_AABB_TREE_H
+
+#include <vector>
+#include "dolas_base.h"
+#include "dolas_bounds.h"
+
+namespace Dolas
+{
+    // 增量更新的动态 AABB 树（叶子为物体，内部节点为两个子节点的并集）。
+    // - Insert 按表面积代价（SAH）选择兄弟节点，向上回溯时做降低表面积的树旋转
+    // - 叶子保存外扩 fat_margin 的包围盒，小幅移动时 Refit 不需要改动树结构
+    // - 节点保存父指针，查询使用无栈遍历，不分配内存也没有递归深度限制
+    class DynamicAABBTree
+    {
+    public:
+        static constexpr Int NULL_NODE = -1;
+
+        explicit DynamicAABBTree(Float fat_margin = 0.1f);
+
+        void Clear();
+
+        // 返回 proxy id（即叶子节点下标），在 Remove 之前保持不变
+        Int Insert(const BoundingBox& box, ULongLong user_data);
+        void Remove(Int proxy_id);
+        // box 仍在叶子的外扩包围盒内时只返回 false；否则重新插入并返回 true
+        Bool Refit(Int proxy_id, const BoundingBox& box);
+
+        ULongLong GetUserData(Int proxy_id) const { return m_nodes[proxy_id].user_data; }
+        void SetUserData(Int proxy_id, ULongLong user_data) { m_nodes[proxy_id].user_data = user_data; }
+        const BoundingBox& GetFatBounds(Int proxy_id) const { return m_nodes[proxy_id].box; }
+
+        UInt GetProxyCount() const { return m_proxy_count; }
+        UInt GetNodeCount() const { return m_node_count; }
+        Int GetHeight() const { return m_root == NULL_NODE ? 0 : m_nodes[m_root].height; }
+        // 所有节点表面积之和 / 根节点表面积，越小说明树质量越好
+        Float GetAreaRatio() const;
+        // 检查父子链接、高度、包围盒包含关系与计数，供测试使用
+        Bool Validate() const;
+
+        // callback(Int proxy_id) -> Bool，返回 false 时提前结束查询
+        template<typename Callback>
+        void QueryBox(const BoundingBox& box, Callback&& callback) const;
+        // 保守测试：跨越视锥边界的叶子也会返回；完全在视锥内的子树不再逐个测试
+        template<typename Callback>
+        void QueryFrustum(const Frustum& frustum, Callback&& callback) const;
+        // callback(Int proxy_id, Float max_distance) -> Float，返回新的最大距离：
+        // 原样返回表示继续，返回更小的命中距离会裁剪射线，返回 0 结束查询
+        template<typename Callback>
+        void RayCast(const Vector3& origin, const Vector3& direction, Float max_distance, Callback&& callback) const;
+
+    private:
+        struct TreeNode
+        {
+            BoundingBox box;
+            ULongLong user_data = 0;
+            Int parent = NULL_NODE; // 空闲节点复用为 free list 的 next
+            Int child1 = NULL_NODE;
+            Int child2 = NULL_NODE;
+            Int height = -1;        // 叶子为 0，空闲节点为 -1
+
+            Bool IsLeaf() const { return child1 == NULL_NODE; }
+        };
+
+        Int AllocateNode();
+        void FreeNode(Int node_index);
+        void InsertLeaf(Int leaf);
+        void RemoveLeaf(Int leaf);
+        // 从 node_index 向上重算包围盒与高度，并对每个祖先尝试旋转
+        void RefitAncestors(Int node_index);
+        void Rotate(Int node_index);
+        void UpdateNode(Int node_index);
+        Int ValidateSubtree(Int node_index, UInt& out_leaf_count) const;
+
+        // classify(const BoundingBox&) -> ContainmentType，visit(Int leaf) -> Bool。
+        // 利用父指针无栈遍历：从父节点下降时测试，从 child1 回来时转向 child2，从 child2 回来时继续上升
+        template<typename Classify, typename Visit>
+        void Traverse(Classify&& classify, Visit&& visit) const;
+
+        std::vector<TreeNode> m_nodes;
+        Int m_root = NULL_NODE;
+        Int m_free_list = NULL_NODE;
+        UInt m_node_count = 0;
+        UInt m_proxy_count = 0;
+        Float m_fat_margin = 0.1f;
+    };
+
+    template<typename Classify, typename Visit>
+    void DynamicAABBTree::Traverse(Classify&& classify, Visit&& visit) const
+    {
+        Int node_index = m_root;
+        Int previous_index = NULL_NODE;
+        Int contained_root = NULL_NODE; // 完全被查询包含的子树根，子树内的节点跳过测试
+        while (node_index != NULL_NODE)
+        {
+            const TreeNode& node = m_nodes[node_index];
+            Int next_index = node.parent;
+            if (previous_index == node.parent)
+            {
+                Bool enter = true;
+                if (contained_root == NULL_NODE)
+                {
+                    const ContainmentType containment = classify(node.box);
+                    if (containment == ContainmentType::Disjoint)
+                    {
+                        enter = false;
+                    }
+                    else if (containment == ContainmentType::Contains)
+                    {
+                        contained_root = node_index;
+                    }
+                }
+
+                if (enter)
+                {
+                    if (node.IsLeaf())
+                    {
+                        if (!visit(node_index))
+                        {
+                            return;
+                        }
+                    }
+                    else
+                    {
+                        next_index = node.child1;
+                    }
+                }
+            }
+            else if (previous_index == node.child1)
+            {
+                next_index = node.child2;
+            }
+
+            if (next_index == node.parent && contained_root == node_index)
+            {
+                contained_root = NULL_NODE;
+            }
+            previous_index = node_index;
+            node_index = next_index;
+        }
+    }
+
+    template<typename Callback>
+    void DynamicAABBTree::QueryBox(const BoundingBox& box, Callback&& callback) const
+    {
+        Traverse(
+            [&box](const BoundingBox& node_box)
+            {
+                if (!box.Intersects(node_box))
+                {
+                    return ContainmentType::Disjoint;
+                }
+                return box.Contains(node_box) ? ContainmentType::Contains : ContainmentType::Intersects;
+            },
+            callback);
+    }
+
+    template<typename Callback>
+    void DynamicAABBTree::QueryFrustum(const Frustum& frustum, Callback&& callback) const
+    {
+        Traverse(
+            [&frustum](const BoundingBox& node_box)
+            {
+                return frustum.ClassifyBox(node_box);
+            },
+            callback);
+    }
+
+    template<typename Callback>
+    void DynamicAABBTree::RayCast(const Vector3& origin, const Vector3& direction, Float max_distance, Callback&& callback) const
+    {
+        Traverse(
+            [&origin, &direction, &max_distance](const BoundingBox& node_box)
+            {
+                Float distance = 0.0f;
+                return node_box.IntersectsRay(origin, direction, max_distance, distance) ? ContainmentType::Intersects : ContainmentType::Disjoint;
+            },
+            [&callback, &max_distance](Int proxy_id)
+            {
+                max_distance = callback(proxy_id, max_distance);
+                return max_distance > 0.0f;
+            });
+    }
+}
+
+#endif // DOLAS_DYNAMIC_AABB_TREE_H
@@ -0,0 +1,55 @@
+#ifndef DOLAS_FRUSTUM_CULLING_H
+#define DOLAS_FRUSTUM_CULLING_H
+
+#include <vector>
+#include "dolas_base.h"
+#include "dolas_bounds.h"
+
+namespace Dolas
+{
+    // 以 SoA（中心 + 半长，各分量独立数组）保存的世界空间包围盒，SIMD 一次读取相邻的 4/8 个包围盒。
+    // 无效（空）包围盒以负的极大半长保存，测试结果总是不可见
+    class CullingBoundsSoA
+    {
+    public:
+        void Clear();
+        void Reserve(UInt count);
+        UInt Add(const BoundingBox& box);
+        void Set(UInt index, const BoundingBox& box);
+        UInt GetCount() const { return m_count; }
+
+        const Float* GetCenterX() const { return m_center_x.data(); }
+        const Float* GetCenterY() const { return m_center_y.data(); }
+        const Float* GetCenterZ() const { return m_center_z.data(); }
+        const Float* GetExtentX() const { return m_extent_x.data(); }
+        const Float* GetExtentY() const { return m_extent_y.data(); }
+        const Float* GetExtentZ() const { return m_extent_z.data(); }
+
+    private:
+        std::vector<Float> m_center_x;
+        std::vector<Float> m_center_y;
+        std::vector<Float> m_center_z;
+        std::vector<Float> m_extent_x;
+        std::vector<Float> m_extent_y;
+        std::vector<Float> m_extent_z;
+        UInt m_count = 0;
+    };
+
+    enum class FrustumCullingPath : UInt
+    {
+        Scalar = 0,
+        SSE,  // 4 路
+        AVX,  // 8 路
+    };
+
+    // 编译期可用的最宽路径（MSVC /arch:AVX 或 -mavx 时为 AVX，x64 默认为 SSE）
+    FrustumCullingPath GetFrustumCullingPath();
+
+    // 测试 [begin, end) 范围内的包围盒，out_visibility[i] 写入 1（可见）或 0（剔除），返回可见数量。
+    // 不同范围之间没有共享状态，可以分块在多个线程上并行调用
+    UInt FrustumCullBoxes(const Frustum& frustum, const CullingBoundsSoA& bounds, UInt begin, UInt end, UByte* out_visibility);
+    // 不使用 SIMD 的逐个测试，结果与 FrustumCullBoxes 逐位一致，用于验证与性能对比
+    UInt FrustumCullBoxesScalar(const Frustum& frustum, const CullingBoundsSoA& bounds, UInt begin, UInt end, UByte* out_visibility);
+}
+
+#endif // DOLAS_FRUSTUM_CULLING_H
@@ -0,0 +1,65 @@
+#ifndef DOLAS_GBUFFER_PACKING_H
+#define DOLAS_GBUFFER_PACKING_H
+
+#include <algorithm>
+#include <cmath>
+
+// GBuffer 打包函数与着色器共用同一份源码（content/shader/gbuffer_packing.hlsli），
+// 这里提供它用到的 HLSL 类型和内建函数的最小 C++ 实现，保证 CPU 侧测试的就是 GPU 上运行的代码
+namespace Dolas
+{
+    namespace GBufferPacking
+    {
+        struct float2
+        {
+            float x = 0.0f;
+            float y = 0.0f;
+
+            float2() = default;
+            float2(float in_x, float in_y) : x(in_x), y(in_y) {}
+        };
+
+        struct float3
+        {
+            float x = 0.0f;
+            float y = 0.0f;
+            float z = 0.0f;
+
+            float3() = default;
+            float3(float in_x, float in_y, float in_z) : x(in_x), y(in_y), z(in_z) {}
+        };
+
+        struct float4
+        {
+            float x = 0.0f;
+            float y = 0.0f;
+            float z = 0.0f;
+            float w = 0.0f;
+
+            float4() = default;
+            float4(float in_x, float in_y, float in_z, float in_w) : x(in_x), y(in_y), z(in_z), w(in_w) {}
+        };
+
+        using std::abs;
+        using std::floor;
+        using std::log2;
+        using std::exp2;
+
+        inline float saturate(float value) { return std::clamp(value, 0.0f, 1.0f); }
+        inline int clamp(int value, int min_value, int max_value) { return std::clamp(value, min_value, max_value); }
+        inline int min(int a, int b) { return std::min(a, b); }
+        inline int max(int a, int b) { return std::max(a, b); }
+        inline float min(float a, float b) { return std::min(a, b); }
+        inline float max(float a, float b) { return std::max(a, b); }
+        inline float dot(const float3& a, const float3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+        inline float3 normalize(const float3& v)
+        {
+            float inv_length = 1.0f / std::sqrt(dot(v, v));
+            return float3(v.x * inv_length, v.y * inv_length, v.z * inv_length);
+        }
+
+#include "gbuffer_packing.hlsli"
+    }
+}
+
+#endif // DOLAS_GBUFFER_PACKING_H
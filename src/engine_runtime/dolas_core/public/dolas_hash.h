@@ -1,6 +1,7 @@
 #ifndef DOLAS_HASH_H
 #define DOLAS_HASH_H
 
+#include <cstddef>
 #include <string>
 #include <unordered_map>
 #include "dolas_base.h"
@@ -14,6 +15,9 @@ namespace Dolas
     {
     public:
         static UInt StringHash(const std::string& str);
+        /// 64-bit FNV-1a over raw bytes, for content keys (shader bytecode, cached pipeline state).
+        /// Pass a previous result as seed to chain several buffers into one key.
+        static ULongLong BytesHash64(const void* data, std::size_t size, ULongLong seed = 14695981039346656037ULL);
         static std::string GetString(UInt hash);
         static Bool HasString(UInt hash);
         static void ClearRegistry();
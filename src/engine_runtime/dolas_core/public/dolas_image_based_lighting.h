@@ -0,0 +1,91 @@
+#ifndef DOLAS_IMAGE_BASED_LIGHTING_H
+#define DOLAS_IMAGE_BASED_LIGHTING_H
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+#include "dolas_base.h"
+#include "dolas_cubemap.h"
+#include "dolas_texture_cook.h"
+
+namespace Dolas
+{
+    static constexpr UInt SH_L2_COEFFICIENT_COUNT = 9;
+
+    // 实数球谐（l <= 2）的 RGB 系数，顺序为 (l, m) = (0,0), (1,-1), (1,0), (1,1), (2,-2), (2,-1), (2,0), (2,1), (2,2)
+    struct SphericalHarmonicsL2
+    {
+        Float coefficients[SH_L2_COEFFICIENT_COUNT][3] = {};
+    };
+
+    // 单位方向上的 9 个正交归一基函数值
+    void EvaluateSHBasisL2(const Float direction[3], Float out_basis[SH_L2_COEFFICIENT_COUNT]);
+    // sum(c_i * Y_i(direction))
+    void EvaluateSHL2(const SphericalHarmonicsL2& sh, const Float direction[3], Float out_color[3]);
+
+    // 把立方体的一级 mip 投影到球谐上：c_i = ∫ L(ω) Y_i(ω) dω，用纹素的立体角做数值积分。
+    // 按行分段交给 parallel_for，每行单独求和后按固定顺序合并，结果与分段方式无关
+    Bool ProjectCubemapToSH(const Cubemap& cubemap, UInt mip, SphericalHarmonicsL2& out_sh, const TextureCookParallelFor& parallel_for = {});
+    // 与余弦瓣卷积（各阶乘以 π, 2π/3, π/4），辐射度 L 的系数变成辐照度 E(n) = ∫ L(ω) max(n·ω, 0) dω 的系数
+    SphericalHarmonicsL2 ConvolveSHWithCosineLobe(const SphericalHarmonicsL2& radiance);
+
+    // shader 侧 float4 g_SkyIrradianceSH[9] 的内容：基函数常数与 Lambert 的 1/π 预先乘入，
+    // shader 只需计算 c0 + c1 y + c2 z + c3 x + c4 xy + c5 yz + c6 (3z² - 1) + c7 xz + c8 (x² - y²)，得到白色漫反射表面的出射辐射度
+    void PackIrradianceSHForShader(const SphericalHarmonicsL2& irradiance, Float out_constants[SH_L2_COEFFICIENT_COUNT][4]);
+
+    // 第 index 个 Hammersley 点的第二维（以 2 为底的 radical inverse）
+    Float ComputeHammersleySequence(UInt index);
+
+    struct ImageBasedLightingSettings
+    {
+        UInt source_face_size = 512;        // 预积分使用的源立方体面大小（向下取 2 的幂）
+        UInt irradiance_face_size = 32;     // 投影球谐时使用的源 mip 的上限：L2 只有最低频的信息，降采样是按立体角加权的，积分不变
+        UInt specular_face_size = 256;      // 预过滤高光立方体 mip 0 的面大小，不超过源立方体
+        UInt specular_mip_count = 6;        // mip i 的粗糙度为 i / (mip_count - 1)
+        UInt specular_sample_count = 128;   // 每个纹素的 GGX 重要性采样数
+        UInt brdf_lut_size = 64;
+        UInt brdf_lut_sample_count = 512;
+    };
+
+    enum class ImageBasedLightingPath : UInt
+    {
+        Scalar = 0,
+        SSE,
+    };
+
+    // 编译时选择的积分路径；SSE 每次处理一个 RGBA 纹素或 4 个样本，与标量路径的运算顺序相同，结果逐位一致
+    ImageBasedLightingPath GetImageBasedLightingPath();
+
+    // GGX 预过滤的高光立方体（split sum 的第一项），mip i 对应粗糙度 i / (mip_count - 1)。
+    // mip 0（粗糙度 0）直接复制源立方体中同样大小的一级；其余各级使用 NoL 加权的重要性采样，
+    // 按样本的 pdf 选择源 mip（filtered importance sampling），样本序列固定，结果与分段方式无关
+    Bool PrefilterSpecularCubemap(const Cubemap& source, const ImageBasedLightingSettings& settings, Cubemap& out_specular, const TextureCookParallelFor& parallel_for = {});
+
+    // split sum 的第二项：F0 * x + y = ∫ f(l, v) NoL dl（Schlick 菲涅尔、GGX、Smith-Schlick k = α / 2）。
+    // 结果写入 out_lut 的 RG，横轴为 NoV，纵轴为粗糙度（纹素中心采样）
+    void ComputeBRDFIntegration(Float NoV, Float roughness, UInt sample_count, Float& out_scale, Float& out_bias);
+    Bool BuildBRDFLUT(UInt size, UInt sample_count, TextureImage& out_lut, const TextureCookParallelFor& parallel_for = {});
+    // BC5 单级 DDS，运行时以 UNORM 采样
+    Bool CookBRDFLUT(const TextureImage& lut, CookedTexture& out_texture);
+
+    struct ImageBasedLighting
+    {
+        SphericalHarmonicsL2 irradiance;    // 已与余弦瓣卷积
+        Cubemap specular;
+    };
+
+    // 从 equirect 天空生成辐照度球谐与预过滤高光立方体（BRDF LUT 与天空无关，单独生成）
+    Bool PrecomputeImageBasedLighting(const TextureImage& equirect, const ImageBasedLightingSettings& settings, ImageBasedLighting& out_lighting, const TextureCookParallelFor& parallel_for = {});
+
+    // 缓存文件名的键：源文件内容的哈希与所有影响结果的设置，算法改变时修改其中的版本号
+    ULongLong ComputeImageBasedLightingCacheKey(ULongLong source_hash, const ImageBasedLightingSettings& settings);
+    ULongLong ComputeBRDFLUTCacheKey(const ImageBasedLightingSettings& settings);
+
+    // 球谐缓存文件："DSH2"、版本号与 27 个 Float
+    std::vector<UByte> BuildSphericalHarmonicsFile(const SphericalHarmonicsL2& sh);
+    Bool ParseSphericalHarmonicsFile(const UByte* data, std::size_t size, SphericalHarmonicsL2& out_sh);
+    Bool SaveSphericalHarmonicsFile(const SphericalHarmonicsL2& sh, const std::filesystem::path& file_path);
+    Bool LoadSphericalHarmonicsFile(const std::filesystem::path& file_path, SphericalHarmonicsL2& out_sh);
+}
+
+#endif // DOLAS_IMAGE_BASED_LIGHTING_H
@@ -0,0 +1,142 @@
+#ifndef DOLAS_LIGHT_CLUSTERING_H
+#define DOLAS_LIGHT_CLUSTERING_H
+
+#include <vector>
+#include "dolas_base.h"
+#include "dolas_bounds.h"
+
+namespace Dolas
+{
+    enum LocalLightType : UInt
+    {
+        LocalLightType_Point = 0,
+        LocalLightType_Spot,
+        LocalLightType_COUNT,
+    };
+
+    // 有作用范围的局部光源（点光 / 聚光），方向光仍由 per-frame 常量提供
+    struct LocalLight
+    {
+        LocalLightType type = LocalLightType_Point;
+        Vector3 position = Vector3::ZERO;
+        Float range = 1.0f;                      // 衰减到 0 的距离
+        Vector3 direction = Vector3::UNIT_Z_NEGATIVE; // 聚光朝向，单位向量
+        Vector3 color = Vector3(1.0f, 1.0f, 1.0f);
+        Float intensity = 1.0f;
+        Float spot_inner_cos = 0.9f;             // 内锥角余弦，之内不衰减
+        Float spot_outer_cos = 0.8f;             // 外锥角余弦，之外没有光照
+
+        // 光照范围的包围球：点光为以 position 为中心、range 为半径的球，聚光为圆锥的最小包围球
+        BoundingSphere GetBoundingSphere() const;
+    };
+
+    // 视锥被划分为 tiles_x * tiles_y 个屏幕 tile，深度方向按指数间隔切成 slice_count 片（froxel）。
+    // cluster 下标 = (slice * tiles_y + row) * tiles_x + column，row 0 为屏幕顶部
+    struct LightClusterGridDesc
+    {
+        UInt tiles_x = 16;
+        UInt tiles_y = 9;
+        UInt slice_count = 24;
+
+        UInt GetClusterCount() const { return tiles_x * tiles_y * slice_count; }
+    };
+
+    // 透视相机：视空间右手系、看向 -Z，深度 = -view_z
+    struct LightClusterView
+    {
+        Matrix4x4 view;
+        Float projection_scale_x = 1.0f;   // 投影矩阵 [0][0]，ndc_x = projection_scale_x * view_x / depth
+        Float projection_scale_y = 1.0f;   // 投影矩阵 [1][1]
+        Float near_plane = 0.1f;
+        Float far_plane = 1000.0f;
+    };
+
+    // 每个 cluster 在紧凑光源索引表中的区间，直接作为 StructuredBuffer<uint2> 上传
+    struct LightClusterRange
+    {
+        UInt offset = 0;
+        UInt count = 0;
+    };
+
+    // 一段光源的分配结果：(cluster, light) 对按光源顺序排列
+    struct LightClusterChunk
+    {
+        std::vector<UInt> cluster_indices;
+        std::vector<UInt> light_indices;
+
+        void Clear() { cluster_indices.clear(); light_indices.clear(); }
+    };
+
+    enum class LightClusteringPath : UInt
+    {
+        Scalar = 0,
+        SSE,  // 4 路
+        AVX,  // 8 路
+    };
+
+    // 编译期可用的最宽路径，规则与 GetFrustumCullingPath 相同
+    LightClusteringPath GetLightClusteringPath();
+
+    // CPU 侧的 clustered 光源分配。
+    // 使用流程：Setup（相机变化时预计算每个 slice 的 froxel 边界）-> PrepareLights（光源包围球变换到视空间）
+    // -> AssignLights（按光源分块，块之间没有共享状态，可并行）-> BuildLightLists（按块顺序合并为每个 cluster 的光源表）。
+    // froxel 用其视空间 AABB 近似，与包围球的最近距离在 x / y / z 上可分离，
+    // 因此每个 slice 只需为每列、每行各算一次距离，再以 SIMD 一次测试一行中的多个 tile
+    class LightClusterGrid
+    {
+    public:
+        void Setup(const LightClusterGridDesc& desc, const LightClusterView& view);
+        void PrepareLights(const LocalLight* lights, UInt light_count);
+
+        // 分配 [begin, end) 范围内的光源，结果追加到 out_chunk。返回追加的 (cluster, light) 对数量
+        UInt AssignLights(UInt begin, UInt end, LightClusterChunk& out_chunk) const;
+        // 不使用 SIMD、逐 froxel 测试的暴力实现，结果与 AssignLights 逐项一致，用于验证与性能对比
+        UInt AssignLightsBruteForce(UInt begin, UInt end, LightClusterChunk& out_chunk) const;
+
+        // chunks 须按光源顺序排列，合并后每个 cluster 内的光源下标递增
+        void BuildLightLists(const LightClusterChunk* chunks, UInt chunk_count, std::vector<LightClusterRange>& out_ranges, std::vector<UInt>& out_light_indices) const;
+
+        // 像素（以视口左上角为原点的归一化坐标）与视空间深度所在的 cluster，与着色器中的计算一致
+        UInt GetClusterIndex(Float screen_u, Float screen_v, Float depth) const;
+        UInt GetSliceIndex(Float depth) const;
+        Float GetSliceNearDepth(UInt slice) const { return m_slice_depths[slice]; }
+
+        const LightClusterGridDesc& GetDesc() const { return m_desc; }
+        UInt GetClusterCount() const { return m_desc.GetClusterCount(); }
+        UInt GetLightCount() const { return m_light_count; }
+        Float GetNearPlane() const { return m_near_plane; }
+        Float GetFarPlane() const { return m_far_plane; }
+        // slice = log2(depth / near) * GetSliceScale()
+        Float GetSliceScale() const { return m_slice_scale; }
+
+    private:
+        void GetLightSliceRange(UInt light_index, UInt& out_first_slice, UInt& out_last_slice) const;
+        Float GetDepthDistanceSquared(UInt light_index, UInt slice) const;
+        void ComputeTileDistances(UInt light_index, UInt slice, Float* out_column_distances, Float* out_row_distances) const;
+
+        LightClusterGridDesc m_desc;
+        Matrix4x4 m_view;
+        Float m_near_plane = 0.1f;
+        Float m_far_plane = 1000.0f;
+        Float m_slice_scale = 1.0f;
+
+        // slice_count + 1 个 slice 边界深度
+        std::vector<Float> m_slice_depths;
+        // 每个 slice 每一列 / 行 froxel 的视空间 AABB 范围，按 slice 连续存放，行宽补齐到 8 的倍数
+        std::vector<Float> m_column_min_x;
+        std::vector<Float> m_column_max_x;
+        std::vector<Float> m_row_min_y;
+        std::vector<Float> m_row_max_y;
+        UInt m_column_stride = 0;
+        UInt m_row_stride = 0;
+
+        // 视空间包围球（SoA），depth = -view_z
+        std::vector<Float> m_light_x;
+        std::vector<Float> m_light_y;
+        std::vector<Float> m_light_depth;
+        std::vector<Float> m_light_radius;
+        UInt m_light_count = 0;
+    };
+}
+
+#endif // DOLAS_LIGHT_CLUSTERING_H
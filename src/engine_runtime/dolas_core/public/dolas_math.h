@@ -282,6 +282,9 @@ namespace Dolas
         {
 
         }
+		// 世界矩阵 = 平移 * 旋转 * 缩放（列向量约定，与 PerObject 常量缓冲一致）
+		Matrix4x4 ToMatrix() const;
+
 		Vector3 m_postion;
 		Quaternion m_rotation; // 
 		Vector3 m_scale;
@@ -0,0 +1,54 @@
+#ifndef DOLAS_MESH_LOD_H
+#define DOLAS_MESH_LOD_H
+
+#include <vector>
+#include "dolas_base.h"
+#include "dolas_bounds.h"
+
+namespace Dolas
+{
+    // 一级 LOD：索引引用与 LOD0 相同的顶点，因此各级 LOD 共享顶点缓冲
+    struct MeshLOD
+    {
+        std::vector<UInt> indices;
+        Float error = 0.0f;       // 相对网格包围盒对角线的几何误差
+        Float screen_size = 0.0f; // 投影后包围球直径占屏幕高度的比例低于该值时切换到此 LOD
+    };
+
+    struct MeshLODChainSettings
+    {
+        UInt max_lod_count = 4;           // 不含 LOD0
+        Float reduction_ratio = 0.5f;     // 每一级的目标三角形数相对上一级的比例
+        Float max_error = 0.05f;          // 单级简化允许的最大相对误差
+        Float min_reduction = 0.9f;       // 简化后仍多于上一级的该比例时停止生成
+        Float first_screen_size = 0.5f;   // LOD1 的切换阈值，之后每级减半
+    };
+
+    // 二次误差（Garland-Heckbert）边折叠简化，只把顶点折叠到已有顶点上，不生成新顶点。
+    // 开放边界上的顶点与 UV / 法线接缝处的重复顶点被锁定，保证轮廓和属性不被撕裂。
+    // 返回实际达到的相对误差；out_indices 的三角形数不超过 target_index_count / 3，
+    // 误差先达到 target_error 时提前停止
+    Float SimplifyMesh(
+        const Float* positions, UInt vertex_count, UInt stride,
+        const std::vector<UInt>& indices,
+        UInt target_index_count, Float target_error,
+        std::vector<UInt>& out_indices);
+
+    // 逐级在上一级的结果上继续简化，返回 LOD1..N（LOD0 为原始索引）
+    std::vector<MeshLOD> GenerateMeshLODChain(
+        const Float* positions, UInt vertex_count, UInt stride,
+        const std::vector<UInt>& indices,
+        const MeshLODChainSettings& settings = MeshLODChainSettings());
+
+    // 包围球投影直径占屏幕高度的比例；projection_scale 为投影矩阵的 [1][1]（cot(fov_y / 2)）
+    Float ComputeScreenSize(const BoundingSphere& world_sphere, const Vector3& camera_position, Float projection_scale);
+
+    // 正交投影（如阴影 cascade）下的同一度量：与距离无关，只取决于视图半高 view_half_height
+    Float ComputeOrthographicScreenSize(const BoundingSphere& world_sphere, Float view_half_height);
+
+    // lod_screen_sizes[i] 为 LOD i 的切换阈值（忽略 [0]）。从 current_lod 出发，
+    // 变粗需要 screen_size 低于阈值 * (1 - hysteresis)，变细需要高于阈值 * (1 + hysteresis)，避免在阈值附近来回切换
+    UInt SelectMeshLOD(Float screen_size, const Float* lod_screen_sizes, UInt lod_count, UInt current_lod, Float hysteresis);
+}
+
+#endif // DOLAS_MESH_LOD_H
@@ -0,0 +1,77 @@
+#ifndef DOLAS_MESHLET_H
+#define DOLAS_MESHLET_H
+
+#include <vector>
+#include "dolas_base.h"
+#include "dolas_bounds.h"
+
+namespace Dolas
+{
+    // 与常见 mesh shader 实现一致的上限：64 个顶点，124 个三角形（124 * 3 字节的局部索引按 4 字节对齐）
+    constexpr UInt kMeshletMaxVertices = 64;
+    constexpr UInt kMeshletMaxTriangles = 124;
+
+    // 一个 meshlet（cluster）：顶点与三角形存放在 MeshletData 的共享数组中，这里只记录区间。
+    // 包围体与法线锥都在模型空间
+    struct Meshlet
+    {
+        UInt vertex_offset = 0;   // MeshletData::vertices 中的起始位置
+        UInt vertex_count = 0;
+        UInt triangle_offset = 0; // MeshletData::triangles 中的起始三角形
+        UInt triangle_count = 0;
+
+        BoundingSphere bounds;
+        // 法线锥：相机位于 apex 之后且 dot(normalize(apex - camera), axis) >= cutoff 时所有三角形都背向相机。
+        // 法线过于分散时 cutoff 大于 1，表示无法做背面剔除
+        Vector3 cone_apex = Vector3::ZERO;
+        Vector3 cone_axis = Vector3::ZERO;
+        Float cone_cutoff = 2.0f;
+
+        Bool HasValidCone() const { return cone_cutoff <= 1.0f; }
+    };
+
+    struct MeshletData
+    {
+        std::vector<Meshlet> meshlets;
+        std::vector<UInt> vertices;   // meshlet 局部顶点 -> 网格顶点
+        std::vector<UByte> triangles; // 每个三角形 3 个局部顶点下标
+
+        Bool IsEmpty() const { return meshlets.empty(); }
+        void Clear();
+        UInt GetTriangleCount() const { return static_cast<UInt>(triangles.size() / 3); }
+    };
+
+    // 贪心地从相邻三角形生长 meshlet：优先选择新增顶点最少、离当前 meshlet 中心最近的三角形，
+    // 保证 meshlet 在空间上紧凑、法线锥收敛。正面为逆时针（法线 cross(p1 - p0, p2 - p0)）。
+    // 结果只依赖输入，可以在离线烘焙时生成并序列化
+    Bool BuildMeshlets(
+        const Float* positions, UInt vertex_count, UInt stride,
+        const std::vector<UInt>& indices,
+        MeshletData& out_meshlets,
+        UInt max_vertices = kMeshletMaxVertices,
+        UInt max_triangles = kMeshletMaxTriangles);
+
+    // camera_position 为模型空间坐标（背面判断在仿射变换下不变，镜像变换除外）
+    Bool IsMeshletBackfacing(const Meshlet& meshlet, const Vector3& camera_position);
+
+    struct MeshletCullingResult
+    {
+        UInt visible_meshlet_count = 0;
+        UInt frustum_culled_count = 0;
+        UInt backface_culled_count = 0;
+        UInt index_count = 0;  // 追加到输出的索引数量
+    };
+
+    // CPU cluster 剔除：meshlet 包围球变换到世界空间做视锥测试，再用法线锥做背面测试，
+    // 可见 meshlet 的三角形展开为网格顶点索引追加到 out_indices。
+    // enable_backface 为 false 时（例如 world 含镜像或材质双面）只做视锥剔除
+    MeshletCullingResult CullMeshlets(
+        const MeshletData& meshlet_data,
+        const Matrix4x4& world,
+        const Frustum& world_frustum,
+        const Vector3& model_space_camera_position,
+        Bool enable_backface,
+        std::vector<UInt>& out_indices);
+}
+
+#endif // DOLAS_MESHLET_H
@@ -6,6 +6,7 @@
 #include <string>
 
 #include "dolas_asset_path.h"
+#include "dolas_base.h"
 
 namespace Dolas {
     class PathUtils
@@ -16,6 +17,18 @@ namespace Dolas {
         static std::string GetProjectContentDir();
         [[nodiscard]] static std::optional<std::filesystem::path> ResolveAssetPath(const AssetPath& asset_path);
         static std::string GetShadersSourceDir();
+        // 运行时生成的缓存（管线缓存等），可随时删除
+        static std::string GetEngineCacheDir();
+        // 离线 shader 编译器（ShaderCompiler --batch）的输出：bytecode、反射与 shader_manifest.txt
+        static std::string GetCompiledShadersDir();
+        // 离线纹理烘焙（TextureCooker）的输出：带完整 mip 链的块压缩 DDS
+        static std::string GetCookedTexturesDir();
+        // 纹理资产烘焙结果的路径：<cooked textures dir>/<规范逻辑路径>.dds
+        static std::filesystem::path GetCookedTexturePath(const AssetPath& asset_path);
+        // equirect 全景图转换成的立方体纹理：<cooked textures dir>/<规范逻辑路径>.cube.dds
+        static std::filesystem::path GetCookedCubemapPath(const AssetPath& asset_path);
+        // 天空光照的预积分结果（球谐、预过滤高光、BRDF LUT）：<cache dir>/ibl/<16 位十六进制的键>.<extension>
+        static std::filesystem::path GetImageBasedLightingCachePath(ULongLong cache_key, const std::string& extension);
 
 #if !defined(NDEBUG)
         static void SetEngineContentDirForDebug(const std::string& engine_content_dir);
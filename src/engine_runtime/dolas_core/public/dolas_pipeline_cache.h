@@ -0,0 +1,73 @@
+#ifndef DOLAS_PIPELINE_CACHE_H
+#define DOLAS_PIPELINE_CACHE_H
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "dolas_base.h"
+
+namespace Dolas
+{
+    // 重建一个图形管线状态（PSO）所需的全部信息。
+    // shader 以“文件路径 + 入口”记录，状态以 RHI 侧的枚举值 / DXGI 格式记录，
+    // 下次启动时材质加载到同一组 shader 就可以据此提前创建 PSO。
+    struct PipelineStateRecord
+    {
+        static constexpr UInt MAX_RENDER_TARGETS = 8;
+
+        std::string vertex_shader_path;
+        std::string vertex_entry_point;
+        std::string pixel_shader_path;
+        std::string pixel_entry_point;
+        UInt input_layout = 0;
+        UInt rasterizer_state = 0;
+        UInt depth_stencil_state = 0;
+        UInt blend_state = 0;
+        UInt primitive_topology = 0;
+        UInt render_target_count = 0;
+        UInt render_target_formats[MAX_RENDER_TARGETS] = {};
+        UInt depth_stencil_format = 0;
+
+        Bool operator==(const PipelineStateRecord& other) const;
+    };
+
+    // 只对固定功能状态做哈希（不含 shader 路径），用于和 bytecode 哈希组合成内容键
+    ULongLong HashPipelineStateRecordStates(const PipelineStateRecord& record);
+
+    // PSO 的内容键：vs/ps bytecode 的内容哈希 + 状态枚举 + RT/DS 格式。
+    // 与指针无关，重启后保持不变；shader 内容改变时键随之改变，旧的缓存条目自然失效。
+    ULongLong ComputePipelineStateKey(ULongLong vertex_bytecode_hash, ULongLong pixel_bytecode_hash, const PipelineStateRecord& record);
+
+    // 磁盘上的管线缓存文件：文件头 + PipelineStateRecord 列表 + 驱动的 pipeline library 二进制。
+    // device_identity 标识生成缓存的适配器/驱动，不匹配或数据校验失败时整个文件作废。
+    class PipelineCacheFile
+    {
+    public:
+        static constexpr UInt FILE_MAGIC = 0x4F535044; // "DPSO"
+        static constexpr UInt FILE_VERSION = 1;
+
+        Bool Load(const std::string& file_path, ULongLong device_identity);
+        Bool Save(const std::string& file_path, ULongLong device_identity) const;
+        void Clear();
+
+        // 重复的记录会被忽略，返回是否为新记录
+        Bool AddRecord(const PipelineStateRecord& record);
+        const std::vector<PipelineStateRecord>& GetRecords() const { return m_records; }
+        Bool IsDirty() const { return m_dirty; }
+        // Save 是 const 的（调用方可能保存一份拷贝），写入成功后由调用方清除脏标记
+        void MarkSaved() { m_dirty = false; }
+
+        const std::vector<UByte>& GetLibraryBlob() const { return m_library_blob; }
+        void SetLibraryBlob(std::vector<UByte>&& library_blob);
+
+    private:
+        static ULongLong HashRecord(const PipelineStateRecord& record);
+
+        std::vector<PipelineStateRecord> m_records;
+        std::unordered_set<ULongLong> m_record_hashes;
+        std::vector<UByte> m_library_blob;
+        Bool m_dirty = false;
+    };
+}
+
+#endif // DOLAS_PIPELINE_CACHE_H
@@ -0,0 +1,151 @@
+#ifndef DOLAS_RENDER_GRAPH_H
+#define DOLAS_RENDER_GRAPH_H
+
+#include <string>
+#include <vector>
+#include "dolas_base.h"
+
+namespace Dolas
+{
+    // 资源访问方式（位掩码）。写访问（RenderTarget / DepthWrite / CopyDest）只能单独出现，
+    // 只读访问可以组合，相邻的只读使用会合并成一个组合状态，避免在读与读之间插入屏障
+    enum RenderGraphAccess : UInt
+    {
+        RenderGraphAccess_None = 0,
+        RenderGraphAccess_RenderTarget = 1 << 0,
+        RenderGraphAccess_DepthWrite = 1 << 1,
+        RenderGraphAccess_DepthRead = 1 << 2,
+        RenderGraphAccess_PixelShaderResource = 1 << 3,
+        RenderGraphAccess_NonPixelShaderResource = 1 << 4,
+        RenderGraphAccess_CopySource = 1 << 5,
+        RenderGraphAccess_CopyDest = 1 << 6,
+        RenderGraphAccess_Present = 1 << 7,
+    };
+
+    constexpr UInt kRenderGraphWriteAccessMask = RenderGraphAccess_RenderTarget | RenderGraphAccess_DepthWrite | RenderGraphAccess_CopyDest;
+    constexpr UInt kRenderGraphReadAccessMask = RenderGraphAccess_DepthRead | RenderGraphAccess_PixelShaderResource | RenderGraphAccess_NonPixelShaderResource | RenderGraphAccess_CopySource;
+
+    typedef UInt RenderGraphResourceHandle;
+    typedef UInt RenderGraphPassHandle;
+    constexpr UInt kRenderGraphInvalidHandle = ~0u;
+
+    // 瞬态纹理的内存需求，由 RHI 查询（GetResourceAllocationInfo）后填入；图编译只关心大小与对齐
+    struct RenderGraphTextureDesc
+    {
+        ULongLong size = 0;
+        ULongLong alignment = 65536;
+    };
+
+    enum RenderGraphBarrierType : UInt
+    {
+        RenderGraphBarrierType_Transition = 0,
+        // 同一块堆内存换给另一个资源使用；resource_before 为之前占用这块内存的资源（无效句柄表示未知 / 任意）
+        RenderGraphBarrierType_Aliasing,
+    };
+
+    struct RenderGraphBarrier
+    {
+        RenderGraphBarrierType type = RenderGraphBarrierType_Transition;
+        RenderGraphResourceHandle resource = kRenderGraphInvalidHandle;
+        RenderGraphResourceHandle resource_before = kRenderGraphInvalidHandle;
+        UInt state_before = RenderGraphAccess_None;
+        UInt state_after = RenderGraphAccess_None;
+    };
+
+    struct RenderGraphCompiledPass
+    {
+        RenderGraphPassHandle pass = kRenderGraphInvalidHandle;
+        // 执行该 pass 之前一次性提交的屏障（一个批次）
+        std::vector<RenderGraphBarrier> barriers;
+    };
+
+    // 瞬态资源在共享堆中的位置。first_pass / last_pass 为执行顺序中的 pass 句柄
+    struct RenderGraphResourceAllocation
+    {
+        Bool transient = false;
+        Bool used = false;
+        RenderGraphPassHandle first_pass = kRenderGraphInvalidHandle;
+        RenderGraphPassHandle last_pass = kRenderGraphInvalidHandle;
+        ULongLong heap_offset = 0;
+        ULongLong size = 0;
+    };
+
+    struct RenderGraphCompileResult
+    {
+        std::vector<RenderGraphCompiledPass> passes;          // 未被剔除的 pass，按添加顺序
+        std::vector<RenderGraphBarrier> final_barriers;       // 帧末把导入资源转换回 final 状态
+        std::vector<RenderGraphResourceAllocation> resources; // 下标为资源句柄
+        std::vector<Bool> pass_culled;                        // 下标为 pass 句柄
+
+        ULongLong transient_heap_size = 0;
+        ULongLong unaliased_heap_size = 0; // 每个瞬态资源独占内存时所需的总大小
+        UInt transition_barrier_count = 0;
+        UInt aliasing_barrier_count = 0;
+        UInt barrier_batch_count = 0;      // 非空的屏障批次数（含 final_barriers）
+        UInt culled_pass_count = 0;
+
+        void Clear();
+    };
+
+    // 每帧重建的渲染图：pass 声明对资源的读写，Compile 负责
+    //   1. 剔除：从有副作用的 pass 与写入导入资源的 pass 反向推导，没有被需要的 pass 不执行；
+    //   2. 屏障：按执行顺序跟踪每个资源的状态，只在状态变化时生成转换，同一 pass 之前的屏障合成一个批次；
+    //   3. 别名：瞬态资源按生命周期（首次到最后一次使用的 pass）在共享堆中分配偏移，生命周期不重叠的资源共用内存。
+    // 只做 CPU 侧的计算，不接触 RHI；执行时由渲染管线按编译结果提交屏障并调用各 pass
+    class RenderGraph
+    {
+    public:
+        void Reset();
+
+        // 瞬态资源：内容只在本帧内有效。帧首状态取上一帧（稳态下与本帧相同）的最后状态
+        RenderGraphResourceHandle CreateTexture(const std::string& name, const RenderGraphTextureDesc& desc);
+        // 导入资源：生命周期在图之外，帧首为 initial_state，帧末转换回 final_state（RenderGraphAccess_None 表示保持原状态）
+        RenderGraphResourceHandle ImportTexture(const std::string& name, UInt initial_state, UInt final_state = RenderGraphAccess_None);
+
+        // has_side_effects：pass 的输出不通过图中资源体现（例如 Present、回读），永远不会被剔除
+        RenderGraphPassHandle AddPass(const std::string& name, Bool has_side_effects = false);
+        // 同一 pass 对同一资源的多次声明会合并；写访问按读-改-写处理（之前的内容需要保留）
+        void Read(RenderGraphPassHandle pass, RenderGraphResourceHandle resource, UInt access);
+        void Write(RenderGraphPassHandle pass, RenderGraphResourceHandle resource, UInt access);
+
+        // 非法声明（无效句柄、读写掩码用错、同一 pass 同时读写同一资源的不同状态）返回 false
+        Bool Compile(RenderGraphCompileResult& out_result) const;
+
+        UInt GetPassCount() const { return static_cast<UInt>(m_passes.size()); }
+        UInt GetResourceCount() const { return static_cast<UInt>(m_resources.size()); }
+        const std::string& GetPassName(RenderGraphPassHandle pass) const { return m_passes[pass].name; }
+        const std::string& GetResourceName(RenderGraphResourceHandle resource) const { return m_resources[resource].name; }
+
+    private:
+        struct ResourceNode
+        {
+            std::string name;
+            Bool imported = false;
+            RenderGraphTextureDesc desc;
+            UInt initial_state = RenderGraphAccess_None;
+            UInt final_state = RenderGraphAccess_None;
+        };
+
+        struct ResourceAccess
+        {
+            RenderGraphResourceHandle resource = kRenderGraphInvalidHandle;
+            UInt access = RenderGraphAccess_None;
+            Bool write = false;
+        };
+
+        struct PassNode
+        {
+            std::string name;
+            Bool has_side_effects = false;
+            std::vector<ResourceAccess> accesses;
+        };
+
+        void AddAccess(RenderGraphPassHandle pass, RenderGraphResourceHandle resource, UInt access, Bool write);
+
+        std::vector<ResourceNode> m_resources;
+        std::vector<PassNode> m_passes;
+        Bool m_has_invalid_access = false;
+    };
+}
+
+#endif // DOLAS_RENDER_GRAPH_H
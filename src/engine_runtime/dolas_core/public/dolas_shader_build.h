@@ -0,0 +1,110 @@
+#ifndef DOLAS_SHADER_BUILD_H
+#define DOLAS_SHADER_BUILD_H
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dolas_base.h"
+
+namespace Dolas
+{
+    // 着色器源文件（.hlsl / .hlsli）之间的 include 依赖图。
+    // 路径统一为相对着色器根目录、以 '/' 分隔，与 #include "deferred_shading/xxx.hlsli" 的写法一致。
+    // include 先按根目录解析（与编译器的 include handler 相同），找不到时再相对包含者所在目录解析
+    class ShaderDependencyGraph
+    {
+    public:
+        void Clear();
+
+        // 添加或替换一个文件，解析其中的 #include。条件编译块中的 include 也算作依赖（宁可多编译）
+        void AddFile(const std::string& path, const std::string& content);
+        // 递归扫描根目录下所有 .hlsl / .hlsli，读取失败的文件返回 false
+        Bool BuildFromDirectory(const std::string& root_directory);
+
+        Bool HasFile(const std::string& path) const { return m_files.find(path) != m_files.end(); }
+        // 按路径排序；extension 为空时返回全部文件
+        std::vector<std::string> GetFiles(const std::string& extension = "") const;
+        // 已解析的直接 include（忽略找不到的文件）
+        std::vector<std::string> GetDirectIncludes(const std::string& path) const;
+        // 直接与间接 include 的闭包，不含自身，按路径排序。include 成环时每个文件只访问一次
+        std::vector<std::string> GetTransitiveIncludes(const std::string& path) const;
+        // 直接或间接 include 了 path 的所有文件，按路径排序
+        std::vector<std::string> GetDependents(const std::string& path) const;
+        // 找不到的 include：(包含者, #include 中的原始路径)
+        std::vector<std::pair<std::string, std::string>> GetMissingIncludes() const;
+
+        // 自身与所有传递 include 的内容哈希。seed 用来混入入口、profile、编译选项等编译参数，
+        // 参数或任意一个输入文件的内容改变时结果随之改变
+        ULongLong ComputeInputHash(const std::string& path, ULongLong seed) const;
+
+        static std::string NormalizePath(const std::string& path);
+        // 提取 #include "x" / #include <x> 中的路径，跳过 // 与 /* */ 注释
+        static std::vector<std::string> ParseIncludes(const std::string& content);
+
+    private:
+        struct FileNode
+        {
+            ULongLong content_hash = 0;
+            std::vector<std::string> raw_includes;
+        };
+
+        // 返回空字符串表示找不到
+        std::string ResolveInclude(const std::string& includer, const std::string& raw_include) const;
+
+        std::map<std::string, FileNode> m_files;
+    };
+
+    // 一个编译产物的记录：哪一个源文件、以什么参数编译、编译时所有输入的哈希
+    struct ShaderBuildManifestEntry
+    {
+        std::string source;                // 相对着色器根目录
+        std::string entry_point;
+        std::string target;                // 例如 vs_5_0
+        std::string defines;               // 宏定义，见 MakeShaderDefinesString，没有时为空
+        std::string output;                // 相对输出目录
+        ULongLong input_hash = 0;          // ShaderDependencyGraph::ComputeInputHash 的结果
+        ULongLong bytecode_size = 0;
+        Double compile_milliseconds = 0.0;
+    };
+
+    // 宏定义按名字排序后拼成 "A=1;B=2"，作为清单中的 defines 字段与 ComputeShaderVariantSeed 的输入
+    std::string MakeShaderDefinesString(std::vector<std::pair<std::string, std::string>> defines);
+
+    // ComputeInputHash 的 seed：编译器标识、profile、入口与宏任意一个不同都视为不同的产物。
+    // 离线编译器与运行时（检查预编译产物是否过期）用同一个函数计算
+    ULongLong ComputeShaderVariantSeed(const std::string& compiler_identity, const std::string& target, const std::string& entry_point, const std::string& defines);
+
+    // 批量编译的清单，与 bytecode 一起写在输出目录中。下一次编译时输入哈希一致且产物存在的条目直接跳过；
+    // 运行时据此找到预编译的 bytecode。文本格式，每行一个条目、以制表符分隔，便于在版本管理中比较
+    class ShaderBuildManifest
+    {
+    public:
+        static constexpr UInt FILE_VERSION = 2;
+
+        Bool Load(const std::string& file_path);
+        Bool Save(const std::string& file_path) const;
+        void Clear() { m_entries.clear(); m_compiler_identity.clear(); }
+
+        // 生成这些产物的编译器与编译选项（例如 d3dcompiler;strict;optimization_level3），写在文件头
+        void SetCompilerIdentity(const std::string& compiler_identity) { m_compiler_identity = compiler_identity; }
+        const std::string& GetCompilerIdentity() const { return m_compiler_identity; }
+
+        // 以 output 为键，已存在时覆盖
+        void SetEntry(const ShaderBuildManifestEntry& entry);
+        void RemoveEntry(const std::string& output) { m_entries.erase(output); }
+        const ShaderBuildManifestEntry* FindEntry(const std::string& output) const;
+        // 按编译参数查找，找不到返回 nullptr
+        const ShaderBuildManifestEntry* FindVariant(const std::string& source, const std::string& entry_point, const std::string& target, const std::string& defines) const;
+        const std::map<std::string, ShaderBuildManifestEntry>& GetEntries() const { return m_entries; }
+
+        // 没有记录或输入哈希不同即为过期；产物文件是否存在由调用方检查
+        Bool IsStale(const std::string& output, ULongLong input_hash) const;
+
+    private:
+        std::string m_compiler_identity;
+        std::map<std::string, ShaderBuildManifestEntry> m_entries;
+    };
+}
+
+#endif // DOLAS_SHADER_BUILD_H
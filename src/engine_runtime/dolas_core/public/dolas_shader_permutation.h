@@ -0,0 +1,42 @@
+#ifndef DOLAS_SHADER_PERMUTATION_H
+#define DOLAS_SHADER_PERMUTATION_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "dolas_base.h"
+
+namespace Dolas
+{
+    // 启用的 keyword 集合的 64 位标识，与 keyword 的顺序无关；没有启用任何 keyword 时为 0
+    using ShaderPermutationKey = ULongLong;
+
+    // 着色器源文件中声明的 keyword，每行一组互斥的 keyword，"_" 表示这一组都不启用：
+    //     // #pragma dolas_keywords _ NORMAL_MAP
+    // 写在注释里：fxc 对不认识的 #pragma 会给出警告，运行时编译把警告当作失败。
+    // 启用的 keyword 以 "<KEYWORD>=1" 的宏传给编译器，shader 中用 #if defined(KEYWORD) 分支
+    class ShaderKeywordDeclaration
+    {
+    public:
+        static ShaderKeywordDeclaration Parse(const std::string& content);
+
+        const std::vector<std::vector<std::string>>& GetKeywordSets() const { return m_keyword_sets; }
+        Bool IsEmpty() const { return m_keyword_sets.empty(); }
+        Bool IsDeclared(const std::string& keyword) const;
+        // 所有组合的数量（每组的 keyword 数 + 1 相乘），用来说明按需编译省下的变体
+        ULongLong GetPermutationCount() const;
+
+        // 从材质请求的 keyword 中选出本 shader 声明过的，排序去重；没有声明的忽略（同一材质的 VS / PS 各取所需）。
+        // 同一组中选了多个时返回 false，out_error 说明冲突的 keyword
+        Bool Resolve(const std::vector<std::string>& requested, std::vector<std::string>& out_keywords, std::string* out_error = nullptr) const;
+
+    private:
+        std::vector<std::vector<std::string>> m_keyword_sets;
+    };
+
+    ShaderPermutationKey ComputeShaderPermutationKey(std::vector<std::string> keywords);
+    // 每个 keyword 对应一个值为 1 的宏，按名字排序
+    std::vector<std::pair<std::string, std::string>> MakeShaderKeywordDefines(const std::vector<std::string>& keywords);
+}
+
+#endif // DOLAS_SHADER_PERMUTATION_H
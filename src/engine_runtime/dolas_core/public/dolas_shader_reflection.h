@@ -0,0 +1,71 @@
+#ifndef DOLAS_SHADER_REFLECTION_H
+#define DOLAS_SHADER_REFLECTION_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "dolas_base.h"
+
+namespace Dolas
+{
+    struct ConstantBufferVariableInfo
+    {
+        std::string name;
+        UInt start_offset = 0;
+        UInt size = 0;
+        UInt flags = 0;
+
+        Bool operator==(const ConstantBufferVariableInfo& other) const = default;
+    };
+
+    struct ConstantBufferInfo
+    {
+        std::string name;
+        UInt size = 0;
+        UInt variable_count = 0;
+        std::vector<ConstantBufferVariableInfo> variable_descs;
+
+        Bool operator==(const ConstantBufferInfo& other) const = default;
+    };
+
+    // shader 绑定的资源（cbuffer / 纹理 / 采样器 / 结构化缓冲区），type 与 dimension 为 D3D_SHADER_INPUT_TYPE / D3D_SRV_DIMENSION 的值
+    struct ShaderBoundResourceInfo
+    {
+        std::string name;
+        UInt type = 0;
+        UInt dimension = 0;
+        UInt bind_point = 0;
+        UInt bind_count = 0;
+
+        Bool operator==(const ShaderBoundResourceInfo& other) const = default;
+    };
+
+    struct ShaderReflectionInfo
+    {
+        UInt constant_buffer_count = 0;
+        UInt bound_resource_count = 0;
+        UInt instruction_count = 0;
+        std::vector<ConstantBufferInfo> constant_buffer_descs;
+        std::vector<ShaderBoundResourceInfo> bound_resource_descs;
+
+        Bool operator==(const ShaderReflectionInfo& other) const = default;
+    };
+
+    // 离线编译器在 bytecode 旁边写出的反射文件（.refl），运行时加载预编译 shader 时不再调用 D3DReflect。
+    // bytecode_hash 为对应 bytecode 的 HashConverter::BytesHash64，加载时据此确认两个文件来自同一次编译
+    class ShaderReflectionFile
+    {
+    public:
+        static constexpr UInt FILE_MAGIC = 0x46525344; // "DSRF"
+        static constexpr UInt FILE_VERSION = 1;
+
+        static void Serialize(const ShaderReflectionInfo& info, ULongLong bytecode_hash, std::vector<UByte>& out_bytes);
+        // 数据截断、magic / 版本不符时返回 false
+        static Bool Deserialize(const UByte* data, std::size_t size, ShaderReflectionInfo& out_info, ULongLong& out_bytecode_hash);
+
+        static Bool Save(const std::string& file_path, const ShaderReflectionInfo& info, ULongLong bytecode_hash);
+        static Bool Load(const std::string& file_path, ShaderReflectionInfo& out_info, ULongLong& out_bytecode_hash);
+    };
+}
+
+#endif // DOLAS_SHADER_REFLECTION_H
@@ -0,0 +1,86 @@
+#ifndef DOLAS_SOFTWARE_OCCLUSION_H
+#define DOLAS_SOFTWARE_OCCLUSION_H
+
+#include <vector>
+#include "dolas_base.h"
+#include "dolas_bounds.h"
+#include "dolas_frustum_culling.h"
+
+namespace Dolas
+{
+    // CPU 软件光栅化的低分辨率深度缓冲，用于遮挡剔除。
+    // 使用流程：BeginFrame -> AddOccluder（三角形建立并按行带分箱）-> RasterizeBand（各行带互不重叠，可并行）
+    // -> BuildHierarchicalZ -> IsOccluded / CullOccludedBoxes。
+    // 深度为裁剪空间 z / w（[0, 1]，越小越近），清除值为 1。像素中心采样，不做背面剔除，
+    // 因此遮挡判断的精度为一个低分辨率像素
+    class SoftwareOcclusionBuffer
+    {
+    public:
+        // width 向上取整到 4 的倍数（SIMD 每次处理一行中的 4 个像素）
+        void Initialize(UInt width, UInt height, UInt band_height = 16);
+
+        void BeginFrame(const Matrix4x4& view_projection);
+        // positions 为模型空间 xyz，按 stride（单位：Float）排列；indices 为三角形列表。返回加入的三角形数量（裁剪后）
+        UInt AddOccluder(const Matrix4x4& world, const Float* positions, UInt vertex_count, UInt stride, const UInt* indices, UInt index_count);
+
+        UInt GetBandCount() const { return static_cast<UInt>(m_band_triangles.size()); }
+        void RasterizeBand(UInt band_index);
+        // 不使用 SIMD 的逐像素参考实现，结果与 RasterizeBand 逐位一致
+        void RasterizeBandScalar(UInt band_index);
+        // 单线程光栅化所有行带
+        void RasterizeAll();
+
+        // 逐级取 2x2 的最远深度
+        void BuildHierarchicalZ();
+
+        // 只有确定被完全挡住时返回 true；跨越近平面或不在屏幕上的包围盒返回 false
+        Bool IsOccluded(const BoundingBox& world_box) const;
+        // 对 in_out_visibility 中为 1 的包围盒做遮挡测试，被遮挡的置 0，返回被遮挡的数量。只读，可分块并行调用
+        UInt CullOccludedBoxes(const CullingBoundsSoA& bounds, UInt begin, UInt end, UByte* in_out_visibility) const;
+
+        UInt GetWidth() const { return m_width; }
+        UInt GetHeight() const { return m_height; }
+        UInt GetTriangleCount() const { return static_cast<UInt>(m_triangles.size()); }
+        UInt GetHierarchicalZLevelCount() const { return static_cast<UInt>(m_levels.size()); }
+        UInt GetLevelWidth(UInt level) const { return m_levels[level].width; }
+        UInt GetLevelHeight(UInt level) const { return m_levels[level].height; }
+        Float GetDepth(UInt level, UInt x, UInt y) const { return m_levels[level].depth[y * m_levels[level].width + x]; }
+
+    private:
+        // 屏幕空间三角形：三条边函数 E(x, y) = a * x + b * y + c（内部为非负）与深度平面 z = a * x + b * y + c
+        struct ScreenTriangle
+        {
+            Float edge_a[3];
+            Float edge_b[3];
+            Float edge_c[3];
+            Float depth_a;
+            Float depth_b;
+            Float depth_c;
+            Int min_x;
+            Int max_x;
+            Int min_y;
+            Int max_y;
+        };
+
+        struct DepthLevel
+        {
+            UInt width = 0;
+            UInt height = 0;
+            std::vector<Float> depth;
+        };
+
+        void SetupTriangle(const Vector4& clip0, const Vector4& clip1, const Vector4& clip2);
+        void GetBandRows(UInt band_index, Int& out_begin_row, Int& out_end_row) const;
+
+        UInt m_width = 0;
+        UInt m_height = 0;
+        UInt m_band_height = 16;
+        Matrix4x4 m_view_projection;
+        std::vector<ScreenTriangle> m_triangles;
+        std::vector<std::vector<UInt>> m_band_triangles;
+        // m_levels[0] 为光栅化目标，其余为 hierarchical-Z
+        std::vector<DepthLevel> m_levels;
+    };
+}
+
+#endif // DOLAS_SOFTWARE_OCCLUSION_H
@@ -0,0 +1,88 @@
+#ifndef DOLAS_TEXTURE_COOK_H
+#define DOLAS_TEXTURE_COOK_H
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <vector>
+#include "dolas_base.h"
+#include "dolas_block_compression.h"
+
+namespace Dolas
+{
+    // RGBA 浮点图像（行优先，每个像素 4 个 Float）
+    struct TextureImage
+    {
+        UInt width = 0;
+        UInt height = 0;
+        std::vector<Float> pixels;
+
+        void Resize(UInt new_width, UInt new_height);
+        Bool IsEmpty() const { return width == 0 || height == 0; }
+        Float* GetPixel(UInt x, UInt y) { return pixels.data() + (static_cast<std::size_t>(y) * width + x) * 4; }
+        const Float* GetPixel(UInt x, UInt y) const { return pixels.data() + (static_cast<std::size_t>(y) * width + x) * 4; }
+    };
+
+    enum class TextureCookUsage : UInt
+    {
+        Albedo = 0, // sRGB 编码的颜色，在线性空间生成 mip
+        Normal,     // 切线空间法线（[0, 1] 编码），只保存 XY，shader 重建 Z
+        Mask,       // 单通道数据（粗糙度、金属度等），取 R 通道
+        HDR,        // 线性 HDR 颜色
+    };
+
+    const char* GetTextureCookUsageName(TextureCookUsage usage);
+
+    struct TextureCookSettings
+    {
+        TextureCookUsage usage = TextureCookUsage::Albedo;
+        Bool high_quality = false;  // 颜色贴图使用 BC7 代替 BC1 / BC3
+        UInt max_mip_count = 0;     // 0 为完整的 mip 链
+    };
+
+    // Albedo：不透明为 BC1，有 alpha 为 BC3，high_quality 时为 BC7；Normal：BC5；Mask：BC4；HDR：BC6H
+    BlockFormat SelectTextureBlockFormat(TextureCookUsage usage, Bool has_alpha, Bool high_quality);
+    // 存在 alpha < 1 的像素
+    Bool HasTranslucentAlpha(const TextureImage& image);
+    UInt ComputeFullMipCount(UInt width, UInt height);
+
+    // 从上一级 mip 生成 destination（已按目标尺寸 Resize）的第 [row_begin, row_end) 行。
+    // 可分离滤波，边缘按 clamp 处理：LDR 使用 Lanczos（3 瓣）并截断到 [0, 1]，HDR 使用帐篷滤波，避免负瓣在高亮像素周围产生振铃；
+    // Normal 在滤波后重新归一化。Albedo 的输入输出都应已转换到线性空间。
+    // 滤波窗口跨到相邻行时也只读 source，写入的行互不重叠，因此一幅 mip 可以按行段分给多个线程
+    void DownsampleImageRows(const TextureImage& source, TextureCookUsage usage, UInt row_begin, UInt row_end, TextureImage& destination);
+    // 原地转换第 [row_begin, row_end) 行的 RGB（alpha 不变）
+    void ConvertImageRowsSRGBToLinear(TextureImage& image, UInt row_begin, UInt row_end);
+    void ConvertImageRowsLinearToSRGB(TextureImage& image, UInt row_begin, UInt row_end);
+
+    struct CookedTexture
+    {
+        BlockFormat format = BlockFormat::BC1;
+        UInt width = 0;
+        UInt height = 0;
+        UInt face_count = 1;                    // 6 为立方体纹理
+        std::vector<std::vector<UByte>> mips;   // 每级 mip 的块数据；立方体按面主序存放（第一个面的所有 mip，然后是下一个面）
+        Double mip_milliseconds = 0.0;
+        Double encode_milliseconds = 0.0;
+        ULongLong encoded_texel_count = 0;      // 所有 mip 的像素数
+
+        UInt GetMipCount() const { return face_count == 0 ? 0 : static_cast<UInt>(mips.size()) / face_count; }
+        ULongLong GetByteSize() const;
+    };
+
+    // 把 [0, count) 切成若干段调用 task(begin, end)，全部完成后返回；为空时在当前线程上顺序执行
+    using TextureCookParallelFor = std::function<void(UInt count, const std::function<void(UInt begin, UInt end)>& task)>;
+
+    // 生成 mip 链并逐级块压缩。mip 生成与压缩都按行分段交给 parallel_for，结果与分段方式无关
+    Bool CookTexture(const TextureImage& image, const TextureCookSettings& settings, CookedTexture& out_texture, const TextureCookParallelFor& parallel_for = {});
+
+    // DDS（带 DX10 扩展头）的完整文件内容。颜色以 UNORM 保存 sRGB 编码的值，与运行时直接加载 PNG（R8G8B8A8_UNORM）时的采样结果一致
+    std::vector<UByte> BuildCookedTextureDDS(const CookedTexture& texture);
+    Bool SaveCookedTextureDDS(const CookedTexture& texture, const std::filesystem::path& file_path);
+
+    // 解码 Radiance RGBE（.hdr）文件内容，支持平铺与新式 RLE 扫描线，只支持 -Y h +X w 方向
+    Bool DecodeRadianceHDR(const UByte* data, std::size_t size, TextureImage& out_image);
+    Bool LoadRadianceHDRFile(const std::filesystem::path& file_path, TextureImage& out_image);
+}
+
+#endif // DOLAS_TEXTURE_COOK_H
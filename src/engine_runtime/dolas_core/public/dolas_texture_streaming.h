@@ -0,0 +1,123 @@
+#ifndef DOLAS_TEXTURE_STREAMING_H
+#define DOLAS_TEXTURE_STREAMING_H
+
+#include <unordered_map>
+#include <vector>
+#include "dolas_base.h"
+
+namespace Dolas
+{
+    struct TextureStreamingDesc
+    {
+        ULongLong budget_bytes = 256ull << 20;              // 可流送纹理（含常驻尾部 mip）的显存预算
+        ULongLong max_stream_in_bytes_per_update = 16ull << 20; // 每次 Update 新增常驻字节的上限，避免一帧提交过多拷贝
+        UInt tail_mip_size = 128;                           // 边长不超过它的 mip 始终常驻，加载时只上传这些
+        UInt drop_delay_frames = 30;                        // 需求降低之后保持多少帧才释放 mip（滞后，避免来回流送）
+        Float mip_bias = 0.0f;                              // 加到期望 mip 上，正值偏向更低的精度
+    };
+
+    // 边长不超过 tail_mip_size 的第一个 mip（至少是最后一个 mip）
+    UInt ComputeTailFirstMip(UInt width, UInt height, UInt mip_count, UInt tail_mip_size);
+    // 屏幕上每单位 UV 覆盖 screen_pixels_per_uv 个像素时需要的最高精度 mip：
+    // 一个纹素对应一个像素即可，mip = floor(log2(纹理边长 / 每 UV 像素数) + bias)
+    UInt ComputeDesiredMip(UInt width, UInt height, UInt mip_count, Float screen_pixels_per_uv, Float mip_bias = 0.0f);
+    // 半径 world_radius 的物体在 view_distance 处投影到屏幕上的直径（像素），作为 [0, 1] UV 铺满物体时的 UV 密度；
+    // projection_scale 为投影矩阵的 [1][1]，相机在物体内部时返回一个很大的值（需要最高精度）
+    Float EstimateScreenPixelsPerUV(Float world_radius, Float view_distance, Float projection_scale, Float viewport_height);
+
+    // 一帧内绘制产生的 UV 密度反馈，每个纹理保留最大值（最高精度的需求）
+    class TextureStreamingFeedback
+    {
+    public:
+        void Record(TextureID texture_id, Float screen_pixels_per_uv);
+        void Clear() { m_screen_pixels_per_uv.clear(); }
+        Bool IsEmpty() const { return m_screen_pixels_per_uv.empty(); }
+        // 本帧没有用到的纹理返回 0
+        Float Get(TextureID texture_id) const;
+
+    private:
+        std::unordered_map<TextureID, Float> m_screen_pixels_per_uv;
+    };
+
+    // 让纹理从 resident first mip 变为 first_mip（较小为流入，较大为流出），完成后调用 OnStreamingFinished
+    struct TextureStreamingRequest
+    {
+        TextureID texture_id = TEXTURE_ID_EMPTY;
+        UInt first_mip = 0;
+    };
+
+    struct TextureStreamingStatistics
+    {
+        UInt texture_count = 0;
+        UInt streaming_count = 0;            // 已发出请求、尚未完成
+        ULongLong budget_bytes = 0;
+        ULongLong resident_bytes = 0;
+        ULongLong target_bytes = 0;          // 预算约束后的目标
+        ULongLong wanted_bytes = 0;          // 不受预算约束时需要的字节数，超过预算说明画面精度被降低
+        ULongLong tail_bytes = 0;            // 所有纹理的尾部 mip
+        ULongLong streamed_in_bytes = 0;     // 累计
+        ULongLong streamed_out_bytes = 0;    // 累计
+    };
+
+    // 纹理 mip 常驻策略（不涉及图形 API）：按反馈得到每个纹理想要的 first mip，在预算内求解目标，
+    // 生成流入 / 流出请求。纹理的常驻部分总是从某个 first mip 到最后一个 mip 的连续区间。
+    // 只在一个线程（渲染线程）上调用
+    class TextureStreamingPolicy
+    {
+    public:
+        void Initialize(const TextureStreamingDesc& desc);
+        void Clear();
+
+        const TextureStreamingDesc& GetDesc() const { return m_desc; }
+        void SetBudget(ULongLong budget_bytes) { m_desc.budget_bytes = budget_bytes; }
+        ULongLong GetBudget() const { return m_desc.budget_bytes; }
+
+        // mip_bytes[i] 为 mip i 占用的字节数。注册后纹理被视为正在加载尾部 mip，加载完成时以尾部 first mip 调用 OnStreamingFinished
+        void RegisterTexture(TextureID texture_id, UInt width, UInt height, const std::vector<ULongLong>& mip_bytes);
+        void UnregisterTexture(TextureID texture_id);
+        Bool IsRegistered(TextureID texture_id) const { return m_textures.find(texture_id) != m_textures.end(); }
+        // 未注册的纹理返回 0
+        UInt GetTailFirstMip(TextureID texture_id) const;
+        UInt GetResidentFirstMip(TextureID texture_id) const;
+
+        // 每帧调用一次：用本帧的反馈更新需求并在预算内求解，out_requests 为需要改变常驻 mip 的纹理（流出在前）。
+        // 正在流送的纹理不会再发出请求
+        void Update(const TextureStreamingFeedback& feedback, std::vector<TextureStreamingRequest>& out_requests);
+        // 请求完成（或失败时传入原来的 first mip）
+        void OnStreamingFinished(TextureID texture_id, UInt first_mip);
+
+        ULongLong GetResidentBytes() const { return m_resident_bytes; }
+        TextureStreamingStatistics GetStatistics() const;
+
+    private:
+        struct Entry
+        {
+            UInt width = 0;
+            UInt height = 0;
+            std::vector<ULongLong> mip_bytes;
+            std::vector<ULongLong> bytes_from_mip;   // bytes_from_mip[m] 为 mip m 到最后一个 mip 的总字节数
+            UInt tail_first_mip = 0;
+            UInt resident_first_mip = 0;
+            UInt wanted_first_mip = 0;     // 经过滞后处理的需求
+            UInt target_first_mip = 0;     // 预算约束后的目标
+            UInt streaming_first_mip = 0;  // 请求中的 first mip
+            Bool streaming = false;
+            UInt coarser_frames = 0;       // 需求连续低于 wanted 的帧数
+            ULongLong last_used_frame = 0;
+            Float screen_pixels_per_uv = 0.0f; // 最近一次使用时的 UV 密度，预算不足时决定先降低谁
+        };
+
+        void UpdateWanted(Entry& entry, UInt desired_first_mip) const;
+        // 从 wanted 开始，超出预算时反复丢弃分数最高的纹理的最高一级 mip
+        void SolveBudget();
+
+        TextureStreamingDesc m_desc;
+        std::unordered_map<TextureID, Entry> m_textures;
+        ULongLong m_frame = 0;
+        ULongLong m_resident_bytes = 0;
+        ULongLong m_streamed_in_bytes = 0;
+        ULongLong m_streamed_out_bytes = 0;
+    };
+}
+
+#endif // DOLAS_TEXTURE_STREAMING_H
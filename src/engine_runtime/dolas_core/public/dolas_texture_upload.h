@@ -0,0 +1,158 @@
+#ifndef DOLAS_TEXTURE_UPLOAD_H
+#define DOLAS_TEXTURE_UPLOAD_H
+
+#include <deque>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "dolas_base.h"
+
+namespace Dolas
+{
+    // staging 缓冲区上的环形分配器。两次 Submit 之间的分配属于同一批次，批次的 fence 完成（Retire）后整段回收
+    class UploadRingAllocator
+    {
+    public:
+        static constexpr ULongLong INVALID_OFFSET = ~0ULL;
+
+        void Initialize(ULongLong capacity);
+
+        // alignment 必须是 2 的幂；空间不足时返回 INVALID_OFFSET，等之前的批次完成后再试
+        ULongLong Allocate(ULongLong size, ULongLong alignment);
+        // 把自上次 Submit 以来的分配记为一个批次
+        void Submit(ULongLong fence_value);
+        // fence 值不超过 completed_fence_value 的批次已在 GPU 完成
+        void Retire(ULongLong completed_fence_value);
+
+        ULongLong GetCapacity() const { return m_capacity; }
+        // 已分配（含对齐与绕回时跳过的字节）且尚未回收的字节数
+        ULongLong GetUsedBytes() const { return m_used; }
+        Bool HasPendingBatches() const { return !m_batches.empty(); }
+
+    private:
+        struct Batch
+        {
+            ULongLong end = 0;
+            ULongLong bytes = 0;
+            ULongLong fence_value = 0;
+        };
+
+        void Consume(ULongLong bytes);
+
+        ULongLong m_capacity = 0;
+        ULongLong m_head = 0;   // 下一次分配的位置
+        ULongLong m_tail = 0;   // 最早的未回收分配的起点
+        ULongLong m_used = 0;
+        ULongLong m_open_bytes = 0;
+        std::deque<Batch> m_batches;
+    };
+
+    enum class TextureLoadState : UByte
+    {
+        None,       // 未知或已经结束的请求
+        Queued,     // 等待解码
+        Decoding,   // 工作线程正在读取 / 解码文件
+        Decoded,    // 等待拷贝到 GPU
+        Uploading,  // 所有子资源都已提交拷贝，等待 GPU 完成
+    };
+
+    // 一次子资源拷贝：从上传环的 ring_offset 处（dedicated 时为单独的上传缓冲）拷贝到纹理的 subresource
+    struct TextureUploadCopy
+    {
+        UInt request = 0;
+        UInt subresource = 0;
+        ULongLong size = 0;
+        ULongLong ring_offset = 0;
+        Bool dedicated = false; // 比整个上传环还大的子资源，调用方为它单独创建上传缓冲
+    };
+
+    struct TextureLoadSchedulerDesc
+    {
+        UInt max_concurrent_decodes = 2;               // 解码后的图像在上传之前一直占用内存
+        ULongLong staging_capacity = 64ull << 20;
+        ULongLong max_batch_bytes = 32ull << 20;       // 每次提交的拷贝字节上限，避免单帧拷贝过多
+        ULongLong placement_alignment = 512;           // D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT
+    };
+
+    struct TextureLoadSchedulerStatistics
+    {
+        UInt queued_count = 0;
+        UInt decoding_count = 0;
+        UInt decoded_count = 0;
+        UInt uploading_count = 0;
+        UInt submitted_batches = 0;          // 累计
+        UInt dedicated_copies = 0;           // 累计
+        ULongLong submitted_bytes = 0;       // 累计
+        ULongLong staging_used_bytes = 0;
+    };
+
+    // 纹理异步加载的调度（不涉及图形 API）：
+    //   Queued -> Decoding（工作线程解码，限制并发数） -> Decoded -> Uploading（按子资源分批进入上传环） -> 完成。
+    // 多个纹理的拷贝合并成一次提交；一个纹理也可以跨多个批次，全部批次完成后才算完成。
+    // 只在一个线程（渲染线程）上调用；解码本身由调用方放到工作线程
+    class TextureLoadScheduler
+    {
+    public:
+        using RequestID = UInt;
+        static constexpr RequestID INVALID_REQUEST = 0xFFFFFFFFu;
+
+        void Initialize(const TextureLoadSchedulerDesc& desc);
+        void Clear();
+
+        RequestID AddRequest();
+        // 取消请求。已有拷贝在 GPU 上执行的请求要等批次完成才会移除，Retire 时不再报告
+        void Cancel(RequestID request);
+
+        // 取出可以开始解码的请求，同时解码的数量不超过 max_concurrent_decodes
+        void TakeDecodeRequests(std::vector<RequestID>& out_requests);
+        // subresource_sizes 为每个子资源在上传缓冲中占用的字节数（按 GetCopyableFootprints 的布局）
+        void OnDecoded(RequestID request, const std::vector<ULongLong>& subresource_sizes);
+        void OnDecodeFailed(RequestID request);
+
+        // 为下一次提交挑选拷贝：按解码完成的顺序，直到批次预算或上传环用尽；
+        // 每批至少包含一个拷贝（如果有待拷贝的子资源且上传环放得下），超过预算的大子资源也能前进
+        void BuildBatch(std::vector<TextureUploadCopy>& out_copies);
+        // 上一次 BuildBatch 的拷贝已经录制并以 fence_value 提交
+        void SubmitBatch(ULongLong fence_value);
+        // fence 不超过 completed_fence_value 的批次已完成；out_completed 为所有子资源都已上传的请求
+        void Retire(ULongLong completed_fence_value, std::vector<RequestID>& out_completed);
+
+        TextureLoadState GetState(RequestID request) const;
+        Bool IsIdle() const { return m_requests.empty(); }
+        Bool HasPendingBatches() const { return !m_batches.empty(); }
+        TextureLoadSchedulerStatistics GetStatistics() const;
+
+    private:
+        struct Request
+        {
+            TextureLoadState state = TextureLoadState::Queued;
+            Bool cancelled = false;
+            std::vector<ULongLong> subresource_sizes;
+            UInt next_subresource = 0;      // 下一个要拷贝的子资源
+            UInt in_flight_subresources = 0; // 已提交、尚未完成的子资源
+        };
+
+        struct Batch
+        {
+            ULongLong fence_value = 0;
+            std::vector<std::pair<RequestID, UInt>> subresource_counts;
+        };
+
+        void Erase(RequestID request);
+
+        TextureLoadSchedulerDesc m_desc;
+        UploadRingAllocator m_ring;
+        RequestID m_next_request = 0;
+        std::unordered_map<RequestID, Request> m_requests;
+        std::deque<RequestID> m_queued;
+        std::deque<RequestID> m_decoded;        // 还有子资源等待拷贝
+        std::vector<TextureUploadCopy> m_open_copies;
+        std::deque<Batch> m_batches;
+        UInt m_decoding_count = 0;
+        UInt m_submitted_batches = 0;
+        UInt m_dedicated_copies = 0;
+        ULongLong m_submitted_bytes = 0;
+    };
+}
+
+#endif // DOLAS_TEXTURE_UPLOAD_H
@@ -102,6 +102,8 @@ namespace Dolas
 		
 		// First, initialize the logging system
 		DOLAS_RETURN_FALSE_IF_FALSE(m_log_system_manager->Initialize());
+		// Worker threads are used during asset loading (e.g. pipeline state precompilation)
+		DOLAS_RETURN_FALSE_IF_FALSE(m_task_manager->Initialize());
 		DOLAS_RETURN_FALSE_IF_FALSE(m_render_hardware_interface->Initialize());
 		DOLAS_RETURN_FALSE_IF_FALSE(m_rhi->Initialize());
 		DOLAS_RETURN_FALSE_IF_FALSE(m_imgui_manager->Initialize());
@@ -113,6 +115,8 @@ namespace Dolas
 
 		DOLAS_RETURN_FALSE_IF_FALSE(m_render_pipeline_manager->Initialize());
 		DOLAS_RETURN_FALSE_IF_FALSE(m_material_manager->Initialize());
+		// 材质加载完成时启动阶段用到的 shader 都已创建，记录预编译与运行时编译各自的耗时
+		m_shader_manager->LogLoadStatistics();
 		DOLAS_RETURN_FALSE_IF_FALSE(m_render_entity_manager->Initialize());
 		DOLAS_RETURN_FALSE_IF_FALSE(m_render_object_manager->Initialize());
 		DOLAS_RETURN_FALSE_IF_FALSE(m_test_manager->Initialize());
@@ -125,7 +129,6 @@ namespace Dolas
 		// Initialize the input manager (must be done after RHI initialization, as it requires a window handle)
 		DOLAS_RETURN_FALSE_IF_FALSE(m_input_manager->Initialize());
 		m_render_hardware_interface->SetWindowMessageHandler(&MainRenderWindowMsgProc);
-		DOLAS_RETURN_FALSE_IF_FALSE(m_task_manager->Initialize());
 		DOLAS_RETURN_FALSE_IF_FALSE(m_tick_manager->Initialize());
 		DOLAS_RETURN_FALSE_IF_FALSE(m_debug_draw_manager->Initialize());
 		DOLAS_RETURN_FALSE_IF_FALSE(m_timer_manager->Initialize());
@@ -136,6 +139,8 @@ namespace Dolas
 
 	void DolasEngine::Clear()
 	{
+		// 拷贝队列上还有未完成的纹理上传时，设备释放前先等待
+		m_texture_manager->WaitForPendingLoads();
 		m_imgui_manager->Clear();
 		m_rhi->Clear();
 		m_render_hardware_interface->Clear();
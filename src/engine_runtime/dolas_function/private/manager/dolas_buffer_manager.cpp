@@ -149,6 +149,24 @@ static std::atomic<UInt> s_next_buffer_id{ 1 };
         return (it != m_buffers.end()) ? it->second : nullptr;
     }
 
+    bool BufferManager::DestroyBuffer(BufferID buffer_id)
+    {
+        auto it = m_buffers.find(buffer_id);
+        if (it == m_buffers.end())
+        {
+            return false;
+        }
+
+        Buffer* buffer = it->second;
+        if (buffer)
+        {
+            buffer->Release();
+            DOLAS_DELETE(buffer);
+        }
+        m_buffers.erase(it);
+        return true;
+    }
+
     uint32_t BufferManager::GetTotalBufferMemory() const
     {
         uint32_t total_memory = 0;
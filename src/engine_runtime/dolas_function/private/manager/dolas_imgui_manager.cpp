@@ -15,7 +15,12 @@
 #include "manager/dolas_render_camera_manager.h"
 #include "manager/dolas_timer_manager.h"
 #include "manager/dolas_shader_manager.h"
+#include "manager/dolas_texture_manager.h"
 #include "manager/dolas_render_pipeline_manager.h"
+#include "manager/dolas_render_view_manager.h"
+#include "render/dolas_render_view.h"
+#include "render/dolas_render_pipeline.h"
+#include "render/dolas_rhi.h"
 
 namespace
 {
@@ -432,6 +437,240 @@ namespace Dolas
         }
         ImGui::Text("FPS: %.2f", fps);
         
+        ImGui::Separator();
+
+        // 上一帧的绑定统计：requested 为过滤前的绑定请求，issued 为实际写入 command list 的次数
+        if (g_dolas_engine.m_rhi)
+        {
+            const RHIFrameStatistics& statistics = g_dolas_engine.m_rhi->GetLastFrameStatistics();
+            ImGui::Text("Draw Calls: %u, Triangles: %u", statistics.draw_calls, statistics.triangles);
+            auto show_bind_counter = [](const char* name, const RHIBindCounter& counter)
+            {
+                ImGui::Text("%s: %u -> %u", name, counter.requested_count, counter.issued_count);
+            };
+            ImGui::Text("Binds (requested -> issued):");
+            show_bind_counter("  Root Signature", statistics.root_signature);
+            show_bind_counter("  CBV", statistics.constant_buffer_view);
+            show_bind_counter("  SRV Table", statistics.srv_table);
+            show_bind_counter("  PSO", statistics.pipeline_state);
+            show_bind_counter("  Vertex Buffer", statistics.vertex_buffer);
+            show_bind_counter("  Index Buffer", statistics.index_buffer);
+            show_bind_counter("  Topology", statistics.primitive_topology);
+            ImGui::Text("Descriptor Copies: %u", statistics.descriptor_copies);
+            ImGui::Text("SRV Table Rebuilds: %u (transient %u)", statistics.srv_table_rebuilds, statistics.srv_table_transient_writes);
+            ImGui::Text("Transient Constants: %.1f KB, %u overflow(s)",
+                static_cast<Double>(statistics.transient_constant_bytes) / 1024.0,
+                statistics.transient_constant_overflows);
+            ImGui::Text("Global Constants: %.1f KB in %u upload(s), %u clean bind(s)",
+                static_cast<Double>(statistics.global_constant_bytes) / 1024.0,
+                statistics.global_constant_uploads,
+                statistics.global_constant_skipped_uploads);
+            ImGui::Text("Material Constants: %.1f KB in %u copy(s), %u material bind(s)",
+                static_cast<Double>(statistics.material_constant_bytes) / 1024.0,
+                statistics.material_constant_uploads,
+                statistics.material_binds);
+            ImGui::Text("PSO (cache / library / compiled): %u / %u / %u, %.2f ms",
+                statistics.pipeline_state_cache_hits,
+                statistics.pipeline_state_library_hits,
+                statistics.pipeline_state_compiles,
+                statistics.pipeline_state_create_milliseconds);
+            const PipelineStateLibraryStatistics library_statistics = g_dolas_engine.m_rhi->GetPipelineStateLibraryStatistics();
+            ImGui::Text("PSO Total: %u hits, %u library, %u compiled, %u failed",
+                library_statistics.cache_hits,
+                library_statistics.library_hits,
+                library_statistics.compiled,
+                library_statistics.failed);
+            ImGui::Text("PSO Precompile: %u created, %u failed",
+                library_statistics.precompiled,
+                library_statistics.precompile_failed);
+            ImGui::Text("First Frame: %.2f ms (PSO %.2f ms)",
+                g_dolas_engine.m_rhi->GetFirstFrameMilliseconds(),
+                g_dolas_engine.m_rhi->GetFirstFramePipelineStateMilliseconds());
+            const ShaderLoadStatistics& shader_statistics = g_dolas_engine.m_shader_manager->GetLoadStatistics();
+            ImGui::Text("Shaders (precompiled / compiled / stale): %u / %u / %u, %.2f / %.2f ms",
+                shader_statistics.precompiled_count,
+                shader_statistics.runtime_compiled_count,
+                shader_statistics.stale_count,
+                shader_statistics.precompiled_milliseconds,
+                shader_statistics.runtime_compile_milliseconds);
+            const TextureLoadSchedulerStatistics texture_statistics = g_dolas_engine.m_texture_manager->GetLoadStatistics();
+            ImGui::Text("Texture Loads (queued / decoding / decoded / uploading): %u / %u / %u / %u",
+                texture_statistics.queued_count,
+                texture_statistics.decoding_count,
+                texture_statistics.decoded_count,
+                texture_statistics.uploading_count);
+            ImGui::Text("Texture Uploads: %.1f MB in %u batch(es), %u dedicated, staging %.1f KB in use",
+                static_cast<Double>(texture_statistics.submitted_bytes) / (1024.0 * 1024.0),
+                texture_statistics.submitted_batches,
+                texture_statistics.dedicated_copies,
+                static_cast<Double>(texture_statistics.staging_used_bytes) / 1024.0);
+            const TextureStreamingStatistics streaming_statistics = g_dolas_engine.m_texture_manager->GetStreamingStatistics();
+            ImGui::Text("Texture Streaming: %u texture(s), %u streaming, resident %.1f / %.1f MB (wanted %.1f MB, tail %.1f MB)",
+                streaming_statistics.texture_count,
+                streaming_statistics.streaming_count,
+                static_cast<Double>(streaming_statistics.resident_bytes) / (1024.0 * 1024.0),
+                static_cast<Double>(streaming_statistics.budget_bytes) / (1024.0 * 1024.0),
+                static_cast<Double>(streaming_statistics.wanted_bytes) / (1024.0 * 1024.0),
+                static_cast<Double>(streaming_statistics.tail_bytes) / (1024.0 * 1024.0));
+            int streaming_budget_megabytes = static_cast<int>(streaming_statistics.budget_bytes >> 20);
+            if (ImGui::SliderInt("Texture Streaming Budget (MB)", &streaming_budget_megabytes, 16, 2048))
+            {
+                g_dolas_engine.m_texture_manager->SetStreamingBudget(static_cast<ULongLong>(streaming_budget_megabytes) << 20);
+            }
+            ImGui::Text("Views (cached / created): %u / %u", statistics.view_cache_hits, statistics.view_creations);
+            ImGui::Text("Barriers: %u in %u call(s), ad hoc transitions %u",
+                statistics.resource_barriers,
+                statistics.resource_barrier_calls,
+                statistics.ad_hoc_transitions);
+            if (g_dolas_engine.m_render_hardware_interface)
+            {
+                auto show_descriptor_allocator = [](const char* name, const DescriptorIndexAllocator& allocator)
+                {
+                    ImGui::Text("%s: %u / %u (largest free %u)", name,
+                        allocator.GetAllocatedCount(), allocator.GetCapacity(), allocator.GetLargestFreeRange());
+                };
+                show_descriptor_allocator("RTV Descriptors", g_dolas_engine.m_render_hardware_interface->GetRtvDescriptorAllocator());
+                show_descriptor_allocator("DSV Descriptors", g_dolas_engine.m_render_hardware_interface->GetDsvDescriptorAllocator());
+                show_descriptor_allocator("SRV Descriptors", g_dolas_engine.m_render_hardware_interface->GetSrvDescriptorAllocator());
+            }
+
+            RenderView* main_render_view = g_dolas_engine.m_render_view_manager ? g_dolas_engine.m_render_view_manager->GetMainRenderView() : nullptr;
+            RenderPipeline* render_pipeline = main_render_view ? g_dolas_engine.m_render_pipeline_manager->GetRenderPipelineByID(main_render_view->GetRenderPipelineID()) : nullptr;
+            if (render_pipeline)
+            {
+                static const char* culling_path_names[] = { "Scalar", "SSE", "AVX" };
+                const RenderCullingStatistics& culling_statistics = render_pipeline->GetCullingStatistics();
+                ImGui::Text("Entities (visible / culled / total): %u / %u / %u",
+                    culling_statistics.visible_entity_count,
+                    culling_statistics.culled_entity_count,
+                    culling_statistics.total_entity_count);
+                ImGui::Text("Frustum Culling: %.3f ms, %u task(s), %s",
+                    culling_statistics.culling_milliseconds,
+                    culling_statistics.culling_task_count,
+                    culling_path_names[static_cast<UInt>(GetFrustumCullingPath())]);
+
+                Bool enable_occlusion_culling = render_pipeline->IsOcclusionCullingEnabled();
+                if (ImGui::Checkbox("Occlusion Culling", &enable_occlusion_culling))
+                {
+                    render_pipeline->SetOcclusionCullingEnabled(enable_occlusion_culling);
+                }
+                ImGui::Text("Occluders: %u (%u triangles), occluded %u, %.3f ms",
+                    culling_statistics.occluder_count,
+                    culling_statistics.occluder_triangle_count,
+                    culling_statistics.occluded_entity_count,
+                    culling_statistics.occlusion_milliseconds);
+
+                Bool enable_mesh_lod = render_pipeline->IsMeshLODEnabled();
+                if (ImGui::Checkbox("Mesh LOD", &enable_mesh_lod))
+                {
+                    render_pipeline->SetMeshLODEnabled(enable_mesh_lod);
+                }
+                const RenderMeshLODStatistics& lod_statistics = render_pipeline->GetMeshLODStatistics();
+                ImGui::Text("GBuffer Triangles (LOD / full detail): %u / %u, %u reduced component(s)",
+                    lod_statistics.rendered_triangle_count,
+                    lod_statistics.full_detail_triangle_count,
+                    lod_statistics.reduced_component_count);
+
+                Bool enable_cluster_culling = render_pipeline->IsClusterCullingEnabled();
+                if (ImGui::Checkbox("Cluster Culling", &enable_cluster_culling))
+                {
+                    render_pipeline->SetClusterCullingEnabled(enable_cluster_culling);
+                }
+                const RenderClusterCullingStatistics& cluster_statistics = render_pipeline->GetClusterCullingStatistics();
+                ImGui::Text("Meshlets: %u visible / %u, frustum culled %u, backface culled %u (%.3f ms)",
+                    cluster_statistics.visible_meshlet_count,
+                    cluster_statistics.meshlet_count,
+                    cluster_statistics.frustum_culled_meshlet_count,
+                    cluster_statistics.backface_culled_meshlet_count,
+                    cluster_statistics.culling_milliseconds);
+                ImGui::Text("Cluster Triangles (submitted / source): %u / %u",
+                    cluster_statistics.submitted_triangle_count,
+                    cluster_statistics.source_triangle_count);
+
+                const RenderLightClusteringStatistics& light_statistics = render_pipeline->GetLightClusteringStatistics();
+                ImGui::Text("Local Lights: %u in %u clusters, %u index(es), max %u per cluster",
+                    light_statistics.local_light_count,
+                    light_statistics.cluster_count,
+                    light_statistics.light_index_count,
+                    light_statistics.max_cluster_light_count);
+                ImGui::Text("Light Clustering: %.3f ms, %u task(s), %s",
+                    light_statistics.assignment_milliseconds,
+                    light_statistics.assignment_task_count,
+                    culling_path_names[static_cast<UInt>(GetLightClusteringPath())]);
+
+                Bool enable_shadows = render_pipeline->IsShadowsEnabled();
+                if (ImGui::Checkbox("Cascaded Shadows", &enable_shadows))
+                {
+                    render_pipeline->SetShadowsEnabled(enable_shadows);
+                }
+                const RenderShadowStatistics& shadow_statistics = render_pipeline->GetShadowStatistics();
+                ImGui::Text("Shadow Fitting: %.3f ms, %u cascade(s), %u entities",
+                    shadow_statistics.fitting_milliseconds,
+                    shadow_statistics.cascade_count,
+                    shadow_statistics.total_entity_count);
+                for (UInt cascade_index = 0; cascade_index < shadow_statistics.cascade_count; ++cascade_index)
+                {
+                    const RenderShadowCascadeStatistics& cascade_statistics = shadow_statistics.cascades[cascade_index];
+                    ImGui::Text("  Cascade %u: %u caster(s), %u draw(s), %u triangles, cull %.3f ms, record %.3f ms",
+                        cascade_index,
+                        cascade_statistics.caster_count,
+                        cascade_statistics.draw_count,
+                        cascade_statistics.triangle_count,
+                        cascade_statistics.culling_milliseconds,
+                        cascade_statistics.record_milliseconds);
+                }
+
+                const RenderGraphStatistics& graph_statistics = render_pipeline->GetRenderGraphStatistics();
+                ImGui::Text("Render Graph: %u pass(es), %u culled, %.3f ms",
+                    graph_statistics.pass_count,
+                    graph_statistics.culled_pass_count,
+                    graph_statistics.build_milliseconds);
+                ImGui::Text("Graph Barriers: %u transition, %u aliasing, %u batch(es)",
+                    graph_statistics.transition_barrier_count,
+                    graph_statistics.aliasing_barrier_count,
+                    graph_statistics.barrier_batch_count);
+                ImGui::Text("Transient Memory (aliased / unaliased): %.1f / %.1f MB%s",
+                    graph_statistics.transient_heap_size / (1024.0 * 1024.0),
+                    graph_statistics.unaliased_heap_size / (1024.0 * 1024.0),
+                    graph_statistics.transient_heap_placed ? "" : " (committed)");
+
+                Bool enable_depth_prepass = main_render_view->IsDepthPrePassEnabled();
+                if (ImGui::Checkbox("Depth Pre-Pass", &enable_depth_prepass))
+                {
+                    main_render_view->SetDepthPrePassEnabled(enable_depth_prepass);
+                }
+                Bool enable_gpu_pass_profiling = g_dolas_engine.m_rhi->IsGpuPassProfilingEnabled();
+                if (ImGui::Checkbox("GPU Pass Statistics", &enable_gpu_pass_profiling))
+                {
+                    g_dolas_engine.m_rhi->SetGpuPassProfilingEnabled(enable_gpu_pass_profiling);
+                }
+                // 统计的是上一帧：GPU 结果在 Present 等待 GPU 之后才合并
+                const RenderPassStatistics& pass_statistics = render_pipeline->GetPassStatistics();
+                for (const RenderPassTiming& pass_timing : pass_statistics.passes)
+                {
+                    if (pass_timing.has_gpu_statistics)
+                    {
+                        ImGui::Text("  %s: CPU %.3f ms, GPU %.3f ms, %llu prim(s), %llu PS invocation(s)",
+                            pass_timing.name.c_str(),
+                            pass_timing.cpu_milliseconds,
+                            pass_timing.gpu_milliseconds,
+                            pass_timing.rasterized_primitive_count,
+                            pass_timing.pixel_shader_invocation_count);
+                    }
+                    else
+                    {
+                        ImGui::Text("  %s: CPU %.3f ms", pass_timing.name.c_str(), pass_timing.cpu_milliseconds);
+                    }
+                }
+                if (pass_statistics.gbuffer_shading_rate > 0.0)
+                {
+                    ImGui::Text("GBuffer Overdraw: %.2f PS invocation(s) / pixel%s",
+                        pass_statistics.gbuffer_shading_rate,
+                        pass_statistics.depth_prepass_enabled ? " (depth pre-pass)" : "");
+                }
+            }
+        }
+
         ImGui::Separator();
         
         // 视口信息
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <string_view>
@@ -7,6 +8,8 @@
 #include "manager/dolas_shader_manager.h"
 #include "manager/dolas_material_manager.h"
 #include "render/dolas_material.h"
+#include "render/dolas_rhi.h"
+#include "render/dolas_texture.h"
 #include "dolas_base.h"
 #include "render/dolas_dx_trace.h"
 #include "dolas_asset_path.h"
@@ -20,7 +23,8 @@ namespace Dolas
         k_global_material_asset_paths = {
             "_engine/global_material/deferred_shading.material",
             "_engine/global_material/sky_box.material",
-            "_engine/global_material/debug_draw.material"
+            "_engine/global_material/debug_draw.material",
+            "_engine/global_material/depth_only.material"
         };
 
     MaterialManager::MaterialManager()
@@ -103,7 +107,7 @@ namespace Dolas
         // 顶点着色器
         if (material_desc->vertex_shader)
         {
-            material->m_vertex_context = CreateVertexContext(material_desc->vertex_shader->GetPath(), "VS");
+            material->m_vertex_context = CreateVertexContext(material_desc->vertex_shader->GetPath(), "VS", material_desc->shader_keywords);
             if (!material->m_vertex_context)
             {
                 LOG_ERROR("Failed to create vertex shader for material {0}", asset_path.GetCanonicalPath());
@@ -115,7 +119,7 @@ namespace Dolas
         // 像素着色器
         if (material_desc->pixel_shader)
         {
-            material->m_pixel_context = CreatePixelContext(material_desc->pixel_shader->GetPath(), "PS");
+            material->m_pixel_context = CreatePixelContext(material_desc->pixel_shader->GetPath(), "PS", material_desc->shader_keywords);
             if (!material->m_pixel_context)
             {
                 LOG_ERROR("Failed to create pixel shader for material {0}", asset_path.GetCanonicalPath());
@@ -124,6 +128,33 @@ namespace Dolas
             }
         }
 
+        // VS / PS 都没有声明的 keyword 多半是拼写错误，否则会悄悄退回到默认变体
+        for (const std::string& keyword : material_desc->shader_keywords)
+        {
+            const auto uses_keyword = [&keyword](const ShaderContext* shader_context)
+            {
+                if (!shader_context)
+                {
+                    return false;
+                }
+                const std::vector<std::string>& keywords = shader_context->GetShaderKeywords();
+                return std::find(keywords.begin(), keywords.end(), keyword) != keywords.end();
+            };
+            if (!uses_keyword(material->m_vertex_context.get()) && !uses_keyword(material->m_pixel_context.get()))
+            {
+                LOG_WARN("Shader keyword {0} of material {1} is not declared by its shaders", keyword, asset_path.GetCanonicalPath());
+            }
+        }
+
+        // 按磁盘管线缓存中记录过的状态组合，在工作线程中提前创建 PSO，避免首次绘制时卡顿
+        if (material->m_vertex_context && material->m_pixel_context)
+        {
+            g_dolas_engine.m_rhi->PrecompilePipelineStates(material->m_vertex_context, material->m_pixel_context);
+        }
+
+        // 材质参数写入材质自己的参数块；共享的 shader context 只保存 shader 本身的状态
+        material->AllocateParameterBlocks();
+
         // 纹理（目前只做 pixel_shader_texture，跟你现有 content 对齐）
         if (material->m_pixel_context)
         {
@@ -133,14 +164,16 @@ namespace Dolas
                 const AssetPath& texture_asset_path = kv.second.GetPath();
 
 				TextureID texture_id = TEXTURE_ID_EMPTY;
+				// 纹理异步加载，完成之前法线贴图显示为平坦法线，其余显示为灰色
+				const TexturePlaceholder placeholder = texture_name == "normal_map" ? TexturePlaceholder::FlatNormal : TexturePlaceholder::Grey;
 				const std::string_view relative_path = texture_asset_path.GetRelativePath();
 				if (relative_path.ends_with(".dds") || relative_path.ends_with(".DDS"))
                 {
-                    texture_id = g_dolas_engine.m_texture_manager->CreateTextureFromDDSFile(texture_asset_path);
+                    texture_id = g_dolas_engine.m_texture_manager->CreateTextureFromDDSFile(texture_asset_path, placeholder);
                 }
                 else if (relative_path.ends_with(".png") || relative_path.ends_with(".PNG"))
                 {
-                    texture_id = g_dolas_engine.m_texture_manager->CreateTextureFromPNGFile(texture_asset_path);
+                    texture_id = g_dolas_engine.m_texture_manager->CreateTextureFromPNGFile(texture_asset_path, placeholder);
                 }
                 else
                 {
@@ -158,20 +191,21 @@ namespace Dolas
                 else if (texture_name == "metallic_map") slot = 3;
 
                 material->m_pixel_context->SetShaderResourceView(slot, texture_id);
+                material->m_texture_ids.push_back(texture_id);
+
+                // bindless 模式下 shader 通过 GlobalConstants 中的 "<texture_name>_index" 访问纹理
+                if (Texture* texture = g_dolas_engine.m_texture_manager->GetTextureByTextureID(texture_id))
+                {
+                    material->SetPixelParameter(texture_name + "_index", static_cast<UInt>(texture->GetBindlessIndex()));
+                }
             }
         }
 
         // 全局变量
-        if (material->m_vertex_context)
-        {
-            for (const auto& kv : material_desc->vertex_shader_global_variables)
-                material->m_vertex_context->SetGlobalVariable(kv.first, kv.second);
-        }
-        if (material->m_pixel_context)
-        {
-            for (const auto& kv : material_desc->pixel_shader_global_variables)
-                material->m_pixel_context->SetGlobalVariable(kv.first, kv.second);
-        }
+        for (const auto& kv : material_desc->vertex_shader_global_variables)
+            material->SetVertexParameter(kv.first, kv.second);
+        for (const auto& kv : material_desc->pixel_shader_global_variables)
+            material->SetPixelParameter(kv.first, kv.second);
 
         m_materials[material->m_file_id] = material;
         return material->m_file_id;
@@ -189,14 +223,14 @@ namespace Dolas
 	}
 
 	// protected methods
-    std::shared_ptr<VertexContext> MaterialManager::CreateVertexContext(const AssetPath& asset_path, const std::string& entry_point)
+    std::shared_ptr<VertexContext> MaterialManager::CreateVertexContext(const AssetPath& asset_path, const std::string& entry_point, const std::vector<std::string>& keywords)
     {
         // 通过 ShaderManager 复用/创建底层 VertexContext
-        return g_dolas_engine.m_shader_manager->GetOrCreateVertexContext(asset_path, entry_point);
+        return g_dolas_engine.m_shader_manager->GetOrCreateVertexContext(asset_path, entry_point, keywords);
     }
 
-    std::shared_ptr<PixelContext> MaterialManager::CreatePixelContext(const AssetPath& asset_path, const std::string& entry_point)
+    std::shared_ptr<PixelContext> MaterialManager::CreatePixelContext(const AssetPath& asset_path, const std::string& entry_point, const std::vector<std::string>& keywords)
     {
-        return g_dolas_engine.m_shader_manager->GetOrCreatePixelContext(asset_path, entry_point);
+        return g_dolas_engine.m_shader_manager->GetOrCreatePixelContext(asset_path, entry_point, keywords);
     }
 } // namespace Dolas
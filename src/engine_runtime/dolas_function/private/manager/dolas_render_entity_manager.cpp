@@ -63,9 +63,7 @@ namespace Dolas
         // 创建 RenderEntity
         RenderEntity* render_entity = DOLAS_NEW(RenderEntity);
         render_entity->m_file_id = HashConverter::StringHash(asset_path.GetCanonicalPath());
-        render_entity->m_pose.m_postion = position;
-        render_entity->m_pose.m_rotation = rotation;
-        render_entity->m_pose.m_scale = scale;
+        render_entity->SetPose(Pose(position, rotation, scale));
 
         // 遍历所有 Mesh 并加载
         for (const auto& mesh_ref : entity_desc->meshes)
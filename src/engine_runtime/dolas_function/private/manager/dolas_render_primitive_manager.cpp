@@ -131,12 +131,23 @@ namespace Dolas
             topology = PrimitiveTopology::PrimitiveTopology_TriangleStrip;
         }
 
+        // LOD 由 dolas_mesh_cooker 离线生成并写回 .mesh，只对三角形列表有效
+        std::vector<MeshLOD> lods;
+        if (topology == PrimitiveTopology::PrimitiveTopology_TriangleList)
+        {
+            for (const MeshLODDesc& lod_desc : mesh_desc->lods)
+            {
+                lods.push_back({ lod_desc.indices, lod_desc.error, lod_desc.screen_size });
+            }
+        }
+
         Bool success = CreateRenderPrimitive(
             primitive_id,
             topology,
             layout_type,
             vertices,
-            mesh_desc->indices);
+            mesh_desc->indices,
+            lods);
 
         if (!success)
         {
@@ -144,9 +155,71 @@ namespace Dolas
             return RENDER_PRIMITIVE_ID_EMPTY;
         }
 
+        if (topology == PrimitiveTopology::PrimitiveTopology_TriangleList)
+        {
+            RenderPrimitive* render_primitive = GetRenderPrimitiveByID(primitive_id);
+            if (!mesh_desc->meshlets.empty())
+            {
+                if (!LoadCookedMeshlets(*mesh_desc, render_primitive->m_meshlets))
+                {
+                    LOG_ERROR("Mesh file {0} has invalid meshlet data, cluster culling disabled for it", asset_path.GetCanonicalPath());
+                }
+            }
+            else if (m_build_meshlets_on_load)
+            {
+                const UInt vertex_count = static_cast<UInt>(mesh_desc->position.size() / 3);
+                BuildMeshlets(mesh_desc->position.data(), vertex_count, 3, mesh_desc->indices, render_primitive->m_meshlets);
+            }
+        }
+
         return primitive_id;
     }
 
+    Bool RenderPrimitiveManager::LoadCookedMeshlets(const MeshAssetDesc& mesh_desc, MeshletData& out_meshlets)
+    {
+        out_meshlets.Clear();
+        const std::size_t vertex_count = mesh_desc.position.size() / 3;
+        for (UInt vertex : mesh_desc.meshlet_vertices)
+        {
+            if (vertex >= vertex_count) return false;
+        }
+
+        // 区间越界的数据直接丢弃，避免剔除时读越界
+        for (const MeshletDesc& meshlet_desc : mesh_desc.meshlets)
+        {
+            if ((std::size_t)meshlet_desc.vertex_offset + meshlet_desc.vertex_count > mesh_desc.meshlet_vertices.size() ||
+                ((std::size_t)meshlet_desc.triangle_offset + meshlet_desc.triangle_count) * 3 > mesh_desc.meshlet_triangles.size())
+            {
+                out_meshlets.Clear();
+                return false;
+            }
+            for (UInt i = 0; i < meshlet_desc.triangle_count * 3; ++i)
+            {
+                if (mesh_desc.meshlet_triangles[meshlet_desc.triangle_offset * 3 + i] >= meshlet_desc.vertex_count)
+                {
+                    out_meshlets.Clear();
+                    return false;
+                }
+            }
+
+            Meshlet meshlet;
+            meshlet.vertex_offset = meshlet_desc.vertex_offset;
+            meshlet.vertex_count = meshlet_desc.vertex_count;
+            meshlet.triangle_offset = meshlet_desc.triangle_offset;
+            meshlet.triangle_count = meshlet_desc.triangle_count;
+            meshlet.bounds = BoundingSphere(
+                Vector3(meshlet_desc.bounding_sphere[0], meshlet_desc.bounding_sphere[1], meshlet_desc.bounding_sphere[2]),
+                meshlet_desc.bounding_sphere[3]);
+            meshlet.cone_apex = Vector3(meshlet_desc.cone_apex[0], meshlet_desc.cone_apex[1], meshlet_desc.cone_apex[2]);
+            meshlet.cone_axis = Vector3(meshlet_desc.cone_axis[0], meshlet_desc.cone_axis[1], meshlet_desc.cone_axis[2]);
+            meshlet.cone_cutoff = meshlet_desc.cone_cutoff;
+            out_meshlets.meshlets.push_back(meshlet);
+        }
+        out_meshlets.vertices = mesh_desc.meshlet_vertices;
+        out_meshlets.triangles = mesh_desc.meshlet_triangles;
+        return true;
+    }
+
 	Bool RenderPrimitiveManager::InitializeSphereGeometry()
 	{
 		RenderPrimitiveManager* render_primitive_manager = g_dolas_engine.m_render_primitive_manager;
@@ -683,7 +756,8 @@ namespace Dolas
 		const PrimitiveTopology& render_primitive_type,
 		const InputLayoutType& input_layout_type,
 		const std::vector<std::vector<Float>>& vertices,
-		const std::vector<UInt>& indices)
+		const std::vector<UInt>& indices,
+		const std::vector<MeshLOD>& lods)
     {
         // vertex buffers
         std::vector<BufferID> vertex_buffer_ids;
@@ -813,22 +887,43 @@ namespace Dolas
 			vertex_offsets.push_back(0); // assume offset is 0
         }
         
-        // index buffer
+        // index buffer：LOD0 在前，各级 LOD 的索引依次拼接在同一个缓冲里，绘制时按区间选择
         const std::size_t ic = indices.size();
-        if (ic > (std::size_t)(std::numeric_limits<UInt>::max)())
+        std::size_t total_index_count = ic;
+        for (const MeshLOD& lod : lods)
+        {
+            total_index_count += lod.indices.size();
+        }
+        if (total_index_count > (std::size_t)(std::numeric_limits<UInt>::max)())
         {
-            LOG_ERROR("RenderPrimitiveManager::BuildFromRawData: index_count overflow ({0})", ic);
+            LOG_ERROR("RenderPrimitiveManager::BuildFromRawData: index_count overflow ({0})", total_index_count);
             return nullptr;
         }
         UInt index_count = (UInt)ic;
 
-        const std::size_t index_bytes_sz = ic * sizeof(UInt);
+        std::vector<RenderPrimitiveLOD> primitive_lods;
+        primitive_lods.push_back({ 0, index_count, 0.0f, 0.0f });
+        std::vector<UInt> lod_indices;
+        if (!lods.empty())
+        {
+            lod_indices.reserve(total_index_count);
+            lod_indices.insert(lod_indices.end(), indices.begin(), indices.end());
+            for (const MeshLOD& lod : lods)
+            {
+                if (lod.indices.empty()) continue;
+                primitive_lods.push_back({ (UInt)lod_indices.size(), (UInt)lod.indices.size(), lod.error, lod.screen_size });
+                lod_indices.insert(lod_indices.end(), lod.indices.begin(), lod.indices.end());
+            }
+        }
+        const std::vector<UInt>& buffer_indices = lods.empty() ? indices : lod_indices;
+
+        const std::size_t index_bytes_sz = buffer_indices.size() * sizeof(UInt);
         if (index_bytes_sz > (std::size_t)(std::numeric_limits<std::uint32_t>::max)())
         {
             LOG_ERROR("RenderPrimitiveManager::BuildFromRawData: index buffer size overflow ({0})", index_bytes_sz);
             return nullptr;
         }
-        BufferID index_buffer_id = g_dolas_engine.m_buffer_manager->CreateIndexBuffer((std::uint32_t)index_bytes_sz, indices.data());
+        BufferID index_buffer_id = g_dolas_engine.m_buffer_manager->CreateIndexBuffer((std::uint32_t)index_bytes_sz, buffer_indices.data());
 		if (index_buffer_id == BUFFER_ID_EMPTY)
 		{
 			LOG_ERROR("RenderPrimitiveManager::BuildFromRawData: Failed to create index buffer");
@@ -843,9 +938,28 @@ namespace Dolas
 		render_primitive->m_vertex_offsets = vertex_offsets;
 		render_primitive->m_vertex_count = vertex_count;
 		render_primitive->m_index_count = index_count;
+		render_primitive->m_lods = primitive_lods;
+		for (const RenderPrimitiveLOD& lod : primitive_lods)
+		{
+			render_primitive->m_lod_screen_sizes.push_back(lod.m_screen_size);
+		}
 		render_primitive->m_vertex_buffer_ids = vertex_buffer_ids;
 		render_primitive->m_index_buffer_id = index_buffer_id;
 
+		// 所有输入布局的 stream 0 都是紧密排列的 xyz 位置
+		if (!vertices.empty() && !vertices[0].empty())
+		{
+			const std::size_t position_count = vertices[0].size() / 3;
+			render_primitive->m_local_bounds = BoundingBox::FromPositions(vertices[0].data(), position_count);
+			render_primitive->m_local_bounding_sphere = BoundingSphere::FromPositions(vertices[0].data(), position_count);
+		}
+
+		if (render_primitive_type == PrimitiveTopology_TriangleList && !vertices.empty())
+		{
+			render_primitive->m_occluder_positions = vertices[0];
+			render_primitive->m_occluder_indices = indices;
+		}
+
         return render_primitive;
     }
 
@@ -854,9 +968,10 @@ namespace Dolas
         const PrimitiveTopology& render_primitive_type,
         const InputLayoutType& input_layout_type,
         const std::vector<std::vector<Float>>& vertices,
-		const std::vector<UInt>& indices)
+		const std::vector<UInt>& indices,
+		const std::vector<MeshLOD>& lods /*= {}*/)
     {
-		RenderPrimitive* render_primitive = BuildFromRawData(render_primitive_type, input_layout_type, vertices, indices);
+		RenderPrimitive* render_primitive = BuildFromRawData(render_primitive_type, input_layout_type, vertices, indices, lods);
 
         if (render_primitive)
         {
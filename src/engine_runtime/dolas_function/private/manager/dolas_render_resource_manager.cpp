@@ -3,9 +3,55 @@
 #include "dolas_log_system_manager.h"
 #include "manager/dolas_texture_manager.h"
 #include "render/dolas_rhi.h"
+#include "dolas_render_hardware_interface.h"
+#include "dolas_cascaded_shadow.h"
+#include <d3d12.h>
 #include <vector>
 namespace Dolas
 {
+    namespace
+    {
+        template <typename T>
+        void SafeRelease(T*& ptr)
+        {
+            if (ptr)
+            {
+                ptr->Release();
+                ptr = nullptr;
+            }
+        }
+
+        // 渲染图瞬态纹理的共享堆只放 render target / depth stencil（resource heap tier 1 要求按资源类别分堆）
+        ID3D12Heap* CreateTransientHeap(ULongLong heap_size)
+        {
+            RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+            ID3D12Device* device = rhi ? rhi->GetDevice() : nullptr;
+            if (!device || heap_size == 0)
+            {
+                return nullptr;
+            }
+
+            D3D12_HEAP_DESC heap_desc = {};
+            heap_desc.SizeInBytes = heap_size;
+            heap_desc.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+            heap_desc.Properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+            heap_desc.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+            heap_desc.Properties.CreationNodeMask = 1;
+            heap_desc.Properties.VisibleNodeMask = 1;
+            heap_desc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+            heap_desc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+
+            ID3D12Heap* heap = nullptr;
+            HRESULT hr = device->CreateHeap(&heap_desc, IID_PPV_ARGS(&heap));
+            if (FAILED(hr))
+            {
+                LOG_WARN("RenderResourceManager: failed to create transient heap of {0} bytes, HRESULT: 0x{1:X}", heap_size, hr);
+                return nullptr;
+            }
+            return heap;
+        }
+    }
+
     RenderResourceManager::RenderResourceManager()
     {
     }
@@ -24,6 +70,8 @@ namespace Dolas
         for (auto resource_iter = m_render_resources.begin(); resource_iter != m_render_resources.end(); ++resource_iter)
         {
             RenderResource* render_resource = resource_iter->second;
+            // 纹理已由 TextureManager 释放，这里只归还共享堆
+            SafeRelease(render_resource->m_transient_heap);
             DOLAS_DELETE(render_resource);
         }
         m_render_resources.clear();
@@ -37,6 +85,11 @@ namespace Dolas
     }
 
     Bool RenderResourceManager::CreateRenderResourceByID(RenderResourceID render_resource_id)
+    {
+        return CreateRenderResourceByID(render_resource_id, DEFAULT_CLIENT_WIDTH, DEFAULT_CLIENT_HEIGHT);
+    }
+
+    Bool RenderResourceManager::CreateRenderResourceByID(RenderResourceID render_resource_id, UInt width, UInt height)
     {
         DOLAS_RETURN_FALSE_IF_FALSE(m_render_resources.find(render_resource_id) == m_render_resources.end());
 
@@ -55,12 +108,14 @@ namespace Dolas
             DOLAS_DELETE(render_resource);
         };
 
-        auto create_required_texture = [&](TextureID texture_id, DolasTextureFormat texture_format, DolasTextureUsage texture_usage, TextureID& output_texture_id) -> Bool
+        // texture_width / texture_height 为 0 时与视口同尺寸
+        auto create_required_texture = [&](TextureID texture_id, DolasTextureFormat texture_format, DolasTextureUsage texture_usage, TextureID& output_texture_id,
+            UInt texture_width = 0, UInt texture_height = 0) -> Bool
         {
             DolasTexture2DDesc desc;
             desc.texture_handle = texture_id;
-            desc.width = DEFAULT_CLIENT_WIDTH;
-            desc.height = DEFAULT_CLIENT_HEIGHT;
+            desc.width = texture_width > 0 ? texture_width : width;
+            desc.height = texture_height > 0 ? texture_height : height;
             desc.format = texture_format;
             desc.usage = texture_usage;
             desc.generateMips = false;
@@ -74,11 +129,21 @@ namespace Dolas
 
             output_texture_id = texture_id;
             created_texture_ids.push_back(texture_id);
+
+            // 先以独立分配创建，渲染图编译出堆内偏移后再放置到共享堆中
+            RenderResourceTransientTexture transient_texture;
+            transient_texture.m_desc = desc;
+            if (!texture_manager->GetTexture2DAllocationInfo(desc, transient_texture.m_allocation_size, transient_texture.m_allocation_alignment))
+            {
+                LOG_WARN("RenderResourceManager::CreateRenderResourceByID: texture {0} will not be aliased", ID_TO_STRING(texture_id));
+            }
+            render_resource->m_transient_textures.push_back(transient_texture);
             return true;
         };
 
+        // 紧凑 GBuffer，布局见 content/shader/gbuffer_packing.hlsli
 		TextureID gbuffer_a_texture_id = STRING_ID(gbuffer_a_map);
-        if (!create_required_texture(gbuffer_a_texture_id, DolasTextureFormat::R8G8B8A8_UNORM, DolasTextureUsage::RenderTarget, render_resource->m_gbuffer_a_id))
+        if (!create_required_texture(gbuffer_a_texture_id, DolasTextureFormat::R10G10B10A2_UNORM, DolasTextureUsage::RenderTarget, render_resource->m_gbuffer_a_id))
         {
             rollback_created_textures();
             return false;
@@ -91,29 +156,24 @@ namespace Dolas
             return false;
         }
 
-        TextureID gbuffer_c_texture_id = STRING_ID(gbuffer_c_map);
-        if (!create_required_texture(gbuffer_c_texture_id, DolasTextureFormat::R8G8B8A8_UNORM, DolasTextureUsage::RenderTarget, render_resource->m_gbuffer_c_id))
+        TextureID depth_stencil_texture_id = STRING_ID(depth_stencil_map);
+        if (!create_required_texture(depth_stencil_texture_id, DolasTextureFormat::R24G8_TYPELESS, DolasTextureUsage::DepthStencil, render_resource->m_depth_stencil_id))
         {
             rollback_created_textures();
             return false;
         }
 
-		TextureID gbuffer_d_texture_id = STRING_ID(gbuffer_d_map);
-		if (!create_required_texture(gbuffer_d_texture_id, DolasTextureFormat::R8G8B8A8_UNORM, DolasTextureUsage::RenderTarget, render_resource->m_gbuffer_d_id))
-		{
-            rollback_created_textures();
-            return false;
-		}
-
-        TextureID depth_stencil_texture_id = STRING_ID(depth_stencil_map);
-        if (!create_required_texture(depth_stencil_texture_id, DolasTextureFormat::R24G8_TYPELESS, DolasTextureUsage::DepthStencil, render_resource->m_depth_stencil_id))
+        TextureID scene_result_texture_id = STRING_ID(scene_result_map);
+        if (!create_required_texture(scene_result_texture_id, DolasTextureFormat::R8G8B8A8_UNORM, DolasTextureUsage::RenderTarget, render_resource->m_scene_result_id))
         {
             rollback_created_textures();
             return false;
         }
 
-        TextureID scene_result_texture_id = STRING_ID(scene_result_map);
-        if (!create_required_texture(scene_result_texture_id, DolasTextureFormat::R8G8B8A8_UNORM, DolasTextureUsage::RenderTarget, render_resource->m_scene_result_id))
+        const CascadeShadowDesc shadow_desc;
+        TextureID shadow_map_texture_id = STRING_ID(shadow_map);
+        if (!create_required_texture(shadow_map_texture_id, DolasTextureFormat::R32_TYPELESS, DolasTextureUsage::DepthStencil, render_resource->m_shadow_map_id,
+            shadow_desc.GetAtlasWidth(), shadow_desc.GetAtlasHeight()))
         {
             rollback_created_textures();
             return false;
@@ -122,4 +182,75 @@ namespace Dolas
         m_render_resources[render_resource_id] = render_resource;
         return true;
     }
+
+    Bool RenderResourceManager::PlaceTransientTextures(RenderResourceID render_resource_id, const std::vector<ULongLong>& heap_offsets, ULongLong heap_size)
+    {
+        RenderResource* render_resource = GetRenderResourceByID(render_resource_id);
+        DOLAS_RETURN_FALSE_IF_NULL(render_resource);
+        TextureManager* texture_manager = g_dolas_engine.m_texture_manager;
+        DOLAS_RETURN_FALSE_IF_NULL(texture_manager);
+
+        std::vector<RenderResourceTransientTexture>& transient_textures = render_resource->m_transient_textures;
+        if (render_resource->m_transient_placement_failed || heap_offsets.size() != transient_textures.size() || heap_size == 0)
+        {
+            return false;
+        }
+
+        Bool layout_changed = render_resource->m_transient_heap == nullptr || render_resource->m_transient_heap_size != heap_size;
+        for (std::size_t i = 0; i < transient_textures.size(); ++i)
+        {
+            if (heap_offsets[i] != kRenderResourceNotPlaced && transient_textures[i].m_allocation_size == 0)
+            {
+                return false;
+            }
+            layout_changed = layout_changed || transient_textures[i].m_heap_offset != heap_offsets[i];
+        }
+        if (!layout_changed)
+        {
+            return true;
+        }
+
+        // 纹理以原 ID 重建：新资源创建成功后才释放旧资源，缓存的 RTV / DSV 随旧纹理一并回收
+        ID3D12Heap* heap = CreateTransientHeap(heap_size);
+        Bool placed = heap != nullptr;
+        for (std::size_t i = 0; placed && i < transient_textures.size(); ++i)
+        {
+            DolasTexture2DDesc desc = transient_textures[i].m_desc;
+            if (heap_offsets[i] != kRenderResourceNotPlaced)
+            {
+                desc.placedHeap = heap;
+                desc.placedHeapOffset = heap_offsets[i];
+            }
+            placed = texture_manager->DolasCreateTexture2D(desc);
+        }
+
+        ID3D12Heap* old_heap = render_resource->m_transient_heap;
+        if (placed)
+        {
+            for (std::size_t i = 0; i < transient_textures.size(); ++i)
+            {
+                transient_textures[i].m_heap_offset = heap_offsets[i];
+            }
+            render_resource->m_transient_heap = heap;
+            render_resource->m_transient_heap_size = heap_size;
+            SafeRelease(old_heap);
+            return true;
+        }
+
+        LOG_WARN("RenderResourceManager::PlaceTransientTextures: falling back to committed render targets");
+        render_resource->m_transient_placement_failed = true;
+        for (RenderResourceTransientTexture& transient_texture : transient_textures)
+        {
+            if (!texture_manager->DolasCreateTexture2D(transient_texture.m_desc))
+            {
+                LOG_ERROR("RenderResourceManager::PlaceTransientTextures: failed to recreate texture {0}", ID_TO_STRING(transient_texture.m_desc.texture_handle));
+            }
+            transient_texture.m_heap_offset = kRenderResourceNotPlaced;
+        }
+        render_resource->m_transient_heap = nullptr;
+        render_resource->m_transient_heap_size = 0;
+        SafeRelease(old_heap);
+        SafeRelease(heap);
+        return false;
+    }
 }
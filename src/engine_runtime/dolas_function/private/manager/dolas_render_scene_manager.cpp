@@ -84,7 +84,7 @@ namespace Dolas
             RenderEntityID render_entity_id = g_dolas_engine.m_render_entity_manager->CreateRenderEntityFromFile(entity_asset_path, position, rotation, scale);
             if (render_entity_id != RENDER_ENTITY_ID_EMPTY)
             {
-                render_scene->m_render_entities.push_back(render_entity_id);
+                render_scene->AddRenderEntity(render_entity_id);
             }
         }
 
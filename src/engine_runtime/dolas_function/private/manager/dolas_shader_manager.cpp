@@ -3,11 +3,27 @@
 #include "dolas_base.h"
 #include "dolas_paths.h"
 #include "render/dolas_dx_trace.h"
+#include <chrono>
 #include <iostream>
 #include <fstream>
+#include <iterator>
 #include "dolas_log_system_manager.h"
+#include "dolas_shader_reflection.h"
 namespace Dolas
 {
+    namespace
+    {
+        const char* const kShaderManifestFileName = "shader_manifest.txt";
+        // 只有 D3D 后端的产物可以直接加载（SPIR-V 产物仅用于在非 Windows 平台上检查 shader）
+        const char* const kD3DCompilerIdentityPrefix = "d3dcompiler";
+
+        Double ElapsedMilliseconds(std::chrono::high_resolution_clock::time_point start_time)
+        {
+            const auto duration = std::chrono::high_resolution_clock::now() - start_time;
+            return std::chrono::duration<Double, std::milli>(duration).count();
+        }
+    }
+
     ShaderManager::ShaderManager()
     {
 
@@ -20,6 +36,25 @@ namespace Dolas
     
     bool ShaderManager::Initialize()
     {
+        const std::string manifest_path = PathUtils::GetCompiledShadersDir() + kShaderManifestFileName;
+        m_precompiled_manifest_loaded = m_precompiled_manifest.Load(manifest_path) &&
+            m_precompiled_manifest.GetCompilerIdentity().rfind(kD3DCompilerIdentityPrefix, 0) == 0;
+        if (!m_precompiled_manifest_loaded)
+        {
+            LOG_INFO("No precompiled shaders in {0}, shaders will be compiled at runtime", PathUtils::GetCompiledShadersDir());
+            return true;
+        }
+        LOG_INFO("Loaded shader manifest {0}: {1} variant(s), compiler = {2}",
+            manifest_path, m_precompiled_manifest.GetEntries().size(), m_precompiled_manifest.GetCompilerIdentity());
+
+#if !defined(NDEBUG)
+        // 开发时 shader 经常在离线编译之后被修改：扫描源文件只需要读文件，比逐个重新编译便宜得多
+        m_check_precompiled_staleness = true;
+        if (!m_shader_source_graph.BuildFromDirectory(PathUtils::GetShadersSourceDir()))
+        {
+            LOG_WARN("Failed to scan shader sources in {0}", PathUtils::GetShadersSourceDir());
+        }
+#endif
         return true;
     }
 
@@ -46,19 +81,34 @@ namespace Dolas
             }
         }
         m_pixel_shaders.clear();
+
+        m_precompiled_manifest.Clear();
+        m_precompiled_manifest_loaded = false;
+        m_shader_source_graph.Clear();
+        m_keyword_declarations.clear();
         return true;
     }
 
-	std::shared_ptr<VertexContext> ShaderManager::GetOrCreateVertexContext(const AssetPath& asset_path, const std::string& entry_point)
+	std::shared_ptr<VertexContext> ShaderManager::GetOrCreateVertexContext(const AssetPath& asset_path, const std::string& entry_point, const std::vector<std::string>& keywords /*= {}*/)
 	{
-        const std::string key = GenerateShaderKey(asset_path, entry_point);
+        const auto shader_path = PathUtils::ResolveAssetPath(asset_path);
+        if (!shader_path)
+        {
+            LOG_ERROR("Failed to resolve vertex shader asset path: {0}", asset_path.GetCanonicalPath());
+            return nullptr;
+        }
+        const std::string shader_file_path = shader_path->string();
+
+        std::vector<std::string> shader_keywords;
+        ResolveShaderKeywords(shader_file_path, keywords, shader_keywords);
+        const ULongLong key = GenerateShaderKey(asset_path, entry_point, ComputeShaderPermutationKey(shader_keywords));
         
         VertexShader* vertex_shader = nullptr;
         auto it = m_vertex_shaders.find(key);
         if (it == m_vertex_shaders.end())
         {
             // 动态类型为 VertexShader，函数返回类型是 VertexContext* 以保持兼容
-            VertexContext* created = CreateVertexShader(asset_path, entry_point);
+            VertexContext* created = CreateVertexShader(shader_file_path, entry_point, shader_keywords);
             if (!created)
             {
                 return nullptr;
@@ -75,15 +125,25 @@ namespace Dolas
         return std::shared_ptr<VertexContext>(vertex_shader, [](VertexContext*) {});
     }
 
-    std::shared_ptr<PixelContext> ShaderManager::GetOrCreatePixelContext(const AssetPath& asset_path, const std::string& entry_point)
+    std::shared_ptr<PixelContext> ShaderManager::GetOrCreatePixelContext(const AssetPath& asset_path, const std::string& entry_point, const std::vector<std::string>& keywords /*= {}*/)
     {
-        const std::string key = GenerateShaderKey(asset_path, entry_point);
+        const auto shader_path = PathUtils::ResolveAssetPath(asset_path);
+        if (!shader_path)
+        {
+            LOG_ERROR("Failed to resolve pixel shader asset path: {0}", asset_path.GetCanonicalPath());
+            return nullptr;
+        }
+        const std::string shader_file_path = shader_path->string();
+
+        std::vector<std::string> shader_keywords;
+        ResolveShaderKeywords(shader_file_path, keywords, shader_keywords);
+        const ULongLong key = GenerateShaderKey(asset_path, entry_point, ComputeShaderPermutationKey(shader_keywords));
 
         PixelShader* pixel_shader = nullptr;
         auto it = m_pixel_shaders.find(key);
         if (it == m_pixel_shaders.end())
         {
-            PixelContext* created = CreatePixelShader(asset_path, entry_point);
+            PixelContext* created = CreatePixelShader(shader_file_path, entry_point, shader_keywords);
             if (!created)
             {
                 return nullptr;
@@ -105,10 +165,9 @@ namespace Dolas
         LOG_INFO("Dump Vertex Shaders...");
         for (auto vertex_shader_iter : m_vertex_shaders)
         {
-            const std::string& shader_name = vertex_shader_iter.first;
             const ShaderContext* shader_ptr = vertex_shader_iter.second;
             LOG_INFO("-----------------------");
-            LOG_INFO("shader name: {0}", shader_name);
+            LOG_INFO("shader name: {0}_{1} [{2}]", shader_ptr->GetFilePath(), shader_ptr->GetEntryPoint(), shader_ptr->GetCompileDefines());
             shader_ptr->dumpShaderReflectionInfo();
             LOG_INFO("-----------------------");
 		}
@@ -116,32 +175,23 @@ namespace Dolas
         LOG_INFO("Dump Pixel Shaders...");
         for (auto pixel_shader_iter : m_pixel_shaders)
         {
-            const std::string& shader_name = pixel_shader_iter.first;
             const ShaderContext* shader_ptr = pixel_shader_iter.second;
             LOG_INFO("-----------------------");
-            LOG_INFO("shader name: {0}", shader_name);
+            LOG_INFO("shader name: {0}_{1} [{2}]", shader_ptr->GetFilePath(), shader_ptr->GetEntryPoint(), shader_ptr->GetCompileDefines());
             shader_ptr->dumpShaderReflectionInfo();
             LOG_INFO("-----------------------");
         }
         LOG_INFO("/*****************************************/");
     }
 
-    VertexContext* ShaderManager::CreateVertexShader(const AssetPath& asset_path, const std::string& entry_point)
+    VertexContext* ShaderManager::CreateVertexShader(const std::string& shader_file_path, const std::string& entry_point, const std::vector<std::string>& keywords)
     {
-        const auto shader_path = PathUtils::ResolveAssetPath(asset_path);
-        if (!shader_path)
-        {
-            LOG_ERROR("Failed to resolve vertex shader asset path: {0}", asset_path.GetCanonicalPath());
-            return nullptr;
-        }
-
-        const std::string shader_file_path = shader_path->string();
-
         // 创建着色器对象
         VertexContext* vertex_context = DOLAS_NEW(VertexContext);
+        vertex_context->SetShaderKeywords(keywords);
         
         // 加载着色器
-        if (!vertex_context->BuildFromFile(shader_file_path, entry_point))
+        if (!BuildShaderContext(vertex_context, shader_file_path, entry_point))
         {
             LOG_ERROR("Failed to load shader from {0}", shader_file_path);
             vertex_context->Release();
@@ -149,24 +199,15 @@ namespace Dolas
             return nullptr;
         }
 
-        vertex_context->PostBuildFromFile();
         LOG_INFO("Successfully created shader from {0}", shader_file_path);
         return vertex_context;
     }
 
-    PixelContext* ShaderManager::CreatePixelShader(const AssetPath& asset_path, const std::string& entry_point)
+    PixelContext* ShaderManager::CreatePixelShader(const std::string& shader_file_path, const std::string& entry_point, const std::vector<std::string>& keywords)
     {
-        const auto shader_path = PathUtils::ResolveAssetPath(asset_path);
-        if (!shader_path)
-        {
-            LOG_ERROR("Failed to resolve pixel shader asset path: {0}", asset_path.GetCanonicalPath());
-            return nullptr;
-        }
-
-        const std::string shader_file_path = shader_path->string();
-
         PixelContext* pixel_context = DOLAS_NEW(PixelContext);
-        if (!pixel_context->BuildFromFile(shader_file_path, entry_point))
+        pixel_context->SetShaderKeywords(keywords);
+        if (!BuildShaderContext(pixel_context, shader_file_path, entry_point))
         {
             LOG_ERROR("Failed to load shader from {0}", shader_file_path);
             pixel_context->Release();
@@ -174,14 +215,129 @@ namespace Dolas
             return nullptr;
         }
 
-        pixel_context->PostBuildFromFile();
         LOG_INFO("Successfully created shader from {0}", shader_file_path);
         return pixel_context;
     }
 
-    std::string ShaderManager::GenerateShaderKey(const AssetPath& asset_path, const std::string& entry_point)
+    ULongLong ShaderManager::GenerateShaderKey(const AssetPath& asset_path, const std::string& entry_point, ShaderPermutationKey permutation_key)
+    {
+        const std::string name = asset_path.GetCanonicalPath() + "_" + entry_point;
+        const ULongLong name_hash = HashConverter::BytesHash64(name.data(), name.size());
+        return HashConverter::BytesHash64(&permutation_key, sizeof(permutation_key), name_hash);
+    }
+
+    void ShaderManager::ResolveShaderKeywords(const std::string& shader_file_path, const std::vector<std::string>& requested, std::vector<std::string>& out_keywords)
+    {
+        out_keywords.clear();
+        if (requested.empty())
+        {
+            return;
+        }
+
+        auto it = m_keyword_declarations.find(shader_file_path);
+        if (it == m_keyword_declarations.end())
+        {
+            std::ifstream file(shader_file_path, std::ios::binary);
+            const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            it = m_keyword_declarations.emplace(shader_file_path, ShaderKeywordDeclaration::Parse(content)).first;
+        }
+
+        std::string error;
+        if (!it->second.Resolve(requested, out_keywords, &error))
+        {
+            LOG_ERROR("Invalid shader keywords for {0}: {1}", shader_file_path, error);
+        }
+    }
+
+    bool ShaderManager::BuildShaderContext(ShaderContext* shader_context, const std::string& shader_file_path, const std::string& entry_point)
+    {
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        if (LoadPrecompiledShader(shader_context, shader_file_path, entry_point))
+        {
+            ++m_load_statistics.precompiled_count;
+            m_load_statistics.precompiled_milliseconds += ElapsedMilliseconds(start_time);
+            return true;
+        }
+
+        // 预编译产物不可用（没有、过期或损坏），丢掉可能已部分创建的对象后运行时编译
+        shader_context->Release();
+        shader_context->m_shader_reflection_info = ShaderReflectionInfo{};
+        if (!shader_context->BuildFromFile(shader_file_path, entry_point))
+        {
+            return false;
+        }
+        shader_context->PostBuildFromFile();
+        ++m_load_statistics.runtime_compiled_count;
+        m_load_statistics.runtime_compile_milliseconds += ElapsedMilliseconds(start_time);
+        return true;
+    }
+
+    bool ShaderManager::LoadPrecompiledShader(ShaderContext* shader_context, const std::string& shader_file_path, const std::string& entry_point)
+    {
+        if (!m_precompiled_manifest_loaded)
+        {
+            return false;
+        }
+
+        // 清单中的路径相对引擎 shader 根目录；项目目录下的 shader 没有预编译产物
+        const std::filesystem::path shader_root = std::filesystem::path(PathUtils::GetShadersSourceDir()).lexically_normal();
+        const std::string relative_path = std::filesystem::path(shader_file_path).lexically_normal().lexically_relative(shader_root).generic_string();
+        if (relative_path.empty() || relative_path.rfind("..", 0) == 0)
+        {
+            return false;
+        }
+        const std::string source = ShaderDependencyGraph::NormalizePath(relative_path);
+
+        const ShaderBuildManifestEntry* entry = m_precompiled_manifest.FindVariant(
+            source, entry_point, shader_context->GetCompileTarget(), shader_context->GetCompileDefines());
+        if (!entry)
+        {
+            return false;
+        }
+
+        if (m_check_precompiled_staleness)
+        {
+            const ULongLong seed = ComputeShaderVariantSeed(m_precompiled_manifest.GetCompilerIdentity(), entry->target, entry->entry_point, entry->defines);
+            if (m_shader_source_graph.ComputeInputHash(source, seed) != entry->input_hash)
+            {
+                ++m_load_statistics.stale_count;
+                LOG_WARN("Precompiled shader {0} is out of date, compiling {1} at runtime", entry->output, source);
+                return false;
+            }
+        }
+
+        const std::string output_path = PathUtils::GetCompiledShadersDir() + entry->output;
+        std::ifstream file(output_path, std::ios::binary);
+        if (!file.is_open())
+        {
+            LOG_WARN("Precompiled shader {0} is listed in the manifest but missing", output_path);
+            return false;
+        }
+        const std::vector<UByte> bytecode((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (bytecode.empty() || bytecode.size() != entry->bytecode_size)
+        {
+            LOG_WARN("Precompiled shader {0} does not match the manifest", output_path);
+            return false;
+        }
+
+        // 反射文件缺失或与 bytecode 不匹配时退回到 D3DReflect，仍然省去了编译
+        ShaderReflectionInfo reflection_info;
+        ULongLong reflection_bytecode_hash = 0;
+        const Bool reflection_valid = ShaderReflectionFile::Load(output_path + ".refl", reflection_info, reflection_bytecode_hash) &&
+            reflection_bytecode_hash == HashConverter::BytesHash64(bytecode.data(), bytecode.size());
+
+        return shader_context->LoadFromBytecode(shader_file_path, entry_point, bytecode.data(), bytecode.size(), reflection_valid ? &reflection_info : nullptr);
+    }
+
+    void ShaderManager::LogLoadStatistics() const
     {
-        return asset_path.GetCanonicalPath() + "_" + entry_point;
+        const ShaderLoadStatistics& statistics = m_load_statistics;
+        LOG_INFO("Shaders: {0} precompiled in {1:.2f} ms, {2} compiled at runtime in {3:.2f} ms, {4} stale",
+            statistics.precompiled_count,
+            statistics.precompiled_milliseconds,
+            statistics.runtime_compiled_count,
+            statistics.runtime_compile_milliseconds,
+            statistics.stale_count);
     }
 
 } // namespace Dolas
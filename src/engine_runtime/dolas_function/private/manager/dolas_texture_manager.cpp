@@ -12,12 +12,17 @@
 #include "dolas_base.h"
 #include "dolas_string_util.h"
 #include "dolas_paths.h"
+#include "dolas_cubemap.h"
+#include "dolas_image_based_lighting.h"
 #include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <iterator>
 #include <vector>
 #include "DirectXTex.h"
 #include "dolas_log_system_manager.h"
 #include "render/dolas_dx_trace.h"
+#include "manager/dolas_task_manager.h"
 namespace Dolas
 {
     // Helper: set D3D11 debug name for RenderDoc and debug layer
@@ -218,6 +223,191 @@ namespace Dolas
         return srv_desc;
     }
 
+    static D3D12_RESOURCE_DESC BuildD3D12TextureResourceDesc(const DirectX::TexMetadata& metadata)
+    {
+        D3D12_RESOURCE_DESC texture_desc = {};
+        texture_desc.Dimension = ConvertToD3D12ResourceDimension(metadata.dimension);
+        texture_desc.Width = static_cast<UINT64>(metadata.width);
+        texture_desc.Height = static_cast<UINT>(metadata.height);
+        texture_desc.DepthOrArraySize = static_cast<UINT16>(
+            metadata.dimension == DirectX::TEX_DIMENSION_TEXTURE3D ? metadata.depth : metadata.arraySize);
+        texture_desc.MipLevels = static_cast<UINT16>(std::max<size_t>(1, metadata.mipLevels));
+        texture_desc.Format = metadata.format;
+        texture_desc.SampleDesc.Count = 1;
+        texture_desc.SampleDesc.Quality = 0;
+        texture_desc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+        texture_desc.Flags = D3D12_RESOURCE_FLAG_NONE;
+        return texture_desc;
+    }
+
+    // D3D12 子资源按 mip + array_slice * mip_levels 编号；3D 纹理每个 mip 是一个子资源（包含所有深度切片）
+    static UINT GetSubresourceCount(const DirectX::TexMetadata& metadata)
+    {
+        const UINT mip_levels = static_cast<UINT>(std::max<size_t>(1, metadata.mipLevels));
+        if (metadata.dimension == DirectX::TEX_DIMENSION_TEXTURE3D)
+        {
+            return mip_levels;
+        }
+        return mip_levels * static_cast<UINT>(std::max<size_t>(1, metadata.arraySize));
+    }
+
+    static const DirectX::Image* GetSubresourceImage(const DirectX::ScratchImage& image, UINT subresource_index)
+    {
+        const DirectX::TexMetadata& metadata = image.GetMetadata();
+        const size_t mip_levels = std::max<size_t>(1, metadata.mipLevels);
+        if (metadata.dimension == DirectX::TEX_DIMENSION_TEXTURE3D)
+        {
+            return image.GetImage(subresource_index, 0, 0);
+        }
+        return image.GetImage(subresource_index % mip_levels, subresource_index / mip_levels, 0);
+    }
+
+    // 流送只处理尺寸为 2 的幂、带 mip 链的普通 2D 纹理（立方体、数组与 3D 纹理整体常驻）；
+    // 块压缩纹理作为 first mip 的尾部边长不能小于一个块
+    static bool IsStreamableTexture(const DirectX::TexMetadata& metadata, UInt tail_first_mip)
+    {
+        if (metadata.dimension != DirectX::TEX_DIMENSION_TEXTURE2D || metadata.arraySize != 1 || metadata.IsCubemap() ||
+            metadata.mipLevels <= 1 || tail_first_mip == 0)
+        {
+            return false;
+        }
+        if ((metadata.width & (metadata.width - 1)) != 0 || (metadata.height & (metadata.height - 1)) != 0)
+        {
+            return false;
+        }
+        return !DirectX::IsCompressed(metadata.format) || std::min(metadata.width, metadata.height) >> tail_first_mip >= 4;
+    }
+
+    // 只包含 [first_mip, mipLevels) 的纹理，流送纹理的 GPU 资源按它创建
+    static DirectX::TexMetadata GetResidentMetadata(const DirectX::TexMetadata& metadata, UInt first_mip)
+    {
+        DirectX::TexMetadata resident_metadata = metadata;
+        resident_metadata.width = std::max<size_t>(1, metadata.width >> first_mip);
+        resident_metadata.height = std::max<size_t>(1, metadata.height >> first_mip);
+        resident_metadata.mipLevels = metadata.mipLevels - first_mip;
+        return resident_metadata;
+    }
+
+    // 烘焙结果存在且不比源文件旧
+    static bool IsCookedFileUpToDate(const std::filesystem::path& cooked_path, const std::filesystem::path& source_path)
+    {
+        std::error_code error;
+        const auto cooked_time = std::filesystem::last_write_time(cooked_path, error);
+        return !error && cooked_time >= std::filesystem::last_write_time(source_path, error) && !error;
+    }
+
+    // 把 [0, count) 切成 worker 数 + 1 段分发到线程池，最后一段在当前线程执行
+    static TextureCookParallelFor MakeTaskManagerParallelFor()
+    {
+        return [](UInt count, const std::function<void(UInt, UInt)>& task)
+        {
+            TaskManager* task_manager = g_dolas_engine.m_task_manager;
+            const UInt chunk_count = std::max(1u, std::min(count, task_manager ? task_manager->GetWorkerCount() + 1 : 1u));
+            const UInt chunk_size = (count + chunk_count - 1) / std::max(1u, chunk_count);
+            auto run_chunk = [&task, chunk_size, count](UInt chunk_index)
+            {
+                const UInt begin = std::min(chunk_index * chunk_size, count);
+                task(begin, std::min(begin + chunk_size, count));
+            };
+
+            std::vector<TaskGUID> task_guids;
+            for (UInt chunk_index = 0; chunk_index + 1 < chunk_count; ++chunk_index)
+            {
+                TaskGUID task_guid = task_manager ? task_manager->EnqueueTask(run_chunk, chunk_index) : 0;
+                if (task_guid != 0)
+                {
+                    task_guids.push_back(task_guid);
+                }
+                else
+                {
+                    run_chunk(chunk_index);
+                }
+            }
+            run_chunk(chunk_count - 1);
+
+            for (TaskGUID task_guid : task_guids)
+            {
+                task_manager->WaitForTask(task_guid);
+            }
+        };
+    }
+
+    static std::vector<ULongLong> ComputeMipBytes(const DirectX::TexMetadata& metadata)
+    {
+        std::vector<ULongLong> mip_bytes;
+        for (size_t mip = 0; mip < metadata.mipLevels; ++mip)
+        {
+            size_t row_pitch = 0;
+            size_t slice_pitch = 0;
+            DirectX::ComputePitch(metadata.format, std::max<size_t>(1, metadata.width >> mip), std::max<size_t>(1, metadata.height >> mip), row_pitch, slice_pitch);
+            mip_bytes.push_back(static_cast<ULongLong>(slice_pitch));
+        }
+        return mip_bytes;
+    }
+
+    // 按 GetCopyableFootprints 的行距把一个子资源写入上传内存；3D 子资源的各深度切片在 DirectXTex 中连续存放
+    static void CopySubresourceToUploadMemory(
+        const DirectX::Image& source_image,
+        const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& layout,
+        UINT num_rows,
+        UINT64 row_size_in_bytes,
+        uint8_t* destination_subresource)
+    {
+        const UINT64 row_size = std::min<UINT64>(row_size_in_bytes, source_image.rowPitch);
+        const UINT depth = std::max<UINT>(1, layout.Footprint.Depth);
+
+        for (UINT z = 0; z < depth; ++z)
+        {
+            uint8_t* destination_slice = destination_subresource +
+                static_cast<size_t>(z) * layout.Footprint.RowPitch * num_rows;
+            const uint8_t* source_slice = source_image.pixels + static_cast<size_t>(z) * source_image.slicePitch;
+
+            for (UINT row = 0; row < num_rows; ++row)
+            {
+                memcpy(
+                    destination_slice + static_cast<size_t>(row) * layout.Footprint.RowPitch,
+                    source_slice + static_cast<size_t>(row) * source_image.rowPitch,
+                    static_cast<size_t>(row_size));
+            }
+        }
+    }
+
+    static ID3D12Resource* CreateD3D12UploadBuffer(ID3D12Device* device, UINT64 size)
+    {
+        D3D12_RESOURCE_DESC upload_desc = {};
+        upload_desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        upload_desc.Width = size;
+        upload_desc.Height = 1;
+        upload_desc.DepthOrArraySize = 1;
+        upload_desc.MipLevels = 1;
+        upload_desc.Format = DXGI_FORMAT_UNKNOWN;
+        upload_desc.SampleDesc.Count = 1;
+        upload_desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+        upload_desc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+        D3D12_HEAP_PROPERTIES upload_heap_properties = {};
+        upload_heap_properties.Type = D3D12_HEAP_TYPE_UPLOAD;
+        upload_heap_properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        upload_heap_properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+        upload_heap_properties.CreationNodeMask = 1;
+        upload_heap_properties.VisibleNodeMask = 1;
+
+        ID3D12Resource* upload_resource = nullptr;
+        HRESULT hr = device->CreateCommittedResource(
+            &upload_heap_properties,
+            D3D12_HEAP_FLAG_NONE,
+            &upload_desc,
+            D3D12_RESOURCE_STATE_GENERIC_READ,
+            nullptr,
+            IID_PPV_ARGS(&upload_resource));
+        if (FAILED(hr))
+        {
+            LOG_ERROR("CreateD3D12UploadBuffer: failed to create upload buffer of {0} bytes, HRESULT: 0x{1:X}", size, hr);
+            return nullptr;
+        }
+        return upload_resource;
+    }
+
     static bool CreateD3D12TextureFromScratchImage(
         const DirectX::ScratchImage& image,
         const DirectX::TexMetadata& metadata,
@@ -240,18 +430,7 @@ namespace Dolas
             return false;
         }
 
-        D3D12_RESOURCE_DESC texture_desc = {};
-        texture_desc.Dimension = ConvertToD3D12ResourceDimension(metadata.dimension);
-        texture_desc.Width = static_cast<UINT64>(metadata.width);
-        texture_desc.Height = static_cast<UINT>(metadata.height);
-        texture_desc.DepthOrArraySize = static_cast<UINT16>(
-            metadata.dimension == DirectX::TEX_DIMENSION_TEXTURE3D ? metadata.depth : metadata.arraySize);
-        texture_desc.MipLevels = static_cast<UINT16>(std::max<size_t>(1, metadata.mipLevels));
-        texture_desc.Format = metadata.format;
-        texture_desc.SampleDesc.Count = 1;
-        texture_desc.SampleDesc.Quality = 0;
-        texture_desc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
-        texture_desc.Flags = D3D12_RESOURCE_FLAG_NONE;
+        const D3D12_RESOURCE_DESC texture_desc = BuildD3D12TextureResourceDesc(metadata);
 
         D3D12_HEAP_PROPERTIES default_heap_properties = {};
         default_heap_properties.Type = D3D12_HEAP_TYPE_DEFAULT;
@@ -288,35 +467,9 @@ namespace Dolas
             row_sizes_in_bytes.data(),
             &upload_buffer_size);
 
-        D3D12_RESOURCE_DESC upload_desc = {};
-        upload_desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-        upload_desc.Width = upload_buffer_size;
-        upload_desc.Height = 1;
-        upload_desc.DepthOrArraySize = 1;
-        upload_desc.MipLevels = 1;
-        upload_desc.Format = DXGI_FORMAT_UNKNOWN;
-        upload_desc.SampleDesc.Count = 1;
-        upload_desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-        upload_desc.Flags = D3D12_RESOURCE_FLAG_NONE;
-
-        D3D12_HEAP_PROPERTIES upload_heap_properties = {};
-        upload_heap_properties.Type = D3D12_HEAP_TYPE_UPLOAD;
-        upload_heap_properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-        upload_heap_properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-        upload_heap_properties.CreationNodeMask = 1;
-        upload_heap_properties.VisibleNodeMask = 1;
-
-        ID3D12Resource* upload_resource = nullptr;
-        hr = device->CreateCommittedResource(
-            &upload_heap_properties,
-            D3D12_HEAP_FLAG_NONE,
-            &upload_desc,
-            D3D12_RESOURCE_STATE_GENERIC_READ,
-            nullptr,
-            IID_PPV_ARGS(&upload_resource));
-        if (FAILED(hr))
+        ID3D12Resource* upload_resource = CreateD3D12UploadBuffer(device, upload_buffer_size);
+        if (!upload_resource)
         {
-            LOG_ERROR("CreateD3D12TextureFromScratchImage: failed to create upload resource, HRESULT: 0x{0:X}", hr);
             SafeRelease(d3d12_resource);
             return false;
         }
@@ -334,26 +487,13 @@ namespace Dolas
 
         for (UINT subresource_index = 0; subresource_index < subresource_count; ++subresource_index)
         {
-            const DirectX::Image& source_image = images[subresource_index];
             const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& layout = layouts[subresource_index];
-            uint8_t* destination_subresource = mapped_data + layout.Offset;
-            const UINT64 row_size = std::min<UINT64>(row_sizes_in_bytes[subresource_index], source_image.rowPitch);
-            const UINT depth = std::max<UINT>(1, layout.Footprint.Depth);
-
-            for (UINT z = 0; z < depth; ++z)
-            {
-                uint8_t* destination_slice = destination_subresource +
-                    static_cast<size_t>(z) * layout.Footprint.RowPitch * num_rows[subresource_index];
-                const uint8_t* source_slice = source_image.pixels + static_cast<size_t>(z) * source_image.slicePitch;
-
-                for (UINT row = 0; row < num_rows[subresource_index]; ++row)
-                {
-                    memcpy(
-                        destination_slice + static_cast<size_t>(row) * layout.Footprint.RowPitch,
-                        source_slice + static_cast<size_t>(row) * source_image.rowPitch,
-                        static_cast<size_t>(row_size));
-                }
-            }
+            CopySubresourceToUploadMemory(
+                images[subresource_index],
+                layout,
+                num_rows[subresource_index],
+                row_sizes_in_bytes[subresource_index],
+                mapped_data + layout.Offset);
         }
 
         D3D12_RANGE written_range = { 0, static_cast<SIZE_T>(upload_buffer_size) };
@@ -407,30 +547,19 @@ namespace Dolas
 
         texture->SetD3D12Resource(d3d12_resource, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
         texture->SetD3D12SrvHandles(srv_cpu_handle, srv_gpu_handle);
+        texture->SetBindlessIndex(rhi->GetSrvDescriptorIndex(srv_gpu_handle));
         SetD3D12DebugName(texture->GetD3D12Resource(), debug_name);
         return true;
     }
 
-    static bool CreateD3D12TextureFromD3D11Desc(Texture* texture, const D3D11_TEXTURE2D_DESC* d3d11_desc)
+    static D3D12_RESOURCE_DESC BuildD3D12Texture2DResourceDesc(const D3D11_TEXTURE2D_DESC* d3d11_desc)
     {
-        RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
-        ID3D12Device* device = rhi ? rhi->GetDevice() : nullptr;
-        if (!rhi || !device || !texture || !d3d11_desc)
-        {
-            LOG_ERROR("CreateD3D12TextureFromD3D11Desc: invalid input");
-            return false;
-        }
-
-        const bool is_render_target = (d3d11_desc->BindFlags & D3D11_BIND_RENDER_TARGET) != 0;
-        const bool is_depth_stencil = (d3d11_desc->BindFlags & D3D11_BIND_DEPTH_STENCIL) != 0;
-        const bool is_shader_resource = (d3d11_desc->BindFlags & D3D11_BIND_SHADER_RESOURCE) != 0;
-
         D3D12_RESOURCE_FLAGS resource_flags = D3D12_RESOURCE_FLAG_NONE;
-        if (is_render_target)
+        if ((d3d11_desc->BindFlags & D3D11_BIND_RENDER_TARGET) != 0)
         {
             resource_flags |= D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
         }
-        if (is_depth_stencil)
+        if ((d3d11_desc->BindFlags & D3D11_BIND_DEPTH_STENCIL) != 0)
         {
             resource_flags |= D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
         }
@@ -445,6 +574,24 @@ namespace Dolas
         resource_desc.SampleDesc = d3d11_desc->SampleDesc;
         resource_desc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
         resource_desc.Flags = resource_flags;
+        return resource_desc;
+    }
+
+    static bool CreateD3D12TextureFromD3D11Desc(Texture* texture, const D3D11_TEXTURE2D_DESC* d3d11_desc, ID3D12Heap* placed_heap, ULongLong placed_heap_offset)
+    {
+        RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+        ID3D12Device* device = rhi ? rhi->GetDevice() : nullptr;
+        if (!rhi || !device || !texture || !d3d11_desc)
+        {
+            LOG_ERROR("CreateD3D12TextureFromD3D11Desc: invalid input");
+            return false;
+        }
+
+        const bool is_render_target = (d3d11_desc->BindFlags & D3D11_BIND_RENDER_TARGET) != 0;
+        const bool is_depth_stencil = (d3d11_desc->BindFlags & D3D11_BIND_DEPTH_STENCIL) != 0;
+        const bool is_shader_resource = (d3d11_desc->BindFlags & D3D11_BIND_SHADER_RESOURCE) != 0;
+
+        const D3D12_RESOURCE_DESC resource_desc = BuildD3D12Texture2DResourceDesc(d3d11_desc);
 
         D3D12_RESOURCE_STATES initial_state = D3D12_RESOURCE_STATE_COMMON;
         D3D12_CLEAR_VALUE clear_value = {};
@@ -481,13 +628,28 @@ namespace Dolas
         heap_properties.VisibleNodeMask = 1;
 
         ID3D12Resource* d3d12_resource = nullptr;
-        HRESULT hr = device->CreateCommittedResource(
-            &heap_properties,
-            D3D12_HEAP_FLAG_NONE,
-            &resource_desc,
-            initial_state,
-            clear_value_ptr,
-            IID_PPV_ARGS(&d3d12_resource));
+        HRESULT hr = S_OK;
+        if (placed_heap)
+        {
+            // 与其他瞬态纹理共用堆内存，内容在别名屏障之后未定义，首次使用的 pass 负责清除
+            hr = device->CreatePlacedResource(
+                placed_heap,
+                placed_heap_offset,
+                &resource_desc,
+                initial_state,
+                clear_value_ptr,
+                IID_PPV_ARGS(&d3d12_resource));
+        }
+        else
+        {
+            hr = device->CreateCommittedResource(
+                &heap_properties,
+                D3D12_HEAP_FLAG_NONE,
+                &resource_desc,
+                initial_state,
+                clear_value_ptr,
+                IID_PPV_ARGS(&d3d12_resource));
+        }
         if (FAILED(hr))
         {
             LOG_ERROR("CreateD3D12TextureFromD3D11Desc: failed to create texture, HRESULT: 0x{0:X}", hr);
@@ -543,11 +705,98 @@ namespace Dolas
                 d3d11_desc->SampleDesc.Count);
             device->CreateShaderResourceView(d3d12_resource, &srv_desc, srv_cpu_handle);
             texture->SetD3D12SrvHandles(srv_cpu_handle, srv_gpu_handle);
+            texture->SetBindlessIndex(rhi->GetSrvDescriptorIndex(srv_gpu_handle));
         }
 
         texture->SetD3D12Resource(d3d12_resource, initial_state);
+        texture->SetD3D12Placed(placed_heap != nullptr);
         return true;
     }
+    // 2D 纹理的占位 SRV 指向 1x1 占位纹理；立方体 / 数组 / 3D 纹理写入相同维度的 null SRV（采样结果为 0）
+    static void WritePlaceholderSrv(
+        ID3D12Device* device,
+        const DirectX::TexMetadata& metadata,
+        Texture* placeholder_texture,
+        D3D12_CPU_DESCRIPTOR_HANDLE srv_cpu_handle)
+    {
+        D3D12_SHADER_RESOURCE_VIEW_DESC srv_desc = CreateD3D12SrvDescFromMetadata(metadata);
+        ID3D12Resource* placeholder_resource = placeholder_texture ? placeholder_texture->GetD3D12Resource() : nullptr;
+        if (srv_desc.ViewDimension == D3D12_SRV_DIMENSION_TEXTURE2D && placeholder_resource)
+        {
+            srv_desc.Format = placeholder_resource->GetDesc().Format;
+            srv_desc.Texture2D.MipLevels = 1;
+            device->CreateShaderResourceView(placeholder_resource, &srv_desc, srv_cpu_handle);
+            return;
+        }
+        device->CreateShaderResourceView(nullptr, &srv_desc, srv_cpu_handle);
+    }
+
+    namespace
+    {
+        // 工作线程写入；任务完成之后才在渲染线程读取
+        struct DecodedTexture
+        {
+            DirectX::ScratchImage image;
+            HRESULT result = E_PENDING;
+        };
+    }
+
+    struct TextureManager::PendingTextureLoad
+    {
+        ~PendingTextureLoad()
+        {
+            SafeRelease(resource);
+        }
+
+        HRESULT ReadMetadata()
+        {
+            switch (file_type)
+            {
+            case TextureFileType::DDS:
+                return DirectX::GetMetadataFromDDSFile(file_path_w.c_str(), DirectX::DDS_FLAGS_NONE, metadata);
+            case TextureFileType::HDR:
+                return DirectX::GetMetadataFromHDRFile(file_path_w.c_str(), metadata);
+            case TextureFileType::WIC:
+            default:
+                return DirectX::GetMetadataFromWICFile(file_path_w.c_str(), DirectX::WIC_FLAGS_NONE, metadata);
+            }
+        }
+
+        static HRESULT Decode(TextureFileType file_type, const std::wstring& file_path_w, DirectX::ScratchImage& out_image)
+        {
+            switch (file_type)
+            {
+            case TextureFileType::DDS:
+                return DirectX::LoadFromDDSFile(file_path_w.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, out_image);
+            case TextureFileType::HDR:
+                return DirectX::LoadFromHDRFile(file_path_w.c_str(), nullptr, out_image);
+            case TextureFileType::WIC:
+            default:
+                // WIC 基于 COM，工作线程需要先进入 MTA；线程池的线程常驻，不做配对的 CoUninitialize，
+                // 避免 DirectXTex 缓存的 WIC factory 随最后一次 CoUninitialize 失效
+                CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+                return DirectX::LoadFromWICFile(file_path_w.c_str(), DirectX::WIC_FLAGS_NONE, nullptr, out_image);
+            }
+        }
+
+        TextureID texture_id = TEXTURE_ID_EMPTY;   // 纹理在加载完成之前被销毁时置空，等调度器放弃请求后移除
+        TextureFileType file_type = TextureFileType::DDS;
+        std::string file_path;
+        std::wstring file_path_w;
+        TaskGUID decode_task = 0;
+        std::shared_ptr<DecodedTexture> decoded;
+        // 流送纹理只创建并上传 [first_mip, mipLevels)；streaming_update 为改变已加载纹理常驻 mip 的请求
+        UInt first_mip = 0;
+        Bool streamed = false;
+        Bool streaming_update = false;
+        // 拷贝目标，加载完成之前由这里持有，完成时交给 Texture
+        ID3D12Resource* resource = nullptr;
+        DirectX::TexMetadata metadata = {};     // 完整文件的描述，resource 按 GetResidentMetadata(metadata, first_mip) 创建
+        std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> layouts;
+        std::vector<UINT> num_rows;
+        std::vector<UINT64> row_sizes_in_bytes;
+    };
+
     TextureManager::TextureManager()
     {
 
@@ -560,8 +809,12 @@ namespace Dolas
     
     bool TextureManager::Initialize()
     {
+        DOLAS_RETURN_FALSE_IF_FALSE(CreatePlaceholderTextures());
+        DOLAS_RETURN_FALSE_IF_FALSE(CreateUploadRingBuffer());
+        m_streaming_policy.Initialize(TextureStreamingDesc());
+
         // initialize global textures
-        // 使用 HDR 文件加载天空盒纹理
+        // 天空盒：HDR 全景图转换成的立方体纹理
         const auto sky_box_asset_path = AssetPath::Parse("_engine/texture/golden_gate_hills_4k.hdr");
         if (!sky_box_asset_path)
         {
@@ -569,7 +822,7 @@ namespace Dolas
             return false;
         }
 
-        TextureID sky_box_texture_id = CreateTextureFromHDRFile(*sky_box_asset_path);
+        TextureID sky_box_texture_id = CreateCubemapFromEquirectHDRFile(*sky_box_asset_path);
         if (sky_box_texture_id == TEXTURE_ID_EMPTY)
         {
             LOG_ERROR("TextureManager::Initialize: failed to load required skybox texture");
@@ -578,11 +831,37 @@ namespace Dolas
         
         m_global_textures[GlobalTextureType::GLOBAL_TEXTURE_SKY_BOX] = sky_box_texture_id;
 
+        // 环境光来自同一张天空图；失败时延迟着色退回常量环境光
+        if (!CreateImageBasedLighting(*sky_box_asset_path))
+        {
+            LOG_WARN("TextureManager::Initialize: image based lighting is unavailable, falling back to constant ambient");
+        }
+
         return true;
     }
 
     bool TextureManager::Clear()
     {
+        WaitForPendingLoads();
+        m_pending_loads.clear();
+        m_loading_textures.clear();
+        m_load_scheduler.Clear();
+        m_streaming_policy.Clear();
+        m_streaming_feedback.Clear();
+        m_streamed_textures.clear();
+        for (auto& upload_buffer : m_dedicated_upload_buffers)
+        {
+            SafeRelease(upload_buffer.second);
+        }
+        m_dedicated_upload_buffers.clear();
+        if (m_upload_ring_buffer)
+        {
+            m_upload_ring_buffer->Unmap(0, nullptr);
+            SafeRelease(m_upload_ring_buffer);
+        }
+        m_upload_ring_data = nullptr;
+        m_last_copy_fence_value = 0;
+
         for (auto texture_iter = m_textures.begin(); texture_iter != m_textures.end(); ++texture_iter)
         {
             Texture* texture = texture_iter->second;
@@ -594,6 +873,18 @@ namespace Dolas
         }
         m_textures.clear();
         m_global_textures.clear();
+        m_image_based_lighting_ready = false;
+        m_sky_irradiance_sh = SphericalHarmonicsL2();
+
+        for (Texture*& placeholder_texture : m_placeholder_textures)
+        {
+            if (placeholder_texture)
+            {
+                placeholder_texture->Release();
+                DOLAS_DELETE(placeholder_texture);
+                placeholder_texture = nullptr;
+            }
+        }
         return true;
     }
 
@@ -611,6 +902,14 @@ namespace Dolas
             return false;
         }
 
+        // 加载中的纹理：拷贝目标由加载持有，GPU 上的拷贝完成之后才释放
+        auto loading_iter = m_loading_textures.find(texture_id);
+        if (loading_iter != m_loading_textures.end())
+        {
+            CancelTextureLoad(loading_iter->second);
+        }
+        StopTextureStreaming(texture_id);
+
         Texture* texture = texture_iter->second;
         if (texture)
         {
@@ -622,285 +921,798 @@ namespace Dolas
         return true;
     }
 
-    TextureID TextureManager::CreateTextureFromDDSFile(const AssetPath& asset_path)
+    TextureID TextureManager::CreateTextureFromDDSFile(const AssetPath& asset_path, TexturePlaceholder placeholder /*= TexturePlaceholder::Grey*/)
     {
-        const auto resolved_path = PathUtils::ResolveAssetPath(asset_path);
-        if (!resolved_path)
-        {
-            LOG_ERROR("TextureManager::CreateTextureFromDDSFile: failed to resolve {0}", asset_path.GetCanonicalPath());
-            return TEXTURE_ID_EMPTY;
-        }
+        return CreateTextureFromFile(asset_path, TextureFileType::DDS, placeholder);
+    }
 
-        const std::string texture_file_path = resolved_path->string();
-        const std::wstring texture_file_path_w = StringUtil::StringToWString(texture_file_path);
-        
-        // 使用 DirectXTex 的现代 API
-        DirectX::TexMetadata metadata;
-        DirectX::ScratchImage image;
-        
-        // 从 DDS 文件加载
-        HRESULT load_hr = DirectX::LoadFromDDSFile(
-            texture_file_path_w.c_str(),
-            DirectX::DDS_FLAGS_NONE,
-            &metadata,
-            image);
-        if (FAILED(load_hr))
-        {
-            LOG_ERROR("TextureManager::CreateTextureFromDDSFile: failed to load {0}, HRESULT: 0x{1:X}", texture_file_path, load_hr);
-            return TEXTURE_ID_EMPTY;
+    TextureID TextureManager::CreateTextureFromHDRFile(const AssetPath& asset_path, TexturePlaceholder placeholder /*= TexturePlaceholder::Grey*/)
+    {
+        return CreateTextureFromFile(asset_path, TextureFileType::HDR, placeholder);
+    }
+
+	TextureID TextureManager::CreateTextureFromPNGFile(const AssetPath& asset_path, TexturePlaceholder placeholder /*= TexturePlaceholder::Grey*/)
+	{
+		// WIC 同时支持 PNG, JPG, BMP 等
+		return CreateTextureFromFile(asset_path, TextureFileType::WIC, placeholder);
+	}
+
+    TextureID TextureManager::CreateCubemapFromEquirectHDRFile(const AssetPath& asset_path, TexturePlaceholder placeholder /*= TexturePlaceholder::Grey*/)
+    {
+        // 与同一文件的 2D 纹理区分
+        const TextureID texture_id = HashConverter::StringHash(asset_path.GetCanonicalPath() + "#cube");
+        if (m_textures.find(texture_id) != m_textures.end())
+        {
+            return texture_id;
         }
 
-        Texture* texture = DOLAS_NEW(Texture);
-        texture->m_is_from_file = true;
-        // 使用规范逻辑资产路径计算稳定 ID，不依赖本机 Content 根目录。
-        texture->m_file_id = HashConverter::StringHash(asset_path.GetCanonicalPath());
-        texture->m_texture_type = ConvertToDolasTextureType(metadata);
-        texture->m_texture_format = ConvertToTextureFormat(metadata.format);
-        texture->m_width = static_cast<uint32_t>(metadata.width);
-        texture->m_height = static_cast<uint32_t>(metadata.height);
-        texture->m_mip_levels = static_cast<uint32_t>(metadata.mipLevels);
-        if (!CreateD3D12TextureFromScratchImage(image, metadata, texture_file_path_w, texture))
-        {
-            LOG_ERROR("Failed to create D3D12 DDS texture: {0}", texture_file_path);
-            texture->Release();
-            DOLAS_DELETE(texture);
+        const auto resolved_path = PathUtils::ResolveAssetPath(asset_path);
+        if (!resolved_path)
+        {
+            LOG_ERROR("TextureManager::CreateCubemapFromEquirectHDRFile: failed to resolve {0}", asset_path.GetCanonicalPath());
             return TEXTURE_ID_EMPTY;
         }
 
-        ID3D11Device* d3d11_device = g_dolas_engine.m_rhi ? g_dolas_engine.m_rhi->GetD3D11Device() : nullptr;
-        if (d3d11_device)
+        // 没有烘焙结果（或源文件更新过）时在这里转换一次并写入缓存，之后的启动直接读取
+        const std::filesystem::path cubemap_path = PathUtils::GetCookedCubemapPath(asset_path);
+        if (!IsCookedFileUpToDate(cubemap_path, *resolved_path))
         {
-            ID3D11Resource* d3d_resource = nullptr;
-            HRESULT hr = DirectX::CreateTexture(
-                d3d11_device,
-                image.GetImages(),
-                image.GetImageCount(),
-                metadata,
-                &d3d_resource);
-            if (SUCCEEDED(hr) && d3d_resource)
+            const auto start_time = std::chrono::high_resolution_clock::now();
+            const TextureCookParallelFor parallel_for = MakeTaskManagerParallelFor();
+            TextureImage equirect;
+            Cubemap cubemap;
+            CookedTexture cooked;
+            if (!LoadRadianceHDRFile(*resolved_path, equirect) ||
+                !BuildCubemapFromEquirect(equirect, CubemapBuildSettings(), cubemap, parallel_for) ||
+                !CookCubemap(cubemap, cooked, parallel_for) ||
+                !SaveCookedTextureDDS(cooked, cubemap_path))
             {
-                hr = d3d_resource->QueryInterface(
-                    __uuidof(ID3D11Texture2D),
-                    reinterpret_cast<void**>(&texture->m_d3d_texture_2d));
-                if (FAILED(hr))
-                {
-                    LOG_WARN("TextureManager::CreateTextureFromDDSFile: failed to create optional D3D11 texture mirror for {0}, HRESULT: 0x{1:X}", texture_file_path, hr);
-                }
-                d3d_resource->Release();
+                LOG_ERROR("TextureManager::CreateCubemapFromEquirectHDRFile: failed to convert {0}", asset_path.GetCanonicalPath());
+                return TEXTURE_ID_EMPTY;
             }
-            else
+            const Double milliseconds = std::chrono::duration<Double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+            LOG_INFO("TextureManager: converted {0} to a {1}x{1} cubemap with {2} mips in {3:.1f} ms", asset_path.GetCanonicalPath(), cooked.width, cooked.GetMipCount(), milliseconds);
+        }
+
+        return CreateTextureFromResolvedFile(texture_id, TextureFileType::DDS, cubemap_path, placeholder);
+    }
+
+    Bool TextureManager::CreateImageBasedLighting(const AssetPath& asset_path)
+    {
+        const auto resolved_path = PathUtils::ResolveAssetPath(asset_path);
+        if (!resolved_path)
+        {
+            LOG_ERROR("TextureManager::CreateImageBasedLighting: failed to resolve {0}", asset_path.GetCanonicalPath());
+            return false;
+        }
+        std::ifstream file(*resolved_path, std::ios::binary);
+        if (!file)
+        {
+            LOG_ERROR("TextureManager::CreateImageBasedLighting: failed to open {0}", resolved_path->string());
+            return false;
+        }
+        const std::vector<UByte> source_bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        // 缓存按内容而不是修改时间区分：同一张天空图换了路径或被 touch 都不需要重新计算
+        const ImageBasedLightingSettings settings;
+        const ULongLong cache_key = ComputeImageBasedLightingCacheKey(HashConverter::BytesHash64(source_bytes.data(), source_bytes.size()), settings);
+        const std::filesystem::path sh_path = PathUtils::GetImageBasedLightingCachePath(cache_key, "sh");
+        const std::filesystem::path specular_path = PathUtils::GetImageBasedLightingCachePath(cache_key, "specular.dds");
+        const std::filesystem::path brdf_lut_path = PathUtils::GetImageBasedLightingCachePath(ComputeBRDFLUTCacheKey(settings), "brdf_lut.dds");
+        const TextureCookParallelFor parallel_for = MakeTaskManagerParallelFor();
+
+        SphericalHarmonicsL2 irradiance;
+        std::error_code error;
+        if (!LoadSphericalHarmonicsFile(sh_path, irradiance) || !std::filesystem::exists(specular_path, error))
+        {
+            const auto start_time = std::chrono::high_resolution_clock::now();
+            TextureImage equirect;
+            ImageBasedLighting lighting;
+            CookedTexture cooked;
+            if (!DecodeRadianceHDR(source_bytes.data(), source_bytes.size(), equirect) ||
+                !PrecomputeImageBasedLighting(equirect, settings, lighting, parallel_for) ||
+                !CookCubemap(lighting.specular, cooked, parallel_for) ||
+                !SaveCookedTextureDDS(cooked, specular_path) ||
+                !SaveSphericalHarmonicsFile(lighting.irradiance, sh_path))
             {
-                LOG_WARN("TextureManager::CreateTextureFromDDSFile: failed to create optional D3D11 resource mirror for {0}, HRESULT: 0x{1:X}", texture_file_path, hr);
+                LOG_ERROR("TextureManager::CreateImageBasedLighting: failed to precompute {0}", asset_path.GetCanonicalPath());
+                return false;
             }
+            irradiance = lighting.irradiance;
+            const Double milliseconds = std::chrono::duration<Double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+            LOG_INFO("TextureManager: precomputed image based lighting for {0} ({1}x{1} specular, {2} mips, {3}) in {4:.1f} ms",
+                asset_path.GetCanonicalPath(), lighting.specular.face_size, lighting.specular.mip_count,
+                GetImageBasedLightingPath() == ImageBasedLightingPath::SSE ? "SSE" : "scalar", milliseconds);
+        }
 
-            hr = DirectX::CreateShaderResourceView(
-                d3d11_device,
-                image.GetImages(),
-                image.GetImageCount(),
-                metadata,
-                &texture->m_d3d_shader_resource_view);
-            if (FAILED(hr))
+        if (!std::filesystem::exists(brdf_lut_path, error))
+        {
+            TextureImage lut;
+            CookedTexture cooked;
+            if (!BuildBRDFLUT(settings.brdf_lut_size, settings.brdf_lut_sample_count, lut, parallel_for) ||
+                !CookBRDFLUT(lut, cooked) ||
+                !SaveCookedTextureDDS(cooked, brdf_lut_path))
             {
-                LOG_WARN("TextureManager::CreateTextureFromDDSFile: failed to create optional D3D11 SRV mirror for {0}, HRESULT: 0x{1:X}", texture_file_path, hr);
+                LOG_ERROR("TextureManager::CreateImageBasedLighting: failed to build the BRDF LUT");
+                return false;
             }
         }
 
-        // Debug names for RenderDoc
-        SetD3DDebugName(texture->m_d3d_texture_2d, std::string("Tex2D: ") + texture_file_path);
-        SetD3DDebugName(texture->m_d3d_shader_resource_view, std::string("SRV: ") + texture_file_path);
-        
-        DestroyTextureByID(texture->m_file_id);
-        m_textures[texture->m_file_id] = texture;
-        
-        LOG_INFO("Successfully loaded texture: {0}", texture_file_path);
-        return texture->m_file_id;
+        // 重复调用时复用已经创建的纹理
+        auto create_texture = [this](TextureID texture_id, const std::filesystem::path& file_path)
+        {
+            return m_textures.find(texture_id) != m_textures.end() ? texture_id : CreateTextureFromResolvedFile(texture_id, TextureFileType::DDS, file_path, TexturePlaceholder::Grey);
+        };
+        const TextureID specular_id = create_texture(HashConverter::StringHash(asset_path.GetCanonicalPath() + "#specular"), specular_path);
+        const TextureID brdf_lut_id = create_texture(HashConverter::StringHash(brdf_lut_path.filename().string()), brdf_lut_path);
+        if (specular_id == TEXTURE_ID_EMPTY || brdf_lut_id == TEXTURE_ID_EMPTY)
+        {
+            return false;
+        }
+
+        m_global_textures[GlobalTextureType::GLOBAL_TEXTURE_SKY_SPECULAR] = specular_id;
+        m_global_textures[GlobalTextureType::GLOBAL_TEXTURE_BRDF_LUT] = brdf_lut_id;
+        m_sky_irradiance_sh = irradiance;
+        m_image_based_lighting_ready = true;
+        return true;
     }
 
-    TextureID TextureManager::CreateTextureFromHDRFile(const AssetPath& asset_path)
+    TextureID TextureManager::CreateTextureFromFile(const AssetPath& asset_path, TextureFileType file_type, TexturePlaceholder placeholder)
     {
+        // 使用规范逻辑资产路径计算稳定 ID，不依赖本机 Content 根目录。
+        const TextureID texture_id = HashConverter::StringHash(asset_path.GetCanonicalPath());
+        if (m_textures.find(texture_id) != m_textures.end())
+        {
+            return texture_id;
+        }
+
         const auto resolved_path = PathUtils::ResolveAssetPath(asset_path);
         if (!resolved_path)
         {
-            LOG_ERROR("TextureManager::CreateTextureFromHDRFile: failed to resolve {0}", asset_path.GetCanonicalPath());
+            LOG_ERROR("TextureManager::CreateTextureFromFile: failed to resolve {0}", asset_path.GetCanonicalPath());
             return TEXTURE_ID_EMPTY;
         }
 
-        const std::string texture_file_path = resolved_path->string();
-        const std::wstring texture_file_path_w = StringUtil::StringToWString(texture_file_path);
-        
-        // 使用 DirectXTex 的 HDR 加载 API
-        DirectX::TexMetadata metadata;
-        DirectX::ScratchImage image;
-        
-        // 从 HDR 文件加载
-        HRESULT load_hr = DirectX::LoadFromHDRFile(
-            texture_file_path_w.c_str(),
-            &metadata,
-            image);
-        if (FAILED(load_hr))
-        {
-            LOG_ERROR("TextureManager::CreateTextureFromHDRFile: failed to load {0}, HRESULT: 0x{1:X}", texture_file_path, load_hr);
+        // TextureCooker 烘焙过的纹理（块压缩 + 完整 mip 链）优先，只在烘焙结果不比源文件旧时使用
+        std::filesystem::path file_path = *resolved_path;
+        if (file_type != TextureFileType::DDS)
+        {
+            const std::filesystem::path cooked_path = PathUtils::GetCookedTexturePath(asset_path);
+            if (IsCookedFileUpToDate(cooked_path, file_path))
+            {
+                file_type = TextureFileType::DDS;
+                file_path = cooked_path;
+            }
+        }
+
+        return CreateTextureFromResolvedFile(texture_id, file_type, file_path, placeholder);
+    }
+
+    TextureID TextureManager::CreateTextureFromResolvedFile(TextureID texture_id, TextureFileType file_type, const std::filesystem::path& file_path, TexturePlaceholder placeholder)
+    {
+        RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+        ID3D12Device* device = rhi ? rhi->GetDevice() : nullptr;
+        Texture* placeholder_texture = m_placeholder_textures[static_cast<int>(placeholder)];
+        if (!device || !placeholder_texture)
+        {
+            LOG_ERROR("TextureManager::CreateTextureFromFile: D3D12 device or placeholder texture is null");
             return TEXTURE_ID_EMPTY;
         }
 
+        std::unique_ptr<PendingTextureLoad> pending = std::make_unique<PendingTextureLoad>();
+        pending->texture_id = texture_id;
+        pending->file_type = file_type;
+        pending->file_path = file_path.string();
+        pending->file_path_w = StringUtil::StringToWString(pending->file_path);
+
+        // 只读取文件头：文件不存在或格式不支持时仍然同步失败
+        HRESULT hr = pending->ReadMetadata();
+        if (FAILED(hr))
+        {
+            LOG_ERROR("TextureManager::CreateTextureFromFile: failed to load {0}, HRESULT: 0x{1:X}", pending->file_path, hr);
+            return TEXTURE_ID_EMPTY;
+        }
+
+        D3D12_CPU_DESCRIPTOR_HANDLE srv_cpu_handle = {};
+        D3D12_GPU_DESCRIPTOR_HANDLE srv_gpu_handle = {};
+        if (!rhi->AllocateSrvDescriptor(&srv_cpu_handle, &srv_gpu_handle))
+        {
+            LOG_ERROR("TextureManager::CreateTextureFromFile: failed to allocate SRV descriptor for {0}", pending->file_path);
+            return TEXTURE_ID_EMPTY;
+        }
+        WritePlaceholderSrv(device, pending->metadata, placeholder_texture, srv_cpu_handle);
+
         Texture* texture = DOLAS_NEW(Texture);
         texture->m_is_from_file = true;
-        // 使用规范逻辑资产路径计算稳定 ID，不依赖本机 Content 根目录。
-        texture->m_file_id = HashConverter::StringHash(asset_path.GetCanonicalPath());
-        texture->m_texture_type = ConvertToDolasTextureType(metadata);
-        texture->m_texture_format = ConvertToTextureFormat(metadata.format);
-        texture->m_width = static_cast<uint32_t>(metadata.width);
-        texture->m_height = static_cast<uint32_t>(metadata.height);
-        texture->m_mip_levels = static_cast<uint32_t>(metadata.mipLevels);
-        if (!CreateD3D12TextureFromScratchImage(image, metadata, texture_file_path_w, texture))
-        {
-            LOG_ERROR("Failed to create D3D12 HDR texture: {0}", texture_file_path);
-            texture->Release();
-            DOLAS_DELETE(texture);
-            return TEXTURE_ID_EMPTY;
+        texture->m_file_id = texture_id;
+        texture->m_texture_type = ConvertToDolasTextureType(pending->metadata);
+        texture->m_texture_format = ConvertToTextureFormat(pending->metadata.format);
+        texture->m_width = static_cast<uint32_t>(pending->metadata.width);
+        texture->m_height = static_cast<uint32_t>(pending->metadata.height);
+        texture->m_mip_levels = static_cast<uint32_t>(pending->metadata.mipLevels);
+        // descriptor 在加载完成时原地改写，bindless 下标从现在起保持不变
+        texture->SetD3D12SrvHandles(srv_cpu_handle, srv_gpu_handle);
+        texture->SetBindlessIndex(rhi->GetSrvDescriptorIndex(srv_gpu_handle));
+        m_textures[texture_id] = texture;
+
+        // 可流送的纹理先只加载尾部 mip
+        const UInt tail_first_mip = ComputeTailFirstMip(
+            static_cast<UInt>(pending->metadata.width),
+            static_cast<UInt>(pending->metadata.height),
+            static_cast<UInt>(pending->metadata.mipLevels),
+            m_streaming_policy.GetDesc().tail_mip_size);
+        if (IsStreamableTexture(pending->metadata, tail_first_mip))
+        {
+            pending->first_mip = tail_first_mip;
+            pending->streamed = true;
+            m_streaming_policy.RegisterTexture(texture_id, texture->m_width, texture->m_height, ComputeMipBytes(pending->metadata));
+            m_streamed_textures[texture_id] = { file_type, pending->file_path, pending->file_path_w };
+        }
+
+        const TextureLoadScheduler::RequestID request = m_load_scheduler.AddRequest();
+        m_loading_textures[texture_id] = request;
+        m_pending_loads[request] = std::move(pending);
+        return texture_id;
+    }
+
+    void TextureManager::TickPreRender()
+    {
+        RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+        DOLAS_RETURN_IF_NULL(rhi);
+        if (!m_load_scheduler.IsIdle() || !m_dedicated_upload_buffers.empty())
+        {
+            FinishTextureLoads(rhi->GetCompletedCopyFenceValue());
         }
+        // 流送请求与文件加载走同一条解码 / 上传路径
+        UpdateTextureStreaming();
+        ProcessTextureLoads();
+    }
+
+    void TextureManager::ProcessTextureLoads()
+    {
+        if (m_load_scheduler.IsIdle())
+        {
+            return;
+        }
+        ReceiveDecodedTextures();
+        StartDecodeTasks();
+        SubmitTextureUploads();
+        ReleaseAbandonedLoads();
+    }
+
+    void TextureManager::UpdateTextureStreaming()
+    {
+        if (m_streamed_textures.empty())
+        {
+            m_streaming_feedback.Clear();
+            return;
+        }
+
+        std::vector<TextureStreamingRequest> requests;
+        m_streaming_policy.Update(m_streaming_feedback, requests);
+        m_streaming_feedback.Clear();
+
+        for (const TextureStreamingRequest& request : requests)
+        {
+            auto streamed_iter = m_streamed_textures.find(request.texture_id);
+            if (streamed_iter == m_streamed_textures.end() || m_loading_textures.find(request.texture_id) != m_loading_textures.end())
+            {
+                m_streaming_policy.OnStreamingFinished(request.texture_id, m_streaming_policy.GetResidentFirstMip(request.texture_id));
+                continue;
+            }
+
+            // 重新解码文件并按新的 first mip 创建资源；完成之前纹理继续使用当前的资源
+            std::unique_ptr<PendingTextureLoad> pending = std::make_unique<PendingTextureLoad>();
+            pending->texture_id = request.texture_id;
+            pending->file_type = streamed_iter->second.file_type;
+            pending->file_path = streamed_iter->second.file_path;
+            pending->file_path_w = streamed_iter->second.file_path_w;
+            pending->first_mip = request.first_mip;
+            pending->streamed = true;
+            pending->streaming_update = true;
+
+            const TextureLoadScheduler::RequestID load_request = m_load_scheduler.AddRequest();
+            m_loading_textures[request.texture_id] = load_request;
+            m_pending_loads[load_request] = std::move(pending);
+        }
+    }
 
+    void TextureManager::StopTextureStreaming(TextureID texture_id)
+    {
+        m_streaming_policy.UnregisterTexture(texture_id);
+        m_streamed_textures.erase(texture_id);
+    }
+
+    void TextureManager::WaitForPendingLoads()
+    {
+        RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+        if (!rhi || !rhi->GetDevice())
+        {
+            // 设备已经释放，拷贝无法再完成，只能丢弃
+            m_pending_loads.clear();
+            m_loading_textures.clear();
+            m_load_scheduler.Clear();
+            return;
+        }
+
+        TaskManager* task_manager = g_dolas_engine.m_task_manager;
+        while (!m_load_scheduler.IsIdle())
+        {
+            for (auto& pending_pair : m_pending_loads)
+            {
+                PendingTextureLoad* pending = pending_pair.second.get();
+                if (pending->decode_task != 0 && task_manager)
+                {
+                    task_manager->WaitForTask(pending->decode_task);
+                    pending->decode_task = 0;
+                }
+            }
+            FinishTextureLoads(rhi->GetCompletedCopyFenceValue());
+            ProcessTextureLoads();
+            rhi->WaitForCopyFence(m_last_copy_fence_value);
+        }
+        FinishTextureLoads(rhi->GetCompletedCopyFenceValue());
+    }
+
+    void TextureManager::CancelTextureLoad(TextureLoadScheduler::RequestID request)
+    {
+        auto pending_iter = m_pending_loads.find(request);
+        if (pending_iter == m_pending_loads.end())
+        {
+            return;
+        }
+        m_load_scheduler.Cancel(request);
+        m_loading_textures.erase(pending_iter->second->texture_id);
+        StopTextureStreaming(pending_iter->second->texture_id);
+        pending_iter->second->texture_id = TEXTURE_ID_EMPTY;
+    }
+
+    void TextureManager::FinishTextureLoads(ULongLong completed_fence_value)
+    {
+        std::vector<TextureLoadScheduler::RequestID> completed_requests;
+        m_load_scheduler.Retire(completed_fence_value, completed_requests);
+
+        auto retired_buffers = std::remove_if(m_dedicated_upload_buffers.begin(), m_dedicated_upload_buffers.end(),
+            [completed_fence_value](std::pair<ULongLong, ID3D12Resource*>& upload_buffer)
+            {
+                if (upload_buffer.first > completed_fence_value)
+                {
+                    return false;
+                }
+                SafeRelease(upload_buffer.second);
+                return true;
+            });
+        m_dedicated_upload_buffers.erase(retired_buffers, m_dedicated_upload_buffers.end());
+
+        if (completed_requests.empty())
+        {
+            return;
+        }
+
+        RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+        ID3D12Device* device = rhi ? rhi->GetDevice() : nullptr;
         ID3D11Device* d3d11_device = g_dolas_engine.m_rhi ? g_dolas_engine.m_rhi->GetD3D11Device() : nullptr;
-        if (d3d11_device)
+        for (TextureLoadScheduler::RequestID request : completed_requests)
         {
-            ID3D11Resource* d3d_resource = nullptr;
-            HRESULT hr = DirectX::CreateTexture(
-                d3d11_device,
-                image.GetImages(),
-                image.GetImageCount(),
-                metadata,
-                &d3d_resource);
-            if (SUCCEEDED(hr) && d3d_resource)
+            auto pending_iter = m_pending_loads.find(request);
+            if (pending_iter == m_pending_loads.end())
+            {
+                continue;
+            }
+
+            PendingTextureLoad* pending = pending_iter->second.get();
+            Texture* texture = GetTextureByTextureID(pending->texture_id);
+            if (texture && device)
             {
-                hr = d3d_resource->QueryInterface(
-                    __uuidof(ID3D11Texture2D),
-                    reinterpret_cast<void**>(&texture->m_d3d_texture_2d));
-                if (FAILED(hr))
+                // 占位 SRV（或流送前的资源）所在的 descriptor 原地换成新的纹理，材质里记录的 bindless 下标不变
+                const D3D12_SHADER_RESOURCE_VIEW_DESC srv_desc = CreateD3D12SrvDescFromMetadata(GetResidentMetadata(pending->metadata, pending->first_mip));
+                device->CreateShaderResourceView(pending->resource, &srv_desc, texture->GetD3D12SrvCpuHandle());
+                // 流送替换下来的资源可以立即释放：Present 等待 GPU 完成上一帧，渲染前已经没有命令引用它
+                ID3D12Resource* previous_resource = texture->GetD3D12Resource();
+                SafeRelease(previous_resource);
+                // 拷贝队列用过的纹理在提交结束时衰减为 COMMON，首次作为 SRV 绑定时由 TransitionTexture 转换
+                texture->SetD3D12Resource(pending->resource, D3D12_RESOURCE_STATE_COMMON);
+                pending->resource = nullptr;
+                SetD3D12DebugName(texture->GetD3D12Resource(), pending->file_path_w);
+
+                texture->m_texture_type = ConvertToDolasTextureType(pending->metadata);
+                texture->m_texture_format = ConvertToTextureFormat(pending->metadata.format);
+                texture->m_width = static_cast<uint32_t>(pending->metadata.width);
+                texture->m_height = static_cast<uint32_t>(pending->metadata.height);
+                texture->m_mip_levels = static_cast<uint32_t>(pending->metadata.mipLevels);
+
+                // 流送纹理的常驻 mip 会变化，不创建完整的 D3D11 镜像
+                if (d3d11_device && pending->decoded && !pending->streamed)
                 {
-                    LOG_WARN("TextureManager::CreateTextureFromHDRFile: failed to create optional D3D11 texture mirror for {0}, HRESULT: 0x{1:X}", texture_file_path, hr);
+                    const DirectX::ScratchImage& image = pending->decoded->image;
+                    ID3D11Resource* d3d_resource = nullptr;
+                    HRESULT hr = DirectX::CreateTexture(d3d11_device, image.GetImages(), image.GetImageCount(), pending->metadata, &d3d_resource);
+                    if (SUCCEEDED(hr) && d3d_resource)
+                    {
+                        hr = d3d_resource->QueryInterface(
+                            __uuidof(ID3D11Texture2D),
+                            reinterpret_cast<void**>(&texture->m_d3d_texture_2d));
+                        if (FAILED(hr))
+                        {
+                            LOG_WARN("TextureManager::FinishTextureLoads: failed to create optional D3D11 texture mirror for {0}, HRESULT: 0x{1:X}", pending->file_path, hr);
+                        }
+                        d3d_resource->Release();
+                    }
+                    else
+                    {
+                        LOG_WARN("TextureManager::FinishTextureLoads: failed to create optional D3D11 resource mirror for {0}, HRESULT: 0x{1:X}", pending->file_path, hr);
+                    }
+
+                    hr = DirectX::CreateShaderResourceView(d3d11_device, image.GetImages(), image.GetImageCount(), pending->metadata, &texture->m_d3d_shader_resource_view);
+                    if (FAILED(hr))
+                    {
+                        LOG_WARN("TextureManager::FinishTextureLoads: failed to create optional D3D11 SRV mirror for {0}, HRESULT: 0x{1:X}", pending->file_path, hr);
+                    }
+
+                    // Debug names for RenderDoc
+                    SetD3DDebugName(texture->m_d3d_texture_2d, std::string("Tex2D: ") + pending->file_path);
+                    SetD3DDebugName(texture->m_d3d_shader_resource_view, std::string("SRV: ") + pending->file_path);
+                }
+
+                if (pending->streamed)
+                {
+                    m_streaming_policy.OnStreamingFinished(pending->texture_id, pending->first_mip);
+                }
+                if (!pending->streaming_update)
+                {
+                    LOG_INFO("Successfully loaded texture: {0}", pending->file_path);
                 }
-                d3d_resource->Release();
             }
-            else
+
+            m_loading_textures.erase(pending->texture_id);
+            m_pending_loads.erase(pending_iter);
+        }
+
+        // 常驻 SRV table 里拷贝的是旧的占位 descriptor
+        if (g_dolas_engine.m_rhi)
+        {
+            g_dolas_engine.m_rhi->InvalidateD3D12SrvTables();
+        }
+    }
+
+    void TextureManager::ReceiveDecodedTextures()
+    {
+        RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+        ID3D12Device* device = rhi ? rhi->GetDevice() : nullptr;
+        DOLAS_RETURN_IF_NULL(device);
+        TaskManager* task_manager = g_dolas_engine.m_task_manager;
+
+        D3D12_HEAP_PROPERTIES default_heap_properties = {};
+        default_heap_properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+        default_heap_properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        default_heap_properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+        default_heap_properties.CreationNodeMask = 1;
+        default_heap_properties.VisibleNodeMask = 1;
+
+        for (auto& pending_pair : m_pending_loads)
+        {
+            const TextureLoadScheduler::RequestID request = pending_pair.first;
+            PendingTextureLoad* pending = pending_pair.second.get();
+            if (m_load_scheduler.GetState(request) != TextureLoadState::Decoding)
+            {
+                continue;
+            }
+            if (pending->decode_task != 0)
+            {
+                if (task_manager && !task_manager->IsTaskComplete(pending->decode_task))
+                {
+                    continue;
+                }
+                if (task_manager)
+                {
+                    // 从任务表中移除
+                    task_manager->WaitForTask(pending->decode_task);
+                }
+                pending->decode_task = 0;
+            }
+
+            if (pending->texture_id == TEXTURE_ID_EMPTY)
+            {
+                m_load_scheduler.OnDecodeFailed(request);
+                continue;
+            }
+            if (FAILED(pending->decoded->result))
             {
-                LOG_WARN("TextureManager::CreateTextureFromHDRFile: failed to create optional D3D11 resource mirror for {0}, HRESULT: 0x{1:X}", texture_file_path, hr);
+                LOG_ERROR("TextureManager: failed to decode {0}, HRESULT: 0x{1:X}", pending->file_path, pending->decoded->result);
+                m_load_scheduler.OnDecodeFailed(request);
+                m_loading_textures.erase(pending->texture_id);
+                continue;
             }
 
-            hr = DirectX::CreateShaderResourceView(
-                d3d11_device,
-                image.GetImages(),
-                image.GetImageCount(),
-                metadata,
-                &texture->m_d3d_shader_resource_view);
+            pending->metadata = pending->decoded->image.GetMetadata();
+            pending->first_mip = std::min<UInt>(pending->first_mip, static_cast<UInt>(std::max<size_t>(1, pending->metadata.mipLevels)) - 1);
+            const DirectX::TexMetadata resident_metadata = GetResidentMetadata(pending->metadata, pending->first_mip);
+            const D3D12_RESOURCE_DESC texture_desc = BuildD3D12TextureResourceDesc(resident_metadata);
+            // 以 COMMON 创建：拷贝队列上隐式提升为 COPY_DEST，提交结束时衰减回 COMMON
+            HRESULT hr = device->CreateCommittedResource(
+                &default_heap_properties,
+                D3D12_HEAP_FLAG_NONE,
+                &texture_desc,
+                D3D12_RESOURCE_STATE_COMMON,
+                nullptr,
+                IID_PPV_ARGS(&pending->resource));
             if (FAILED(hr))
             {
-                LOG_WARN("TextureManager::CreateTextureFromHDRFile: failed to create optional D3D11 SRV mirror for {0}, HRESULT: 0x{1:X}", texture_file_path, hr);
+                LOG_ERROR("TextureManager: failed to create texture for {0}, HRESULT: 0x{1:X}", pending->file_path, hr);
+                m_load_scheduler.OnDecodeFailed(request);
+                m_loading_textures.erase(pending->texture_id);
+                continue;
+            }
+
+            const UINT subresource_count = GetSubresourceCount(resident_metadata);
+            pending->layouts.resize(subresource_count);
+            pending->num_rows.resize(subresource_count);
+            pending->row_sizes_in_bytes.resize(subresource_count);
+            device->GetCopyableFootprints(
+                &texture_desc,
+                0,
+                subresource_count,
+                0,
+                pending->layouts.data(),
+                pending->num_rows.data(),
+                pending->row_sizes_in_bytes.data(),
+                nullptr);
+
+            // 每个子资源在上传环中单独放置，占用按自己的行距计算
+            std::vector<ULongLong> subresource_sizes(subresource_count);
+            for (UINT subresource_index = 0; subresource_index < subresource_count; ++subresource_index)
+            {
+                const D3D12_SUBRESOURCE_FOOTPRINT& footprint = pending->layouts[subresource_index].Footprint;
+                subresource_sizes[subresource_index] = static_cast<ULongLong>(footprint.RowPitch) *
+                    pending->num_rows[subresource_index] * std::max<UINT>(1, footprint.Depth);
             }
+            m_load_scheduler.OnDecoded(request, subresource_sizes);
         }
+    }
 
-        // Debug names for RenderDoc
-        SetD3DDebugName(texture->m_d3d_texture_2d, std::string("Tex2D_HDR: ") + texture_file_path);
-        SetD3DDebugName(texture->m_d3d_shader_resource_view, std::string("SRV_HDR: ") + texture_file_path);
-        
-        DestroyTextureByID(texture->m_file_id);
-        m_textures[texture->m_file_id] = texture;
-        
-        LOG_INFO("Successfully loaded HDR texture: {0}", texture_file_path);
-        return texture->m_file_id;
+    void TextureManager::StartDecodeTasks()
+    {
+        std::vector<TextureLoadScheduler::RequestID> requests;
+        m_load_scheduler.TakeDecodeRequests(requests);
+
+        TaskManager* task_manager = g_dolas_engine.m_task_manager;
+        for (TextureLoadScheduler::RequestID request : requests)
+        {
+            PendingTextureLoad* pending = m_pending_loads[request].get();
+            pending->decoded = std::make_shared<DecodedTexture>();
+            auto decode = [decoded = pending->decoded, file_type = pending->file_type, file_path_w = pending->file_path_w]()
+            {
+                decoded->result = PendingTextureLoad::Decode(file_type, file_path_w, decoded->image);
+            };
+
+            pending->decode_task = task_manager ? task_manager->EnqueueTask(decode) : 0;
+            if (pending->decode_task == 0)
+            {
+                // 线程池不可用时退化为同步解码
+                decode();
+            }
+        }
     }
 
-	TextureID TextureManager::CreateTextureFromPNGFile(const AssetPath& asset_path)
-	{
-		const auto resolved_path = PathUtils::ResolveAssetPath(asset_path);
-		if (!resolved_path)
-		{
-			LOG_ERROR("TextureManager::CreateTextureFromPNGFile: failed to resolve {0}", asset_path.GetCanonicalPath());
-			return TEXTURE_ID_EMPTY;
-		}
-
-		const std::string texture_file_path = resolved_path->string();
-		const std::wstring texture_file_path_w = StringUtil::StringToWString(texture_file_path);
-
-		// 使用 DirectXTex 的 WIC 加载 API (支持 PNG, JPG, BMP 等)
-		DirectX::TexMetadata metadata;
-		DirectX::ScratchImage image;
-
-		// 从 WIC 文件加载
-		HRESULT load_hr = DirectX::LoadFromWICFile(
-			texture_file_path_w.c_str(),
-			DirectX::WIC_FLAGS_NONE,
-			&metadata,
-			image);
-		if (FAILED(load_hr))
-		{
-			LOG_ERROR("TextureManager::CreateTextureFromPNGFile: failed to load {0}, HRESULT: 0x{1:X}", texture_file_path, load_hr);
-			return TEXTURE_ID_EMPTY;
-		}
-
-		Texture* texture = DOLAS_NEW(Texture);
-		texture->m_is_from_file = true;
-		texture->m_file_id = HashConverter::StringHash(asset_path.GetCanonicalPath());
-		texture->m_texture_type = ConvertToDolasTextureType(metadata);
-		texture->m_texture_format = ConvertToTextureFormat(metadata.format);
-		texture->m_width = static_cast<uint32_t>(metadata.width);
-		texture->m_height = static_cast<uint32_t>(metadata.height);
-		texture->m_mip_levels = static_cast<uint32_t>(metadata.mipLevels);
-		if (!CreateD3D12TextureFromScratchImage(image, metadata, texture_file_path_w, texture))
-		{
-			LOG_ERROR("Failed to create D3D12 PNG texture: {0}", texture_file_path);
-			texture->Release();
-			DOLAS_DELETE(texture);
-			return TEXTURE_ID_EMPTY;
-		}
-
-		ID3D11Device* d3d11_device = g_dolas_engine.m_rhi ? g_dolas_engine.m_rhi->GetD3D11Device() : nullptr;
-		if (d3d11_device)
-		{
-			ID3D11Resource* d3d_resource = nullptr;
-			HRESULT hr = DirectX::CreateTexture(
-				d3d11_device,
-				image.GetImages(),
-				image.GetImageCount(),
-				metadata,
-				&d3d_resource);
-			if (SUCCEEDED(hr) && d3d_resource)
-			{
-				hr = d3d_resource->QueryInterface(
-					__uuidof(ID3D11Texture2D),
-					reinterpret_cast<void**>(&texture->m_d3d_texture_2d));
-				if (FAILED(hr))
-				{
-					LOG_WARN("TextureManager::CreateTextureFromPNGFile: failed to create optional D3D11 texture mirror for {0}, HRESULT: 0x{1:X}", texture_file_path, hr);
-				}
-				d3d_resource->Release();
-			}
-			else
-			{
-				LOG_WARN("TextureManager::CreateTextureFromPNGFile: failed to create optional D3D11 resource mirror for {0}, HRESULT: 0x{1:X}", texture_file_path, hr);
-			}
-
-			hr = DirectX::CreateShaderResourceView(
-				d3d11_device,
-				image.GetImages(),
-				image.GetImageCount(),
-				metadata,
-				&texture->m_d3d_shader_resource_view);
-			if (FAILED(hr))
-			{
-				LOG_WARN("TextureManager::CreateTextureFromPNGFile: failed to create optional D3D11 SRV mirror for {0}, HRESULT: 0x{1:X}", texture_file_path, hr);
-			}
-		}
-
-		// Debug names for RenderDoc
-		SetD3DDebugName(texture->m_d3d_texture_2d, std::string("Tex2D_PNG: ") + texture_file_path);
-		SetD3DDebugName(texture->m_d3d_shader_resource_view, std::string("SRV_PNG: ") + texture_file_path);
-
-		DestroyTextureByID(texture->m_file_id);
-		m_textures[texture->m_file_id] = texture;
-
-		LOG_INFO("Successfully loaded PNG texture: {0}", texture_file_path);
-		return texture->m_file_id;
-	}
+    void TextureManager::SubmitTextureUploads()
+    {
+        std::vector<TextureUploadCopy> copies;
+        m_load_scheduler.BuildBatch(copies);
+        if (copies.empty())
+        {
+            return;
+        }
+
+        RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+        ID3D12Device* device = rhi->GetDevice();
+
+        struct RecordedCopy
+        {
+            D3D12_TEXTURE_COPY_LOCATION destination = {};
+            D3D12_TEXTURE_COPY_LOCATION source = {};
+        };
+        std::vector<RecordedCopy> recorded_copies;
+        recorded_copies.reserve(copies.size());
+        std::vector<ID3D12Resource*> dedicated_buffers;
+        std::vector<ID3D12Resource*> finished_resources;
+        std::vector<TextureLoadScheduler::RequestID> failed_requests;
+        for (const TextureUploadCopy& copy : copies)
+        {
+            PendingTextureLoad* pending = m_pending_loads[copy.request].get();
+            // 流送纹理只有一个数组切片，资源的子资源 i 对应文件中的 mip first_mip + i
+            const DirectX::Image* image = GetSubresourceImage(pending->decoded->image, copy.subresource + pending->first_mip);
+            if (!image)
+            {
+                failed_requests.push_back(copy.request);
+                continue;
+            }
+
+            D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint = pending->layouts[copy.subresource];
+            ID3D12Resource* upload_buffer = m_upload_ring_buffer;
+            uint8_t* destination = nullptr;
+            if (copy.dedicated)
+            {
+                upload_buffer = CreateD3D12UploadBuffer(device, copy.size);
+                D3D12_RANGE read_range = { 0, 0 };
+                if (!upload_buffer || FAILED(upload_buffer->Map(0, &read_range, reinterpret_cast<void**>(&destination))))
+                {
+                    SafeRelease(upload_buffer);
+                    failed_requests.push_back(copy.request);
+                    continue;
+                }
+                dedicated_buffers.push_back(upload_buffer);
+                footprint.Offset = 0;
+            }
+            else
+            {
+                destination = m_upload_ring_data + copy.ring_offset;
+                footprint.Offset = copy.ring_offset;
+            }
+
+            CopySubresourceToUploadMemory(
+                *image,
+                footprint,
+                pending->num_rows[copy.subresource],
+                pending->row_sizes_in_bytes[copy.subresource],
+                destination);
+            if (copy.dedicated)
+            {
+                upload_buffer->Unmap(0, nullptr);
+            }
+
+            RecordedCopy recorded;
+            recorded.destination.pResource = pending->resource;
+            recorded.destination.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+            recorded.destination.SubresourceIndex = copy.subresource;
+            recorded.source.pResource = upload_buffer;
+            recorded.source.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+            recorded.source.PlacedFootprint = footprint;
+            recorded_copies.push_back(recorded);
+
+            // 直接队列上提升到 COPY_DEST 的纹理不会在提交结束时衰减，最后一个子资源拷贝之后显式转回 COMMON
+            if (!rhi->HasCopyQueue() && copy.subresource + 1 == pending->layouts.size())
+            {
+                finished_resources.push_back(pending->resource);
+            }
+        }
+
+        UINT64 fence_value = 0;
+        const bool submitted = recorded_copies.empty() || rhi->ExecuteCopyCommands([&](ID3D12GraphicsCommandList* command_list) -> bool
+        {
+            for (const RecordedCopy& recorded : recorded_copies)
+            {
+                command_list->CopyTextureRegion(&recorded.destination, 0, 0, 0, &recorded.source, nullptr);
+            }
+            for (ID3D12Resource* resource : finished_resources)
+            {
+                D3D12_RESOURCE_BARRIER barrier = {};
+                barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+                barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+                barrier.Transition.pResource = resource;
+                barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+                barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
+                barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COMMON;
+                command_list->ResourceBarrier(1, &barrier);
+            }
+            return true;
+        }, &fence_value);
+
+        // 提交失败时上传环的空间同样要随批次回收
+        m_load_scheduler.SubmitBatch(fence_value);
+        m_last_copy_fence_value = std::max(m_last_copy_fence_value, fence_value);
+        for (ID3D12Resource* upload_buffer : dedicated_buffers)
+        {
+            m_dedicated_upload_buffers.emplace_back(fence_value, upload_buffer);
+        }
+
+        if (!submitted)
+        {
+            LOG_ERROR("TextureManager: failed to submit texture upload batch of {0} copies", copies.size());
+            for (const TextureUploadCopy& copy : copies)
+            {
+                failed_requests.push_back(copy.request);
+            }
+        }
+        // 失败的纹理保留占位 SRV
+        for (TextureLoadScheduler::RequestID request : failed_requests)
+        {
+            CancelTextureLoad(request);
+        }
+
+        // 所有子资源都已写入上传缓冲的纹理不再需要解码结果（D3D11 镜像在完成时还要用到）
+        const Bool has_d3d11_device = g_dolas_engine.m_rhi && g_dolas_engine.m_rhi->GetD3D11Device();
+        for (const TextureUploadCopy& copy : copies)
+        {
+            auto pending_iter = m_pending_loads.find(copy.request);
+            if (pending_iter != m_pending_loads.end() &&
+                (!has_d3d11_device || pending_iter->second->streamed) &&
+                m_load_scheduler.GetState(copy.request) != TextureLoadState::Decoded)
+            {
+                pending_iter->second->decoded.reset();
+            }
+        }
+    }
+
+    void TextureManager::ReleaseAbandonedLoads()
+    {
+        for (auto pending_iter = m_pending_loads.begin(); pending_iter != m_pending_loads.end();)
+        {
+            if (m_load_scheduler.GetState(pending_iter->first) == TextureLoadState::None)
+            {
+                // 加载失败：纹理保留占位 SRV 或流送前的 mip，不再参与流送
+                m_loading_textures.erase(pending_iter->second->texture_id);
+                StopTextureStreaming(pending_iter->second->texture_id);
+                pending_iter = m_pending_loads.erase(pending_iter);
+            }
+            else
+            {
+                ++pending_iter;
+            }
+        }
+    }
+
+    Bool TextureManager::CreatePlaceholderTextures()
+    {
+        const UByte placeholder_colors[][4] =
+        {
+            { 128, 128, 128, 255 },  // Grey
+            { 128, 128, 255, 255 },  // FlatNormal
+        };
+        static_assert(std::size(placeholder_colors) == static_cast<std::size_t>(TexturePlaceholder::Count));
+
+        for (std::size_t placeholder_index = 0; placeholder_index < std::size(placeholder_colors); ++placeholder_index)
+        {
+            DirectX::ScratchImage image;
+            HRESULT hr = image.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, 1, 1, 1, 1);
+            if (FAILED(hr))
+            {
+                LOG_ERROR("TextureManager::CreatePlaceholderTextures: failed to initialize image, HRESULT: 0x{0:X}", hr);
+                return false;
+            }
+            memcpy(image.GetPixels(), placeholder_colors[placeholder_index], sizeof(placeholder_colors[placeholder_index]));
+
+            Texture* texture = DOLAS_NEW(Texture);
+            texture->m_texture_format = DolasTextureFormat::R8G8B8A8_UNORM;
+            texture->m_width = 1;
+            texture->m_height = 1;
+            if (!CreateD3D12TextureFromScratchImage(image, image.GetMetadata(), L"Tex2D: Placeholder", texture))
+            {
+                LOG_ERROR("TextureManager::CreatePlaceholderTextures: failed to create placeholder texture");
+                texture->Release();
+                DOLAS_DELETE(texture);
+                return false;
+            }
+            m_placeholder_textures[placeholder_index] = texture;
+        }
+        return true;
+    }
+
+    Bool TextureManager::CreateUploadRingBuffer()
+    {
+        RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+        ID3D12Device* device = rhi ? rhi->GetDevice() : nullptr;
+        DOLAS_RETURN_FALSE_IF_NULL(device);
+
+        const TextureLoadSchedulerDesc scheduler_desc;
+        m_upload_ring_buffer = CreateD3D12UploadBuffer(device, scheduler_desc.staging_capacity);
+        DOLAS_RETURN_FALSE_IF_NULL(m_upload_ring_buffer);
+
+        // 上传堆的内存可以一直映射
+        D3D12_RANGE read_range = { 0, 0 };
+        HRESULT hr = m_upload_ring_buffer->Map(0, &read_range, reinterpret_cast<void**>(&m_upload_ring_data));
+        if (FAILED(hr))
+        {
+            LOG_ERROR("TextureManager::CreateUploadRingBuffer: failed to map upload ring, HRESULT: 0x{0:X}", hr);
+            SafeRelease(m_upload_ring_buffer);
+            m_upload_ring_data = nullptr;
+            return false;
+        }
+        SetD3D12DebugName(m_upload_ring_buffer, L"TextureUploadRing");
+
+        m_load_scheduler.Initialize(scheduler_desc);
+        m_last_copy_fence_value = 0;
+        return true;
+    }
 
 	Texture* TextureManager::GetGlobalTexture(GlobalTextureType global_texture_type)
     {
@@ -922,7 +1734,36 @@ namespace Dolas
 
     Bool TextureManager::DolasCreateTexture2D(const DolasTexture2DDesc& dolas_texture2d_desc)
     {
-        D3D11_TEXTURE2D_DESC d3d_texture2d_desc = (D3D11_TEXTURE2D_DESC)0;
+        D3D11_TEXTURE2D_DESC d3d_texture2d_desc;
+        ConvertToD3D11Texture2DDesc(dolas_texture2d_desc, d3d_texture2d_desc);
+        return D3DCreateTexture2D(dolas_texture2d_desc.texture_handle, &d3d_texture2d_desc, dolas_texture2d_desc.placedHeap, dolas_texture2d_desc.placedHeapOffset);
+    }
+
+    Bool TextureManager::GetTexture2DAllocationInfo(const DolasTexture2DDesc& dolas_texture2d_desc, ULongLong& out_size, ULongLong& out_alignment)
+    {
+        out_size = 0;
+        out_alignment = 0;
+        RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+        ID3D12Device* device = rhi ? rhi->GetDevice() : nullptr;
+        DOLAS_RETURN_FALSE_IF_NULL(device);
+
+        D3D11_TEXTURE2D_DESC d3d_texture2d_desc;
+        ConvertToD3D11Texture2DDesc(dolas_texture2d_desc, d3d_texture2d_desc);
+        const D3D12_RESOURCE_DESC resource_desc = BuildD3D12Texture2DResourceDesc(&d3d_texture2d_desc);
+        const D3D12_RESOURCE_ALLOCATION_INFO allocation_info = device->GetResourceAllocationInfo(0, 1, &resource_desc);
+        if (allocation_info.SizeInBytes == 0 || allocation_info.SizeInBytes == UINT64_MAX)
+        {
+            LOG_ERROR("TextureManager::GetTexture2DAllocationInfo: invalid allocation info for texture {0}", ID_TO_STRING(dolas_texture2d_desc.texture_handle));
+            return false;
+        }
+        out_size = allocation_info.SizeInBytes;
+        out_alignment = allocation_info.Alignment;
+        return true;
+    }
+
+    void TextureManager::ConvertToD3D11Texture2DDesc(const DolasTexture2DDesc& dolas_texture2d_desc, D3D11_TEXTURE2D_DESC& d3d_texture2d_desc)
+    {
+        d3d_texture2d_desc = (D3D11_TEXTURE2D_DESC)0;
 		d3d_texture2d_desc.Width = dolas_texture2d_desc.width;
 		d3d_texture2d_desc.Height = dolas_texture2d_desc.height;
 		d3d_texture2d_desc.MipLevels = dolas_texture2d_desc.generateMips ? 0 : 1; // 0表示自动生成所有mip级别
@@ -967,8 +1808,6 @@ namespace Dolas
             d3d_texture2d_desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ | D3D11_CPU_ACCESS_WRITE;
             break;
         }
-
-        return D3DCreateTexture2D(dolas_texture2d_desc.texture_handle, &d3d_texture2d_desc);
     }
     DXGI_FORMAT TextureManager::ConvertToDXGIFormat(DolasTextureFormat texture_format)
     {
@@ -982,8 +1821,12 @@ namespace Dolas
             case DolasTextureFormat::BC3_SRGB:               return DXGI_FORMAT_BC3_UNORM_SRGB;
             case DolasTextureFormat::BC7_UNORM:              return DXGI_FORMAT_BC7_UNORM;
             case DolasTextureFormat::BC7_SRGB:               return DXGI_FORMAT_BC7_UNORM_SRGB;
+            case DolasTextureFormat::BC4_UNORM:              return DXGI_FORMAT_BC4_UNORM;
+            case DolasTextureFormat::BC5_UNORM:              return DXGI_FORMAT_BC5_UNORM;
+            case DolasTextureFormat::BC6H_UF16:              return DXGI_FORMAT_BC6H_UF16;
             case DolasTextureFormat::R32G32B32A32_FLOAT:     return DXGI_FORMAT_R32G32B32A32_FLOAT;
             case DolasTextureFormat::R16G16B16A16_FLOAT:     return DXGI_FORMAT_R16G16B16A16_FLOAT;
+            case DolasTextureFormat::R10G10B10A2_UNORM:      return DXGI_FORMAT_R10G10B10A2_UNORM;
             case DolasTextureFormat::D24_UNORM_S8_UINT:      return DXGI_FORMAT_D24_UNORM_S8_UINT;
             case DolasTextureFormat::D32_FLOAT:              return DXGI_FORMAT_D32_FLOAT;
             case DolasTextureFormat::R32_TYPELESS:           return DXGI_FORMAT_R32_TYPELESS;
@@ -1006,8 +1849,12 @@ namespace Dolas
         case DXGI_FORMAT_BC3_UNORM_SRGB:            return DolasTextureFormat::BC3_SRGB;
         case DXGI_FORMAT_BC7_UNORM:                 return DolasTextureFormat::BC7_UNORM;
         case DXGI_FORMAT_BC7_UNORM_SRGB:            return DolasTextureFormat::BC7_SRGB;
+        case DXGI_FORMAT_BC4_UNORM:                 return DolasTextureFormat::BC4_UNORM;
+        case DXGI_FORMAT_BC5_UNORM:                 return DolasTextureFormat::BC5_UNORM;
+        case DXGI_FORMAT_BC6H_UF16:                 return DolasTextureFormat::BC6H_UF16;
         case DXGI_FORMAT_R32G32B32A32_FLOAT:        return DolasTextureFormat::R32G32B32A32_FLOAT;
         case DXGI_FORMAT_R16G16B16A16_FLOAT:        return DolasTextureFormat::R16G16B16A16_FLOAT;
+        case DXGI_FORMAT_R10G10B10A2_UNORM:         return DolasTextureFormat::R10G10B10A2_UNORM;
         case DXGI_FORMAT_D24_UNORM_S8_UINT:         return DolasTextureFormat::D24_UNORM_S8_UINT;
         case DXGI_FORMAT_D32_FLOAT:                 return DolasTextureFormat::D32_FLOAT;
         case DXGI_FORMAT_R32_TYPELESS:              return DolasTextureFormat::R32_TYPELESS;
@@ -1020,7 +1867,9 @@ namespace Dolas
 
     Bool TextureManager::D3DCreateTexture2D(
         TextureID texture_handle,
-        const D3D11_TEXTURE2D_DESC* pDesc)
+        const D3D11_TEXTURE2D_DESC* pDesc,
+        ID3D12Heap* placed_heap /*= nullptr*/,
+        ULongLong placed_heap_offset /*= 0*/)
     {
         if (!pDesc)
         {
@@ -1037,7 +1886,7 @@ namespace Dolas
         texture->m_height = pDesc->Height;
         texture->m_mip_levels = pDesc->MipLevels;
 
-        if (!CreateD3D12TextureFromD3D11Desc(texture, pDesc))
+        if (!CreateD3D12TextureFromD3D11Desc(texture, pDesc, placed_heap, placed_heap_offset))
         {
             LOG_ERROR("TextureManager::D3DCreateTexture2D: Failed to create D3D12 texture");
             texture->Release();
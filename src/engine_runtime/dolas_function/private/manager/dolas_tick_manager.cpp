@@ -7,6 +7,7 @@
 #include "manager/dolas_render_camera_manager.h"
 #include "manager/dolas_imgui_manager.h"
 #include "manager/dolas_debug_draw_manager.h"
+#include "manager/dolas_texture_manager.h"
 namespace Dolas
 {
 	using Dolas::TaskGUID;
@@ -53,6 +54,8 @@ namespace Dolas
 
     void TickManager::TickPreRender(Float delta_time)
     {
+        // 在录制本帧命令之前切换完成加载的纹理 SRV，并提交新的上传批次
+        g_dolas_engine.m_texture_manager->TickPreRender();
         g_dolas_engine.m_imgui_manager->TickPreRender();
     }
 
@@ -221,6 +221,26 @@ namespace Dolas
             return false;
         }
 
+        // upload heap 上的缓冲区常驻 GENERIC_READ 状态，shader 可以直接读取
+        if (type == BufferType::STRUCTURED_BUFFER && stride > 0)
+        {
+            if (!render_hardware_interface->AllocateSrvDescriptor(&m_d3d12_srv_cpu_handle, &m_d3d12_srv_gpu_handle))
+            {
+                LOG_ERROR("Buffer::CreateBuffer: Failed to allocate D3D12 SRV descriptor");
+                return false;
+            }
+
+            D3D12_SHADER_RESOURCE_VIEW_DESC srv_desc = {};
+            srv_desc.Format = DXGI_FORMAT_UNKNOWN;
+            srv_desc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
+            srv_desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+            srv_desc.Buffer.FirstElement = 0;
+            srv_desc.Buffer.NumElements = m_element_count;
+            srv_desc.Buffer.StructureByteStride = stride;
+            srv_desc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
+            d3d12_device->CreateShaderResourceView(m_d3d12_resource, &srv_desc, m_d3d12_srv_cpu_handle);
+        }
+
         ID3D11Device* device = g_dolas_engine.m_rhi->GetD3D11Device();
         if (!device)
         {
@@ -468,6 +488,14 @@ namespace Dolas
         if (m_d3d_buffer)                { m_d3d_buffer->Release();                m_d3d_buffer = nullptr; }
         if (m_d3d12_resource)       { m_d3d12_resource->Release();       m_d3d12_resource = nullptr; }
 
+        RenderHardwareInterface* render_hardware_interface = g_dolas_engine.m_render_hardware_interface;
+        if (render_hardware_interface)
+        {
+            render_hardware_interface->FreeSrvDescriptor(m_d3d12_srv_cpu_handle, m_d3d12_srv_gpu_handle);
+        }
+        m_d3d12_srv_cpu_handle = {};
+        m_d3d12_srv_gpu_handle = {};
+
         m_size = 0;
         m_stride = 0;
         m_element_count = 0;
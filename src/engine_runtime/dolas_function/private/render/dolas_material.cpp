@@ -2,6 +2,7 @@
 #include "render/dolas_shader.h"
 #include "dolas_engine.h"
 #include "manager/dolas_texture_manager.h"
+#include "render/dolas_rhi.h"
 namespace Dolas
 {
 	Material::Material()
@@ -23,4 +24,36 @@ namespace Dolas
 	{
 		return m_pixel_context;
 	}
-}
\ No newline at end of file
+
+	void Material::SetVertexParameter(const std::string& name, const Vector4& value)
+	{
+		DOLAS_RETURN_IF_NULL(m_vertex_context);
+		g_dolas_engine.m_rhi->WriteMaterialParameters(m_vertex_parameter_block, m_vertex_context->FindGlobalVariable(name), &value, sizeof(Vector4));
+	}
+
+	void Material::SetPixelParameter(const std::string& name, const Vector4& value)
+	{
+		DOLAS_RETURN_IF_NULL(m_pixel_context);
+		g_dolas_engine.m_rhi->WriteMaterialParameters(m_pixel_parameter_block, m_pixel_context->FindGlobalVariable(name), &value, sizeof(Vector4));
+	}
+
+	void Material::SetPixelParameter(const std::string& name, UInt value)
+	{
+		DOLAS_RETURN_IF_NULL(m_pixel_context);
+		g_dolas_engine.m_rhi->WriteMaterialParameters(m_pixel_parameter_block, m_pixel_context->FindGlobalVariable(name), &value, sizeof(UInt));
+	}
+
+	void Material::AllocateParameterBlocks()
+	{
+		DolasRHI* rhi = g_dolas_engine.m_rhi;
+		DOLAS_RETURN_IF_NULL(rhi);
+		if (m_vertex_context)
+		{
+			m_vertex_parameter_block = rhi->AllocateMaterialParameterBlock(static_cast<UInt>(m_vertex_context->GetGlobalConstantBufferData().size()));
+		}
+		if (m_pixel_context)
+		{
+			m_pixel_parameter_block = rhi->AllocateMaterialParameterBlock(static_cast<UInt>(m_pixel_context->GetGlobalConstantBufferData().size()));
+		}
+	}
+}
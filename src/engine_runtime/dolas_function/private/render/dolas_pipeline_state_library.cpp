@@ -0,0 +1,260 @@
+#include "render/dolas_pipeline_state_library.h"
+#include <chrono>
+#include <cwchar>
+#include <filesystem>
+#include "dolas_log_system_manager.h"
+
+namespace Dolas
+{
+	namespace
+	{
+		template<typename T>
+		void SafeRelease(T*& ptr)
+		{
+			if (ptr)
+			{
+				ptr->Release();
+				ptr = nullptr;
+			}
+		}
+
+		// pipeline library 以字符串为名存取 PSO，这里直接使用内容键的十六进制
+		void MakePipelineName(ULongLong key, wchar_t (&name)[17])
+		{
+			std::swprintf(name, 17, L"%016llX", key);
+		}
+	}
+
+	PipelineStateLibrary::PipelineStateLibrary()
+	{
+	}
+
+	PipelineStateLibrary::~PipelineStateLibrary()
+	{
+		Clear();
+	}
+
+	Bool PipelineStateLibrary::Initialize(ID3D12Device* device, const std::string& cache_file_path, ULongLong device_identity)
+	{
+		DOLAS_RETURN_FALSE_IF_NULL(device);
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_device = device;
+		m_cache_file_path = cache_file_path;
+		m_device_identity = device_identity;
+
+		if (m_cache_file.Load(cache_file_path, device_identity))
+		{
+			LOG_INFO("Loaded pipeline cache {0}: {1} records, {2} bytes library.",
+				cache_file_path, m_cache_file.GetRecords().size(), m_cache_file.GetLibraryBlob().size());
+		}
+
+		// ID3D12PipelineLibrary 需要 ID3D12Device1；不支持时仍然可以使用记录做预编译
+		if (FAILED(device->QueryInterface(IID_PPV_ARGS(&m_device1))))
+		{
+			LOG_WARN("ID3D12Device1 unavailable, pipeline library disabled.");
+			return true;
+		}
+
+		const std::vector<UByte>& library_blob = m_cache_file.GetLibraryBlob();
+		HRESULT hr = E_FAIL;
+		if (!library_blob.empty())
+		{
+			hr = m_device1->CreatePipelineLibrary(library_blob.data(), library_blob.size(), IID_PPV_ARGS(&m_pipeline_library));
+			if (FAILED(hr))
+			{
+				// 驱动更新（D3D12_ERROR_DRIVER_VERSION_MISMATCH）等情况下旧的二进制作废，重新开始积累
+				LOG_WARN("Discarding pipeline library from {0}, HRESULT: 0x{1:X}", cache_file_path, hr);
+			}
+		}
+		if (FAILED(hr))
+		{
+			hr = m_device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&m_pipeline_library));
+			if (FAILED(hr))
+			{
+				LOG_WARN("Failed to create D3D12 pipeline library, HRESULT: 0x{0:X}", hr);
+				m_pipeline_library = nullptr;
+			}
+		}
+		return true;
+	}
+
+	Bool PipelineStateLibrary::Save()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_library_dirty && !m_cache_file.IsDirty())
+		{
+			return true;
+		}
+
+		// 当前 library 仍引用 m_cache_file 中的二进制，序列化结果写入一份拷贝
+		PipelineCacheFile file_to_save = m_cache_file;
+		if (m_pipeline_library)
+		{
+			std::vector<UByte> serialized(m_pipeline_library->GetSerializedSize());
+			if (!serialized.empty() && FAILED(m_pipeline_library->Serialize(serialized.data(), serialized.size())))
+			{
+				LOG_WARN("Failed to serialize D3D12 pipeline library.");
+				serialized.clear();
+			}
+			file_to_save.SetLibraryBlob(std::move(serialized));
+		}
+
+		std::error_code error_code;
+		std::filesystem::create_directories(std::filesystem::path(m_cache_file_path).parent_path(), error_code);
+		if (!file_to_save.Save(m_cache_file_path, m_device_identity))
+		{
+			LOG_WARN("Failed to write pipeline cache {0}", m_cache_file_path);
+			return false;
+		}
+
+		LOG_INFO("Saved pipeline cache {0}: {1} records.", m_cache_file_path, file_to_save.GetRecords().size());
+		m_cache_file.MarkSaved();
+		m_library_dirty = false;
+		return true;
+	}
+
+	void PipelineStateLibrary::Clear()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto& pso_pair : m_pipeline_states)
+		{
+			SafeRelease(pso_pair.second);
+		}
+		m_pipeline_states.clear();
+		SafeRelease(m_pipeline_library);
+		SafeRelease(m_device1);
+		m_cache_file.Clear();
+		m_device = nullptr;
+		m_library_dirty = false;
+	}
+
+	ID3D12PipelineState* PipelineStateLibrary::FindOrCreate(
+		ULongLong key,
+		const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+		const PipelineStateRecord& record,
+		PipelineStateSource* out_source /*= nullptr*/,
+		Double* out_create_milliseconds /*= nullptr*/)
+	{
+		if (out_create_milliseconds)
+		{
+			*out_create_milliseconds = 0.0;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto pso_iter = m_pipeline_states.find(key);
+			if (pso_iter != m_pipeline_states.end())
+			{
+				++m_cache_hits;
+				if (out_source) *out_source = PipelineStateSource::Cache;
+				return pso_iter->second;
+			}
+		}
+
+		if (!m_device)
+		{
+			if (out_source) *out_source = PipelineStateSource::Failed;
+			return nullptr;
+		}
+
+		// 驱动编译不持锁，多个工作线程可以同时创建不同的 PSO
+		const auto start_time = std::chrono::high_resolution_clock::now();
+		wchar_t pipeline_name[17] = {};
+		MakePipelineName(key, pipeline_name);
+
+		ID3D12PipelineState* pipeline_state = nullptr;
+		PipelineStateSource source = PipelineStateSource::Compiled;
+		Bool loaded_from_library = false;
+		{
+			// pipeline library 的 Load/Store 都在锁内进行，只有驱动编译在锁外
+			std::lock_guard<std::mutex> lock(m_mutex);
+			loaded_from_library = m_pipeline_library &&
+				SUCCEEDED(m_pipeline_library->LoadGraphicsPipeline(pipeline_name, &desc, IID_PPV_ARGS(&pipeline_state)));
+		}
+		if (loaded_from_library)
+		{
+			source = PipelineStateSource::Library;
+		}
+		else
+		{
+			HRESULT hr = m_device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pipeline_state));
+			if (FAILED(hr))
+			{
+				LOG_ERROR("Failed to create D3D12 graphics pipeline state! HRESULT: 0x{0:X}", hr);
+				++m_failed;
+				if (out_source) *out_source = PipelineStateSource::Failed;
+				return nullptr;
+			}
+		}
+
+		const auto end_time = std::chrono::high_resolution_clock::now();
+		const auto create_microseconds = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count();
+		m_create_microseconds += static_cast<ULongLong>(create_microseconds);
+		if (out_create_milliseconds)
+		{
+			*out_create_milliseconds = static_cast<Double>(create_microseconds) / 1000.0;
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto inserted = m_pipeline_states.emplace(key, pipeline_state);
+		if (!inserted.second)
+		{
+			// 另一个线程抢先创建了同一个 PSO
+			SafeRelease(pipeline_state);
+			++m_cache_hits;
+			if (out_source) *out_source = PipelineStateSource::Cache;
+			return inserted.first->second;
+		}
+
+		if (source == PipelineStateSource::Library)
+		{
+			++m_library_hits;
+		}
+		else
+		{
+			++m_compiled;
+			if (m_pipeline_library && SUCCEEDED(m_pipeline_library->StorePipeline(pipeline_name, pipeline_state)))
+			{
+				m_library_dirty = true;
+			}
+		}
+		m_cache_file.AddRecord(record);
+
+		if (out_source) *out_source = source;
+		return pipeline_state;
+	}
+
+	std::vector<PipelineStateRecord> PipelineStateLibrary::FindRecords(
+		const std::string& vertex_shader_path,
+		const std::string& vertex_entry_point,
+		const std::string& pixel_shader_path,
+		const std::string& pixel_entry_point)
+	{
+		std::vector<PipelineStateRecord> records;
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (const PipelineStateRecord& record : m_cache_file.GetRecords())
+		{
+			if (record.vertex_shader_path == vertex_shader_path &&
+				record.vertex_entry_point == vertex_entry_point &&
+				record.pixel_shader_path == pixel_shader_path &&
+				record.pixel_entry_point == pixel_entry_point)
+			{
+				records.push_back(record);
+			}
+		}
+		return records;
+	}
+
+	PipelineStateLibraryStatistics PipelineStateLibrary::GetStatistics() const
+	{
+		PipelineStateLibraryStatistics statistics;
+		statistics.cache_hits = m_cache_hits;
+		statistics.library_hits = m_library_hits;
+		statistics.compiled = m_compiled;
+		statistics.failed = m_failed;
+		statistics.precompiled = m_precompiled;
+		statistics.precompile_failed = m_precompile_failed;
+		statistics.create_milliseconds = static_cast<Double>(m_create_microseconds.load()) / 1000.0;
+		return statistics;
+	}
+} // namespace Dolas
@@ -0,0 +1,137 @@
+#include "render/dolas_render_draw_list.h"
+#include "dolas_engine.h"
+#include "manager/dolas_material_manager.h"
+#include "manager/dolas_render_primitive_manager.h"
+#include "render/dolas_material.h"
+#include "render/dolas_render_primitive.h"
+#include "render/dolas_rhi.h"
+#include "render/dolas_shader.h"
+
+namespace Dolas
+{
+	namespace
+	{
+		std::size_t HashCombine(std::size_t seed, std::size_t value)
+		{
+			return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+		}
+	}
+
+	RenderDrawList::RenderDrawList()
+	{
+	}
+
+	RenderDrawList::~RenderDrawList()
+	{
+	}
+
+	void RenderDrawList::Reset(const Vector3& camera_position, const Vector3& camera_forward, Float near_plane, Float far_plane)
+	{
+		m_draw_packets.clear();
+		m_sort_entries.clear();
+		m_pipeline_slots.clear();
+		m_material_slots.clear();
+		m_mesh_slots.clear();
+
+		m_camera_position = camera_position;
+		m_camera_forward = camera_forward.Normalized();
+		m_near_plane = near_plane;
+		m_far_plane = far_plane;
+	}
+
+	Bool RenderDrawList::AddDrawPacket(RenderPassType pass, RenderPrimitiveID render_primitive_id, MaterialID material_id, const Pose& pose, UInt lod_index /*= 0*/, const DrawIndexRange& index_range /*= DrawIndexRange()*/)
+	{
+		Material* material = g_dolas_engine.m_material_manager->GetMaterialByID(material_id);
+		DOLAS_RETURN_FALSE_IF_NULL(material);
+		return AddDrawPacket(pass, render_primitive_id, material, pose, lod_index, index_range);
+	}
+
+	Bool RenderDrawList::AddDrawPacket(RenderPassType pass, RenderPrimitiveID render_primitive_id, Material* material, const Pose& pose, UInt lod_index /*= 0*/, const DrawIndexRange& index_range /*= DrawIndexRange()*/)
+	{
+		DOLAS_RETURN_FALSE_IF_NULL(material);
+		RenderPrimitive* render_primitive = g_dolas_engine.m_render_primitive_manager->GetRenderPrimitiveByID(render_primitive_id);
+		DOLAS_RETURN_FALSE_IF_NULL(render_primitive);
+
+		std::shared_ptr<VertexContext> vertex_context = material->GetVertexContext();
+		std::shared_ptr<PixelContext> pixel_context = material->GetPixelContext();
+		if (!vertex_context || !pixel_context)
+		{
+			return false;
+		}
+
+		// 同一个 pass 内，PSO 由 shader 组合 + 输入布局 + 拓扑决定（RT/光栅状态由 pass 统一设置）
+		std::size_t pipeline_identity = 0;
+		pipeline_identity = HashCombine(pipeline_identity, reinterpret_cast<std::size_t>(vertex_context->GetShaderBytecode().data));
+		pipeline_identity = HashCombine(pipeline_identity, reinterpret_cast<std::size_t>(pixel_context->GetShaderBytecode().data));
+		pipeline_identity = HashCombine(pipeline_identity, static_cast<std::size_t>(render_primitive->m_input_layout_type));
+		pipeline_identity = HashCombine(pipeline_identity, static_cast<std::size_t>(render_primitive->m_topology));
+
+		const UInt pipeline_slot = GetOrAssignSlot(m_pipeline_slots, pipeline_identity);
+		const UInt material_slot = GetOrAssignSlot(m_material_slots, reinterpret_cast<std::size_t>(material));
+		const UInt mesh_slot = GetOrAssignSlot(m_mesh_slots, static_cast<std::size_t>(render_primitive_id));
+
+		const Float view_depth = (pose.m_postion - m_camera_position).Dot(m_camera_forward);
+		const Bool front_to_back = pass != RenderPassType_Transparent;
+		const UInt depth = DrawSortKey::QuantizeDepth(view_depth, m_near_plane, m_far_plane, front_to_back);
+
+		DrawSortEntry entry;
+		// 深度预通道只有一个材质，严格由近及远以尽早填满深度缓冲
+		entry.m_key = pass == RenderPassType_DepthPrePass
+			? DrawSortKey::EncodeDepthFirst(pass, pipeline_slot, depth, mesh_slot)
+			: DrawSortKey::Encode(pass, pipeline_slot, material_slot, mesh_slot, depth);
+		entry.m_index = static_cast<UInt>(m_draw_packets.size());
+		m_sort_entries.push_back(entry);
+
+		DrawPacket draw_packet;
+		draw_packet.m_render_primitive_id = render_primitive_id;
+		draw_packet.m_material = material;
+		draw_packet.m_pose = pose;
+		draw_packet.m_lod_index = lod_index;
+		draw_packet.m_index_range = index_range;
+		m_draw_packets.push_back(draw_packet);
+		return true;
+	}
+
+	void RenderDrawList::Sort()
+	{
+		RadixSortDrawEntries(m_sort_entries, m_sort_scratch);
+	}
+
+	void RenderDrawList::Submit(DolasRHI* rhi) const
+	{
+		DOLAS_RETURN_IF_NULL(rhi);
+
+		for (const DrawSortEntry& entry : m_sort_entries)
+		{
+			const DrawPacket& draw_packet = m_draw_packets[entry.m_index];
+			rhi->UpdatePerObjectParameters(draw_packet.m_pose);
+
+			// 相邻 draw 的重复绑定由 DolasRHI 的冗余状态过滤负责跳过；同一材质的参数块地址不变
+			if (rhi->BindMaterial(draw_packet.m_material))
+			{
+				if (draw_packet.m_index_range.IsValid())
+				{
+					const DrawIndexRange& index_range = draw_packet.m_index_range;
+					rhi->DrawRenderPrimitiveIndexRange(draw_packet.m_render_primitive_id, index_range.m_index_buffer_id, index_range.m_start_index, index_range.m_index_count);
+				}
+				else
+				{
+					rhi->DrawRenderPrimitive(draw_packet.m_render_primitive_id, draw_packet.m_lod_index);
+				}
+			}
+		}
+	}
+
+	UInt RenderDrawList::GetOrAssignSlot(std::unordered_map<std::size_t, UInt>& slots, std::size_t identity)
+	{
+		auto iter = slots.find(identity);
+		if (iter != slots.end())
+		{
+			return iter->second;
+		}
+
+		const UInt slot = static_cast<UInt>(slots.size());
+		slots.emplace(identity, slot);
+		return slot;
+	}
+} // namespace Dolas
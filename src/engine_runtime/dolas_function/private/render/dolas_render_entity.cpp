@@ -12,6 +12,9 @@
 #include "render/dolas_shader.h"
 #include "manager/dolas_render_primitive_manager.h"
 #include "render/dolas_render_primitive.h"
+#include "render/dolas_render_scene.h"
+#include "dolas_mesh_lod.h"
+#include "dolas_texture_streaming.h"
 namespace Dolas
 {
     RenderEntity::RenderEntity()
@@ -21,7 +24,10 @@ namespace Dolas
 
     RenderEntity::~RenderEntity()
     {
-
+        if (m_owner_scene)
+        {
+            m_owner_scene->RemoveRenderEntity(m_file_id);
+        }
     }
 
     bool RenderEntity::Clear()
@@ -38,16 +44,34 @@ namespace Dolas
             Material* material = g_dolas_engine.m_material_manager->GetMaterialByID(component.m_material_id);
             if (!material) continue;
 
-            std::shared_ptr<VertexContext> vertex_context = material->GetVertexContext();
-            if (!vertex_context) continue;
-
-            std::shared_ptr<PixelContext> pixel_context = material->GetPixelContext();
-            if (!pixel_context) continue;
+            // 绑定 Shader 与材质参数并绘制对应的 RenderPrimitive
+            if (rhi->BindMaterial(material))
+            {
+                g_dolas_engine.m_rhi->DrawRenderPrimitive(component.m_render_primitive_id, component.m_lod_index);
+            }
+        }
+    }
 
-            // 绑定 Shader 并绘制对应的 RenderPrimitive
-            if (rhi->BindVertexContext(vertex_context) && rhi->BindPixelContext(pixel_context))
+    void RenderEntity::CollectDrawPackets(RenderDrawList& draw_list, RenderPassType pass, BufferID cluster_index_buffer_id /*= BUFFER_ID_EMPTY*/, Material* override_material /*= nullptr*/) const
+    {
+        for (const auto& component : m_components)
+        {
+            DrawIndexRange index_range;
+            if (component.m_use_cluster_indices)
+            {
+                // 所有 meshlet 都被剔除时整个 component 不需要绘制
+                if (component.m_cluster_index_count == 0 || cluster_index_buffer_id == BUFFER_ID_EMPTY) continue;
+                index_range.m_index_buffer_id = cluster_index_buffer_id;
+                index_range.m_start_index = component.m_cluster_index_offset;
+                index_range.m_index_count = component.m_cluster_index_count;
+            }
+            if (override_material)
             {
-                g_dolas_engine.m_rhi->DrawRenderPrimitive(component.m_render_primitive_id);
+                draw_list.AddDrawPacket(pass, component.m_render_primitive_id, override_material, m_pose, component.m_lod_index, index_range);
+            }
+            else
+            {
+                draw_list.AddDrawPacket(pass, component.m_render_primitive_id, component.m_material_id, m_pose, component.m_lod_index, index_range);
             }
         }
     }
@@ -55,5 +79,121 @@ namespace Dolas
     void RenderEntity::AddComponent(RenderPrimitiveID mesh_id, MaterialID material_id)
     {
         m_components.push_back({ mesh_id, material_id });
+
+        RenderPrimitive* render_primitive = g_dolas_engine.m_render_primitive_manager->GetRenderPrimitiveByID(mesh_id);
+        if (render_primitive)
+        {
+            m_local_bounds.Merge(render_primitive->m_local_bounds);
+        }
+        UpdateWorldBounds();
+    }
+
+    void RenderEntity::UpdateMeshLOD(const Vector3& camera_position, Float projection_scale, Float hysteresis)
+    {
+        const Matrix4x4 world = m_pose.ToMatrix();
+        for (auto& component : m_components)
+        {
+            RenderPrimitive* render_primitive = g_dolas_engine.m_render_primitive_manager->GetRenderPrimitiveByID(component.m_render_primitive_id);
+            if (!render_primitive || render_primitive->GetLODCount() <= 1 || !render_primitive->m_local_bounding_sphere.IsValid())
+            {
+                component.m_lod_index = 0;
+                continue;
+            }
+
+            const BoundingSphere world_sphere = render_primitive->m_local_bounding_sphere.Transform(world);
+            const Float screen_size = ComputeScreenSize(world_sphere, camera_position, projection_scale);
+            component.m_lod_index = SelectMeshLOD(
+                screen_size,
+                render_primitive->m_lod_screen_sizes.data(),
+                render_primitive->GetLODCount(),
+                component.m_lod_index,
+                hysteresis);
+        }
+    }
+
+    void RenderEntity::ResetMeshLOD()
+    {
+        for (auto& component : m_components)
+        {
+            component.m_lod_index = 0;
+        }
+    }
+
+    void RenderEntity::RecordTextureUsage(const Vector3& camera_position, Float projection_scale, Float viewport_height, TextureStreamingFeedback& feedback) const
+    {
+        const Matrix4x4 world = m_pose.ToMatrix();
+        for (const auto& component : m_components)
+        {
+            RenderPrimitive* render_primitive = g_dolas_engine.m_render_primitive_manager->GetRenderPrimitiveByID(component.m_render_primitive_id);
+            Material* material = g_dolas_engine.m_material_manager->GetMaterialByID(component.m_material_id);
+            if (!render_primitive || !material || material->GetTextureIDs().empty() || !render_primitive->m_local_bounding_sphere.IsValid())
+            {
+                continue;
+            }
+
+            const BoundingSphere world_sphere = render_primitive->m_local_bounding_sphere.Transform(world);
+            const Float distance = (world_sphere.center - camera_position).Length();
+            const Float screen_pixels_per_uv = EstimateScreenPixelsPerUV(world_sphere.radius, distance, projection_scale, viewport_height);
+            for (TextureID texture_id : material->GetTextureIDs())
+            {
+                feedback.Record(texture_id, screen_pixels_per_uv);
+            }
+        }
+    }
+
+    void RenderEntity::UpdateClusterCulling(const Frustum& world_frustum, const Vector3& camera_position, std::vector<UInt>& cluster_indices, MeshletCullingResult& culling_result)
+    {
+        const Matrix4x4 world = m_pose.ToMatrix();
+        const Vector4 model_space_camera = world.GetInverse() * Vector4(camera_position, 1.0f);
+        // 镜像变换翻转了绕序，法线锥不再可靠，只做视锥剔除
+        const Bool enable_backface = m_pose.m_scale.x * m_pose.m_scale.y * m_pose.m_scale.z > 0.0f;
+
+        for (auto& component : m_components)
+        {
+            component.m_use_cluster_indices = false;
+            if (component.m_lod_index != 0) continue;
+
+            RenderPrimitive* render_primitive = g_dolas_engine.m_render_primitive_manager->GetRenderPrimitiveByID(component.m_render_primitive_id);
+            if (!render_primitive || render_primitive->m_meshlets.IsEmpty()) continue;
+
+            const MeshletCullingResult result = CullMeshlets(
+                render_primitive->m_meshlets,
+                world,
+                world_frustum,
+                Vector3(model_space_camera.x, model_space_camera.y, model_space_camera.z),
+                enable_backface,
+                cluster_indices);
+            component.m_use_cluster_indices = true;
+            component.m_cluster_index_offset = static_cast<UInt>(cluster_indices.size()) - result.index_count;
+            component.m_cluster_index_count = result.index_count;
+
+            culling_result.visible_meshlet_count += result.visible_meshlet_count;
+            culling_result.frustum_culled_count += result.frustum_culled_count;
+            culling_result.backface_culled_count += result.backface_culled_count;
+            culling_result.index_count += result.index_count;
+        }
+    }
+
+    void RenderEntity::ResetClusterCulling()
+    {
+        for (auto& component : m_components)
+        {
+            component.m_use_cluster_indices = false;
+        }
+    }
+
+    void RenderEntity::SetPose(const Pose& pose)
+    {
+        m_pose = pose;
+        UpdateWorldBounds();
+    }
+
+    void RenderEntity::UpdateWorldBounds()
+    {
+        m_world_bounds = m_local_bounds.Transform(m_pose.ToMatrix());
+        if (m_owner_scene)
+        {
+            m_owner_scene->RefitRenderEntity(m_file_id);
+        }
     }
 }
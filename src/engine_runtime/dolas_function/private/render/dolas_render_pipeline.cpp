@@ -1,6 +1,9 @@
 #include <string>
 #include <iostream>
 #include <cstddef>  // for offsetof
+#include <chrono>
+#include <algorithm>
+#include <cmath>
 
 #include "dolas_paths.h"
 #include "dolas_base.h"
@@ -28,8 +31,124 @@
 #include "manager/dolas_tick_manager.h"
 #include "manager/dolas_imgui_manager.h"
 #include "manager/dolas_debug_draw_manager.h"
+#include "manager/dolas_task_manager.h"
+#include "manager/dolas_buffer_manager.h"
+#include "render/dolas_buffer.h"
+#include "dolas_mesh_lod.h"
 namespace Dolas
 {
+    namespace
+    {
+        // 每个剔除任务处理的最少包围盒数量，entity 较少时直接在渲染线程上完成，避免任务调度开销
+        constexpr UInt kCullingEntitiesPerTask = 4096;
+        // 遮挡剔除每个任务测试的最少包围盒数量（单个测试比视锥测试贵得多）
+        constexpr UInt kOcclusionEntitiesPerTask = 512;
+
+        // 软件遮挡缓冲的分辨率与遮挡体预算
+        constexpr UInt kOcclusionBufferWidth = 256;
+        constexpr UInt kOcclusionBufferHeight = 128;
+        constexpr UInt kMaxOccluderCount = 32;
+        constexpr UInt kMaxOccluderTriangleCount = 65536;
+        // 包围球半径 / 到相机的距离，超过该值的可见 entity 才作为遮挡体
+        constexpr Float kMinOccluderScreenSize = 0.1f;
+        // LOD 切换阈值两侧的滞后比例，避免相机微小移动时来回切换
+        constexpr Float kMeshLODHysteresis = 0.1f;
+        // cluster 剔除压缩索引缓冲的最小容量（索引个数）
+        constexpr UInt kMinClusterIndexCapacity = 64 * 1024;
+        // clustered lighting 每个分配任务处理的最少光源数量
+        constexpr UInt kLightClusteringLightsPerTask = 256;
+        // 光源数组与 cluster 光源索引表的最小容量（元素个数）
+        constexpr UInt kMinLocalLightCapacity = 256;
+        constexpr UInt kMinLightClusterIndexCapacity = 16 * 1024;
+
+        UInt GetParallelChunkCount(UInt item_count, UInt min_items_per_task)
+        {
+            TaskManager* task_manager = g_dolas_engine.m_task_manager;
+            if (!task_manager || item_count <= min_items_per_task)
+            {
+                return item_count > 0 ? 1 : 0;
+            }
+            return std::min<UInt>(
+                (item_count + min_items_per_task - 1) / min_items_per_task,
+                std::max<UInt>(1, static_cast<UInt>(task_manager->GetWorkerCount())));
+        }
+
+        // 动态结构化缓冲区：容量不足时按 2 倍重建。RHI 每帧结束都会等待 GPU，旧缓冲此时已不再被引用，可以直接释放
+        Bool UploadDynamicStructuredBuffer(BufferID buffer_name_id, BufferID& in_out_buffer_id, UInt& in_out_capacity, UInt min_capacity,
+            const void* data, UInt element_count, UInt element_size)
+        {
+            BufferManager* buffer_manager = g_dolas_engine.m_buffer_manager;
+            if (!buffer_manager)
+            {
+                return false;
+            }
+
+            if (in_out_buffer_id == BUFFER_ID_EMPTY || element_count > in_out_capacity)
+            {
+                if (in_out_buffer_id != BUFFER_ID_EMPTY)
+                {
+                    buffer_manager->DestroyBuffer(in_out_buffer_id);
+                }
+                const UInt capacity = std::max(min_capacity, std::max(element_count, in_out_capacity * 2));
+                in_out_buffer_id = buffer_manager->CreateStructuredBuffer(buffer_name_id, capacity, element_size, nullptr, BufferUsage::DYNAMIC);
+                in_out_capacity = in_out_buffer_id == BUFFER_ID_EMPTY ? 0 : capacity;
+                if (in_out_buffer_id == BUFFER_ID_EMPTY)
+                {
+                    LOG_ERROR("UploadDynamicStructuredBuffer: Failed to create structured buffer {0} ({1} elements)", buffer_name_id, capacity);
+                    return false;
+                }
+            }
+
+            if (element_count == 0)
+            {
+                return true;
+            }
+            Buffer* buffer = buffer_manager->GetBufferByID(in_out_buffer_id);
+            return buffer && buffer->UpdateData(data, element_count * element_size, 0);
+        }
+
+        // 把 [0, item_count) 平均切成 chunk_count 块，function(chunk_index, begin, end) 分发到线程池，
+        // 最后一块在当前线程执行。各块必须只写互不重叠的数据
+        template<typename Function>
+        void RunParallelChunks(UInt chunk_count, UInt item_count, Function&& function)
+        {
+            if (chunk_count == 0)
+            {
+                return;
+            }
+
+            const UInt chunk_size = (item_count + chunk_count - 1) / chunk_count;
+            auto run_chunk = [&function, chunk_size, item_count](UInt chunk_index)
+            {
+                const UInt begin = std::min(chunk_index * chunk_size, item_count);
+                const UInt end = std::min(begin + chunk_size, item_count);
+                function(chunk_index, begin, end);
+            };
+
+            TaskManager* task_manager = g_dolas_engine.m_task_manager;
+            std::vector<TaskGUID> task_guids;
+            task_guids.reserve(chunk_count);
+            for (UInt chunk_index = 0; chunk_index + 1 < chunk_count; ++chunk_index)
+            {
+                TaskGUID task_guid = task_manager ? task_manager->EnqueueTask(run_chunk, chunk_index) : 0;
+                if (task_guid != 0)
+                {
+                    task_guids.push_back(task_guid);
+                }
+                else
+                {
+                    run_chunk(chunk_index);
+                }
+            }
+            run_chunk(chunk_count - 1);
+
+            for (TaskGUID task_guid : task_guids)
+            {
+                task_manager->WaitForTask(task_guid);
+            }
+        }
+    }
+
     RenderPipeline::RenderPipeline() : m_viewport(0.0f, 0.0f, DEFAULT_CLIENT_WIDTH, DEFAULT_CLIENT_HEIGHT, 0.0f, 1.0f)
     {
 
@@ -42,6 +161,7 @@ namespace Dolas
 
     bool RenderPipeline::Initialize()
     {
+        m_occlusion_buffer.Initialize(kOcclusionBufferWidth, kOcclusionBufferHeight);
         g_dolas_engine.m_rhi->VSSetConstantBuffers();
         g_dolas_engine.m_rhi->PSSetConstantBuffers();
         return true;
@@ -97,20 +217,223 @@ namespace Dolas
         rhi->UpdatePerFrameParameters();
 		rhi->UpdatePerViewParameters(render_camera);
 
-        ClearPass(rhi, render_view);
-        GBufferPass(rhi, render_view);
-        DeferredShadingPass(rhi, render_view);
-        ForwardShadingPass(rhi);
-        SkyboxPass(rhi, render_view);
-        PostProcessPass(rhi);
-
+        // 调试物体要在建图之前加入，DebugPass 是否执行取决于本帧是否有调试物体
         if (m_display_world_coordinate)
         {
             DisplayWorldCoordinate();
         }
 
-        DebugPass(rhi, render_view);
+        m_pass_statistics = RenderPassStatistics();
+        m_pass_gpu_query_indices.clear();
+        m_pass_statistics.viewport_pixel_count = static_cast<UInt>(std::max(m_viewport.m_width, 0.0f) * std::max(m_viewport.m_height, 0.0f));
+
+        // 可见集合决定深度预通道是否有内容可画，所以要在建图之前收集
+        CollectGBufferDraws(render_view);
+        const Bool declare_depth_prepass = m_pass_statistics.depth_prepass_enabled;
+
+        ClearPass(rhi, render_view);
+        if (BuildRenderGraph(rhi, render_view))
+        {
+            ExecuteRenderGraph(rhi);
+        }
+        else
+        {
+            // 建图失败时按固定顺序执行，资源状态由绑定时的 TransitionTexture 维护
+            if (declare_depth_prepass)
+            {
+                ExecuteProfiledPass(rhi, "DepthPrePass", [this, rhi, render_view]() { DepthPrePass(rhi, render_view); });
+            }
+            ExecuteProfiledPass(rhi, "GBuffer", [this, rhi, render_view]() { GBufferPass(rhi, render_view); });
+            ExecuteProfiledPass(rhi, "ShadowDepth", [this, rhi, render_view]() { ShadowDepthPass(rhi, render_view); });
+            ExecuteProfiledPass(rhi, "DeferredShading", [this, rhi, render_view]() { DeferredShadingPass(rhi, render_view); });
+            ExecuteProfiledPass(rhi, "ForwardShading", [this, rhi]() { ForwardShadingPass(rhi); });
+            ExecuteProfiledPass(rhi, "Skybox", [this, rhi, render_view]() { SkyboxPass(rhi, render_view); });
+            ExecuteProfiledPass(rhi, "PostProcess", [this, rhi]() { PostProcessPass(rhi); });
+            ExecuteProfiledPass(rhi, "Debug", [this, rhi, render_view]() { DebugPass(rhi, render_view); });
+        }
+        // Present 结束本帧的 command list，必须在图中所有屏障之后执行
         PresentPass(rhi, render_view);
+        // Present 内部等待了 GPU，本帧的查询结果已经读回
+        MergeGpuPassStatistics(rhi);
+    }
+
+    void RenderPipeline::ExecuteProfiledPass(DolasRHI* rhi, const std::string& name, const std::function<void()>& execute)
+    {
+        RenderPassTiming timing;
+        timing.name = name;
+        const UInt query_index = rhi->BeginGpuPassQuery(name);
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        execute();
+        timing.cpu_milliseconds = std::chrono::duration<Double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+        rhi->EndGpuPassQuery(query_index);
+
+        m_pass_statistics.passes.push_back(std::move(timing));
+        m_pass_gpu_query_indices.push_back(query_index);
+    }
+
+    void RenderPipeline::MergeGpuPassStatistics(DolasRHI* rhi)
+    {
+        const std::vector<RHIGpuPassStatistics>& gpu_statistics = rhi->GetLastFrameGpuPassStatistics();
+        for (size_t pass_index = 0; pass_index < m_pass_statistics.passes.size(); ++pass_index)
+        {
+            const UInt query_index = m_pass_gpu_query_indices[pass_index];
+            if (query_index == kInvalidGpuPassQuery || query_index >= gpu_statistics.size()) continue;
+
+            RenderPassTiming& timing = m_pass_statistics.passes[pass_index];
+            const RHIGpuPassStatistics& statistics = gpu_statistics[query_index];
+            timing.has_gpu_statistics = true;
+            timing.gpu_milliseconds = statistics.gpu_milliseconds;
+            timing.rasterized_primitive_count = statistics.rasterized_primitives;
+            timing.pixel_shader_invocation_count = statistics.pixel_shader_invocations;
+            if (timing.name == "GBuffer" && m_pass_statistics.viewport_pixel_count > 0)
+            {
+                m_pass_statistics.gbuffer_shading_rate = static_cast<Double>(statistics.pixel_shader_invocations) / static_cast<Double>(m_pass_statistics.viewport_pixel_count);
+            }
+        }
+    }
+
+    Bool RenderPipeline::BuildRenderGraph(DolasRHI* rhi, RenderView* render_view)
+    {
+        const auto build_start_time = std::chrono::high_resolution_clock::now();
+        m_render_graph.Reset();
+        m_render_graph_pass_functions.clear();
+        m_render_graph_textures.clear();
+        m_render_graph_statistics = RenderGraphStatistics();
+
+        RenderResource* render_resource = TryGetRenderResource(render_view);
+        DOLAS_RETURN_FALSE_IF_NULL(render_resource);
+
+        const RenderGraphResourceHandle gbuffer_textures[] = {
+            CreateRenderGraphTexture(render_resource, render_resource->m_gbuffer_a_id),
+            CreateRenderGraphTexture(render_resource, render_resource->m_gbuffer_b_id),
+        };
+        const RenderGraphResourceHandle depth_stencil = CreateRenderGraphTexture(render_resource, render_resource->m_depth_stencil_id);
+        const RenderGraphResourceHandle scene_result = CreateRenderGraphTexture(render_resource, render_resource->m_scene_result_id);
+        const RenderGraphResourceHandle shadow_map = CreateRenderGraphTexture(render_resource, render_resource->m_shadow_map_id);
+
+        // 每个瞬态纹理由第一个写入它的 pass 负责清除（别名之后内容未定义）：开启深度预通道时深度由它清除
+        if (m_pass_statistics.depth_prepass_enabled)
+        {
+            const RenderGraphPassHandle depth_prepass = AddRenderGraphPass("DepthPrePass", false, [this, rhi, render_view]() { DepthPrePass(rhi, render_view); });
+            m_render_graph.Write(depth_prepass, depth_stencil, RenderGraphAccess_DepthWrite);
+        }
+
+        const RenderGraphPassHandle gbuffer_pass = AddRenderGraphPass("GBuffer", false, [this, rhi, render_view]() { GBufferPass(rhi, render_view); });
+        for (RenderGraphResourceHandle gbuffer_texture : gbuffer_textures)
+        {
+            m_render_graph.Write(gbuffer_pass, gbuffer_texture, RenderGraphAccess_RenderTarget);
+        }
+        m_render_graph.Write(gbuffer_pass, depth_stencil, RenderGraphAccess_DepthWrite);
+
+        // 投射体剔除复用 CollectGBufferDraws 收集的世界包围盒（建图之前已完成）
+        const RenderGraphPassHandle shadow_depth_pass = AddRenderGraphPass("ShadowDepth", false, [this, rhi, render_view]() { ShadowDepthPass(rhi, render_view); });
+        m_render_graph.Write(shadow_depth_pass, shadow_map, RenderGraphAccess_DepthWrite);
+
+        const RenderGraphPassHandle deferred_shading_pass = AddRenderGraphPass("DeferredShading", false, [this, rhi, render_view]() { DeferredShadingPass(rhi, render_view); });
+        for (RenderGraphResourceHandle gbuffer_texture : gbuffer_textures)
+        {
+            m_render_graph.Read(deferred_shading_pass, gbuffer_texture, RenderGraphAccess_PixelShaderResource);
+        }
+        // 世界坐标由深度重建
+        m_render_graph.Read(deferred_shading_pass, depth_stencil, RenderGraphAccess_PixelShaderResource);
+        m_render_graph.Read(deferred_shading_pass, shadow_map, RenderGraphAccess_PixelShaderResource);
+        m_render_graph.Write(deferred_shading_pass, scene_result, RenderGraphAccess_RenderTarget);
+
+        // 前向与后处理 pass 尚未实现，不声明任何资源，由图编译剔除
+        AddRenderGraphPass("ForwardShading", false, [this, rhi]() { ForwardShadingPass(rhi); });
+
+        // 天空盒只做模板测试，但 DSV 总是以 DEPTH_WRITE 状态绑定
+        const RenderGraphPassHandle skybox_pass = AddRenderGraphPass("Skybox", false, [this, rhi, render_view]() { SkyboxPass(rhi, render_view); });
+        m_render_graph.Write(skybox_pass, scene_result, RenderGraphAccess_RenderTarget);
+        m_render_graph.Write(skybox_pass, depth_stencil, RenderGraphAccess_DepthWrite);
+
+        AddRenderGraphPass("PostProcess", false, [this, rhi]() { PostProcessPass(rhi); });
+
+        const RenderGraphPassHandle debug_pass = AddRenderGraphPass("Debug", false, [this, rhi, render_view]() { DebugPass(rhi, render_view); });
+        if (!g_dolas_engine.m_debug_draw_manager->GetDebugObjects().empty())
+        {
+            m_render_graph.Write(debug_pass, scene_result, RenderGraphAccess_RenderTarget);
+            m_render_graph.Write(debug_pass, depth_stencil, RenderGraphAccess_DepthWrite);
+        }
+
+        // 拷贝到 back buffer 在图执行完之后由 PresentPass 完成，这里只声明读取
+        const RenderGraphPassHandle present_pass = AddRenderGraphPass("Present", true, nullptr);
+        m_render_graph.Read(present_pass, scene_result, RenderGraphAccess_CopySource);
+
+        if (!m_render_graph.Compile(m_render_graph_result))
+        {
+            LOG_ERROR("RenderPipeline::BuildRenderGraph: invalid render graph declaration");
+            return false;
+        }
+
+        PlaceTransientTextures(render_view, render_resource);
+
+        m_render_graph_statistics.pass_count = m_render_graph.GetPassCount();
+        m_render_graph_statistics.culled_pass_count = m_render_graph_result.culled_pass_count;
+        m_render_graph_statistics.transition_barrier_count = m_render_graph_result.transition_barrier_count;
+        m_render_graph_statistics.aliasing_barrier_count = m_render_graph_result.aliasing_barrier_count;
+        m_render_graph_statistics.barrier_batch_count = m_render_graph_result.barrier_batch_count;
+        m_render_graph_statistics.transient_heap_size = m_render_graph_result.transient_heap_size;
+        m_render_graph_statistics.unaliased_heap_size = m_render_graph_result.unaliased_heap_size;
+        m_render_graph_statistics.transient_heap_placed = render_resource->IsTransientHeapPlaced();
+        m_render_graph_statistics.build_milliseconds = std::chrono::duration<Double, std::milli>(std::chrono::high_resolution_clock::now() - build_start_time).count();
+        return true;
+    }
+
+    void RenderPipeline::ExecuteRenderGraph(DolasRHI* rhi)
+    {
+        for (const RenderGraphCompiledPass& compiled_pass : m_render_graph_result.passes)
+        {
+            rhi->ExecuteRenderGraphBarriers(compiled_pass.barriers, m_render_graph_textures);
+            const std::function<void()>& execute = m_render_graph_pass_functions[compiled_pass.pass];
+            if (execute)
+            {
+                ExecuteProfiledPass(rhi, m_render_graph.GetPassName(compiled_pass.pass), execute);
+            }
+        }
+        rhi->ExecuteRenderGraphBarriers(m_render_graph_result.final_barriers, m_render_graph_textures);
+    }
+
+    RenderGraphResourceHandle RenderPipeline::CreateRenderGraphTexture(const RenderResource* render_resource, TextureID texture_id)
+    {
+        RenderGraphTextureDesc desc;
+        const RenderResourceTransientTexture* transient_texture = render_resource->GetTransientTexture(texture_id);
+        if (transient_texture)
+        {
+            desc.size = transient_texture->m_allocation_size;
+            desc.alignment = transient_texture->m_allocation_alignment;
+        }
+        const RenderGraphResourceHandle handle = m_render_graph.CreateTexture(ID_TO_STRING(texture_id), desc);
+        m_render_graph_textures.push_back(texture_id);
+        return handle;
+    }
+
+    RenderGraphPassHandle RenderPipeline::AddRenderGraphPass(const std::string& name, Bool has_side_effects, std::function<void()> execute)
+    {
+        const RenderGraphPassHandle handle = m_render_graph.AddPass(name, has_side_effects);
+        m_render_graph_pass_functions.push_back(std::move(execute));
+        return handle;
+    }
+
+    void RenderPipeline::PlaceTransientTextures(RenderView* render_view, RenderResource* render_resource)
+    {
+        RenderResourceManager* render_resource_manager = g_dolas_engine.m_render_resource_manager;
+        DOLAS_RETURN_IF_NULL(render_resource_manager);
+
+        const std::vector<RenderResourceTransientTexture>& transient_textures = render_resource->GetTransientTextures();
+        std::vector<ULongLong> heap_offsets(transient_textures.size(), kRenderResourceNotPlaced);
+        for (std::size_t i = 0; i < transient_textures.size(); ++i)
+        {
+            for (RenderGraphResourceHandle resource = 0; resource < m_render_graph_textures.size(); ++resource)
+            {
+                const RenderGraphResourceAllocation& allocation = m_render_graph_result.resources[resource];
+                if (m_render_graph_textures[resource] == transient_textures[i].m_desc.texture_handle && allocation.used && allocation.size > 0)
+                {
+                    heap_offsets[i] = allocation.heap_offset;
+                }
+            }
+        }
+        render_resource_manager->PlaceTransientTextures(render_view->GetRenderResourceID(), heap_offsets, m_render_graph_result.transient_heap_size);
     }
 
     void RenderPipeline::SetRenderViewID(RenderViewID id)
@@ -126,50 +449,178 @@ namespace Dolas
     void RenderPipeline::ClearPass(DolasRHI* rhi, RenderView* render_view)
     {
         UserAnnotationScope scope(rhi, L"ClearPass");
-		RenderResource* render_resource = TryGetRenderResource(render_view);
-		DOLAS_RETURN_IF_NULL(render_resource);
-
 		const FLOAT black_clear_color[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
 
+        // 场景纹理由渲染图中第一个写入它们的 pass 清除，这里只清 back buffer
         rhi->BeginEvent(L"ClearBackRenderTarget");
         rhi->ClearRenderTargetView(rhi->GetBackBufferRTV(), black_clear_color);
         rhi->EndEvent();
+    }
 
-        rhi->BeginEvent(L"ClearGBufferTextures");
-        auto gbuffer_a_rtv = rhi->CreateRenderTargetView(render_resource->m_gbuffer_a_id);
-        auto gbuffer_b_rtv = rhi->CreateRenderTargetView(render_resource->m_gbuffer_b_id);
-        auto gbuffer_c_rtv = rhi->CreateRenderTargetView(render_resource->m_gbuffer_c_id);
-        auto gbuffer_d_rtv = rhi->CreateRenderTargetView(render_resource->m_gbuffer_d_id);
-        rhi->ClearRenderTargetView(gbuffer_a_rtv, black_clear_color);
-        rhi->ClearRenderTargetView(gbuffer_b_rtv, black_clear_color);
-        rhi->ClearRenderTargetView(gbuffer_c_rtv, black_clear_color);
-        rhi->ClearRenderTargetView(gbuffer_d_rtv, black_clear_color);
-        rhi->EndEvent();
-        
-        rhi->BeginEvent(L"ClearSceneDepthTexture");
-        std::shared_ptr<DepthStencilView> scene_dsv = rhi->CreateDepthStencilView(render_resource->m_depth_stencil_id);
-		DepthClearParams depth_clear_params;
+    void RenderPipeline::CollectGBufferDraws(RenderView* render_view)
+    {
+        m_gbuffer_draws_ready = false;
+        m_depth_prepass_ready = false;
+
+        RenderScene* render_scene = TryGetRenderScene(render_view);
+        DOLAS_RETURN_IF_NULL(render_scene);
+        RenderCamera* render_camera = TryGetRenderCamera(render_view);
+        DOLAS_RETURN_IF_NULL(render_camera);
+
+        // 收集 draw packet -> 按排序键排序，提交在各 pass 中完成，使共享状态的 draw 相邻
+        m_gbuffer_draw_list.Reset(
+            render_camera->GetPosition(),
+            render_camera->GetForward(),
+            render_camera->GetNearPlane(),
+            render_camera->GetFarPlane());
+        m_depth_prepass_draw_list.Reset(
+            render_camera->GetPosition(),
+            render_camera->GetForward(),
+            render_camera->GetNearPlane(),
+            render_camera->GetFarPlane());
+
+        // 深度预通道与 GBuffer 画同一组可见网格（包括 cluster 剔除后的索引区间），只是换成只写深度的材质
+        Material* depth_only_material = nullptr;
+        if (render_view->IsDepthPrePassEnabled())
+        {
+            depth_only_material = g_dolas_engine.m_material_manager->GetGlobalMaterial(GlobalMaterialType::DepthOnly);
+            if (!depth_only_material)
+            {
+                LOG_WARN("RenderPipeline::CollectGBufferDraws: depth only material is missing, depth pre-pass disabled");
+            }
+        }
+
+        CullRenderEntities(render_scene, render_camera);
+
+        const Vector3 camera_position = render_camera->GetPosition();
+        const Float projection_scale = std::abs(render_camera->GetProjectionMatrix().data[1][1]);
+        m_mesh_lod_statistics = RenderMeshLODStatistics();
+        m_cluster_culling_statistics = RenderClusterCullingStatistics();
+        m_cluster_indices.clear();
+        const Frustum frustum = Frustum::FromViewProjection(render_camera->GetProjectionMatrix() * render_camera->GetViewMatrix());
+        MeshletCullingResult cluster_culling_result;
+        Double cluster_culling_milliseconds = 0.0;
+
+        std::vector<RenderEntity*> visible_entities;
+        // 可见 entity 的材质纹理按屏幕上的 UV 密度决定需要常驻的 mip
+        TextureStreamingFeedback* texture_streaming_feedback = g_dolas_engine.m_texture_manager ? &g_dolas_engine.m_texture_manager->GetStreamingFeedback() : nullptr;
+
+        const std::vector<RenderEntityID>& render_entities = render_scene->GetRenderEntities();
+        for (size_t entity_index = 0; entity_index < render_entities.size(); ++entity_index)
+        {
+            if (m_entity_visibility[entity_index] == 0) continue;
+
+            RenderEntity* render_entity = g_dolas_engine.m_render_entity_manager->GetRenderEntityByID(render_entities[entity_index]);
+			DOLAS_CONTINUE_IF_NULL(render_entity);
+			if (m_enable_mesh_lod)
+			{
+				render_entity->UpdateMeshLOD(camera_position, projection_scale, kMeshLODHysteresis);
+			}
+			else
+			{
+				render_entity->ResetMeshLOD();
+			}
+			if (texture_streaming_feedback)
+			{
+				render_entity->RecordTextureUsage(camera_position, projection_scale, m_viewport.m_height, *texture_streaming_feedback);
+			}
+
+			for (const RenderComponent& component : render_entity->GetComponents())
+			{
+				RenderPrimitive* render_primitive = g_dolas_engine.m_render_primitive_manager->GetRenderPrimitiveByID(component.m_render_primitive_id);
+				DOLAS_CONTINUE_IF_NULL(render_primitive);
+				m_mesh_lod_statistics.rendered_triangle_count += render_primitive->GetTriangleCount(component.m_lod_index);
+				m_mesh_lod_statistics.full_detail_triangle_count += render_primitive->GetTriangleCount();
+				m_mesh_lod_statistics.reduced_component_count += component.m_lod_index > 0 ? 1 : 0;
+			}
+
+			if (m_enable_cluster_culling)
+			{
+				const auto cluster_start_time = std::chrono::high_resolution_clock::now();
+				render_entity->UpdateClusterCulling(frustum, camera_position, m_cluster_indices, cluster_culling_result);
+				cluster_culling_milliseconds += std::chrono::duration<Double, std::milli>(std::chrono::high_resolution_clock::now() - cluster_start_time).count();
+
+				for (const RenderComponent& component : render_entity->GetComponents())
+				{
+					if (!component.m_use_cluster_indices) continue;
+					RenderPrimitive* render_primitive = g_dolas_engine.m_render_primitive_manager->GetRenderPrimitiveByID(component.m_render_primitive_id);
+					DOLAS_CONTINUE_IF_NULL(render_primitive);
+					m_cluster_culling_statistics.meshlet_count += static_cast<UInt>(render_primitive->m_meshlets.meshlets.size());
+					m_cluster_culling_statistics.source_triangle_count += render_primitive->GetTriangleCount();
+				}
+			}
+			else
+			{
+				render_entity->ResetClusterCulling();
+			}
+			visible_entities.push_back(render_entity);
+        }
+
+        // 所有 entity 的压缩索引拼接后一次上传，各 component 通过区间引用
+        const BufferID cluster_index_buffer_id = m_cluster_indices.empty() ? BUFFER_ID_EMPTY : UploadClusterIndices();
+        const Bool cluster_upload_failed = !m_cluster_indices.empty() && cluster_index_buffer_id == BUFFER_ID_EMPTY;
+        for (RenderEntity* render_entity : visible_entities)
+        {
+            // 上传失败时退回到绘制完整网格
+            if (cluster_upload_failed)
+            {
+                render_entity->ResetClusterCulling();
+            }
+            render_entity->CollectDrawPackets(m_gbuffer_draw_list, RenderPassType_GBuffer, cluster_index_buffer_id);
+            if (depth_only_material)
+            {
+                render_entity->CollectDrawPackets(m_depth_prepass_draw_list, RenderPassType_DepthPrePass, cluster_index_buffer_id, depth_only_material);
+            }
+        }
+
+        m_cluster_culling_statistics.visible_meshlet_count = cluster_culling_result.visible_meshlet_count;
+        m_cluster_culling_statistics.frustum_culled_meshlet_count = cluster_culling_result.frustum_culled_count;
+        m_cluster_culling_statistics.backface_culled_meshlet_count = cluster_culling_result.backface_culled_count;
+        m_cluster_culling_statistics.submitted_triangle_count = cluster_culling_result.index_count / 3;
+        m_cluster_culling_statistics.culling_milliseconds = cluster_culling_milliseconds;
+
+        m_gbuffer_draw_list.Sort();
+        m_depth_prepass_draw_list.Sort();
+        m_gbuffer_draws_ready = true;
+        m_pass_statistics.depth_prepass_enabled = depth_only_material != nullptr;
+    }
+
+    void RenderPipeline::DepthPrePass(DolasRHI* rhi, RenderView* render_view)
+    {
+        UserAnnotationScope scope(rhi, L"DepthPrePass");
+
+        RenderResource* render_resource = TryGetRenderResource(render_view);
+        DOLAS_RETURN_IF_NULL(render_resource);
+
+        // 深度由这个 pass 第一次写入：清除深度与模板（天空盒依赖清除后的 SKY 模板值）
+        auto dsv = g_dolas_engine.m_rhi->CreateDepthStencilView(render_resource->m_depth_stencil_id);
+        rhi->BeginEvent(L"ClearDepthStencil");
+        DepthClearParams depth_clear_params;
         depth_clear_params.enable = true;
         depth_clear_params.clear_value = 1.0f;
-		StencilClearParams stencil_clear_params;
-		stencil_clear_params.enable = true;
-		stencil_clear_params.clear_value = StencilMaskEnum_SKY;
-        rhi->ClearDepthStencilView(scene_dsv, depth_clear_params, stencil_clear_params);
+        StencilClearParams stencil_clear_params;
+        stencil_clear_params.enable = true;
+        stencil_clear_params.clear_value = StencilMaskEnum_SKY;
+        rhi->ClearDepthStencilView(dsv, depth_clear_params, stencil_clear_params);
         rhi->EndEvent();
 
-        rhi->BeginEvent(L"ClearSceneResultTexture");
-		auto scene_result_rtv = rhi->CreateRenderTargetView(render_resource->m_scene_result_id);
-        rhi->ClearRenderTargetView(scene_result_rtv, black_clear_color);
-        rhi->EndEvent();
+        // 只有深度，没有颜色目标
+        rhi->SetRenderTargetViewAndDepthStencilView(std::vector<std::shared_ptr<RenderTargetView>>(), dsv);
+        rhi->SetViewPort(m_viewport);
+        rhi->SetRasterizerState(RasterizerStateType_SolidBackCull);
+        rhi->SetDepthStencilState(DepthStencilStateType_DepthWriteLess);
+        rhi->SetBlendState(BlendStateType_Opaque);
+
+        rhi->SetPositionOnlyVertexInput(true);
+        m_depth_prepass_draw_list.Submit(rhi);
+        rhi->SetPositionOnlyVertexInput(false);
+        m_depth_prepass_ready = true;
     }
 
     void RenderPipeline::GBufferPass(DolasRHI* rhi, RenderView* render_view)
     {
         UserAnnotationScope scope(rhi, L"GBufferPass");
 
-        RenderScene* render_scene = TryGetRenderScene(render_view);
-        DOLAS_RETURN_IF_NULL(render_scene);
-
         // 设置 RT 和 视口
 		RenderResource* render_resource = TryGetRenderResource(render_view);
         DOLAS_RETURN_IF_NULL(render_resource);
@@ -177,27 +628,455 @@ namespace Dolas
         std::vector<std::shared_ptr<RenderTargetView>> rtvs;
         rtvs.push_back(g_dolas_engine.m_rhi->CreateRenderTargetView(render_resource->m_gbuffer_a_id));
         rtvs.push_back(g_dolas_engine.m_rhi->CreateRenderTargetView(render_resource->m_gbuffer_b_id));
-        rtvs.push_back(g_dolas_engine.m_rhi->CreateRenderTargetView(render_resource->m_gbuffer_c_id));
-        rtvs.push_back(g_dolas_engine.m_rhi->CreateRenderTargetView(render_resource->m_gbuffer_d_id));
 
         auto dsv = g_dolas_engine.m_rhi->CreateDepthStencilView(render_resource->m_depth_stencil_id);
 
+        // GBuffer 是这一帧第一次写入：先清除。深度预通道已经写过深度时不能再清（天空盒依赖清除后的 SKY 模板值）
+        rhi->BeginEvent(L"ClearGBufferTextures");
+		const FLOAT black_clear_color[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        for (const std::shared_ptr<RenderTargetView>& rtv : rtvs)
+        {
+            rhi->ClearRenderTargetView(rtv, black_clear_color);
+        }
+        if (!m_depth_prepass_ready)
+        {
+            DepthClearParams depth_clear_params;
+            depth_clear_params.enable = true;
+            depth_clear_params.clear_value = 1.0f;
+            StencilClearParams stencil_clear_params;
+            stencil_clear_params.enable = true;
+            stencil_clear_params.clear_value = StencilMaskEnum_SKY;
+            rhi->ClearDepthStencilView(dsv, depth_clear_params, stencil_clear_params);
+        }
+        rhi->EndEvent();
+
+        DOLAS_RETURN_IF_FALSE(m_gbuffer_draws_ready);
+
         rhi->SetRenderTargetViewAndDepthStencilView(rtvs, dsv);
         rhi->SetViewPort(m_viewport);
 
         rhi->SetRasterizerState(RasterizerStateType_SolidBackCull);
-        rhi->SetDepthStencilState(DepthStencilStateType_DepthWriteLess_StencilWriteStatic);
+        // 预通道之后深度已经是最终结果：EQUAL 测试、不写深度，每个像素只着色一次；模板仍在这里写入
+        rhi->SetDepthStencilState(m_depth_prepass_ready ? DepthStencilStateType_DepthEqual_StencilWriteStatic : DepthStencilStateType_DepthWriteLess_StencilWriteStatic);
         rhi->SetBlendState(BlendStateType_Opaque);
 
+        m_gbuffer_draw_list.Submit(rhi);
+    }
+
+    void RenderPipeline::CullRenderEntities(RenderScene* render_scene, RenderCamera* render_camera)
+    {
+        const auto start_time = std::chrono::high_resolution_clock::now();
+
         const std::vector<RenderEntityID>& render_entities = render_scene->GetRenderEntities();
-        for (RenderEntityID render_entity_id: render_entities)
+        const UInt entity_count = static_cast<UInt>(render_entities.size());
+
+        // 收集世界包围盒到 SoA，找不到的 entity 以空盒占位，保证下标与 render_entities 一一对应
+        m_culling_bounds.Clear();
+        m_culling_bounds.Reserve(entity_count);
+        for (RenderEntityID render_entity_id : render_entities)
         {
             RenderEntity* render_entity = g_dolas_engine.m_render_entity_manager->GetRenderEntityByID(render_entity_id);
-			DOLAS_CONTINUE_IF_NULL(render_entity);
-			render_entity->Draw(rhi);
+            m_culling_bounds.Add(render_entity ? render_entity->GetWorldBounds() : BoundingBox());
+        }
+        m_entity_visibility.assign(entity_count, 0);
+
+        const Matrix4x4 view_projection = render_camera->GetProjectionMatrix() * render_camera->GetViewMatrix();
+        const Frustum frustum = Frustum::FromViewProjection(view_projection);
+
+        // 按块切分到线程池，每个任务写入互不重叠的 visibility 区间
+        const UInt chunk_count = GetParallelChunkCount(entity_count, kCullingEntitiesPerTask);
+        std::vector<UInt> chunk_visible_counts(chunk_count, 0);
+        RunParallelChunks(chunk_count, entity_count, [this, &frustum, &chunk_visible_counts](UInt chunk_index, UInt begin, UInt end)
+        {
+            chunk_visible_counts[chunk_index] = FrustumCullBoxes(frustum, m_culling_bounds, begin, end, m_entity_visibility.data());
+        });
+
+        UInt visible_count = 0;
+        for (UInt chunk_visible_count : chunk_visible_counts)
+        {
+            visible_count += chunk_visible_count;
+        }
+
+        const auto frustum_end_time = std::chrono::high_resolution_clock::now();
+        m_culling_statistics.total_entity_count = entity_count;
+        m_culling_statistics.visible_entity_count = visible_count;
+        m_culling_statistics.culled_entity_count = entity_count - visible_count;
+        m_culling_statistics.culling_task_count = chunk_count;
+        m_culling_statistics.culling_milliseconds = std::chrono::duration<Double, std::milli>(frustum_end_time - start_time).count();
+
+        m_culling_statistics.occluder_count = 0;
+        m_culling_statistics.occluder_triangle_count = 0;
+        m_culling_statistics.occluded_entity_count = 0;
+        m_culling_statistics.occlusion_milliseconds = 0.0;
+        if (m_enable_occlusion_culling && visible_count > 0)
+        {
+            OcclusionCullRenderEntities(render_scene, render_camera, view_projection);
+            m_culling_statistics.visible_entity_count -= m_culling_statistics.occluded_entity_count;
+            const auto occlusion_end_time = std::chrono::high_resolution_clock::now();
+            m_culling_statistics.occlusion_milliseconds = std::chrono::duration<Double, std::milli>(occlusion_end_time - frustum_end_time).count();
+        }
+    }
+
+    void RenderPipeline::OcclusionCullRenderEntities(RenderScene* render_scene, RenderCamera* render_camera, const Matrix4x4& view_projection)
+    {
+        const std::vector<RenderEntityID>& render_entities = render_scene->GetRenderEntities();
+        const UInt entity_count = static_cast<UInt>(render_entities.size());
+
+        // 选择遮挡体：视锥内、屏幕上足够大的 entity，按大小从大到小
+        const Vector3 camera_position = render_camera->GetPosition();
+        const Float near_plane = render_camera->GetNearPlane();
+        std::vector<std::pair<Float, UInt>> occluder_candidates;
+        for (UInt entity_index = 0; entity_index < entity_count; ++entity_index)
+        {
+            if (m_entity_visibility[entity_index] == 0) continue;
+
+            const Vector3 center(m_culling_bounds.GetCenterX()[entity_index], m_culling_bounds.GetCenterY()[entity_index], m_culling_bounds.GetCenterZ()[entity_index]);
+            const Vector3 extents(m_culling_bounds.GetExtentX()[entity_index], m_culling_bounds.GetExtentY()[entity_index], m_culling_bounds.GetExtentZ()[entity_index]);
+            const Float screen_size = extents.Length() / std::max((center - camera_position).Length(), near_plane);
+            if (screen_size >= kMinOccluderScreenSize)
+            {
+                occluder_candidates.push_back({ screen_size, entity_index });
+            }
+        }
+        std::sort(occluder_candidates.begin(), occluder_candidates.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        m_occlusion_buffer.BeginFrame(view_projection);
+        UInt occluder_count = 0;
+        for (const auto& candidate : occluder_candidates)
+        {
+            if (occluder_count >= kMaxOccluderCount) break;
+
+            RenderEntity* render_entity = g_dolas_engine.m_render_entity_manager->GetRenderEntityByID(render_entities[candidate.second]);
+            DOLAS_CONTINUE_IF_NULL(render_entity);
+
+            UInt triangle_count = 0;
+            for (const RenderComponent& component : render_entity->GetComponents())
+            {
+                RenderPrimitive* render_primitive = g_dolas_engine.m_render_primitive_manager->GetRenderPrimitiveByID(component.m_render_primitive_id);
+                if (render_primitive) triangle_count += static_cast<UInt>(render_primitive->m_occluder_indices.size() / 3);
+            }
+            if (triangle_count == 0 || m_occlusion_buffer.GetTriangleCount() + triangle_count > kMaxOccluderTriangleCount) continue;
+
+            const Matrix4x4 world = render_entity->GetPose().ToMatrix();
+            for (const RenderComponent& component : render_entity->GetComponents())
+            {
+                RenderPrimitive* render_primitive = g_dolas_engine.m_render_primitive_manager->GetRenderPrimitiveByID(component.m_render_primitive_id);
+                if (!render_primitive || render_primitive->m_occluder_indices.empty()) continue;
+
+                m_occlusion_buffer.AddOccluder(
+                    world,
+                    render_primitive->m_occluder_positions.data(),
+                    static_cast<UInt>(render_primitive->m_occluder_positions.size() / 3),
+                    3,
+                    render_primitive->m_occluder_indices.data(),
+                    static_cast<UInt>(render_primitive->m_occluder_indices.size()));
+            }
+            ++occluder_count;
+        }
+
+        m_culling_statistics.occluder_count = occluder_count;
+        m_culling_statistics.occluder_triangle_count = m_occlusion_buffer.GetTriangleCount();
+        if (occluder_count == 0)
+        {
+            return;
+        }
+
+        // 各行带写入互不重叠的深度行，可以并行光栅化
+        const UInt band_count = m_occlusion_buffer.GetBandCount();
+        RunParallelChunks(GetParallelChunkCount(band_count, 1), band_count, [this](UInt, UInt begin, UInt end)
+        {
+            for (UInt band_index = begin; band_index < end; ++band_index)
+            {
+                m_occlusion_buffer.RasterizeBand(band_index);
+            }
+        });
+        m_occlusion_buffer.BuildHierarchicalZ();
+
+        const UInt chunk_count = GetParallelChunkCount(entity_count, kOcclusionEntitiesPerTask);
+        std::vector<UInt> chunk_occluded_counts(chunk_count, 0);
+        RunParallelChunks(chunk_count, entity_count, [this, &chunk_occluded_counts](UInt chunk_index, UInt begin, UInt end)
+        {
+            chunk_occluded_counts[chunk_index] = m_occlusion_buffer.CullOccludedBoxes(m_culling_bounds, begin, end, m_entity_visibility.data());
+        });
+        for (UInt chunk_occluded_count : chunk_occluded_counts)
+        {
+            m_culling_statistics.occluded_entity_count += chunk_occluded_count;
+        }
+    }
+
+    BufferID RenderPipeline::UploadClusterIndices()
+    {
+        BufferManager* buffer_manager = g_dolas_engine.m_buffer_manager;
+        if (!buffer_manager)
+        {
+            return BUFFER_ID_EMPTY;
+        }
+
+        const UInt index_count = static_cast<UInt>(m_cluster_indices.size());
+        if (m_cluster_index_buffer_id == BUFFER_ID_EMPTY || index_count > m_cluster_index_capacity)
+        {
+            // RHI 每帧结束都会等待 GPU，旧缓冲此时已不再被引用，可以直接释放
+            if (m_cluster_index_buffer_id != BUFFER_ID_EMPTY)
+            {
+                buffer_manager->DestroyBuffer(m_cluster_index_buffer_id);
+            }
+            const UInt capacity = std::max(kMinClusterIndexCapacity, std::max(index_count, m_cluster_index_capacity * 2));
+            m_cluster_index_buffer_id = buffer_manager->CreateIndexBuffer(capacity * sizeof(UInt), nullptr, BufferUsage::DYNAMIC, STRING_ID(cluster_index_buffer));
+            m_cluster_index_capacity = m_cluster_index_buffer_id == BUFFER_ID_EMPTY ? 0 : capacity;
+            if (m_cluster_index_buffer_id == BUFFER_ID_EMPTY)
+            {
+                LOG_ERROR("RenderPipeline::UploadClusterIndices: Failed to create cluster index buffer ({0} indices)", capacity);
+                return BUFFER_ID_EMPTY;
+            }
+        }
+
+        Buffer* buffer = buffer_manager->GetBufferByID(m_cluster_index_buffer_id);
+        if (!buffer || !buffer->UpdateData(m_cluster_indices.data(), index_count * sizeof(UInt), 0))
+        {
+            return BUFFER_ID_EMPTY;
+        }
+        return m_cluster_index_buffer_id;
+    }
+
+    void RenderPipeline::AssignLightClusters(RenderScene* render_scene, RenderCamera* render_camera)
+    {
+        const auto start_time = std::chrono::high_resolution_clock::now();
+
+        // froxel 按透视投影划分，正交相机只保留方向光
+        const Bool is_perspective = render_camera->GetCameraPerspectiveType() == CameraPerspectiveType::Perspective;
+        const std::vector<LocalLight>& lights = render_scene->GetLocalLights();
+        const UInt light_count = is_perspective ? static_cast<UInt>(lights.size()) : 0;
+
+        const Matrix4x4 projection = render_camera->GetProjectionMatrix();
+        LightClusterView cluster_view;
+        cluster_view.view = render_camera->GetViewMatrix();
+        cluster_view.projection_scale_x = std::abs(projection.data[0][0]);
+        cluster_view.projection_scale_y = std::abs(projection.data[1][1]);
+        cluster_view.near_plane = render_camera->GetNearPlane();
+        cluster_view.far_plane = render_camera->GetFarPlane();
+        m_light_cluster_grid.Setup(LightClusterGridDesc(), cluster_view);
+        m_light_cluster_grid.PrepareLights(lights.data(), light_count);
+
+        // 按光源分块到线程池，每块输出独立的 (cluster, light) 列表，最后按块顺序合并
+        const UInt chunk_count = GetParallelChunkCount(light_count, kLightClusteringLightsPerTask);
+        if (m_light_cluster_chunks.size() < chunk_count)
+        {
+            m_light_cluster_chunks.resize(chunk_count);
+        }
+        RunParallelChunks(chunk_count, light_count, [this](UInt chunk_index, UInt begin, UInt end)
+        {
+            LightClusterChunk& chunk = m_light_cluster_chunks[chunk_index];
+            chunk.Clear();
+            m_light_cluster_grid.AssignLights(begin, end, chunk);
+        });
+        m_light_cluster_grid.BuildLightLists(m_light_cluster_chunks.data(), chunk_count, m_light_cluster_ranges, m_light_cluster_indices);
+
+        m_local_light_data.resize(light_count);
+        for (UInt light_index = 0; light_index < light_count; ++light_index)
+        {
+            const LocalLight& light = lights[light_index];
+            LocalLightData& light_data = m_local_light_data[light_index];
+            light_data.position_range = Vector4(light.position, light.range);
+            light_data.color_type = Vector4(light.color * light.intensity, static_cast<Float>(light.type));
+            light_data.direction = Vector4(light.direction, 0.0f);
+            light_data.spot_scale_offset = Vector4(0.0f, 1.0f, 0.0f, 0.0f);
+            if (light.type == LocalLightType_Spot)
+            {
+                const Float spot_scale = 1.0f / std::max(light.spot_inner_cos - light.spot_outer_cos, 1.0e-4f);
+                light_data.spot_scale_offset = Vector4(spot_scale, -light.spot_outer_cos * spot_scale, 0.0f, 0.0f);
+            }
+        }
+
+        const auto end_time = std::chrono::high_resolution_clock::now();
+        m_light_clustering_statistics.local_light_count = light_count;
+        m_light_clustering_statistics.cluster_count = m_light_cluster_grid.GetClusterCount();
+        m_light_clustering_statistics.light_index_count = static_cast<UInt>(m_light_cluster_indices.size());
+        m_light_clustering_statistics.max_cluster_light_count = 0;
+        for (const LightClusterRange& range : m_light_cluster_ranges)
+        {
+            m_light_clustering_statistics.max_cluster_light_count = std::max(m_light_clustering_statistics.max_cluster_light_count, range.count);
+        }
+        m_light_clustering_statistics.assignment_task_count = chunk_count;
+        m_light_clustering_statistics.assignment_milliseconds = std::chrono::duration<Double, std::milli>(end_time - start_time).count();
+    }
+
+    Bool RenderPipeline::UploadLightClusters()
+    {
+        return UploadDynamicStructuredBuffer(STRING_ID(local_light_buffer), m_local_light_buffer_id, m_local_light_capacity, kMinLocalLightCapacity,
+                m_local_light_data.data(), static_cast<UInt>(m_local_light_data.size()), sizeof(LocalLightData))
+            && UploadDynamicStructuredBuffer(STRING_ID(light_cluster_range_buffer), m_light_cluster_range_buffer_id, m_light_cluster_range_capacity, m_light_cluster_grid.GetClusterCount(),
+                m_light_cluster_ranges.data(), static_cast<UInt>(m_light_cluster_ranges.size()), sizeof(LightClusterRange))
+            && UploadDynamicStructuredBuffer(STRING_ID(light_cluster_index_buffer), m_light_cluster_index_buffer_id, m_light_cluster_index_capacity, kMinLightClusterIndexCapacity,
+                m_light_cluster_indices.data(), static_cast<UInt>(m_light_cluster_indices.size()), sizeof(UInt));
+    }
+
+    void RenderPipeline::UpdateShadowCascades(DolasRHI* rhi, RenderCamera* render_camera)
+    {
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        const UInt cascade_count = std::min(m_shadow_desc.cascade_count, kMaxShadowCascadeCount);
+        const UInt entity_count = m_culling_bounds.GetCount();
+
+        // 近平面要延伸到所有投射体，取全部 entity 世界包围盒的并集（空盒的半长为负，跳过）
+        BoundingBox caster_bounds;
+        const Float* center_x = m_culling_bounds.GetCenterX();
+        const Float* center_y = m_culling_bounds.GetCenterY();
+        const Float* center_z = m_culling_bounds.GetCenterZ();
+        const Float* extent_x = m_culling_bounds.GetExtentX();
+        const Float* extent_y = m_culling_bounds.GetExtentY();
+        const Float* extent_z = m_culling_bounds.GetExtentZ();
+        for (UInt entity_index = 0; entity_index < entity_count; ++entity_index)
+        {
+            if (extent_x[entity_index] < 0.0f) continue;
+            const Vector3 center(center_x[entity_index], center_y[entity_index], center_z[entity_index]);
+            const Vector3 extents(extent_x[entity_index], extent_y[entity_index], extent_z[entity_index]);
+            caster_bounds.Merge(BoundingBox(center - extents, center + extents));
+        }
+
+        const Matrix4x4 projection = render_camera->GetProjectionMatrix();
+        CascadeShadowView shadow_view;
+        shadow_view.view = render_camera->GetViewMatrix();
+        shadow_view.projection_scale_x = std::abs(projection.data[0][0]);
+        shadow_view.projection_scale_y = std::abs(projection.data[1][1]);
+        shadow_view.near_plane = render_camera->GetNearPlane();
+        shadow_view.far_plane = render_camera->GetFarPlane();
+        const Vector4& light_direction_intensity = rhi->GetMainLightDirectionIntensity();
+        const Vector3 light_direction(light_direction_intensity.x, light_direction_intensity.y, light_direction_intensity.z);
+        ComputeShadowCascades(m_shadow_desc, shadow_view, light_direction, caster_bounds, m_shadow_cascades);
+
+        m_shadow_statistics.cascade_count = cascade_count;
+        m_shadow_statistics.total_entity_count = entity_count;
+        m_shadow_statistics.fitting_milliseconds = std::chrono::duration<Double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+        // 每个 cascade 按 entity 分块并行剔除，各块写入互不重叠的 visibility 区间
+        const UInt chunk_count = GetParallelChunkCount(entity_count, kCullingEntitiesPerTask);
+        std::vector<UInt> chunk_caster_counts(chunk_count, 0);
+        for (UInt cascade_index = 0; cascade_index < cascade_count; ++cascade_index)
+        {
+            const auto culling_start_time = std::chrono::high_resolution_clock::now();
+            const ShadowCascade& cascade = m_shadow_cascades[cascade_index];
+            std::vector<UByte>& visibility = m_shadow_cascade_visibility[cascade_index];
+            visibility.assign(entity_count, 0);
+            std::fill(chunk_caster_counts.begin(), chunk_caster_counts.end(), 0);
+            RunParallelChunks(chunk_count, entity_count, [this, &cascade, &visibility, &chunk_caster_counts](UInt chunk_index, UInt begin, UInt end)
+            {
+                chunk_caster_counts[chunk_index] = CullShadowCasters(cascade, m_culling_bounds, begin, end, visibility.data());
+            });
+
+            RenderShadowCascadeStatistics& cascade_statistics = m_shadow_statistics.cascades[cascade_index];
+            cascade_statistics.caster_count = 0;
+            for (UInt chunk_caster_count : chunk_caster_counts)
+            {
+                cascade_statistics.caster_count += chunk_caster_count;
+            }
+            cascade_statistics.culling_milliseconds = std::chrono::duration<Double, std::milli>(std::chrono::high_resolution_clock::now() - culling_start_time).count();
         }
     }
 
+    void RenderPipeline::ShadowDepthPass(DolasRHI* rhi, RenderView* render_view)
+    {
+        UserAnnotationScope scope(rhi, L"ShadowDepthPass");
+        m_shadow_cascades_ready = false;
+        m_shadow_statistics = RenderShadowStatistics();
+
+        RenderResource* render_resource = TryGetRenderResource(render_view);
+        DOLAS_RETURN_IF_NULL(render_resource);
+
+        // 阴影图集由这个 pass 第一次写入，关闭阴影时也要清除，保证 DeferredShadingPass 读到的是确定的内容
+        auto dsv = g_dolas_engine.m_rhi->CreateDepthStencilView(render_resource->m_shadow_map_id);
+        rhi->BeginEvent(L"ClearShadowMap");
+        DepthClearParams depth_clear_params;
+        depth_clear_params.enable = true;
+        depth_clear_params.clear_value = 1.0f;
+        StencilClearParams stencil_clear_params;
+        stencil_clear_params.enable = false;
+        rhi->ClearDepthStencilView(dsv, depth_clear_params, stencil_clear_params);
+        rhi->EndEvent();
+
+        RenderScene* render_scene = TryGetRenderScene(render_view);
+        RenderCamera* render_camera = TryGetRenderCamera(render_view);
+        DOLAS_RETURN_IF_NULL(render_scene);
+        DOLAS_RETURN_IF_NULL(render_camera);
+
+        // cascade 划分依赖透视投影，正交相机不渲染阴影
+        DOLAS_RETURN_IF_FALSE(m_enable_shadows);
+        DOLAS_RETURN_IF_FALSE(render_camera->GetCameraPerspectiveType() == CameraPerspectiveType::Perspective);
+
+        // 世界包围盒由 CollectGBufferDraws 的 CullRenderEntities 收集，下标与 render_entities 一一对应
+        const std::vector<RenderEntityID>& render_entities = render_scene->GetRenderEntities();
+        DOLAS_RETURN_IF_FALSE(m_culling_bounds.GetCount() == static_cast<UInt>(render_entities.size()));
+
+        Material* material = g_dolas_engine.m_material_manager->GetGlobalMaterial(GlobalMaterialType::DepthOnly);
+        DOLAS_RETURN_IF_NULL(material);
+        DOLAS_RETURN_IF_NULL(material->GetVertexContext());
+        DOLAS_RETURN_IF_NULL(material->GetPixelContext());
+
+        UpdateShadowCascades(rhi, render_camera);
+
+        // 只有深度，没有颜色目标
+        rhi->SetRenderTargetViewAndDepthStencilView(std::vector<std::shared_ptr<RenderTargetView>>(), dsv);
+        rhi->SetRasterizerState(RasterizerStateType_ShadowDepthBias);
+        rhi->SetDepthStencilState(DepthStencilStateType_DepthWriteLess);
+        rhi->SetBlendState(BlendStateType_Opaque);
+        rhi->SetPositionOnlyVertexInput(true);
+
+        // 单个 command list，录制在渲染线程上逐 cascade 串行完成
+        for (UInt cascade_index = 0; cascade_index < m_shadow_statistics.cascade_count; ++cascade_index)
+        {
+            const auto record_start_time = std::chrono::high_resolution_clock::now();
+            const ShadowCascade& cascade = m_shadow_cascades[cascade_index];
+            const std::vector<UByte>& visibility = m_shadow_cascade_visibility[cascade_index];
+            RenderShadowCascadeStatistics& cascade_statistics = m_shadow_statistics.cascades[cascade_index];
+
+            UInt atlas_x = 0;
+            UInt atlas_y = 0;
+            m_shadow_desc.GetCascadeAtlasOffset(cascade_index, atlas_x, atlas_y);
+            const Float resolution = static_cast<Float>(m_shadow_desc.resolution);
+            rhi->SetViewPort(ViewPort(static_cast<Float>(atlas_x), static_cast<Float>(atlas_y), resolution, resolution, 0.0f, 1.0f));
+            // per-view 常量写入 RHI 的瞬态常量环，不会覆盖前一个 cascade 已录制的 draw
+            rhi->UpdatePerViewParameters(cascade.light_view, cascade.projection, cascade.bounding_sphere.center);
+
+            for (size_t entity_index = 0; entity_index < render_entities.size(); ++entity_index)
+            {
+                if (visibility[entity_index] == 0) continue;
+
+                RenderEntity* render_entity = g_dolas_engine.m_render_entity_manager->GetRenderEntityByID(render_entities[entity_index]);
+                DOLAS_CONTINUE_IF_NULL(render_entity);
+                rhi->UpdatePerObjectParameters(render_entity->GetPose());
+                if (!rhi->BindMaterial(material)) continue;
+
+                // meshlet 剔除结果只对相机有效，阴影总是绘制完整网格。
+                // component.m_lod_index 只对相机可见的 entity 每帧更新，这里按 cascade 的正交视图重新选择 LOD
+                const Matrix4x4 world = render_entity->GetPose().ToMatrix();
+                for (const RenderComponent& component : render_entity->GetComponents())
+                {
+                    RenderPrimitive* render_primitive = g_dolas_engine.m_render_primitive_manager->GetRenderPrimitiveByID(component.m_render_primitive_id);
+                    DOLAS_CONTINUE_IF_NULL(render_primitive);
+                    UInt lod_index = 0;
+                    if (m_enable_mesh_lod && render_primitive->GetLODCount() > 1 && render_primitive->m_local_bounding_sphere.IsValid())
+                    {
+                        const BoundingSphere world_sphere = render_primitive->m_local_bounding_sphere.Transform(world);
+                        lod_index = SelectMeshLOD(
+                            ComputeOrthographicScreenSize(world_sphere, cascade.bounding_sphere.radius),
+                            render_primitive->m_lod_screen_sizes.data(),
+                            render_primitive->GetLODCount(),
+                            0,
+                            0.0f);
+                    }
+                    rhi->DrawRenderPrimitive(component.m_render_primitive_id, lod_index);
+                    ++cascade_statistics.draw_count;
+                    cascade_statistics.triangle_count += render_primitive->GetTriangleCount(lod_index);
+                }
+            }
+            cascade_statistics.record_milliseconds = std::chrono::duration<Double, std::milli>(std::chrono::high_resolution_clock::now() - record_start_time).count();
+        }
+
+        // 恢复相机的 per-view 常量、视口与完整顶点流，供后续 pass 使用
+        rhi->SetPositionOnlyVertexInput(false);
+        rhi->UpdatePerViewParameters(render_camera);
+        rhi->SetViewPort(m_viewport);
+        m_shadow_cascades_ready = true;
+    }
+
     void RenderPipeline::DeferredShadingPass(DolasRHI* rhi, RenderView* render_view)
     {
         UserAnnotationScope scope(rhi, L"DeferredShadingPass");
@@ -205,10 +1084,28 @@ namespace Dolas
         RenderResource* render_resource = TryGetRenderResource(render_view);
         DOLAS_RETURN_IF_NULL(render_resource);
 
+        // 点光 / 聚光的 cluster 分配在 CPU 上完成，上传失败时只保留方向光
+        Bool light_clusters_ready = false;
+        RenderScene* render_scene = TryGetRenderScene(render_view);
+        RenderCamera* render_camera = TryGetRenderCamera(render_view);
+        if (render_scene && render_camera)
+        {
+            rhi->BeginEvent(L"AssignLightClusters");
+            AssignLightClusters(render_scene, render_camera);
+            light_clusters_ready = UploadLightClusters();
+            rhi->EndEvent();
+        }
+
         std::vector<std::shared_ptr<RenderTargetView>> rtvs;
         auto scene_result_rtv = g_dolas_engine.m_rhi->CreateRenderTargetView(render_resource->m_scene_result_id);
         rtvs.push_back(scene_result_rtv);
 
+        // scene_result 在这一帧第一次写入
+        rhi->BeginEvent(L"ClearSceneResultTexture");
+		const FLOAT black_clear_color[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        rhi->ClearRenderTargetView(scene_result_rtv, black_clear_color);
+        rhi->EndEvent();
+
         rhi->SetRenderTargetViewWithoutDepthStencilView(rtvs);
         rhi->SetViewPort(m_viewport);
 
@@ -227,8 +1124,65 @@ namespace Dolas
 
         pixel_context->SetShaderResourceView(0, render_resource->m_gbuffer_a_id);
         pixel_context->SetShaderResourceView(1, render_resource->m_gbuffer_b_id);
-        pixel_context->SetShaderResourceView(2, render_resource->m_gbuffer_c_id);
-        pixel_context->SetShaderResourceView(3, render_resource->m_gbuffer_d_id);
+        pixel_context->SetShaderResourceView(2, render_resource->m_depth_stencil_id);
+
+        const LightClusterGridDesc& cluster_desc = m_light_cluster_grid.GetDesc();
+        const UInt cluster_light_count = light_clusters_ready ? m_light_clustering_statistics.local_light_count : 0;
+        if (light_clusters_ready)
+        {
+            BufferManager* buffer_manager = g_dolas_engine.m_buffer_manager;
+            pixel_context->SetShaderResourceView(3, buffer_manager->GetBufferByID(m_local_light_buffer_id));
+            pixel_context->SetShaderResourceView(4, buffer_manager->GetBufferByID(m_light_cluster_range_buffer_id));
+            pixel_context->SetShaderResourceView(5, buffer_manager->GetBufferByID(m_light_cluster_index_buffer_id));
+        }
+        ResolveDeferredShadingVariables(pixel_context.get());
+        const DeferredShadingVariables& variables = m_deferred_shading_variables;
+        pixel_context->SetGlobalVariable(variables.light_cluster_grid, Vector4(
+            static_cast<Float>(cluster_desc.tiles_x),
+            static_cast<Float>(cluster_desc.tiles_y),
+            static_cast<Float>(cluster_desc.slice_count),
+            static_cast<Float>(cluster_light_count)));
+        pixel_context->SetGlobalVariable(variables.light_cluster_depth, Vector4(m_light_cluster_grid.GetNearPlane(), m_light_cluster_grid.GetSliceScale(), 0.0f, 0.0f));
+
+        // 阴影图集总是绑定（ShadowDepthPass 至少会清除它），cascade 数量为 0 时着色器不采样
+        pixel_context->SetShaderResourceView(6, render_resource->m_shadow_map_id);
+        const UInt shadow_cascade_count = m_shadow_cascades_ready ? m_shadow_statistics.cascade_count : 0;
+        Matrix4x4 shadow_matrices[kMaxShadowCascadeCount];
+        Float shadow_splits[kMaxShadowCascadeCount] = {};
+        for (UInt cascade_index = 0; cascade_index < shadow_cascade_count; ++cascade_index)
+        {
+            shadow_matrices[cascade_index] = m_shadow_cascades[cascade_index].view_projection;
+            shadow_splits[cascade_index] = m_shadow_cascades[cascade_index].split_far;
+        }
+        const Float shadow_atlas_width = static_cast<Float>(m_shadow_desc.GetAtlasWidth());
+        const Float shadow_atlas_height = static_cast<Float>(m_shadow_desc.GetAtlasHeight());
+        const Float shadow_resolution = static_cast<Float>(m_shadow_desc.resolution);
+        pixel_context->SetGlobalVariable(variables.shadow_cascade_matrices, shadow_matrices, kMaxShadowCascadeCount);
+        pixel_context->SetGlobalVariable(variables.shadow_cascade_splits, Vector4(shadow_splits[0], shadow_splits[1], shadow_splits[2], shadow_splits[3]));
+        pixel_context->SetGlobalVariable(variables.shadow_atlas, Vector4(
+            shadow_resolution / shadow_atlas_width,
+            shadow_resolution / shadow_atlas_height,
+            1.0f / shadow_atlas_width,
+            1.0f / shadow_atlas_height));
+        pixel_context->SetGlobalVariable(variables.shadow_params, Vector4(static_cast<Float>(shadow_cascade_count), 0.0f, 0.0f, 0.0f));
+
+        // 天空光照：辐照度球谐在常量中，预过滤高光与 BRDF LUT 在 t7 / t8（异步加载完成之前高光为 0）
+        TextureManager* texture_manager = g_dolas_engine.m_texture_manager;
+        const Bool sky_lighting_ready = texture_manager->HasImageBasedLighting();
+        if (sky_lighting_ready)
+        {
+            Float packed_sh[SH_L2_COEFFICIENT_COUNT][4];
+            PackIrradianceSHForShader(texture_manager->GetSkyIrradianceSH(), packed_sh);
+            Vector4 sky_irradiance_sh[SH_L2_COEFFICIENT_COUNT];
+            for (UInt i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+            {
+                sky_irradiance_sh[i] = Vector4(packed_sh[i][0], packed_sh[i][1], packed_sh[i][2], packed_sh[i][3]);
+            }
+            pixel_context->SetGlobalVariable(variables.sky_irradiance_sh, sky_irradiance_sh, SH_L2_COEFFICIENT_COUNT);
+            pixel_context->SetShaderResourceView(7, texture_manager->GetGlobalTexture(GlobalTextureType::GLOBAL_TEXTURE_SKY_SPECULAR));
+            pixel_context->SetShaderResourceView(8, texture_manager->GetGlobalTexture(GlobalTextureType::GLOBAL_TEXTURE_BRDF_LUT));
+        }
+        pixel_context->SetGlobalVariable(variables.sky_lighting_params, Vector4(sky_lighting_ready ? 1.0f : 0.0f, 0.0f, 0.0f, 0.0f));
 
         if (rhi->BindVertexContext(vertex_context) && rhi->BindPixelContext(pixel_context))
         {
@@ -237,6 +1191,24 @@ namespace Dolas
         }
     }
 
+    void RenderPipeline::ResolveDeferredShadingVariables(const PixelContext* pixel_context)
+    {
+        DeferredShadingVariables& variables = m_deferred_shading_variables;
+        if (variables.pixel_context == pixel_context)
+        {
+            return;
+        }
+        variables.pixel_context = pixel_context;
+        variables.light_cluster_grid = pixel_context->FindGlobalVariable(STRING_ID(g_LightClusterGrid));
+        variables.light_cluster_depth = pixel_context->FindGlobalVariable(STRING_ID(g_LightClusterDepth));
+        variables.shadow_cascade_matrices = pixel_context->FindGlobalVariable(STRING_ID(g_ShadowCascadeMatrices));
+        variables.shadow_cascade_splits = pixel_context->FindGlobalVariable(STRING_ID(g_ShadowCascadeSplits));
+        variables.shadow_atlas = pixel_context->FindGlobalVariable(STRING_ID(g_ShadowAtlas));
+        variables.shadow_params = pixel_context->FindGlobalVariable(STRING_ID(g_ShadowParams));
+        variables.sky_irradiance_sh = pixel_context->FindGlobalVariable(STRING_ID(g_SkyIrradianceSH));
+        variables.sky_lighting_params = pixel_context->FindGlobalVariable(STRING_ID(g_SkyLightingParams));
+    }
+
 	void RenderPipeline::ForwardShadingPass(DolasRHI* rhi)
 	{
         UserAnnotationScope scope(rhi, L"ForwardShadingPass");
@@ -245,7 +1217,6 @@ namespace Dolas
     void RenderPipeline::SkyboxPass(DolasRHI* rhi, RenderView* render_view)
     {
         UserAnnotationScope scope(rhi, L"SkyboxPass");
-        // TODO: Implement SkyboxPass
 		RenderResource* render_resource = TryGetRenderResource(render_view);
 		DOLAS_RETURN_IF_NULL(render_resource);
 
@@ -258,14 +1229,6 @@ namespace Dolas
 		rhi->SetDepthStencilState(DepthStencilStateType_DepthDisabled_StencilReadSky);
 		rhi->SetBlendState(BlendStateType_Opaque);
 
-        RenderCamera* eye_camera = TryGetRenderCamera(render_view);
-		DOLAS_RETURN_IF_NULL(eye_camera);
-        
-        const Float hack_scale = 0.99f;
-        Float scale = eye_camera->GetFarPlane() * hack_scale;
-        Pose pose(eye_camera->GetPosition(), Quaternion(1.0, 0.0, 0.0, 0.0), Vector3(scale, scale, scale));
-        rhi->UpdatePerObjectParameters(pose);
-
         Material* material = g_dolas_engine.m_material_manager->GetGlobalMaterial(GlobalMaterialType::SkyBox);
         DOLAS_RETURN_IF_NULL(material);
 
@@ -277,11 +1240,10 @@ namespace Dolas
 
         pixel_context->SetShaderResourceView(0, g_dolas_engine.m_texture_manager->GetGlobalTexture(GlobalTextureType::GLOBAL_TEXTURE_SKY_BOX));
 
-		// 绑定 Shader
+		// 全屏三角形，PS 用逆视图投影矩阵重建视线方向采样立方体纹理；模板只放过没有几何体覆盖的像素
         if (rhi->BindVertexContext(vertex_context) && rhi->BindPixelContext(pixel_context))
         {
-            RenderPrimitiveID sphere_render_primitive_id = g_dolas_engine.m_render_primitive_manager->GetGeometryRenderPrimitiveID(BaseGeometryType_SPHERE);
-            rhi->DrawRenderPrimitive(sphere_render_primitive_id);
+            rhi->DrawFullScreenTriangle();
         }
     }
 
@@ -339,6 +1301,8 @@ namespace Dolas
         g_dolas_engine.m_rhi->SetDepthStencilState(DepthStencilStateType_DepthReadOnly);
         g_dolas_engine.m_rhi->SetBlendState(BlendStateType_Opaque);
 
+		// 每个调试对象都要写一次颜色，先解析成 handle
+		const ConstantBufferVariableHandle color_handle = pixel_context->FindGlobalVariable(STRING_ID(g_DebugDrawColor));
 		for (const DebugDrawObject& debug_draw_object : debug_objects)
 		{
 			Vector4 color_value(
@@ -347,7 +1311,7 @@ namespace Dolas
 				debug_draw_object.m_color.b,
 				debug_draw_object.m_color.a);
 
-			pixel_context->SetGlobalVariable("g_DebugDrawColor", color_value);
+			pixel_context->SetGlobalVariable(color_handle, color_value);
 			rhi->UpdatePerObjectParameters(debug_draw_object.m_pose);
 			if (rhi->BindVertexContext(vertex_context) && rhi->BindPixelContext(pixel_context))
 			{
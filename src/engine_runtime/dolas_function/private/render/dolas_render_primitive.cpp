@@ -24,9 +24,22 @@ namespace Dolas
     {
         m_vertex_count = 0;
         m_index_count = 0;
+        m_lods.clear();
+        m_lod_screen_sizes.clear();
+        m_meshlets.Clear();
         m_topology = PrimitiveTopology::PrimitiveTopology_TriangleList;
         return true;
     }
+
+    UInt RenderPrimitive::GetTriangleCount(UInt lod_index /*= 0*/) const
+    {
+        const UInt index_count = lod_index < m_lods.size() ? m_lods[lod_index].m_index_count : m_index_count;
+        if (m_topology == PrimitiveTopology::PrimitiveTopology_TriangleStrip)
+        {
+            return index_count >= 3 ? index_count - 2 : 0;
+        }
+        return index_count / 3;
+    }
 }
 
 
@@ -5,5 +5,15 @@
 
 namespace Dolas
 {
-
+    const RenderResourceTransientTexture* RenderResource::GetTransientTexture(TextureID texture_id) const
+    {
+        for (const RenderResourceTransientTexture& transient_texture : m_transient_textures)
+        {
+            if (transient_texture.m_desc.texture_handle == texture_id)
+            {
+                return &transient_texture;
+            }
+        }
+        return nullptr;
+    }
 } // namespace Dolas 
\ No newline at end of file
@@ -25,7 +25,7 @@ namespace Dolas
 
     RenderScene::~RenderScene()
     {
-
+        Clear();
     }
 
     bool RenderScene::Initialize()
@@ -35,9 +35,141 @@ namespace Dolas
 
     bool RenderScene::Clear()
     {
+        for (auto& proxy_pair : m_entity_proxies)
+        {
+            proxy_pair.second.render_entity->m_owner_scene = nullptr;
+        }
+        m_render_entities.clear();
+        m_entity_proxies.clear();
+        m_entity_tree.Clear();
+        m_local_lights.clear();
         return true;
     }
 
+    void RenderScene::AddRenderEntity(RenderEntityID render_entity_id)
+    {
+        if (m_entity_proxies.find(render_entity_id) != m_entity_proxies.end())
+        {
+            return;
+        }
+
+        AddRenderEntity(g_dolas_engine.m_render_entity_manager->GetRenderEntityByID(render_entity_id));
+    }
+
+    void RenderScene::AddRenderEntity(RenderEntity* render_entity)
+    {
+        DOLAS_RETURN_IF_NULL(render_entity);
+        const RenderEntityID render_entity_id = render_entity->GetID();
+        if (m_entity_proxies.find(render_entity_id) != m_entity_proxies.end())
+        {
+            return;
+        }
+        if (render_entity->m_owner_scene && render_entity->m_owner_scene != this)
+        {
+            render_entity->m_owner_scene->RemoveRenderEntity(render_entity_id);
+        }
+
+        m_render_entities.push_back(render_entity_id);
+        m_entity_proxies[render_entity_id] = { m_entity_tree.Insert(render_entity->GetWorldBounds(), render_entity_id), render_entity };
+        render_entity->m_owner_scene = this;
+    }
+
+    void RenderScene::RemoveRenderEntity(RenderEntityID render_entity_id)
+    {
+        auto proxy_it = m_entity_proxies.find(render_entity_id);
+        if (proxy_it == m_entity_proxies.end())
+        {
+            return;
+        }
+
+        m_entity_tree.Remove(proxy_it->second.proxy_id);
+        proxy_it->second.render_entity->m_owner_scene = nullptr;
+        m_entity_proxies.erase(proxy_it);
+        m_render_entities.erase(std::remove(m_render_entities.begin(), m_render_entities.end(), render_entity_id), m_render_entities.end());
+    }
+
+    void RenderScene::RefitRenderEntity(RenderEntityID render_entity_id)
+    {
+        auto proxy_it = m_entity_proxies.find(render_entity_id);
+        if (proxy_it == m_entity_proxies.end())
+        {
+            return;
+        }
+
+        m_entity_tree.Refit(proxy_it->second.proxy_id, proxy_it->second.render_entity->GetWorldBounds());
+    }
+
+    UInt RenderScene::AddLocalLight(const LocalLight& light)
+    {
+        m_local_lights.push_back(light);
+        return static_cast<UInt>(m_local_lights.size() - 1);
+    }
+
+    void RenderScene::SetLocalLight(UInt light_index, const LocalLight& light)
+    {
+        if (light_index >= m_local_lights.size())
+        {
+            LOG_WARN("RenderScene::SetLocalLight: light index {0} out of range ({1} lights)", light_index, m_local_lights.size());
+            return;
+        }
+        m_local_lights[light_index] = light;
+    }
+
+    void RenderScene::RemoveLocalLight(UInt light_index)
+    {
+        if (light_index >= m_local_lights.size())
+        {
+            return;
+        }
+        m_local_lights[light_index] = m_local_lights.back();
+        m_local_lights.pop_back();
+    }
+
+    void RenderScene::QueryRenderEntities(const Frustum& frustum, std::vector<RenderEntityID>& out_render_entities) const
+    {
+        m_entity_tree.QueryFrustum(frustum, [this, &out_render_entities](Int proxy_id)
+        {
+            out_render_entities.push_back(static_cast<RenderEntityID>(m_entity_tree.GetUserData(proxy_id)));
+            return true;
+        });
+    }
+
+    void RenderScene::QueryRenderEntities(const BoundingBox& box, std::vector<RenderEntityID>& out_render_entities) const
+    {
+        m_entity_tree.QueryBox(box, [this, &out_render_entities](Int proxy_id)
+        {
+            out_render_entities.push_back(static_cast<RenderEntityID>(m_entity_tree.GetUserData(proxy_id)));
+            return true;
+        });
+    }
+
+    RenderEntityID RenderScene::RayCastRenderEntity(const Vector3& origin, const Vector3& direction, Float max_distance, Float* out_distance /*= nullptr*/) const
+    {
+        RenderEntityID closest_entity_id = RENDER_ENTITY_ID_EMPTY;
+        Float closest_distance = max_distance;
+        m_entity_tree.RayCast(origin, direction, max_distance, [&](Int proxy_id, Float current_max_distance)
+        {
+            // 树中保存的是外扩后的包围盒，用 entity 的实际世界包围盒确认命中
+            const RenderEntityID render_entity_id = static_cast<RenderEntityID>(m_entity_tree.GetUserData(proxy_id));
+            auto proxy_it = m_entity_proxies.find(render_entity_id);
+            RenderEntity* render_entity = proxy_it != m_entity_proxies.end() ? proxy_it->second.render_entity : nullptr;
+            Float distance = 0.0f;
+            if (render_entity && render_entity->GetWorldBounds().IntersectsRay(origin, direction, current_max_distance, distance))
+            {
+                closest_entity_id = render_entity_id;
+                closest_distance = distance;
+                return distance;
+            }
+            return current_max_distance;
+        });
+
+        if (out_distance && closest_entity_id != RENDER_ENTITY_ID_EMPTY)
+        {
+            *out_distance = closest_distance;
+        }
+        return closest_entity_id;
+    }
+
     // BuildFromAsset 已废弃：RenderSceneManager 直接构建 m_render_entities
 
 } // namespace Dolas 
\ No newline at end of file
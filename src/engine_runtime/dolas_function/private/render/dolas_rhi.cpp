@@ -24,8 +24,11 @@
 #include "render/dolas_render_primitive.h"
 #include "manager/dolas_render_primitive_manager.h"
 #include "manager/dolas_buffer_manager.h"
+#include "render/dolas_material.h"
 #include "render/dolas_shader.h"
 #include "render/dolas_texture.h"
+#include "manager/dolas_task_manager.h"
+#include "dolas_paths.h"
 namespace Dolas
 {
 	struct DolasRHI::D3D11StateCache
@@ -47,7 +50,10 @@ namespace Dolas
 
 	namespace
 	{
-		constexpr UINT kD3D12SrvTableSize = 16;
+		// 查询回读缓冲布局：先是每段的起止 timestamp，之后是每段的 pipeline statistics
+		constexpr UINT kD3D12TimestampQueryCount = kMaxGpuPassQueryCount * 2;
+		constexpr UINT kD3D12PipelineStatisticsReadbackOffset = kD3D12TimestampQueryCount * sizeof(UINT64);
+		constexpr UINT kD3D12QueryReadbackSize = kD3D12PipelineStatisticsReadbackOffset + kMaxGpuPassQueryCount * sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS);
 		constexpr UINT kRootPerViewCBV = 0;
 		constexpr UINT kRootPerFrameCBV = 1;
 		constexpr UINT kRootPerObjectCBV = 2;
@@ -55,6 +61,12 @@ namespace Dolas
 		constexpr UINT kRootPSGlobalCBV = 4;
 		constexpr UINT kRootVSSrvTable = 5;
 		constexpr UINT kRootPSSrvTable = 6;
+		constexpr UINT kRootBindlessSrvTable = 7;
+		constexpr UINT kBindlessSrvRegisterSpace = 1;
+		// per-view / per-object 常量上传环的大小：每次更新占 256 字节，约 3 万次更新 / 帧
+		constexpr UINT kD3D12TransientConstantBufferSize = 8 * 1024 * 1024;
+		// 材质参数 arena 的初始容量，每个材质每个 stage 至少一个 256 字节块
+		constexpr UInt kD3D12MaterialConstantBufferMinCapacity = 64 * 1024;
 
 		template<typename T>
 		void SafeRelease(T*& ptr)
@@ -76,6 +88,149 @@ namespace Dolas
 			return (value + 255u) & ~255u;
 		}
 
+		// 渲染图的访问掩码 -> D3D12 资源状态；组合的只读访问映射为对应只读状态的按位或
+		D3D12_RESOURCE_STATES ToD3D12ResourceState(UInt access)
+		{
+			if (access & RenderGraphAccess_Present) return D3D12_RESOURCE_STATE_PRESENT;
+			if (access & RenderGraphAccess_RenderTarget) return D3D12_RESOURCE_STATE_RENDER_TARGET;
+			if (access & RenderGraphAccess_DepthWrite) return D3D12_RESOURCE_STATE_DEPTH_WRITE;
+			if (access & RenderGraphAccess_CopyDest) return D3D12_RESOURCE_STATE_COPY_DEST;
+
+			D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
+			if (access & RenderGraphAccess_DepthRead) state |= D3D12_RESOURCE_STATE_DEPTH_READ;
+			if (access & RenderGraphAccess_PixelShaderResource) state |= D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+			if (access & RenderGraphAccess_NonPixelShaderResource) state |= D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+			if (access & RenderGraphAccess_CopySource) state |= D3D12_RESOURCE_STATE_COPY_SOURCE;
+			return state;
+		}
+
+		Bool IsD3D12ReadOnlyState(D3D12_RESOURCE_STATES state)
+		{
+			const D3D12_RESOURCE_STATES kWriteStates = D3D12_RESOURCE_STATE_RENDER_TARGET | D3D12_RESOURCE_STATE_UNORDERED_ACCESS |
+				D3D12_RESOURCE_STATE_DEPTH_WRITE | D3D12_RESOURCE_STATE_STREAM_OUT | D3D12_RESOURCE_STATE_COPY_DEST | D3D12_RESOURCE_STATE_RESOLVE_DEST;
+			return state != D3D12_RESOURCE_STATE_COMMON && (state & kWriteStates) == 0;
+		}
+
+		DXGI_FORMAT ConvertToDepthStencilViewFormat(DXGI_FORMAT format)
+		{
+			switch (format)
+			{
+			case DXGI_FORMAT_R24G8_TYPELESS:
+				return DXGI_FORMAT_D24_UNORM_S8_UINT;
+			case DXGI_FORMAT_R32_TYPELESS:
+				return DXGI_FORMAT_D32_FLOAT;
+			case DXGI_FORMAT_R16_TYPELESS:
+				return DXGI_FORMAT_D16_UNORM;
+			case DXGI_FORMAT_R32G8X24_TYPELESS:
+				return DXGI_FORMAT_D32_FLOAT_S8X24_UINT;
+			default:
+				return format;
+			}
+		}
+
+		// 子资源视图只覆盖单个 mip / 单个数组切片
+		D3D12_RENDER_TARGET_VIEW_DESC MakeD3D12RenderTargetViewDesc(const D3D12_RESOURCE_DESC& resource_desc, DXGI_FORMAT format, UInt mip_slice, UInt array_slice)
+		{
+			D3D12_RENDER_TARGET_VIEW_DESC rtv_desc = {};
+			rtv_desc.Format = format;
+			const Bool is_multisampled = resource_desc.SampleDesc.Count > 1;
+			if (resource_desc.DepthOrArraySize > 1)
+			{
+				if (is_multisampled)
+				{
+					rtv_desc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2DMSARRAY;
+					rtv_desc.Texture2DMSArray.FirstArraySlice = array_slice;
+					rtv_desc.Texture2DMSArray.ArraySize = 1;
+				}
+				else
+				{
+					rtv_desc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2DARRAY;
+					rtv_desc.Texture2DArray.MipSlice = mip_slice;
+					rtv_desc.Texture2DArray.FirstArraySlice = array_slice;
+					rtv_desc.Texture2DArray.ArraySize = 1;
+				}
+			}
+			else if (is_multisampled)
+			{
+				rtv_desc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2DMS;
+			}
+			else
+			{
+				rtv_desc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
+				rtv_desc.Texture2D.MipSlice = mip_slice;
+			}
+			return rtv_desc;
+		}
+
+		D3D12_DEPTH_STENCIL_VIEW_DESC MakeD3D12DepthStencilViewDesc(const D3D12_RESOURCE_DESC& resource_desc, DXGI_FORMAT format, UInt mip_slice, UInt array_slice)
+		{
+			D3D12_DEPTH_STENCIL_VIEW_DESC dsv_desc = {};
+			dsv_desc.Format = format;
+			const Bool is_multisampled = resource_desc.SampleDesc.Count > 1;
+			if (resource_desc.DepthOrArraySize > 1)
+			{
+				if (is_multisampled)
+				{
+					dsv_desc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2DMSARRAY;
+					dsv_desc.Texture2DMSArray.FirstArraySlice = array_slice;
+					dsv_desc.Texture2DMSArray.ArraySize = 1;
+				}
+				else
+				{
+					dsv_desc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2DARRAY;
+					dsv_desc.Texture2DArray.MipSlice = mip_slice;
+					dsv_desc.Texture2DArray.FirstArraySlice = array_slice;
+					dsv_desc.Texture2DArray.ArraySize = 1;
+				}
+			}
+			else if (is_multisampled)
+			{
+				dsv_desc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2DMS;
+			}
+			else
+			{
+				dsv_desc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
+				dsv_desc.Texture2D.MipSlice = mip_slice;
+			}
+			return dsv_desc;
+		}
+
+		bool CreateD3D12ReadbackBuffer(ID3D12Device* device, UINT size, ID3D12Resource** resource)
+		{
+			if (!device || !resource || size == 0)
+			{
+				return false;
+			}
+
+			D3D12_HEAP_PROPERTIES heap_properties = {};
+			heap_properties.Type = D3D12_HEAP_TYPE_READBACK;
+			heap_properties.CreationNodeMask = 1;
+			heap_properties.VisibleNodeMask = 1;
+
+			D3D12_RESOURCE_DESC resource_desc = {};
+			resource_desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+			resource_desc.Width = size;
+			resource_desc.Height = 1;
+			resource_desc.DepthOrArraySize = 1;
+			resource_desc.MipLevels = 1;
+			resource_desc.SampleDesc.Count = 1;
+			resource_desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+			HRESULT hr = device->CreateCommittedResource(
+				&heap_properties,
+				D3D12_HEAP_FLAG_NONE,
+				&resource_desc,
+				D3D12_RESOURCE_STATE_COPY_DEST,
+				nullptr,
+				IID_PPV_ARGS(resource));
+			if (FAILED(hr))
+			{
+				LOG_ERROR("Failed to create D3D12 readback buffer, HRESULT: 0x{0:X}", hr);
+				return false;
+			}
+			return true;
+		}
+
 		bool CreateD3D12UploadBuffer(ID3D12Device* device, UINT size, const void* initial_data, ID3D12Resource** resource)
 		{
 			if (!device || !resource || size == 0)
@@ -297,16 +452,36 @@ namespace Dolas
 		if (m_d3d_device) { m_d3d_device->Release(); m_d3d_device = nullptr; }
 		if (m_swap_chain) { m_swap_chain->Release(); m_swap_chain = nullptr; }
 
-		for (auto& pso_pair : m_d3d12_pipeline_state_cache)
-		{
-			SafeRelease(pso_pair.second);
-		}
-		m_d3d12_pipeline_state_cache.clear();
+		WaitForPipelineStatePrecompile();
+		m_pipeline_state_library.Save();
+		m_pipeline_state_library.Clear();
 		SafeRelease(m_d3d12_root_signature);
 		SafeRelease(m_d3d12_per_frame_parameters_buffer);
 		SafeRelease(m_d3d12_per_view_parameters_buffer);
 		SafeRelease(m_d3d12_per_object_parameters_buffer);
 		SafeRelease(m_d3d12_dummy_constant_buffer);
+		if (m_d3d12_transient_constant_buffer && m_d3d12_transient_constant_data)
+		{
+			m_d3d12_transient_constant_buffer->Unmap(0, nullptr);
+		}
+		m_d3d12_transient_constant_data = nullptr;
+		SafeRelease(m_d3d12_transient_constant_buffer);
+		if (m_d3d12_material_constant_buffer && m_d3d12_material_constant_data)
+		{
+			m_d3d12_material_constant_buffer->Unmap(0, nullptr);
+		}
+		m_d3d12_material_constant_data = nullptr;
+		m_d3d12_material_constant_capacity = 0;
+		SafeRelease(m_d3d12_material_constant_buffer);
+		for (ID3D12Resource*& retired_buffer : m_d3d12_retired_constant_buffers)
+		{
+			SafeRelease(retired_buffer);
+		}
+		m_d3d12_retired_constant_buffers.clear();
+		m_material_constant_arena.Clear();
+		SafeRelease(m_d3d12_timestamp_query_heap);
+		SafeRelease(m_d3d12_pipeline_statistics_query_heap);
+		SafeRelease(m_d3d12_query_readback_buffer);
 	}
 
 	bool DolasRHI::BeginFrame(const float clear_color[4])
@@ -318,6 +493,31 @@ namespace Dolas
 		}
 
 		m_d3d12_frame_started = true;
+		++m_frame_serial;
+		if (m_frame_serial == 1)
+		{
+			// 预编译任务必须在第一次 draw 之前完成，否则仍会在帧内重复编译
+			WaitForPipelineStatePrecompile();
+			m_first_frame_start_time = std::chrono::high_resolution_clock::now();
+		}
+		m_last_frame_statistics = m_frame_statistics;
+		m_frame_statistics = RHIFrameStatistics();
+		ResetD3D12BindingCache();
+		m_gpu_pass_query_names.clear();
+		m_position_only_vertex_input = false;
+
+		// 上一帧已经执行完毕，扩容换下的材质常量缓冲可以释放
+		for (ID3D12Resource*& retired_buffer : m_d3d12_retired_constant_buffers)
+		{
+			SafeRelease(retired_buffer);
+		}
+		m_d3d12_retired_constant_buffers.clear();
+
+		// 上一帧已经执行完毕，上传环从头开始；本帧第一次更新之前根 CBV 指向共享常量缓冲
+		m_d3d12_transient_constant_offset = 0;
+		m_d3d12_per_view_address = m_d3d12_per_view_parameters_buffer ? m_d3d12_per_view_parameters_buffer->GetGPUVirtualAddress() : 0;
+		m_d3d12_per_object_address = m_d3d12_per_object_parameters_buffer ? m_d3d12_per_object_parameters_buffer->GetGPUVirtualAddress() : 0;
+
 		ID3D12DescriptorHeap* descriptor_heaps[] = { rhi->GetSrvHeap() };
 		rhi->GetCommandList()->SetDescriptorHeaps(1, descriptor_heaps);
 		BindD3D12GlobalResources();
@@ -346,10 +546,28 @@ namespace Dolas
 		D3D12_CPU_DESCRIPTOR_HANDLE back_buffer_rtv = rhi->GetCurrentRtvHandle();
 		command_list->OMSetRenderTargets(1, &back_buffer_rtv, FALSE, nullptr);
 		RenderImGuiDrawData();
+		ResolveD3D12GpuPassQueries();
 
 		if (rhi->EndFrame())
 		{
 			m_d3d12_frame_started = false;
+			// EndFrame 等待 GPU 执行完本帧，查询结果已经可读
+			ReadBackD3D12GpuPassQueries();
+		}
+
+		if (m_frame_serial == 1)
+		{
+			const auto first_frame_end_time = std::chrono::high_resolution_clock::now();
+			m_first_frame_milliseconds = std::chrono::duration<Double, std::milli>(first_frame_end_time - m_first_frame_start_time).count();
+			m_first_frame_pipeline_state_milliseconds = m_frame_statistics.pipeline_state_create_milliseconds;
+			const PipelineStateLibraryStatistics library_statistics = m_pipeline_state_library.GetStatistics();
+			LOG_INFO("First frame: {0:.2f} ms, pipeline state creation {1:.2f} ms ({2} compiled in frame, {3} precompiled, {4} precompile failed, {5} from library).",
+				m_first_frame_milliseconds,
+				m_first_frame_pipeline_state_milliseconds,
+				m_frame_statistics.pipeline_state_compiles,
+				library_statistics.precompiled,
+				library_statistics.precompile_failed,
+				library_statistics.library_hits);
 		}
 	}
 
@@ -544,7 +762,7 @@ namespace Dolas
 
 	std::shared_ptr<RenderTargetView> DolasRHI::GetBackBufferRTV() const { return m_back_buffer_render_target_view; }
 
-	std::shared_ptr<DepthStencilView> DolasRHI::CreateDepthStencilView(TextureID texture_id)
+	std::shared_ptr<DepthStencilView> DolasRHI::CreateDepthStencilView(TextureID texture_id, DXGI_FORMAT format /*= DXGI_FORMAT_UNKNOWN*/, UInt mip_slice /*= 0*/, UInt array_slice /*= 0*/)
 	{
 		TextureManager* texture_manager = g_dolas_engine.m_texture_manager;
 		DOLAS_RETURN_NULL_IF_NULL(texture_manager);
@@ -552,9 +770,37 @@ namespace Dolas
 		Texture* texture = texture_manager->GetTextureByTextureID(texture_id);
 		DOLAS_RETURN_NULL_IF_NULL(texture);
 
-		std::shared_ptr<DepthStencilView> depth_stencil_view = std::make_shared<DepthStencilView>();
+		const ULongLong view_key = Texture::MakeViewKey(static_cast<UInt>(format), mip_slice, array_slice);
+		std::shared_ptr<DepthStencilView> depth_stencil_view = texture->FindDepthStencilView(view_key);
+		if (depth_stencil_view)
+		{
+			++m_frame_statistics.view_cache_hits;
+			return depth_stencil_view;
+		}
+
+		++m_frame_statistics.view_creations;
+		depth_stencil_view = std::make_shared<DepthStencilView>();
 		depth_stencil_view->m_texture_id = texture_id;
-		depth_stencil_view->m_d3d12_depth_stencil_view = texture->GetD3D12DsvHandle();
+
+		const Bool is_default_view = format == DXGI_FORMAT_UNKNOWN && mip_slice == 0 && array_slice == 0;
+		ID3D12Resource* d3d12_resource = texture->GetD3D12Resource();
+		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+		if (is_default_view)
+		{
+			depth_stencil_view->m_d3d12_depth_stencil_view = texture->GetD3D12DsvHandle();
+		}
+		else if (rhi && rhi->GetDevice() && d3d12_resource)
+		{
+			const D3D12_RESOURCE_DESC resource_desc = d3d12_resource->GetDesc();
+			const DXGI_FORMAT view_format = ConvertToDepthStencilViewFormat(format == DXGI_FORMAT_UNKNOWN ? resource_desc.Format : format);
+			D3D12_CPU_DESCRIPTOR_HANDLE dsv_handle = {};
+			if (rhi->AllocateDsvDescriptor(&dsv_handle))
+			{
+				const D3D12_DEPTH_STENCIL_VIEW_DESC dsv_desc = MakeD3D12DepthStencilViewDesc(resource_desc, view_format, mip_slice, array_slice);
+				rhi->GetDevice()->CreateDepthStencilView(d3d12_resource, &dsv_desc, dsv_handle);
+				depth_stencil_view->m_d3d12_depth_stencil_view = dsv_handle;
+			}
+		}
 
 		ID3D11Texture2D* d3d_texture_2d = texture->GetD3DTexture2D();
 		if (m_d3d_device && d3d_texture_2d)
@@ -562,26 +808,24 @@ namespace Dolas
 			D3D11_TEXTURE2D_DESC texture_desc = {};
 			d3d_texture_2d->GetDesc(&texture_desc);
 
-			DXGI_FORMAT dsv_format = texture_desc.Format;
-			switch (texture_desc.Format)
+			D3D11_DEPTH_STENCIL_VIEW_DESC dsv_desc = {};
+			dsv_desc.Format = ConvertToDepthStencilViewFormat(format == DXGI_FORMAT_UNKNOWN ? texture_desc.Format : format);
+			if (texture_desc.ArraySize > 1)
 			{
-			case DXGI_FORMAT_R24G8_TYPELESS:
-				dsv_format = DXGI_FORMAT_D24_UNORM_S8_UINT;
-				break;
-			case DXGI_FORMAT_R32_TYPELESS:
-				dsv_format = DXGI_FORMAT_D32_FLOAT;
-				break;
-			default:
-				break;
+				dsv_desc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2DARRAY;
+				dsv_desc.Texture2DArray.MipSlice = mip_slice;
+				dsv_desc.Texture2DArray.FirstArraySlice = array_slice;
+				dsv_desc.Texture2DArray.ArraySize = 1;
 			}
-
-			D3D11_DEPTH_STENCIL_VIEW_DESC dsv_desc = {};
-			dsv_desc.Format = dsv_format;
-			dsv_desc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
-			dsv_desc.Texture2D.MipSlice = 0;
-			HR(g_dolas_engine.m_rhi->m_d3d_device->CreateDepthStencilView(d3d_texture_2d, &dsv_desc, &depth_stencil_view->m_d3d_depth_stencil_view));
+			else
+			{
+				dsv_desc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
+				dsv_desc.Texture2D.MipSlice = mip_slice;
+			}
+			HR(m_d3d_device->CreateDepthStencilView(d3d_texture_2d, &dsv_desc, &depth_stencil_view->m_d3d_depth_stencil_view));
 		}
 
+		texture->AddDepthStencilView(view_key, depth_stencil_view);
 		return depth_stencil_view;
 	}
 
@@ -723,31 +967,56 @@ namespace Dolas
         m_d3d_immediate_context->OMSetBlendState(blend_state.m_d3d_blend_state, nullptr, 0xFFFFFFFF);
     }
 
+	void DolasRHI::SetPositionOnlyVertexInput(Bool enabled)
+	{
+		if (m_position_only_vertex_input == enabled)
+		{
+			return;
+		}
+		m_position_only_vertex_input = enabled;
+		// 同一个 RenderPrimitive 在两种模式下绑定的顶点流不同，下一次 draw 必须重新设置
+		m_d3d12_binding_cache.render_primitive_id = RENDER_PRIMITIVE_ID_EMPTY;
+	}
+
 	Bool DolasRHI::BindVertexContext(std::shared_ptr<VertexContext> vertex_context, ID3D11ClassInstance* const* class_instances/* = nullptr*/, UINT num_class_instances/* = 0*/)
+	{
+		return BindVertexContext(vertex_context, ConstantBufferArena::INVALID_BLOCK, class_instances, num_class_instances);
+	}
+
+	Bool DolasRHI::BindVertexContext(std::shared_ptr<VertexContext> vertex_context, UInt material_block, ID3D11ClassInstance* const* class_instances, UINT num_class_instances)
 	{
 		DOLAS_RETURN_FALSE_IF_NULL(vertex_context);
 		m_current_vertex_context = vertex_context;
 
+		const D3D12_GPU_VIRTUAL_ADDRESS material_address = GetMaterialParameterBlockAddress(material_block);
+		if (material_address == 0 || GetD3D11MirrorDrawContext())
+		{
+			// D3D11 兼容设备没有常量 arena，材质参数块拷贝到 context 的常量缓冲后上传（没有变化时跳过）
+			if (m_material_constant_arena.IsValidBlock(material_block))
+			{
+				vertex_context->SetGlobalConstants(m_material_constant_arena.GetBlockData(material_block), m_material_constant_arena.GetBlockSize(material_block));
+			}
+			UploadGlobalConstants(vertex_context.get());
+		}
+
 		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
 		ID3D12GraphicsCommandList* command_list = rhi ? rhi->GetCommandList() : nullptr;
 		if (command_list && m_d3d12_root_signature)
 		{
-			command_list->SetGraphicsRootSignature(m_d3d12_root_signature);
 			BindD3D12GlobalResources();
-			ID3D12Resource* global_constant_buffer = vertex_context->GetD3D12GlobalConstantBuffer();
-			if (!global_constant_buffer)
+			if (material_address != 0)
 			{
-				global_constant_buffer = m_d3d12_dummy_constant_buffer;
+				SetD3D12GlobalConstantBuffer(kRootVSGlobalCBV, material_address, m_d3d12_binding_cache.vs_global_constant_buffer);
 			}
-			if (global_constant_buffer)
+			else
 			{
-				command_list->SetGraphicsRootConstantBufferView(kRootVSGlobalCBV, global_constant_buffer->GetGPUVirtualAddress());
+				SetD3D12GlobalConstantBuffer(kRootVSGlobalCBV, vertex_context->GetD3D12GlobalConstantBuffer(), m_d3d12_binding_cache.vs_global_constant_buffer);
 			}
 			vertex_context->ConvertTextureIDMapToSRVMap();
 			BindD3D12SrvTable(vertex_context, false);
 		}
 
-		if (!m_d3d_immediate_context)
+		if (!GetD3D11MirrorDrawContext())
 		{
 			m_current_vs_bytecode = vertex_context->GetShaderBytecode();
 			return true;
@@ -778,16 +1047,6 @@ namespace Dolas
             m_d3d_immediate_context->VSSetConstantBuffers(D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT - 1, 1, &global_constant_buffer);
         }
 
-		// Update Constant Buffer Data（将 ShaderContext 中预打包好的全局常量拷贝到 GPU CB）
-		const std::vector<uint8_t>& cb_data = vertex_context->GetGlobalConstantBufferData();
-		if (global_constant_buffer && !cb_data.empty())
-		{
-			D3D11_MAPPED_SUBRESOURCE mappedData;
-			HR(m_d3d_immediate_context->Map(global_constant_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedData));
-			memcpy_s(mappedData.pData, cb_data.size(), cb_data.data(), cb_data.size());
-			m_d3d_immediate_context->Unmap(global_constant_buffer, 0);
-		}
-
 		/* 5. Cache VS bytecode for InputLayout creating later */
 		m_current_vs_bytecode = vertex_context->GetShaderBytecode();
 
@@ -796,30 +1055,43 @@ namespace Dolas
 
 	// PixelContext
 	Bool DolasRHI::BindPixelContext(std::shared_ptr<PixelContext> pixel_context, ID3D11ClassInstance* const* class_instances/* = nullptr*/, UINT num_class_instances/* = 0*/)
+	{
+		return BindPixelContext(pixel_context, ConstantBufferArena::INVALID_BLOCK, class_instances, num_class_instances);
+	}
+
+	Bool DolasRHI::BindPixelContext(std::shared_ptr<PixelContext> pixel_context, UInt material_block, ID3D11ClassInstance* const* class_instances, UINT num_class_instances)
 	{
 		DOLAS_RETURN_FALSE_IF_NULL(pixel_context);
 		m_current_pixel_context = pixel_context;
 
+		const D3D12_GPU_VIRTUAL_ADDRESS material_address = GetMaterialParameterBlockAddress(material_block);
+		if (material_address == 0 || GetD3D11MirrorDrawContext())
+		{
+			if (m_material_constant_arena.IsValidBlock(material_block))
+			{
+				pixel_context->SetGlobalConstants(m_material_constant_arena.GetBlockData(material_block), m_material_constant_arena.GetBlockSize(material_block));
+			}
+			UploadGlobalConstants(pixel_context.get());
+		}
+
 		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
 		ID3D12GraphicsCommandList* command_list = rhi ? rhi->GetCommandList() : nullptr;
 		if (command_list && m_d3d12_root_signature)
 		{
-			command_list->SetGraphicsRootSignature(m_d3d12_root_signature);
 			BindD3D12GlobalResources();
-			ID3D12Resource* global_constant_buffer = pixel_context->GetD3D12GlobalConstantBuffer();
-			if (!global_constant_buffer)
+			if (material_address != 0)
 			{
-				global_constant_buffer = m_d3d12_dummy_constant_buffer;
+				SetD3D12GlobalConstantBuffer(kRootPSGlobalCBV, material_address, m_d3d12_binding_cache.ps_global_constant_buffer);
 			}
-			if (global_constant_buffer)
+			else
 			{
-				command_list->SetGraphicsRootConstantBufferView(kRootPSGlobalCBV, global_constant_buffer->GetGPUVirtualAddress());
+				SetD3D12GlobalConstantBuffer(kRootPSGlobalCBV, pixel_context->GetD3D12GlobalConstantBuffer(), m_d3d12_binding_cache.ps_global_constant_buffer);
 			}
 			pixel_context->ConvertTextureIDMapToSRVMap();
 			BindD3D12SrvTable(pixel_context, true);
 		}
 
-		if (!m_d3d_immediate_context)
+		if (!GetD3D11MirrorDrawContext())
 		{
 			return true;
 		}
@@ -848,23 +1120,129 @@ namespace Dolas
         {
             m_d3d_immediate_context->PSSetConstantBuffers(D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT - 1, 1, &global_constant_buffer);
         }
-		// Update Constant Buffer Data（将 ShaderContext 中预打包好的全局常量拷贝到 GPU CB）
-		const std::vector<uint8_t>& cb_data = pixel_context->GetGlobalConstantBufferData();
-		if (global_constant_buffer && !cb_data.empty())
+
+		return true;
+	}
+
+	UInt DolasRHI::AllocateMaterialParameterBlock(UInt size)
+	{
+		return m_material_constant_arena.Allocate(size);
+	}
+
+	Bool DolasRHI::WriteMaterialParameters(UInt block, ConstantBufferVariableHandle handle, const void* data, std::size_t size)
+	{
+		return m_material_constant_arena.Write(block, handle, data, size);
+	}
+
+	Bool DolasRHI::BindMaterial(Material* material)
+	{
+		DOLAS_RETURN_FALSE_IF_NULL(material);
+		std::shared_ptr<VertexContext> vertex_context = material->GetVertexContext();
+		std::shared_ptr<PixelContext> pixel_context = material->GetPixelContext();
+		DOLAS_RETURN_FALSE_IF_NULL(vertex_context);
+		DOLAS_RETURN_FALSE_IF_NULL(pixel_context);
+
+		// 通常只有加载 / 编辑材质之后的第一次绑定有脏数据
+		FlushMaterialConstants();
+		++m_frame_statistics.material_binds;
+		return BindVertexContext(vertex_context, material->GetVertexParameterBlock(), nullptr, 0) &&
+			BindPixelContext(pixel_context, material->GetPixelParameterBlock(), nullptr, 0);
+	}
+
+	D3D12_GPU_VIRTUAL_ADDRESS DolasRHI::GetMaterialParameterBlockAddress(UInt block) const
+	{
+		if (!m_d3d12_material_constant_data || !m_material_constant_arena.IsValidBlock(block) ||
+			m_material_constant_arena.GetBlockOffset(block) + m_material_constant_arena.GetBlockSize(block) > m_d3d12_material_constant_capacity)
 		{
-			D3D11_MAPPED_SUBRESOURCE mappedData;
-			HR(m_d3d_immediate_context->Map(global_constant_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedData));
-			memcpy_s(mappedData.pData, cb_data.size(), cb_data.data(), cb_data.size());
-			m_d3d_immediate_context->Unmap(global_constant_buffer, 0);
+			return 0;
+		}
+		return m_d3d12_material_constant_buffer->GetGPUVirtualAddress() + m_material_constant_arena.GetBlockOffset(block);
+	}
+
+	void DolasRHI::FlushMaterialConstants()
+	{
+		if (!m_material_constant_arena.IsDirty() || !EnsureD3D12MaterialConstantCapacity())
+		{
+			return;
+		}
+
+		m_material_constant_arena.TakeDirtyRanges(m_material_constant_dirty_ranges);
+		const std::vector<UByte>& bytes = m_material_constant_arena.GetBytes();
+		for (const ConstantBufferRange& range : m_material_constant_dirty_ranges)
+		{
+			memcpy(m_d3d12_material_constant_data + range.begin, bytes.data() + range.begin, range.end - range.begin);
+			m_frame_statistics.material_constant_bytes += range.end - range.begin;
+			++m_frame_statistics.material_constant_uploads;
+		}
+	}
+
+	Bool DolasRHI::EnsureD3D12MaterialConstantCapacity()
+	{
+		const UInt required_size = m_material_constant_arena.GetSize();
+		if (required_size <= m_d3d12_material_constant_capacity)
+		{
+			return m_d3d12_material_constant_data != nullptr;
+		}
+
+		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+		ID3D12Device* device = rhi ? rhi->GetDevice() : nullptr;
+		DOLAS_RETURN_FALSE_IF_NULL(device);
+
+		UInt capacity = (std::max)(m_d3d12_material_constant_capacity, kD3D12MaterialConstantBufferMinCapacity);
+		while (capacity < required_size)
+		{
+			capacity *= 2;
+		}
+
+		ID3D12Resource* constant_buffer = nullptr;
+		void* mapped_data = nullptr;
+		D3D12_RANGE read_range = { 0, 0 };
+		if (!CreateD3D12UploadBuffer(device, capacity, nullptr, &constant_buffer) ||
+			FAILED(constant_buffer->Map(0, &read_range, &mapped_data)))
+		{
+			SafeRelease(constant_buffer);
+			LOG_ERROR("Failed to create D3D12 material constant buffer ({0} bytes), materials fall back to shared shader constants.", capacity);
+			return false;
+		}
+
+		// 本帧已录制的 draw 可能还引用旧缓冲区，等到下一帧开始再释放
+		if (m_d3d12_material_constant_buffer)
+		{
+			m_d3d12_material_constant_buffer->Unmap(0, nullptr);
+			m_d3d12_retired_constant_buffers.push_back(m_d3d12_material_constant_buffer);
 		}
+		m_d3d12_material_constant_buffer = constant_buffer;
+		m_d3d12_material_constant_data = static_cast<UByte*>(mapped_data);
+		m_d3d12_material_constant_capacity = capacity;
 
+		// 新缓冲区需要完整的数据，脏区间随之作废
+		const std::vector<UByte>& bytes = m_material_constant_arena.GetBytes();
+		memcpy(m_d3d12_material_constant_data, bytes.data(), bytes.size());
+		m_material_constant_arena.TakeDirtyRanges(m_material_constant_dirty_ranges);
+		m_frame_statistics.material_constant_bytes += bytes.size();
+		++m_frame_statistics.material_constant_uploads;
 		return true;
 	}
 
+	void DolasRHI::UploadGlobalConstants(ShaderContext* shader_context)
+	{
+		// GlobalConstants 的写入只改 CPU 端数据，这里只上传自上次绑定以来改动过的区间
+		const UInt uploaded_bytes = shader_context->UploadGlobalConstants(GetD3D11MirrorDrawContext());
+		if (uploaded_bytes > 0)
+		{
+			m_frame_statistics.global_constant_bytes += uploaded_bytes;
+			++m_frame_statistics.global_constant_uploads;
+		}
+		else if (!shader_context->GetGlobalConstantBufferData().empty())
+		{
+			++m_frame_statistics.global_constant_skipped_uploads;
+		}
+	}
+
 	void DolasRHI::SetPrimitiveTopology(PrimitiveTopology primitive_topology)
 	{
 		m_current_primitive_topology = primitive_topology;
-		if (m_d3d_immediate_context)
+		if (GetD3D11MirrorDrawContext())
 		{
 			m_d3d_immediate_context->IASetPrimitiveTopology(m_d3d11_state_cache->primitive_topology[static_cast<UInt>(primitive_topology)]);
 		}
@@ -879,8 +1257,13 @@ namespace Dolas
 
 	void DolasRHI::SetInputLayout(InputLayoutType input_layout_type, const void* vs_blob, size_t bytecode_length)
 	{
-		if (!m_d3d_immediate_context)
+		if (!GetD3D11MirrorDrawContext())
+		{
+			return;
+		}
+		if (input_layout_type == InputLayoutType_NONE)
 		{
+			m_d3d_immediate_context->IASetInputLayout(nullptr);
 			return;
 		}
 		std::shared_ptr<InputLayout> input_layout = CreateInputLayout(input_layout_type, vs_blob, bytecode_length);
@@ -914,7 +1297,7 @@ namespace Dolas
 			}
 		}
 
-		if (!m_d3d_immediate_context)
+		if (!GetD3D11MirrorDrawContext())
 		{
 			return;
 		}
@@ -946,77 +1329,182 @@ namespace Dolas
 			command_list->IASetIndexBuffer(&index_view);
 		}
 
-		if (m_d3d_immediate_context)
+		if (GetD3D11MirrorDrawContext())
 		{
 			m_d3d_immediate_context->IASetIndexBuffer(buffer->GetBuffer(), DXGI_FORMAT_R32_UINT, 0);
 		}
 	}
 
-	void DolasRHI::DrawIndexed(UInt index_count)
+	void DolasRHI::DrawIndexed(UInt index_count, UInt start_index_location /*= 0*/)
 	{
 		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
 		ID3D12GraphicsCommandList* command_list = rhi ? rhi->GetCommandList() : nullptr;
 		if (command_list)
 		{
-			command_list->DrawIndexedInstanced(index_count, 1, 0, 0, 0);
+			command_list->DrawIndexedInstanced(index_count, 1, start_index_location, 0, 0);
+			++m_frame_statistics.draw_calls;
 		}
 
-		if (m_d3d_immediate_context)
+		if (GetD3D11MirrorDrawContext())
 		{
-			m_d3d_immediate_context->DrawIndexed(index_count, 0, 0);
+			m_d3d_immediate_context->DrawIndexed(index_count, start_index_location, 0);
 		}
 	}
 
-	void DolasRHI::DrawRenderPrimitive(RenderPrimitiveID render_primitive_id)
+	void DolasRHI::DrawRenderPrimitive(RenderPrimitiveID render_primitive_id, UInt lod_index /*= 0*/)
 	{
 		RenderPrimitive* render_primitive = g_dolas_engine.m_render_primitive_manager->GetRenderPrimitiveByID(render_primitive_id);
 		DOLAS_RETURN_IF_NULL(render_primitive);
 
-		if (!m_current_vs_bytecode.IsValid())
+		if (!BindRenderPrimitive(render_primitive_id, render_primitive, render_primitive->m_index_buffer_id))
 		{
 			return;
 		}
 
-		SetInputLayout(render_primitive->m_input_layout_type, m_current_vs_bytecode.data, m_current_vs_bytecode.size);
+		// 所有 LOD 共用顶点 / 索引缓冲，只是索引区间不同，切换 LOD 不产生额外绑定
+		if (lod_index < render_primitive->GetLODCount())
+		{
+			const RenderPrimitiveLOD& lod = render_primitive->m_lods[lod_index];
+			m_frame_statistics.triangles += render_primitive->GetTriangleCount(lod_index);
+			DrawIndexed(lod.m_index_count, lod.m_index_offset);
+		}
+		else
+		{
+			m_frame_statistics.triangles += render_primitive->GetTriangleCount();
+			DrawIndexed(render_primitive->m_index_count);
+		}
+	}
 
-		SetPrimitiveTopology(render_primitive->m_topology);
+	void DolasRHI::DrawRenderPrimitiveIndexRange(RenderPrimitiveID render_primitive_id, BufferID index_buffer_id, UInt start_index_location, UInt index_count)
+	{
+		RenderPrimitive* render_primitive = g_dolas_engine.m_render_primitive_manager->GetRenderPrimitiveByID(render_primitive_id);
+		DOLAS_RETURN_IF_NULL(render_primitive);
 
-		SetVertexBuffers(render_primitive->m_vertex_buffer_ids, render_primitive->m_vertex_strides, render_primitive->m_vertex_offsets);
+		if (index_count == 0 || !BindRenderPrimitive(render_primitive_id, render_primitive, index_buffer_id))
+		{
+			return;
+		}
 
-		SetIndexBuffer(render_primitive->m_index_buffer_id);
+		m_frame_statistics.triangles += index_count / 3;
+		DrawIndexed(index_count, start_index_location);
+	}
 
-		if (ID3D12PipelineState* pso = GetOrCreateD3D12PipelineState(render_primitive))
+	Bool DolasRHI::BindRenderPrimitive(RenderPrimitiveID render_primitive_id, RenderPrimitive* render_primitive, BufferID index_buffer_id)
+	{
+		if (!m_current_vs_bytecode.IsValid())
 		{
-			RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
-			ID3D12GraphicsCommandList* command_list = rhi ? rhi->GetCommandList() : nullptr;
-			if (command_list)
+			return false;
+		}
+
+		SetInputLayout(GetCurrentInputLayoutType(render_primitive), m_current_vs_bytecode.data, m_current_vs_bytecode.size);
+
+		// 相邻 draw 使用同一个 RenderPrimitive 时，拓扑 / VB 都无需重新设置；
+		// IB 单独比较，cluster 剔除后多个 RenderPrimitive 共用同一个压缩索引缓冲
+		const Bool geometry_changed = m_d3d12_binding_cache.render_primitive_id != render_primitive_id;
+		const Bool index_buffer_changed = m_d3d12_binding_cache.index_buffer_id != index_buffer_id;
+		m_frame_statistics.primitive_topology.Record(geometry_changed);
+		m_frame_statistics.vertex_buffer.Record(geometry_changed);
+		m_frame_statistics.index_buffer.Record(index_buffer_changed);
+		if (geometry_changed)
+		{
+			SetPrimitiveTopology(render_primitive->m_topology);
+
+			if (m_position_only_vertex_input && !render_primitive->m_vertex_buffer_ids.empty())
 			{
-				command_list->SetPipelineState(pso);
+				const std::vector<BufferID> position_buffer_ids(1, render_primitive->m_vertex_buffer_ids[0]);
+				const std::vector<UInt> position_strides(render_primitive->m_vertex_strides.begin(), render_primitive->m_vertex_strides.begin() + std::min<std::size_t>(render_primitive->m_vertex_strides.size(), 1));
+				const std::vector<UInt> position_offsets(render_primitive->m_vertex_offsets.begin(), render_primitive->m_vertex_offsets.begin() + std::min<std::size_t>(render_primitive->m_vertex_offsets.size(), 1));
+				SetVertexBuffers(position_buffer_ids, position_strides, position_offsets);
+			}
+			else
+			{
+				SetVertexBuffers(render_primitive->m_vertex_buffer_ids, render_primitive->m_vertex_strides, render_primitive->m_vertex_offsets);
 			}
+
+			m_d3d12_binding_cache.render_primitive_id = render_primitive_id;
+		}
+		if (index_buffer_changed)
+		{
+			SetIndexBuffer(index_buffer_id);
+
+			m_d3d12_binding_cache.index_buffer_id = index_buffer_id;
 		}
 
-		DrawIndexed(render_primitive->m_index_count);
+		BindD3D12PipelineState(GetCurrentInputLayoutType(render_primitive));
+		return true;
 	}
 
-	void DolasRHI::VSSetConstantBuffers()
+	void DolasRHI::BindD3D12PipelineState(InputLayoutType input_layout_type)
 	{
-		if (m_d3d_immediate_context)
+		if (ID3D12PipelineState* pso = GetOrCreateD3D12PipelineState(input_layout_type))
 		{
-			m_d3d_immediate_context->VSSetConstantBuffers(0, 1, &m_d3d_per_view_parameters_buffer);
-			m_d3d_immediate_context->VSSetConstantBuffers(1, 1, &m_d3d_per_frame_parameters_buffer);
-			m_d3d_immediate_context->VSSetConstantBuffers(2, 1, &m_d3d_per_object_parameters_buffer);
+			RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+			ID3D12GraphicsCommandList* command_list = rhi ? rhi->GetCommandList() : nullptr;
+			const Bool pso_changed = pso != m_d3d12_binding_cache.pipeline_state;
+			m_frame_statistics.pipeline_state.Record(pso_changed);
+			if (command_list && pso_changed)
+			{
+				command_list->SetPipelineState(pso);
+				m_d3d12_binding_cache.pipeline_state = pso;
+			}
 		}
 	}
 
-	void DolasRHI::PSSetConstantBuffers()
+	void DolasRHI::DrawFullScreenTriangle()
 	{
-		if (m_d3d_immediate_context)
+		if (!m_current_vs_bytecode.IsValid())
 		{
-			m_d3d_immediate_context->PSSetConstantBuffers(0, 1, &m_d3d_per_view_parameters_buffer);
-			m_d3d_immediate_context->PSSetConstantBuffers(1, 1, &m_d3d_per_frame_parameters_buffer);
-			m_d3d_immediate_context->PSSetConstantBuffers(2, 1, &m_d3d_per_object_parameters_buffer);
+			return;
 		}
-	}
+
+		SetInputLayout(InputLayoutType_NONE, m_current_vs_bytecode.data, m_current_vs_bytecode.size);
+
+		// 之前绑定的 VB / IB 不会被读取，保持不动；清空缓存的 RenderPrimitive，下一次 DrawRenderPrimitive 重新设置拓扑与 VB
+		const Bool topology_changed = m_current_primitive_topology != PrimitiveTopology_TriangleList ||
+			m_d3d12_binding_cache.render_primitive_id != RENDER_PRIMITIVE_ID_EMPTY;
+		m_frame_statistics.primitive_topology.Record(topology_changed);
+		if (topology_changed)
+		{
+			SetPrimitiveTopology(PrimitiveTopology_TriangleList);
+			m_d3d12_binding_cache.render_primitive_id = RENDER_PRIMITIVE_ID_EMPTY;
+		}
+
+		BindD3D12PipelineState(InputLayoutType_NONE);
+
+		m_frame_statistics.triangles += 1;
+		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+		ID3D12GraphicsCommandList* command_list = rhi ? rhi->GetCommandList() : nullptr;
+		if (command_list)
+		{
+			command_list->DrawInstanced(3, 1, 0, 0);
+			++m_frame_statistics.draw_calls;
+		}
+
+		if (GetD3D11MirrorDrawContext())
+		{
+			m_d3d_immediate_context->Draw(3, 0);
+		}
+	}
+
+	void DolasRHI::VSSetConstantBuffers()
+	{
+		if (GetD3D11MirrorDrawContext())
+		{
+			m_d3d_immediate_context->VSSetConstantBuffers(0, 1, &m_d3d_per_view_parameters_buffer);
+			m_d3d_immediate_context->VSSetConstantBuffers(1, 1, &m_d3d_per_frame_parameters_buffer);
+			m_d3d_immediate_context->VSSetConstantBuffers(2, 1, &m_d3d_per_object_parameters_buffer);
+		}
+	}
+
+	void DolasRHI::PSSetConstantBuffers()
+	{
+		if (GetD3D11MirrorDrawContext())
+		{
+			m_d3d_immediate_context->PSSetConstantBuffers(0, 1, &m_d3d_per_view_parameters_buffer);
+			m_d3d_immediate_context->PSSetConstantBuffers(1, 1, &m_d3d_per_frame_parameters_buffer);
+			m_d3d_immediate_context->PSSetConstantBuffers(2, 1, &m_d3d_per_object_parameters_buffer);
+		}
+	}
 
 	ID3D11ShaderResourceView* DolasRHI::CreateShaderResourceView(ID3D11Resource* resource)
 	{
@@ -1033,7 +1521,7 @@ namespace Dolas
 	void DolasRHI::UpdatePerFrameParameters()
 	{
 		PerFrameConstantBuffer per_frame_constant_buffer;
-		per_frame_constant_buffer.light_direction_intensity = Vector4(-1.0f, 1.0f, -1.0f, 1.0f);
+		per_frame_constant_buffer.light_direction_intensity = m_main_light_direction_intensity;
 		per_frame_constant_buffer.light_color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
 
 		if (m_d3d_immediate_context && m_d3d_per_frame_parameters_buffer)
@@ -1048,11 +1536,18 @@ namespace Dolas
 	}
 
 	void DolasRHI::UpdatePerViewParameters(RenderCamera* render_camera)
+	{
+		DOLAS_RETURN_IF_NULL(render_camera);
+		UpdatePerViewParameters(render_camera->GetViewMatrix(), render_camera->GetProjectionMatrix(), render_camera->GetPosition());
+	}
+
+	void DolasRHI::UpdatePerViewParameters(const Matrix4x4& view, const Matrix4x4& projection, const Vector3& view_position)
 	{
 		PerViewConstantBuffer per_view_constant_buffer;
-		per_view_constant_buffer.view = render_camera->GetViewMatrix();
-		per_view_constant_buffer.proj = render_camera->GetProjectionMatrix();
-		per_view_constant_buffer.camera_position = Vector4(render_camera->GetPosition(), 1.0f);
+		per_view_constant_buffer.view = view;
+		per_view_constant_buffer.proj = projection;
+		per_view_constant_buffer.camera_position = Vector4(view_position, 1.0f);
+		per_view_constant_buffer.inverse_view_proj = (projection * view).GetInverse();
 
 		if (m_d3d_immediate_context && m_d3d_per_view_parameters_buffer)
 		{
@@ -1061,7 +1556,8 @@ namespace Dolas
 			memcpy_s(mappedData.pData, sizeof(per_view_constant_buffer), &per_view_constant_buffer, sizeof(per_view_constant_buffer));
 			m_d3d_immediate_context->Unmap(m_d3d_per_view_parameters_buffer, 0);
 		}
-		UpdateD3D12UploadBuffer(m_d3d12_per_view_parameters_buffer, &per_view_constant_buffer, sizeof(per_view_constant_buffer));
+		const D3D12_GPU_VIRTUAL_ADDRESS address = WriteD3D12TransientConstants(m_d3d12_per_view_parameters_buffer, &per_view_constant_buffer, sizeof(per_view_constant_buffer));
+		SetD3D12RootConstantBufferView(kRootPerViewCBV, address, m_d3d12_per_view_address);
 	}
 
 	void DolasRHI::UpdatePerObjectParameters(Pose pose)
@@ -1069,56 +1565,7 @@ namespace Dolas
 		PerObjectConstantBuffer per_object_constant_buffer;
 
 		// 从 Pose 构建世界矩阵
-		// 世界矩阵 = 缩放矩阵 * 旋转矩阵 * 平移矩阵
-
-		// 提取 Pose 数据
-		Vector3 position = pose.m_postion;  // 注意：原始代码中拼写是 m_postion
-		Quaternion quat = pose.m_rotation;     // 四元数 (x, y, z, w)
-		Vector3 scale = pose.m_scale;
-
-		// 归一化四元数（确保是单位四元数）
-		Float quat_length = sqrt(quat.x * quat.x + quat.y * quat.y + quat.z * quat.z + quat.w * quat.w);
-		if (quat_length > 0.0001f)
-		{
-			quat.x /= quat_length;
-			quat.y /= quat_length;
-			quat.z /= quat_length;
-			quat.w /= quat_length;
-		}
-
-		// 从四元数构建旋转矩阵
-		Float xx = quat.x * quat.x;
-		Float yy = quat.y * quat.y;
-		Float zz = quat.z * quat.z;
-		Float xy = quat.x * quat.y;
-		Float xz = quat.x * quat.z;
-		Float yz = quat.y * quat.z;
-		Float wx = quat.w * quat.x;
-		Float wy = quat.w * quat.y;
-		Float wz = quat.w * quat.z;
-
-		Matrix4x4 ratation_mat{
-			1.0f - 2.0f * (yy + zz),     2.0f * (xy - wz),         2.0f * (xz + wy),         0.0f,
-			2.0f * (xy + wz),           1.0f - 2.0f * (xx + zz),   2.0f * (yz - wx),       0.0f,
-			2.0f * (xz - wy),           2.0f * (yz + wx),         1.0f - 2.0f * (xx + yy), 0.0f ,
-			0.0f,                       0.0f,                     0.0f,                     1.0f
-		};
-
-		Matrix4x4 scale_mat{
-			scale.x, 0.0f,     0.0f,     0.0f,
-			0.0f,     scale.y, 0.0f,     0.0f,
-			0.0f,     0.0f,     scale.z, 0.0f,
-			0.0f,     0.0f,     0.0f,     1.0f
-		};
-
-		Matrix4x4 trans_mat{
-			1.0f, 0.0f, 0.0f, position.x,
-			0.0f, 1.0f, 0.0f, position.y,
-			0.0f, 0.0f, 1.0f, position.z,
-			0.0f, 0.0f, 0.0f, 1.0f
-		};
-
-		per_object_constant_buffer.world = trans_mat * ratation_mat * scale_mat;
+		per_object_constant_buffer.world = pose.ToMatrix();
 
 		if (m_d3d_immediate_context && m_d3d_per_object_parameters_buffer)
 		{
@@ -1128,7 +1575,8 @@ namespace Dolas
 			memcpy_s(mappedData.pData, sizeof(per_object_constant_buffer), &per_object_constant_buffer, sizeof(per_object_constant_buffer));
 			m_d3d_immediate_context->Unmap(m_d3d_per_object_parameters_buffer, 0);
 		}
-		UpdateD3D12UploadBuffer(m_d3d12_per_object_parameters_buffer, &per_object_constant_buffer, sizeof(per_object_constant_buffer));
+		const D3D12_GPU_VIRTUAL_ADDRESS address = WriteD3D12TransientConstants(m_d3d12_per_object_parameters_buffer, &per_object_constant_buffer, sizeof(per_object_constant_buffer));
+		SetD3D12RootConstantBufferView(kRootPerObjectCBV, address, m_d3d12_per_object_address);
 	}
 
 	bool DolasRHI::InitializeD3D11CompatibilityDevice()
@@ -1226,6 +1674,25 @@ namespace Dolas
 			return false;
 		}
 
+		// 上传环创建失败时仍可运行，所有更新退回到上面的共享常量缓冲
+		if (CreateD3D12UploadBuffer(device, kD3D12TransientConstantBufferSize, nullptr, &m_d3d12_transient_constant_buffer))
+		{
+			D3D12_RANGE read_range = { 0, 0 };
+			void* mapped_data = nullptr;
+			if (SUCCEEDED(m_d3d12_transient_constant_buffer->Map(0, &read_range, &mapped_data)))
+			{
+				m_d3d12_transient_constant_data = static_cast<UByte*>(mapped_data);
+			}
+			else
+			{
+				SafeRelease(m_d3d12_transient_constant_buffer);
+			}
+		}
+		if (!m_d3d12_transient_constant_data)
+		{
+			LOG_WARN("Failed to create D3D12 transient constant buffer, per-object constants will be shared within a frame.");
+		}
+
 		D3D12_DESCRIPTOR_RANGE srv_ranges[2] = {};
 		srv_ranges[0].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
 		srv_ranges[0].NumDescriptors = kD3D12SrvTableSize;
@@ -1234,7 +1701,25 @@ namespace Dolas
 		srv_ranges[0].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
 		srv_ranges[1] = srv_ranges[0];
 
-		D3D12_ROOT_PARAMETER root_parameters[7] = {};
+		// 无界数组需要 Resource Binding Tier 2 以上（Tier 1 每个 stage 最多 128 个 SRV）
+		D3D12_FEATURE_DATA_D3D12_OPTIONS options = {};
+		m_bindless_texture_enabled =
+			SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options))) &&
+			options.ResourceBindingTier >= D3D12_RESOURCE_BINDING_TIER_2;
+		if (!m_bindless_texture_enabled)
+		{
+			LOG_WARN("D3D12 resource binding tier 2 unavailable, bindless textures disabled.");
+		}
+
+		// bindless 纹理表覆盖 SRV heap 的整个常驻区间，纹理的 heap 下标即数组下标
+		D3D12_DESCRIPTOR_RANGE bindless_srv_range = {};
+		bindless_srv_range.RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+		bindless_srv_range.NumDescriptors = rhi->GetPersistentSrvDescriptorCount();
+		bindless_srv_range.BaseShaderRegister = 0;
+		bindless_srv_range.RegisterSpace = kBindlessSrvRegisterSpace;
+		bindless_srv_range.OffsetInDescriptorsFromTableStart = 0;
+
+		D3D12_ROOT_PARAMETER root_parameters[8] = {};
 		root_parameters[kRootPerViewCBV].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
 		root_parameters[kRootPerViewCBV].Descriptor.ShaderRegister = 0;
 		root_parameters[kRootPerViewCBV].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
@@ -1265,7 +1750,12 @@ namespace Dolas
 		root_parameters[kRootPSSrvTable].DescriptorTable.pDescriptorRanges = &srv_ranges[1];
 		root_parameters[kRootPSSrvTable].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
-		D3D12_STATIC_SAMPLER_DESC samplers[8] = {};
+		root_parameters[kRootBindlessSrvTable].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+		root_parameters[kRootBindlessSrvTable].DescriptorTable.NumDescriptorRanges = 1;
+		root_parameters[kRootBindlessSrvTable].DescriptorTable.pDescriptorRanges = &bindless_srv_range;
+		root_parameters[kRootBindlessSrvTable].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+		D3D12_STATIC_SAMPLER_DESC samplers[9] = {};
 		auto configure_sampler = [](D3D12_STATIC_SAMPLER_DESC& sampler, UINT shader_register, D3D12_TEXTURE_ADDRESS_MODE address_mode)
 		{
 			sampler.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
@@ -1289,9 +1779,14 @@ namespace Dolas
 		configure_sampler(samplers[5], 13, D3D12_TEXTURE_ADDRESS_MODE_WRAP);
 		configure_sampler(samplers[6], 14, D3D12_TEXTURE_ADDRESS_MODE_CLAMP);
 		configure_sampler(samplers[7], 15, D3D12_TEXTURE_ADDRESS_MODE_CLAMP);
+		// 阴影比较采样（SamplerComparisonState, s12）：硬件 2x2 PCF，图集外按白色边界视为不在阴影中
+		configure_sampler(samplers[8], 12, D3D12_TEXTURE_ADDRESS_MODE_BORDER);
+		samplers[8].Filter = D3D12_FILTER_COMPARISON_MIN_MAG_LINEAR_MIP_POINT;
+		samplers[8].ComparisonFunc = D3D12_COMPARISON_FUNC_LESS_EQUAL;
+		samplers[8].BorderColor = D3D12_STATIC_BORDER_COLOR_OPAQUE_WHITE;
 
 		D3D12_ROOT_SIGNATURE_DESC root_signature_desc = {};
-		root_signature_desc.NumParameters = ARRAYSIZE(root_parameters);
+		root_signature_desc.NumParameters = m_bindless_texture_enabled ? ARRAYSIZE(root_parameters) : kRootBindlessSrvTable;
 		root_signature_desc.pParameters = root_parameters;
 		root_signature_desc.NumStaticSamplers = ARRAYSIZE(samplers);
 		root_signature_desc.pStaticSamplers = samplers;
@@ -1323,6 +1818,7 @@ namespace Dolas
 			return false;
 		}
 
+		m_pipeline_state_library.Initialize(device, PathUtils::GetEngineCacheDir() + "pipeline_cache.bin", rhi->GetAdapterIdentity());
 		return true;
 	}
 
@@ -1398,6 +1894,18 @@ namespace Dolas
 		D3D12_RASTERIZER_DESC d3d12_wireframe_desc = d3d12_solid_back_cull_desc;
 		d3d12_wireframe_desc.FillMode = D3D12_FILL_MODE_WIREFRAME;
 		m_d3d11_state_cache->d3d12_rasterizer_state_create_desc[RasterizerStateType_Wireframe] = d3d12_wireframe_desc;
+
+		// 深度偏移以 D32_FLOAT 阴影图为准：常量项按深度的指数缩放，斜率项处理与光线接近平行的表面
+		D3D11_RASTERIZER_DESC shadow_depth_bias_desc = solid_none_cull_desc;
+		shadow_depth_bias_desc.DepthBias = 64;
+		shadow_depth_bias_desc.DepthBiasClamp = 0.01f;
+		shadow_depth_bias_desc.SlopeScaledDepthBias = 2.0f;
+		m_d3d11_state_cache->rasterizer_state_create_desc[RasterizerStateType_ShadowDepthBias] = shadow_depth_bias_desc;
+		D3D12_RASTERIZER_DESC d3d12_shadow_depth_bias_desc = d3d12_solid_none_cull_desc;
+		d3d12_shadow_depth_bias_desc.DepthBias = 64;
+		d3d12_shadow_depth_bias_desc.DepthBiasClamp = 0.01f;
+		d3d12_shadow_depth_bias_desc.SlopeScaledDepthBias = 2.0f;
+		m_d3d11_state_cache->d3d12_rasterizer_state_create_desc[RasterizerStateType_ShadowDepthBias] = d3d12_shadow_depth_bias_desc;
 	}
 
 	void DolasRHI::InitializeDepthStencilStateCreateDesc()
@@ -1484,6 +1992,29 @@ namespace Dolas
 		d3d12_depth_read_only_desc.StencilEnable = FALSE;
 		m_d3d11_state_cache->d3d12_depth_stencil_state_create_desc[DepthStencilStateType_DepthReadOnly].first = d3d12_depth_read_only_desc;
 
+		D3D11_DEPTH_STENCIL_DESC depth_write_less_desc = {};
+		depth_write_less_desc.DepthEnable = TRUE;
+		depth_write_less_desc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
+		depth_write_less_desc.DepthFunc = D3D11_COMPARISON_LESS;
+		m_d3d11_state_cache->depth_stencil_state_create_desc[DepthStencilStateType_DepthWriteLess].first = depth_write_less_desc;
+		D3D12_DEPTH_STENCIL_DESC d3d12_depth_write_less_desc = {};
+		d3d12_depth_write_less_desc.DepthEnable = TRUE;
+		d3d12_depth_write_less_desc.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;
+		d3d12_depth_write_less_desc.DepthFunc = D3D12_COMPARISON_FUNC_LESS;
+		d3d12_depth_write_less_desc.StencilEnable = FALSE;
+		m_d3d11_state_cache->d3d12_depth_stencil_state_create_desc[DepthStencilStateType_DepthWriteLess].first = d3d12_depth_write_less_desc;
+
+		D3D11_DEPTH_STENCIL_DESC depth_equal_stencil_write_static_desc = depth_write_less_stencil_read_static_desc;
+		depth_equal_stencil_write_static_desc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO;
+		depth_equal_stencil_write_static_desc.DepthFunc = D3D11_COMPARISON_EQUAL;
+		m_d3d11_state_cache->depth_stencil_state_create_desc[DepthStencilStateType_DepthEqual_StencilWriteStatic].first = depth_equal_stencil_write_static_desc;
+		m_d3d11_state_cache->depth_stencil_state_create_desc[DepthStencilStateType_DepthEqual_StencilWriteStatic].second = StencilMaskEnum_Static;
+		D3D12_DEPTH_STENCIL_DESC d3d12_depth_equal_stencil_write_static_desc = d3d12_depth_write_less_stencil_write_static_desc;
+		d3d12_depth_equal_stencil_write_static_desc.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO;
+		d3d12_depth_equal_stencil_write_static_desc.DepthFunc = D3D12_COMPARISON_FUNC_EQUAL;
+		m_d3d11_state_cache->d3d12_depth_stencil_state_create_desc[DepthStencilStateType_DepthEqual_StencilWriteStatic].first = d3d12_depth_equal_stencil_write_static_desc;
+		m_d3d11_state_cache->d3d12_depth_stencil_state_create_desc[DepthStencilStateType_DepthEqual_StencilWriteStatic].second = StencilMaskEnum_Static;
+
 	}
 
 	void DolasRHI::InitializeBlendStateCreateDesc()
@@ -1669,7 +2200,7 @@ namespace Dolas
 		}
 	}
 
-	std::shared_ptr<RenderTargetView> DolasRHI::CreateRenderTargetView(TextureID texture_id)
+	std::shared_ptr<RenderTargetView> DolasRHI::CreateRenderTargetView(TextureID texture_id, DXGI_FORMAT format /*= DXGI_FORMAT_UNKNOWN*/, UInt mip_slice /*= 0*/, UInt array_slice /*= 0*/)
 	{
 		TextureManager* texture_manager = g_dolas_engine.m_texture_manager;
 		DOLAS_RETURN_NULL_IF_NULL(texture_manager);
@@ -1677,36 +2208,68 @@ namespace Dolas
 		Texture* texture = texture_manager->GetTextureByTextureID(texture_id);
 		DOLAS_RETURN_NULL_IF_NULL(texture);
 
+		const ULongLong view_key = Texture::MakeViewKey(static_cast<UInt>(format), mip_slice, array_slice);
+		std::shared_ptr<RenderTargetView> render_target_view = texture->FindRenderTargetView(view_key);
+		if (render_target_view)
+		{
+			++m_frame_statistics.view_cache_hits;
+			return render_target_view;
+		}
+
+		++m_frame_statistics.view_creations;
 		ID3D11Texture2D* d3d11_texture = texture->GetD3DTexture2D();
-		std::shared_ptr<RenderTargetView> render_target_view = nullptr;
 		if (d3d11_texture)
 		{
-			render_target_view = CreateRenderTargetViewByD3D11Texture(d3d11_texture);
+			render_target_view = CreateRenderTargetViewByD3D11Texture(d3d11_texture, format, mip_slice, array_slice);
 		}
 		else
 		{
 			render_target_view = std::make_shared<RenderTargetView>();
 		}
 		render_target_view->m_texture_id = texture_id;
-		render_target_view->m_d3d12_render_target_view = texture->GetD3D12RtvHandle();
+
+		const Bool is_default_view = format == DXGI_FORMAT_UNKNOWN && mip_slice == 0 && array_slice == 0;
+		ID3D12Resource* d3d12_resource = texture->GetD3D12Resource();
+		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+		if (is_default_view)
+		{
+			render_target_view->m_d3d12_render_target_view = texture->GetD3D12RtvHandle();
+		}
+		else if (rhi && rhi->GetDevice() && d3d12_resource)
+		{
+			const D3D12_RESOURCE_DESC resource_desc = d3d12_resource->GetDesc();
+			const DXGI_FORMAT view_format = format == DXGI_FORMAT_UNKNOWN ? resource_desc.Format : format;
+			D3D12_CPU_DESCRIPTOR_HANDLE rtv_handle = {};
+			if (rhi->AllocateRtvDescriptor(&rtv_handle))
+			{
+				const D3D12_RENDER_TARGET_VIEW_DESC rtv_desc = MakeD3D12RenderTargetViewDesc(resource_desc, view_format, mip_slice, array_slice);
+				rhi->GetDevice()->CreateRenderTargetView(d3d12_resource, &rtv_desc, rtv_handle);
+				render_target_view->m_d3d12_render_target_view = rtv_handle;
+			}
+		}
+
+		texture->AddRenderTargetView(view_key, render_target_view);
 		return render_target_view;
 	}
 
-	std::shared_ptr<RenderTargetView> DolasRHI::CreateRenderTargetViewByD3D11Texture(ID3D11Texture2D* d3d_texture)
+	std::shared_ptr<RenderTargetView> DolasRHI::CreateRenderTargetViewByD3D11Texture(ID3D11Texture2D* d3d_texture, DXGI_FORMAT format /*= DXGI_FORMAT_UNKNOWN*/, UInt mip_slice /*= 0*/, UInt array_slice /*= 0*/)
 	{
 		D3D11_TEXTURE2D_DESC texture_desc = {};
 		d3d_texture->GetDesc(&texture_desc);
 
 		D3D11_RENDER_TARGET_VIEW_DESC rtv_desc = {};
-		rtv_desc.Format = texture_desc.Format;
+		rtv_desc.Format = format == DXGI_FORMAT_UNKNOWN ? texture_desc.Format : format;
 
+		// 默认视图（mip 0、slice 0）覆盖整个数组，子资源视图只覆盖单个切片
+		const Bool is_default_view = mip_slice == 0 && array_slice == 0;
+		const UINT array_size = is_default_view ? texture_desc.ArraySize : 1;
 		if (texture_desc.SampleDesc.Count > 1)
 		{
 			if (texture_desc.ArraySize > 1)
 			{
 				rtv_desc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2DMSARRAY;
-				rtv_desc.Texture2DMSArray.FirstArraySlice = 0;
-				rtv_desc.Texture2DMSArray.ArraySize = texture_desc.ArraySize;
+				rtv_desc.Texture2DMSArray.FirstArraySlice = array_slice;
+				rtv_desc.Texture2DMSArray.ArraySize = array_size;
 			}
 			else
 			{
@@ -1718,14 +2281,14 @@ namespace Dolas
 			if (texture_desc.ArraySize > 1)
 			{
 				rtv_desc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2DARRAY;
-				rtv_desc.Texture2DArray.MipSlice = 0;
-				rtv_desc.Texture2DArray.FirstArraySlice = 0;
-				rtv_desc.Texture2DArray.ArraySize = texture_desc.ArraySize;
+				rtv_desc.Texture2DArray.MipSlice = mip_slice;
+				rtv_desc.Texture2DArray.FirstArraySlice = array_slice;
+				rtv_desc.Texture2DArray.ArraySize = array_size;
 			}
 			else
 			{
 				rtv_desc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2D;
-				rtv_desc.Texture2D.MipSlice = 0;
+				rtv_desc.Texture2D.MipSlice = mip_slice;
 			}
 		}
 
@@ -1818,6 +2381,8 @@ namespace Dolas
 		barrier.Transition.StateBefore = before_state;
 		barrier.Transition.StateAfter = after_state;
 		command_list->ResourceBarrier(1, &barrier);
+		++m_frame_statistics.resource_barriers;
+		++m_frame_statistics.resource_barrier_calls;
 	}
 
 	void DolasRHI::TransitionTexture(Texture* texture, D3D12_RESOURCE_STATES after_state)
@@ -1828,8 +2393,82 @@ namespace Dolas
 		}
 
 		D3D12_RESOURCE_STATES before_state = texture->GetD3D12ResourceState();
+		// 渲染图会把连续的只读使用合并成一个组合只读状态，已包含目标状态时不需要再转换
+		if (before_state == after_state || (IsD3D12ReadOnlyState(before_state) && (before_state & after_state) == after_state))
+		{
+			return;
+		}
 		TransitionResource(texture->GetD3D12Resource(), before_state, after_state);
 		texture->SetD3D12ResourceState(after_state);
+		++m_frame_statistics.ad_hoc_transitions;
+	}
+
+	void DolasRHI::ExecuteRenderGraphBarriers(const std::vector<RenderGraphBarrier>& barriers, const std::vector<TextureID>& textures)
+	{
+		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+		ID3D12GraphicsCommandList* command_list = rhi ? rhi->GetCommandList() : nullptr;
+		TextureManager* texture_manager = g_dolas_engine.m_texture_manager;
+		if (!command_list || !texture_manager || barriers.empty())
+		{
+			return;
+		}
+
+		auto get_texture = [&](RenderGraphResourceHandle resource) -> Texture*
+		{
+			if (resource >= textures.size())
+			{
+				return nullptr;
+			}
+			Texture* texture = texture_manager->GetTextureByTextureID(textures[resource]);
+			return texture && texture->GetD3D12Resource() ? texture : nullptr;
+		};
+
+		std::vector<D3D12_RESOURCE_BARRIER> d3d12_barriers;
+		d3d12_barriers.reserve(barriers.size());
+		for (const RenderGraphBarrier& barrier : barriers)
+		{
+			Texture* texture = get_texture(barrier.resource);
+			DOLAS_CONTINUE_IF_NULL(texture);
+
+			D3D12_RESOURCE_BARRIER d3d12_barrier = {};
+			d3d12_barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+			if (barrier.type == RenderGraphBarrierType_Aliasing)
+			{
+				// 放置失败退回独立分配时纹理不共用内存，不需要别名屏障
+				if (!texture->IsD3D12Placed())
+				{
+					continue;
+				}
+				Texture* texture_before = get_texture(barrier.resource_before);
+				d3d12_barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+				d3d12_barrier.Aliasing.pResourceBefore = texture_before && texture_before->IsD3D12Placed() ? texture_before->GetD3D12Resource() : nullptr;
+				d3d12_barrier.Aliasing.pResourceAfter = texture->GetD3D12Resource();
+				d3d12_barriers.push_back(d3d12_barrier);
+				continue;
+			}
+
+			const D3D12_RESOURCE_STATES before_state = texture->GetD3D12ResourceState();
+			const D3D12_RESOURCE_STATES after_state = ToD3D12ResourceState(barrier.state_after);
+			if (before_state == after_state)
+			{
+				continue;
+			}
+			d3d12_barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+			d3d12_barrier.Transition.pResource = texture->GetD3D12Resource();
+			d3d12_barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+			d3d12_barrier.Transition.StateBefore = before_state;
+			d3d12_barrier.Transition.StateAfter = after_state;
+			d3d12_barriers.push_back(d3d12_barrier);
+			texture->SetD3D12ResourceState(after_state);
+		}
+
+		if (d3d12_barriers.empty())
+		{
+			return;
+		}
+		command_list->ResourceBarrier(static_cast<UINT>(d3d12_barriers.size()), d3d12_barriers.data());
+		m_frame_statistics.resource_barriers += static_cast<UInt>(d3d12_barriers.size());
+		++m_frame_statistics.resource_barrier_calls;
 	}
 
 	void DolasRHI::UpdateD3D12UploadBuffer(ID3D12Resource* resource, const void* data, std::size_t size)
@@ -1862,33 +2501,123 @@ namespace Dolas
 			return;
 		}
 
+		// 根签名、per-frame CBV 与 bindless 表在整个 command list 内不变，只需绑定一次；
+		// per-view / per-object CBV 指向上传环中最近一次更新的区间，之后由 SetD3D12RootConstantBufferView 随更新重新设置
+		const Bool need_bind = !m_d3d12_binding_cache.global_resources_bound;
+		m_frame_statistics.root_signature.Record(need_bind);
+		m_frame_statistics.constant_buffer_view.Record(need_bind && m_d3d12_per_view_address != 0);
+		m_frame_statistics.constant_buffer_view.Record(need_bind && m_d3d12_per_frame_parameters_buffer);
+		m_frame_statistics.constant_buffer_view.Record(need_bind && m_d3d12_per_object_address != 0);
+		if (!need_bind)
+		{
+			return;
+		}
+
 		command_list->SetGraphicsRootSignature(m_d3d12_root_signature);
-		if (m_d3d12_per_view_parameters_buffer)
+		if (m_d3d12_per_view_address != 0)
 		{
-			command_list->SetGraphicsRootConstantBufferView(kRootPerViewCBV, m_d3d12_per_view_parameters_buffer->GetGPUVirtualAddress());
+			command_list->SetGraphicsRootConstantBufferView(kRootPerViewCBV, m_d3d12_per_view_address);
 		}
 		if (m_d3d12_per_frame_parameters_buffer)
 		{
 			command_list->SetGraphicsRootConstantBufferView(kRootPerFrameCBV, m_d3d12_per_frame_parameters_buffer->GetGPUVirtualAddress());
 		}
-		if (m_d3d12_per_object_parameters_buffer)
+		if (m_d3d12_per_object_address != 0)
+		{
+			command_list->SetGraphicsRootConstantBufferView(kRootPerObjectCBV, m_d3d12_per_object_address);
+		}
+		if (m_bindless_texture_enabled && rhi->GetSrvHeap())
+		{
+			// bindless 表从 heap 起始处开始，整个 command list 内固定不变
+			command_list->SetGraphicsRootDescriptorTable(kRootBindlessSrvTable, rhi->GetSrvHeap()->GetGPUDescriptorHandleForHeapStart());
+		}
+		m_d3d12_binding_cache.global_resources_bound = true;
+
+		// 新设置的根签名会使之前的根参数失效，global CB 先指向 dummy
+		m_d3d12_binding_cache.vs_global_constant_buffer = 0;
+		m_d3d12_binding_cache.ps_global_constant_buffer = 0;
+		m_d3d12_binding_cache.vs_srv_table = 0;
+		m_d3d12_binding_cache.ps_srv_table = 0;
+		SetD3D12GlobalConstantBuffer(kRootVSGlobalCBV, m_d3d12_dummy_constant_buffer, m_d3d12_binding_cache.vs_global_constant_buffer);
+		SetD3D12GlobalConstantBuffer(kRootPSGlobalCBV, m_d3d12_dummy_constant_buffer, m_d3d12_binding_cache.ps_global_constant_buffer);
+	}
+
+	D3D12_GPU_VIRTUAL_ADDRESS DolasRHI::WriteD3D12TransientConstants(ID3D12Resource* fallback_buffer, const void* data, std::size_t size)
+	{
+		const ULongLong aligned_size = AlignTo256(static_cast<UINT>(size));
+		if (m_d3d12_transient_constant_data && m_d3d12_transient_constant_offset + aligned_size <= kD3D12TransientConstantBufferSize)
 		{
-			command_list->SetGraphicsRootConstantBufferView(kRootPerObjectCBV, m_d3d12_per_object_parameters_buffer->GetGPUVirtualAddress());
+			const ULongLong offset = m_d3d12_transient_constant_offset;
+			memcpy(m_d3d12_transient_constant_data + offset, data, size);
+			m_d3d12_transient_constant_offset += aligned_size;
+			m_frame_statistics.transient_constant_bytes += aligned_size;
+			return m_d3d12_transient_constant_buffer->GetGPUVirtualAddress() + offset;
 		}
-		if (m_d3d12_dummy_constant_buffer)
+
+		if (m_d3d12_transient_constant_data && m_frame_statistics.transient_constant_overflows++ == 0)
 		{
-			command_list->SetGraphicsRootConstantBufferView(kRootVSGlobalCBV, m_d3d12_dummy_constant_buffer->GetGPUVirtualAddress());
-			command_list->SetGraphicsRootConstantBufferView(kRootPSGlobalCBV, m_d3d12_dummy_constant_buffer->GetGPUVirtualAddress());
+			LOG_WARN("D3D12 transient constant buffer exhausted ({0} bytes), constants of later draws in this frame may be overwritten.", kD3D12TransientConstantBufferSize);
 		}
+		UpdateD3D12UploadBuffer(fallback_buffer, data, size);
+		return fallback_buffer ? fallback_buffer->GetGPUVirtualAddress() : 0;
+	}
+
+	void DolasRHI::SetD3D12RootConstantBufferView(UINT root_parameter_index, D3D12_GPU_VIRTUAL_ADDRESS address, D3D12_GPU_VIRTUAL_ADDRESS& current_address)
+	{
+		if (address == 0 || address == current_address)
+		{
+			return;
+		}
+		current_address = address;
+
+		// 全局资源尚未绑定时（新的 command list / ImGui 改写根签名之后），由 BindD3D12GlobalResources 使用新地址
+		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+		ID3D12GraphicsCommandList* command_list = rhi ? rhi->GetCommandList() : nullptr;
+		if (command_list && m_d3d12_binding_cache.global_resources_bound)
+		{
+			command_list->SetGraphicsRootConstantBufferView(root_parameter_index, address);
+			m_frame_statistics.constant_buffer_view.Record(true);
+		}
+	}
+
+	void DolasRHI::SetD3D12GlobalConstantBuffer(UINT root_parameter_index, ID3D12Resource* constant_buffer, D3D12_GPU_VIRTUAL_ADDRESS& bound_address)
+	{
+		SetD3D12GlobalConstantBuffer(root_parameter_index, constant_buffer ? constant_buffer->GetGPUVirtualAddress() : 0, bound_address);
+	}
+
+	void DolasRHI::SetD3D12GlobalConstantBuffer(UINT root_parameter_index, D3D12_GPU_VIRTUAL_ADDRESS address, D3D12_GPU_VIRTUAL_ADDRESS& bound_address)
+	{
+		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+		ID3D12GraphicsCommandList* command_list = rhi ? rhi->GetCommandList() : nullptr;
+		if (address == 0 && m_d3d12_dummy_constant_buffer)
+		{
+			address = m_d3d12_dummy_constant_buffer->GetGPUVirtualAddress();
+		}
+		if (!command_list || address == 0)
+		{
+			return;
+		}
+
+		const Bool need_bind = address != bound_address;
+		m_frame_statistics.constant_buffer_view.Record(need_bind);
+		if (need_bind)
+		{
+			command_list->SetGraphicsRootConstantBufferView(root_parameter_index, address);
+			bound_address = address;
+		}
+	}
+
+	void DolasRHI::ResetD3D12BindingCache()
+	{
+		m_d3d12_binding_cache = D3D12BindingCache();
 	}
 
 	void DolasRHI::BindD3D12SrvTable(std::shared_ptr<ShaderContext> shader_context, bool pixel_shader)
 	{
 		DOLAS_RETURN_IF_NULL(shader_context);
 		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
-		ID3D12Device* device = rhi ? rhi->GetDevice() : nullptr;
 		ID3D12GraphicsCommandList* command_list = rhi ? rhi->GetCommandList() : nullptr;
-		if (!rhi || !device || !command_list)
+		if (!rhi || !command_list)
 		{
 			return;
 		}
@@ -1900,114 +2629,450 @@ namespace Dolas
 			TransitionTexture(texture, pixel_shader ? D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE : D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 		}
 
-		D3D12_CPU_DESCRIPTOR_HANDLE table_cpu = {};
 		D3D12_GPU_DESCRIPTOR_HANDLE table_gpu = {};
-		if (!rhi->AllocateTransientSrvDescriptorTable(kD3D12SrvTableSize, &table_cpu, &table_gpu))
+		if (!PrepareD3D12SrvTable(shader_context.get(), &table_gpu))
 		{
 			return;
 		}
 
-		const UINT descriptor_size = rhi->GetSrvDescriptorSize();
-		D3D12_CPU_DESCRIPTOR_HANDLE null_srv = rhi->GetNullSrvDescriptorCpuHandle();
-		for (UINT slot = 0; slot < kD3D12SrvTableSize; ++slot)
+		// 与该 stage 当前绑定的 table 相同则跳过
+		UINT64& bound_table = pixel_shader ? m_d3d12_binding_cache.ps_srv_table : m_d3d12_binding_cache.vs_srv_table;
+		const Bool need_bind = bound_table != table_gpu.ptr;
+		m_frame_statistics.srv_table.Record(need_bind);
+		if (!need_bind)
 		{
-			D3D12_CPU_DESCRIPTOR_HANDLE dst = table_cpu;
-			dst.ptr += static_cast<SIZE_T>(slot) * descriptor_size;
-			device->CopyDescriptorsSimple(1, dst, null_srv, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+			return;
 		}
 
+		command_list->SetGraphicsRootDescriptorTable(pixel_shader ? kRootPSSrvTable : kRootVSSrvTable, table_gpu);
+		bound_table = table_gpu.ptr;
+	}
+
+	ULongLong DolasRHI::GetD3D12SrvContentGeneration() const
+	{
+		// 释放的 SRV 下标会立即被新纹理复用，同一个源句柄可能已指向别的资源，只比较句柄不够
+		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+		const ULongLong free_generation = rhi ? rhi->GetSrvDescriptorAllocator().GetFreeGeneration() : 0;
+		return m_d3d12_srv_content_generation + free_generation;
+	}
+
+	Bool DolasRHI::PrepareD3D12SrvTable(ShaderContext* shader_context, D3D12_GPU_DESCRIPTOR_HANDLE* out_table_gpu)
+	{
+		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+		DOLAS_RETURN_FALSE_IF_NULL(rhi);
+
+		// 按 slot 顺序展开成定长数组，空 slot 保持 ptr == 0，写入时替换为 null SRV
+		D3D12_CPU_DESCRIPTOR_HANDLE srv_sources[kD3D12SrvTableSize] = {};
+		UInt valid_srv_count = 0;
 		for (const auto& srv_pair : shader_context->GetSlotToD3D12SRVCpuMap())
 		{
 			if (srv_pair.first >= kD3D12SrvTableSize || srv_pair.second.ptr == 0)
 			{
 				continue;
 			}
+			srv_sources[srv_pair.first] = srv_pair.second;
+			++valid_srv_count;
+		}
 
-			D3D12_CPU_DESCRIPTOR_HANDLE dst = table_cpu;
-			dst.ptr += static_cast<SIZE_T>(srv_pair.first) * descriptor_size;
-			device->CopyDescriptorsSimple(1, dst, srv_pair.second, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+		// 没有任何纹理的 shader 共用一张全 null 的 table
+		if (valid_srv_count == 0)
+		{
+			if (m_d3d12_null_srv_table_gpu.ptr == 0)
+			{
+				D3D12_CPU_DESCRIPTOR_HANDLE null_table_cpu = {};
+				if (!rhi->AllocateSrvDescriptorTable(kD3D12SrvTableSize, &null_table_cpu, &m_d3d12_null_srv_table_gpu))
+				{
+					return false;
+				}
+				WriteD3D12SrvTable(null_table_cpu, nullptr);
+			}
+			*out_table_gpu = m_d3d12_null_srv_table_gpu;
+			return true;
 		}
 
-		command_list->SetGraphicsRootDescriptorTable(pixel_shader ? kRootPSSrvTable : kRootVSSrvTable, table_gpu);
+		Bool sources_match = shader_context->m_d3d12_srv_table_valid
+			&& shader_context->m_d3d12_srv_table_content_generation == GetD3D12SrvContentGeneration();
+		for (UInt slot = 0; sources_match && slot < kD3D12SrvTableSize; ++slot)
+		{
+			sources_match = shader_context->m_d3d12_srv_table_sources[slot].ptr == srv_sources[slot].ptr;
+		}
+		if (sources_match)
+		{
+			shader_context->m_d3d12_srv_table_last_bound_frame = m_frame_serial;
+			*out_table_gpu = shader_context->m_d3d12_srv_table_gpu;
+			return true;
+		}
+
+		// 纹理绑定发生了变化：优先原地重写常驻 table；
+		// 但如果本帧已有 draw 引用了这张 table（GPU 执行时才读取 descriptor），只能退回到本帧的临时 table，下一帧再重建
+		Bool write_persistent = true;
+		if (shader_context->m_d3d12_srv_table_gpu.ptr == 0)
+		{
+			write_persistent = rhi->AllocateSrvDescriptorTable(
+				kD3D12SrvTableSize,
+				&shader_context->m_d3d12_srv_table_cpu,
+				&shader_context->m_d3d12_srv_table_gpu);
+		}
+		else if (shader_context->m_d3d12_srv_table_valid && shader_context->m_d3d12_srv_table_last_bound_frame == m_frame_serial)
+		{
+			write_persistent = false;
+		}
+
+		if (write_persistent)
+		{
+			WriteD3D12SrvTable(shader_context->m_d3d12_srv_table_cpu, srv_sources);
+			shader_context->m_d3d12_srv_table_valid = true;
+			for (UInt slot = 0; slot < kD3D12SrvTableSize; ++slot)
+			{
+				shader_context->m_d3d12_srv_table_sources[slot] = srv_sources[slot];
+			}
+			shader_context->m_d3d12_srv_table_content_generation = GetD3D12SrvContentGeneration();
+			shader_context->m_d3d12_srv_table_last_bound_frame = m_frame_serial;
+			++m_frame_statistics.srv_table_rebuilds;
+			*out_table_gpu = shader_context->m_d3d12_srv_table_gpu;
+			return true;
+		}
+
+		D3D12_CPU_DESCRIPTOR_HANDLE transient_table_cpu = {};
+		if (!rhi->AllocateTransientSrvDescriptorTable(kD3D12SrvTableSize, &transient_table_cpu, out_table_gpu))
+		{
+			return false;
+		}
+		WriteD3D12SrvTable(transient_table_cpu, srv_sources);
+		++m_frame_statistics.srv_table_transient_writes;
+		return true;
 	}
 
-	ID3D12PipelineState* DolasRHI::GetOrCreateD3D12PipelineState(RenderPrimitive* render_primitive)
+	void DolasRHI::WriteD3D12SrvTable(D3D12_CPU_DESCRIPTOR_HANDLE table_cpu, const D3D12_CPU_DESCRIPTOR_HANDLE* srv_sources)
 	{
-		DOLAS_RETURN_NULL_IF_NULL(render_primitive);
 		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
 		ID3D12Device* device = rhi ? rhi->GetDevice() : nullptr;
-		if (!device || !m_d3d12_root_signature || !m_current_vertex_context || !m_current_pixel_context)
+		DOLAS_RETURN_IF_NULL(device);
+
+		const UINT descriptor_size = rhi->GetSrvDescriptorSize();
+		D3D12_CPU_DESCRIPTOR_HANDLE srv_handles[kD3D12SrvTableSize];
+		for (UINT slot = 0; slot < kD3D12SrvTableSize; ++slot)
 		{
-			return nullptr;
+			const Bool has_source = srv_sources && srv_sources[slot].ptr != 0;
+			srv_handles[slot] = has_source ? srv_sources[slot] : rhi->GetNullSrvDescriptorCpuHandle();
 		}
 
-		ShaderBytecodeView vs_bytecode = m_current_vertex_context->GetShaderBytecode();
-		ShaderBytecodeView ps_bytecode = m_current_pixel_context->GetShaderBytecode();
-		if (!vs_bytecode.IsValid() || !ps_bytecode.IsValid())
+		for (UINT slot = 0; slot < kD3D12SrvTableSize; ++slot)
 		{
-			return nullptr;
+			D3D12_CPU_DESCRIPTOR_HANDLE dst = table_cpu;
+			dst.ptr += static_cast<SIZE_T>(slot) * descriptor_size;
+			device->CopyDescriptorsSimple(1, dst, srv_handles[slot], D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 		}
+		m_frame_statistics.descriptor_copies += kD3D12SrvTableSize;
+	}
+
+	InputLayoutType DolasRHI::GetCurrentInputLayoutType(const RenderPrimitive* render_primitive) const
+	{
+		return m_position_only_vertex_input ? InputLayoutType_POS_3 : render_primitive->m_input_layout_type;
+	}
 
-		std::size_t key = 0;
-		key = HashCombine(key, reinterpret_cast<std::size_t>(vs_bytecode.data));
-		key = HashCombine(key, vs_bytecode.size);
-		key = HashCombine(key, reinterpret_cast<std::size_t>(ps_bytecode.data));
-		key = HashCombine(key, ps_bytecode.size);
-		key = HashCombine(key, static_cast<std::size_t>(render_primitive->m_input_layout_type));
-		key = HashCombine(key, static_cast<std::size_t>(m_current_rasterizer_state_type));
-		key = HashCombine(key, static_cast<std::size_t>(m_current_depth_stencil_state_type));
-		key = HashCombine(key, static_cast<std::size_t>(m_current_blend_state_type));
-		key = HashCombine(key, static_cast<std::size_t>(m_current_primitive_topology));
-		key = HashCombine(key, static_cast<std::size_t>(m_current_render_target_count));
-		key = HashCombine(key, static_cast<std::size_t>(m_current_dsv_format));
+	PipelineStateRecord DolasRHI::MakeCurrentPipelineStateRecord(InputLayoutType input_layout_type) const
+	{
+		PipelineStateRecord record;
+		if (m_current_vertex_context)
+		{
+			record.vertex_shader_path = m_current_vertex_context->GetFilePath();
+			record.vertex_entry_point = m_current_vertex_context->GetEntryPoint();
+		}
+		if (m_current_pixel_context)
+		{
+			record.pixel_shader_path = m_current_pixel_context->GetFilePath();
+			record.pixel_entry_point = m_current_pixel_context->GetEntryPoint();
+		}
+		record.input_layout = static_cast<UInt>(input_layout_type);
+		record.rasterizer_state = static_cast<UInt>(m_current_rasterizer_state_type);
+		record.depth_stencil_state = static_cast<UInt>(m_current_depth_stencil_state_type);
+		record.blend_state = static_cast<UInt>(m_current_blend_state_type);
+		record.primitive_topology = static_cast<UInt>(m_current_primitive_topology);
+		record.render_target_count = m_current_render_target_count;
 		for (UINT i = 0; i < m_current_render_target_count; ++i)
 		{
-			key = HashCombine(key, static_cast<std::size_t>(m_current_rtv_formats[i]));
+			record.render_target_formats[i] = static_cast<UInt>(m_current_rtv_formats[i]);
 		}
+		record.depth_stencil_format = static_cast<UInt>(m_current_dsv_format);
+		return record;
+	}
 
-		auto pso_iter = m_d3d12_pipeline_state_cache.find(key);
-		if (pso_iter != m_d3d12_pipeline_state_cache.end())
+	Bool DolasRHI::BuildD3D12PipelineStateDesc(
+		const PipelineStateRecord& record,
+		const ShaderBytecodeView& vs_bytecode,
+		const ShaderBytecodeView& ps_bytecode,
+		D3D12_GRAPHICS_PIPELINE_STATE_DESC& out_desc) const
+	{
+		// 记录来自磁盘，枚举值越界时视为无效（枚举定义改变过）
+		if (!m_d3d12_root_signature || !vs_bytecode.IsValid() || !ps_bytecode.IsValid() ||
+			record.input_layout >= InputLayoutType_Count ||
+			record.rasterizer_state >= RasterizerStateType_Count ||
+			record.depth_stencil_state >= DepthStencilStateType_Count ||
+			record.blend_state >= BlendStateType_Count ||
+			record.primitive_topology >= PrimitiveTopology_Count ||
+			record.render_target_count > PipelineStateRecord::MAX_RENDER_TARGETS)
 		{
-			return pso_iter->second;
+			return false;
 		}
 
 		const std::vector<D3D12_INPUT_ELEMENT_DESC>& input_descs =
-			m_d3d11_state_cache->d3d12_input_element_descs[render_primitive->m_input_layout_type];
+			m_d3d11_state_cache->d3d12_input_element_descs[record.input_layout];
+
+		out_desc = {};
+		out_desc.InputLayout = { input_descs.data(), static_cast<UINT>(input_descs.size()) };
+		out_desc.pRootSignature = m_d3d12_root_signature;
+		out_desc.VS = { vs_bytecode.data, vs_bytecode.size };
+		out_desc.PS = { ps_bytecode.data, ps_bytecode.size };
+		out_desc.RasterizerState = m_d3d11_state_cache->d3d12_rasterizer_state_create_desc[record.rasterizer_state];
+		out_desc.BlendState = m_d3d11_state_cache->d3d12_blend_state_create_desc[record.blend_state];
+		out_desc.DepthStencilState = m_d3d11_state_cache->d3d12_depth_stencil_state_create_desc[record.depth_stencil_state].first;
+		out_desc.SampleMask = UINT_MAX;
+		out_desc.PrimitiveTopologyType = m_d3d11_state_cache->d3d12_primitive_topology_type[record.primitive_topology];
+		out_desc.NumRenderTargets = record.render_target_count;
+		for (UInt i = 0; i < record.render_target_count; ++i)
+		{
+			out_desc.RTVFormats[i] = static_cast<DXGI_FORMAT>(record.render_target_formats[i]);
+		}
+		out_desc.DSVFormat = static_cast<DXGI_FORMAT>(record.depth_stencil_format);
+		out_desc.SampleDesc.Count = 1;
+		out_desc.SampleDesc.Quality = 0;
+		return true;
+	}
 
-		D3D12_GRAPHICS_PIPELINE_STATE_DESC pso_desc = {};
-		pso_desc.InputLayout = { input_descs.data(), static_cast<UINT>(input_descs.size()) };
-		pso_desc.pRootSignature = m_d3d12_root_signature;
-		pso_desc.VS = { vs_bytecode.data, vs_bytecode.size };
-		pso_desc.PS = { ps_bytecode.data, ps_bytecode.size };
-		pso_desc.RasterizerState = m_d3d11_state_cache->d3d12_rasterizer_state_create_desc[m_current_rasterizer_state_type];
-		pso_desc.BlendState = m_d3d11_state_cache->d3d12_blend_state_create_desc[m_current_blend_state_type];
-		pso_desc.DepthStencilState = m_d3d11_state_cache->d3d12_depth_stencil_state_create_desc[m_current_depth_stencil_state_type].first;
-		pso_desc.SampleMask = UINT_MAX;
-		pso_desc.PrimitiveTopologyType = m_d3d11_state_cache->d3d12_primitive_topology_type[m_current_primitive_topology];
-		pso_desc.NumRenderTargets = m_current_render_target_count;
-		for (UINT i = 0; i < m_current_render_target_count; ++i)
+	ID3D12PipelineState* DolasRHI::GetOrCreateD3D12PipelineState(InputLayoutType input_layout_type)
+	{
+		if (!m_current_vertex_context || !m_current_pixel_context)
 		{
-			pso_desc.RTVFormats[i] = m_current_rtv_formats[i];
+			return nullptr;
 		}
-		pso_desc.DSVFormat = m_current_dsv_format;
-		pso_desc.SampleDesc.Count = 1;
-		pso_desc.SampleDesc.Quality = 0;
 
-		ID3D12PipelineState* pipeline_state = nullptr;
-		HRESULT hr = device->CreateGraphicsPipelineState(&pso_desc, IID_PPV_ARGS(&pipeline_state));
-		if (FAILED(hr))
+		const PipelineStateRecord record = MakeCurrentPipelineStateRecord(input_layout_type);
+		const ULongLong key = ComputePipelineStateKey(
+			m_current_vertex_context->GetShaderBytecodeHash(),
+			m_current_pixel_context->GetShaderBytecodeHash(),
+			record);
+
+		D3D12_GRAPHICS_PIPELINE_STATE_DESC pso_desc = {};
+		if (!BuildD3D12PipelineStateDesc(record, m_current_vertex_context->GetShaderBytecode(), m_current_pixel_context->GetShaderBytecode(), pso_desc))
 		{
-			LOG_ERROR("Failed to create D3D12 graphics pipeline state! HRESULT: 0x{0:X}", hr);
 			return nullptr;
 		}
 
-		m_d3d12_pipeline_state_cache[key] = pipeline_state;
+		PipelineStateSource source = PipelineStateSource::Failed;
+		Double create_milliseconds = 0.0;
+		ID3D12PipelineState* pipeline_state = m_pipeline_state_library.FindOrCreate(key, pso_desc, record, &source, &create_milliseconds);
+		switch (source)
+		{
+		case PipelineStateSource::Cache: ++m_frame_statistics.pipeline_state_cache_hits; break;
+		case PipelineStateSource::Library: ++m_frame_statistics.pipeline_state_library_hits; break;
+		case PipelineStateSource::Compiled: ++m_frame_statistics.pipeline_state_compiles; break;
+		default: break;
+		}
+		m_frame_statistics.pipeline_state_create_milliseconds += create_milliseconds;
 		return pipeline_state;
 	}
 
+	void DolasRHI::PrecompilePipelineStates(std::shared_ptr<VertexContext> vertex_context, std::shared_ptr<PixelContext> pixel_context)
+	{
+		if (!vertex_context || !pixel_context)
+		{
+			return;
+		}
+
+		std::vector<PipelineStateRecord> records = m_pipeline_state_library.FindRecords(
+			vertex_context->GetFilePath(),
+			vertex_context->GetEntryPoint(),
+			pixel_context->GetFilePath(),
+			pixel_context->GetEntryPoint());
+		if (records.empty())
+		{
+			return;
+		}
+
+		// ShaderContext 由 ShaderManager 持有，生命周期覆盖整个预编译过程
+		auto precompile = [this, vertex_context, pixel_context](const PipelineStateRecord& record)
+		{
+			D3D12_GRAPHICS_PIPELINE_STATE_DESC pso_desc = {};
+			if (!BuildD3D12PipelineStateDesc(record, vertex_context->GetShaderBytecode(), pixel_context->GetShaderBytecode(), pso_desc))
+			{
+				m_pipeline_state_library.AddPrecompileFailedCount(1);
+				return;
+			}
+			const ULongLong key = ComputePipelineStateKey(vertex_context->GetShaderBytecodeHash(), pixel_context->GetShaderBytecodeHash(), record);
+			PipelineStateSource source = PipelineStateSource::Failed;
+			m_pipeline_state_library.FindOrCreate(key, pso_desc, record, &source);
+			// 其他材质已经创建过的 PSO 命中缓存，不计入预编译数量
+			if (source == PipelineStateSource::Library || source == PipelineStateSource::Compiled)
+			{
+				m_pipeline_state_library.AddPrecompiledCount(1);
+			}
+			else if (source == PipelineStateSource::Failed)
+			{
+				m_pipeline_state_library.AddPrecompileFailedCount(1);
+			}
+		};
+
+		TaskManager* task_manager = g_dolas_engine.m_task_manager;
+		for (const PipelineStateRecord& record : records)
+		{
+			TaskGUID task_guid = task_manager ? task_manager->EnqueueTask(precompile, record) : 0;
+			if (task_guid != 0)
+			{
+				m_pipeline_precompile_tasks.push_back(task_guid);
+			}
+			else
+			{
+				// 线程池不可用时退化为同步创建
+				precompile(record);
+			}
+		}
+	}
+
+	void DolasRHI::WaitForPipelineStatePrecompile()
+	{
+		TaskManager* task_manager = g_dolas_engine.m_task_manager;
+		if (task_manager)
+		{
+			for (TaskGUID task_guid : m_pipeline_precompile_tasks)
+			{
+				task_manager->WaitForTask(task_guid);
+			}
+		}
+		m_pipeline_precompile_tasks.clear();
+	}
+
+	UInt DolasRHI::BeginGpuPassQuery(const std::string& name)
+	{
+		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+		ID3D12GraphicsCommandList* command_list = rhi ? rhi->GetCommandList() : nullptr;
+		if (!m_gpu_pass_profiling_enabled || !command_list || !m_d3d12_frame_started || m_gpu_pass_query_names.size() >= kMaxGpuPassQueryCount)
+		{
+			return kInvalidGpuPassQuery;
+		}
+		if (!m_d3d12_timestamp_query_heap && !CreateD3D12GpuPassQueries())
+		{
+			return kInvalidGpuPassQuery;
+		}
+
+		const UInt query_index = static_cast<UInt>(m_gpu_pass_query_names.size());
+		m_gpu_pass_query_names.push_back(name);
+		command_list->EndQuery(m_d3d12_timestamp_query_heap, D3D12_QUERY_TYPE_TIMESTAMP, query_index * 2);
+		command_list->BeginQuery(m_d3d12_pipeline_statistics_query_heap, D3D12_QUERY_TYPE_PIPELINE_STATISTICS, query_index);
+		return query_index;
+	}
+
+	void DolasRHI::EndGpuPassQuery(UInt query_index)
+	{
+		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+		ID3D12GraphicsCommandList* command_list = rhi ? rhi->GetCommandList() : nullptr;
+		if (query_index >= m_gpu_pass_query_names.size() || !command_list)
+		{
+			return;
+		}
+		command_list->EndQuery(m_d3d12_pipeline_statistics_query_heap, D3D12_QUERY_TYPE_PIPELINE_STATISTICS, query_index);
+		command_list->EndQuery(m_d3d12_timestamp_query_heap, D3D12_QUERY_TYPE_TIMESTAMP, query_index * 2 + 1);
+	}
+
+	Bool DolasRHI::CreateD3D12GpuPassQueries()
+	{
+		if (m_gpu_pass_queries_unavailable)
+		{
+			return false;
+		}
+
+		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+		ID3D12Device* device = rhi ? rhi->GetDevice() : nullptr;
+		DOLAS_RETURN_FALSE_IF_NULL(device);
+
+		D3D12_QUERY_HEAP_DESC timestamp_heap_desc = {};
+		timestamp_heap_desc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+		timestamp_heap_desc.Count = kD3D12TimestampQueryCount;
+		D3D12_QUERY_HEAP_DESC pipeline_statistics_heap_desc = {};
+		pipeline_statistics_heap_desc.Type = D3D12_QUERY_HEAP_TYPE_PIPELINE_STATISTICS;
+		pipeline_statistics_heap_desc.Count = kMaxGpuPassQueryCount;
+		if (FAILED(device->CreateQueryHeap(&timestamp_heap_desc, IID_PPV_ARGS(&m_d3d12_timestamp_query_heap))) ||
+			FAILED(device->CreateQueryHeap(&pipeline_statistics_heap_desc, IID_PPV_ARGS(&m_d3d12_pipeline_statistics_query_heap))) ||
+			!CreateD3D12ReadbackBuffer(device, kD3D12QueryReadbackSize, &m_d3d12_query_readback_buffer))
+		{
+			LOG_WARN("DolasRHI: failed to create GPU pass queries, GPU pass statistics are disabled.");
+			SafeRelease(m_d3d12_timestamp_query_heap);
+			SafeRelease(m_d3d12_pipeline_statistics_query_heap);
+			SafeRelease(m_d3d12_query_readback_buffer);
+			m_gpu_pass_queries_unavailable = true;
+			return false;
+		}
+		return true;
+	}
+
+	void DolasRHI::ResolveD3D12GpuPassQueries()
+	{
+		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+		ID3D12GraphicsCommandList* command_list = rhi ? rhi->GetCommandList() : nullptr;
+		const UINT query_count = static_cast<UINT>(m_gpu_pass_query_names.size());
+		if (!command_list || query_count == 0 || !m_d3d12_query_readback_buffer)
+		{
+			return;
+		}
+		command_list->ResolveQueryData(m_d3d12_timestamp_query_heap, D3D12_QUERY_TYPE_TIMESTAMP, 0, query_count * 2, m_d3d12_query_readback_buffer, 0);
+		command_list->ResolveQueryData(m_d3d12_pipeline_statistics_query_heap, D3D12_QUERY_TYPE_PIPELINE_STATISTICS, 0, query_count, m_d3d12_query_readback_buffer, kD3D12PipelineStatisticsReadbackOffset);
+	}
+
+	void DolasRHI::ReadBackD3D12GpuPassQueries()
+	{
+		m_last_frame_gpu_pass_statistics.clear();
+		RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+		ID3D12CommandQueue* command_queue = rhi ? rhi->GetCommandQueue() : nullptr;
+		const UInt query_count = static_cast<UInt>(m_gpu_pass_query_names.size());
+		if (!command_queue || query_count == 0 || !m_d3d12_query_readback_buffer)
+		{
+			return;
+		}
+
+		UINT64 timestamp_frequency = 0;
+		if (FAILED(command_queue->GetTimestampFrequency(&timestamp_frequency)) || timestamp_frequency == 0)
+		{
+			return;
+		}
+
+		const D3D12_RANGE read_range = { 0, kD3D12QueryReadbackSize };
+		void* mapped_data = nullptr;
+		if (FAILED(m_d3d12_query_readback_buffer->Map(0, &read_range, &mapped_data)))
+		{
+			return;
+		}
+
+		const UINT64* timestamps = static_cast<const UINT64*>(mapped_data);
+		const D3D12_QUERY_DATA_PIPELINE_STATISTICS* pipeline_statistics = reinterpret_cast<const D3D12_QUERY_DATA_PIPELINE_STATISTICS*>(
+			static_cast<const UByte*>(mapped_data) + kD3D12PipelineStatisticsReadbackOffset);
+		m_last_frame_gpu_pass_statistics.resize(query_count);
+		for (UInt query_index = 0; query_index < query_count; ++query_index)
+		{
+			RHIGpuPassStatistics& statistics = m_last_frame_gpu_pass_statistics[query_index];
+			statistics.name = m_gpu_pass_query_names[query_index];
+			const UINT64 begin_timestamp = timestamps[query_index * 2];
+			const UINT64 end_timestamp = timestamps[query_index * 2 + 1];
+			statistics.gpu_milliseconds = end_timestamp > begin_timestamp
+				? static_cast<Double>(end_timestamp - begin_timestamp) * 1000.0 / static_cast<Double>(timestamp_frequency)
+				: 0.0;
+			statistics.rasterized_primitives = pipeline_statistics[query_index].CPrimitives;
+			statistics.pixel_shader_invocations = pipeline_statistics[query_index].PSInvocations;
+		}
+
+		const D3D12_RANGE written_range = { 0, 0 };
+		m_d3d12_query_readback_buffer->Unmap(0, &written_range);
+	}
+
+	PipelineStateLibraryStatistics DolasRHI::GetPipelineStateLibraryStatistics() const
+	{
+		return m_pipeline_state_library.GetStatistics();
+	}
+
 	void DolasRHI::RenderImGuiDrawData()
 	{
 		g_dolas_engine.m_imgui_manager->RenderDrawData(g_dolas_engine.m_render_hardware_interface->GetCommandList());
+		// ImGui 后端会设置自己的根签名和 PSO
+		ResetD3D12BindingCache();
 	}
 
 } // namespace Dolas
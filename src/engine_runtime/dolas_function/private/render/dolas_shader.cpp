@@ -16,7 +16,10 @@
 #include "render/dolas_dx_trace.h"
 #include "dolas_paths.h"
 #include "manager/dolas_texture_manager.h"
+#include "render/dolas_buffer.h"
 #include "dolas_log_system_manager.h"
+#include "dolas_shader_build.h"
+#include "dolas_shader_permutation.h"
 namespace Dolas
 {
     namespace
@@ -106,6 +109,36 @@ namespace Dolas
             resource->Unmap(0, &written_range);
             return true;
         }
+
+        // bindless 纹理需要 SM5.1 的无界 descriptor 数组；D3D11 兼容设备只能加载 SM5.0 字节码，
+        // 因此 bindless 模式下只编译 D3D12 使用的字节码，不再创建 D3D11 shader 对象，DolasRHI 也不再向 D3D11 镜像 draw
+        bool IsBindlessShaderCompile()
+        {
+            return g_dolas_engine.m_rhi && g_dolas_engine.m_rhi->IsBindlessTextureEnabled();
+        }
+
+        // 以 nullptr 结尾的宏数组，字符串指向 defines 中的元素，defines 需要在编译结束前保持有效
+        std::vector<D3D_SHADER_MACRO> MakeShaderCompileMacros(const std::vector<std::pair<std::string, std::string>>& defines)
+        {
+            std::vector<D3D_SHADER_MACRO> macros;
+            macros.reserve(defines.size() + 1);
+            for (const auto& define : defines)
+            {
+                macros.push_back({ define.first.c_str(), define.second.c_str() });
+            }
+            macros.push_back({ nullptr, nullptr });
+            return macros;
+        }
+
+        UINT GetShaderCompileFlags()
+        {
+            UINT flags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+            if (IsBindlessShaderCompile())
+            {
+                flags |= D3DCOMPILE_ENABLE_UNBOUNDED_DESCRIPTOR_TABLES;
+            }
+            return flags;
+        }
     }
 
     // Custom include handler to search files under PathUtils::GetShadersSourceDir()
@@ -209,6 +242,22 @@ namespace Dolas
         }
         m_slot_to_d3d12_srv_map.clear();
         m_slot_to_d3d12_srv_cpu_map.clear();
+
+        // 常驻 SRV table 归还给 descriptor 空闲链表，重新使用这个 context 时由 PrepareD3D12SrvTable 重新分配
+        RenderHardwareInterface* render_hardware_interface = g_dolas_engine.m_render_hardware_interface;
+        if (render_hardware_interface && m_d3d12_srv_table_gpu.ptr != 0)
+        {
+            render_hardware_interface->FreeSrvDescriptorTable(kD3D12SrvTableSize, m_d3d12_srv_table_cpu, m_d3d12_srv_table_gpu);
+        }
+        m_d3d12_srv_table_cpu = {};
+        m_d3d12_srv_table_gpu = {};
+        for (D3D12_CPU_DESCRIPTOR_HANDLE& source : m_d3d12_srv_table_sources)
+        {
+            source = {};
+        }
+        m_d3d12_srv_table_content_generation = 0;
+        m_d3d12_srv_table_valid = false;
+        m_d3d12_srv_table_last_bound_frame = 0;
 	}
 
 	ShaderBytecodeView ShaderContext::GetShaderBytecode() const
@@ -267,6 +316,27 @@ namespace Dolas
 		}
 	}
 
+	void ShaderContext::AnalyzeBoundResources(UInt bound_resources_count)
+	{
+		for (UInt resource_index = 0; resource_index < bound_resources_count; ++resource_index)
+		{
+			D3D11_SHADER_INPUT_BIND_DESC bind_desc = {};
+			if (FAILED(m_d3d_shader_reflection->GetResourceBindingDesc(static_cast<UINT>(resource_index), &bind_desc)))
+			{
+				LOG_ERROR("Failed to get bound resource {0} of shader {1}", resource_index, m_file_path);
+				continue;
+			}
+
+			ShaderBoundResourceInfo resource_info;
+			resource_info.name = bind_desc.Name ? bind_desc.Name : "";
+			resource_info.type = static_cast<UInt>(bind_desc.Type);
+			resource_info.dimension = static_cast<UInt>(bind_desc.Dimension);
+			resource_info.bind_point = bind_desc.BindPoint;
+			resource_info.bind_count = bind_desc.BindCount;
+			m_shader_reflection_info.bound_resource_descs.push_back(std::move(resource_info));
+		}
+	}
+
 	void ShaderContext::GenerateReflectionAndDesc()
 	{
 		HR(D3DReflect(m_d3d_shader_blob->GetBufferPointer(), m_d3d_shader_blob->GetBufferSize(), IID_ID3D11ShaderReflection, (void**)&m_d3d_shader_reflection));
@@ -278,6 +348,7 @@ namespace Dolas
 		m_shader_reflection_info.instruction_count = shader_desc.InstructionCount;
 
 		AnalyzeConstantBuffers(m_shader_reflection_info.constant_buffer_count);
+		AnalyzeBoundResources(m_shader_reflection_info.bound_resource_count);
 
 		// HR(m_d3d_shader_reflection->GetConstant(&m_shader_desc));
 		// HR(m_d3d_shader_reflection->GetDesc(&m_shader_desc));
@@ -310,15 +381,20 @@ namespace Dolas
 			}
 		}
 
+        m_global_cb_layout.Clear();
+        m_global_cb_data.Resize(0);
 		if (!target_cb_info)
 		{
 			// 当前 shader 没有 GlobalConstants，就什么都不做
 			return;
 		}
 
-        // 初始化 CPU 端缓存区，用来存放 GlobalConstants 的原始字节数据
-        m_global_cb_data.clear();
-        m_global_cb_data.resize(target_cb_info->size);
+        // 变量名 -> (offset, size) 的索引与 CPU 端缓存区（整块标记为脏，第一次绑定时上传）
+        if (!m_global_cb_layout.Build(*target_cb_info))
+        {
+            LOG_WARN("GlobalConstants of shader {0} has variables with colliding name hashes", m_file_path);
+        }
+        m_global_cb_data.Resize(target_cb_info->size);
 
 		ID3D11Device* device = g_dolas_engine.m_rhi->GetD3D11Device();
         if (device)
@@ -340,9 +416,9 @@ namespace Dolas
         {
             const uint32_t d3d12_cb_size = AlignTo(target_cb_info->size, 256);
             std::vector<uint8_t> d3d12_initial_data(d3d12_cb_size, 0);
-            if (!m_global_cb_data.empty())
+            if (!m_global_cb_data.IsEmpty())
             {
-                memcpy(d3d12_initial_data.data(), m_global_cb_data.data(), m_global_cb_data.size());
+                memcpy(d3d12_initial_data.data(), m_global_cb_data.GetBytes().data(), m_global_cb_data.GetBytes().size());
             }
 
             if (!CreateD3D12UploadBuffer(d3d12_device, d3d12_cb_size, d3d12_initial_data.data(), &m_d3d12_global_constant_buffer))
@@ -356,10 +432,61 @@ namespace Dolas
 
 	void ShaderContext::PostBuildFromFile()
 	{
+		const ShaderBytecodeView bytecode = GetShaderBytecode();
+		m_shader_bytecode_hash = HashConverter::BytesHash64(bytecode.data, bytecode.size);
 		GenerateReflectionAndDesc();
 		CreateGlobalConstantBuffer();
 	}
 
+	bool ShaderContext::LoadFromBytecode(const std::string& file_path, const std::string& entry_point, const void* bytecode, size_t bytecode_size, const ShaderReflectionInfo* reflection)
+	{
+		m_entry_point = entry_point;
+		m_file_path = file_path;
+		if (!bytecode || bytecode_size == 0 || FAILED(D3DCreateBlob(bytecode_size, &m_d3d_shader_blob)))
+		{
+			return false;
+		}
+		memcpy(m_d3d_shader_blob->GetBufferPointer(), bytecode, bytecode_size);
+
+		if (!CreateD3DShaderObject())
+		{
+			return false;
+		}
+
+		if (!reflection)
+		{
+			PostBuildFromFile();
+			return true;
+		}
+		m_shader_bytecode_hash = HashConverter::BytesHash64(bytecode, bytecode_size);
+		m_shader_reflection_info = *reflection;
+		CreateGlobalConstantBuffer();
+		return true;
+	}
+
+	void ShaderContext::SetShaderKeywords(const std::vector<std::string>& keywords)
+	{
+		m_shader_keywords = keywords;
+		std::sort(m_shader_keywords.begin(), m_shader_keywords.end());
+		m_shader_keywords.erase(std::unique(m_shader_keywords.begin(), m_shader_keywords.end()), m_shader_keywords.end());
+		m_permutation_key = ComputeShaderPermutationKey(m_shader_keywords);
+	}
+
+	std::vector<std::pair<std::string, std::string>> ShaderContext::GetCompileDefineList() const
+	{
+		std::vector<std::pair<std::string, std::string>> defines = MakeShaderKeywordDefines(m_shader_keywords);
+		if (IsBindlessShaderCompile())
+		{
+			defines.emplace_back("DOLAS_BINDLESS_TEXTURES", "1");
+		}
+		return defines;
+	}
+
+	std::string ShaderContext::GetCompileDefines() const
+	{
+		return MakeShaderDefinesString(GetCompileDefineList());
+	}
+
 	void ShaderContext::SetShaderResourceView(size_t slot, ID3D11ShaderResourceView* srv)
 	{
 		DOLAS_RETURN_IF_NULL(srv);
@@ -399,6 +526,21 @@ namespace Dolas
         }
 	}
 
+	void ShaderContext::SetShaderResourceView(size_t slot, Buffer* buffer)
+	{
+		DOLAS_RETURN_IF_NULL(buffer);
+
+        if (ID3D11ShaderResourceView* srv = buffer->GetShaderResourceView())
+        {
+            m_slot_to_srv_map[slot] = srv;
+        }
+        if (buffer->HasD3D12Srv())
+        {
+            m_slot_to_d3d12_srv_cpu_map[slot] = buffer->GetD3D12SrvCpuHandle();
+            m_slot_to_d3d12_srv_map[slot] = buffer->GetD3D12SrvGpuHandle();
+        }
+	}
+
 	void ShaderContext::dumpShaderReflectionInfo() const
 	{
 		LOG_INFO("file = {0}, entry = {1}", m_file_path, m_entry_point);
@@ -461,57 +603,78 @@ namespace Dolas
 
     void ShaderContext::SetGlobalVariable(const std::string& name, const Vector4& values)
     {
-        if (m_global_cb_data.empty())
-        {
-            // 当前 shader 没有 GlobalConstants，忽略
-            return;
-        }
+        SetGlobalVariable(FindGlobalVariable(name), values);
+    }
 
-        // 找到 GlobalConstants 中同名变量的布局信息
-        const char* kGlobalCBName = "GlobalConstants";
-        const ConstantBufferInfo* target_cb_info = nullptr;
-        for (const auto& cb_info : m_shader_reflection_info.constant_buffer_descs)
-        {
-            if (cb_info.name == kGlobalCBName)
-            {
-                target_cb_info = &cb_info;
-                break;
-            }
-        }
-        if (!target_cb_info)
-        {
-            return;
-        }
+    void ShaderContext::SetGlobalVariable(const std::string& name, UInt value)
+    {
+        SetGlobalVariable(FindGlobalVariable(name), value);
+    }
 
-        for (const auto& var_desc : target_cb_info->variable_descs)
-        {
-            if (name != var_desc.name)
-            {
-                continue;
-            }
+    void ShaderContext::SetGlobalVariable(const std::string& name, const Matrix4x4* matrices, UInt count)
+    {
+        SetGlobalVariable(FindGlobalVariable(name), matrices, count);
+    }
 
-            // 计算要拷贝的字节数（不超过变量大小）
-            size_t src_bytes = sizeof(Vector4);
-            size_t copy_bytes = std::min<size_t>(src_bytes, var_desc.size);
+    void ShaderContext::SetGlobalVariable(const std::string& name, const Vector4* values, UInt count)
+    {
+        SetGlobalVariable(FindGlobalVariable(name), values, count);
+    }
 
-            if (copy_bytes == 0)
-            {
-                return;
-            }
+    void ShaderContext::SetGlobalVariable(ConstantBufferVariableHandle handle, const Vector4& values)
+    {
+        m_global_cb_data.Write(handle, &values, sizeof(Vector4));
+    }
 
-            // 写入到 CPU 端 Global CB 缓冲区中相应的偏移位置
-            uint8_t* dst = m_global_cb_data.data() + var_desc.start_offset;
-            std::memcpy(dst, &values, copy_bytes);
-            if (m_d3d12_global_constant_buffer)
-            {
-                UpdateD3D12UploadBuffer(
-                    m_d3d12_global_constant_buffer,
-                    &values,
-                    static_cast<uint32_t>(copy_bytes),
-                    var_desc.start_offset);
-            }
-            return;
-        }
+    void ShaderContext::SetGlobalVariable(ConstantBufferVariableHandle handle, UInt value)
+    {
+        m_global_cb_data.Write(handle, &value, sizeof(UInt));
+    }
+
+    void ShaderContext::SetGlobalVariable(ConstantBufferVariableHandle handle, const Matrix4x4* matrices, UInt count)
+    {
+        m_global_cb_data.Write(handle, matrices, sizeof(Matrix4x4) * count);
+    }
+
+    void ShaderContext::SetGlobalVariable(ConstantBufferVariableHandle handle, const Vector4* values, UInt count)
+    {
+        m_global_cb_data.Write(handle, values, sizeof(Vector4) * count);
+    }
+
+    void ShaderContext::SetGlobalConstants(const UByte* data, UInt size)
+    {
+        const ConstantBufferVariableHandle whole_buffer{ 0, static_cast<UInt>(m_global_cb_data.GetBytes().size()) };
+        m_global_cb_data.Write(whole_buffer, data, size);
+    }
+
+	UInt ShaderContext::UploadGlobalConstants(ID3D11DeviceContext* d3d11_context)
+	{
+		if (!m_global_cb_data.IsDirty())
+		{
+			return 0;
+		}
+
+		const std::vector<UByte>& bytes = m_global_cb_data.GetBytes();
+		const UInt dirty_begin = m_global_cb_data.GetDirtyBegin();
+		const UInt dirty_size = m_global_cb_data.GetDirtyEnd() - dirty_begin;
+		UInt uploaded_bytes = 0;
+		if (m_d3d12_global_constant_buffer && UpdateD3D12UploadBuffer(m_d3d12_global_constant_buffer, bytes.data() + dirty_begin, dirty_size, dirty_begin))
+		{
+			uploaded_bytes += dirty_size;
+		}
+
+		// D3D11 的动态缓冲区只能 WRITE_DISCARD，需要整块重写
+		if (d3d11_context && m_global_constant_buffer)
+		{
+			D3D11_MAPPED_SUBRESOURCE mapped_data;
+			HR(d3d11_context->Map(m_global_constant_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_data));
+			memcpy_s(mapped_data.pData, bytes.size(), bytes.data(), bytes.size());
+			d3d11_context->Unmap(m_global_constant_buffer, 0);
+			uploaded_bytes += static_cast<UInt>(bytes.size());
+		}
+
+		m_global_cb_data.ClearDirty();
+		return uploaded_bytes;
 	}
 
 	VertexContext::VertexContext()
@@ -530,13 +693,15 @@ namespace Dolas
 		m_file_path = file_path;
 		ID3DBlob* error_blob = nullptr;
         DolasShaderInclude include_handler;
+		const std::vector<std::pair<std::string, std::string>> defines = GetCompileDefineList();
+		const std::vector<D3D_SHADER_MACRO> macros = MakeShaderCompileMacros(defines);
 		HR(D3DCompileFromFile(
 			StringUtil::StringToWString(file_path).c_str(), // file path
-			nullptr, // macros
+			macros.data(), // macros
 			&include_handler, // include
 			entry_point.c_str(), // entry point
-			"vs_5_0", // shader model
-			D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION, // flags
+			GetCompileTarget().c_str(), // shader model
+			GetShaderCompileFlags(), // flags
 			0, // effect flags
 			&m_d3d_shader_blob, // shader blob
 			&error_blob)); // error blob
@@ -549,12 +714,21 @@ namespace Dolas
 			return false;
 		}
 
+		return CreateD3DShaderObject();
+	}
+
+	std::string VertexContext::GetCompileTarget() const
+	{
+		return IsBindlessShaderCompile() ? "vs_5_1" : "vs_5_0";
+	}
+
+	bool VertexContext::CreateD3DShaderObject()
+	{
 		ID3D11Device* device = g_dolas_engine.m_rhi->GetD3D11Device();
-        if (device)
+        if (device && !IsBindlessShaderCompile())
         {
             HR(device->CreateVertexShader(m_d3d_shader_blob->GetBufferPointer(), m_d3d_shader_blob->GetBufferSize(), nullptr, &m_d3d_vertex_shader));
         }
-
 		return true;
 	}
 
@@ -589,13 +763,15 @@ namespace Dolas
 		m_file_path = file_path;
 		ID3DBlob* error_blob = nullptr;
         DolasShaderInclude include_handler;
+		const std::vector<std::pair<std::string, std::string>> defines = GetCompileDefineList();
+		const std::vector<D3D_SHADER_MACRO> macros = MakeShaderCompileMacros(defines);
 		HR(D3DCompileFromFile(
 			StringUtil::StringToWString(file_path).c_str(), // file path
-			nullptr, // macros
+			macros.data(), // macros
 			&include_handler, // include
 			entry_point.c_str(), // entry point
-			"ps_5_0", // shader model
-			D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION, // flags
+			GetCompileTarget().c_str(), // shader model
+			GetShaderCompileFlags(), // flags
 			0, // effect flags
 			&m_d3d_shader_blob, // shader blob
 			&error_blob)); // error blob
@@ -608,12 +784,21 @@ namespace Dolas
 			return false;
 		}
 
+		return CreateD3DShaderObject();
+	}
+
+	std::string PixelContext::GetCompileTarget() const
+	{
+		return IsBindlessShaderCompile() ? "ps_5_1" : "ps_5_0";
+	}
+
+	bool PixelContext::CreateD3DShaderObject()
+	{
 		ID3D11Device* device = g_dolas_engine.m_rhi->GetD3D11Device();
-        if (device)
+        if (device && !IsBindlessShaderCompile())
         {
             HR(device->CreatePixelShader(m_d3d_shader_blob->GetBufferPointer(), m_d3d_shader_blob->GetBufferSize(), nullptr, &m_d3d_pixel_shader));
         }
-
 		return true;
 	}
 
@@ -1,6 +1,7 @@
 #include "render/dolas_texture.h"
 #include "dolas_engine.h"
 #include "render/dolas_rhi.h"
+#include "dolas_render_hardware_interface.h"
 #include <d3d11.h>
 #include <iostream>
 // #include <DirectXTex.h>
@@ -20,6 +21,18 @@ namespace Dolas
 
     void Texture::Release()
     {
+        InvalidateViews();
+
+        // descriptor 归还给 RHI 的空闲链表；引擎退出时 heap 已先于纹理释放，此时 Free* 什么也不做。
+        // SRV 的释放会推进分配器的释放代数，拷贝过这个 descriptor 的常驻 SRV table 在下次绑定时重建
+        RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+        if (rhi)
+        {
+            rhi->FreeRtvDescriptor(m_d3d12_rtv_handle);
+            rhi->FreeDsvDescriptor(m_d3d12_dsv_handle);
+            rhi->FreeSrvDescriptor(m_d3d12_srv_cpu_handle, m_d3d12_srv_gpu_handle);
+        }
+
         if (m_d3d_texture_2d)
         {
             m_d3d_texture_2d->Release();
@@ -43,6 +56,7 @@ namespace Dolas
         m_d3d12_srv_gpu_handle = {};
         m_d3d12_rtv_handle = {};
         m_d3d12_dsv_handle = {};
+        m_bindless_index = 0;
     }
 
     ID3D11ShaderResourceView* Texture::GetShaderResourceView()
@@ -54,4 +68,59 @@ namespace Dolas
         return m_d3d_shader_resource_view;
     }
 
+    uint64_t Texture::MakeViewKey(uint32_t format, uint32_t mip_slice, uint32_t array_slice)
+    {
+        return (static_cast<uint64_t>(format) << 32) |
+            (static_cast<uint64_t>(mip_slice & 0xFFFFu) << 16) |
+            static_cast<uint64_t>(array_slice & 0xFFFFu);
+    }
+
+    std::shared_ptr<RenderTargetView> Texture::FindRenderTargetView(uint64_t view_key) const
+    {
+        auto iter = m_render_target_views.find(view_key);
+        return iter != m_render_target_views.end() ? iter->second : nullptr;
+    }
+
+    std::shared_ptr<DepthStencilView> Texture::FindDepthStencilView(uint64_t view_key) const
+    {
+        auto iter = m_depth_stencil_views.find(view_key);
+        return iter != m_depth_stencil_views.end() ? iter->second : nullptr;
+    }
+
+    void Texture::AddRenderTargetView(uint64_t view_key, const std::shared_ptr<RenderTargetView>& render_target_view)
+    {
+        m_render_target_views[view_key] = render_target_view;
+    }
+
+    void Texture::AddDepthStencilView(uint64_t view_key, const std::shared_ptr<DepthStencilView>& depth_stencil_view)
+    {
+        m_depth_stencil_views[view_key] = depth_stencil_view;
+    }
+
+    void Texture::InvalidateViews()
+    {
+        // 默认视图直接使用纹理创建时分配的 descriptor，只有子资源/别名格式视图的 descriptor 归视图所有
+        RenderHardwareInterface* rhi = g_dolas_engine.m_render_hardware_interface;
+        for (auto& view_pair : m_render_target_views)
+        {
+            const D3D12_CPU_DESCRIPTOR_HANDLE handle = view_pair.second->m_d3d12_render_target_view;
+            if (rhi && handle.ptr != 0 && handle.ptr != m_d3d12_rtv_handle.ptr)
+            {
+                rhi->FreeRtvDescriptor(handle);
+            }
+            view_pair.second->m_d3d12_render_target_view = {};
+        }
+        for (auto& view_pair : m_depth_stencil_views)
+        {
+            const D3D12_CPU_DESCRIPTOR_HANDLE handle = view_pair.second->m_d3d12_depth_stencil_view;
+            if (rhi && handle.ptr != 0 && handle.ptr != m_d3d12_dsv_handle.ptr)
+            {
+                rhi->FreeDsvDescriptor(handle);
+            }
+            view_pair.second->m_d3d12_depth_stencil_view = {};
+        }
+        m_render_target_views.clear();
+        m_depth_stencil_views.clear();
+    }
+
 } // namespace Dolas
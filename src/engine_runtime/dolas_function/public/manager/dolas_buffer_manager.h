@@ -32,6 +32,9 @@ namespace Dolas
         
         // 获取已存在的缓冲区
         Buffer* GetBufferByID(BufferID buffer_id);
+
+        // 释放缓冲区；调用方需保证 GPU 已不再使用它
+        bool DestroyBuffer(BufferID buffer_id);
         
         // 获取缓冲区统计信息
         size_t GetBufferCount() const { return m_buffers.size(); }
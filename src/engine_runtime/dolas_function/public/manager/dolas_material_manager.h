@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <memory>
 #include <array>
+#include <vector>
 #include "dolas_base.h"
 #include "dolas_hash.h"
 namespace Dolas
@@ -19,6 +20,7 @@ namespace Dolas
         DeferredShading,
         SkyBox,
         DebugDraw,
+        DepthOnly,
         Count
     };
 
@@ -34,8 +36,8 @@ namespace Dolas
         Material* GetGlobalMaterial(GlobalMaterialType global_material_type);
     private:
         bool InitializeGlobalMaterials();
-        std::shared_ptr<VertexContext> CreateVertexContext(const AssetPath& asset_path, const std::string& entry_point);
-        std::shared_ptr<PixelContext>  CreatePixelContext(const AssetPath& asset_path, const std::string& entry_point);
+        std::shared_ptr<VertexContext> CreateVertexContext(const AssetPath& asset_path, const std::string& entry_point, const std::vector<std::string>& keywords);
+        std::shared_ptr<PixelContext>  CreatePixelContext(const AssetPath& asset_path, const std::string& entry_point, const std::vector<std::string>& keywords);
 
         std::unordered_map<MaterialID, Material*> m_materials;
         std::array<MaterialID, static_cast<UInt>(GlobalMaterialType::Count)> m_global_materials{};
@@ -5,9 +5,12 @@
 #include <memory>
 #include "render/dolas_rhi_common.h"
 #include "dolas_hash.h"
+#include "dolas_mesh_lod.h"
 namespace Dolas
 {
     class AssetPath;
+    struct MeshAssetDesc;
+    struct MeshletData;
     class RenderPrimitive;
 
 	enum BaseGeometryType : UInt
@@ -35,18 +38,24 @@ namespace Dolas
 		// @param input_layout_type: Specifies the input layout of the RenderPrimitive to be created
 		// @param vertices: Providing vertex data
 		// @param indices: Providing index data
+		// @param lods: Optional simplified index lists (LOD1..N) referencing the same vertices
         Bool CreateRenderPrimitive(
             RenderPrimitiveID id,
             const PrimitiveTopology& render_primitive_type,
             const InputLayoutType& input_layout_type,
             const std::vector<std::vector<Float>>& vertices,
-            const std::vector<UInt>& indices);
+            const std::vector<UInt>& indices,
+            const std::vector<MeshLOD>& lods = {});
 
 		RenderPrimitiveID GetGeometryRenderPrimitiveID(BaseGeometryType geometry_type);
         RenderPrimitive* GetRenderPrimitiveByID(RenderPrimitiveID render_primitive_id) const;
 
         // 从 .mesh 文件创建 RenderPrimitive，返回对应的 RenderPrimitiveID
         RenderPrimitiveID CreateRenderPrimitiveFromMeshFile(const AssetPath& asset_path);
+
+        // 没有离线烘焙 meshlet 的 .mesh 在加载时现场切分（只影响之后加载的网格）
+        void SetBuildMeshletsOnLoad(Bool enabled) { m_build_meshlets_on_load = enabled; }
+        Bool IsBuildMeshletsOnLoad() const { return m_build_meshlets_on_load; }
     private:
 		Bool InitializeSphereGeometry();
 		Bool InitializeQuadGeometry();
@@ -58,14 +67,19 @@ namespace Dolas
 		Bool GenerateCylinderRawData(std::vector<std::vector<Float>>& vertices_data, std::vector<UInt>& indices);
 		Bool GenerateCubeRawData(std::vector<std::vector<Float>>& vertices_data, std::vector<UInt>& indices);
 
+        // 校验并转换 .mesh 中离线烘焙的 meshlet
+        static Bool LoadCookedMeshlets(const MeshAssetDesc& mesh_desc, MeshletData& out_meshlets);
+
         RenderPrimitive* BuildFromRawData(
 			const PrimitiveTopology& render_primitive_type,
 			const InputLayoutType& input_layout_type,
 			const std::vector<std::vector<Float>>& vertices,
-			const std::vector<UInt>& indices);
+			const std::vector<UInt>& indices,
+			const std::vector<MeshLOD>& lods);
 
         std::unordered_map<RenderPrimitiveID, RenderPrimitive*> m_render_primitives;
         std::unordered_map<BaseGeometryType, RenderPrimitiveID> m_base_geometries;
+        Bool m_build_meshlets_on_load = false;
     }; // class RenderPrimitiveManager
 }
 
@@ -1,6 +1,7 @@
 #ifndef DOLAS_RENDER_RESOURCE_MANAGER_H
 #define DOLAS_RENDER_RESOURCE_MANAGER_H
 
+#include <vector>
 #include "dolas_hash.h"
 #include "render/dolas_render_resource.h"
 
@@ -15,6 +16,11 @@ namespace Dolas
         Bool Clear();
         RenderResource* GetRenderResourceByID(RenderResourceID render_resource_id);
         Bool CreateRenderResourceByID(RenderResourceID render_resource_id);
+        Bool CreateRenderResourceByID(RenderResourceID render_resource_id, UInt width, UInt height);
+        // 按渲染图编译出的堆内偏移（下标与 GetTransientTextures 一致）把瞬态 render target 重建为同一个 RT/DS 堆中的
+        // placed resource，生命周期不重叠的纹理共用内存。布局不变时直接返回；失败时退回独立分配并不再重试。
+        // 须在帧开始、任何 pass 使用这些纹理之前调用（上一帧的 GPU 工作已完成）
+        Bool PlaceTransientTextures(RenderResourceID render_resource_id, const std::vector<ULongLong>& heap_offsets, ULongLong heap_size);
     protected:
         std::unordered_map<RenderResourceID, RenderResource*> m_render_resources;
     };
@@ -4,11 +4,25 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 #include "render/dolas_shader.h"
+#include "dolas_shader_build.h"
+#include "dolas_shader_permutation.h"
 
 namespace Dolas
 {
     class AssetPath;
+
+    // shader 的来源与耗时：预编译的 bytecode 只需读文件与创建对象，运行时编译需要 D3DCompile + D3DReflect
+    struct ShaderLoadStatistics
+    {
+        UInt precompiled_count = 0;
+        UInt runtime_compiled_count = 0;
+        UInt stale_count = 0;                       // 清单中有记录，但源文件在离线编译之后被修改（只在开发构建中检查）
+        Double precompiled_milliseconds = 0.0;
+        Double runtime_compile_milliseconds = 0.0;
+    };
+
     class ShaderManager
     {
     public:
@@ -17,18 +31,37 @@ namespace Dolas
         bool Initialize();
         bool Clear();
 
-        // 返回可共享的 Vertex/Pixel 上下文，内部通过缓存避免重复创建底层 D3D shader
-        std::shared_ptr<VertexContext> GetOrCreateVertexContext(const AssetPath& asset_path, const std::string& entry_point);
-        std::shared_ptr<PixelContext>  GetOrCreatePixelContext(const AssetPath& asset_path, const std::string& entry_point);
+        // 返回可共享的 Vertex/Pixel 上下文，内部通过缓存避免重复创建底层 D3D shader。
+        // keywords 为材质启用的 shader keyword，只有 shader 中声明过的才参与编译，相同的组合共享同一个变体
+        std::shared_ptr<VertexContext> GetOrCreateVertexContext(const AssetPath& asset_path, const std::string& entry_point, const std::vector<std::string>& keywords = {});
+        std::shared_ptr<PixelContext>  GetOrCreatePixelContext(const AssetPath& asset_path, const std::string& entry_point, const std::vector<std::string>& keywords = {});
         void                           dumpShaderReflectionInfos() const;
+        const ShaderLoadStatistics&    GetLoadStatistics() const { return m_load_statistics; }
+        void                           LogLoadStatistics() const;
     private:
-        VertexContext* CreateVertexShader(const AssetPath& asset_path, const std::string& entry_point);
-        PixelContext*  CreatePixelShader(const AssetPath& asset_path, const std::string& entry_point);
-        std::string    GenerateShaderKey(const AssetPath& asset_path, const std::string& entry_point);
+        VertexContext* CreateVertexShader(const std::string& shader_file_path, const std::string& entry_point, const std::vector<std::string>& keywords);
+        PixelContext*  CreatePixelShader(const std::string& shader_file_path, const std::string& entry_point, const std::vector<std::string>& keywords);
+        // 路径 + 入口 + permutation key 组成的 64 位缓存键
+        ULongLong      GenerateShaderKey(const AssetPath& asset_path, const std::string& entry_point, ShaderPermutationKey permutation_key);
+        // 按 shader 源文件中的 #pragma dolas_keywords 声明筛选材质请求的 keyword
+        void           ResolveShaderKeywords(const std::string& shader_file_path, const std::vector<std::string>& requested, std::vector<std::string>& out_keywords);
+        // 优先加载离线编译的变体，没有或已过期时运行时编译
+        bool           BuildShaderContext(ShaderContext* shader_context, const std::string& shader_file_path, const std::string& entry_point);
+        bool           LoadPrecompiledShader(ShaderContext* shader_context, const std::string& shader_file_path, const std::string& entry_point);
 
         // ShaderManager 持有共享的底层着色器对象（VertexShader / PixelShader）
-        std::unordered_map<std::string, VertexShader*> m_vertex_shaders;
-        std::unordered_map<std::string, PixelShader*>  m_pixel_shaders;
+        std::unordered_map<ULongLong, VertexShader*> m_vertex_shaders;
+        std::unordered_map<ULongLong, PixelShader*>  m_pixel_shaders;
+        // 源文件路径 -> keyword 声明，每个 shader 文件只解析一次
+        std::unordered_map<std::string, ShaderKeywordDeclaration> m_keyword_declarations;
+
+        // PathUtils::GetCompiledShadersDir() 下的编译清单
+        ShaderBuildManifest   m_precompiled_manifest;
+        bool                  m_precompiled_manifest_loaded = false;
+        // 开发构建中按 include 依赖图重新计算输入哈希，源文件改过的变体回退到运行时编译
+        bool                  m_check_precompiled_staleness = false;
+        ShaderDependencyGraph m_shader_source_graph;
+        ShaderLoadStatistics  m_load_statistics;
     }; // class ShaderManager
 } // namespace Dolas
 
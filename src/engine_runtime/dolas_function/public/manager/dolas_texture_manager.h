@@ -2,13 +2,22 @@
 #define DOLAS_TEXTURE_MANAGER_H
 
 #include <dxgiformat.h>
+#include <filesystem>
 #include <unordered_map>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 #include "render/dolas_texture.h"
 #include "dolas_base.h"
 #include "dolas_hash.h"
+#include "dolas_image_based_lighting.h"
+#include "dolas_texture_streaming.h"
+#include "dolas_texture_upload.h"
 
 struct D3D11_TEXTURE2D_DESC;
+struct ID3D12Heap;
+struct ID3D12Resource;
 
 namespace Dolas
 {
@@ -31,11 +40,23 @@ namespace Dolas
         bool shaderResource = true; // 是否绑定为着色器资源
         uint32_t arraySize = 1;     // 纹理数组大小
         uint32_t sampleCount = 1;   // 多重采样数量
+        ID3D12Heap* placedHeap = nullptr; // 非空时在该堆的 placedHeapOffset 处创建 placed resource，否则独立分配
+        ULongLong placedHeapOffset = 0;
+    };
+
+    // 文件纹理异步加载完成之前，其 SRV 指向的占位纹理
+    enum class TexturePlaceholder
+    {
+        Grey,
+        FlatNormal,     // (0.5, 0.5, 1.0)，切线空间的 +Z
+        Count
     };
 
     enum class GlobalTextureType
     {
         GLOBAL_TEXTURE_SKY_BOX,
+        GLOBAL_TEXTURE_SKY_SPECULAR,    // GGX 预过滤的天空立方体，mip 对应粗糙度
+        GLOBAL_TEXTURE_BRDF_LUT,        // split sum 的 (scale, bias)，横轴 NoV，纵轴粗糙度
         GLOBAL_TEXTURE_COUNT
     };
 
@@ -56,12 +77,40 @@ namespace Dolas
 
 		// 从文件创建纹理
 		// asset_path: 带挂载点的纹理资产路径
+		// placeholder: 加载完成之前显示的内容
 		// 返回: 纹理ID，如果创建失败则返回 TEXTURE_ID_EMPTY
-        TextureID CreateTextureFromDDSFile(const AssetPath& asset_path);
-
-        TextureID CreateTextureFromHDRFile(const AssetPath& asset_path);
-
-		TextureID CreateTextureFromPNGFile(const AssetPath& asset_path);
+		// 只同步读取文件头：纹理对象与它的 SRV descriptor（bindless 下标）立即可用，先指向占位纹理；
+		// 解码在工作线程上进行，拷贝在拷贝队列上分批提交，完成后原地改写同一个 descriptor。
+		// 同一个文件已经创建（或正在加载）时直接返回已有的纹理
+        TextureID CreateTextureFromDDSFile(const AssetPath& asset_path, TexturePlaceholder placeholder = TexturePlaceholder::Grey);
+
+        TextureID CreateTextureFromHDRFile(const AssetPath& asset_path, TexturePlaceholder placeholder = TexturePlaceholder::Grey);
+
+		TextureID CreateTextureFromPNGFile(const AssetPath& asset_path, TexturePlaceholder placeholder = TexturePlaceholder::Grey);
+
+		// equirect 全景 HDR 转换成带完整 mip 链的 BC6H 立方体纹理。优先使用 TextureCooker 烘焙的 .cube.dds，
+		// 不存在或比源文件旧时在 CPU 上并行转换一次并写入缓存，之后与其他 DDS 一样异步加载（加载完成之前采样结果为 0）
+		TextureID CreateCubemapFromEquirectHDRFile(const AssetPath& asset_path, TexturePlaceholder placeholder = TexturePlaceholder::Grey);
+
+		// 天空的基于图像的光照：辐照度球谐、预过滤高光立方体与 BRDF LUT。按源文件内容的哈希与设置缓存在 cache/ibl 下，
+		// 没有缓存时在 CPU 上并行预积分一次。球谐立即可用，两张纹理与其他 DDS 一样异步加载
+		Bool CreateImageBasedLighting(const AssetPath& asset_path);
+		Bool HasImageBasedLighting() const { return m_image_based_lighting_ready; }
+		// 已与余弦瓣卷积的辐照度
+		const SphericalHarmonicsL2& GetSkyIrradianceSH() const { return m_sky_irradiance_sh; }
+
+		// 每帧渲染前调用：接收完成的拷贝并切换 SRV、接收解码结果、启动新的解码、提交一批拷贝
+        void TickPreRender();
+		// 阻塞直到所有进行中的加载完成或失败（退出前调用）
+        void WaitForPendingLoads();
+        Bool IsTextureLoading(TextureID texture_id) const { return m_loading_textures.find(texture_id) != m_loading_textures.end(); }
+        TextureLoadSchedulerStatistics GetLoadStatistics() const { return m_load_scheduler.GetStatistics(); }
+
+		// 纹理流送：带完整 mip 链的 2D 纹理先只加载尾部 mip，之后按渲染时记录的 UV 密度反馈，
+		// 在预算内流入 / 流出更高精度的 mip（重新解码文件，按新的 first mip 创建资源并原地改写 SRV）
+        TextureStreamingFeedback& GetStreamingFeedback() { return m_streaming_feedback; }
+        void SetStreamingBudget(ULongLong budget_bytes) { m_streaming_policy.SetBudget(budget_bytes); }
+        TextureStreamingStatistics GetStreamingStatistics() const { return m_streaming_policy.GetStatistics(); }
 
         Texture* GetGlobalTexture(GlobalTextureType global_texture_type);
 
@@ -69,7 +118,46 @@ namespace Dolas
 		// dolas_texture2d_desc: 2D纹理描述
 		// 返回: 是否成功创建纹理
         Bool DolasCreateTexture2D(const DolasTexture2DDesc& dolas_texture2d_desc);
+
+		// 查询纹理在 GPU 堆中所需的大小与对齐（不创建资源），用于渲染图规划瞬态纹理的堆内偏移
+        Bool GetTexture2DAllocationInfo(const DolasTexture2DDesc& dolas_texture2d_desc, ULongLong& out_size, ULongLong& out_alignment);
     protected:
+        enum class TextureFileType
+        {
+            DDS,
+            HDR,
+            WIC,
+        };
+        struct PendingTextureLoad;
+        // 流送纹理的来源文件，每次改变常驻 mip 时重新解码
+        struct StreamedTexture
+        {
+            TextureFileType file_type = TextureFileType::DDS;
+            std::string file_path;
+            std::wstring file_path_w;
+        };
+
+        TextureID CreateTextureFromFile(const AssetPath& asset_path, TextureFileType file_type, TexturePlaceholder placeholder);
+        // 同步读取文件头并创建指向占位纹理的 SRV，解码与上传交给加载调度器
+        TextureID CreateTextureFromResolvedFile(TextureID texture_id, TextureFileType file_type, const std::filesystem::path& file_path, TexturePlaceholder placeholder);
+        Bool CreatePlaceholderTextures();
+        Bool CreateUploadRingBuffer();
+        void FinishTextureLoads(ULongLong completed_fence_value);
+        void ReceiveDecodedTextures();
+        void StartDecodeTasks();
+        void SubmitTextureUploads();
+        // 接收解码结果、启动新的解码、提交一批拷贝（不处理流送）
+        void ProcessTextureLoads();
+        // 用上一帧的使用反馈更新流送策略，需要改变常驻 mip 的纹理作为新的加载进入调度器
+        void UpdateTextureStreaming();
+        // 纹理不再参与流送，保留当前常驻的 mip
+        void StopTextureStreaming(TextureID texture_id);
+        // 放弃一个加载，纹理保留占位 SRV；GPU 上已提交的拷贝完成后由 ReleaseAbandonedLoads 释放资源
+        void CancelTextureLoad(TextureLoadScheduler::RequestID request);
+        // 移除调度器已经不再跟踪的加载（失败或被取消），释放它们持有的资源
+        void ReleaseAbandonedLoads();
+
+        void ConvertToD3D11Texture2DDesc(const DolasTexture2DDesc& dolas_texture2d_desc, D3D11_TEXTURE2D_DESC& out_desc);
 
         DXGI_FORMAT ConvertToDXGIFormat(DolasTextureFormat format);
 
@@ -77,13 +165,32 @@ namespace Dolas
 
         Bool D3DCreateTexture2D(
             TextureID texture_handle,
-            const D3D11_TEXTURE2D_DESC* pDesc);
+            const D3D11_TEXTURE2D_DESC* pDesc,
+            ID3D12Heap* placed_heap = nullptr,
+            ULongLong placed_heap_offset = 0);
         
         Bool IsDepthFormatShaderCompatible(DXGI_FORMAT format);
 
         std::unordered_map<TextureID, Texture*> m_textures;
 
 		std::unordered_map<GlobalTextureType, TextureID> m_global_textures;
+
+        Texture* m_placeholder_textures[static_cast<int>(TexturePlaceholder::Count)] = {};
+        TextureLoadScheduler m_load_scheduler;
+        std::unordered_map<TextureLoadScheduler::RequestID, std::unique_ptr<PendingTextureLoad>> m_pending_loads;
+        std::unordered_map<TextureID, TextureLoadScheduler::RequestID> m_loading_textures;
+        // 持久映射的上传环，所有 staging 拷贝共用；超过整个环的子资源使用单独的上传缓冲，拷贝 fence 完成后释放
+        ID3D12Resource* m_upload_ring_buffer = nullptr;
+        UByte* m_upload_ring_data = nullptr;
+        std::vector<std::pair<ULongLong, ID3D12Resource*>> m_dedicated_upload_buffers;
+        ULongLong m_last_copy_fence_value = 0;
+
+        TextureStreamingPolicy m_streaming_policy;
+        TextureStreamingFeedback m_streaming_feedback;
+        std::unordered_map<TextureID, StreamedTexture> m_streamed_textures;
+
+        Bool m_image_based_lighting_ready = false;
+        SphericalHarmonicsL2 m_sky_irradiance_sh;
     }; // class TextureManager
 } // namespace Dolas
 
@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <string>
+#include <d3d12.h>
 
 struct ID3D11Buffer;
 struct ID3D11ShaderResourceView;
@@ -65,6 +66,10 @@ namespace Dolas
         ID3D11ShaderResourceView* GetShaderResourceView() const { return m_shader_resource_view; }
         ID3D11UnorderedAccessView* GetUnorderedAccessView() const { return m_unordered_access_view; }
         ID3D12Resource* GetD3D12Resource() const { return m_d3d12_resource; }
+        // 结构化缓冲区在创建时分配 D3D12 SRV，可以像纹理一样放进 shader 的 SRV table
+        D3D12_CPU_DESCRIPTOR_HANDLE GetD3D12SrvCpuHandle() const { return m_d3d12_srv_cpu_handle; }
+        D3D12_GPU_DESCRIPTOR_HANDLE GetD3D12SrvGpuHandle() const { return m_d3d12_srv_gpu_handle; }
+        bool HasD3D12Srv() const { return m_d3d12_srv_cpu_handle.ptr != 0 && m_d3d12_srv_gpu_handle.ptr != 0; }
         
         BufferType GetBufferType() const { return m_buffer_type; }
         BufferUsage GetBufferUsage() const { return m_buffer_usage; }
@@ -81,6 +86,8 @@ namespace Dolas
         ID3D11ShaderResourceView* m_shader_resource_view = nullptr;
         ID3D11UnorderedAccessView* m_unordered_access_view = nullptr;
         ID3D12Resource* m_d3d12_resource = nullptr;
+        D3D12_CPU_DESCRIPTOR_HANDLE m_d3d12_srv_cpu_handle {};
+        D3D12_GPU_DESCRIPTOR_HANDLE m_d3d12_srv_gpu_handle {};
 
         uint32_t m_size = 0;
         uint32_t m_stride = 0;
@@ -4,6 +4,8 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <vector>
+#include "dolas_constant_buffer_arena.h"
 #include "dolas_hash.h"
 #include "render/dolas_shader.h"
 namespace Dolas
@@ -16,10 +18,27 @@ namespace Dolas
         ~Material();
         std::shared_ptr<VertexContext> GetVertexContext();
         std::shared_ptr<PixelContext> GetPixelContext();
+
+        // 材质自己的 GlobalConstants 参数块（DolasRHI 常量 arena 中的块），布局来自 shader 反射。
+        // shader context 由 ShaderManager 在材质之间共享，材质参数必须写入这里而不是 context
+        UInt GetVertexParameterBlock() const { return m_vertex_parameter_block; }
+        UInt GetPixelParameterBlock() const { return m_pixel_parameter_block; }
+        // shader 中没有该变量时忽略
+        void SetVertexParameter(const std::string& name, const Vector4& value);
+        void SetPixelParameter(const std::string& name, const Vector4& value);
+        void SetPixelParameter(const std::string& name, UInt value);
+        // 材质引用的文件纹理，渲染时用来记录纹理流送的使用反馈
+        const std::vector<TextureID>& GetTextureIDs() const { return m_texture_ids; }
     protected:
+        // 按 VS / PS 的 GlobalConstants 大小分配参数块
+        void AllocateParameterBlocks();
+
         MaterialID m_file_id;
         std::shared_ptr<VertexContext> m_vertex_context{ nullptr };
         std::shared_ptr<PixelContext> m_pixel_context{ nullptr };
+        UInt m_vertex_parameter_block = ConstantBufferArena::INVALID_BLOCK;
+        UInt m_pixel_parameter_block = ConstantBufferArena::INVALID_BLOCK;
+        std::vector<TextureID> m_texture_ids;
     }; // class Material
 } // namespace Dolas
 
@@ -0,0 +1,90 @@
+#ifndef DOLAS_PIPELINE_STATE_LIBRARY_H
+#define DOLAS_PIPELINE_STATE_LIBRARY_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <d3d12.h>
+#include "dolas_base.h"
+#include "dolas_pipeline_cache.h"
+
+namespace Dolas
+{
+    enum class PipelineStateSource : UInt
+    {
+        Cache = 0,   // 内存缓存命中
+        Library,     // 从磁盘 pipeline library 反序列化
+        Compiled,    // 驱动重新编译（缓存未命中）
+        Failed,
+    };
+
+    struct PipelineStateLibraryStatistics
+    {
+        UInt cache_hits = 0;
+        UInt library_hits = 0;
+        UInt compiled = 0;
+        UInt failed = 0;
+        UInt precompiled = 0; // 材质加载阶段提前创建成功的数量（库中加载或驱动编译）
+        UInt precompile_failed = 0; // 材质加载阶段按记录创建失败的数量
+        Double create_milliseconds = 0.0;
+    };
+
+    // 以内容键（bytecode 哈希 + 状态 + RT 格式）索引的 PSO 缓存。
+    // 创建过的 PSO 存入 ID3D12PipelineLibrary，其序列化结果与 PipelineStateRecord 一起写入磁盘，
+    // 下次启动时既可以直接反序列化 PSO，也可以据记录在材质加载阶段并行预编译。
+    // FindOrCreate 可以在多个工作线程中同时调用。
+    class PipelineStateLibrary
+    {
+    public:
+        PipelineStateLibrary();
+        ~PipelineStateLibrary();
+
+        Bool Initialize(ID3D12Device* device, const std::string& cache_file_path, ULongLong device_identity);
+        // 把 pipeline library 序列化回磁盘（只有产生了新的 PSO 时才写文件）
+        Bool Save();
+        void Clear();
+
+        ID3D12PipelineState* FindOrCreate(
+            ULongLong key,
+            const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+            const PipelineStateRecord& record,
+            PipelineStateSource* out_source = nullptr,
+            Double* out_create_milliseconds = nullptr);
+
+        // 返回缓存文件中使用这组 shader 的全部记录（拷贝，调用时其他线程可能正在写入新记录）
+        std::vector<PipelineStateRecord> FindRecords(
+            const std::string& vertex_shader_path,
+            const std::string& vertex_entry_point,
+            const std::string& pixel_shader_path,
+            const std::string& pixel_entry_point);
+        void AddPrecompiledCount(UInt count) { m_precompiled += count; }
+        void AddPrecompileFailedCount(UInt count) { m_precompile_failed += count; }
+        PipelineStateLibraryStatistics GetStatistics() const;
+
+    private:
+        ID3D12Device* m_device = nullptr;
+        ID3D12Device1* m_device1 = nullptr;
+        ID3D12PipelineLibrary* m_pipeline_library = nullptr;
+        std::string m_cache_file_path;
+        ULongLong m_device_identity = 0;
+
+        // pipeline library 直接引用反序列化的内存，必须在 library 释放前保持有效
+        PipelineCacheFile m_cache_file;
+        Bool m_library_dirty = false;
+
+        std::mutex m_mutex;
+        std::unordered_map<ULongLong, ID3D12PipelineState*> m_pipeline_states;
+
+        std::atomic<UInt> m_cache_hits {0};
+        std::atomic<UInt> m_library_hits {0};
+        std::atomic<UInt> m_compiled {0};
+        std::atomic<UInt> m_failed {0};
+        std::atomic<UInt> m_precompiled {0};
+        std::atomic<UInt> m_precompile_failed {0};
+        std::atomic<ULongLong> m_create_microseconds {0};
+    }; // class PipelineStateLibrary
+} // namespace Dolas
+
+#endif // DOLAS_PIPELINE_STATE_LIBRARY_H
@@ -0,0 +1,85 @@
+#ifndef DOLAS_RENDER_DRAW_LIST_H
+#define DOLAS_RENDER_DRAW_LIST_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+#include "dolas_hash.h"
+#include "dolas_math.h"
+#include "dolas_draw_sort_key.h"
+
+namespace Dolas
+{
+    class DolasRHI;
+    class Material;
+    class RenderPrimitive;
+
+    // 写入排序键最高位的 pass 编号
+    enum RenderPassType : UInt
+    {
+        RenderPassType_GBuffer = 0,
+        RenderPassType_Forward,
+        RenderPassType_Transparent,
+        RenderPassType_DepthPrePass,   // 只写深度，排序键为深度优先（DrawSortKey::EncodeDepthFirst）
+        RenderPassType_Count,
+    };
+
+    // 从外部索引缓冲绘制的区间（例如 cluster 剔除后的压缩索引），无效时按 LOD 绘制整个 RenderPrimitive
+    struct DrawIndexRange
+    {
+        BufferID m_index_buffer_id = BUFFER_ID_EMPTY;
+        UInt m_start_index = 0;
+        UInt m_index_count = 0;
+
+        Bool IsValid() const { return m_index_buffer_id != BUFFER_ID_EMPTY; }
+    };
+
+    struct DrawPacket
+    {
+        RenderPrimitiveID m_render_primitive_id = RENDER_PRIMITIVE_ID_EMPTY;
+        Material* m_material = nullptr;
+        Pose m_pose;
+        UInt m_lod_index = 0;
+        DrawIndexRange m_index_range;
+    };
+
+    // 每帧收集的 draw packet 列表：按 64 位排序键做基数排序后提交，
+    // 使共享 PSO / 材质 / 网格的 draw 在提交顺序上相邻，配合 DolasRHI 的冗余状态过滤减少重复绑定。
+    class RenderDrawList
+    {
+    public:
+        RenderDrawList();
+        ~RenderDrawList();
+
+        // 清空上一帧的数据（保留容量），并设置深度量化使用的相机参数
+        void Reset(const Vector3& camera_position, const Vector3& camera_forward, Float near_plane, Float far_plane);
+
+        Bool AddDrawPacket(RenderPassType pass, RenderPrimitiveID render_primitive_id, MaterialID material_id, const Pose& pose, UInt lod_index = 0, const DrawIndexRange& index_range = DrawIndexRange());
+        // 直接使用材质对象，例如不在 MaterialManager 中按 ID 注册的全局材质
+        Bool AddDrawPacket(RenderPassType pass, RenderPrimitiveID render_primitive_id, Material* material, const Pose& pose, UInt lod_index = 0, const DrawIndexRange& index_range = DrawIndexRange());
+
+        void Sort();
+        void Submit(DolasRHI* rhi) const;
+
+        UInt GetDrawPacketCount() const { return static_cast<UInt>(m_draw_packets.size()); }
+
+    private:
+        UInt GetOrAssignSlot(std::unordered_map<std::size_t, UInt>& slots, std::size_t identity);
+
+        std::vector<DrawPacket> m_draw_packets;
+        std::vector<DrawSortEntry> m_sort_entries;
+        std::vector<DrawSortEntry> m_sort_scratch;
+
+        // 每帧重新分配的紧凑索引：identity -> slot
+        std::unordered_map<std::size_t, UInt> m_pipeline_slots;
+        std::unordered_map<std::size_t, UInt> m_material_slots;
+        std::unordered_map<std::size_t, UInt> m_mesh_slots;
+
+        Vector3 m_camera_position;
+        Vector3 m_camera_forward;
+        Float m_near_plane = 0.1f;
+        Float m_far_plane = 1000.0f;
+    }; // class RenderDrawList
+} // namespace Dolas
+
+#endif // DOLAS_RENDER_DRAW_LIST_H
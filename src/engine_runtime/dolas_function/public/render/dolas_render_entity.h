@@ -6,32 +6,72 @@
 #include <DirectXMath.h>
 #include <memory>
 #include "dolas_hash.h"
+#include "dolas_bounds.h"
+#include "dolas_meshlet.h"
 #include "render/dolas_transform.h"
+#include "render/dolas_render_draw_list.h"
 
 namespace Dolas
 {
     class DolasRHI;
     class Material;
+    class RenderScene;
+    class TextureStreamingFeedback;
     struct RenderComponent
     {
         RenderPrimitiveID m_render_primitive_id = RENDER_PRIMITIVE_ID_EMPTY;
         MaterialID m_material_id = MATERIAL_ID_EMPTY;
+        // 上一帧选中的 LOD，作为下一帧滞后判断的起点
+        UInt m_lod_index = 0;
+        // 本帧 cluster 剔除后在压缩索引缓冲中的区间；m_use_cluster_indices 为 false 时绘制整个 LOD
+        Bool m_use_cluster_indices = false;
+        UInt m_cluster_index_offset = 0;
+        UInt m_cluster_index_count = 0;
     };
 
     class RenderEntity
     {
         friend class RenderEntityManager;
+        friend class RenderScene;
     public:
         RenderEntity();
         ~RenderEntity();
         bool Clear();
         void Draw(DolasRHI* rhi);
+        // 将所有 component 作为 draw packet 加入 draw_list，由调用方统一排序后提交
+        // cluster_index_buffer_id 为 UpdateClusterCulling 输出的索引上传后的缓冲；
+        // override_material 不为空时所有 component 都使用该材质（例如深度预通道的全局材质）
+        void CollectDrawPackets(RenderDrawList& draw_list, RenderPassType pass, BufferID cluster_index_buffer_id = BUFFER_ID_EMPTY, Material* override_material = nullptr) const;
 
         void AddComponent(RenderPrimitiveID mesh_id, MaterialID material_id);
+
+        // 按每个 component 包围球的投影尺寸选择 LOD；projection_scale 为投影矩阵的 [1][1]
+        void UpdateMeshLOD(const Vector3& camera_position, Float projection_scale, Float hysteresis);
+        // 所有 component 回到 LOD0
+        void ResetMeshLOD();
+        // 纹理流送的使用反馈：按每个 component 包围球的投影直径估计 UV 密度，记录到它的材质引用的纹理上
+        void RecordTextureUsage(const Vector3& camera_position, Float projection_scale, Float viewport_height, TextureStreamingFeedback& feedback) const;
+
+        // 对使用 LOD0 且带 meshlet 的 component 做 cluster 剔除（视锥 + 法线锥），
+        // 可见 meshlet 的索引追加到 cluster_indices，统计累加到 culling_result
+        void UpdateClusterCulling(const Frustum& world_frustum, const Vector3& camera_position, std::vector<UInt>& cluster_indices, MeshletCullingResult& culling_result);
+        void ResetClusterCulling();
+
+        RenderEntityID GetID() const { return m_file_id; }
+        void SetPose(const Pose& pose);
+        const Pose& GetPose() const { return m_pose; }
+        const std::vector<RenderComponent>& GetComponents() const { return m_components; }
+        // 所有 component 的包围盒合并后按 m_pose 变换到世界空间；pose 或 component 变化时更新，并 refit 到所属 scene 的树上
+        const BoundingBox& GetWorldBounds() const { return m_world_bounds; }
+        void UpdateWorldBounds();
     protected:
         RenderEntityID m_file_id = RENDER_ENTITY_ID_EMPTY;
         std::vector<RenderComponent> m_components;
 		Pose m_pose = Pose();
+        BoundingBox m_local_bounds;
+        BoundingBox m_world_bounds;
+        // 由 RenderScene 在加入 / 移除时设置
+        RenderScene* m_owner_scene = nullptr;
     };
 } // namespace Dolas
 
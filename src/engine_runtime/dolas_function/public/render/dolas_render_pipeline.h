@@ -1,10 +1,134 @@
 #ifndef DOLAS_RENDER_PIPELINE_H
 #define DOLAS_RENDER_PIPELINE_H
+#include <functional>
+#include <string>
 #include "dolas_hash.h"
 #include "render/dolas_rhi_common.h"
+#include "render/dolas_render_draw_list.h"
+#include "dolas_frustum_culling.h"
+#include "dolas_software_occlusion.h"
+#include "dolas_light_clustering.h"
+#include "dolas_cascaded_shadow.h"
+#include "dolas_render_graph.h"
+#include "dolas_constant_buffer_layout.h"
 namespace Dolas
 {
     class DolasRHI;
+
+    // 最近一帧 GBufferPass 的视锥 / 遮挡剔除结果
+    struct RenderCullingStatistics
+    {
+        UInt total_entity_count = 0;
+        UInt visible_entity_count = 0;   // 视锥与遮挡剔除之后
+        UInt culled_entity_count = 0;    // 视锥剔除
+        UInt culling_task_count = 0;
+        Double culling_milliseconds = 0.0;
+
+        UInt occluder_count = 0;
+        UInt occluder_triangle_count = 0;
+        UInt occluded_entity_count = 0;  // 通过视锥测试但被遮挡
+        Double occlusion_milliseconds = 0.0;
+    };
+
+    // 最近一帧 GBufferPass 提交的三角形：使用 LOD 的实际数量与全部使用 LOD0 时的数量
+    struct RenderMeshLODStatistics
+    {
+        UInt rendered_triangle_count = 0;
+        UInt full_detail_triangle_count = 0;
+        UInt reduced_component_count = 0;  // 使用了 LOD0 以外级别的 component
+    };
+
+    // 最近一帧 GBufferPass 的 meshlet（cluster）剔除结果，只统计带 meshlet 且使用 LOD0 的 component
+    struct RenderClusterCullingStatistics
+    {
+        UInt meshlet_count = 0;
+        UInt visible_meshlet_count = 0;
+        UInt frustum_culled_meshlet_count = 0;
+        UInt backface_culled_meshlet_count = 0;
+        UInt source_triangle_count = 0;     // 不做 cluster 剔除时会提交的三角形
+        UInt submitted_triangle_count = 0;
+        Double culling_milliseconds = 0.0;
+    };
+
+    // 最近一帧 DeferredShadingPass 的 clustered 光源分配结果
+    struct RenderLightClusteringStatistics
+    {
+        UInt local_light_count = 0;
+        UInt cluster_count = 0;
+        UInt light_index_count = 0;        // 所有 cluster 光源表的总长度
+        UInt max_cluster_light_count = 0;  // 单个 cluster 的最多光源数
+        UInt assignment_task_count = 0;
+        Double assignment_milliseconds = 0.0;  // 分配 + 合并，不含上传
+    };
+
+    // 最近一帧 ShadowDepthPass 单个 cascade 的剔除与提交结果（整个 pass 的 GPU 耗时见 RenderPassStatistics）
+    struct RenderShadowCascadeStatistics
+    {
+        UInt caster_count = 0;             // 通过该 cascade 剔除的 entity
+        UInt draw_count = 0;
+        UInt triangle_count = 0;
+        Double culling_milliseconds = 0.0;
+        Double record_milliseconds = 0.0;  // 录制 draw 的 CPU 耗时
+    };
+
+    struct RenderShadowStatistics
+    {
+        UInt cascade_count = 0;
+        UInt total_entity_count = 0;
+        Double fitting_milliseconds = 0.0;  // 划分 + 拟合
+        RenderShadowCascadeStatistics cascades[kMaxShadowCascadeCount];
+    };
+
+    // 最近一帧渲染图的编译结果
+    struct RenderGraphStatistics
+    {
+        UInt pass_count = 0;
+        UInt culled_pass_count = 0;
+        UInt transition_barrier_count = 0;
+        UInt aliasing_barrier_count = 0;
+        UInt barrier_batch_count = 0;
+        ULongLong transient_heap_size = 0;   // 按生命周期别名后的瞬态纹理内存
+        ULongLong unaliased_heap_size = 0;   // 每张瞬态纹理独占内存时的总量
+        Bool transient_heap_placed = false;  // 瞬态纹理是否已放置在共享堆中（否则为独立分配）
+        Double build_milliseconds = 0.0;     // 声明 + 编译
+    };
+
+    // 最近一帧单个 pass 的耗时。GPU 数据来自 RHI 的 timestamp / pipeline statistics 查询，
+    // 只在开启 GPU pass 统计且查询可用时有效
+    struct RenderPassTiming
+    {
+        std::string name;
+        Double cpu_milliseconds = 0.0;     // 录制命令的 CPU 耗时
+        Bool has_gpu_statistics = false;
+        Double gpu_milliseconds = 0.0;
+        ULongLong rasterized_primitive_count = 0;
+        ULongLong pixel_shader_invocation_count = 0;
+    };
+
+    struct RenderPassStatistics
+    {
+        std::vector<RenderPassTiming> passes;  // 按执行顺序
+        Bool depth_prepass_enabled = false;
+        UInt viewport_pixel_count = 0;
+        // GBuffer 像素着色器调用次数 / 视口像素数，即 GBuffer 的 overdraw（深度预通道开启时接近 1）
+        Double gbuffer_shading_rate = 0.0;
+    };
+
+    // DeferredShading 像素着色器每帧写入的 GlobalConstants 变量。
+    // GlobalMaterial 在 RenderPipeline::Initialize 之后才创建，因此在第一次绘制（或 shader 重建）时解析一次
+    struct DeferredShadingVariables
+    {
+        const class PixelContext* pixel_context = nullptr; // 解析这些 handle 时使用的 shader
+        ConstantBufferVariableHandle light_cluster_grid;
+        ConstantBufferVariableHandle light_cluster_depth;
+        ConstantBufferVariableHandle shadow_cascade_matrices;
+        ConstantBufferVariableHandle shadow_cascade_splits;
+        ConstantBufferVariableHandle shadow_atlas;
+        ConstantBufferVariableHandle shadow_params;
+        ConstantBufferVariableHandle sky_irradiance_sh;
+        ConstantBufferVariableHandle sky_lighting_params;
+    };
+
     class RenderPipeline
     {
         friend class RenderPipelineManager;
@@ -16,10 +140,34 @@ namespace Dolas
         void Render(DolasRHI* rhi);
         void SetRenderViewID(RenderViewID id);
         void DisplayWorldCoordinateSystem();
+        const RenderCullingStatistics& GetCullingStatistics() const { return m_culling_statistics; }
+        void SetOcclusionCullingEnabled(Bool enabled) { m_enable_occlusion_culling = enabled; }
+        Bool IsOcclusionCullingEnabled() const { return m_enable_occlusion_culling; }
+        const RenderMeshLODStatistics& GetMeshLODStatistics() const { return m_mesh_lod_statistics; }
+        void SetMeshLODEnabled(Bool enabled) { m_enable_mesh_lod = enabled; }
+        Bool IsMeshLODEnabled() const { return m_enable_mesh_lod; }
+        const RenderClusterCullingStatistics& GetClusterCullingStatistics() const { return m_cluster_culling_statistics; }
+        void SetClusterCullingEnabled(Bool enabled) { m_enable_cluster_culling = enabled; }
+        Bool IsClusterCullingEnabled() const { return m_enable_cluster_culling; }
+        const RenderGraphStatistics& GetRenderGraphStatistics() const { return m_render_graph_statistics; }
+        const RenderLightClusteringStatistics& GetLightClusteringStatistics() const { return m_light_clustering_statistics; }
+        const RenderShadowStatistics& GetShadowStatistics() const { return m_shadow_statistics; }
+        void SetShadowsEnabled(Bool enabled) { m_enable_shadows = enabled; }
+        Bool IsShadowsEnabled() const { return m_enable_shadows; }
+        const RenderPassStatistics& GetPassStatistics() const { return m_pass_statistics; }
     private:
         void ClearPass(DolasRHI* rhi, class RenderView* render_view);
+        // 相机剔除、LOD 选择与 cluster 剔除，收集 GBuffer（以及开启时深度预通道）的 draw list。
+        // 在建图之前执行，各 pass 只负责提交
+        void CollectGBufferDraws(class RenderView* render_view);
+        // 只写深度：复用 GBuffer 的可见集合与 cluster 剔除结果，以只含位置的顶点流由近及远绘制
+        void DepthPrePass(DolasRHI* rhi, class RenderView* render_view);
         void GBufferPass(DolasRHI* rhi, class RenderView* render_view);
+        // 方向光的级联阴影：复用 CollectGBufferDraws 收集的世界包围盒，逐 cascade 剔除投射体并渲染到阴影图集
+        void ShadowDepthPass(DolasRHI* rhi, class RenderView* render_view);
         void DeferredShadingPass(DolasRHI* rhi, class RenderView* render_view);
+        // pixel_context 与上次解析时不同才重新查找变量
+        void ResolveDeferredShadingVariables(const class PixelContext* pixel_context);
         void ForwardShadingPass(DolasRHI* rhi);
         void SkyboxPass(DolasRHI* rhi, class RenderView* render_view);
         void DebugPass(DolasRHI* rhi, class RenderView* render_view);
@@ -27,6 +175,30 @@ namespace Dolas
         void PostProcessPass(DolasRHI* rhi);
         void DisplayWorldCoordinate();
         void PresentPass(DolasRHI* rhi, class RenderView* render_view);
+        // 用相机的 view-projection 对场景中所有 entity 的世界包围盒做视锥剔除，结果写入 m_entity_visibility
+        void CullRenderEntities(class RenderScene* render_scene, class RenderCamera* render_camera);
+        // 把屏幕上较大的可见 entity 光栅化进软件深度缓冲，再用 hierarchical-Z 剔除被挡住的 entity
+        void OcclusionCullRenderEntities(class RenderScene* render_scene, class RenderCamera* render_camera, const Matrix4x4& view_projection);
+        // 把本帧 cluster 剔除输出的索引写入动态索引缓冲，容量不足时按 2 倍重建；失败时返回 BUFFER_ID_EMPTY
+        BufferID UploadClusterIndices();
+        // 把场景中的点光 / 聚光分配到相机视锥的 froxel 中（按光源分块并行），结果写入 m_light_cluster_ranges / m_light_cluster_indices
+        void AssignLightClusters(class RenderScene* render_scene, class RenderCamera* render_camera);
+        // 上传光源数组、每个 cluster 的区间与光源索引表，任一失败时返回 false
+        Bool UploadLightClusters();
+        // 按相机与主光源方向拟合各 cascade，并按 entity 分块并行剔除投射体，结果写入 m_shadow_cascade_visibility
+        void UpdateShadowCascades(DolasRHI* rhi, class RenderCamera* render_camera);
+
+        // 每帧重建渲染图：各 pass 声明对 RenderResource 纹理的读写，编译出执行顺序、屏障批次与瞬态纹理的堆内偏移
+        Bool BuildRenderGraph(DolasRHI* rhi, class RenderView* render_view);
+        // 依次提交每个 pass 之前的屏障批次并执行 pass
+        void ExecuteRenderGraph(DolasRHI* rhi);
+        // 执行 pass 并记录 CPU 耗时与 GPU 查询下标，GPU 结果在 Present 之后合并
+        void ExecuteProfiledPass(DolasRHI* rhi, const std::string& name, const std::function<void()>& execute);
+        void MergeGpuPassStatistics(DolasRHI* rhi);
+        RenderGraphResourceHandle CreateRenderGraphTexture(const class RenderResource* render_resource, TextureID texture_id);
+        RenderGraphPassHandle AddRenderGraphPass(const std::string& name, Bool has_side_effects, std::function<void()> execute);
+        // 按编译结果把瞬态纹理放置到共享堆中（布局不变时不做任何事）
+        void PlaceTransientTextures(class RenderView* render_view, class RenderResource* render_resource);
 
         class RenderScene* TryGetRenderScene(class RenderView* view = nullptr) const;
         class RenderResource* TryGetRenderResource(class RenderView* view = nullptr) const;
@@ -34,6 +206,48 @@ namespace Dolas
         class RenderView* TryGetRenderView() const;
         ViewPort m_viewport;
         RenderViewID m_render_view_id;
+        RenderDrawList m_gbuffer_draw_list;
+        RenderDrawList m_depth_prepass_draw_list;
+        Bool m_gbuffer_draws_ready = false;      // 本帧 CollectGBufferDraws 是否成功
+        Bool m_depth_prepass_ready = false;      // 本帧深度预通道是否已写入深度，GBufferPass 据此选择 EQUAL 测试
+        CullingBoundsSoA m_culling_bounds;
+        std::vector<UByte> m_entity_visibility;
+        RenderCullingStatistics m_culling_statistics;
+        SoftwareOcclusionBuffer m_occlusion_buffer;
+        Bool m_enable_occlusion_culling = true;
+        RenderMeshLODStatistics m_mesh_lod_statistics;
+        Bool m_enable_mesh_lod = true;
+        RenderClusterCullingStatistics m_cluster_culling_statistics;
+        Bool m_enable_cluster_culling = true;
+        std::vector<UInt> m_cluster_indices;
+        BufferID m_cluster_index_buffer_id = BUFFER_ID_EMPTY;
+        UInt m_cluster_index_capacity = 0;
+        LightClusterGrid m_light_cluster_grid;
+        std::vector<LightClusterChunk> m_light_cluster_chunks;
+        std::vector<LightClusterRange> m_light_cluster_ranges;
+        std::vector<UInt> m_light_cluster_indices;
+        std::vector<LocalLightData> m_local_light_data;
+        BufferID m_local_light_buffer_id = BUFFER_ID_EMPTY;
+        BufferID m_light_cluster_range_buffer_id = BUFFER_ID_EMPTY;
+        BufferID m_light_cluster_index_buffer_id = BUFFER_ID_EMPTY;
+        UInt m_local_light_capacity = 0;
+        UInt m_light_cluster_range_capacity = 0;
+        UInt m_light_cluster_index_capacity = 0;
+        RenderLightClusteringStatistics m_light_clustering_statistics;
+        DeferredShadingVariables m_deferred_shading_variables;
+        CascadeShadowDesc m_shadow_desc;
+        ShadowCascade m_shadow_cascades[kMaxShadowCascadeCount];
+        std::vector<UByte> m_shadow_cascade_visibility[kMaxShadowCascadeCount];
+        Bool m_enable_shadows = true;
+        Bool m_shadow_cascades_ready = false;   // 本帧阴影图是否已渲染，DeferredShadingPass 据此决定是否采样
+        RenderShadowStatistics m_shadow_statistics;
+        RenderGraph m_render_graph;
+        RenderGraphCompileResult m_render_graph_result;
+        std::vector<std::function<void()>> m_render_graph_pass_functions; // 下标为 pass 句柄
+        std::vector<TextureID> m_render_graph_textures;                   // 下标为资源句柄
+        RenderGraphStatistics m_render_graph_statistics;
+        RenderPassStatistics m_pass_statistics;
+        std::vector<UInt> m_pass_gpu_query_indices;                       // 与 m_pass_statistics.passes 一一对应
 
 		Bool m_display_world_coordinate = false;
     };// class RenderPipeline
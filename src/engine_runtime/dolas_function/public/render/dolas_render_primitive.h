@@ -6,12 +6,23 @@
 #include <vector>
 
 #include "dolas_hash.h"
+#include "dolas_bounds.h"
+#include "dolas_meshlet.h"
 #include "render/dolas_rhi_common.h"
 namespace Dolas
 {
     class DolasRHI;
     class Buffer;
 
+    // 一级 LOD 在共享索引缓冲中的区间；所有 LOD 共用同一组顶点缓冲
+    struct RenderPrimitiveLOD
+    {
+        UInt m_index_offset = 0;
+        UInt m_index_count = 0;
+        Float m_error = 0.0f;
+        Float m_screen_size = 0.0f; // 投影尺寸低于该值时切换到此 LOD，LOD0 为 0
+    };
+
     class RenderPrimitive
     {
         friend class RenderPrimitiveManager;
@@ -21,6 +32,10 @@ namespace Dolas
 
         bool Clear();
 
+        UInt GetLODCount() const { return static_cast<UInt>(m_lods.size()); }
+        // lod_index 越界时按 LOD0 计算
+        UInt GetTriangleCount(UInt lod_index = 0) const;
+
         PrimitiveTopology m_topology;
 		InputLayoutType m_input_layout_type;
         
@@ -33,8 +48,22 @@ namespace Dolas
         
 		// index count
         BufferID m_index_buffer_id;
-        UInt m_index_count = 0;
-		
+		UInt m_index_count = 0; // LOD0 的索引数量
+
+		// m_lods[0] 为原始网格，之后按细节递减；m_lod_screen_sizes 与之一一对应，供 SelectMeshLOD 使用
+		std::vector<RenderPrimitiveLOD> m_lods;
+		std::vector<Float> m_lod_screen_sizes;
+
+		// 模型空间包围体，由 stream 0 的顶点位置计算
+		BoundingBox m_local_bounds;
+		BoundingSphere m_local_bounding_sphere;
+
+		// 三角形列表在 CPU 侧保留一份位置（xyz）与索引，作为软件遮挡剔除的遮挡体；其他拓扑为空
+		std::vector<Float> m_occluder_positions;
+		std::vector<UInt> m_occluder_indices;
+
+		// LOD0 的 meshlet，供 CPU cluster 剔除生成压缩索引；为空时按整个 LOD 绘制
+		MeshletData m_meshlets;
     };// class RenderPrimitive
 } // namespace Dolas
 
@@ -6,22 +6,47 @@
 #include <memory>
 #include <vector>
 #include "dolas_hash.h"
+#include "manager/dolas_texture_manager.h"
+
+struct ID3D12Heap;
 
 namespace Dolas
 {
     class Texture;
     class Buffer;
 
+    constexpr ULongLong kRenderResourceNotPlaced = ~0ull;
+
+    // 渲染图中的瞬态 render target：保存创建参数与内存需求，放置到共享堆时据此重建
+    struct RenderResourceTransientTexture
+    {
+        DolasTexture2DDesc m_desc;
+        ULongLong m_allocation_size = 0;
+        ULongLong m_allocation_alignment = 0;
+        ULongLong m_heap_offset = kRenderResourceNotPlaced; // kRenderResourceNotPlaced 表示独立分配（committed）
+    };
+
     class RenderResource
     {
         friend class RenderResourceManager;
     public:
+        const std::vector<RenderResourceTransientTexture>& GetTransientTextures() const { return m_transient_textures; }
+        const RenderResourceTransientTexture* GetTransientTexture(TextureID texture_id) const;
+        Bool IsTransientHeapPlaced() const { return m_transient_heap != nullptr; }
+        ULongLong GetTransientHeapSize() const { return m_transient_heap_size; }
+
         TextureID m_gbuffer_a_id = TEXTURE_ID_EMPTY;
         TextureID m_gbuffer_b_id = TEXTURE_ID_EMPTY;
-        TextureID m_gbuffer_c_id = TEXTURE_ID_EMPTY;
-        TextureID m_gbuffer_d_id = TEXTURE_ID_EMPTY;
         TextureID m_depth_stencil_id = TEXTURE_ID_EMPTY;
         TextureID m_scene_result_id = TEXTURE_ID_EMPTY;
+        // 方向光级联阴影图集（D32），尺寸与视口无关，由 CascadeShadowDesc 决定
+        TextureID m_shadow_map_id = TEXTURE_ID_EMPTY;
+
+    private:
+        std::vector<RenderResourceTransientTexture> m_transient_textures;
+        ID3D12Heap* m_transient_heap = nullptr;
+        ULongLong m_transient_heap_size = 0;
+        Bool m_transient_placement_failed = false; // 放置失败后保持独立分配，不再每帧重试
     }; // class RenderResource
 } // namespace Dolas
 
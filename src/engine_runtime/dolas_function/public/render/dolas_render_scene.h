@@ -8,12 +8,16 @@
 #include <DirectXMath.h>
 #include "dolas_hash.h"
 #include "render/dolas_transform.h"
+#include "dolas_dynamic_aabb_tree.h"
+#include "dolas_light_clustering.h"
 namespace Dolas
 {
+    class RenderEntity;
 
     class RenderScene
     {
         friend class RenderSceneManager;
+        friend class RenderEntity;
     public:
         RenderScene();
         ~RenderScene();
@@ -22,8 +26,39 @@ namespace Dolas
         bool Clear();
         // Asset description parsing and entity creation are owned by RenderSceneManager.
 		const std::vector<RenderEntityID>& GetRenderEntities() const { return m_render_entities; }
+
+        // entity 以世界包围盒加入 m_entity_tree，之后它的世界包围盒每次更新都会自动 refit 到树上；
+        // 一个 entity 同一时间只属于一个 scene
+        void AddRenderEntity(RenderEntityID render_entity_id);
+        void AddRenderEntity(RenderEntity* render_entity);
+        void RemoveRenderEntity(RenderEntityID render_entity_id);
+
+        void QueryRenderEntities(const Frustum& frustum, std::vector<RenderEntityID>& out_render_entities) const;
+        void QueryRenderEntities(const BoundingBox& box, std::vector<RenderEntityID>& out_render_entities) const;
+        // 编辑器拾取：返回包围盒最先被射线命中的 entity，未命中返回 RENDER_ENTITY_ID_EMPTY
+        RenderEntityID RayCastRenderEntity(const Vector3& origin, const Vector3& direction, Float max_distance, Float* out_distance = nullptr) const;
+
+        const DynamicAABBTree& GetEntityTree() const { return m_entity_tree; }
+
+        // 点光 / 聚光列表，下标即着色器中的光源下标；删除时最后一个光源移到被删除的位置
+        UInt AddLocalLight(const LocalLight& light);
+        void SetLocalLight(UInt light_index, const LocalLight& light);
+        void RemoveLocalLight(UInt light_index);
+        void ClearLocalLights() { m_local_lights.clear(); }
+        const std::vector<LocalLight>& GetLocalLights() const { return m_local_lights; }
     private:
+        // 由 RenderEntity::UpdateWorldBounds 调用
+        void RefitRenderEntity(RenderEntityID render_entity_id);
+
+        struct EntityProxy
+        {
+            Int proxy_id = DynamicAABBTree::NULL_NODE;
+            RenderEntity* render_entity = nullptr;
+        };
         std::vector<RenderEntityID> m_render_entities;
+        std::unordered_map<RenderEntityID, EntityProxy> m_entity_proxies;
+        DynamicAABBTree m_entity_tree;
+        std::vector<LocalLight> m_local_lights;
     }; // class RenderScene
 } // namespace Dolas
 
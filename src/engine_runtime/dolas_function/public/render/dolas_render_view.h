@@ -34,6 +34,11 @@ namespace Dolas
         RenderResourceID GetRenderResourceID() const { return m_render_resource_id; }
         RenderSceneID GetRenderSceneID() const { return m_render_scene_id; }
 
+        // 深度预通道：先以只含位置的顶点流由近及远写深度，GBuffer 再以 EQUAL 测试、不写深度，
+        // 被遮挡的片元不再付出 GBuffer 带宽。顶点开销翻倍，适合 overdraw 高的视图
+        void SetDepthPrePassEnabled(Bool enabled) { m_depth_prepass_enabled = enabled; }
+        Bool IsDepthPrePassEnabled() const { return m_depth_prepass_enabled; }
+
         // 渲染执行
         void Render(DolasRHI* rhi);
 
@@ -43,6 +48,7 @@ namespace Dolas
         RenderPipelineID m_render_pipeline_id;
         RenderResourceID m_render_resource_id;
         RenderSceneID m_render_scene_id;
+        Bool m_depth_prepass_enabled = false;
 
     }; // class RenderView
 } // namespace Dolas
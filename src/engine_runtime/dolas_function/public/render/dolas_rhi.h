@@ -1,15 +1,20 @@
 #ifndef DOLAS_RHI_H
 #define DOLAS_RHI_H
 
+#include <chrono>
 #include <cstddef>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 #include <d3d12.h>
 
+#include "dolas_constant_buffer_arena.h"
 #include "dolas_hash.h"
 #include "dolas_math.h"
+#include "dolas_render_graph.h"
 #include "render/dolas_rhi_common.h"
+#include "render/dolas_pipeline_state_library.h"
 
 struct ID3D11BlendState;
 struct ID3D11Buffer;
@@ -36,6 +41,69 @@ namespace Dolas
 	class PixelContext;
 	class ShaderContext;
 	class RenderPrimitive;
+	class Material;
+
+	// 单类绑定的计数：requested 为调用方发起的绑定次数，issued 为冗余过滤后真正写入 command list 的次数
+	struct RHIBindCounter
+	{
+		UInt requested_count = 0;
+		UInt issued_count = 0;
+
+		void Record(Bool issued)
+		{
+			++requested_count;
+			if (issued)
+			{
+				++issued_count;
+			}
+		}
+	};
+
+	// 每帧的绑定 / 状态切换统计，在 BeginFrame 时锁存为上一帧结果
+	struct RHIFrameStatistics
+	{
+		UInt draw_calls = 0;
+		UInt triangles = 0;                   // DrawRenderPrimitive 实际提交的三角形
+		RHIBindCounter root_signature;
+		RHIBindCounter constant_buffer_view;
+		RHIBindCounter srv_table;
+		RHIBindCounter pipeline_state;
+		RHIBindCounter vertex_buffer;
+		RHIBindCounter index_buffer;
+		RHIBindCounter primitive_topology;
+		UInt descriptor_copies = 0;           // CopyDescriptorsSimple 调用次数
+		UInt srv_table_rebuilds = 0;          // 常驻 SRV table 的重写次数
+		UInt srv_table_transient_writes = 0;  // 退回到临时 table 的次数
+		UInt pipeline_state_cache_hits = 0;     // PSO 内存缓存命中
+		UInt pipeline_state_library_hits = 0;   // 从磁盘 pipeline library 加载
+		UInt pipeline_state_compiles = 0;       // 帧内驱动编译（未被预编译覆盖，会造成卡顿）
+		Double pipeline_state_create_milliseconds = 0.0;
+		UInt view_cache_hits = 0;               // 复用纹理上缓存的 RTV/DSV
+		UInt view_creations = 0;                // 新建 RTV/DSV（稳定运行时应为 0）
+		UInt resource_barriers = 0;             // 写入 command list 的资源屏障总数
+		UInt resource_barrier_calls = 0;        // ResourceBarrier 调用次数（渲染图每个批次一次）
+		UInt ad_hoc_transitions = 0;            // 绑定时由 TransitionTexture 补上的转换（渲染图覆盖的纹理应为 0）
+		ULongLong transient_constant_bytes = 0; // per-view / per-object 常量写入上传环的字节数
+		UInt transient_constant_overflows = 0;  // 上传环耗尽、退回到共享常量缓冲的次数
+		ULongLong global_constant_bytes = 0;    // 绑定 shader 时上传的 GlobalConstants 字节（只含脏区间）
+		UInt global_constant_uploads = 0;
+		UInt global_constant_skipped_uploads = 0; // 自上次绑定以来没有改动、不需要上传的绑定
+		ULongLong material_constant_bytes = 0;  // 材质参数 arena 上传的字节（只含脏区间）
+		UInt material_constant_uploads = 0;     // 合并后的拷贝次数
+		UInt material_binds = 0;                // 通过 BindMaterial 按块偏移绑定的次数
+	};
+
+	// 一段 GPU 工作（通常是一个 pass）的 timestamp 与 pipeline statistics 查询结果
+	struct RHIGpuPassStatistics
+	{
+		std::string name;
+		Double gpu_milliseconds = 0.0;
+		ULongLong rasterized_primitives = 0;     // CPrimitives
+		ULongLong pixel_shader_invocations = 0;  // PSInvocations，被 early-Z 剔除的像素不计入
+	};
+
+	constexpr UInt kMaxGpuPassQueryCount = 32;
+	constexpr UInt kInvalidGpuPassQuery = 0xFFFFFFFFu;
 
 	// 渲染硬件接口(RHI)相关定义将在这里
 	class DolasRHI
@@ -56,7 +124,11 @@ namespace Dolas
 		
 		ID3D11ShaderResourceView* CreateShaderResourceView(ID3D11Resource* resource);
 		void UpdatePerFrameParameters();
+		// 主方向光：xyz 为光线传播方向，w 为强度（写入 per-frame 常量，阴影 cascade 也以此拟合）
+		const Vector4& GetMainLightDirectionIntensity() const { return m_main_light_direction_intensity; }
 		void UpdatePerViewParameters(class RenderCamera* render_camera);
+		// 非相机视图（例如阴影 cascade）；每次更新写入新的常量区间，不影响本帧之前录制的 draw
+		void UpdatePerViewParameters(const Matrix4x4& view, const Matrix4x4& projection, const Vector3& view_position);
 		void UpdatePerObjectParameters(Pose pose);
 		// User annotation helpers (RenderDoc / PIX markers)
 		void BeginEvent(const wchar_t* name);
@@ -64,7 +136,8 @@ namespace Dolas
 		void SetMarker(const wchar_t* name);
 
 		// RenderTargetView
-		std::shared_ptr<RenderTargetView> CreateRenderTargetView(TextureID texture_id);
+		// 视图按 (format, mip, slice) 缓存在纹理上，重复调用返回同一个对象；DXGI_FORMAT_UNKNOWN 表示使用纹理格式
+		std::shared_ptr<RenderTargetView> CreateRenderTargetView(TextureID texture_id, DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN, UInt mip_slice = 0, UInt array_slice = 0);
 		void SetRenderTargetViewAndDepthStencilView(std::shared_ptr<RenderTargetView> d3d11_render_target_view, std::shared_ptr<DepthStencilView> depth_stencil_view);
 		void SetRenderTargetViewAndDepthStencilView(const std::vector<std::shared_ptr<RenderTargetView>>& d3d11_render_target_view, std::shared_ptr<DepthStencilView> depth_stencil_view);
 		void SetRenderTargetViewWithoutDepthStencilView(const std::vector<std::shared_ptr<RenderTargetView>>& d3d11_render_target_view);
@@ -72,7 +145,7 @@ namespace Dolas
 		std::shared_ptr<RenderTargetView> GetBackBufferRTV() const;
 
 		// DepthStencilView
-		std::shared_ptr<DepthStencilView> CreateDepthStencilView(TextureID texture_id);
+		std::shared_ptr<DepthStencilView> CreateDepthStencilView(TextureID texture_id, DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN, UInt mip_slice = 0, UInt array_slice = 0);
 		void ClearDepthStencilView(std::shared_ptr<DepthStencilView> dsv, const DepthClearParams& depth_clear_params, const StencilClearParams& stencil_clear_params);
 	
 		// ViewPort
@@ -86,20 +159,101 @@ namespace Dolas
 		
 		// BlendState
 		void SetBlendState(BlendStateType type);
+
+		// 只绑定 stream 0（位置）并使用 InputLayoutType_POS_3，供只写深度的 pass（深度预通道 / 阴影）使用。
+		// 所有输入布局的位置都在 slot 0，其余属性流不会被读取
+		void SetPositionOnlyVertexInput(Bool enabled);
 		
 		// VertexContext
 		Bool BindVertexContext(std::shared_ptr<VertexContext> vertex_context, ID3D11ClassInstance* const* class_instances = nullptr, unsigned int num_class_instances = 0);
 		
 		// PixelContext
 		Bool BindPixelContext(std::shared_ptr<PixelContext> pixel_context, ID3D11ClassInstance* const* class_instances = nullptr, unsigned int num_class_instances = 0);
+
+		// Material
+		// 材质的 GlobalConstants 参数块连续存放在同一个常量 arena 中（GPU 端一个上传缓冲区），
+		// 共用同一个 shader 的材质各有一块，互不覆盖。size 为 0 时返回 ConstantBufferArena::INVALID_BLOCK
+		UInt AllocateMaterialParameterBlock(UInt size);
+		// handle 来自材质 shader 的 FindGlobalVariable；只修改 CPU 端数据，下一次 BindMaterial 时上传脏区间
+		Bool WriteMaterialParameters(UInt block, ConstantBufferVariableHandle handle, const void* data, std::size_t size);
+		// 绑定材质的 VS / PS，GlobalConstants 的根 CBV 指向材质自己的参数块
+		Bool BindMaterial(Material* material);
 		
 		// Buffer
 
 		// Texture
+		// 纹理 SRV descriptor 被原地重写后调用（异步加载完成时占位 SRV 换成真实纹理）：
+		// 常驻 SRV table 保存的是 descriptor 的副本，而复用判断只比较源句柄，需要据此重建
+		void InvalidateD3D12SrvTables() { ++m_d3d12_srv_content_generation; }
+		// 纹理内容代数与 SRV descriptor 释放代数之和，任一变化都使常驻 SRV table 失效
+		ULongLong GetD3D12SrvContentGeneration() const;
 
 		// DC
-		void DrawRenderPrimitive(RenderPrimitiveID render_primitive_id);
+		// lod_index 越界时绘制 LOD0
+		void DrawRenderPrimitive(RenderPrimitiveID render_primitive_id, UInt lod_index = 0);
+		// 使用 RenderPrimitive 的顶点缓冲，但从外部索引缓冲（例如 cluster 剔除后的压缩索引）中绘制一段区间
+		void DrawRenderPrimitiveIndexRange(RenderPrimitiveID render_primitive_id, BufferID index_buffer_id, UInt start_index_location, UInt index_count);
+		// 不绑定顶点 / 索引缓冲绘制 3 个顶点，VS 使用 InputLayoutType_NONE 并由 SV_VertexID 生成覆盖整个视口的三角形
+		void DrawFullScreenTriangle();
+
+		// 提交渲染图编译出的一个屏障批次（一次 ResourceBarrier 调用）。textures 为图资源句柄 -> TextureID；
+		// 转换以纹理当前跟踪的状态为 before，已处于目标状态的纹理跳过
+		void ExecuteRenderGraphBarriers(const std::vector<RenderGraphBarrier>& barriers, const std::vector<TextureID>& textures);
+
+		// Statistics
+		const RHIFrameStatistics& GetLastFrameStatistics() const { return m_last_frame_statistics; }
+
+		// GPU pass 统计：开启后每帧最多记录 kMaxGpuPassQueryCount 段，Present 等待 GPU 之后读回。
+		// 查询本身有开销（pipeline statistics 会打断部分硬件的并行），默认关闭
+		void SetGpuPassProfilingEnabled(Bool enabled) { m_gpu_pass_profiling_enabled = enabled; }
+		Bool IsGpuPassProfilingEnabled() const { return m_gpu_pass_profiling_enabled; }
+		// 返回查询下标；未开启、查询资源不可用或本帧槽位耗尽时返回 kInvalidGpuPassQuery
+		UInt BeginGpuPassQuery(const std::string& name);
+		void EndGpuPassQuery(UInt query_index);
+		// 最近一次 Present 读回的结果，下标与该帧 BeginGpuPassQuery 的返回值一致
+		const std::vector<RHIGpuPassStatistics>& GetLastFrameGpuPassStatistics() const { return m_last_frame_gpu_pass_statistics; }
+
+		PipelineStateLibraryStatistics GetPipelineStateLibraryStatistics() const;
+		// 第一帧（BeginFrame 到 Present）的 CPU 耗时，以及其中创建 PSO 的耗时
+		Double GetFirstFrameMilliseconds() const { return m_first_frame_milliseconds; }
+		Double GetFirstFramePipelineStateMilliseconds() const { return m_first_frame_pipeline_state_milliseconds; }
+
+		// 材质加载时调用：根据磁盘缓存中记录过的状态组合，在工作线程中提前创建这组 shader 的 PSO
+		void PrecompilePipelineStates(std::shared_ptr<VertexContext> vertex_context, std::shared_ptr<PixelContext> pixel_context);
+
+		// Bindless：纹理通过材质常量中的 heap 下标访问（SM5.1 无界 descriptor 数组，register(t0, space1)）
+		Bool IsBindlessTextureEnabled() const { return m_bindless_texture_enabled; }
 	private:
+		// 当前 command list 上已绑定的 D3D12 状态，用于跳过相邻 draw 之间的重复绑定
+		struct D3D12BindingCache
+		{
+			Bool global_resources_bound = false;
+			D3D12_GPU_VIRTUAL_ADDRESS vs_global_constant_buffer = 0;
+			D3D12_GPU_VIRTUAL_ADDRESS ps_global_constant_buffer = 0;
+			UINT64 vs_srv_table = 0; // 当前绑定的 SRV table GPU 句柄
+			UINT64 ps_srv_table = 0;
+			ID3D12PipelineState* pipeline_state = nullptr;
+			RenderPrimitiveID render_primitive_id = RENDER_PRIMITIVE_ID_EMPTY;
+			BufferID index_buffer_id = BUFFER_ID_EMPTY;
+		};
+		// command list 重新开始录制或被外部（ImGui）改写根签名后必须调用
+		void ResetD3D12BindingCache();
+		// bindless 模式下 shader 只有 SM5.1 字节码、没有 D3D11 shader 对象，shader / 输入装配 / draw 不再镜像到 D3D11 上
+		ID3D11DeviceContext* GetD3D11MirrorDrawContext() const { return m_bindless_texture_enabled ? nullptr : m_d3d_immediate_context; }
+		// 设置输入布局、拓扑、VB / IB 与 PSO，跳过与上一次 draw 相同的绑定；没有有效 VS 时返回 false
+		Bool BindRenderPrimitive(RenderPrimitiveID render_primitive_id, RenderPrimitive* render_primitive, BufferID index_buffer_id);
+		void SetD3D12GlobalConstantBuffer(UINT root_parameter_index, ID3D12Resource* constant_buffer, D3D12_GPU_VIRTUAL_ADDRESS& bound_address);
+		// address 为 0 时绑定 dummy 常量缓冲
+		void SetD3D12GlobalConstantBuffer(UINT root_parameter_index, D3D12_GPU_VIRTUAL_ADDRESS address, D3D12_GPU_VIRTUAL_ADDRESS& bound_address);
+		// material_block 有效时 GlobalConstants 使用材质参数块，否则使用 context 自己的常量缓冲
+		Bool BindVertexContext(std::shared_ptr<VertexContext> vertex_context, UInt material_block, ID3D11ClassInstance* const* class_instances, unsigned int num_class_instances);
+		Bool BindPixelContext(std::shared_ptr<PixelContext> pixel_context, UInt material_block, ID3D11ClassInstance* const* class_instances, unsigned int num_class_instances);
+		// 返回材质参数块的 GPU 地址；arena 没有 GPU 缓冲区（或块无效）时返回 0
+		D3D12_GPU_VIRTUAL_ADDRESS GetMaterialParameterBlockAddress(UInt block) const;
+		// 把 arena 的脏区间拷贝到 GPU 缓冲区，容量不足时重新创建（旧缓冲区在下一帧开始时释放）
+		void FlushMaterialConstants();
+		Bool EnsureD3D12MaterialConstantCapacity();
+
 		bool InitializeD3D11CompatibilityDevice();
 		bool InitializeD3D12CompatibilityResources();
 
@@ -109,7 +263,7 @@ namespace Dolas
 		void InitializePrimitiveTopology();
 		void InitializeInputLayoutDescs();
 
-		std::shared_ptr<RenderTargetView> CreateRenderTargetViewByD3D11Texture(ID3D11Texture2D* texture_id);
+		std::shared_ptr<RenderTargetView> CreateRenderTargetViewByD3D11Texture(ID3D11Texture2D* texture_id, DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN, UInt mip_slice = 0, UInt array_slice = 0);
 		ID3D11RasterizerState* CreateRasterizerState(RasterizerStateType type);
 		Bool CreateDepthStencilState(DepthStencilStateType type);
 		ID3D11BlendState* CreateBlendState(BlendStateType type);
@@ -126,14 +280,37 @@ namespace Dolas
 
 		void SetIndexBuffer(BufferID index_buffer_id);
 
-		void DrawIndexed(UInt index_count);
+		void DrawIndexed(UInt index_count, UInt start_index_location = 0);
 
 		void TransitionTexture(class Texture* texture, D3D12_RESOURCE_STATES after_state);
 		void TransitionResource(ID3D12Resource* resource, D3D12_RESOURCE_STATES before_state, D3D12_RESOURCE_STATES after_state);
 		void UpdateD3D12UploadBuffer(ID3D12Resource* resource, const void* data, std::size_t size);
+		// 把常量写入本帧的上传环并返回其 GPU 地址；环耗尽时写入 fallback_buffer（同帧的后续更新会互相覆盖）
+		D3D12_GPU_VIRTUAL_ADDRESS WriteD3D12TransientConstants(ID3D12Resource* fallback_buffer, const void* data, std::size_t size);
+		// 记录根 CBV 的新地址，command list 上已绑定全局资源时立即重新设置
+		void SetD3D12RootConstantBufferView(UINT root_parameter_index, D3D12_GPU_VIRTUAL_ADDRESS address, D3D12_GPU_VIRTUAL_ADDRESS& current_address);
 		void BindD3D12GlobalResources();
 		void BindD3D12SrvTable(std::shared_ptr<ShaderContext> shader_context, bool pixel_shader);
-		ID3D12PipelineState* GetOrCreateD3D12PipelineState(RenderPrimitive* render_primitive);
+		void UploadGlobalConstants(ShaderContext* shader_context);
+		// 返回 shader_context 对应的 SRV table：常驻 table 仅在纹理绑定变化时重写
+		Bool PrepareD3D12SrvTable(ShaderContext* shader_context, D3D12_GPU_DESCRIPTOR_HANDLE* out_table_gpu);
+		void WriteD3D12SrvTable(D3D12_CPU_DESCRIPTOR_HANDLE table_cpu, const D3D12_CPU_DESCRIPTOR_HANDLE* srv_sources);
+		InputLayoutType GetCurrentInputLayoutType(const RenderPrimitive* render_primitive) const;
+		PipelineStateRecord MakeCurrentPipelineStateRecord(InputLayoutType input_layout_type) const;
+		Bool BuildD3D12PipelineStateDesc(
+			const PipelineStateRecord& record,
+			const ShaderBytecodeView& vs_bytecode,
+			const ShaderBytecodeView& ps_bytecode,
+			D3D12_GRAPHICS_PIPELINE_STATE_DESC& out_desc) const;
+		ID3D12PipelineState* GetOrCreateD3D12PipelineState(InputLayoutType input_layout_type);
+		// 当前状态对应的 PSO 与上一次 draw 不同时才调用 SetPipelineState
+		void BindD3D12PipelineState(InputLayoutType input_layout_type);
+		void WaitForPipelineStatePrecompile();
+		Bool CreateD3D12GpuPassQueries();
+		// 在 command list 关闭之前把本帧的查询结果拷贝到回读缓冲
+		void ResolveD3D12GpuPassQueries();
+		// GPU 执行完毕之后调用
+		void ReadBackD3D12GpuPassQueries();
 		void RenderImGuiDrawData();
 
 		ID3D11Device* m_d3d_device;
@@ -166,16 +343,50 @@ namespace Dolas
 		ID3D12Resource* m_d3d12_per_view_parameters_buffer = nullptr;
 		ID3D12Resource* m_d3d12_per_object_parameters_buffer = nullptr;
 		ID3D12Resource* m_d3d12_dummy_constant_buffer = nullptr;
+		// per-view / per-object 常量的每帧线性上传环（常驻映射）。RHI 每帧结束都会等待 GPU，BeginFrame 时整体复用
+		ID3D12Resource* m_d3d12_transient_constant_buffer = nullptr;
+		UByte* m_d3d12_transient_constant_data = nullptr;
+		ULongLong m_d3d12_transient_constant_offset = 0;
+		D3D12_GPU_VIRTUAL_ADDRESS m_d3d12_per_view_address = 0;
+		// 材质参数 arena：CPU 端数据与常驻映射的 GPU 上传缓冲区。参数在原地更新，
+		// 与之前每个 shader 一个常量缓冲一样，本帧已录制的 draw 会看到同一帧之后写入的值
+		ConstantBufferArena m_material_constant_arena;
+		std::vector<ConstantBufferRange> m_material_constant_dirty_ranges;
+		ID3D12Resource* m_d3d12_material_constant_buffer = nullptr;
+		UByte* m_d3d12_material_constant_data = nullptr;
+		UInt m_d3d12_material_constant_capacity = 0;
+		std::vector<ID3D12Resource*> m_d3d12_retired_constant_buffers; // 扩容时换下、本帧可能仍被引用的缓冲区
+		D3D12_GPU_VIRTUAL_ADDRESS m_d3d12_per_object_address = 0;
 		ID3D12RootSignature* m_d3d12_root_signature = nullptr;
-		std::unordered_map<std::size_t, ID3D12PipelineState*> m_d3d12_pipeline_state_cache;
+		PipelineStateLibrary m_pipeline_state_library;
+		std::vector<ULong> m_pipeline_precompile_tasks; // TaskGUID
 		DXGI_FORMAT m_current_rtv_formats[8] {};
 		DXGI_FORMAT m_current_dsv_format = DXGI_FORMAT_UNKNOWN;
 		UINT m_current_render_target_count = 0;
 		RasterizerStateType m_current_rasterizer_state_type = RasterizerStateType_SolidBackCull;
 		DepthStencilStateType m_current_depth_stencil_state_type = DepthStencilStateType_DepthWriteLess_StencilWriteStatic;
 		BlendStateType m_current_blend_state_type = BlendStateType_Opaque;
+		Bool m_position_only_vertex_input = false;
 		PrimitiveTopology m_current_primitive_topology = PrimitiveTopology_TriangleList;
 		bool m_d3d12_frame_started = false;
+		D3D12BindingCache m_d3d12_binding_cache;
+		D3D12_GPU_DESCRIPTOR_HANDLE m_d3d12_null_srv_table_gpu {};
+		ULongLong m_d3d12_srv_content_generation = 0; // 与 ShaderContext 记录的代数不同时重写 SRV table
+		ULongLong m_frame_serial = 0;
+		Bool m_bindless_texture_enabled = false;
+		Vector4 m_main_light_direction_intensity = Vector4(-1.0f, 1.0f, -1.0f, 1.0f);
+		RHIFrameStatistics m_frame_statistics;
+		RHIFrameStatistics m_last_frame_statistics;
+		Bool m_gpu_pass_profiling_enabled = false;
+		Bool m_gpu_pass_queries_unavailable = false; // 创建失败后不再重试
+		ID3D12QueryHeap* m_d3d12_timestamp_query_heap = nullptr;
+		ID3D12QueryHeap* m_d3d12_pipeline_statistics_query_heap = nullptr;
+		ID3D12Resource* m_d3d12_query_readback_buffer = nullptr;
+		std::vector<std::string> m_gpu_pass_query_names;        // 本帧已开始的查询
+		std::vector<RHIGpuPassStatistics> m_last_frame_gpu_pass_statistics;
+		std::chrono::high_resolution_clock::time_point m_first_frame_start_time;
+		Double m_first_frame_milliseconds = 0.0;
+		Double m_first_frame_pipeline_state_milliseconds = 0.0;
 	};
 
 	// RAII scope for GPU events
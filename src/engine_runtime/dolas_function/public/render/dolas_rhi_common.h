@@ -15,6 +15,9 @@ struct ID3D11InputLayout;
 
 namespace Dolas
 {
+	// 每个 shader 常驻 SRV descriptor table 的大小（t0..t15）；ShaderContext 释放时按同样大小归还
+	constexpr UInt kD3D12SrvTableSize = 16;
+
 	struct ShaderBytecodeView
 	{
 		const void* data = nullptr;
@@ -64,6 +67,7 @@ namespace Dolas
 		RasterizerStateType_SolidBackCull,
 		RasterizerStateType_SolidFrontCull,
 		RasterizerStateType_Wireframe,
+		RasterizerStateType_ShadowDepthBias,  // 阴影深度：常量 + 斜率深度偏移，不做背面剔除
 		RasterizerStateType_Count,
 	};
 
@@ -83,6 +87,8 @@ namespace Dolas
 		DepthStencilStateType_DepthDisabled_StencilDisable,
 		DepthStencilStateType_DepthDisabled_StencilReadSky,
 		DepthStencilStateType_DepthReadOnly,
+		DepthStencilStateType_DepthWriteLess,  // 只写深度，不使用模板（阴影图）
+		DepthStencilStateType_DepthEqual_StencilWriteStatic,  // 深度预通道之后的 GBuffer：EQUAL 测试、不写深度，模板仍标记为静态物体
 		DepthStencilStateType_Count,
 	};
 
@@ -120,6 +126,16 @@ namespace Dolas
 		Matrix4x4 view;
 		Matrix4x4 proj;
 		Vector4 camera_position; // w is unused
+		Matrix4x4 inverse_view_proj; // deferred shading 由深度重建世界坐标
+	};
+
+	// StructuredBuffer<LocalLightData> 的元素，布局与 light.hlsli 一致
+	struct LocalLightData
+	{
+		Vector4 position_range;     // xyz: 世界坐标, w: 作用范围
+		Vector4 color_type;         // rgb: 颜色 * 强度, w: LocalLightType
+		Vector4 direction;          // xyz: 聚光朝向
+		Vector4 spot_scale_offset;  // 聚光锥衰减 saturate(cos * x + y)，点光为 (0, 1)
 	};
 
 	struct PerObjectConstantBuffer
@@ -165,6 +181,7 @@ namespace Dolas
 		InputLayoutType_POS_3_UV_2_NORM_3,
 		InputLayoutType_POS_3_UV_2_NORM_3_TANG_3,
 		InputLayoutType_POS_3_NORM_3,
+		InputLayoutType_NONE,  // 没有顶点输入，VS 由 SV_VertexID 生成顶点（全屏三角形）
 		InputLayoutType_Count
 	};
 
@@ -7,8 +7,11 @@
 #include <unordered_map>
 #include <vector>
 #include <d3d12.h>
+#include "dolas_constant_buffer_layout.h"
 #include "dolas_hash.h"
 #include "dolas_math.h"
+#include "dolas_shader_permutation.h"
+#include "dolas_shader_reflection.h"
 #include "render/dolas_rhi_common.h"
 
 struct ID3D10Blob;
@@ -16,49 +19,43 @@ typedef ID3D10Blob ID3DBlob;
 struct ID3D11ShaderReflection;
 struct ID3D11ShaderResourceView;
 struct ID3D11Buffer;
+struct ID3D11DeviceContext;
 struct ID3D11VertexShader;
 struct ID3D11PixelShader;
 struct ID3D12Resource;
 
 namespace Dolas
 {
-    struct ConstantBufferVariableInfo
-    {
-        std::string name;
-        UInt start_offset = 0;
-        UInt size = 0;
-        UInt flags = 0;
-    };
-
-    struct ConstantBufferInfo
-    {
-        std::string name;
-        UInt size = 0;
-        UInt variable_count = 0;
-		std::vector<ConstantBufferVariableInfo> variable_descs;
-    };
-
-    struct ShaderReflectionInfo
-    {
-        UInt constant_buffer_count = 0;
-        UInt bound_resource_count = 0;
-        UInt instruction_count = 0;
-		std::vector<ConstantBufferInfo> constant_buffer_descs;
-    };
-
     class ShaderContext
     {
         friend class ShaderManager;
+        friend class DolasRHI;
     public:
         ShaderContext();
         ~ShaderContext();
 
         virtual bool BuildFromFile(const std::string& file_path, const std::string& entry_point) = 0;
+        // 使用离线编译好的 bytecode，跳过 D3DCompile；reflection 为 nullptr 时对 bytecode 调用 D3DReflect
+        bool LoadFromBytecode(const std::string& file_path, const std::string& entry_point, const void* bytecode, size_t bytecode_size, const ShaderReflectionInfo* reflection);
         virtual void Release();
+        // 运行时编译使用的 profile 与宏（bindless 模式为 SM5.1 + DOLAS_BINDLESS_TEXTURES，另加启用的 keyword），
+        // 对应离线编译清单中的 target / defines，用来查找预编译的变体
+        virtual std::string GetCompileTarget() const = 0;
+        std::string GetCompileDefines() const;
+        // 启用的 shader keyword（已按本 shader 的声明筛选），需要在 BuildFromFile / LoadFromBytecode 之前设置
+        void SetShaderKeywords(const std::vector<std::string>& keywords);
+        const std::vector<std::string>& GetShaderKeywords() const { return m_shader_keywords; }
+        ShaderPermutationKey GetPermutationKey() const { return m_permutation_key; }
         ShaderBytecodeView GetShaderBytecode() const;
+        // bytecode 的内容哈希（64 位 FNV-1a），在 PostBuildFromFile 中计算，用作 PSO 缓存键的一部分
+        ULongLong GetShaderBytecodeHash() const { return m_shader_bytecode_hash; }
+        const std::string& GetFilePath() const { return m_file_path; }
+        const std::string& GetEntryPoint() const { return m_entry_point; }
         void SetShaderResourceView(size_t slot, ID3D11ShaderResourceView* srv);
         void SetShaderResourceView(size_t slot, TextureID texture_id);
         void SetShaderResourceView(size_t slot, class Texture* texture);
+        // 结构化缓冲区（StructuredBuffer<T>）
+        void SetShaderResourceView(size_t slot, class Buffer* buffer);
         const std::unordered_map<size_t, ID3D11ShaderResourceView*>& GetSlotToSRVMap() const {return m_slot_to_srv_map;};
         const std::unordered_map<size_t, TextureID>& GetSlotToTextureMap() const { return m_slot_to_texture_map; }
         const std::unordered_map<size_t, D3D12_CPU_DESCRIPTOR_HANDLE>& GetSlotToD3D12SRVCpuMap() const { return m_slot_to_d3d12_srv_cpu_map; }
@@ -69,19 +66,45 @@ namespace Dolas
 		ID3D12Resource* GetD3D12GlobalConstantBuffer() { return m_d3d12_global_constant_buffer; };
         void ConvertTextureIDMapToSRVMap();
         // Global constant buffer data（已根据反射布局预打包好的原始字节）
-        const std::vector<uint8_t>& GetGlobalConstantBufferData() const { return m_global_cb_data; }
+        const std::vector<uint8_t>& GetGlobalConstantBufferData() const { return m_global_cb_data.GetBytes(); }
+        // GlobalConstants 中变量的 handle：每帧都写的变量应解析一次后保存，
+        // 按名字的 SetGlobalVariable 每次都要计算名字哈希。没有该变量时返回无效 handle，写入时忽略
+        ConstantBufferVariableHandle FindGlobalVariable(UInt name_id) const { return m_global_cb_layout.FindVariable(name_id); }
+        ConstantBufferVariableHandle FindGlobalVariable(const std::string& name) const { return m_global_cb_layout.FindVariable(name); }
         // 设置某个全局变量（按变量名写入 GlobalConstants cbuffer 对应区域）
         void SetGlobalVariable(const std::string& name, const Vector4& values);
+        // 写入 uint 类型的全局变量（如 bindless 纹理下标 albedo_map_index）
+        void SetGlobalVariable(const std::string& name, UInt value);
+        // 写入矩阵数组（如 float4x4 g_ShadowCascadeMatrices[4]），按 C++ 行主序原样拷贝，与 per-view 常量一致
+        void SetGlobalVariable(const std::string& name, const Matrix4x4* matrices, UInt count);
+        // 写入 float4 数组（如 float4 g_SkyIrradianceSH[9]），cbuffer 中数组元素按 16 字节对齐，与 Vector4 连续存放一致
+        void SetGlobalVariable(const std::string& name, const Vector4* values, UInt count);
+        void SetGlobalVariable(ConstantBufferVariableHandle handle, const Vector4& values);
+        void SetGlobalVariable(ConstantBufferVariableHandle handle, UInt value);
+        void SetGlobalVariable(ConstantBufferVariableHandle handle, const Matrix4x4* matrices, UInt count);
+        void SetGlobalVariable(ConstantBufferVariableHandle handle, const Vector4* values, UInt count);
+        // 整块覆盖 GlobalConstants（例如把材质参数块拷贝到没有常量 arena 的 D3D11 路径），只有变化时才会上传
+        void SetGlobalConstants(const UByte* data, UInt size);
     protected:
+        // 写入只修改 CPU 端数据并记录脏区间，由 DolasRHI 在绑定时调用 UploadGlobalConstants 上传；
+        // 返回实际上传的字节数，没有改动时为 0
+        UInt UploadGlobalConstants(ID3D11DeviceContext* d3d11_context);
         void AnalyzeConstantBuffers(UInt constant_buffers_count);
         void GenerateReflectionAndDesc();
+        void AnalyzeBoundResources(UInt bound_resources_count);
+        // 由 m_d3d_shader_blob 创建 D3D11 shader 对象；bindless 模式或没有 D3D11 设备时不创建
+        virtual bool CreateD3DShaderObject() = 0;
         void CreateGlobalConstantBuffer();
         void PostBuildFromFile();
+        std::vector<std::pair<std::string, std::string>> GetCompileDefineList() const;
     protected:
         std::string m_file_path;
         std::string m_entry_point;
+        std::vector<std::string> m_shader_keywords;
+        ShaderPermutationKey m_permutation_key = 0;
 
         ID3DBlob* m_d3d_shader_blob = nullptr;
+        ULongLong m_shader_bytecode_hash = 0;
         ID3D11ShaderReflection* m_d3d_shader_reflection = nullptr;
 
 		ShaderReflectionInfo m_shader_reflection_info;
@@ -93,7 +116,17 @@ namespace Dolas
 
 		ID3D11Buffer* m_global_constant_buffer = nullptr;
         ID3D12Resource* m_d3d12_global_constant_buffer = nullptr;
-        std::vector<uint8_t> m_global_cb_data;
+        ConstantBufferLayout m_global_cb_layout;
+        ConstantBufferData m_global_cb_data;
+
+        // 常驻的 D3D12 SRV descriptor table，由 DolasRHI 在绑定时按需创建；
+        // 记录上次写入时每个 slot 的源 descriptor 和内容代数，逐项比较不同才重新写入
+        D3D12_CPU_DESCRIPTOR_HANDLE m_d3d12_srv_table_cpu {};
+        D3D12_GPU_DESCRIPTOR_HANDLE m_d3d12_srv_table_gpu {};
+        D3D12_CPU_DESCRIPTOR_HANDLE m_d3d12_srv_table_sources[kD3D12SrvTableSize] {};
+        ULongLong m_d3d12_srv_table_content_generation = 0;
+        Bool m_d3d12_srv_table_valid = false;
+        ULongLong m_d3d12_srv_table_last_bound_frame = 0;
 
     }; // class ShaderContext
 
@@ -104,9 +137,11 @@ namespace Dolas
         ~VertexContext();
         virtual bool BuildFromFile(const std::string& file_path, const std::string& entry_point) override;
         virtual void Release() override;
+        virtual std::string GetCompileTarget() const override;
         ID3D11VertexShader* GetD3DVertexShader();
 
     protected:
+        virtual bool CreateD3DShaderObject() override;
         ID3D11VertexShader* m_d3d_vertex_shader = nullptr;
     }; // class VertexContext
 
@@ -117,9 +152,11 @@ namespace Dolas
         ~PixelContext();
         virtual bool BuildFromFile(const std::string& file_path, const std::string& entry_point) override;
         virtual void Release() override;
+        virtual std::string GetCompileTarget() const override;
         ID3D11PixelShader* GetD3DPixelShader();
         
     protected:
+        virtual bool CreateD3DShaderObject() override;
         ID3D11PixelShader* m_d3d_pixel_shader = nullptr;
     }; // class PixelContext
 
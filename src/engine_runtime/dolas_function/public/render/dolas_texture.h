@@ -2,7 +2,9 @@
 #define DOLAS_TEXTURE_H
 
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <d3d12.h>
 #include "dolas_hash.h"
 
@@ -12,6 +14,9 @@ struct ID3D12Resource;
 
 namespace Dolas
 {
+    class RenderTargetView;
+    class DepthStencilView;
+
     enum class DolasTextureType
     {
         TEXTURE_2D,
@@ -30,8 +35,12 @@ namespace Dolas
         BC3_SRGB,
         BC7_UNORM,
         BC7_SRGB,
+        BC4_UNORM,
+        BC5_UNORM,
+        BC6H_UF16,
         R32G32B32A32_FLOAT,
         R16G16B16A16_FLOAT,
+        R10G10B10A2_UNORM,
         // Depth/Stencil related
         D24_UNORM_S8_UINT,
         D32_FLOAT,
@@ -56,6 +65,7 @@ namespace Dolas
             m_d3d12_resource_state = state;
         }
         void SetD3D12ResourceState(D3D12_RESOURCE_STATES state) { m_d3d12_resource_state = state; }
+        void SetD3D12Placed(bool placed) { m_d3d12_placed = placed; }
         void SetD3D12SrvHandles(D3D12_CPU_DESCRIPTOR_HANDLE cpu_handle, D3D12_GPU_DESCRIPTOR_HANDLE gpu_handle)
         {
             m_d3d12_srv_cpu_handle = cpu_handle;
@@ -63,12 +73,15 @@ namespace Dolas
         }
         void SetD3D12RtvHandle(D3D12_CPU_DESCRIPTOR_HANDLE rtv_handle) { m_d3d12_rtv_handle = rtv_handle; }
         void SetD3D12DsvHandle(D3D12_CPU_DESCRIPTOR_HANDLE dsv_handle) { m_d3d12_dsv_handle = dsv_handle; }
+        void SetBindlessIndex(uint32_t bindless_index) { m_bindless_index = bindless_index; }
 
         // Getters
         ID3D11Texture2D* GetD3DTexture2D() const { return m_d3d_texture_2d; }
         ID3D11ShaderResourceView* GetShaderResourceView();
         ID3D12Resource* GetD3D12Resource() const { return m_d3d12_resource; }
         D3D12_RESOURCE_STATES GetD3D12ResourceState() const { return m_d3d12_resource_state; }
+        // placed resource 与其他纹理共用一个堆（渲染图瞬态纹理别名），换用前需要别名屏障
+        bool IsD3D12Placed() const { return m_d3d12_placed; }
         D3D12_CPU_DESCRIPTOR_HANDLE GetD3D12SrvCpuHandle() const { return m_d3d12_srv_cpu_handle; }
         D3D12_GPU_DESCRIPTOR_HANDLE GetD3D12SrvGpuHandle() const { return m_d3d12_srv_gpu_handle; }
         D3D12_CPU_DESCRIPTOR_HANDLE GetD3D12RtvHandle() const { return m_d3d12_rtv_handle; }
@@ -76,6 +89,17 @@ namespace Dolas
         bool HasD3D12Srv() const { return m_d3d12_srv_cpu_handle.ptr != 0 && m_d3d12_srv_gpu_handle.ptr != 0; }
         bool HasD3D12Rtv() const { return m_d3d12_rtv_handle.ptr != 0; }
         bool HasD3D12Dsv() const { return m_d3d12_dsv_handle.ptr != 0; }
+        // 在全局 shader-visible SRV heap 中的稳定下标，shader 通过 g_bindless_textures[index] 访问；0 为 null SRV
+        uint32_t GetBindlessIndex() const { return m_bindless_index; }
+
+        // RTV/DSV 按 (format, mip, slice) 缓存在纹理上，每帧请求同一个视图时直接复用
+        static uint64_t MakeViewKey(uint32_t format, uint32_t mip_slice, uint32_t array_slice);
+        std::shared_ptr<RenderTargetView> FindRenderTargetView(uint64_t view_key) const;
+        std::shared_ptr<DepthStencilView> FindDepthStencilView(uint64_t view_key) const;
+        void AddRenderTargetView(uint64_t view_key, const std::shared_ptr<RenderTargetView>& render_target_view);
+        void AddDepthStencilView(uint64_t view_key, const std::shared_ptr<DepthStencilView>& depth_stencil_view);
+        // 丢弃缓存的视图并归还它们额外占用的 descriptor；纹理被重建（例如窗口 resize）时调用
+        void InvalidateViews();
         
         uint32_t GetWidth() const { return m_width; }
         uint32_t GetHeight() const { return m_height; }
@@ -94,10 +118,15 @@ namespace Dolas
         ID3D11ShaderResourceView* m_d3d_shader_resource_view = nullptr;
         ID3D12Resource* m_d3d12_resource = nullptr;
         D3D12_RESOURCE_STATES m_d3d12_resource_state = D3D12_RESOURCE_STATE_COMMON;
+        bool m_d3d12_placed = false;
         D3D12_CPU_DESCRIPTOR_HANDLE m_d3d12_srv_cpu_handle {};
         D3D12_GPU_DESCRIPTOR_HANDLE m_d3d12_srv_gpu_handle {};
         D3D12_CPU_DESCRIPTOR_HANDLE m_d3d12_rtv_handle {};
         D3D12_CPU_DESCRIPTOR_HANDLE m_d3d12_dsv_handle {};
+        uint32_t m_bindless_index = 0;
+
+        std::unordered_map<uint64_t, std::shared_ptr<RenderTargetView>> m_render_target_views;
+        std::unordered_map<uint64_t, std::shared_ptr<DepthStencilView>> m_depth_stencil_views;
 
         uint32_t m_width = 0;
         uint32_t m_height = 0;
@@ -0,0 +1,95 @@
+#include "dolas_descriptor_allocator.h"
+#include <algorithm>
+
+namespace Dolas
+{
+	void DescriptorIndexAllocator::Initialize(unsigned int first_index, unsigned int capacity)
+	{
+		m_free_ranges.clear();
+		m_first_index = first_index;
+		m_capacity = capacity;
+		m_allocated_count = 0;
+		++m_free_generation;
+		if (capacity > 0)
+		{
+			m_free_ranges.emplace(first_index, capacity);
+		}
+	}
+
+	unsigned int DescriptorIndexAllocator::Allocate(unsigned int count /*= 1*/)
+	{
+		if (count == 0)
+		{
+			return INVALID_INDEX;
+		}
+
+		for (auto iter = m_free_ranges.begin(); iter != m_free_ranges.end(); ++iter)
+		{
+			if (iter->second < count)
+			{
+				continue;
+			}
+
+			const unsigned int index = iter->first;
+			const unsigned int remaining = iter->second - count;
+			m_free_ranges.erase(iter);
+			if (remaining > 0)
+			{
+				m_free_ranges.emplace(index + count, remaining);
+			}
+			m_allocated_count += count;
+			return index;
+		}
+		return INVALID_INDEX;
+	}
+
+	bool DescriptorIndexAllocator::Free(unsigned int index, unsigned int count /*= 1*/)
+	{
+		if (count == 0 || index < m_first_index ||
+			static_cast<unsigned long long>(index) + count > static_cast<unsigned long long>(m_first_index) + m_capacity)
+		{
+			return false;
+		}
+
+		// 与后一个空闲区间重叠或相接
+		auto next = m_free_ranges.lower_bound(index);
+		if (next != m_free_ranges.end() && next->first < index + count)
+		{
+			return false;
+		}
+		// 与前一个空闲区间重叠或相接
+		auto prev = (next == m_free_ranges.begin()) ? m_free_ranges.end() : std::prev(next);
+		if (prev != m_free_ranges.end() && prev->first + prev->second > index)
+		{
+			return false;
+		}
+
+		unsigned int merged_start = index;
+		unsigned int merged_count = count;
+		if (prev != m_free_ranges.end() && prev->first + prev->second == index)
+		{
+			merged_start = prev->first;
+			merged_count += prev->second;
+			m_free_ranges.erase(prev);
+		}
+		if (next != m_free_ranges.end() && next->first == index + count)
+		{
+			merged_count += next->second;
+			m_free_ranges.erase(next);
+		}
+		m_free_ranges.emplace(merged_start, merged_count);
+		m_allocated_count -= count;
+		++m_free_generation;
+		return true;
+	}
+
+	unsigned int DescriptorIndexAllocator::GetLargestFreeRange() const
+	{
+		unsigned int largest = 0;
+		for (const auto& range : m_free_ranges)
+		{
+			largest = std::max(largest, range.second);
+		}
+		return largest;
+	}
+}
@@ -60,6 +60,7 @@ namespace Dolas
 
     bool RenderHardwareInterface::Clear()
     {
+        ReleaseCopyQueue();
         WaitForGpu();
 
         if (m_fence_event)
@@ -219,15 +220,101 @@ namespace Dolas
         return true;
     }
 
+    bool RenderHardwareInterface::ExecuteCopyCommands(const std::function<bool(ID3D12GraphicsCommandList*)>& record_commands, UINT64* out_fence_value)
+    {
+        if (out_fence_value)
+        {
+            *out_fence_value = 0;
+        }
+        if (!record_commands)
+        {
+            return false;
+        }
+        if (!m_copy_command_list)
+        {
+            return ExecuteImmediate(record_commands);
+        }
+
+        const UINT allocator_index = m_copy_command_allocator_index;
+        m_copy_command_allocator_index = (m_copy_command_allocator_index + 1) % kCopyCommandAllocatorCount;
+        WaitForCopyFence(m_copy_command_allocator_fence_values[allocator_index]);
+
+        ID3D12CommandAllocator* command_allocator = m_copy_command_allocators[allocator_index];
+        HRESULT hr = command_allocator->Reset();
+        if (FAILED(hr))
+        {
+            LOG_ERROR("Failed to reset D3D12 copy command allocator! HRESULT: 0x{0:X}", hr);
+            return false;
+        }
+
+        hr = m_copy_command_list->Reset(command_allocator, nullptr);
+        if (FAILED(hr))
+        {
+            LOG_ERROR("Failed to reset D3D12 copy command list! HRESULT: 0x{0:X}", hr);
+            return false;
+        }
+
+        if (!record_commands(m_copy_command_list))
+        {
+            m_copy_command_list->Close();
+            return false;
+        }
+
+        hr = m_copy_command_list->Close();
+        if (FAILED(hr))
+        {
+            LOG_ERROR("Failed to close D3D12 copy command list! HRESULT: 0x{0:X}", hr);
+            return false;
+        }
+
+        ID3D12CommandList* command_lists[] = { m_copy_command_list };
+        m_copy_command_queue->ExecuteCommandLists(1, command_lists);
+
+        const UINT64 fence_value = ++m_copy_fence_value;
+        hr = m_copy_command_queue->Signal(m_copy_fence, fence_value);
+        if (FAILED(hr))
+        {
+            LOG_ERROR("Failed to signal D3D12 copy fence! HRESULT: 0x{0:X}", hr);
+            return false;
+        }
+        m_copy_command_allocator_fence_values[allocator_index] = fence_value;
+        if (out_fence_value)
+        {
+            *out_fence_value = fence_value;
+        }
+        return true;
+    }
+
+    UINT64 RenderHardwareInterface::GetCompletedCopyFenceValue() const
+    {
+        return m_copy_fence ? m_copy_fence->GetCompletedValue() : m_copy_fence_value;
+    }
+
+    void RenderHardwareInterface::WaitForCopyFence(UINT64 fence_value)
+    {
+        if (!m_copy_fence || !m_copy_fence_event || m_copy_fence->GetCompletedValue() >= fence_value)
+        {
+            return;
+        }
+
+        HRESULT hr = m_copy_fence->SetEventOnCompletion(fence_value, m_copy_fence_event);
+        if (FAILED(hr))
+        {
+            LOG_ERROR("Failed to set D3D12 copy fence completion event! HRESULT: 0x{0:X}", hr);
+            return;
+        }
+        WaitForSingleObject(m_copy_fence_event, INFINITE);
+    }
+
     bool RenderHardwareInterface::AllocateRtvDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE* out_cpu_handle)
     {
-        if (!m_rtv_heap || !out_cpu_handle || m_rtv_descriptor_next_index >= kRtvDescriptorCount)
+        const UINT descriptor_index = m_rtv_heap ? m_rtv_descriptor_allocator.Allocate() : DescriptorIndexAllocator::INVALID_INDEX;
+        if (!out_cpu_handle || descriptor_index == DescriptorIndexAllocator::INVALID_INDEX)
         {
             LOG_ERROR("Failed to allocate D3D12 RTV descriptor.");
             return false;
         }
 
-        const UINT descriptor_index = m_rtv_descriptor_next_index++;
         *out_cpu_handle = m_rtv_heap->GetCPUDescriptorHandleForHeapStart();
         out_cpu_handle->ptr += static_cast<SIZE_T>(descriptor_index) * m_rtv_descriptor_size;
         return true;
@@ -235,13 +322,13 @@ namespace Dolas
 
     bool RenderHardwareInterface::AllocateDsvDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE* out_cpu_handle)
     {
-        if (!m_dsv_heap || !out_cpu_handle || m_dsv_descriptor_next_index >= kDsvDescriptorCount)
+        const UINT descriptor_index = m_dsv_heap ? m_dsv_descriptor_allocator.Allocate() : DescriptorIndexAllocator::INVALID_INDEX;
+        if (!out_cpu_handle || descriptor_index == DescriptorIndexAllocator::INVALID_INDEX)
         {
             LOG_ERROR("Failed to allocate D3D12 DSV descriptor.");
             return false;
         }
 
-        const UINT descriptor_index = m_dsv_descriptor_next_index++;
         *out_cpu_handle = m_dsv_heap->GetCPUDescriptorHandleForHeapStart();
         out_cpu_handle->ptr += static_cast<SIZE_T>(descriptor_index) * m_dsv_descriptor_size;
         return true;
@@ -251,14 +338,28 @@ namespace Dolas
         D3D12_CPU_DESCRIPTOR_HANDLE* out_cpu_handle,
         D3D12_GPU_DESCRIPTOR_HANDLE* out_gpu_handle)
     {
-        if (!m_srv_heap || !out_cpu_handle || !out_gpu_handle ||
-            m_srv_descriptor_persistent_next_index >= kPersistentSrvDescriptorCount)
+        return AllocateSrvDescriptorTable(1, out_cpu_handle, out_gpu_handle);
+    }
+
+    bool RenderHardwareInterface::AllocateSrvDescriptorTable(
+        UINT descriptor_count,
+        D3D12_CPU_DESCRIPTOR_HANDLE* out_cpu_handle,
+        D3D12_GPU_DESCRIPTOR_HANDLE* out_gpu_handle)
+    {
+        if (!m_srv_heap || !out_cpu_handle || !out_gpu_handle || descriptor_count == 0)
         {
             LOG_ERROR("Failed to allocate persistent D3D12 SRV descriptor.");
             return false;
         }
 
-        const UINT descriptor_index = m_srv_descriptor_persistent_next_index++;
+        const UINT descriptor_index = m_srv_descriptor_allocator.Allocate(descriptor_count);
+        if (descriptor_index == DescriptorIndexAllocator::INVALID_INDEX)
+        {
+            LOG_ERROR("Persistent D3D12 SRV descriptors exhausted: {0} requested, {1}/{2} in use, largest free range {3}.",
+                descriptor_count, m_srv_descriptor_allocator.GetAllocatedCount(),
+                m_srv_descriptor_allocator.GetCapacity(), m_srv_descriptor_allocator.GetLargestFreeRange());
+            return false;
+        }
         *out_cpu_handle = m_srv_heap->GetCPUDescriptorHandleForHeapStart();
         *out_gpu_handle = m_srv_heap->GetGPUDescriptorHandleForHeapStart();
         out_cpu_handle->ptr += static_cast<SIZE_T>(descriptor_index) * m_srv_descriptor_size;
@@ -266,6 +367,23 @@ namespace Dolas
         return true;
     }
 
+    UINT RenderHardwareInterface::GetSrvDescriptorIndex(D3D12_GPU_DESCRIPTOR_HANDLE gpu_handle) const
+    {
+        if (!m_srv_heap || m_srv_descriptor_size == 0)
+        {
+            return 0;
+        }
+
+        const UINT64 heap_start = m_srv_heap->GetGPUDescriptorHandleForHeapStart().ptr;
+        if (gpu_handle.ptr < heap_start)
+        {
+            return 0;
+        }
+
+        const UINT64 descriptor_index = (gpu_handle.ptr - heap_start) / m_srv_descriptor_size;
+        return descriptor_index < kSrvDescriptorCount ? static_cast<UINT>(descriptor_index) : 0;
+    }
+
     bool RenderHardwareInterface::AllocateTransientSrvDescriptorTable(
         UINT descriptor_count,
         D3D12_CPU_DESCRIPTOR_HANDLE* out_cpu_handle,
@@ -288,12 +406,60 @@ namespace Dolas
         return true;
     }
 
+    void RenderHardwareInterface::FreeRtvDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE cpu_handle)
+    {
+        if (!m_rtv_heap || cpu_handle.ptr == 0)
+        {
+            return;
+        }
+
+        const SIZE_T heap_start = m_rtv_heap->GetCPUDescriptorHandleForHeapStart().ptr;
+        const UINT descriptor_index = static_cast<UINT>((cpu_handle.ptr - heap_start) / m_rtv_descriptor_size);
+        if (!m_rtv_descriptor_allocator.Free(descriptor_index))
+        {
+            LOG_WARN("Ignoring invalid D3D12 RTV descriptor free, index: {0}", descriptor_index);
+        }
+    }
+
+    void RenderHardwareInterface::FreeDsvDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE cpu_handle)
+    {
+        if (!m_dsv_heap || cpu_handle.ptr == 0)
+        {
+            return;
+        }
+
+        const SIZE_T heap_start = m_dsv_heap->GetCPUDescriptorHandleForHeapStart().ptr;
+        const UINT descriptor_index = static_cast<UINT>((cpu_handle.ptr - heap_start) / m_dsv_descriptor_size);
+        if (!m_dsv_descriptor_allocator.Free(descriptor_index))
+        {
+            LOG_WARN("Ignoring invalid D3D12 DSV descriptor free, index: {0}", descriptor_index);
+        }
+    }
+
     void RenderHardwareInterface::FreeSrvDescriptor(
         D3D12_CPU_DESCRIPTOR_HANDLE cpu_handle,
         D3D12_GPU_DESCRIPTOR_HANDLE gpu_handle)
+    {
+        FreeSrvDescriptorTable(1, cpu_handle, gpu_handle);
+    }
+
+    void RenderHardwareInterface::FreeSrvDescriptorTable(
+        UINT descriptor_count,
+        D3D12_CPU_DESCRIPTOR_HANDLE cpu_handle,
+        D3D12_GPU_DESCRIPTOR_HANDLE gpu_handle)
     {
         (void)cpu_handle;
-        (void)gpu_handle;
+        if (!m_srv_heap || gpu_handle.ptr == 0 || descriptor_count == 0)
+        {
+            return;
+        }
+
+        // 下标 0 是 null SRV，GetSrvDescriptorIndex 对非法句柄也返回 0，二者都不归还
+        const UINT descriptor_index = GetSrvDescriptorIndex(gpu_handle);
+        if (descriptor_index == 0 || !m_srv_descriptor_allocator.Free(descriptor_index, descriptor_count))
+        {
+            LOG_WARN("Ignoring invalid D3D12 SRV descriptor free, index: {0}, count: {1}", descriptor_index, descriptor_count);
+        }
     }
 
     void RenderHardwareInterface::ResetTransientSrvDescriptors()
@@ -453,6 +619,15 @@ namespace Dolas
             SafeRelease(factory7);
             return false;
         }
+        // 记录适配器身份，用于判断磁盘上的管线缓存是否由同一块显卡生成（驱动版本由 pipeline library 自行校验）
+        DXGI_ADAPTER_DESC3 selected_adapter_desc = {};
+        if (SUCCEEDED(dxgi_adapter4->GetDesc3(&selected_adapter_desc)))
+        {
+            m_adapter_identity =
+                (static_cast<UINT64>(selected_adapter_desc.VendorId & 0xFFFF) << 48) |
+                (static_cast<UINT64>(selected_adapter_desc.DeviceId & 0xFFFF) << 32) |
+                static_cast<UINT64>(selected_adapter_desc.SubSysId ^ (selected_adapter_desc.Revision << 24));
+        }
         SafeRelease(dxgi_adapter4);
         
         // 4. 创建命令队列
@@ -568,11 +743,94 @@ namespace Dolas
             LOG_ERROR("Failed to create D3D12 fence event!");
             return false;
         }
-        
+
+        // 拷贝队列只用于异步上传，创建失败时上传退回到直接队列
+        if (!CreateCopyQueue())
+        {
+            LOG_WARN("D3D12 copy queue is unavailable, texture uploads fall back to the direct queue");
+            ReleaseCopyQueue();
+        }
         
         return true;
     }
 
+    bool RenderHardwareInterface::CreateCopyQueue()
+    {
+        D3D12_COMMAND_QUEUE_DESC queue_desc = {};
+        queue_desc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+        queue_desc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+        queue_desc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+        queue_desc.NodeMask = 0;
+
+        HRESULT hr = m_device->CreateCommandQueue(&queue_desc, IID_PPV_ARGS(&m_copy_command_queue));
+        if (FAILED(hr))
+        {
+            LOG_ERROR("Failed to create D3D12 copy CommandQueue! HRESULT: 0x{0:X}", hr);
+            return false;
+        }
+
+        for (UINT i = 0; i < kCopyCommandAllocatorCount; ++i)
+        {
+            hr = m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&m_copy_command_allocators[i]));
+            if (FAILED(hr))
+            {
+                LOG_ERROR("Failed to create D3D12 copy CommandAllocator! HRESULT: 0x{0:X}", hr);
+                return false;
+            }
+            m_copy_command_allocator_fence_values[i] = 0;
+        }
+
+        hr = m_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, m_copy_command_allocators[0], nullptr, IID_PPV_ARGS(&m_copy_command_list));
+        if (FAILED(hr))
+        {
+            LOG_ERROR("Failed to create D3D12 copy CommandList! HRESULT: 0x{0:X}", hr);
+            return false;
+        }
+        hr = m_copy_command_list->Close();
+        if (FAILED(hr))
+        {
+            LOG_ERROR("Failed to close initial D3D12 copy CommandList! HRESULT: 0x{0:X}", hr);
+            return false;
+        }
+
+        hr = m_device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_copy_fence));
+        if (FAILED(hr))
+        {
+            LOG_ERROR("Failed to create D3D12 copy fence! HRESULT: 0x{0:X}", hr);
+            return false;
+        }
+        m_copy_fence_value = 0;
+        m_copy_command_allocator_index = 0;
+
+        m_copy_fence_event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+        if (!m_copy_fence_event)
+        {
+            LOG_ERROR("Failed to create D3D12 copy fence event!");
+            return false;
+        }
+        return true;
+    }
+
+    void RenderHardwareInterface::ReleaseCopyQueue()
+    {
+        WaitForCopyFence(m_copy_fence_value);
+
+        if (m_copy_fence_event)
+        {
+            CloseHandle(m_copy_fence_event);
+            m_copy_fence_event = nullptr;
+        }
+        SafeRelease(m_copy_fence);
+        SafeRelease(m_copy_command_list);
+        for (UINT i = 0; i < kCopyCommandAllocatorCount; ++i)
+        {
+            SafeRelease(m_copy_command_allocators[i]);
+            m_copy_command_allocator_fence_values[i] = 0;
+        }
+        SafeRelease(m_copy_command_queue);
+        m_copy_fence_value = 0;
+    }
+
     bool RenderHardwareInterface::CreateSrvDescriptorHeap()
     {
         D3D12_DESCRIPTOR_HEAP_DESC srv_heap_desc = {};
@@ -588,7 +846,6 @@ namespace Dolas
         }
 
         m_srv_descriptor_size = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-        m_srv_descriptor_persistent_next_index = 0;
         ResetTransientSrvDescriptors();
 
         m_null_srv_cpu_handle = m_srv_heap->GetCPUDescriptorHandleForHeapStart();
@@ -598,7 +855,7 @@ namespace Dolas
         null_srv_desc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
         null_srv_desc.Texture2D.MipLevels = 1;
         m_device->CreateShaderResourceView(nullptr, &null_srv_desc, m_null_srv_cpu_handle);
-        m_srv_descriptor_persistent_next_index = 1;
+        m_srv_descriptor_allocator.Initialize(1, kPersistentSrvDescriptorCount - 1);
         return true;
     }
 
@@ -617,7 +874,6 @@ namespace Dolas
         }
 
         m_rtv_descriptor_size = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
-        m_rtv_descriptor_next_index = 0;
         D3D12_CPU_DESCRIPTOR_HANDLE rtv_handle = m_rtv_heap->GetCPUDescriptorHandleForHeapStart();
 
         for (UINT i = 0; i < kFrameCount; ++i)
@@ -631,8 +887,8 @@ namespace Dolas
 
             m_device->CreateRenderTargetView(m_render_targets[i], nullptr, rtv_handle);
             rtv_handle.ptr += m_rtv_descriptor_size;
-            ++m_rtv_descriptor_next_index;
         }
+        m_rtv_descriptor_allocator.Initialize(kFrameCount, kRtvDescriptorCount - kFrameCount);
 
         return true;
     }
@@ -652,7 +908,7 @@ namespace Dolas
         }
 
         m_dsv_descriptor_size = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_DSV);
-        m_dsv_descriptor_next_index = 0;
+        m_dsv_descriptor_allocator.Initialize(0, kDsvDescriptorCount);
         return true;
     }
 
@@ -0,0 +1,42 @@
+#ifndef DOLAS_DESCRIPTOR_ALLOCATOR_H
+#define DOLAS_DESCRIPTOR_ALLOCATOR_H
+
+#include <map>
+
+namespace Dolas
+{
+    // 管理 [first_index, first_index + capacity) 区间内的 descriptor 下标。
+    // 空闲区间按起始下标有序保存，分配时 first-fit 取连续区间，释放时与相邻空闲区间合并，
+    // 因此长时间运行、反复创建销毁纹理也不会耗尽 descriptor heap。
+    // 与图形 API 无关，只依赖标准库，DolasPlatform 的 RHI 与上层模块都可以直接使用。
+    class DescriptorIndexAllocator
+    {
+    public:
+        static constexpr unsigned int INVALID_INDEX = 0xFFFFFFFFu;
+
+        void Initialize(unsigned int first_index, unsigned int capacity);
+
+        // 分配 count 个连续下标，失败时返回 INVALID_INDEX
+        unsigned int Allocate(unsigned int count = 1);
+        // 释放之前分配的区间；越界或与空闲区间重叠（重复释放）时返回 false 且不做修改
+        bool Free(unsigned int index, unsigned int count = 1);
+
+        unsigned int GetFirstIndex() const { return m_first_index; }
+        unsigned int GetCapacity() const { return m_capacity; }
+        unsigned int GetAllocatedCount() const { return m_allocated_count; }
+        unsigned int GetFreeRangeCount() const { return static_cast<unsigned int>(m_free_ranges.size()); }
+        unsigned int GetLargestFreeRange() const;
+        // 每次成功释放加一。释放的下标会被之后的分配原样复用，
+        // 按源 descriptor 句柄缓存拷贝结果的调用方（常驻 SRV table）用它判断句柄是否可能已指向别的资源
+        unsigned long long GetFreeGeneration() const { return m_free_generation; }
+
+    private:
+        std::map<unsigned int, unsigned int> m_free_ranges; // start -> count
+        unsigned int m_first_index = 0;
+        unsigned int m_capacity = 0;
+        unsigned int m_allocated_count = 0;
+        unsigned long long m_free_generation = 0;
+    };
+}
+
+#endif // DOLAS_DESCRIPTOR_ALLOCATOR_H
@@ -4,6 +4,7 @@
 #include <d3d12.h>
 #include <dxgi1_6.h>
 #include <functional>
+#include "dolas_descriptor_allocator.h"
 
 namespace Dolas
 {
@@ -22,12 +23,28 @@ namespace Dolas
         bool EndFrame();
         bool Present();
         bool ExecuteImmediate(const std::function<bool(ID3D12GraphicsCommandList*)>& record_commands);
+        // 在独立的拷贝队列上提交（纹理上传），不等待 GPU；out_fence_value 为本次提交的拷贝 fence 值。
+        // 拷贝队列不可用时退化为 ExecuteImmediate，fence 值为 0（已完成）
+        bool ExecuteCopyCommands(const std::function<bool(ID3D12GraphicsCommandList*)>& record_commands, UINT64* out_fence_value);
+        UINT64 GetCompletedCopyFenceValue() const;
+        void WaitForCopyFence(UINT64 fence_value);
+        bool HasCopyQueue() const { return m_copy_command_queue != nullptr; }
         bool AllocateRtvDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE* out_cpu_handle);
         bool AllocateDsvDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE* out_cpu_handle);
         bool AllocateSrvDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE* out_cpu_handle, D3D12_GPU_DESCRIPTOR_HANDLE* out_gpu_handle);
+        // 在持久区间分配连续的 descriptor_count 个 SRV（用于材质常驻的 descriptor table）
+        bool AllocateSrvDescriptorTable(UINT descriptor_count, D3D12_CPU_DESCRIPTOR_HANDLE* out_cpu_handle, D3D12_GPU_DESCRIPTOR_HANDLE* out_gpu_handle);
         bool AllocateTransientSrvDescriptorTable(UINT descriptor_count, D3D12_CPU_DESCRIPTOR_HANDLE* out_cpu_handle, D3D12_GPU_DESCRIPTOR_HANDLE* out_gpu_handle);
+        // 归还常驻区间的 descriptor，供之后的纹理/视图复用；调用方需保证 GPU 不再引用它们
+        void FreeRtvDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE cpu_handle);
+        void FreeDsvDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE cpu_handle);
         void FreeSrvDescriptor(D3D12_CPU_DESCRIPTOR_HANDLE cpu_handle, D3D12_GPU_DESCRIPTOR_HANDLE gpu_handle);
+        void FreeSrvDescriptorTable(UINT descriptor_count, D3D12_CPU_DESCRIPTOR_HANDLE cpu_handle, D3D12_GPU_DESCRIPTOR_HANDLE gpu_handle);
         void ResetTransientSrvDescriptors();
+        // SRV 在 shader-visible heap 中的下标（bindless 纹理数组的索引），不属于该 heap 时返回 0（null SRV）
+        UINT GetSrvDescriptorIndex(D3D12_GPU_DESCRIPTOR_HANDLE gpu_handle) const;
+        // 常驻区间 [0, kPersistentSrvDescriptorCount) 整体作为 bindless 纹理表
+        UINT GetPersistentSrvDescriptorCount() const { return kPersistentSrvDescriptorCount; }
         void SetWindowMessageHandler(WindowMessageHandler handler);
         
         ID3D12Device* GetDevice() const { return m_device; }
@@ -41,18 +58,26 @@ namespace Dolas
         D3D12_CPU_DESCRIPTOR_HANDLE GetCurrentRtvHandle() const;
         D3D12_CPU_DESCRIPTOR_HANDLE GetNullSrvDescriptorCpuHandle() const { return m_null_srv_cpu_handle; }
         ID3D12Resource* GetCurrentBackBufferResource() const { return m_render_targets[m_frame_index]; }
+        // VendorId / DeviceId / SubSysId / Revision 组合而成，标识当前使用的显卡
+        UINT64 GetAdapterIdentity() const { return m_adapter_identity; }
+        const DescriptorIndexAllocator& GetRtvDescriptorAllocator() const { return m_rtv_descriptor_allocator; }
+        const DescriptorIndexAllocator& GetDsvDescriptorAllocator() const { return m_dsv_descriptor_allocator; }
+        const DescriptorIndexAllocator& GetSrvDescriptorAllocator() const { return m_srv_descriptor_allocator; }
 
     private:
         static constexpr UINT kRtvDescriptorCount = 256;
         static constexpr UINT kDsvDescriptorCount = 64;
-        static constexpr UINT kSrvDescriptorCount = 1024;
-        static constexpr UINT kPersistentSrvDescriptorCount = 512;
+        static constexpr UINT kSrvDescriptorCount = 4096;
+        static constexpr UINT kPersistentSrvDescriptorCount = 3072;
+        static constexpr UINT kCopyCommandAllocatorCount = 3;
 
         bool InitializeWindow(LONG origin_width, LONG origin_height);
         bool InitializeD3D12();
         bool CreateRenderTargetViews();
         bool CreateDepthStencilDescriptorHeap();
         bool CreateSrvDescriptorHeap();
+        bool CreateCopyQueue();
+        void ReleaseCopyQueue();
         void WaitForGpu();
         
         ID3D12Device* m_device {nullptr};
@@ -66,16 +91,27 @@ namespace Dolas
         ID3D12Resource* m_render_targets[kFrameCount] {nullptr, nullptr};
         ID3D12Fence* m_fence {nullptr};
         HANDLE m_fence_event {nullptr};
+        // 拷贝队列：每个分配器记录最后一次使用它的 fence 值，复用前等待该值完成
+        ID3D12CommandQueue* m_copy_command_queue {nullptr};
+        ID3D12CommandAllocator* m_copy_command_allocators[kCopyCommandAllocatorCount] {};
+        UINT64 m_copy_command_allocator_fence_values[kCopyCommandAllocatorCount] {};
+        ID3D12GraphicsCommandList* m_copy_command_list {nullptr};
+        ID3D12Fence* m_copy_fence {nullptr};
+        HANDLE m_copy_fence_event {nullptr};
+        UINT m_copy_command_allocator_index {0};
+        UINT64 m_copy_fence_value {0};
         UINT m_rtv_descriptor_size {0};
         UINT m_dsv_descriptor_size {0};
         UINT m_srv_descriptor_size {0};
-        UINT m_rtv_descriptor_next_index {0};
-        UINT m_dsv_descriptor_next_index {0};
-        UINT m_srv_descriptor_persistent_next_index {0};
+        // RTV 堆前 kFrameCount 个固定给交换链，其余与 DSV、常驻 SRV 一样走可回收的空闲链表
+        DescriptorIndexAllocator m_rtv_descriptor_allocator;
+        DescriptorIndexAllocator m_dsv_descriptor_allocator;
+        DescriptorIndexAllocator m_srv_descriptor_allocator;
         UINT m_srv_descriptor_transient_next_index {0};
         D3D12_CPU_DESCRIPTOR_HANDLE m_null_srv_cpu_handle {};
         UINT m_frame_index {0};
         UINT64 m_fence_value {0};
+        UINT64 m_adapter_identity {0};
         HWND m_window_hwnd {nullptr};
         LONG m_client_width {1280};
         LONG m_client_height {720};
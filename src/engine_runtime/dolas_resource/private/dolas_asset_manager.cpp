@@ -85,6 +85,37 @@ namespace Dolas
         *static_cast<TAsset*>(output_asset) = std::move(file.data);
         return AssetLoadError::None;
     }
+
+    template<AssetDescription TAsset>
+    [[nodiscard]] Bool SaveJsonAssetFile(
+        const std::string& file_path,
+        const void* asset)
+    {
+        if (asset == nullptr)
+        {
+            return false;
+        }
+
+        const JsonAssetFile<TAsset> file{
+            std::string{TAsset::kTypeId},
+            TAsset::kSchemaVersion,
+            *static_cast<const TAsset*>(asset)};
+
+        std::ofstream output{file_path, std::ios::trunc};
+        if (!output)
+        {
+            LOG_ERROR("Failed to open asset '{0}' for writing", file_path);
+            return false;
+        }
+
+        output << rfl::json::write(file, rfl::json::pretty);
+        if (!output)
+        {
+            LOG_ERROR("Failed to write asset '{0}'", file_path);
+            return false;
+        }
+        return true;
+    }
 }
 
 namespace rfl
@@ -205,6 +236,12 @@ namespace Dolas
         m_asset_loaders.emplace(
             SceneAssetDesc::kTypeId,
             &LoadJsonAssetFile<SceneAssetDesc>);
+
+        // Only cooked asset types are written back by tools.
+        m_asset_savers.clear();
+        m_asset_savers.emplace(
+            MeshAssetDesc::kTypeId,
+            &SaveJsonAssetFile<MeshAssetDesc>);
         return true;
     }
 
@@ -226,4 +263,18 @@ namespace Dolas
         }
         return loader->second(file_path, output_asset);
     }
+
+    Bool AssetManager::SerializeAndSaveAssetFile(
+        std::string_view type_id,
+        const std::string& file_path,
+        const void* asset) const
+    {
+        const auto saver = m_asset_savers.find(std::string{type_id});
+        if (saver == m_asset_savers.end())
+        {
+            LOG_ERROR("No saver registered for asset type '{0}'", type_id);
+            return false;
+        }
+        return saver->second(file_path, asset);
+    }
 }
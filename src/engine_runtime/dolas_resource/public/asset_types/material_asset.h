@@ -6,6 +6,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "dolas_asset_ref.h"
 #include "dolas_base.h"
@@ -21,6 +22,8 @@ namespace Dolas
 
         std::optional<RawAssetRef> vertex_shader;
         std::optional<RawAssetRef> pixel_shader;
+        // 启用的 shader keyword（见 ShaderKeywordDeclaration），VS / PS 各自只使用自己声明过的
+        std::vector<std::string> shader_keywords;
         std::map<std::string, Vector4> vertex_shader_global_variables;
         std::map<std::string, Vector4> pixel_shader_global_variables;
         std::map<std::string, RawAssetRef> pixel_shader_texture;
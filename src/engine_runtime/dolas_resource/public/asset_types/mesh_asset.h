@@ -1,6 +1,7 @@
 #ifndef DOLAS_MESH_ASSET_H
 #define DOLAS_MESH_ASSET_H
 
+#include <array>
 #include <cstdint>
 #include <optional>
 #include <string_view>
@@ -18,6 +19,28 @@ namespace Dolas
         TriangleStrip = 1,
     };
 
+    // Cook-time simplified index list referencing the base mesh vertices.
+    struct MeshLODDesc
+    {
+        std::vector<UInt> indices;
+        Float error{0.0f};
+        Float screen_size{0.0f};
+    };
+
+    // Cook-time meshlet (cluster): ranges into meshlet_vertices / meshlet_triangles,
+    // plus model-space bounding sphere and normal cone used by the CPU cluster culler.
+    struct MeshletDesc
+    {
+        UInt vertex_offset{0};
+        UInt vertex_count{0};
+        UInt triangle_offset{0};
+        UInt triangle_count{0};
+        std::array<Float, 4> bounding_sphere{};  // center xyz, radius
+        std::array<Float, 3> cone_apex{};
+        std::array<Float, 3> cone_axis{};
+        Float cone_cutoff{2.0f};                 // > 1 means the cone cannot be used for culling
+    };
+
     struct MeshAssetDesc
     {
         static constexpr std::string_view kTypeId{"dolas.mesh"};
@@ -33,6 +56,13 @@ namespace Dolas
         std::vector<UInt> indices;
         TopologyType topology{TopologyType::TriangleList};
         std::optional<AssetRef<MaterialAssetDesc>> material;
+        // LOD1..N, ordered from most to least detailed; empty until the mesh is cooked.
+        std::vector<MeshLODDesc> lods;
+        // Meshlets of LOD0; meshlet_vertices index the base vertices and
+        // meshlet_triangles holds 3 meshlet-local vertex indices per triangle.
+        std::vector<MeshletDesc> meshlets;
+        std::vector<UInt> meshlet_vertices;
+        std::vector<UByte> meshlet_triangles;
     };
 }
 
@@ -139,8 +139,14 @@ namespace Dolas
         template<AssetDescription TAsset>
         [[nodiscard]] AssetLoadResult<TAsset> LoadAsset(const AssetPath& asset_path);
 
+        // Writes a registered asset description back to disk (used by offline cook tools)
+        // and replaces the cached copy so later loads observe the saved value.
+        template<AssetDescription TAsset>
+        Bool SaveAsset(const AssetPath& asset_path, const TAsset& asset);
+
     private:
         using AssetFileLoader = AssetLoadError (*)(const std::string&, void*);
+        using AssetFileSaver = Bool (*)(const std::string&, const void*);
 
         // Keeps file-format and type-erasure details out of the public template interface.
         AssetLoadError LoadAndParseAssetFile(
@@ -148,6 +154,11 @@ namespace Dolas
             const std::string& file_path,
             void* output_asset) const;
 
+        Bool SerializeAndSaveAssetFile(
+            std::string_view type_id,
+            const std::string& file_path,
+            const void* asset) const;
+
         template<AssetDescription TAsset>
         AssetCache<TAsset>& GetTypedCache()
         {
@@ -161,6 +172,7 @@ namespace Dolas
         }
 
         std::unordered_map<std::string, AssetFileLoader> m_asset_loaders;
+        std::unordered_map<std::string, AssetFileSaver> m_asset_savers;
         std::unordered_map<std::type_index, std::unique_ptr<IAssetCache>> m_asset_caches;
     };
 
@@ -200,5 +212,28 @@ namespace Dolas
         (void)was_inserted;
         return {&inserted->second, AssetLoadError::None};
     }
+
+    template<AssetDescription TAsset>
+    Bool AssetManager::SaveAsset(const AssetPath& asset_path, const TAsset& asset)
+    {
+        if (!asset_path.GetRelativePath().ends_with(TAsset::kFileSuffix))
+        {
+            return false;
+        }
+
+        const auto file_path = PathUtils::ResolveAssetPath(asset_path);
+        if (!file_path)
+        {
+            return false;
+        }
+
+        if (!SerializeAndSaveAssetFile(TAsset::kTypeId, file_path->string(), &asset))
+        {
+            return false;
+        }
+
+        GetTypedCache<TAsset>().map.insert_or_assign(asset_path, asset);
+        return true;
+    }
 }
 #endif // DOLAS_ASSET_MANAGER_H
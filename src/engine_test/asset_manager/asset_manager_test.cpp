@@ -342,6 +342,48 @@ TEST_CASE("AssetManager loads JSON assets with references", "[AssetManager]")
         REQUIRE_FALSE(load_result.HasValue());
         REQUIRE(load_result.GetError() == AssetLoadError::JsonParseFailed);
     }
+
+    SECTION("Saves a cooked mesh with LODs and meshlets and reloads it")
+    {
+        const AssetPath asset_path = RequireAssetPath("_project/cooked.mesh");
+        MeshAssetDesc mesh;
+        mesh.position = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f};
+        mesh.indices = {0, 1, 2, 2, 1, 3};
+        mesh.material = AssetRef<MaterialAssetDesc>{RequireAssetPath("_project/cooked.material")};
+        mesh.lods.push_back(MeshLODDesc{{0, 1, 2}, 0.25f, 0.5f});
+        MeshletDesc meshlet;
+        meshlet.vertex_count = 4;
+        meshlet.triangle_count = 2;
+        meshlet.bounding_sphere = {0.5f, 0.5f, 0.0f, 0.75f};
+        meshlet.cone_axis = {0.0f, 0.0f, 1.0f};
+        meshlet.cone_cutoff = 0.0f;
+        mesh.meshlets.push_back(meshlet);
+        mesh.meshlet_vertices = {0, 1, 2, 3};
+        mesh.meshlet_triangles = {0, 1, 2, 2, 1, 3};
+
+        REQUIRE(manager.SaveAsset(asset_path, mesh));
+        REQUIRE(fs::exists(test_dir / "cooked.mesh"));
+        REQUIRE_FALSE(manager.SaveAsset(RequireAssetPath("_project/cooked.scene"), mesh));
+
+        // 清空缓存后从磁盘重新读取
+        REQUIRE(manager.Clear());
+        const auto load_result = manager.LoadAsset<MeshAssetDesc>(asset_path);
+
+        REQUIRE(load_result.HasValue());
+        REQUIRE(load_result.GetAsset()->indices == mesh.indices);
+        REQUIRE(load_result.GetAsset()->position == mesh.position);
+        REQUIRE(load_result.GetAsset()->material.has_value());
+        REQUIRE(load_result.GetAsset()->lods.size() == 1);
+        REQUIRE(load_result.GetAsset()->lods[0].indices == mesh.lods[0].indices);
+        REQUIRE(load_result.GetAsset()->lods[0].error == 0.25f);
+        REQUIRE(load_result.GetAsset()->lods[0].screen_size == 0.5f);
+        REQUIRE(load_result.GetAsset()->meshlets.size() == 1);
+        REQUIRE(load_result.GetAsset()->meshlets[0].triangle_count == 2);
+        REQUIRE(load_result.GetAsset()->meshlets[0].bounding_sphere == meshlet.bounding_sphere);
+        REQUIRE(load_result.GetAsset()->meshlets[0].cone_axis == meshlet.cone_axis);
+        REQUIRE(load_result.GetAsset()->meshlet_vertices == mesh.meshlet_vertices);
+        REQUIRE(load_result.GetAsset()->meshlet_triangles == mesh.meshlet_triangles);
+    }
 #else
     SUCCEED("Test skipped in Release builds because path root overrides are debug-only");
 #endif
@@ -103,3 +103,24 @@ TEST_CASE("HashConverter debug-only tests skipped in release", "[HashConverter]"
 }
 
 #endif
+
+// FNV-1a 64-bit test vectors
+// - "" (empty) → 0xcbf29ce484222325
+// - "a"         → 0xaf63dc4c8601ec8c
+
+TEST_CASE("HashConverter BytesHash64 known FNV-1a 64-bit test vectors", "[HashConverter][fnv1a64]")
+{
+    REQUIRE(HashConverter::BytesHash64(nullptr, 0) == 0xcbf29ce484222325ULL);
+    REQUIRE(HashConverter::BytesHash64("a", 1) == 0xaf63dc4c8601ec8cULL);
+}
+
+TEST_CASE("HashConverter BytesHash64 chaining equals hashing the concatenation", "[HashConverter][fnv1a64]")
+{
+    const std::string a = "vertex_bytecode";
+    const std::string b = "pixel_bytecode";
+    const std::string ab = a + b;
+    ULongLong chained = HashConverter::BytesHash64(a.data(), a.size());
+    chained = HashConverter::BytesHash64(b.data(), b.size(), chained);
+    REQUIRE(chained == HashConverter::BytesHash64(ab.data(), ab.size()));
+    REQUIRE(HashConverter::BytesHash64(a.data(), a.size()) != HashConverter::BytesHash64(b.data(), b.size()));
+}
@@ -55,6 +55,15 @@ TEST_CASE("PathUtils::ResolveAssetPath Tests", "[PathUtils]") {
         REQUIRE(normalized->generic_string() == "C:/Engine/Content/textures/stone.png");
     }
 
+    SECTION("Testing cooked texture path") {
+        const auto cooked = PathUtils::GetCookedTexturePath(RequireAssetPath("_engine\\textures//stone.png"));
+        REQUIRE(cooked.generic_string() == "C:/Engine/Content/cache/texture/_engine/textures/stone.png.dds");
+        const auto cubemap = PathUtils::GetCookedCubemapPath(RequireAssetPath("_engine/texture/sky.hdr"));
+        REQUIRE(cubemap.generic_string() == "C:/Engine/Content/cache/texture/_engine/texture/sky.hdr.cube.dds");
+        const auto ibl = PathUtils::GetImageBasedLightingCachePath(0x1234abcdULL, "specular.dds");
+        REQUIRE(ibl.generic_string() == "C:/Engine/Content/cache/ibl/000000001234abcd.specular.dds");
+    }
+
     SECTION("Testing _project prefix") {
         PathUtils::SetProjectContentDirForDebug("D:/MyGame/Content");
         
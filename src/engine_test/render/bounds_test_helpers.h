@@ -0,0 +1,16 @@
+#ifndef DOLAS_BOUNDS_TEST_HELPERS_H
+#define DOLAS_BOUNDS_TEST_HELPERS_H
+
+#include "dolas_bounds.h"
+
+// 剔除、遮挡与场景查询测试共用的包围盒构造函数
+namespace Dolas
+{
+    inline BoundingBox MakeBox(const Vector3& center, Float half_size)
+    {
+        const Vector3 extents(half_size, half_size, half_size);
+        return BoundingBox(center - extents, center + extents);
+    }
+}
+
+#endif // DOLAS_BOUNDS_TEST_HELPERS_H
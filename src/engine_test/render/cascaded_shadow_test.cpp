@@ -0,0 +1,260 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "dolas_cascaded_shadow.h"
+
+using namespace Dolas;
+using Catch::Matchers::WithinRel;
+
+namespace
+{
+    // 在 eye 处、看向 target 的相机 view 矩阵（右手系，看向 -Z）
+    Matrix4x4 MakeLookAt(const Vector3& eye, const Vector3& target)
+    {
+        const Vector3 back = (eye - target).Normalized();
+        const Vector3 right = Vector3(0.0f, 1.0f, 0.0f).Cross(back).Normalized();
+        const Vector3 up = back.Cross(right);
+
+        Matrix4x4 view = Matrix4x4::IDENTITY;
+        view.SetRow(0, Vector4(right, -right.Dot(eye)));
+        view.SetRow(1, Vector4(up, -up.Dot(eye)));
+        view.SetRow(2, Vector4(back, -back.Dot(eye)));
+        return view;
+    }
+
+    CascadeShadowView MakeShadowView(const Vector3& eye, const Vector3& target)
+    {
+        CascadeShadowView view;
+        view.view = MakeLookAt(eye, target);
+        view.projection_scale_y = 1.0f / std::tan(0.5f * 1.0471976f); // 60 度垂直视角
+        view.projection_scale_x = view.projection_scale_y / (16.0f / 9.0f);
+        view.near_plane = 0.1f;
+        view.far_plane = 500.0f;
+        return view;
+    }
+
+    // 视空间深度 depth 处的视锥截面四个角点（世界空间）
+    void GetSliceCorners(const CascadeShadowView& view, Float depth, Vector3* out_corners)
+    {
+        const Matrix4x4 inverse_view = view.view.GetInverse();
+        const Float half_width = depth / view.projection_scale_x;
+        const Float half_height = depth / view.projection_scale_y;
+        const Float signs[4][2] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { -1.0f, 1.0f }, { 1.0f, 1.0f } };
+        for (UInt i = 0; i < 4; ++i)
+        {
+            const Vector4 world = inverse_view * Vector4(signs[i][0] * half_width, signs[i][1] * half_height, -depth, 1.0f);
+            out_corners[i] = Vector3(world.x, world.y, world.z);
+        }
+    }
+
+    Vector3 Project(const Matrix4x4& view_projection, const Vector3& point)
+    {
+        const Vector4 clip = view_projection * Vector4(point, 1.0f);
+        return Vector3(clip.x / clip.w, clip.y / clip.w, clip.z / clip.w);
+    }
+
+    const Vector3 kLightDirection = Vector3(0.4f, -1.0f, 0.3f).Normalized();
+}
+
+TEST_CASE("Cascade splits blend logarithmic and uniform distributions", "[render][shadow]")
+{
+    Float splits[kMaxShadowCascadeCount + 1] = {};
+    ComputeCascadeSplits(0.1f, 200.0f, 4, 0.8f, splits);
+    CHECK(splits[0] == 0.1f);
+    CHECK(splits[4] == 200.0f);
+    for (UInt i = 0; i < 4; ++i)
+    {
+        CHECK(splits[i] < splits[i + 1]);
+    }
+
+    // lambda = 0 为均匀划分，lambda = 1 为对数划分（相邻比值相等）
+    ComputeCascadeSplits(1.0f, 101.0f, 4, 0.0f, splits);
+    CHECK_THAT(splits[1], WithinRel(26.0f, 1e-5f));
+    CHECK_THAT(splits[2], WithinRel(51.0f, 1e-5f));
+    ComputeCascadeSplits(1.0f, 10000.0f, 4, 1.0f, splits);
+    CHECK_THAT(splits[1], WithinRel(10.0f, 1e-4f));
+    CHECK_THAT(splits[2], WithinRel(100.0f, 1e-4f));
+    CHECK_THAT(splits[3], WithinRel(1000.0f, 1e-4f));
+}
+
+TEST_CASE("Every cascade contains its frustum slice", "[render][shadow]")
+{
+    const CascadeShadowView view = MakeShadowView(Vector3(10.0f, 5.0f, 20.0f), Vector3(30.0f, 0.0f, -40.0f));
+    CascadeShadowDesc desc;
+    ShadowCascade cascades[kMaxShadowCascadeCount];
+    ComputeShadowCascades(desc, view, kLightDirection, BoundingBox(), cascades);
+
+    for (UInt cascade_index = 0; cascade_index < desc.cascade_count; ++cascade_index)
+    {
+        const ShadowCascade& cascade = cascades[cascade_index];
+        CHECK(cascade.split_near < cascade.split_far);
+        if (cascade_index > 0)
+        {
+            CHECK(cascade.split_near == cascades[cascade_index - 1].split_far);
+        }
+        CHECK_THAT(cascade.texel_size, WithinRel(2.0f * cascade.bounding_sphere.radius / desc.resolution, 1e-5f));
+
+        Vector3 corners[8];
+        GetSliceCorners(view, cascade.split_near, corners);
+        GetSliceCorners(view, cascade.split_far, corners + 4);
+        for (const Vector3& corner : corners)
+        {
+            CHECK((corner - cascade.bounding_sphere.center).Length() <= cascade.bounding_sphere.radius + 1e-3f);
+
+            const Vector3 ndc = Project(cascade.view_projection, corner);
+            CHECK(std::abs(ndc.x) <= 1.0f + 1e-4f);
+            CHECK(std::abs(ndc.y) <= 1.0f + 1e-4f);
+            CHECK(ndc.z >= -1e-4f);
+            CHECK(ndc.z <= 1.0f + 1e-4f);
+        }
+    }
+    CHECK(cascades[desc.cascade_count - 1].split_far == desc.max_distance);
+}
+
+TEST_CASE("Stable cascade fitting moves the shadow map in whole texels", "[render][shadow]")
+{
+    CascadeShadowDesc desc;
+    desc.cascade_count = 3;
+    desc.resolution = 1024;
+
+    // 相机绕 Y 轴旋转并平移：包围球半径不变，固定世界点在阴影图中的亚 texel 位置不变
+    const Vector3 probe(3.25f, 1.5f, -7.75f);
+    ShadowCascade reference[kMaxShadowCascadeCount];
+    Float reference_fraction_x[kMaxShadowCascadeCount] = {};
+    Float reference_fraction_y[kMaxShadowCascadeCount] = {};
+    for (UInt frame = 0; frame < 16; ++frame)
+    {
+        const Float angle = 0.37f * frame;
+        const Vector3 eye(0.5f * frame, 2.0f, -0.3f * frame);
+        const Vector3 target = eye + Vector3(std::sin(angle), -0.2f, -std::cos(angle));
+        ShadowCascade cascades[kMaxShadowCascadeCount];
+        ComputeShadowCascades(desc, MakeShadowView(eye, target), kLightDirection, BoundingBox(), cascades);
+
+        for (UInt cascade_index = 0; cascade_index < desc.cascade_count; ++cascade_index)
+        {
+            const ShadowCascade& cascade = cascades[cascade_index];
+            const Vector3 ndc = Project(cascade.view_projection, probe);
+            const Float texel_x = (ndc.x * 0.5f + 0.5f) * desc.resolution;
+            const Float texel_y = (ndc.y * 0.5f + 0.5f) * desc.resolution;
+            const Float fraction_x = texel_x - std::floor(texel_x);
+            const Float fraction_y = texel_y - std::floor(texel_y);
+            if (frame == 0)
+            {
+                reference[cascade_index] = cascade;
+                reference_fraction_x[cascade_index] = fraction_x;
+                reference_fraction_y[cascade_index] = fraction_y;
+                continue;
+            }
+
+            CHECK(cascade.bounding_sphere.radius == reference[cascade_index].bounding_sphere.radius);
+            CHECK(cascade.texel_size == reference[cascade_index].texel_size);
+            // 光源方向不变时光源空间的旋转完全相同
+            CHECK(cascade.light_view.data[0][0] == reference[cascade_index].light_view.data[0][0]);
+            CHECK(cascade.light_view.data[2][1] == reference[cascade_index].light_view.data[2][1]);
+            // 允许浮点误差，但远小于一个 texel
+            const Float delta_x = std::abs(fraction_x - reference_fraction_x[cascade_index]);
+            const Float delta_y = std::abs(fraction_y - reference_fraction_y[cascade_index]);
+            CHECK(std::min(delta_x, 1.0f - delta_x) < 0.02f);
+            CHECK(std::min(delta_y, 1.0f - delta_y) < 0.02f);
+        }
+    }
+}
+
+TEST_CASE("Shadow caster culling keeps casters between the light and the cascade", "[render][shadow]")
+{
+    const CascadeShadowView view = MakeShadowView(Vector3(0.0f, 2.0f, 0.0f), Vector3(0.0f, 2.0f, -10.0f));
+    const Vector3 light_direction(0.0f, -1.0f, 0.0f);
+
+    CascadeShadowDesc desc;
+    desc.cascade_count = 2;
+    desc.max_distance = 40.0f;
+
+    CullingBoundsSoA bounds;
+    auto make_box = [](const Vector3& center, Float extent) { return BoundingBox(center - Vector3(extent, extent, extent), center + Vector3(extent, extent, extent)); };
+    bounds.Add(make_box(Vector3(0.0f, 0.0f, -5.0f), 0.5f));      // 0: 第一个 cascade 内
+    bounds.Add(make_box(Vector3(0.0f, 300.0f, -5.0f), 1.0f));    // 1: 切片正上方很高处，挡住光线
+    bounds.Add(make_box(Vector3(500.0f, 0.0f, -5.0f), 1.0f));    // 2: 侧面远处
+    bounds.Add(make_box(Vector3(0.0f, -500.0f, -5.0f), 1.0f));   // 3: 切片下方（远离光源）
+    bounds.Add(BoundingBox());                                   // 4: 空盒
+    bounds.Add(make_box(Vector3(0.0f, 0.0f, -30.0f), 0.5f));     // 5: 只在第二个 cascade 内
+
+    BoundingBox caster_bounds;
+    caster_bounds.Merge(make_box(Vector3(0.0f, 0.0f, -5.0f), 0.5f));
+    caster_bounds.Merge(make_box(Vector3(0.0f, 300.0f, -5.0f), 1.0f));
+    caster_bounds.Merge(make_box(Vector3(0.0f, 0.0f, -30.0f), 0.5f));
+
+    ShadowCascade cascades[kMaxShadowCascadeCount];
+    ComputeShadowCascades(desc, view, light_direction, caster_bounds, cascades);
+
+    std::vector<UByte> visibility(bounds.GetCount(), 0xFF);
+    CHECK(CullShadowCasters(cascades[0], bounds, 0, bounds.GetCount(), visibility.data()) == 2);
+    CHECK((visibility == std::vector<UByte>{ 1, 1, 0, 0, 0, 0 }));
+
+    CHECK(CullShadowCasters(cascades[1], bounds, 0, bounds.GetCount(), visibility.data()) == 3);
+    CHECK((visibility == std::vector<UByte>{ 1, 1, 0, 0, 0, 1 }));
+
+    // 不提供投射体范围时近平面停在包围球上，高处的物体被剔除
+    const ShadowCascade tight = FitShadowCascade(cascades[0].bounding_sphere, light_direction, desc.resolution, BoundingBox());
+    CullShadowCasters(tight, bounds, 0, bounds.GetCount(), visibility.data());
+    CHECK(visibility[0] == 1);
+    CHECK(visibility[1] == 0);
+
+    // 与标量参考实现逐项一致
+    std::vector<UByte> scalar_visibility(bounds.GetCount(), 0xFF);
+    FrustumCullBoxesScalar(cascades[1].frustum, bounds, 0, bounds.GetCount(), scalar_visibility.data());
+    CullShadowCasters(cascades[1], bounds, 0, bounds.GetCount(), visibility.data());
+    CHECK(visibility == scalar_visibility);
+}
+
+TEST_CASE("Cascaded shadow fitting and caster culling 100k casters", "[.][benchmark][CascadedShadow]")
+{
+    constexpr UInt kCasterCount = 100000;
+    std::mt19937 random(7);
+    std::uniform_real_distribution<Float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<Float> extent(0.5f, 4.0f);
+    CullingBoundsSoA bounds;
+    BoundingBox caster_bounds;
+    for (UInt i = 0; i < kCasterCount; ++i)
+    {
+        const Vector3 center(position(random), position(random) * 0.1f, position(random));
+        const Float e = extent(random);
+        const BoundingBox box(center - Vector3(e, e, e), center + Vector3(e, e, e));
+        bounds.Add(box);
+        caster_bounds.Merge(box);
+    }
+
+    const CascadeShadowView view = MakeShadowView(Vector3(0.0f, 10.0f, 0.0f), Vector3(20.0f, 0.0f, -50.0f));
+    CascadeShadowDesc desc;
+    ShadowCascade cascades[kMaxShadowCascadeCount];
+    std::vector<UByte> visibility(kCasterCount);
+
+    BENCHMARK("fit cascades")
+    {
+        ComputeShadowCascades(desc, view, kLightDirection, caster_bounds, cascades);
+        return cascades[0].texel_size;
+    };
+
+    ComputeShadowCascades(desc, view, kLightDirection, caster_bounds, cascades);
+    BENCHMARK("cull casters scalar")
+    {
+        UInt visible_count = 0;
+        for (UInt cascade_index = 0; cascade_index < desc.cascade_count; ++cascade_index)
+        {
+            visible_count += FrustumCullBoxesScalar(cascades[cascade_index].frustum, bounds, 0, kCasterCount, visibility.data());
+        }
+        return visible_count;
+    };
+
+    BENCHMARK("cull casters simd")
+    {
+        UInt visible_count = 0;
+        for (UInt cascade_index = 0; cascade_index < desc.cascade_count; ++cascade_index)
+        {
+            visible_count += CullShadowCasters(cascades[cascade_index], bounds, 0, kCasterCount, visibility.data());
+        }
+        return visible_count;
+    };
+}
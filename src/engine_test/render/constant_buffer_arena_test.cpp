@@ -0,0 +1,74 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <vector>
+#include "dolas_constant_buffer_arena.h"
+
+using namespace Dolas;
+
+TEST_CASE("ConstantBufferArena places blocks at aligned offsets", "[ConstantBuffer]")
+{
+    ConstantBufferArena arena;
+    CHECK(arena.Allocate(0) == ConstantBufferArena::INVALID_BLOCK);
+
+    const UInt first = arena.Allocate(256);
+    const UInt second = arena.Allocate(320);
+    const UInt third = arena.Allocate(16);
+    CHECK(arena.GetBlockCount() == 3);
+    CHECK(arena.GetBlockOffset(first) == 0);
+    CHECK(arena.GetBlockOffset(second) == 256);
+    CHECK(arena.GetBlockOffset(third) == 768);
+    CHECK(arena.GetBlockSize(second) == 320);
+    CHECK(arena.GetSize() == 1024);
+    CHECK_FALSE(arena.IsValidBlock(ConstantBufferArena::INVALID_BLOCK));
+    CHECK(arena.GetBlockData(ConstantBufferArena::INVALID_BLOCK) == nullptr);
+
+    // 新块整块为脏；首尾相接的区间合并成一段上传，中间隔着对齐填充的不合并
+    std::vector<ConstantBufferRange> ranges;
+    arena.TakeDirtyRanges(ranges);
+    REQUIRE(ranges.size() == 2);
+    CHECK((ranges[0] == ConstantBufferRange{ 0, 576 }));
+    CHECK((ranges[1] == ConstantBufferRange{ 768, 784 }));
+    CHECK_FALSE(arena.IsDirty());
+
+    arena.Clear();
+    CHECK(arena.GetSize() == 0);
+    CHECK(arena.GetBlockCount() == 0);
+}
+
+TEST_CASE("ConstantBufferArena keeps blocks independent and uploads only changed bytes", "[ConstantBuffer]")
+{
+    // 两个材质共用同一个 shader（同一份布局），各自的参数互不覆盖
+    const ConstantBufferVariableHandle base_color{ 0, 16 };
+    const ConstantBufferVariableHandle albedo_map_index{ 16, 4 };
+
+    ConstantBufferArena arena;
+    const UInt material_a = arena.Allocate(32);
+    const UInt material_b = arena.Allocate(32);
+    std::vector<ConstantBufferRange> ranges;
+    arena.TakeDirtyRanges(ranges);
+
+    const Float red[4] = { 1.0f, 0.0f, 0.0f, 1.0f };
+    const Float blue[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+    const UInt index = 7;
+    CHECK(arena.Write(material_a, base_color, red, sizeof(red)));
+    CHECK(arena.Write(material_b, base_color, blue, sizeof(blue)));
+    CHECK(arena.Write(material_b, albedo_map_index, &index, sizeof(index)));
+    CHECK(std::memcmp(arena.GetBlockData(material_a), red, sizeof(red)) == 0);
+    CHECK(std::memcmp(arena.GetBlockData(material_b), blue, sizeof(blue)) == 0);
+
+    arena.TakeDirtyRanges(ranges);
+    REQUIRE(ranges.size() == 2);
+    CHECK((ranges[0] == ConstantBufferRange{ 0, 16 }));
+    CHECK((ranges[1] == ConstantBufferRange{ 256, 276 }));
+
+    // 相同的值不产生上传
+    CHECK_FALSE(arena.Write(material_a, base_color, red, sizeof(red)));
+    CHECK_FALSE(arena.IsDirty());
+
+    // 越界的 handle、无效的块被忽略
+    CHECK_FALSE(arena.Write(material_a, ConstantBufferVariableHandle{ 24, 16 }, red, sizeof(red)));
+    CHECK_FALSE(arena.Write(ConstantBufferArena::INVALID_BLOCK, base_color, red, sizeof(red)));
+    CHECK_FALSE(arena.Write(material_a, ConstantBufferVariableHandle{}, red, sizeof(red)));
+    arena.TakeDirtyRanges(ranges);
+    CHECK(ranges.empty());
+}
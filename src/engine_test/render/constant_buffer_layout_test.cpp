@@ -0,0 +1,180 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "dolas_constant_buffer_layout.h"
+
+using namespace Dolas;
+
+namespace
+{
+    // 与 deferred_shading_ps.hlsl 的 GlobalConstants 相同的布局
+    ConstantBufferInfo MakeDeferredShadingConstants()
+    {
+        ConstantBufferInfo info;
+        info.name = "GlobalConstants";
+        info.size = 320;
+        info.variable_descs.push_back({ "g_LightClusterGrid", 0, 16, 2 });
+        info.variable_descs.push_back({ "g_LightClusterDepth", 16, 16, 2 });
+        info.variable_descs.push_back({ "g_ShadowCascadeMatrices", 32, 256, 2 });
+        info.variable_descs.push_back({ "g_ShadowCascadeSplits", 288, 16, 2 });
+        info.variable_descs.push_back({ "g_ShadowParams", 304, 16, 2 });
+        info.variable_count = static_cast<UInt>(info.variable_descs.size());
+        return info;
+    }
+
+    // 旧的写入方式：每次按名字找 GlobalConstants，再按名字找变量
+    void WriteByName(const ShaderReflectionInfo& reflection, std::vector<UByte>& bytes, const std::string& name, const void* data, std::size_t size)
+    {
+        const ConstantBufferInfo* target = nullptr;
+        for (const ConstantBufferInfo& constant_buffer : reflection.constant_buffer_descs)
+        {
+            if (constant_buffer.name == "GlobalConstants")
+            {
+                target = &constant_buffer;
+                break;
+            }
+        }
+        if (!target)
+        {
+            return;
+        }
+        for (const ConstantBufferVariableInfo& variable : target->variable_descs)
+        {
+            if (name == variable.name)
+            {
+                std::memcpy(bytes.data() + variable.start_offset, data, std::min<std::size_t>(size, variable.size));
+                return;
+            }
+        }
+    }
+}
+
+TEST_CASE("ConstantBufferLayout resolves variables by interned name", "[ConstantBuffer]")
+{
+    ConstantBufferLayout layout;
+    REQUIRE(layout.Build(MakeDeferredShadingConstants()));
+    CHECK(layout.GetSize() == 320);
+    CHECK(layout.GetVariableCount() == 5);
+
+    const ConstantBufferVariableHandle splits = layout.FindVariable(STRING_ID(g_ShadowCascadeSplits));
+    REQUIRE(splits.IsValid());
+    CHECK(splits.offset == 288);
+    CHECK(splits.size == 16);
+    CHECK(layout.FindVariable("g_ShadowCascadeMatrices").size == 256);
+    CHECK_FALSE(layout.FindVariable("g_DebugDrawColor").IsValid());
+
+    // 越界的变量不进入布局
+    ConstantBufferInfo corrupted = MakeDeferredShadingConstants();
+    corrupted.variable_descs.push_back({ "g_OutOfRange", 312, 16, 2 });
+    REQUIRE(layout.Build(corrupted));
+    CHECK_FALSE(layout.FindVariable("g_OutOfRange").IsValid());
+
+    layout.Clear();
+    CHECK_FALSE(layout.FindVariable("g_ShadowParams").IsValid());
+}
+
+TEST_CASE("ConstantBufferData tracks the dirty byte range", "[ConstantBuffer]")
+{
+    ConstantBufferLayout layout;
+    layout.Build(MakeDeferredShadingConstants());
+    const ConstantBufferVariableHandle grid = layout.FindVariable("g_LightClusterGrid");
+    const ConstantBufferVariableHandle splits = layout.FindVariable("g_ShadowCascadeSplits");
+    const ConstantBufferVariableHandle params = layout.FindVariable("g_ShadowParams");
+
+    ConstantBufferData data;
+    data.Resize(layout.GetSize());
+    // 新建的缓冲区整块需要上传
+    CHECK(data.IsDirty());
+    CHECK(data.GetDirtyBegin() == 0);
+    CHECK(data.GetDirtyEnd() == 320);
+    data.ClearDirty();
+    CHECK_FALSE(data.IsDirty());
+
+    const Float values[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+    CHECK(data.Write(splits, values, sizeof(values)));
+    CHECK(data.GetDirtyBegin() == 288);
+    CHECK(data.GetDirtyEnd() == 304);
+
+    // 区间合并为覆盖所有改动的最小范围
+    CHECK(data.Write(params, values, sizeof(Float)));
+    CHECK(data.GetDirtyBegin() == 288);
+    CHECK(data.GetDirtyEnd() == 308);
+    float stored = 0.0f;
+    std::memcpy(&stored, data.GetBytes().data() + 304, sizeof(stored));
+    CHECK(stored == 1.0f);
+
+    data.ClearDirty();
+    // 写入相同的值不产生上传
+    CHECK_FALSE(data.Write(splits, values, sizeof(values)));
+    CHECK_FALSE(data.IsDirty());
+
+    // 超出变量大小的部分被截断
+    const Float wide[8] = { 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 9.0f, 9.0f, 9.0f };
+    CHECK(data.Write(grid, wide, sizeof(wide)));
+    CHECK(data.GetDirtyBegin() == 0);
+    CHECK(data.GetDirtyEnd() == 16);
+
+    // 无效 handle 与 handle 超出缓冲区时忽略
+    CHECK_FALSE(data.Write(ConstantBufferVariableHandle{}, values, sizeof(values)));
+    CHECK_FALSE(data.Write(ConstantBufferVariableHandle{ 1024, 16 }, values, sizeof(values)));
+}
+
+TEST_CASE("Constant buffer handle writes versus string lookup", "[.][benchmark][ConstantBuffer]")
+{
+    // 一帧中 DebugPass 为每个调试对象写一次颜色
+    constexpr UInt kWriteCount = 4096;
+    ShaderReflectionInfo reflection;
+    ConstantBufferInfo per_view;
+    per_view.name = "PerViewConstants";
+    per_view.size = 256;
+    reflection.constant_buffer_descs.push_back(per_view);
+    reflection.constant_buffer_descs.push_back(MakeDeferredShadingConstants());
+
+    ConstantBufferLayout layout;
+    layout.Build(reflection.constant_buffer_descs[1]);
+    ConstantBufferData data;
+    data.Resize(layout.GetSize());
+    std::vector<UByte> bytes(layout.GetSize());
+
+    // 轮流写几个变量，和 DeferredShadingPass 每帧写入的一组参数一样；
+    // 调用处传入字符串字面量，旧接口每次都要构造 std::string
+    const char* const names[] = { "g_LightClusterGrid", "g_LightClusterDepth", "g_ShadowCascadeSplits", "g_ShadowParams" };
+    constexpr UInt kNameCount = 4;
+    std::vector<ConstantBufferVariableHandle> handles;
+    for (const char* name : names)
+    {
+        handles.push_back(layout.FindVariable(name));
+    }
+
+    BENCHMARK("string lookup")
+    {
+        for (UInt index = 0; index < kWriteCount; ++index)
+        {
+            const Float value[4] = { static_cast<Float>(index), 0.0f, 0.0f, 1.0f };
+            WriteByName(reflection, bytes, names[index % kNameCount], value, sizeof(value));
+        }
+        return bytes[304];
+    };
+
+    BENCHMARK("name id lookup")
+    {
+        for (UInt index = 0; index < kWriteCount; ++index)
+        {
+            const Float value[4] = { static_cast<Float>(index), 0.0f, 0.0f, 1.0f };
+            data.Write(layout.FindVariable(names[index % kNameCount]), value, sizeof(value));
+        }
+        return data.GetDirtyEnd();
+    };
+
+    BENCHMARK("pre-resolved handle")
+    {
+        for (UInt index = 0; index < kWriteCount; ++index)
+        {
+            const Float value[4] = { static_cast<Float>(index), 0.0f, 0.0f, 1.0f };
+            data.Write(handles[index % kNameCount], value, sizeof(value));
+        }
+        return data.GetDirtyEnd();
+    };
+}
@@ -0,0 +1,279 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "dolas_cubemap.h"
+
+using namespace Dolas;
+
+namespace
+{
+    constexpr Double kPi = 3.14159265358979323846;
+
+    // 按 D3D 的规则选择主轴与面内坐标，与 ComputeCubemapDirection 互逆
+    void SelectCubemapTexel(const Float direction[3], UInt& out_face, Float& out_s, Float& out_t)
+    {
+        const Float ax = std::fabs(direction[0]);
+        const Float ay = std::fabs(direction[1]);
+        const Float az = std::fabs(direction[2]);
+        if (ax >= ay && ax >= az)
+        {
+            out_face = direction[0] > 0.0f ? 0 : 1;
+            out_s = (direction[0] > 0.0f ? -direction[2] : direction[2]) / ax;
+            out_t = -direction[1] / ax;
+        }
+        else if (ay >= az)
+        {
+            out_face = direction[1] > 0.0f ? 2 : 3;
+            out_s = direction[0] / ay;
+            out_t = (direction[1] > 0.0f ? direction[2] : -direction[2]) / ay;
+        }
+        else
+        {
+            out_face = direction[2] > 0.0f ? 4 : 5;
+            out_s = (direction[2] > 0.0f ? direction[0] : -direction[0]) / az;
+            out_t = -direction[1] / az;
+        }
+    }
+
+    // f(d) = 1 + d.z + 0.5 * d.x^2，在球面上的积分为 4π + 0.5 * 4π / 3
+    Float SkyFunction(const Float direction[3])
+    {
+        return 1.0f + direction[2] + 0.5f * direction[0] * direction[0];
+    }
+
+    TextureImage MakeEquirect(UInt width, UInt height)
+    {
+        TextureImage image;
+        image.Resize(width, height);
+        for (UInt y = 0; y < height; ++y)
+        {
+            const Double theta = (y + 0.5) / height * kPi;
+            for (UInt x = 0; x < width; ++x)
+            {
+                const Double phi = ((x + 0.5) / width - 0.5) * 2.0 * kPi;
+                const Float direction[3] = {
+                    static_cast<Float>(std::sin(theta) * std::cos(phi)),
+                    static_cast<Float>(std::sin(theta) * std::sin(phi)),
+                    static_cast<Float>(std::cos(theta)) };
+                Float* pixel = image.GetPixel(x, y);
+                pixel[0] = SkyFunction(direction);
+                pixel[1] = 2.0f * pixel[0];
+                pixel[2] = 0.25f;
+                pixel[3] = 1.0f;
+            }
+        }
+        return image;
+    }
+
+    Double IntegrateFace(const TextureImage& face, UInt channel)
+    {
+        Double sum = 0.0;
+        for (UInt y = 0; y < face.height; ++y)
+        {
+            for (UInt x = 0; x < face.width; ++x)
+            {
+                sum += face.GetPixel(x, y)[channel] * ComputeCubemapTexelSolidAngle(x, y, face.width);
+            }
+        }
+        return sum;
+    }
+
+    // 按不规则的段长调用 task，验证结果与分段方式无关
+    void UnevenParallelFor(UInt count, const std::function<void(UInt, UInt)>& task)
+    {
+        std::vector<std::pair<UInt, UInt>> ranges;
+        for (UInt begin = 0, step = 1; begin < count; begin += step, step = step % 5 + 2)
+        {
+            ranges.emplace_back(begin, std::min(count, begin + step));
+        }
+        std::reverse(ranges.begin(), ranges.end());
+        for (const auto& range : ranges)
+        {
+            task(range.first, range.second);
+        }
+    }
+}
+
+TEST_CASE("Cubemap directions follow the D3D face convention", "[Cubemap]")
+{
+    const Float expected_centers[CUBE_FACE_COUNT][3] = {
+        { 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
+        { 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f } };
+    for (UInt face = 0; face < CUBE_FACE_COUNT; ++face)
+    {
+        Float direction[3];
+        ComputeCubemapDirection(face, 0.0f, 0.0f, direction);
+        for (UInt c = 0; c < 3; ++c)
+        {
+            CHECK(std::fabs(direction[c] - expected_centers[face][c]) < 1e-6f);
+        }
+    }
+
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<Float> coordinate(-0.999f, 0.999f);
+    for (UInt i = 0; i < 600; ++i)
+    {
+        const UInt face = i % CUBE_FACE_COUNT;
+        const Float s = coordinate(generator);
+        const Float t = coordinate(generator);
+        Float direction[3];
+        ComputeCubemapDirection(face, s, t, direction);
+        CHECK(std::fabs(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2] - 1.0f) < 1e-5f);
+
+        UInt selected_face = 0;
+        Float selected_s = 0.0f;
+        Float selected_t = 0.0f;
+        SelectCubemapTexel(direction, selected_face, selected_s, selected_t);
+        CHECK(selected_face == face);
+        CHECK(std::fabs(selected_s - s) < 1e-4f);
+        CHECK(std::fabs(selected_t - t) < 1e-4f);
+    }
+
+    SECTION("Texel solid angles cover the sphere")
+    {
+        for (UInt face_size : { 1u, 7u, 64u })
+        {
+            Double total = 0.0;
+            for (UInt y = 0; y < face_size; ++y)
+            {
+                for (UInt x = 0; x < face_size; ++x)
+                {
+                    total += ComputeCubemapTexelSolidAngle(x, y, face_size);
+                }
+            }
+            CHECK(std::fabs(total * CUBE_FACE_COUNT - 4.0 * kPi) < 1e-4);
+        }
+        // 面中心的纹素比角上的大
+        CHECK(ComputeCubemapTexelSolidAngle(31, 31, 64) > 2.5f * ComputeCubemapTexelSolidAngle(0, 0, 64));
+    }
+
+    SECTION("Equirect mapping matches the spherical sky shader")
+    {
+        Float u = 0.0f;
+        Float v = 0.0f;
+        const Float positive_x[3] = { 1.0f, 0.0f, 0.0f };
+        ComputeEquirectUV(positive_x, u, v);
+        CHECK(std::fabs(u - 0.5f) < 1e-6f);
+        CHECK(std::fabs(v - 0.5f) < 1e-6f);
+        const Float positive_y[3] = { 0.0f, 1.0f, 0.0f };
+        ComputeEquirectUV(positive_y, u, v);
+        CHECK(std::fabs(u - 0.75f) < 1e-6f);
+        const Float up[3] = { 0.0f, 0.0f, 1.0f };
+        ComputeEquirectUV(up, u, v);
+        CHECK(std::fabs(v) < 1e-6f);
+    }
+}
+
+TEST_CASE("Equirect to cubemap conversion preserves radiance", "[Cubemap]")
+{
+    const TextureImage equirect = MakeEquirect(256, 128);
+
+    CubemapBuildSettings settings;
+    Cubemap cubemap;
+    REQUIRE(BuildCubemapFromEquirect(equirect, settings, cubemap));
+    REQUIRE(cubemap.face_size == 64);
+    REQUIRE(cubemap.mip_count == 7);
+    REQUIRE(cubemap.faces.size() == CUBE_FACE_COUNT * 7);
+
+    // 逐纹素与解析值比较（源图只有 256 x 128，允许插值误差）
+    Float max_error = 0.0f;
+    for (UInt face = 0; face < CUBE_FACE_COUNT; ++face)
+    {
+        const TextureImage& level = cubemap.GetFace(face, 0);
+        for (UInt y = 0; y < level.height; ++y)
+        {
+            for (UInt x = 0; x < level.width; ++x)
+            {
+                Float direction[3];
+                ComputeCubemapDirection(face, (x + 0.5f) / 32.0f - 1.0f, (y + 0.5f) / 32.0f - 1.0f, direction);
+                max_error = std::max(max_error, std::fabs(level.GetPixel(x, y)[0] - SkyFunction(direction)));
+            }
+        }
+    }
+    CHECK(max_error < 0.03f);
+
+    // 每一级 mip 的立体角积分都与解析积分一致（降采样按立体角加权，能量守恒）
+    const Double expected = 4.0 * kPi + 0.5 * 4.0 * kPi / 3.0;
+    for (UInt mip = 0; mip < cubemap.mip_count; ++mip)
+    {
+        Double integral = 0.0;
+        Double constant = 0.0;
+        for (UInt face = 0; face < CUBE_FACE_COUNT; ++face)
+        {
+            integral += IntegrateFace(cubemap.GetFace(face, mip), 0);
+            constant += IntegrateFace(cubemap.GetFace(face, mip), 2);
+        }
+        CHECK(std::fabs(integral - expected) / expected < 0.005);
+        CHECK(std::fabs(constant - 0.25 * 4.0 * kPi) < 1e-3);
+    }
+
+    SECTION("Parallel conversion is identical to serial")
+    {
+        Cubemap parallel;
+        REQUIRE(BuildCubemapFromEquirect(equirect, settings, parallel, UnevenParallelFor));
+        REQUIRE(parallel.faces.size() == cubemap.faces.size());
+        for (std::size_t i = 0; i < cubemap.faces.size(); ++i)
+        {
+            CHECK(parallel.faces[i].pixels == cubemap.faces[i].pixels);
+        }
+    }
+
+    SECTION("Face size and mip count settings")
+    {
+        CubemapBuildSettings limited;
+        limited.face_size = 50;
+        limited.max_mip_count = 3;
+        limited.samples_per_axis = 1;
+        Cubemap small;
+        REQUIRE(BuildCubemapFromEquirect(equirect, limited, small));
+        CHECK(small.face_size == 32);
+        CHECK(small.mip_count == 3);
+        CHECK(small.GetFace(5, 2).width == 8);
+    }
+}
+
+TEST_CASE("Cooked cubemap is a BC6H cube DDS", "[Cubemap]")
+{
+    const TextureImage equirect = MakeEquirect(64, 32);
+    CubemapBuildSettings settings;
+    Cubemap cubemap;
+    REQUIRE(BuildCubemapFromEquirect(equirect, settings, cubemap));
+    REQUIRE(cubemap.face_size == 16);
+
+    CookedTexture cooked;
+    REQUIRE(CookCubemap(cubemap, cooked, UnevenParallelFor));
+    CHECK(cooked.format == BlockFormat::BC6H);
+    CHECK(cooked.face_count == CUBE_FACE_COUNT);
+    CHECK(cooked.GetMipCount() == 5);
+    CHECK(cooked.mips[0].size() == 16 * 16);
+    CHECK(cooked.mips[4].size() == 16);  // 1x1 也占一个块
+    CHECK(cooked.encoded_texel_count == CUBE_FACE_COUNT * (256 + 64 + 16 + 4 + 1));
+
+    // +Z 面 mip 0 的第一个块解码后接近源数据
+    Float decoded[BLOCK_TEXEL_COUNT * 4];
+    REQUIRE(DecodeBlock(BlockFormat::BC6H, cooked.mips[4 * 5].data(), decoded));
+    const TextureImage& positive_z = cubemap.GetFace(4, 0);
+    for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+    {
+        const Float expected = positive_z.GetPixel(i % 4, i / 4)[0];
+        CHECK(std::fabs(decoded[i * 4] - expected) < 0.1f * expected);
+    }
+
+    const std::vector<UByte> dds = BuildCookedTextureDDS(cooked);
+    auto read_uint = [&dds](std::size_t offset)
+    {
+        UInt value = 0;
+        std::memcpy(&value, dds.data() + offset, sizeof(value));
+        return value;
+    };
+    CHECK(read_uint(4 + 24) == 5);                  // mip count
+    CHECK((read_uint(4 + 104) & 0x8) != 0);         // caps COMPLEX
+    CHECK(read_uint(4 + 108) == (0x200u | 0xFC00u)); // caps2 全部六个面
+    CHECK(read_uint(128 + 0) == 95);                // DXGI_FORMAT_BC6H_UF16
+    CHECK(read_uint(128 + 8) == 0x4);               // DDS_RESOURCE_MISC_TEXTURECUBE
+    CHECK(read_uint(128 + 12) == 1);
+    CHECK(dds.size() == 148 + cooked.GetByteSize());
+}
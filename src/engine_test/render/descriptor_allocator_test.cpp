@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+#include "dolas_base.h"
+#include "dolas_descriptor_allocator.h"
+
+using namespace Dolas;
+
+// ============ DescriptorIndexAllocator Tests ============
+
+TEST_CASE("DescriptorIndexAllocator allocates inside its range", "[DescriptorAllocator]")
+{
+    DescriptorIndexAllocator allocator;
+    allocator.Initialize(2, 4);
+
+    REQUIRE(allocator.Allocate() == 2);
+    REQUIRE(allocator.Allocate(2) == 3);
+    REQUIRE(allocator.Allocate() == 5);
+    REQUIRE(allocator.Allocate() == DescriptorIndexAllocator::INVALID_INDEX);
+    REQUIRE(allocator.GetAllocatedCount() == 4);
+    REQUIRE(allocator.GetFreeRangeCount() == 0);
+    REQUIRE(allocator.Allocate(0) == DescriptorIndexAllocator::INVALID_INDEX);
+}
+
+TEST_CASE("DescriptorIndexAllocator reuses freed indices and coalesces ranges", "[DescriptorAllocator]")
+{
+    DescriptorIndexAllocator allocator;
+    allocator.Initialize(0, 8);
+
+    std::vector<UInt> indices;
+    for (UInt i = 0; i < 8; ++i)
+    {
+        indices.push_back(allocator.Allocate());
+    }
+    REQUIRE(allocator.Allocate() == DescriptorIndexAllocator::INVALID_INDEX);
+
+    REQUIRE(allocator.Free(indices[2]));
+    REQUIRE(allocator.Free(indices[4]));
+    REQUIRE(allocator.GetFreeRangeCount() == 2);
+    REQUIRE(allocator.GetLargestFreeRange() == 1);
+
+    // 释放中间的 3 之后 [2,5) 合并成一段
+    REQUIRE(allocator.Free(indices[3]));
+    REQUIRE(allocator.GetFreeRangeCount() == 1);
+    REQUIRE(allocator.GetLargestFreeRange() == 3);
+    REQUIRE(allocator.Allocate(3) == 2);
+    REQUIRE(allocator.GetAllocatedCount() == 8);
+}
+
+TEST_CASE("DescriptorIndexAllocator rejects double and out-of-range frees", "[DescriptorAllocator]")
+{
+    DescriptorIndexAllocator allocator;
+    allocator.Initialize(10, 4);
+
+    const UInt index = allocator.Allocate(2);
+    REQUIRE(index == 10);
+    REQUIRE(allocator.Free(index, 2));
+    REQUIRE_FALSE(allocator.Free(index));
+    REQUIRE_FALSE(allocator.Free(11));
+    REQUIRE_FALSE(allocator.Free(9));
+    REQUIRE_FALSE(allocator.Free(13, 2));
+    REQUIRE(allocator.GetAllocatedCount() == 0);
+    REQUIRE(allocator.GetLargestFreeRange() == 4);
+}
+
+TEST_CASE("DescriptorIndexAllocator does not leak under create/destroy churn", "[DescriptorAllocator]")
+{
+    DescriptorIndexAllocator allocator;
+    allocator.Initialize(1, 64);
+
+    // 模拟反复 resize：每轮创建一批不同大小的视图再全部释放
+    for (UInt frame = 0; frame < 1000; ++frame)
+    {
+        std::vector<std::pair<UInt, UInt>> allocations;
+        for (UInt i = 0; i < 10; ++i)
+        {
+            const UInt count = 1 + (frame + i) % 3;
+            const UInt index = allocator.Allocate(count);
+            REQUIRE(index != DescriptorIndexAllocator::INVALID_INDEX);
+            allocations.emplace_back(index, count);
+        }
+        for (size_t i = 0; i < allocations.size(); ++i)
+        {
+            // 交错释放顺序，覆盖前后两种合并路径
+            const auto& allocation = allocations[(i * 7) % allocations.size()];
+            REQUIRE(allocator.Free(allocation.first, allocation.second));
+        }
+    }
+    REQUIRE(allocator.GetAllocatedCount() == 0);
+    REQUIRE(allocator.GetFreeRangeCount() == 1);
+    REQUIRE(allocator.GetLargestFreeRange() == 64);
+}
+
+TEST_CASE("DescriptorIndexAllocator advances its free generation when an index is recycled", "[DescriptorAllocator]")
+{
+    DescriptorIndexAllocator allocator;
+    allocator.Initialize(1, 4);
+
+    // 常驻 SRV table 只记录源 descriptor 的下标：销毁纹理后立刻创建新纹理会拿回同一个下标，
+    // 必须能从释放代数上看出这个下标已经指向了别的资源
+    const UInt old_texture_index = allocator.Allocate();
+    const ULongLong cached_generation = allocator.GetFreeGeneration();
+    REQUIRE(allocator.Allocate() != old_texture_index);
+    REQUIRE(allocator.GetFreeGeneration() == cached_generation);
+
+    REQUIRE(allocator.Free(old_texture_index));
+    const UInt new_texture_index = allocator.Allocate();
+    REQUIRE(new_texture_index == old_texture_index);
+    REQUIRE(allocator.GetFreeGeneration() != cached_generation);
+
+    // 被拒绝的释放不改变代数
+    const ULongLong generation_after_reuse = allocator.GetFreeGeneration();
+    REQUIRE_FALSE(allocator.Free(0));
+    REQUIRE_FALSE(allocator.Free(allocator.GetFirstIndex() + allocator.GetCapacity()));
+    REQUIRE(allocator.GetFreeGeneration() == generation_after_reuse);
+}
@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "dolas_draw_sort_key.h"
+
+using namespace Dolas;
+
+// ============ DrawSortKey Encode / Decode Tests ============
+
+TEST_CASE("DrawSortKey encode and decode round trip", "[DrawSortKey][encode]")
+{
+    ULongLong key = DrawSortKey::Encode(3, 1234, 40000, 512, 65535);
+    REQUIRE(DrawSortKey::GetPass(key) == 3);
+    REQUIRE(DrawSortKey::GetPipeline(key) == 1234);
+    REQUIRE(DrawSortKey::GetMaterial(key) == 40000);
+    REQUIRE(DrawSortKey::GetMesh(key) == 512);
+    REQUIRE(DrawSortKey::GetDepth(key) == 65535);
+}
+
+TEST_CASE("DrawSortKey saturates out of range fields", "[DrawSortKey][encode]")
+{
+    ULongLong key = DrawSortKey::Encode(100, 5000, 0, 0, 0);
+    REQUIRE(DrawSortKey::GetPass(key) == 15);
+    REQUIRE(DrawSortKey::GetPipeline(key) == 4095);
+    REQUIRE(DrawSortKey::GetMaterial(key) == 0);
+}
+
+TEST_CASE("DrawSortKey field priority follows pass, pipeline, material, mesh, depth", "[DrawSortKey][encode]")
+{
+    REQUIRE(DrawSortKey::Encode(0, 4095, 65535, 65535, 65535) < DrawSortKey::Encode(1, 0, 0, 0, 0));
+    REQUIRE(DrawSortKey::Encode(0, 0, 65535, 65535, 65535) < DrawSortKey::Encode(0, 1, 0, 0, 0));
+    REQUIRE(DrawSortKey::Encode(0, 0, 0, 65535, 65535) < DrawSortKey::Encode(0, 0, 1, 0, 0));
+    REQUIRE(DrawSortKey::Encode(0, 0, 0, 0, 65535) < DrawSortKey::Encode(0, 0, 0, 1, 0));
+}
+
+TEST_CASE("DrawSortKey depth-first keys order by depth before mesh", "[DrawSortKey][encode]")
+{
+    // 同一 pipeline 内由近及远，mesh 只在深度相同时参与排序
+    REQUIRE(DrawSortKey::EncodeDepthFirst(0, 0, 10, 65535) < DrawSortKey::EncodeDepthFirst(0, 0, 11, 0));
+    REQUIRE(DrawSortKey::EncodeDepthFirst(0, 0, 10, 1) < DrawSortKey::EncodeDepthFirst(0, 0, 10, 2));
+    REQUIRE(DrawSortKey::EncodeDepthFirst(0, 0, 65535, 65535) < DrawSortKey::EncodeDepthFirst(0, 1, 0, 0));
+    REQUIRE(DrawSortKey::EncodeDepthFirst(0, 4095, 65535, 65535) < DrawSortKey::EncodeDepthFirst(1, 0, 0, 0));
+
+    ULongLong key = DrawSortKey::EncodeDepthFirst(2, 7, 1234, 56);
+    REQUIRE(DrawSortKey::GetPass(key) == 2);
+    REQUIRE(DrawSortKey::GetPipeline(key) == 7);
+    REQUIRE(DrawSortKey::GetDepth(key) == 0);
+}
+
+TEST_CASE("DrawSortKey QuantizeDepth ordering", "[DrawSortKey][depth]")
+{
+    REQUIRE(DrawSortKey::QuantizeDepth(0.1f, 0.1f, 100.0f) == 0);
+    REQUIRE(DrawSortKey::QuantizeDepth(100.0f, 0.1f, 100.0f) == 65535);
+    REQUIRE(DrawSortKey::QuantizeDepth(-5.0f, 0.1f, 100.0f) == 0);
+    REQUIRE(DrawSortKey::QuantizeDepth(500.0f, 0.1f, 100.0f) == 65535);
+    REQUIRE(DrawSortKey::QuantizeDepth(10.0f, 0.1f, 100.0f) < DrawSortKey::QuantizeDepth(20.0f, 0.1f, 100.0f));
+    REQUIRE(DrawSortKey::QuantizeDepth(10.0f, 0.1f, 100.0f, false) > DrawSortKey::QuantizeDepth(20.0f, 0.1f, 100.0f, false));
+}
+
+// ============ RadixSortDrawEntries Tests ============
+
+TEST_CASE("RadixSortDrawEntries handles empty and single input", "[RadixSort]")
+{
+    std::vector<DrawSortEntry> entries;
+    std::vector<DrawSortEntry> scratch;
+    RadixSortDrawEntries(entries, scratch);
+    REQUIRE(entries.empty());
+
+    entries.push_back({ 42ull, 7 });
+    RadixSortDrawEntries(entries, scratch);
+    REQUIRE(entries.size() == 1);
+    REQUIRE(entries[0].m_key == 42ull);
+    REQUIRE(entries[0].m_index == 7);
+}
+
+TEST_CASE("RadixSortDrawEntries matches std::stable_sort on random keys", "[RadixSort]")
+{
+    std::mt19937_64 rng(12345);
+    std::vector<DrawSortEntry> entries(4096);
+    for (UInt i = 0; i < entries.size(); ++i)
+    {
+        // 只使用少量不同的 key，保证有重复值以检查稳定性
+        entries[i].m_key = DrawSortKey::Encode(
+            static_cast<UInt>(rng() % 3),
+            static_cast<UInt>(rng() % 8),
+            static_cast<UInt>(rng() % 32),
+            static_cast<UInt>(rng() % 16),
+            static_cast<UInt>(rng() % 4));
+        entries[i].m_index = i;
+    }
+
+    std::vector<DrawSortEntry> expected = entries;
+    std::stable_sort(expected.begin(), expected.end(),
+        [](const DrawSortEntry& a, const DrawSortEntry& b) { return a.m_key < b.m_key; });
+
+    std::vector<DrawSortEntry> scratch;
+    RadixSortDrawEntries(entries, scratch);
+
+    REQUIRE(entries.size() == expected.size());
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+        REQUIRE(entries[i].m_key == expected[i].m_key);
+        REQUIRE(entries[i].m_index == expected[i].m_index);
+    }
+}
+
+TEST_CASE("RadixSortDrawEntries sorts full 64-bit keys", "[RadixSort]")
+{
+    std::vector<DrawSortEntry> entries = {
+        { 0xFFFFFFFFFFFFFFFFull, 0 },
+        { 0x0000000000000001ull, 1 },
+        { 0x8000000000000000ull, 2 },
+        { 0x00000000FFFFFFFFull, 3 },
+        { 0x0000000000000000ull, 4 },
+    };
+    std::vector<DrawSortEntry> scratch;
+    RadixSortDrawEntries(entries, scratch);
+
+    REQUIRE(entries[0].m_index == 4);
+    REQUIRE(entries[1].m_index == 1);
+    REQUIRE(entries[2].m_index == 3);
+    REQUIRE(entries[3].m_index == 2);
+    REQUIRE(entries[4].m_index == 0);
+}
@@ -0,0 +1,273 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "dolas_dynamic_aabb_tree.h"
+#include "bounds_test_helpers.h"
+
+using namespace Dolas;
+
+namespace
+{
+    std::vector<BoundingBox> MakeRandomBoxes(UInt count, UInt seed, Float range = 200.0f)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<Float> position(-range, range);
+        std::uniform_real_distribution<Float> size(0.1f, 2.0f);
+        std::vector<BoundingBox> boxes;
+        boxes.reserve(count);
+        for (UInt i = 0; i < count; ++i)
+        {
+            boxes.push_back(MakeBox(Vector3(position(generator), position(generator), position(generator)), size(generator)));
+        }
+        return boxes;
+    }
+
+    Frustum MakeTestFrustum()
+    {
+        const Matrix4x4 projection = Matrix4x4::Perspective(MathUtil::PI * 0.5f, 1.0f, -150.0f, -1.0f);
+        return Frustum::FromViewProjection(projection);
+    }
+
+    std::vector<ULongLong> SortedUserData(const DynamicAABBTree& tree, const std::vector<Int>& proxies)
+    {
+        std::vector<ULongLong> result;
+        for (Int proxy_id : proxies)
+        {
+            result.push_back(tree.GetUserData(proxy_id));
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+}
+
+TEST_CASE("DynamicAABBTree insert, remove and refit keep the tree valid", "[DynamicAABBTree]")
+{
+    DynamicAABBTree tree;
+    REQUIRE(tree.Validate());
+
+    const std::vector<BoundingBox> boxes = MakeRandomBoxes(2000, 3);
+    std::vector<Int> proxies;
+    for (UInt i = 0; i < boxes.size(); ++i)
+    {
+        proxies.push_back(tree.Insert(boxes[i], i));
+    }
+    REQUIRE(tree.GetProxyCount() == 2000);
+    REQUIRE(tree.Validate());
+
+    // 小于外扩边距的移动不会改动树结构
+    const BoundingBox small_move(boxes[0].min_point + Vector3(0.05f, 0.0f, 0.0f), boxes[0].max_point + Vector3(0.05f, 0.0f, 0.0f));
+    REQUIRE_FALSE(tree.Refit(proxies[0], small_move));
+    REQUIRE(tree.Refit(proxies[0], MakeBox(Vector3(500.0f, 0.0f, 0.0f), 1.0f)));
+    REQUIRE(tree.GetFatBounds(proxies[0]).Contains(MakeBox(Vector3(500.0f, 0.0f, 0.0f), 1.0f)));
+    REQUIRE(tree.Validate());
+
+    for (UInt i = 0; i < boxes.size(); i += 2)
+    {
+        tree.Remove(proxies[i]);
+    }
+    REQUIRE(tree.GetProxyCount() == 1000);
+    REQUIRE(tree.Validate());
+
+    // 回收的节点被复用
+    const UInt node_count = tree.GetNodeCount();
+    tree.Insert(MakeBox(Vector3::ZERO, 1.0f), 99999);
+    REQUIRE(tree.GetNodeCount() == node_count + 2);
+    REQUIRE(tree.Validate());
+
+    tree.Clear();
+    REQUIRE(tree.GetProxyCount() == 0);
+    REQUIRE(tree.Validate());
+}
+
+TEST_CASE("DynamicAABBTree rotations keep sorted insertion shallow", "[DynamicAABBTree]")
+{
+    // 沿一条直线按顺序插入是不做旋转时退化为链表的典型情况
+    DynamicAABBTree tree(0.0f);
+    for (UInt i = 0; i < 4096; ++i)
+    {
+        tree.Insert(MakeBox(Vector3(static_cast<Float>(i) * 2.0f, 0.0f, 0.0f), 0.5f), i);
+    }
+    REQUIRE(tree.Validate());
+    REQUIRE(tree.GetHeight() < 64);
+}
+
+TEST_CASE("DynamicAABBTree queries match brute force", "[DynamicAABBTree]")
+{
+    const std::vector<BoundingBox> boxes = MakeRandomBoxes(5000, 11);
+    DynamicAABBTree tree(0.0f);
+    std::vector<Int> proxies;
+    for (UInt i = 0; i < boxes.size(); ++i)
+    {
+        proxies.push_back(tree.Insert(boxes[i], i));
+    }
+
+    SECTION("box")
+    {
+        const BoundingBox query(Vector3(-50.0f, -20.0f, -80.0f), Vector3(40.0f, 60.0f, 10.0f));
+        std::vector<Int> hits;
+        tree.QueryBox(query, [&hits](Int proxy_id) { hits.push_back(proxy_id); return true; });
+
+        std::vector<ULongLong> expected;
+        for (UInt i = 0; i < boxes.size(); ++i)
+        {
+            if (query.Intersects(boxes[i])) expected.push_back(i);
+        }
+        REQUIRE(!expected.empty());
+        REQUIRE(SortedUserData(tree, hits) == expected);
+    }
+
+    SECTION("frustum")
+    {
+        const Frustum frustum = MakeTestFrustum();
+        std::vector<Int> hits;
+        tree.QueryFrustum(frustum, [&hits](Int proxy_id) { hits.push_back(proxy_id); return true; });
+
+        std::vector<ULongLong> expected;
+        for (UInt i = 0; i < boxes.size(); ++i)
+        {
+            if (frustum.IntersectsBox(boxes[i])) expected.push_back(i);
+        }
+        REQUIRE(!expected.empty());
+        REQUIRE(SortedUserData(tree, hits) == expected);
+    }
+
+    SECTION("ray closest hit")
+    {
+        // 射向某个包围盒的中心，保证至少有一次命中
+        const Vector3 origin(-300.0f, 1.0f, 2.0f);
+        const Vector3 direction = boxes[17].GetCenter() - origin;
+        Int closest_proxy = DynamicAABBTree::NULL_NODE;
+        tree.RayCast(origin, direction, 2.0f, [&](Int proxy_id, Float max_distance)
+        {
+            Float distance = 0.0f;
+            if (boxes[tree.GetUserData(proxy_id)].IntersectsRay(origin, direction, max_distance, distance))
+            {
+                closest_proxy = proxy_id;
+                return distance;
+            }
+            return max_distance;
+        });
+
+        Float expected_distance = 2.0f;
+        ULongLong expected_index = ~0ull;
+        for (UInt i = 0; i < boxes.size(); ++i)
+        {
+            Float distance = 0.0f;
+            if (boxes[i].IntersectsRay(origin, direction, expected_distance, distance))
+            {
+                expected_distance = distance;
+                expected_index = i;
+            }
+        }
+        REQUIRE(expected_index != ~0ull);
+        REQUIRE(closest_proxy != DynamicAABBTree::NULL_NODE);
+        REQUIRE(tree.GetUserData(closest_proxy) == expected_index);
+    }
+
+    SECTION("early out")
+    {
+        UInt visit_count = 0;
+        tree.QueryBox(BoundingBox(Vector3(-300.0f, -300.0f, -300.0f), Vector3(300.0f, 300.0f, 300.0f)),
+            [&visit_count](Int) { ++visit_count; return visit_count < 10; });
+        REQUIRE(visit_count == 10);
+    }
+}
+
+TEST_CASE("DynamicAABBTree vs brute force", "[.][benchmark][DynamicAABBTree]")
+{
+    constexpr UInt kBoxCount = 100000;
+    const std::vector<BoundingBox> boxes = MakeRandomBoxes(kBoxCount, 5, 1000.0f);
+    DynamicAABBTree tree;
+    std::vector<Int> proxies(kBoxCount);
+
+    BENCHMARK("build 100k")
+    {
+        tree.Clear();
+        for (UInt i = 0; i < kBoxCount; ++i)
+        {
+            proxies[i] = tree.Insert(boxes[i], i);
+        }
+        return tree.GetHeight();
+    };
+
+    const Frustum frustum = MakeTestFrustum();
+    BENCHMARK("frustum query (tree)")
+    {
+        UInt count = 0;
+        tree.QueryFrustum(frustum, [&count](Int) { ++count; return true; });
+        return count;
+    };
+    BENCHMARK("frustum query (brute force)")
+    {
+        UInt count = 0;
+        for (const BoundingBox& box : boxes)
+        {
+            count += frustum.IntersectsBox(box) ? 1 : 0;
+        }
+        return count;
+    };
+
+    const BoundingBox query(Vector3(-50.0f, -50.0f, -50.0f), Vector3(50.0f, 50.0f, 50.0f));
+    BENCHMARK("box query (tree)")
+    {
+        UInt count = 0;
+        tree.QueryBox(query, [&count](Int) { ++count; return true; });
+        return count;
+    };
+    BENCHMARK("box query (brute force)")
+    {
+        UInt count = 0;
+        for (const BoundingBox& box : boxes)
+        {
+            count += query.Intersects(box) ? 1 : 0;
+        }
+        return count;
+    };
+
+    const Vector3 origin(-1200.0f, 3.0f, 7.0f);
+    const Vector3 direction(1.0f, 0.01f, 0.0f);
+    BENCHMARK("ray cast (tree)")
+    {
+        Float closest = 5000.0f;
+        tree.RayCast(origin, direction, closest, [&](Int proxy_id, Float max_distance)
+        {
+            Float distance = 0.0f;
+            if (boxes[tree.GetUserData(proxy_id)].IntersectsRay(origin, direction, max_distance, distance))
+            {
+                closest = distance;
+                return distance;
+            }
+            return max_distance;
+        });
+        return closest;
+    };
+    BENCHMARK("ray cast (brute force)")
+    {
+        Float closest = 5000.0f;
+        for (const BoundingBox& box : boxes)
+        {
+            Float distance = 0.0f;
+            if (box.IntersectsRay(origin, direction, closest, distance))
+            {
+                closest = distance;
+            }
+        }
+        return closest;
+    };
+
+    // 10% 的物体每帧移动：大部分移动留在外扩包围盒内，不需要重新插入
+    std::vector<BoundingBox> moved = boxes;
+    BENCHMARK("refit 10k moving proxies")
+    {
+        UInt reinserted = 0;
+        for (UInt i = 0; i < kBoxCount; i += 10)
+        {
+            moved[i].min_point.x += 0.03f;
+            moved[i].max_point.x += 0.03f;
+            reinserted += tree.Refit(proxies[i], moved[i]) ? 1 : 0;
+        }
+        return reinserted;
+    };
+}
@@ -0,0 +1,175 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+#include "dolas_bounds.h"
+#include "dolas_frustum_culling.h"
+#include "bounds_test_helpers.h"
+
+using namespace Dolas;
+
+namespace
+{
+    // 位于原点、朝 -Z 看的透视相机，near = 1, far = 100, 90 度视角
+    Frustum MakeTestFrustum()
+    {
+        const Matrix4x4 projection = Matrix4x4::Perspective(MathUtil::PI * 0.5f, 1.0f, -100.0f, -1.0f);
+        return Frustum::FromViewProjection(projection);
+    }
+
+    void FillRandomBoxes(CullingBoundsSoA& bounds, UInt count, UInt seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<Float> position(-200.0f, 200.0f);
+        std::uniform_real_distribution<Float> size(0.1f, 5.0f);
+        bounds.Clear();
+        bounds.Reserve(count);
+        for (UInt i = 0; i < count; ++i)
+        {
+            bounds.Add(MakeBox(Vector3(position(generator), position(generator), position(generator)), size(generator)));
+        }
+    }
+}
+
+// ============ Bounding Volume Tests ============
+
+TEST_CASE("BoundingBox from positions and transform", "[Bounds]")
+{
+    const Float positions[] = {
+        -1.0f, 0.0f, 2.0f,   9.0f, 9.0f,
+        3.0f, -2.0f, 0.0f,   9.0f, 9.0f,
+        0.0f, 4.0f, 1.0f,    9.0f, 9.0f,
+    };
+    const BoundingBox box = BoundingBox::FromPositions(positions, 3, 5);
+    REQUIRE(box.IsValid());
+    REQUIRE(box.min_point.x == -1.0f);
+    REQUIRE(box.min_point.y == -2.0f);
+    REQUIRE(box.min_point.z == 0.0f);
+    REQUIRE(box.max_point.x == 3.0f);
+    REQUIRE(box.max_point.y == 4.0f);
+    REQUIRE(box.max_point.z == 2.0f);
+    REQUIRE_FALSE(BoundingBox().IsValid());
+
+    // 绕 Y 轴旋转 90 度并平移：x/z 半长互换
+    Pose pose(Vector3(10.0f, 0.0f, 0.0f), Quaternion(0.70710678f, 0.0f, 0.70710678f, 0.0f), Vector3(1.0f, 1.0f, 1.0f));
+    const BoundingBox world_box = box.Transform(pose.ToMatrix());
+    const Vector3 extents = world_box.GetExtents();
+    REQUIRE(std::abs(extents.x - 1.0f) < 1e-4f);
+    REQUIRE(std::abs(extents.y - 3.0f) < 1e-4f);
+    REQUIRE(std::abs(extents.z - 2.0f) < 1e-4f);
+    REQUIRE(std::abs(world_box.GetCenter().x - 11.0f) < 1e-4f);
+}
+
+TEST_CASE("BoundingSphere contains all positions and scales conservatively", "[Bounds]")
+{
+    const Float positions[] = { 1.0f, 1.0f, 1.0f, -1.0f, -1.0f, -1.0f, 1.0f, -1.0f, 0.0f };
+    const BoundingSphere sphere = BoundingSphere::FromPositions(positions, 3);
+    REQUIRE(sphere.IsValid());
+    for (UInt i = 0; i < 3; ++i)
+    {
+        const Vector3 point(positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2]);
+        REQUIRE((point - sphere.center).Length() <= sphere.radius + 1e-5f);
+    }
+
+    Pose pose(Vector3::ZERO, Quaternion::IDENTITY, Vector3(1.0f, 3.0f, 2.0f));
+    const BoundingSphere scaled = sphere.Transform(pose.ToMatrix());
+    REQUIRE(std::abs(scaled.radius - sphere.radius * 3.0f) < 1e-4f);
+}
+
+// ============ Frustum Tests ============
+
+TEST_CASE("Frustum classifies boxes against all six planes", "[FrustumCulling]")
+{
+    const Frustum frustum = MakeTestFrustum();
+
+    REQUIRE(frustum.IntersectsBox(MakeBox(Vector3(0.0f, 0.0f, -10.0f), 1.0f)));
+    REQUIRE_FALSE(frustum.IntersectsBox(MakeBox(Vector3(0.0f, 0.0f, 10.0f), 1.0f)));    // 相机后方
+    REQUIRE_FALSE(frustum.IntersectsBox(MakeBox(Vector3(0.0f, 0.0f, -0.2f), 0.5f)));    // 近平面之前
+    REQUIRE_FALSE(frustum.IntersectsBox(MakeBox(Vector3(0.0f, 0.0f, -150.0f), 1.0f)));  // 远平面之后
+    REQUIRE_FALSE(frustum.IntersectsBox(MakeBox(Vector3(-30.0f, 0.0f, -10.0f), 1.0f))); // 左
+    REQUIRE_FALSE(frustum.IntersectsBox(MakeBox(Vector3(30.0f, 0.0f, -10.0f), 1.0f)));  // 右
+    REQUIRE_FALSE(frustum.IntersectsBox(MakeBox(Vector3(0.0f, -30.0f, -10.0f), 1.0f))); // 下
+    REQUIRE_FALSE(frustum.IntersectsBox(MakeBox(Vector3(0.0f, 30.0f, -10.0f), 1.0f)));  // 上
+    // 跨越左平面的包围盒保守地保留
+    REQUIRE(frustum.IntersectsBox(MakeBox(Vector3(-10.5f, 0.0f, -10.0f), 1.0f)));
+
+    REQUIRE(frustum.IntersectsSphere(BoundingSphere(Vector3(0.0f, 0.0f, -50.0f), 1.0f)));
+    REQUIRE_FALSE(frustum.IntersectsSphere(BoundingSphere(Vector3(0.0f, 0.0f, 50.0f), 1.0f)));
+}
+
+TEST_CASE("SIMD frustum culling matches scalar reference", "[FrustumCulling]")
+{
+    const Frustum frustum = MakeTestFrustum();
+    CullingBoundsSoA bounds;
+    // 非 8 的倍数，覆盖 SIMD 尾部
+    FillRandomBoxes(bounds, 10007, 7);
+    bounds.Add(BoundingBox());
+
+    const UInt count = bounds.GetCount();
+    std::vector<UByte> simd_visibility(count, 2);
+    std::vector<UByte> scalar_visibility(count, 2);
+    const UInt simd_visible = FrustumCullBoxes(frustum, bounds, 0, count, simd_visibility.data());
+    const UInt scalar_visible = FrustumCullBoxesScalar(frustum, bounds, 0, count, scalar_visibility.data());
+
+    REQUIRE(simd_visible == scalar_visible);
+    REQUIRE(simd_visibility == scalar_visibility);
+    REQUIRE(simd_visible > 0);
+    REQUIRE(simd_visible < count);
+    REQUIRE(simd_visibility.back() == 0);
+
+    // 分块调用与整体调用结果一致（并行剔除按块划分）
+    std::vector<UByte> chunked_visibility(count, 2);
+    UInt chunked_visible = 0;
+    for (UInt begin = 0; begin < count; begin += 1000)
+    {
+        chunked_visible += FrustumCullBoxes(frustum, bounds, begin, std::min(begin + 1000, count), chunked_visibility.data());
+    }
+    REQUIRE(chunked_visible == simd_visible);
+    REQUIRE(chunked_visibility == simd_visibility);
+}
+
+TEST_CASE("Frustum culling 1M boxes", "[.][benchmark][FrustumCulling]")
+{
+    constexpr UInt kBoxCount = 1000000;
+    const Frustum frustum = MakeTestFrustum();
+    CullingBoundsSoA bounds;
+    FillRandomBoxes(bounds, kBoxCount, 1);
+    std::vector<UByte> visibility(kBoxCount);
+
+    BENCHMARK("scalar")
+    {
+        return FrustumCullBoxesScalar(frustum, bounds, 0, kBoxCount, visibility.data());
+    };
+
+    BENCHMARK("simd")
+    {
+        return FrustumCullBoxes(frustum, bounds, 0, kBoxCount, visibility.data());
+    };
+
+    BENCHMARK("simd parallel")
+    {
+        const UInt thread_count = std::max(1u, std::thread::hardware_concurrency());
+        const UInt chunk_size = (kBoxCount + thread_count - 1) / thread_count;
+        std::vector<UInt> visible_counts(thread_count, 0);
+        std::vector<std::thread> threads;
+        for (UInt thread_index = 0; thread_index < thread_count; ++thread_index)
+        {
+            threads.emplace_back([&, thread_index]()
+            {
+                const UInt begin = thread_index * chunk_size;
+                const UInt end = std::min(begin + chunk_size, kBoxCount);
+                visible_counts[thread_index] = FrustumCullBoxes(frustum, bounds, begin, end, visibility.data());
+            });
+        }
+        UInt visible_count = 0;
+        for (UInt thread_index = 0; thread_index < thread_count; ++thread_index)
+        {
+            threads[thread_index].join();
+            visible_count += visible_counts[thread_index];
+        }
+        return visible_count;
+    };
+}
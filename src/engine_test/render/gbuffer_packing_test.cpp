@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <vector>
+#include "dolas_gbuffer_packing.h"
+
+using namespace Dolas::GBufferPacking;
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+
+namespace
+{
+    // 模拟写入 UNORM 渲染目标时的量化（就近取整）
+    float QuantizeUnorm(float value, int bits)
+    {
+        const float max_value = static_cast<float>((1 << bits) - 1);
+        return std::floor(saturate(value) * max_value + 0.5f) / max_value;
+    }
+
+    float4 QuantizeGBufferA(const float4& value)
+    {
+        return float4(QuantizeUnorm(value.x, 10), QuantizeUnorm(value.y, 10), QuantizeUnorm(value.z, 10), QuantizeUnorm(value.w, 2));
+    }
+
+    float4 QuantizeGBufferB(const float4& value)
+    {
+        return float4(QuantizeUnorm(value.x, 8), QuantizeUnorm(value.y, 8), QuantizeUnorm(value.z, 8), QuantizeUnorm(value.w, 8));
+    }
+
+    // 斐波那契球面采样，外加坐标轴和八面体折叠边上的方向
+    std::vector<float3> MakeTestDirections(int count)
+    {
+        std::vector<float3> directions;
+        const float golden_angle = 3.14159265f * (3.0f - std::sqrt(5.0f));
+        for (int i = 0; i < count; ++i)
+        {
+            const float z = 1.0f - 2.0f * (i + 0.5f) / count;
+            const float radius = std::sqrt(1.0f - z * z);
+            const float phi = golden_angle * i;
+            directions.push_back(float3(radius * std::cos(phi), radius * std::sin(phi), z));
+        }
+
+        const float3 special[] = {
+            float3(1.0f, 0.0f, 0.0f), float3(-1.0f, 0.0f, 0.0f),
+            float3(0.0f, 1.0f, 0.0f), float3(0.0f, -1.0f, 0.0f),
+            float3(0.0f, 0.0f, 1.0f), float3(0.0f, 0.0f, -1.0f),
+            normalize(float3(1.0f, 1.0f, 0.0f)), normalize(float3(-1.0f, 1.0f, -0.0001f)),
+            normalize(float3(1.0f, -1.0f, -1.0f)), normalize(float3(-1.0f, -1.0f, -1.0f)),
+        };
+        directions.insert(directions.end(), std::begin(special), std::end(special));
+        return directions;
+    }
+
+    // 用叉积和点积求夹角，避免 acos 在接近 1 时的精度损失
+    double AngleDegrees(const float3& a, const float3& b)
+    {
+        const double cross_x = static_cast<double>(a.y) * b.z - static_cast<double>(a.z) * b.y;
+        const double cross_y = static_cast<double>(a.z) * b.x - static_cast<double>(a.x) * b.z;
+        const double cross_z = static_cast<double>(a.x) * b.y - static_cast<double>(a.y) * b.x;
+        const double sin_angle = std::sqrt(cross_x * cross_x + cross_y * cross_y + cross_z * cross_z);
+        const double cos_angle = static_cast<double>(a.x) * b.x + static_cast<double>(a.y) * b.y + static_cast<double>(a.z) * b.z;
+        return std::atan2(sin_angle, cos_angle) * 180.0 / 3.14159265358979;
+    }
+}
+
+TEST_CASE("Octahedral normal encoding round-trips within the 10-bit quantization error", "[render][gbuffer]")
+{
+    double max_exact_error = 0.0;
+    double max_quantized_error = 0.0;
+    for (const float3& direction : MakeTestDirections(4096))
+    {
+        const float2 encoded = GBufferEncodeNormal(direction);
+        REQUIRE(encoded.x >= 0.0f);
+        REQUIRE(encoded.x <= 1.0f);
+        REQUIRE(encoded.y >= 0.0f);
+        REQUIRE(encoded.y <= 1.0f);
+
+        const float3 decoded = GBufferDecodeNormal(encoded);
+        REQUIRE_THAT(dot(decoded, decoded), WithinAbs(1.0, 1e-5));
+        max_exact_error = std::max(max_exact_error, AngleDegrees(direction, decoded));
+
+        const float2 quantized(QuantizeUnorm(encoded.x, 10), QuantizeUnorm(encoded.y, 10));
+        max_quantized_error = std::max(max_quantized_error, AngleDegrees(direction, GBufferDecodeNormal(quantized)));
+    }
+
+    // 未量化时只有浮点误差；10 bit 八面体编码就近量化后的最大角度误差约 0.24 度
+    CHECK(max_exact_error < 0.001);
+    CHECK(max_quantized_error < 0.25);
+}
+
+TEST_CASE("Shade mode survives the 2-bit alpha channel", "[render][gbuffer]")
+{
+    for (int shade_mode = 0; shade_mode < SHADE_MODE_COUNT; ++shade_mode)
+    {
+        const float encoded = GBufferEncodeShadeMode(shade_mode);
+        CHECK(GBufferDecodeShadeMode(encoded) == shade_mode);
+        CHECK(GBufferDecodeShadeMode(QuantizeUnorm(encoded, 2)) == shade_mode);
+    }
+
+    // 越界输入被钳制到合法范围
+    CHECK(GBufferDecodeShadeMode(GBufferEncodeShadeMode(-1)) == SHADE_MODE_OPAQUE);
+    CHECK(GBufferDecodeShadeMode(GBufferEncodeShadeMode(SHADE_MODE_COUNT + 3)) == SHADE_MODE_COUNT - 1);
+    CHECK(GBufferDecodeShadeMode(1.0f) == SHADE_MODE_COUNT - 1);
+}
+
+TEST_CASE("Shininess uses a logarithmic 8-bit encoding", "[render][gbuffer]")
+{
+    // 每档相对步长 2^(10/255)，就近量化的误差不超过半档
+    const float max_relative_error = std::exp2(GBUFFER_SHININESS_MAX_LOG2 / 255.0f * 0.5f) - 1.0f;
+    for (float shininess = 1.0f; shininess <= 1024.0f; shininess *= 1.1f)
+    {
+        const float decoded = GBufferDecodeShininess(QuantizeUnorm(GBufferEncodeShininess(shininess), 8));
+        CHECK_THAT(decoded, WithinRel(shininess, max_relative_error + 1e-4f));
+    }
+
+    CHECK_THAT(GBufferDecodeShininess(GBufferEncodeShininess(0.0f)), WithinAbs(1.0, 1e-5));
+    CHECK_THAT(GBufferDecodeShininess(GBufferEncodeShininess(4096.0f)), WithinRel(1024.0f, 1e-5f));
+}
+
+TEST_CASE("Packed GBuffer round-trips a surface through the render target formats", "[render][gbuffer]")
+{
+    GBufferSurface surface;
+    surface.world_normal = normalize(float3(0.3f, -0.8f, -0.52f));
+    surface.albedo = float3(0.75f, 0.5f, 0.125f);
+    surface.specular = GBufferSpecularIntensity(float3(0.5f, 0.5f, 0.5f));
+    surface.shininess = 32.0f;
+    surface.shade_mode = SHADE_MODE_BLINN_PHONG;
+
+    const GBufferPacked packed = GBufferPack(surface);
+    const GBufferSurface unpacked = GBufferUnpack(QuantizeGBufferA(packed.gbuffer_a), QuantizeGBufferB(packed.gbuffer_b));
+
+    CHECK(AngleDegrees(surface.world_normal, unpacked.world_normal) < 0.25);
+    CHECK_THAT(unpacked.albedo.x, WithinAbs(surface.albedo.x, 0.5 / 255.0 + 1e-6));
+    CHECK_THAT(unpacked.albedo.y, WithinAbs(surface.albedo.y, 0.5 / 255.0 + 1e-6));
+    CHECK_THAT(unpacked.albedo.z, WithinAbs(surface.albedo.z, 0.5 / 255.0 + 1e-6));
+    CHECK_THAT(unpacked.specular, WithinAbs(0.5, 0.5 / 1023.0 + 1e-6));
+    CHECK_THAT(unpacked.shininess, WithinRel(32.0f, 0.014f));
+    CHECK(unpacked.shade_mode == SHADE_MODE_BLINN_PHONG);
+
+    // 超出 [0, 1] 的颜色在打包时钳制，而不是依赖渲染目标的隐式截断
+    surface.albedo = float3(1.5f, -0.25f, 0.5f);
+    surface.specular = 2.0f;
+    const GBufferPacked clamped = GBufferPack(surface);
+    CHECK(clamped.gbuffer_b.x == 1.0f);
+    CHECK(clamped.gbuffer_b.y == 0.0f);
+    CHECK(clamped.gbuffer_a.z == 1.0f);
+}
+
+TEST_CASE("Specular color reduces to luminance", "[render][gbuffer]")
+{
+    CHECK_THAT(GBufferSpecularIntensity(float3(1.0f, 1.0f, 1.0f)), WithinAbs(1.0, 1e-5));
+    CHECK_THAT(GBufferSpecularIntensity(float3(0.0f, 0.0f, 0.0f)), WithinAbs(0.0, 1e-6));
+    CHECK_THAT(GBufferSpecularIntensity(float3(0.0f, 1.0f, 0.0f)), WithinAbs(0.7152, 1e-5));
+}
@@ -0,0 +1,384 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "dolas_image_based_lighting.h"
+
+using namespace Dolas;
+
+namespace
+{
+    constexpr Double kPi = 3.14159265358979323846;
+
+    using SkyFunction = std::function<void(const Float direction[3], Float out_color[4])>;
+
+    // 直接在立方体纹素中心求值（不经过 equirect），只检验积分本身的误差
+    Cubemap MakeCubemap(UInt face_size, const SkyFunction& sky)
+    {
+        CubemapBuildSettings settings;
+        settings.face_size = face_size;
+        settings.samples_per_axis = 1;
+        TextureImage placeholder;
+        placeholder.Resize(4 * face_size, 2 * face_size);
+        Cubemap cubemap;
+        BuildCubemapFromEquirect(placeholder, settings, cubemap);
+        for (UInt face = 0; face < CUBE_FACE_COUNT; ++face)
+        {
+            for (UInt mip = 0; mip < cubemap.mip_count; ++mip)
+            {
+                TextureImage& level = cubemap.GetFace(face, mip);
+                for (UInt y = 0; y < level.height; ++y)
+                {
+                    for (UInt x = 0; x < level.width; ++x)
+                    {
+                        Float direction[3];
+                        ComputeCubemapDirection(face, (x + 0.5f) * 2.0f / level.width - 1.0f, (y + 0.5f) * 2.0f / level.height - 1.0f, direction);
+                        sky(direction, level.GetPixel(x, y));
+                    }
+                }
+            }
+        }
+        return cubemap;
+    }
+
+    void ConstantSky(const Float*, Float out_color[4])
+    {
+        out_color[0] = 1.0f;
+        out_color[1] = 0.5f;
+        out_color[2] = 2.0f;
+        out_color[3] = 1.0f;
+    }
+
+    // f(d) = 1 + d.z + 0.5 * d.x^2，在球面上的积分为 4π + 0.5 * 4π / 3
+    void GradientSky(const Float direction[3], Float out_color[4])
+    {
+        out_color[0] = 1.0f + direction[2] + 0.5f * direction[0] * direction[0];
+        out_color[1] = out_color[0];
+        out_color[2] = out_color[0];
+        out_color[3] = 1.0f;
+    }
+
+    Double IntegrateCubemap(const Cubemap& cubemap, UInt mip, UInt channel)
+    {
+        Double sum = 0.0;
+        for (UInt face = 0; face < CUBE_FACE_COUNT; ++face)
+        {
+            const TextureImage& level = cubemap.GetFace(face, mip);
+            for (UInt y = 0; y < level.height; ++y)
+            {
+                for (UInt x = 0; x < level.width; ++x)
+                {
+                    sum += level.GetPixel(x, y)[channel] * ComputeCubemapTexelSolidAngle(x, y, level.width);
+                }
+            }
+        }
+        return sum;
+    }
+
+    // shader 中 g_SkyIrradianceSH 的求值方式
+    Float EvaluatePackedSH(const Float constants[SH_L2_COEFFICIENT_COUNT][4], const Float n[3], UInt channel)
+    {
+        const Float x = n[0];
+        const Float y = n[1];
+        const Float z = n[2];
+        const Float terms[SH_L2_COEFFICIENT_COUNT] = { 1.0f, y, z, x, x * y, y * z, 3.0f * z * z - 1.0f, x * z, x * x - y * y };
+        Float value = 0.0f;
+        for (UInt i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+        {
+            value += constants[i][channel] * terms[i];
+        }
+        return value;
+    }
+
+    // 按不规则的段长倒序调用 task，验证结果与分段方式无关
+    void UnevenParallelFor(UInt count, const std::function<void(UInt, UInt)>& task)
+    {
+        std::vector<std::pair<UInt, UInt>> ranges;
+        for (UInt begin = 0, step = 1; begin < count; begin += step, step = step % 5 + 2)
+        {
+            ranges.emplace_back(begin, std::min(count, begin + step));
+        }
+        std::reverse(ranges.begin(), ranges.end());
+        for (const auto& range : ranges)
+        {
+            task(range.first, range.second);
+        }
+    }
+}
+
+TEST_CASE("Spherical harmonics irradiance conserves energy", "[ImageBasedLighting]")
+{
+    SECTION("Basis is orthonormal under the cubemap solid angles")
+    {
+        const UInt face_size = 64;
+        Double products[SH_L2_COEFFICIENT_COUNT][SH_L2_COEFFICIENT_COUNT] = {};
+        for (UInt face = 0; face < CUBE_FACE_COUNT; ++face)
+        {
+            for (UInt y = 0; y < face_size; ++y)
+            {
+                for (UInt x = 0; x < face_size; ++x)
+                {
+                    Float direction[3];
+                    ComputeCubemapDirection(face, (x + 0.5f) * 2.0f / face_size - 1.0f, (y + 0.5f) * 2.0f / face_size - 1.0f, direction);
+                    Float basis[SH_L2_COEFFICIENT_COUNT];
+                    EvaluateSHBasisL2(direction, basis);
+                    const Double solid_angle = ComputeCubemapTexelSolidAngle(x, y, face_size);
+                    for (UInt i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+                    {
+                        for (UInt j = 0; j < SH_L2_COEFFICIENT_COUNT; ++j)
+                        {
+                            products[i][j] += basis[i] * basis[j] * solid_angle;
+                        }
+                    }
+                }
+            }
+        }
+        for (UInt i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+        {
+            for (UInt j = 0; j < SH_L2_COEFFICIENT_COUNT; ++j)
+            {
+                CHECK(std::fabs(products[i][j] - (i == j ? 1.0 : 0.0)) < 2e-3);
+            }
+        }
+    }
+
+    SECTION("White furnace: a constant sky lights a white surface with the sky radiance")
+    {
+        const Cubemap cubemap = MakeCubemap(16, ConstantSky);
+        SphericalHarmonicsL2 radiance;
+        REQUIRE(ProjectCubemapToSH(cubemap, 0, radiance));
+        const SphericalHarmonicsL2 irradiance = ConvolveSHWithCosineLobe(radiance);
+        Float constants[SH_L2_COEFFICIENT_COUNT][4];
+        PackIrradianceSHForShader(irradiance, constants);
+
+        const Float expected[3] = { 1.0f, 0.5f, 2.0f };
+        for (UInt face = 0; face < CUBE_FACE_COUNT; ++face)
+        {
+            Float n[3];
+            ComputeCubemapDirection(face, 0.3f, -0.6f, n);
+            Float E[3];
+            EvaluateSHL2(irradiance, n, E);
+            for (UInt c = 0; c < 3; ++c)
+            {
+                CHECK(std::fabs(E[c] - expected[c] * kPi) < 1e-3 * kPi);
+                CHECK(std::fabs(EvaluatePackedSH(constants, n, c) - expected[c]) < 1e-3f);
+            }
+        }
+    }
+
+    SECTION("Irradiance of a linear sky matches the analytic cosine integral")
+    {
+        // L = 1 + ω.z：E(n) = π + (2π / 3) n.z，L2 截断对 l <= 1 的信号是精确的
+        const Cubemap cubemap = MakeCubemap(32, [](const Float direction[3], Float out_color[4])
+        {
+            out_color[0] = out_color[1] = out_color[2] = 1.0f + direction[2];
+            out_color[3] = 1.0f;
+        });
+        SphericalHarmonicsL2 radiance;
+        REQUIRE(ProjectCubemapToSH(cubemap, 0, radiance));
+        const SphericalHarmonicsL2 irradiance = ConvolveSHWithCosineLobe(radiance);
+        for (UInt face = 0; face < CUBE_FACE_COUNT; ++face)
+        {
+            Float n[3];
+            ComputeCubemapDirection(face, -0.2f, 0.7f, n);
+            Float E[3];
+            EvaluateSHL2(irradiance, n, E);
+            const Double expected = kPi + 2.0 * kPi / 3.0 * n[2];
+            CHECK(std::fabs(E[0] - expected) < 2e-3 * kPi);
+        }
+    }
+
+    SECTION("Projection is identical for serial and uneven parallel splits")
+    {
+        const Cubemap cubemap = MakeCubemap(16, GradientSky);
+        SphericalHarmonicsL2 serial;
+        SphericalHarmonicsL2 parallel;
+        REQUIRE(ProjectCubemapToSH(cubemap, 1, serial));
+        REQUIRE(ProjectCubemapToSH(cubemap, 1, parallel, UnevenParallelFor));
+        for (UInt i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+        {
+            for (UInt c = 0; c < 3; ++c)
+            {
+                CHECK(serial.coefficients[i][c] == parallel.coefficients[i][c]);
+            }
+        }
+        CHECK_FALSE(ProjectCubemapToSH(cubemap, cubemap.mip_count, serial));
+    }
+
+    SECTION("Cache file round trip")
+    {
+        const Cubemap cubemap = MakeCubemap(8, GradientSky);
+        SphericalHarmonicsL2 sh;
+        REQUIRE(ProjectCubemapToSH(cubemap, 0, sh));
+        std::vector<UByte> bytes = BuildSphericalHarmonicsFile(sh);
+        SphericalHarmonicsL2 parsed;
+        REQUIRE(ParseSphericalHarmonicsFile(bytes.data(), bytes.size(), parsed));
+        for (UInt i = 0; i < SH_L2_COEFFICIENT_COUNT; ++i)
+        {
+            for (UInt c = 0; c < 3; ++c)
+            {
+                CHECK(parsed.coefficients[i][c] == sh.coefficients[i][c]);
+            }
+        }
+        CHECK_FALSE(ParseSphericalHarmonicsFile(bytes.data(), bytes.size() - 1, parsed));
+        bytes[0] = 'X';
+        CHECK_FALSE(ParseSphericalHarmonicsFile(bytes.data(), bytes.size(), parsed));
+    }
+}
+
+TEST_CASE("GGX prefiltered specular cubemap conserves energy", "[ImageBasedLighting]")
+{
+    ImageBasedLightingSettings settings;
+    settings.specular_face_size = 16;
+    settings.specular_mip_count = 5;
+    settings.specular_sample_count = 64;
+
+    SECTION("White furnace: every roughness level of a constant sky is the constant")
+    {
+        const Cubemap source = MakeCubemap(32, ConstantSky);
+        Cubemap specular;
+        REQUIRE(PrefilterSpecularCubemap(source, settings, specular));
+        REQUIRE(specular.face_size == 16);
+        REQUIRE(specular.mip_count == 5);
+        for (UInt face = 0; face < CUBE_FACE_COUNT; ++face)
+        {
+            for (UInt mip = 0; mip < specular.mip_count; ++mip)
+            {
+                const TextureImage& level = specular.GetFace(face, mip);
+                for (UInt i = 0; i < level.width * level.height; ++i)
+                {
+                    const Float* pixel = level.pixels.data() + i * 4;
+                    CHECK(std::fabs(pixel[0] - 1.0f) < 1e-5f);
+                    CHECK(std::fabs(pixel[1] - 0.5f) < 1e-5f);
+                    CHECK(std::fabs(pixel[2] - 2.0f) < 1e-5f);
+                }
+            }
+        }
+    }
+
+    const Cubemap source = MakeCubemap(32, GradientSky);
+    Cubemap specular;
+    REQUIRE(PrefilterSpecularCubemap(source, settings, specular));
+
+    SECTION("Mip 0 is the source level of the same size")
+    {
+        for (UInt face = 0; face < CUBE_FACE_COUNT; ++face)
+        {
+            CHECK(specular.GetFace(face, 0).pixels == source.GetFace(face, 1).pixels);
+        }
+    }
+
+    SECTION("A normalized zonal lobe keeps the sphere integral at every roughness")
+    {
+        const Double expected = 4.0 * kPi + 0.5 * 4.0 * kPi / 3.0;
+        for (UInt mip = 0; mip < specular.mip_count; ++mip)
+        {
+            const Double integral = IntegrateCubemap(specular, mip, 0);
+            CHECK(std::fabs(integral - expected) / expected < 0.02);
+        }
+
+        // 粗糙度越高，l = 1 的分量衰减越多：+Z 与 -Z 两个面的平均值之差逐级减小（x² 项在两侧对称，互相抵消）
+        auto face_average = [&specular](CubeFace face, UInt mip)
+        {
+            const TextureImage& level = specular.GetFace(static_cast<UInt>(face), mip);
+            Double sum = 0.0;
+            Double solid_angle_sum = 0.0;
+            for (UInt y = 0; y < level.height; ++y)
+            {
+                for (UInt x = 0; x < level.width; ++x)
+                {
+                    const Double solid_angle = ComputeCubemapTexelSolidAngle(x, y, level.width);
+                    sum += level.GetPixel(x, y)[0] * solid_angle;
+                    solid_angle_sum += solid_angle;
+                }
+            }
+            return sum / solid_angle_sum;
+        };
+        // 最后两级只有 2x2 / 1x1 个纹素，面平均值不再代表同一组方向，不参与比较
+        Double previous_contrast = 2.0;
+        for (UInt mip = 1; specular.GetFace(0, mip).width >= 4; ++mip)
+        {
+            const Double contrast = face_average(CubeFace::PositiveZ, mip) - face_average(CubeFace::NegativeZ, mip);
+            CHECK(contrast < previous_contrast);
+            CHECK(contrast > 0.0);
+            previous_contrast = contrast;
+        }
+    }
+
+    SECTION("Prefiltering is identical for serial and uneven parallel splits")
+    {
+        Cubemap parallel;
+        REQUIRE(PrefilterSpecularCubemap(source, settings, parallel, UnevenParallelFor));
+        REQUIRE(parallel.faces.size() == specular.faces.size());
+        for (std::size_t i = 0; i < specular.faces.size(); ++i)
+        {
+            CHECK(parallel.faces[i].pixels == specular.faces[i].pixels);
+        }
+    }
+}
+
+TEST_CASE("Split-sum BRDF LUT never creates energy", "[ImageBasedLighting]")
+{
+    TextureImage lut;
+    REQUIRE(BuildBRDFLUT(32, 256, lut));
+    REQUIRE(lut.width == 32);
+
+    for (UInt y = 0; y < lut.height; ++y)
+    {
+        for (UInt x = 0; x < lut.width; ++x)
+        {
+            const Float* pixel = lut.GetPixel(x, y);
+            CHECK(pixel[0] >= 0.0f);
+            CHECK(pixel[1] >= 0.0f);
+            // F0 = 1 时为镜面反照率，单次散射的微表面 BRDF 不超过 1
+            CHECK(pixel[0] + pixel[1] <= 1.01f);
+        }
+    }
+
+    // 光滑表面正视时几乎全部反射；粗糙表面掠射时多次散射的能量丢失明显
+    Float scale = 0.0f;
+    Float bias = 0.0f;
+    ComputeBRDFIntegration(1.0f, 0.02f, 256, scale, bias);
+    CHECK(std::fabs(scale + bias - 1.0f) < 0.01f);
+    CHECK(bias < 0.01f);
+    ComputeBRDFIntegration(0.05f, 1.0f, 256, scale, bias);
+    CHECK(scale + bias < 0.6f);
+
+    // 与单独积分一致，LUT 的纹素中心为 ((x + 0.5) / size, (y + 0.5) / size)
+    ComputeBRDFIntegration(5.5f / 32.0f, 20.5f / 32.0f, 256, scale, bias);
+    CHECK(lut.GetPixel(5, 20)[0] == scale);
+    CHECK(lut.GetPixel(5, 20)[1] == bias);
+
+    TextureImage parallel;
+    REQUIRE(BuildBRDFLUT(32, 256, parallel, UnevenParallelFor));
+    CHECK(parallel.pixels == lut.pixels);
+
+    CookedTexture cooked;
+    REQUIRE(CookBRDFLUT(lut, cooked));
+    CHECK(cooked.format == BlockFormat::BC5);
+    CHECK(cooked.GetMipCount() == 1);
+    Float decoded[BLOCK_TEXEL_COUNT * 4];
+    REQUIRE(DecodeBlock(BlockFormat::BC5, cooked.mips[0].data() + 16 * (4 * 8 + 1), decoded));
+    for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+    {
+        const Float* pixel = lut.GetPixel(4 + i % 4, 16 + i / 4);
+        CHECK(std::fabs(decoded[i * 4] - pixel[0]) < 0.01f);
+        CHECK(std::fabs(decoded[i * 4 + 1] - pixel[1]) < 0.01f);
+    }
+
+    SECTION("Cache keys change with the source and the settings")
+    {
+        ImageBasedLightingSettings settings;
+        const ULongLong key = ComputeImageBasedLightingCacheKey(1234, settings);
+        CHECK(key == ComputeImageBasedLightingCacheKey(1234, settings));
+        CHECK(key != ComputeImageBasedLightingCacheKey(1235, settings));
+        settings.specular_sample_count *= 2;
+        CHECK(key != ComputeImageBasedLightingCacheKey(1234, settings));
+        const ULongLong lut_key = ComputeBRDFLUTCacheKey(settings);
+        CHECK(lut_key == ComputeBRDFLUTCacheKey(settings));
+        settings.brdf_lut_size = 128;
+        CHECK(lut_key != ComputeBRDFLUTCacheKey(settings));
+    }
+}
@@ -0,0 +1,319 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+#include "dolas_light_clustering.h"
+
+using namespace Dolas;
+using Catch::Matchers::WithinAbs;
+
+namespace
+{
+    constexpr Float kNearPlane = 0.5f;
+    constexpr Float kFarPlane = 200.0f;
+    constexpr Float kAspectRatio = 16.0f / 9.0f;
+
+    Matrix4x4 MakeTestProjection()
+    {
+        return Matrix4x4::Perspective(MathUtil::PI * 0.5f, kAspectRatio, -kFarPlane, -kNearPlane);
+    }
+
+    LightClusterView MakeTestView(const Matrix4x4& view)
+    {
+        const Matrix4x4 projection = MakeTestProjection();
+        LightClusterView cluster_view;
+        cluster_view.view = view;
+        cluster_view.projection_scale_x = projection.data[0][0];
+        cluster_view.projection_scale_y = projection.data[1][1];
+        cluster_view.near_plane = kNearPlane;
+        cluster_view.far_plane = kFarPlane;
+        return cluster_view;
+    }
+
+    // 相机位于 (10, 2, 30)，绕 y 轴转 30 度
+    Matrix4x4 MakeTestViewMatrix()
+    {
+        const Float angle = MathUtil::DegreesToRadians(30.0f);
+        const Float c = std::cos(angle);
+        const Float s = std::sin(angle);
+        const Matrix4x4 camera_to_world(
+            c, 0.0f, s, 10.0f,
+            0.0f, 1.0f, 0.0f, 2.0f,
+            -s, 0.0f, c, 30.0f,
+            0.0f, 0.0f, 0.0f, 1.0f);
+        return camera_to_world.GetInverse();
+    }
+
+    // 点光与聚光各半，分布在相机周围（包括身后和跨越近平面的光源）
+    std::vector<LocalLight> MakeRandomLights(UInt count, UInt seed, const Vector3& center, Float extent)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<Float> position(-extent, extent);
+        std::uniform_real_distribution<Float> range(0.5f, 12.0f);
+        std::uniform_real_distribution<Float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<Float> cone(0.05f, 0.98f);
+
+        std::vector<LocalLight> lights(count);
+        for (UInt i = 0; i < count; ++i)
+        {
+            LocalLight& light = lights[i];
+            light.type = (i % 2 == 0) ? LocalLightType_Point : LocalLightType_Spot;
+            light.position = center + Vector3(position(generator), position(generator) * 0.25f, position(generator));
+            light.range = range(generator);
+            Vector3 direction(unit(generator), unit(generator), unit(generator));
+            light.direction = direction.LengthSquared() > 1.0e-4f ? direction.Normalized() : Vector3::UNIT_Z_NEGATIVE;
+            light.spot_outer_cos = cone(generator);
+            light.spot_inner_cos = std::min(1.0f, light.spot_outer_cos + 0.05f);
+        }
+        return lights;
+    }
+
+    // 按光源下标的连续块分配，模拟渲染管线的并行分块
+    void AssignInChunks(const LightClusterGrid& grid, UInt chunk_count, std::vector<LightClusterRange>& out_ranges, std::vector<UInt>& out_light_indices)
+    {
+        const UInt light_count = grid.GetLightCount();
+        const UInt chunk_size = (light_count + chunk_count - 1) / chunk_count;
+        std::vector<LightClusterChunk> chunks(chunk_count);
+        for (UInt chunk_index = 0; chunk_index < chunk_count; ++chunk_index)
+        {
+            const UInt begin = std::min(chunk_index * chunk_size, light_count);
+            grid.AssignLights(begin, std::min(begin + chunk_size, light_count), chunks[chunk_index]);
+        }
+        grid.BuildLightLists(chunks.data(), chunk_count, out_ranges, out_light_indices);
+    }
+}
+
+TEST_CASE("Spot light bounding sphere encloses the cone", "[LightClustering]")
+{
+    for (Float outer_cos : { 0.99f, 0.9f, 0.75f, 0.5f, 0.1f })
+    {
+        LocalLight light;
+        light.type = LocalLightType_Spot;
+        light.position = Vector3(1.0f, 2.0f, 3.0f);
+        light.direction = Vector3(0.0f, -1.0f, 0.0f);
+        light.range = 10.0f;
+        light.spot_outer_cos = outer_cos;
+
+        const BoundingSphere sphere = light.GetBoundingSphere();
+        REQUIRE(sphere.IsValid());
+        CHECK(sphere.radius <= light.range + 1.0e-4f);
+
+        // 顶点与底面圆周（母线长为 range）都在球内
+        const Float sin_theta = std::sqrt(1.0f - outer_cos * outer_cos);
+        CHECK((light.position - sphere.center).Length() <= sphere.radius + 1.0e-4f);
+        for (UInt i = 0; i < 16; ++i)
+        {
+            const Float phi = MathUtil::PI * 2.0f * i / 16.0f;
+            const Vector3 rim = light.position + Vector3(std::cos(phi) * sin_theta, -outer_cos, std::sin(phi) * sin_theta) * light.range;
+            CHECK((rim - sphere.center).Length() <= sphere.radius + 1.0e-4f);
+        }
+    }
+
+    LocalLight point_light;
+    point_light.range = 4.0f;
+    CHECK(point_light.GetBoundingSphere().radius == 4.0f);
+    point_light.range = 0.0f;
+    CHECK_FALSE(point_light.GetBoundingSphere().IsValid());
+}
+
+TEST_CASE("Cluster slices are exponential and match the shader lookup", "[LightClustering]")
+{
+    LightClusterGrid grid;
+    grid.Setup(LightClusterGridDesc(), MakeTestView(Matrix4x4::IDENTITY));
+    const UInt slice_count = grid.GetDesc().slice_count;
+
+    CHECK(grid.GetSliceNearDepth(0) == kNearPlane);
+    CHECK(grid.GetSliceNearDepth(slice_count) == kFarPlane);
+    const Float ratio = grid.GetSliceNearDepth(1) / grid.GetSliceNearDepth(0);
+    for (UInt slice = 1; slice < slice_count; ++slice)
+    {
+        CHECK_THAT(grid.GetSliceNearDepth(slice + 1) / grid.GetSliceNearDepth(slice), WithinAbs(ratio, 1.0e-4));
+        const Float middle = std::sqrt(grid.GetSliceNearDepth(slice) * grid.GetSliceNearDepth(slice + 1));
+        CHECK(grid.GetSliceIndex(middle) == slice);
+    }
+
+    // 近平面以内和远平面以外钳制到首尾 slice
+    CHECK(grid.GetSliceIndex(0.0f) == 0);
+    CHECK(grid.GetSliceIndex(kFarPlane * 2.0f) == slice_count - 1);
+
+    // 屏幕左上角 / 右下角
+    CHECK(grid.GetClusterIndex(0.0f, 0.0f, kNearPlane) == 0);
+    CHECK(grid.GetClusterIndex(1.0f, 1.0f, kFarPlane) == grid.GetClusterCount() - 1);
+}
+
+TEST_CASE("SIMD cluster assignment matches brute force", "[LightClustering]")
+{
+    const Matrix4x4 view = MakeTestViewMatrix();
+    LightClusterGrid grid;
+    grid.Setup(LightClusterGridDesc(), MakeTestView(view));
+
+    std::vector<LocalLight> lights = MakeRandomLights(3000, 7, Vector3(10.0f, 2.0f, 30.0f), 60.0f);
+    // 包住相机、跨越近平面的光源
+    LocalLight camera_light;
+    camera_light.position = Vector3(10.0f, 2.0f, 30.0f);
+    camera_light.range = 2.0f;
+    lights.push_back(camera_light);
+    grid.PrepareLights(lights.data(), static_cast<UInt>(lights.size()));
+
+    LightClusterChunk fast;
+    LightClusterChunk reference;
+    const UInt fast_count = grid.AssignLights(0, grid.GetLightCount(), fast);
+    const UInt reference_count = grid.AssignLightsBruteForce(0, grid.GetLightCount(), reference);
+
+    REQUIRE(fast_count == reference_count);
+    CHECK(fast.cluster_indices == reference.cluster_indices);
+    CHECK(fast.light_indices == reference.light_indices);
+    CHECK(fast_count > 0);
+
+    // 包住相机的光源覆盖所有 tile 的第一个 slice
+    const UInt camera_light_index = static_cast<UInt>(lights.size() - 1);
+    const UInt camera_light_pairs = static_cast<UInt>(std::count(fast.light_indices.begin(), fast.light_indices.end(), camera_light_index));
+    CHECK(camera_light_pairs >= grid.GetDesc().tiles_x * grid.GetDesc().tiles_y);
+
+    // 分块后合并的结果与单块一致
+    std::vector<LightClusterRange> single_ranges;
+    std::vector<UInt> single_indices;
+    grid.BuildLightLists(&fast, 1, single_ranges, single_indices);
+
+    std::vector<LightClusterRange> chunked_ranges;
+    std::vector<UInt> chunked_indices;
+    AssignInChunks(grid, 7, chunked_ranges, chunked_indices);
+
+    REQUIRE(chunked_ranges.size() == grid.GetClusterCount());
+    CHECK(chunked_indices == single_indices);
+    for (UInt cluster = 0; cluster < grid.GetClusterCount(); ++cluster)
+    {
+        CHECK(chunked_ranges[cluster].offset == single_ranges[cluster].offset);
+        CHECK(chunked_ranges[cluster].count == single_ranges[cluster].count);
+        for (UInt i = 1; i < chunked_ranges[cluster].count; ++i)
+        {
+            CHECK(chunked_indices[chunked_ranges[cluster].offset + i - 1] < chunked_indices[chunked_ranges[cluster].offset + i]);
+        }
+    }
+}
+
+TEST_CASE("Every visible point finds the lights that reach it", "[LightClustering]")
+{
+    const Matrix4x4 view = MakeTestViewMatrix();
+    const Matrix4x4 camera_to_world = view.GetInverse();
+    const Matrix4x4 projection = MakeTestProjection();
+    LightClusterGrid grid;
+    grid.Setup(LightClusterGridDesc(), MakeTestView(view));
+
+    const std::vector<LocalLight> lights = MakeRandomLights(500, 11, Vector3(10.0f, 2.0f, 30.0f), 25.0f);
+    grid.PrepareLights(lights.data(), static_cast<UInt>(lights.size()));
+
+    std::vector<LightClusterRange> ranges;
+    std::vector<UInt> light_indices;
+    AssignInChunks(grid, 3, ranges, light_indices);
+
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<Float> screen(0.0f, 1.0f);
+    std::uniform_real_distribution<Float> log_depth(std::log(kNearPlane), std::log(60.0f));
+    UInt lit_sample_count = 0;
+    for (UInt sample = 0; sample < 4000; ++sample)
+    {
+        const Float u = screen(generator);
+        const Float v = screen(generator);
+        const Float depth = std::exp(log_depth(generator));
+
+        // 由屏幕坐标和深度还原视空间位置，并用投影矩阵确认它确实投影回同一像素
+        const Float ndc_x = u * 2.0f - 1.0f;
+        const Float ndc_y = 1.0f - v * 2.0f;
+        const Vector4 view_position(ndc_x * depth / projection.data[0][0], ndc_y * depth / projection.data[1][1], -depth, 1.0f);
+        const Vector4 clip = projection * view_position;
+        REQUIRE_THAT(clip.x / clip.w, WithinAbs(ndc_x, 1.0e-4));
+        REQUIRE_THAT(clip.y / clip.w, WithinAbs(ndc_y, 1.0e-4));
+
+        const Vector4 world = camera_to_world * view_position;
+        const Vector3 world_position(world.x, world.y, world.z);
+        const LightClusterRange& range = ranges[grid.GetClusterIndex(u, v, depth)];
+        const UInt* cluster_begin = light_indices.data() + range.offset;
+        const UInt* cluster_end = cluster_begin + range.count;
+
+        for (UInt light_index = 0; light_index < lights.size(); ++light_index)
+        {
+            const LocalLight& light = lights[light_index];
+            const Vector3 to_point = world_position - light.position;
+            Bool reaches = to_point.Length() < light.range * 0.999f;
+            if (reaches && light.type == LocalLightType_Spot && to_point.Length() > 1.0e-4f)
+            {
+                reaches = to_point.Normalized().Dot(light.direction) > light.spot_outer_cos + 1.0e-4f;
+            }
+            if (reaches)
+            {
+                ++lit_sample_count;
+                CHECK(std::find(cluster_begin, cluster_end, light_index) != cluster_end);
+            }
+        }
+    }
+    CHECK(lit_sample_count > 0);
+}
+
+TEST_CASE("Clustered light assignment 10k lights", "[.][benchmark][LightClustering]")
+{
+    constexpr UInt kLightCount = 10000;
+    const Matrix4x4 view = MakeTestViewMatrix();
+    LightClusterGrid grid;
+    grid.Setup(LightClusterGridDesc(), MakeTestView(view));
+    const std::vector<LocalLight> lights = MakeRandomLights(kLightCount, 5, Vector3(10.0f, 2.0f, 30.0f), 150.0f);
+
+    BENCHMARK("prepare lights")
+    {
+        grid.PrepareLights(lights.data(), kLightCount);
+        return grid.GetLightCount();
+    };
+
+    grid.PrepareLights(lights.data(), kLightCount);
+    LightClusterChunk chunk;
+
+    BENCHMARK("brute force")
+    {
+        chunk.Clear();
+        return grid.AssignLightsBruteForce(0, kLightCount, chunk);
+    };
+
+    BENCHMARK("simd")
+    {
+        chunk.Clear();
+        return grid.AssignLights(0, kLightCount, chunk);
+    };
+
+    std::vector<LightClusterRange> ranges;
+    std::vector<UInt> light_indices;
+    BENCHMARK("simd + build lists")
+    {
+        chunk.Clear();
+        grid.AssignLights(0, kLightCount, chunk);
+        grid.BuildLightLists(&chunk, 1, ranges, light_indices);
+        return light_indices.size();
+    };
+
+    const UInt thread_count = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<LightClusterChunk> chunks(thread_count);
+    BENCHMARK("simd parallel + build lists")
+    {
+        const UInt chunk_size = (kLightCount + thread_count - 1) / thread_count;
+        std::vector<std::thread> threads;
+        for (UInt thread_index = 0; thread_index < thread_count; ++thread_index)
+        {
+            threads.emplace_back([&, thread_index]()
+            {
+                const UInt begin = std::min(thread_index * chunk_size, kLightCount);
+                const UInt end = std::min(begin + chunk_size, kLightCount);
+                chunks[thread_index].Clear();
+                grid.AssignLights(begin, end, chunks[thread_index]);
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        grid.BuildLightLists(chunks.data(), thread_count, ranges, light_indices);
+        return light_indices.size();
+    };
+}
@@ -0,0 +1,241 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cmath>
+#include <vector>
+#include "dolas_mesh_lod.h"
+#include "mesh_test_helpers.h"
+
+using namespace Dolas;
+using Catch::Matchers::WithinAbs;
+
+namespace
+{
+    // XZ 平面上的 n x n 网格，四周是开放边界
+    TestMesh MakeGrid(UInt n)
+    {
+        TestMesh mesh;
+        for (UInt z = 0; z <= n; ++z)
+        {
+            for (UInt x = 0; x <= n; ++x)
+            {
+                mesh.positions.insert(mesh.positions.end(), { static_cast<Float>(x), 0.0f, static_cast<Float>(z) });
+            }
+        }
+        for (UInt z = 0; z < n; ++z)
+        {
+            for (UInt x = 0; x < n; ++x)
+            {
+                const UInt a = z * (n + 1) + x;
+                mesh.indices.insert(mesh.indices.end(), { a, a + n + 1, a + 1, a + 1, a + n + 1, a + n + 2 });
+            }
+        }
+        return mesh;
+    }
+
+    Bool HasDegenerateTriangle(const std::vector<UInt>& indices)
+    {
+        for (std::size_t i = 0; i < indices.size(); i += 3)
+        {
+            if (indices[i] == indices[i + 1] || indices[i + 1] == indices[i + 2] || indices[i] == indices[i + 2]) return true;
+        }
+        return false;
+    }
+}
+
+TEST_CASE("SimplifyMesh reduces a closed sphere within the error bound", "[MeshLOD]")
+{
+    const TestMesh sphere = MakeWeldedSphere(2.0f, 32, 64);
+    const UInt target_index_count = static_cast<UInt>(sphere.indices.size() / 4) / 3 * 3;
+
+    std::vector<UInt> simplified;
+    const Float error = SimplifyMesh(sphere.positions.data(), sphere.GetVertexCount(), 3, sphere.indices, target_index_count, 1.0f, simplified);
+
+    REQUIRE(simplified.size() % 3 == 0);
+    REQUIRE(simplified.size() <= target_index_count);
+    REQUIRE(simplified.size() > target_index_count / 2);
+    REQUIRE_FALSE(HasDegenerateTriangle(simplified));
+    REQUIRE(error > 0.0f);
+    REQUIRE(error < 0.02f);
+
+    // 只折叠到已有顶点，所有顶点仍在球面上，三角形也不会向内塌陷或翻转
+    auto facing = [&sphere](const std::vector<UInt>& indices, std::size_t i)
+    {
+        const Vector3 p0 = sphere.GetPosition(indices[i]);
+        const Vector3 p1 = sphere.GetPosition(indices[i + 1]);
+        const Vector3 p2 = sphere.GetPosition(indices[i + 2]);
+        return (p1 - p0).Cross(p2 - p0).Dot(p0 + p1 + p2) > 0.0f;
+    };
+    const Bool original_facing = facing(sphere.indices, 0);
+    for (std::size_t i = 0; i < simplified.size(); i += 3)
+    {
+        REQUIRE(simplified[i] < sphere.GetVertexCount());
+        const Vector3 p0 = sphere.GetPosition(simplified[i]);
+        const Vector3 p1 = sphere.GetPosition(simplified[i + 1]);
+        const Vector3 p2 = sphere.GetPosition(simplified[i + 2]);
+        const Vector3 centroid = (p0 + p1 + p2) * (1.0f / 3.0f);
+        REQUIRE(centroid.Length() > 1.6f);
+        REQUIRE(facing(simplified, i) == original_facing);
+    }
+
+    SECTION("target error stops simplification early")
+    {
+        std::vector<UInt> conservative;
+        const Float conservative_error = SimplifyMesh(sphere.positions.data(), sphere.GetVertexCount(), 3, sphere.indices, 0, 0.001f, conservative);
+        REQUIRE(conservative_error <= 0.001f);
+        REQUIRE(conservative.size() > simplified.size());
+        REQUIRE(conservative.size() < sphere.indices.size());
+    }
+}
+
+TEST_CASE("SimplifyMesh keeps open borders and collapses flat interiors", "[MeshLOD]")
+{
+    const UInt n = 16;
+    const TestMesh grid = MakeGrid(n);
+
+    std::vector<UInt> simplified;
+    const Float error = SimplifyMesh(grid.positions.data(), grid.GetVertexCount(), 3, grid.indices, 0, 0.01f, simplified);
+    REQUIRE_THAT(error, WithinAbs(0.0f, 1e-6f));
+    REQUIRE_FALSE(HasDegenerateTriangle(simplified));
+
+    // 边界 4n 个顶点全部锁定，内部完全平坦，最终只剩三角化边界多边形所需的三角形
+    REQUIRE(simplified.size() / 3 < grid.indices.size() / 3 / 4);
+
+    std::vector<Bool> used(grid.GetVertexCount(), false);
+    for (UInt index : simplified) used[index] = true;
+    for (UInt i = 0; i <= n; ++i)
+    {
+        REQUIRE(used[i]);
+        REQUIRE(used[n * (n + 1) + i]);
+        REQUIRE(used[i * (n + 1)]);
+        REQUIRE(used[i * (n + 1) + n]);
+    }
+
+    // 总面积不变
+    Float area = 0.0f;
+    for (std::size_t i = 0; i < simplified.size(); i += 3)
+    {
+        const Vector3 p0 = grid.GetPosition(simplified[i]);
+        area += (grid.GetPosition(simplified[i + 1]) - p0).Cross(grid.GetPosition(simplified[i + 2]) - p0).Length() * 0.5f;
+    }
+    REQUIRE_THAT(area, WithinAbs(static_cast<Float>(n * n), 1e-3f));
+}
+
+TEST_CASE("SimplifyMesh locks seam vertices", "[MeshLOD]")
+{
+    // 复制一列顶点形成接缝：右半边的三角形引用副本
+    const UInt n = 8;
+    TestMesh grid = MakeGrid(n);
+    const UInt seam_column = n / 2;
+    std::vector<UInt> duplicates(n + 1);
+    for (UInt z = 0; z <= n; ++z)
+    {
+        const Vector3 p = grid.GetPosition(z * (n + 1) + seam_column);
+        duplicates[z] = grid.GetVertexCount();
+        grid.positions.insert(grid.positions.end(), { p.x, p.y, p.z });
+    }
+    for (std::size_t i = 0; i < grid.indices.size(); i += 3)
+    {
+        const Float centroid_x = (grid.GetPosition(grid.indices[i]).x + grid.GetPosition(grid.indices[i + 1]).x + grid.GetPosition(grid.indices[i + 2]).x) / 3.0f;
+        if (centroid_x < seam_column) continue;
+        for (UInt c = 0; c < 3; ++c)
+        {
+            UInt& index = grid.indices[i + c];
+            if (index < (n + 1) * (n + 1) && index % (n + 1) == seam_column) index = duplicates[index / (n + 1)];
+        }
+    }
+
+    std::vector<UInt> simplified;
+    SimplifyMesh(grid.positions.data(), grid.GetVertexCount(), 3, grid.indices, 0, 0.01f, simplified);
+    std::vector<Bool> used(grid.GetVertexCount(), false);
+    for (UInt index : simplified) used[index] = true;
+    for (UInt z = 0; z <= n; ++z)
+    {
+        REQUIRE(used[z * (n + 1) + seam_column]);
+        REQUIRE(used[duplicates[z]]);
+    }
+}
+
+TEST_CASE("GenerateMeshLODChain produces decreasing detail", "[MeshLOD]")
+{
+    const TestMesh sphere = MakeWeldedSphere(1.0f, 48, 96);
+    MeshLODChainSettings settings;
+    settings.max_lod_count = 4;
+    const std::vector<MeshLOD> lods = GenerateMeshLODChain(sphere.positions.data(), sphere.GetVertexCount(), 3, sphere.indices, settings);
+
+    REQUIRE(lods.size() == 4);
+    std::size_t previous_count = sphere.indices.size();
+    Float previous_error = 0.0f;
+    Float previous_screen_size = DOLAS_FLOAT_MAX;
+    for (const MeshLOD& lod : lods)
+    {
+        REQUIRE(lod.indices.size() <= previous_count * settings.min_reduction);
+        REQUIRE(lod.error >= previous_error);
+        REQUIRE(lod.error <= settings.max_error * settings.max_lod_count);
+        REQUIRE(lod.screen_size < previous_screen_size);
+        REQUIRE_FALSE(HasDegenerateTriangle(lod.indices));
+        previous_count = lod.indices.size();
+        previous_error = lod.error;
+        previous_screen_size = lod.screen_size;
+    }
+    REQUIRE(lods[0].screen_size == settings.first_screen_size);
+
+    // 已经足够粗的网格不再生成 LOD
+    const TestMesh tetrahedron{ { 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 0, 2, 1, 0, 1, 3, 0, 3, 2, 1, 2, 3 } };
+    REQUIRE(GenerateMeshLODChain(tetrahedron.positions.data(), 4, 3, tetrahedron.indices).empty());
+}
+
+TEST_CASE("SelectMeshLOD applies hysteresis around thresholds", "[MeshLOD]")
+{
+    const Float screen_sizes[] = { 0.0f, 0.5f, 0.25f, 0.125f };
+    const Float hysteresis = 0.1f;
+
+    REQUIRE(SelectMeshLOD(1.0f, screen_sizes, 4, 0, hysteresis) == 0);
+    REQUIRE(SelectMeshLOD(0.46f, screen_sizes, 4, 0, hysteresis) == 0);
+    REQUIRE(SelectMeshLOD(0.44f, screen_sizes, 4, 0, hysteresis) == 1);
+    REQUIRE(SelectMeshLOD(0.52f, screen_sizes, 4, 1, hysteresis) == 1);
+    REQUIRE(SelectMeshLOD(0.56f, screen_sizes, 4, 1, hysteresis) == 0);
+    REQUIRE(SelectMeshLOD(0.01f, screen_sizes, 4, 0, hysteresis) == 3);
+    REQUIRE(SelectMeshLOD(10.0f, screen_sizes, 4, 3, hysteresis) == 0);
+    REQUIRE(SelectMeshLOD(0.01f, screen_sizes, 1, 2, hysteresis) == 0);
+
+    // 在阈值附近来回抖动不会切换
+    UInt lod = 0;
+    for (UInt frame = 0; frame < 100; ++frame)
+    {
+        lod = SelectMeshLOD(frame % 2 == 0 ? 0.48f : 0.52f, screen_sizes, 4, lod, hysteresis);
+        REQUIRE(lod == 0);
+    }
+}
+
+TEST_CASE("ComputeScreenSize follows projected sphere diameter", "[MeshLOD]")
+{
+    const Float projection_scale = 1.0f / std::tan(MathUtil::PI * 0.25f);
+    REQUIRE_THAT(ComputeScreenSize(BoundingSphere(Vector3(0.0f, 0.0f, -10.0f), 1.0f), Vector3::ZERO, projection_scale), WithinAbs(0.1f, 1e-5f));
+    REQUIRE_THAT(ComputeScreenSize(BoundingSphere(Vector3(0.0f, 0.0f, -20.0f), 1.0f), Vector3::ZERO, projection_scale), WithinAbs(0.05f, 1e-5f));
+    REQUIRE(ComputeScreenSize(BoundingSphere(Vector3(0.0f, 0.0f, -0.5f), 1.0f), Vector3::ZERO, projection_scale) == DOLAS_FLOAT_MAX);
+}
+
+TEST_CASE("ComputeOrthographicScreenSize ignores distance", "[MeshLOD]")
+{
+    REQUIRE_THAT(ComputeOrthographicScreenSize(BoundingSphere(Vector3(0.0f, 0.0f, -10.0f), 1.0f), 20.0f), WithinAbs(0.05f, 1e-6f));
+    REQUIRE_THAT(ComputeOrthographicScreenSize(BoundingSphere(Vector3(0.0f, 0.0f, -90.0f), 1.0f), 20.0f), WithinAbs(0.05f, 1e-6f));
+    REQUIRE(ComputeOrthographicScreenSize(BoundingSphere(Vector3::ZERO, 1.0f), 0.0f) == DOLAS_FLOAT_MAX);
+
+    // 阴影 cascade 不保留上一帧的 LOD，从 LOD0 出发、不加滞回地选择
+    const Float lod_screen_sizes[3] = { 0.0f, 0.5f, 0.25f };
+    REQUIRE(SelectMeshLOD(ComputeOrthographicScreenSize(BoundingSphere(Vector3::ZERO, 1.0f), 1.5f), lod_screen_sizes, 3, 0, 0.0f) == 0);
+    REQUIRE(SelectMeshLOD(ComputeOrthographicScreenSize(BoundingSphere(Vector3::ZERO, 1.0f), 3.0f), lod_screen_sizes, 3, 0, 0.0f) == 1);
+    REQUIRE(SelectMeshLOD(ComputeOrthographicScreenSize(BoundingSphere(Vector3::ZERO, 1.0f), 10.0f), lod_screen_sizes, 3, 0, 0.0f) == 2);
+}
+
+TEST_CASE("SimplifyMesh throughput", "[.][benchmark][MeshLOD]")
+{
+    const TestMesh sphere = MakeWeldedSphere(1.0f, 256, 512);
+    BENCHMARK("simplify 260k triangles to 25%")
+    {
+        std::vector<UInt> simplified;
+        SimplifyMesh(sphere.positions.data(), sphere.GetVertexCount(), 3, sphere.indices, static_cast<UInt>(sphere.indices.size() / 4), 1.0f, simplified);
+        return simplified.size();
+    };
+}
@@ -0,0 +1,59 @@
+#ifndef DOLAS_MESH_TEST_HELPERS_H
+#define DOLAS_MESH_TEST_HELPERS_H
+
+#include <cmath>
+#include <vector>
+#include "dolas_math.h"
+
+// 网格简化与 meshlet 测试共用的索引网格与经纬球
+namespace Dolas
+{
+    struct TestMesh
+    {
+        std::vector<Float> positions;
+        std::vector<UInt> indices;
+
+        UInt GetVertexCount() const { return static_cast<UInt>(positions.size() / 3); }
+        Vector3 GetPosition(UInt index) const { return Vector3(positions[index * 3], positions[index * 3 + 1], positions[index * 3 + 2]); }
+    };
+
+    // 顶点完全共享的经纬球（两极各一个顶点，经线接缝不重复），是没有边界和接缝的闭合流形
+    inline TestMesh MakeWeldedSphere(Float radius, UInt rings, UInt segments)
+    {
+        TestMesh mesh;
+        auto add_vertex = [&mesh](const Vector3& p) { mesh.positions.insert(mesh.positions.end(), { p.x, p.y, p.z }); };
+        add_vertex(Vector3(0.0f, radius, 0.0f));
+        for (UInt ring = 1; ring < rings; ++ring)
+        {
+            const Float theta = MathUtil::PI * ring / rings;
+            for (UInt segment = 0; segment < segments; ++segment)
+            {
+                const Float phi = 2.0f * MathUtil::PI * segment / segments;
+                add_vertex(Vector3(radius * std::sin(theta) * std::cos(phi), radius * std::cos(theta), radius * std::sin(theta) * std::sin(phi)));
+            }
+        }
+        add_vertex(Vector3(0.0f, -radius, 0.0f));
+
+        const UInt south_pole = mesh.GetVertexCount() - 1;
+        auto ring_vertex = [segments](UInt ring, UInt segment) { return 1 + (ring - 1) * segments + segment % segments; };
+        for (UInt segment = 0; segment < segments; ++segment)
+        {
+            mesh.indices.insert(mesh.indices.end(), { 0, ring_vertex(1, segment + 1), ring_vertex(1, segment) });
+            mesh.indices.insert(mesh.indices.end(), { south_pole, ring_vertex(rings - 1, segment), ring_vertex(rings - 1, segment + 1) });
+        }
+        for (UInt ring = 1; ring + 1 < rings; ++ring)
+        {
+            for (UInt segment = 0; segment < segments; ++segment)
+            {
+                const UInt a = ring_vertex(ring, segment);
+                const UInt b = ring_vertex(ring, segment + 1);
+                const UInt c = ring_vertex(ring + 1, segment);
+                const UInt d = ring_vertex(ring + 1, segment + 1);
+                mesh.indices.insert(mesh.indices.end(), { a, b, c, b, d, c });
+            }
+        }
+        return mesh;
+    }
+}
+
+#endif // DOLAS_MESH_TEST_HELPERS_H
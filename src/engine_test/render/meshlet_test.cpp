@@ -0,0 +1,216 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "dolas_meshlet.h"
+#include "mesh_test_helpers.h"
+
+using namespace Dolas;
+
+namespace
+{
+    Vector3 TriangleNormal(const TestMesh& mesh, UInt i0, UInt i1, UInt i2)
+    {
+        const Vector3 p0 = mesh.GetPosition(i0);
+        return (mesh.GetPosition(i1) - p0).Cross(mesh.GetPosition(i2) - p0);
+    }
+
+    // 旋转到最小下标在前，保持绕序，便于比较三角形集合
+    std::array<UInt, 3> CanonicalTriangle(UInt a, UInt b, UInt c)
+    {
+        if (b < a && b < c) return { b, c, a };
+        if (c < a && c < b) return { c, a, b };
+        return { a, b, c };
+    }
+
+    std::vector<std::array<UInt, 3>> SortedTriangles(const std::vector<UInt>& indices)
+    {
+        std::vector<std::array<UInt, 3>> triangles;
+        for (std::size_t i = 0; i < indices.size(); i += 3)
+        {
+            triangles.push_back(CanonicalTriangle(indices[i], indices[i + 1], indices[i + 2]));
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    // 位于 camera_position、朝 -Z 看的透视相机，90 度视角
+    Frustum MakeFrustumLookingDownZ(const Vector3& camera_position)
+    {
+        const Matrix4x4 view = Pose(Vector3(-camera_position.x, -camera_position.y, -camera_position.z), Quaternion::IDENTITY, Vector3(1.0f, 1.0f, 1.0f)).ToMatrix();
+        const Matrix4x4 projection = Matrix4x4::Perspective(MathUtil::PI * 0.5f, 1.0f, -100.0f, -0.1f);
+        return Frustum::FromViewProjection(projection * view);
+    }
+}
+
+TEST_CASE("BuildMeshlets respects limits and covers every triangle once", "[Meshlet]")
+{
+    const TestMesh sphere = MakeWeldedSphere(1.0f, 48, 96);
+    MeshletData meshlet_data;
+    REQUIRE(BuildMeshlets(sphere.positions.data(), sphere.GetVertexCount(), 3, sphere.indices, meshlet_data));
+    REQUIRE_FALSE(meshlet_data.IsEmpty());
+    REQUIRE(meshlet_data.GetTriangleCount() == sphere.indices.size() / 3);
+
+    std::vector<UInt> expanded;
+    for (const Meshlet& meshlet : meshlet_data.meshlets)
+    {
+        REQUIRE(meshlet.vertex_count <= kMeshletMaxVertices);
+        REQUIRE(meshlet.triangle_count <= kMeshletMaxTriangles);
+        REQUIRE(meshlet.triangle_count > 0);
+
+        for (UInt t = 0; t < meshlet.triangle_count * 3; ++t)
+        {
+            const UByte local = meshlet_data.triangles[meshlet.triangle_offset * 3 + t];
+            REQUIRE(local < meshlet.vertex_count);
+            expanded.push_back(meshlet_data.vertices[meshlet.vertex_offset + local]);
+        }
+        for (UInt v = 0; v < meshlet.vertex_count; ++v)
+        {
+            const Vector3 p = sphere.GetPosition(meshlet_data.vertices[meshlet.vertex_offset + v]);
+            REQUIRE((p - meshlet.bounds.center).Length() <= meshlet.bounds.radius * 1.0001f + 1e-6f);
+        }
+    }
+    REQUIRE(SortedTriangles(expanded) == SortedTriangles(sphere.indices));
+
+    // 贪心生长得到的 meshlet 应接近填满
+    const Float average_triangles = static_cast<Float>(meshlet_data.GetTriangleCount()) / meshlet_data.meshlets.size();
+    REQUIRE(average_triangles > kMeshletMaxTriangles * 0.7f);
+
+    SECTION("deterministic")
+    {
+        MeshletData again;
+        REQUIRE(BuildMeshlets(sphere.positions.data(), sphere.GetVertexCount(), 3, sphere.indices, again));
+        REQUIRE(again.vertices == meshlet_data.vertices);
+        REQUIRE(again.triangles == meshlet_data.triangles);
+    }
+
+    SECTION("custom limits")
+    {
+        MeshletData small;
+        REQUIRE(BuildMeshlets(sphere.positions.data(), sphere.GetVertexCount(), 3, sphere.indices, small, 32, 40));
+        for (const Meshlet& meshlet : small.meshlets)
+        {
+            REQUIRE(meshlet.vertex_count <= 32);
+            REQUIRE(meshlet.triangle_count <= 40);
+        }
+        REQUIRE(small.GetTriangleCount() == sphere.indices.size() / 3);
+    }
+
+    SECTION("invalid input")
+    {
+        MeshletData invalid;
+        std::vector<UInt> out_of_range = { 0, 1, sphere.GetVertexCount() };
+        REQUIRE_FALSE(BuildMeshlets(sphere.positions.data(), sphere.GetVertexCount(), 3, out_of_range, invalid));
+        REQUIRE_FALSE(BuildMeshlets(sphere.positions.data(), sphere.GetVertexCount(), 3, sphere.indices, invalid, 300, 124));
+    }
+}
+
+TEST_CASE("Meshlet normal cones are conservative", "[Meshlet]")
+{
+    const TestMesh sphere = MakeWeldedSphere(1.0f, 32, 64);
+    MeshletData meshlet_data;
+    REQUIRE(BuildMeshlets(sphere.positions.data(), sphere.GetVertexCount(), 3, sphere.indices, meshlet_data));
+
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<Float> coordinate(-6.0f, 6.0f);
+    UInt culled_count = 0;
+    UInt tested_count = 0;
+    for (UInt sample = 0; sample < 200; ++sample)
+    {
+        const Vector3 camera(coordinate(generator), coordinate(generator), coordinate(generator));
+        for (const Meshlet& meshlet : meshlet_data.meshlets)
+        {
+            ++tested_count;
+            if (!IsMeshletBackfacing(meshlet, camera)) continue;
+            ++culled_count;
+
+            // 被判为背面的 meshlet 中每个三角形都必须背向相机
+            for (UInt t = 0; t < meshlet.triangle_count; ++t)
+            {
+                const UByte* local = &meshlet_data.triangles[(meshlet.triangle_offset + t) * 3];
+                const UInt i0 = meshlet_data.vertices[meshlet.vertex_offset + local[0]];
+                const UInt i1 = meshlet_data.vertices[meshlet.vertex_offset + local[1]];
+                const UInt i2 = meshlet_data.vertices[meshlet.vertex_offset + local[2]];
+                REQUIRE(TriangleNormal(sphere, i0, i1, i2).Dot(camera - sphere.GetPosition(i0)) <= 1e-6f);
+            }
+        }
+    }
+    // 从球外看大约一半的表面背向相机，锥体剔除应能去掉其中相当一部分
+    REQUIRE(culled_count > tested_count / 5);
+}
+
+TEST_CASE("CullMeshlets emits a compacted index list of visible clusters", "[Meshlet]")
+{
+    const TestMesh sphere = MakeWeldedSphere(1.0f, 48, 96);
+    MeshletData meshlet_data;
+    REQUIRE(BuildMeshlets(sphere.positions.data(), sphere.GetVertexCount(), 3, sphere.indices, meshlet_data));
+
+    SECTION("front-facing triangles are kept")
+    {
+        const Vector3 camera(0.0f, 0.0f, 5.0f);
+        std::vector<UInt> indices = { 7, 7, 7 }; // 追加而不是覆盖
+        const MeshletCullingResult result = CullMeshlets(meshlet_data, Matrix4x4::IDENTITY, MakeFrustumLookingDownZ(camera), camera, true, indices);
+
+        REQUIRE(result.index_count == indices.size() - 3);
+        REQUIRE(result.frustum_culled_count == 0);
+        REQUIRE(result.backface_culled_count > 0);
+        REQUIRE(result.visible_meshlet_count + result.backface_culled_count == meshlet_data.meshlets.size());
+        REQUIRE(result.index_count < sphere.indices.size() * 3 / 4);
+
+        const std::vector<UInt> emitted(indices.begin() + 3, indices.end());
+        const auto emitted_triangles = SortedTriangles(emitted);
+        for (std::size_t i = 0; i < sphere.indices.size(); i += 3)
+        {
+            const UInt i0 = sphere.indices[i];
+            const UInt i1 = sphere.indices[i + 1];
+            const UInt i2 = sphere.indices[i + 2];
+            if (TriangleNormal(sphere, i0, i1, i2).Dot(camera - sphere.GetPosition(i0)) > 0.0f)
+            {
+                REQUIRE(std::binary_search(emitted_triangles.begin(), emitted_triangles.end(), CanonicalTriangle(i0, i1, i2)));
+            }
+        }
+    }
+
+    SECTION("backface culling can be disabled")
+    {
+        const Vector3 camera(0.0f, 0.0f, 5.0f);
+        std::vector<UInt> indices;
+        const MeshletCullingResult result = CullMeshlets(meshlet_data, Matrix4x4::IDENTITY, MakeFrustumLookingDownZ(camera), camera, false, indices);
+        REQUIRE(result.backface_culled_count == 0);
+        REQUIRE(indices.size() == sphere.indices.size());
+    }
+
+    SECTION("world transform moves clusters out of the frustum")
+    {
+        const Vector3 camera(0.0f, 0.0f, 5.0f);
+        const Matrix4x4 world = Pose(Vector3(0.0f, 0.0f, 200.0f), Quaternion::IDENTITY, Vector3(1.0f, 1.0f, 1.0f)).ToMatrix();
+        std::vector<UInt> indices;
+        const MeshletCullingResult result = CullMeshlets(meshlet_data, world, MakeFrustumLookingDownZ(camera), camera, true, indices);
+        REQUIRE(result.frustum_culled_count == meshlet_data.meshlets.size());
+        REQUIRE(indices.empty());
+    }
+}
+
+TEST_CASE("Meshlet build and cull throughput", "[.][benchmark][Meshlet]")
+{
+    const TestMesh sphere = MakeWeldedSphere(1.0f, 256, 512);
+    MeshletData meshlet_data;
+    BENCHMARK("build 260k triangles")
+    {
+        BuildMeshlets(sphere.positions.data(), sphere.GetVertexCount(), 3, sphere.indices, meshlet_data);
+        return meshlet_data.meshlets.size();
+    };
+
+    const Vector3 camera(0.0f, 0.5f, 3.0f);
+    const Frustum frustum = MakeFrustumLookingDownZ(camera);
+    std::vector<UInt> indices;
+    indices.reserve(sphere.indices.size());
+    BENCHMARK("cull and compact")
+    {
+        indices.clear();
+        return CullMeshlets(meshlet_data, Matrix4x4::IDENTITY, frustum, camera, true, indices).index_count;
+    };
+}
@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include "dolas_pipeline_cache.h"
+
+using namespace Dolas;
+
+namespace
+{
+    PipelineStateRecord MakeRecord(const std::string& pixel_shader_path, UInt render_target_count)
+    {
+        PipelineStateRecord record;
+        record.vertex_shader_path = "shader/opaque/opaque_vs.hlsl";
+        record.vertex_entry_point = "VS";
+        record.pixel_shader_path = pixel_shader_path;
+        record.pixel_entry_point = "PS";
+        record.input_layout = 2;
+        record.rasterizer_state = 1;
+        record.depth_stencil_state = 3;
+        record.blend_state = 0;
+        record.primitive_topology = 0;
+        record.render_target_count = render_target_count;
+        for (UInt i = 0; i < render_target_count; ++i)
+        {
+            record.render_target_formats[i] = 28 + i;
+        }
+        record.depth_stencil_format = 45;
+        return record;
+    }
+
+    std::string GetTempCachePath(const char* file_name)
+    {
+        return (std::filesystem::temp_directory_path() / file_name).string();
+    }
+}
+
+// ============ Pipeline State Key Tests ============
+
+TEST_CASE("ComputePipelineStateKey depends on bytecode content and state, not shader paths", "[PipelineCache][key]")
+{
+    PipelineStateRecord a = MakeRecord("shader/opaque/opaque_ps.hlsl", 4);
+    PipelineStateRecord b = MakeRecord("shader/other/other_ps.hlsl", 4);
+    REQUIRE(ComputePipelineStateKey(1, 2, a) == ComputePipelineStateKey(1, 2, b));
+    REQUIRE(ComputePipelineStateKey(1, 2, a) != ComputePipelineStateKey(1, 3, a));
+    REQUIRE(ComputePipelineStateKey(1, 2, a) != ComputePipelineStateKey(2, 1, a));
+
+    PipelineStateRecord c = a;
+    c.blend_state = 1;
+    REQUIRE(ComputePipelineStateKey(1, 2, a) != ComputePipelineStateKey(1, 2, c));
+}
+
+TEST_CASE("ComputePipelineStateKey ignores formats beyond render_target_count", "[PipelineCache][key]")
+{
+    PipelineStateRecord a = MakeRecord("shader/opaque/opaque_ps.hlsl", 1);
+    PipelineStateRecord b = a;
+    b.render_target_formats[3] = 99;
+    REQUIRE(ComputePipelineStateKey(1, 2, a) == ComputePipelineStateKey(1, 2, b));
+
+    b.render_target_formats[0] = 99;
+    REQUIRE(ComputePipelineStateKey(1, 2, a) != ComputePipelineStateKey(1, 2, b));
+}
+
+// ============ PipelineCacheFile Tests ============
+
+TEST_CASE("PipelineCacheFile ignores duplicate records", "[PipelineCache][file]")
+{
+    PipelineCacheFile cache;
+    REQUIRE(cache.AddRecord(MakeRecord("shader/opaque/opaque_ps.hlsl", 4)));
+    REQUIRE_FALSE(cache.AddRecord(MakeRecord("shader/opaque/opaque_ps.hlsl", 4)));
+    REQUIRE(cache.AddRecord(MakeRecord("shader/opaque/opaque_ps.hlsl", 1)));
+    REQUIRE(cache.GetRecords().size() == 2);
+    REQUIRE(cache.IsDirty());
+}
+
+TEST_CASE("PipelineCacheFile save and load round trip", "[PipelineCache][file]")
+{
+    const std::string path = GetTempCachePath("dolas_pipeline_cache_round_trip.bin");
+    const ULongLong device_identity = 0x1234ABCDull;
+
+    PipelineCacheFile cache;
+    cache.AddRecord(MakeRecord("shader/opaque/opaque_ps.hlsl", 4));
+    cache.AddRecord(MakeRecord("shader/solid/solid_ps.hlsl", 1));
+    cache.SetLibraryBlob({ 1, 2, 3, 4, 5, 250 });
+    REQUIRE(cache.Save(path, device_identity));
+    REQUIRE(cache.IsDirty());
+    cache.MarkSaved();
+    REQUIRE_FALSE(cache.IsDirty());
+
+    PipelineCacheFile loaded;
+    REQUIRE(loaded.Load(path, device_identity));
+    REQUIRE_FALSE(loaded.IsDirty());
+    REQUIRE(loaded.GetRecords().size() == 2);
+    REQUIRE(loaded.GetRecords()[0] == cache.GetRecords()[0]);
+    REQUIRE(loaded.GetRecords()[1] == cache.GetRecords()[1]);
+    REQUIRE(loaded.GetLibraryBlob() == cache.GetLibraryBlob());
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("PipelineCacheFile rejects other devices and corrupted data", "[PipelineCache][file]")
+{
+    const std::string path = GetTempCachePath("dolas_pipeline_cache_invalid.bin");
+
+    PipelineCacheFile cache;
+    cache.AddRecord(MakeRecord("shader/opaque/opaque_ps.hlsl", 4));
+    cache.SetLibraryBlob({ 9, 8, 7 });
+    REQUIRE(cache.Save(path, 1));
+
+    PipelineCacheFile loaded;
+    REQUIRE_FALSE(loaded.Load(path, 2));
+    REQUIRE(loaded.GetRecords().empty());
+
+    // 翻转最后一个字节，payload 校验应失败
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekg(-1, std::ios::end);
+        char last = 0;
+        file.read(&last, 1);
+        file.seekp(-1, std::ios::end);
+        last = static_cast<char>(last ^ 0xFF);
+        file.write(&last, 1);
+    }
+    REQUIRE_FALSE(loaded.Load(path, 1));
+    REQUIRE(loaded.GetLibraryBlob().empty());
+
+    REQUIRE_FALSE(loaded.Load(GetTempCachePath("dolas_pipeline_cache_missing.bin"), 1));
+
+    std::filesystem::remove(path);
+}
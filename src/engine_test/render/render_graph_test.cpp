@@ -0,0 +1,434 @@
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+#include "dolas_render_graph.h"
+
+using namespace Dolas;
+
+namespace
+{
+    constexpr ULongLong kTextureSize = 8ull * 1024 * 1024;
+
+    RenderGraphTextureDesc MakeDesc(ULongLong size = kTextureSize, ULongLong alignment = 65536)
+    {
+        RenderGraphTextureDesc desc;
+        desc.size = size;
+        desc.alignment = alignment;
+        return desc;
+    }
+
+    const RenderGraphCompiledPass* FindCompiledPass(const RenderGraphCompileResult& result, RenderGraphPassHandle pass)
+    {
+        for (const RenderGraphCompiledPass& compiled : result.passes)
+        {
+            if (compiled.pass == pass) return &compiled;
+        }
+        return nullptr;
+    }
+
+    std::vector<RenderGraphBarrier> FilterBarriers(const std::vector<RenderGraphBarrier>& barriers, RenderGraphBarrierType type)
+    {
+        std::vector<RenderGraphBarrier> filtered;
+        for (const RenderGraphBarrier& barrier : barriers)
+        {
+            if (barrier.type == type) filtered.push_back(barrier);
+        }
+        return filtered;
+    }
+
+    Bool Overlaps(const RenderGraphResourceAllocation& a, const RenderGraphResourceAllocation& b)
+    {
+        return a.heap_offset < b.heap_offset + b.size && b.heap_offset < a.heap_offset + a.size;
+    }
+
+    // 与渲染管线相同的延迟渲染帧：GBuffer -> Deferred -> Skybox -> Present，外加从未被使用的 pass
+    struct DeferredFrame
+    {
+        RenderGraph graph;
+        RenderGraphResourceHandle gbuffer[4];
+        RenderGraphResourceHandle depth;
+        RenderGraphResourceHandle scene_result;
+        RenderGraphPassHandle gbuffer_pass;
+        RenderGraphPassHandle deferred_pass;
+        RenderGraphPassHandle forward_pass;
+        RenderGraphPassHandle skybox_pass;
+        RenderGraphPassHandle present_pass;
+
+        DeferredFrame()
+        {
+            for (UInt i = 0; i < 4; ++i) gbuffer[i] = graph.CreateTexture("gbuffer", MakeDesc());
+            depth = graph.CreateTexture("depth", MakeDesc());
+            scene_result = graph.CreateTexture("scene_result", MakeDesc());
+
+            gbuffer_pass = graph.AddPass("GBuffer");
+            for (UInt i = 0; i < 4; ++i) graph.Write(gbuffer_pass, gbuffer[i], RenderGraphAccess_RenderTarget);
+            graph.Write(gbuffer_pass, depth, RenderGraphAccess_DepthWrite);
+
+            deferred_pass = graph.AddPass("DeferredShading");
+            for (UInt i = 0; i < 4; ++i) graph.Read(deferred_pass, gbuffer[i], RenderGraphAccess_PixelShaderResource);
+            graph.Write(deferred_pass, scene_result, RenderGraphAccess_RenderTarget);
+
+            forward_pass = graph.AddPass("Forward");
+
+            skybox_pass = graph.AddPass("Skybox");
+            graph.Write(skybox_pass, scene_result, RenderGraphAccess_RenderTarget);
+            graph.Write(skybox_pass, depth, RenderGraphAccess_DepthWrite);
+
+            present_pass = graph.AddPass("Present", true);
+            graph.Read(present_pass, scene_result, RenderGraphAccess_CopySource);
+        }
+    };
+}
+
+TEST_CASE("RenderGraph culls passes whose outputs are never consumed", "[render][render_graph]")
+{
+    SECTION("Passes without accesses or only feeding culled passes are removed")
+    {
+        RenderGraph graph;
+        const RenderGraphResourceHandle scene = graph.CreateTexture("scene", MakeDesc());
+        const RenderGraphResourceHandle unused = graph.CreateTexture("unused", MakeDesc());
+        const RenderGraphResourceHandle unused_2 = graph.CreateTexture("unused_2", MakeDesc());
+
+        const RenderGraphPassHandle draw = graph.AddPass("Draw");
+        graph.Write(draw, scene, RenderGraphAccess_RenderTarget);
+        const RenderGraphPassHandle empty = graph.AddPass("Empty");
+        const RenderGraphPassHandle orphan = graph.AddPass("Orphan");
+        graph.Write(orphan, unused, RenderGraphAccess_RenderTarget);
+        const RenderGraphPassHandle orphan_reader = graph.AddPass("OrphanReader");
+        graph.Read(orphan_reader, unused, RenderGraphAccess_PixelShaderResource);
+        graph.Write(orphan_reader, unused_2, RenderGraphAccess_RenderTarget);
+        const RenderGraphPassHandle present = graph.AddPass("Present", true);
+        graph.Read(present, scene, RenderGraphAccess_CopySource);
+
+        RenderGraphCompileResult result;
+        REQUIRE(graph.Compile(result));
+        REQUIRE(result.culled_pass_count == 3);
+        REQUIRE_FALSE(result.pass_culled[draw]);
+        REQUIRE(result.pass_culled[empty]);
+        REQUIRE(result.pass_culled[orphan]);
+        REQUIRE(result.pass_culled[orphan_reader]);
+        REQUIRE_FALSE(result.pass_culled[present]);
+        REQUIRE(result.passes.size() == 2);
+        REQUIRE(result.passes[0].pass == draw);
+        REQUIRE(result.passes[1].pass == present);
+
+        // 被剔除 pass 独占的资源不分配内存
+        REQUIRE_FALSE(result.resources[unused].used);
+        REQUIRE_FALSE(result.resources[unused_2].used);
+        REQUIRE(result.transient_heap_size == kTextureSize);
+    }
+
+    SECTION("Writes to imported resources keep the pass alive")
+    {
+        RenderGraph graph;
+        const RenderGraphResourceHandle back_buffer = graph.ImportTexture("back_buffer", RenderGraphAccess_Present, RenderGraphAccess_Present);
+        const RenderGraphPassHandle pass = graph.AddPass("Blit");
+        graph.Write(pass, back_buffer, RenderGraphAccess_RenderTarget);
+
+        RenderGraphCompileResult result;
+        REQUIRE(graph.Compile(result));
+        REQUIRE(result.culled_pass_count == 0);
+        REQUIRE(result.passes.size() == 1);
+    }
+
+    SECTION("Earlier writers of a resource that is modified later are kept")
+    {
+        DeferredFrame frame;
+        RenderGraphCompileResult result;
+        REQUIRE(frame.graph.Compile(result));
+        REQUIRE(result.culled_pass_count == 1);
+        REQUIRE(result.pass_culled[frame.forward_pass]);
+        REQUIRE_FALSE(result.pass_culled[frame.gbuffer_pass]);
+        REQUIRE_FALSE(result.pass_culled[frame.deferred_pass]);
+        REQUIRE_FALSE(result.pass_culled[frame.skybox_pass]);
+    }
+}
+
+TEST_CASE("RenderGraph emits minimal batched barriers", "[render][render_graph]")
+{
+    SECTION("Barriers are only issued on state changes")
+    {
+        DeferredFrame frame;
+        RenderGraphCompileResult result;
+        REQUIRE(frame.graph.Compile(result));
+
+        // GBuffer: 4 张 GBuffer PSR -> RT（depth 在整帧保持 DepthWrite，不需要屏障）
+        const RenderGraphCompiledPass* gbuffer = FindCompiledPass(result, frame.gbuffer_pass);
+        REQUIRE(gbuffer != nullptr);
+        REQUIRE(gbuffer->barriers.size() == 4);
+        for (const RenderGraphBarrier& barrier : gbuffer->barriers)
+        {
+            REQUIRE(barrier.type == RenderGraphBarrierType_Transition);
+            REQUIRE(barrier.state_before == RenderGraphAccess_PixelShaderResource);
+            REQUIRE(barrier.state_after == RenderGraphAccess_RenderTarget);
+        }
+
+        // Deferred: 4 张 GBuffer RT -> PSR，scene_result CopySource -> RT
+        const RenderGraphCompiledPass* deferred = FindCompiledPass(result, frame.deferred_pass);
+        REQUIRE(deferred != nullptr);
+        REQUIRE(deferred->barriers.size() == 5);
+
+        // Skybox 继续以相同状态写入，没有屏障
+        const RenderGraphCompiledPass* skybox = FindCompiledPass(result, frame.skybox_pass);
+        REQUIRE(skybox != nullptr);
+        REQUIRE(skybox->barriers.empty());
+
+        const RenderGraphCompiledPass* present = FindCompiledPass(result, frame.present_pass);
+        REQUIRE(present != nullptr);
+        REQUIRE(present->barriers.size() == 1);
+        REQUIRE(present->barriers[0].resource == frame.scene_result);
+        REQUIRE(present->barriers[0].state_before == RenderGraphAccess_RenderTarget);
+        REQUIRE(present->barriers[0].state_after == RenderGraphAccess_CopySource);
+
+        REQUIRE(result.transition_barrier_count == 10);
+        REQUIRE(result.barrier_batch_count == 3);
+        REQUIRE(result.aliasing_barrier_count == 0);
+        REQUIRE(result.final_barriers.empty());
+    }
+
+    SECTION("Consecutive reads are merged into one combined read state")
+    {
+        RenderGraph graph;
+        const RenderGraphResourceHandle texture = graph.CreateTexture("shadow", MakeDesc());
+        const RenderGraphResourceHandle output = graph.ImportTexture("output", RenderGraphAccess_RenderTarget);
+
+        const RenderGraphPassHandle writer = graph.AddPass("Write");
+        graph.Write(writer, texture, RenderGraphAccess_DepthWrite);
+        const RenderGraphPassHandle reader_a = graph.AddPass("ReadA");
+        graph.Read(reader_a, texture, RenderGraphAccess_PixelShaderResource);
+        graph.Write(reader_a, output, RenderGraphAccess_RenderTarget);
+        const RenderGraphPassHandle reader_b = graph.AddPass("ReadB");
+        graph.Read(reader_b, texture, RenderGraphAccess_NonPixelShaderResource);
+        graph.Read(reader_b, texture, RenderGraphAccess_DepthRead);
+        graph.Write(reader_b, output, RenderGraphAccess_RenderTarget);
+
+        RenderGraphCompileResult result;
+        REQUIRE(graph.Compile(result));
+        const UInt combined = RenderGraphAccess_PixelShaderResource | RenderGraphAccess_NonPixelShaderResource | RenderGraphAccess_DepthRead;
+
+        const RenderGraphCompiledPass* compiled_a = FindCompiledPass(result, reader_a);
+        REQUIRE(compiled_a->barriers.size() == 1);
+        REQUIRE(compiled_a->barriers[0].state_before == RenderGraphAccess_DepthWrite);
+        REQUIRE(compiled_a->barriers[0].state_after == combined);
+        REQUIRE(FindCompiledPass(result, reader_b)->barriers.empty());
+
+        // 帧首从上一帧的最后状态（组合读状态）转换回 DepthWrite
+        const RenderGraphCompiledPass* compiled_writer = FindCompiledPass(result, writer);
+        REQUIRE(compiled_writer->barriers.size() == 1);
+        REQUIRE(compiled_writer->barriers[0].state_before == combined);
+        REQUIRE(compiled_writer->barriers[0].state_after == RenderGraphAccess_DepthWrite);
+    }
+
+    SECTION("Imported resources are returned to their final state in one batch")
+    {
+        RenderGraph graph;
+        const RenderGraphResourceHandle back_buffer = graph.ImportTexture("back_buffer", RenderGraphAccess_Present, RenderGraphAccess_Present);
+        const RenderGraphResourceHandle history = graph.ImportTexture("history", RenderGraphAccess_PixelShaderResource, RenderGraphAccess_PixelShaderResource);
+        const RenderGraphPassHandle pass = graph.AddPass("Resolve");
+        graph.Read(pass, history, RenderGraphAccess_PixelShaderResource);
+        graph.Write(pass, back_buffer, RenderGraphAccess_RenderTarget);
+
+        RenderGraphCompileResult result;
+        REQUIRE(graph.Compile(result));
+        REQUIRE(result.passes.size() == 1);
+        REQUIRE(result.passes[0].barriers.size() == 1);
+        REQUIRE(result.passes[0].barriers[0].resource == back_buffer);
+        REQUIRE(result.final_barriers.size() == 1);
+        REQUIRE(result.final_barriers[0].resource == back_buffer);
+        REQUIRE(result.final_barriers[0].state_before == RenderGraphAccess_RenderTarget);
+        REQUIRE(result.final_barriers[0].state_after == RenderGraphAccess_Present);
+        REQUIRE(result.barrier_batch_count == 2);
+    }
+
+    SECTION("Steady-state frames start from the state the previous frame ended in")
+    {
+        RenderGraph graph;
+        const RenderGraphResourceHandle target = graph.CreateTexture("target", MakeDesc());
+        const RenderGraphPassHandle draw = graph.AddPass("Draw");
+        graph.Write(draw, target, RenderGraphAccess_RenderTarget);
+        const RenderGraphPassHandle overlay = graph.AddPass("Overlay", true);
+        graph.Write(overlay, target, RenderGraphAccess_RenderTarget);
+
+        RenderGraphCompileResult result;
+        REQUIRE(graph.Compile(result));
+        REQUIRE(result.transition_barrier_count == 0);
+        REQUIRE(result.barrier_batch_count == 0);
+    }
+}
+
+TEST_CASE("RenderGraph aliases transient textures by lifetime", "[render][render_graph]")
+{
+    SECTION("Non-overlapping lifetimes share memory")
+    {
+        RenderGraph graph;
+        const RenderGraphResourceHandle a = graph.CreateTexture("a", MakeDesc());
+        const RenderGraphResourceHandle b = graph.CreateTexture("b", MakeDesc());
+        const RenderGraphResourceHandle c = graph.CreateTexture("c", MakeDesc());
+        const RenderGraphResourceHandle output = graph.ImportTexture("output", RenderGraphAccess_RenderTarget);
+
+        // a -> b -> c -> output：每个时刻最多两个资源同时存活
+        const RenderGraphPassHandle pass_a = graph.AddPass("A");
+        graph.Write(pass_a, a, RenderGraphAccess_RenderTarget);
+        const RenderGraphPassHandle pass_b = graph.AddPass("B");
+        graph.Read(pass_b, a, RenderGraphAccess_PixelShaderResource);
+        graph.Write(pass_b, b, RenderGraphAccess_RenderTarget);
+        const RenderGraphPassHandle pass_c = graph.AddPass("C");
+        graph.Read(pass_c, b, RenderGraphAccess_PixelShaderResource);
+        graph.Write(pass_c, c, RenderGraphAccess_RenderTarget);
+        const RenderGraphPassHandle pass_out = graph.AddPass("Out");
+        graph.Read(pass_out, c, RenderGraphAccess_PixelShaderResource);
+        graph.Write(pass_out, output, RenderGraphAccess_RenderTarget);
+
+        RenderGraphCompileResult result;
+        REQUIRE(graph.Compile(result));
+        REQUIRE(result.unaliased_heap_size == 3 * kTextureSize);
+        REQUIRE(result.transient_heap_size == 2 * kTextureSize);
+        REQUIRE(result.resources[a].heap_offset == 0);
+        REQUIRE(result.resources[b].heap_offset == kTextureSize);
+        REQUIRE(result.resources[c].heap_offset == 0);
+        REQUIRE(result.resources[a].first_pass == pass_a);
+        REQUIRE(result.resources[a].last_pass == pass_b);
+        REQUIRE_FALSE(result.resources[output].transient);
+
+        // 同时存活的资源内存不重叠
+        REQUIRE_FALSE(Overlaps(result.resources[a], result.resources[b]));
+        REQUIRE_FALSE(Overlaps(result.resources[b], result.resources[c]));
+
+        // c 接管 a 的内存：在 C 的批次开头有一个别名屏障；a 的内存在上一帧被 c 占用，因此也需要别名屏障
+        const std::vector<RenderGraphBarrier> aliasing_c = FilterBarriers(FindCompiledPass(result, pass_c)->barriers, RenderGraphBarrierType_Aliasing);
+        REQUIRE(aliasing_c.size() == 1);
+        REQUIRE(aliasing_c[0].resource == c);
+        REQUIRE(aliasing_c[0].resource_before == a);
+        REQUIRE(FindCompiledPass(result, pass_c)->barriers.front().type == RenderGraphBarrierType_Aliasing);
+
+        const std::vector<RenderGraphBarrier> aliasing_a = FilterBarriers(FindCompiledPass(result, pass_a)->barriers, RenderGraphBarrierType_Aliasing);
+        REQUIRE(aliasing_a.size() == 1);
+        REQUIRE(aliasing_a[0].resource == a);
+        REQUIRE(aliasing_a[0].resource_before == kRenderGraphInvalidHandle);
+
+        REQUIRE(FilterBarriers(FindCompiledPass(result, pass_b)->barriers, RenderGraphBarrierType_Aliasing).empty());
+        REQUIRE(result.aliasing_barrier_count == 2);
+    }
+
+    SECTION("Offsets respect each resource's alignment")
+    {
+        RenderGraph graph;
+        const RenderGraphResourceHandle small = graph.CreateTexture("small", MakeDesc(1000, 256));
+        const RenderGraphResourceHandle large = graph.CreateTexture("large", MakeDesc(5000, 4096));
+        const RenderGraphPassHandle pass = graph.AddPass("Draw", true);
+        graph.Write(pass, small, RenderGraphAccess_RenderTarget);
+        graph.Write(pass, large, RenderGraphAccess_RenderTarget);
+
+        RenderGraphCompileResult result;
+        REQUIRE(graph.Compile(result));
+        REQUIRE(result.resources[small].heap_offset == 0);
+        REQUIRE(result.resources[large].heap_offset == 4096);
+        REQUIRE(result.transient_heap_size == 4096 + 5000);
+        REQUIRE(result.unaliased_heap_size == 4096 + 5000);
+        REQUIRE(result.aliasing_barrier_count == 0);
+    }
+
+    SECTION("The deferred frame keeps GBuffer and scene result live together")
+    {
+        // DeferredShading 同时读取 GBuffer 并写入 scene_result，因此这一帧布局下无法节省内存
+        DeferredFrame frame;
+        RenderGraphCompileResult result;
+        REQUIRE(frame.graph.Compile(result));
+        REQUIRE(result.transient_heap_size == 6 * kTextureSize);
+        REQUIRE(result.unaliased_heap_size == 6 * kTextureSize);
+        for (UInt i = 0; i < 4; ++i)
+        {
+            REQUIRE_FALSE(Overlaps(result.resources[frame.gbuffer[i]], result.resources[frame.scene_result]));
+        }
+    }
+
+    SECTION("A post chain after the deferred frame reuses GBuffer memory")
+    {
+        DeferredFrame frame;
+        const RenderGraphResourceHandle bloom = frame.graph.CreateTexture("bloom", MakeDesc(4 * kTextureSize));
+        const RenderGraphResourceHandle back_buffer = frame.graph.ImportTexture("back_buffer", RenderGraphAccess_Present, RenderGraphAccess_Present);
+        const RenderGraphPassHandle bloom_pass = frame.graph.AddPass("Bloom");
+        frame.graph.Read(bloom_pass, frame.scene_result, RenderGraphAccess_PixelShaderResource);
+        frame.graph.Write(bloom_pass, bloom, RenderGraphAccess_RenderTarget);
+        const RenderGraphPassHandle composite_pass = frame.graph.AddPass("Composite");
+        frame.graph.Read(composite_pass, bloom, RenderGraphAccess_PixelShaderResource);
+        frame.graph.Read(composite_pass, frame.scene_result, RenderGraphAccess_PixelShaderResource);
+        frame.graph.Write(composite_pass, back_buffer, RenderGraphAccess_RenderTarget);
+
+        RenderGraphCompileResult result;
+        REQUIRE(frame.graph.Compile(result));
+        REQUIRE(result.unaliased_heap_size == 10 * kTextureSize);
+        REQUIRE(result.transient_heap_size < result.unaliased_heap_size);
+        REQUIRE(result.resources[bloom].heap_offset == 0);
+        for (UInt i = 0; i < 4; ++i)
+        {
+            REQUIRE(Overlaps(result.resources[bloom], result.resources[frame.gbuffer[i]]));
+        }
+        REQUIRE_FALSE(Overlaps(result.resources[bloom], result.resources[frame.scene_result]));
+
+        // 合并后的读状态：scene_result 在 Present / Bloom / Composite 之间只转换一次
+        const UInt scene_read_state = RenderGraphAccess_CopySource | RenderGraphAccess_PixelShaderResource;
+        const RenderGraphCompiledPass* present = FindCompiledPass(result, frame.present_pass);
+        REQUIRE(present->barriers.size() == 1);
+        REQUIRE(present->barriers[0].state_after == scene_read_state);
+        for (RenderGraphPassHandle pass : { bloom_pass, composite_pass })
+        {
+            for (const RenderGraphBarrier& barrier : FindCompiledPass(result, pass)->barriers)
+            {
+                REQUIRE(barrier.resource != frame.scene_result);
+            }
+        }
+    }
+}
+
+TEST_CASE("RenderGraph rejects invalid declarations", "[render][render_graph]")
+{
+    RenderGraph graph;
+    const RenderGraphResourceHandle texture = graph.CreateTexture("texture", MakeDesc());
+    const RenderGraphPassHandle pass = graph.AddPass("Pass", true);
+    RenderGraphCompileResult result;
+
+    SECTION("Read and write of the same resource in one pass")
+    {
+        graph.Read(pass, texture, RenderGraphAccess_PixelShaderResource);
+        graph.Write(pass, texture, RenderGraphAccess_RenderTarget);
+        REQUIRE_FALSE(graph.Compile(result));
+    }
+
+    SECTION("Read access passed to Write and vice versa")
+    {
+        graph.Write(pass, texture, RenderGraphAccess_PixelShaderResource);
+        REQUIRE_FALSE(graph.Compile(result));
+        graph.Reset();
+        const RenderGraphResourceHandle other = graph.CreateTexture("texture", MakeDesc());
+        const RenderGraphPassHandle other_pass = graph.AddPass("Pass", true);
+        graph.Read(other_pass, other, RenderGraphAccess_RenderTarget);
+        REQUIRE_FALSE(graph.Compile(result));
+    }
+
+    SECTION("Combined write states and present mixed with reads")
+    {
+        graph.Write(pass, texture, RenderGraphAccess_RenderTarget | RenderGraphAccess_CopyDest);
+        REQUIRE_FALSE(graph.Compile(result));
+        graph.Reset();
+        const RenderGraphResourceHandle other = graph.CreateTexture("texture", MakeDesc());
+        const RenderGraphPassHandle other_pass = graph.AddPass("Pass", true);
+        graph.Read(other_pass, other, RenderGraphAccess_Present);
+        graph.Read(other_pass, other, RenderGraphAccess_CopySource);
+        REQUIRE_FALSE(graph.Compile(result));
+    }
+
+    SECTION("Invalid handles")
+    {
+        graph.Read(pass, texture + 1, RenderGraphAccess_PixelShaderResource);
+        REQUIRE_FALSE(graph.Compile(result));
+    }
+
+    SECTION("Reset clears the error")
+    {
+        graph.Read(pass, texture + 1, RenderGraphAccess_PixelShaderResource);
+        graph.Reset();
+        REQUIRE(graph.GetPassCount() == 0);
+        REQUIRE(graph.Compile(result));
+        REQUIRE(result.passes.empty());
+    }
+}
@@ -0,0 +1,65 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <vector>
+#include "render/dolas_render_entity.h"
+#include "render/dolas_render_scene.h"
+#include "bounds_test_helpers.h"
+
+using namespace Dolas;
+
+namespace
+{
+    // 不加载网格，直接给定局部包围盒的 entity
+    class TestRenderEntity : public RenderEntity
+    {
+    public:
+        TestRenderEntity(RenderEntityID render_entity_id, const BoundingBox& local_bounds)
+        {
+            m_file_id = render_entity_id;
+            m_local_bounds = local_bounds;
+            UpdateWorldBounds();
+        }
+    };
+
+    Bool ContainsEntity(const std::vector<RenderEntityID>& render_entities, RenderEntityID render_entity_id)
+    {
+        return std::find(render_entities.begin(), render_entities.end(), render_entity_id) != render_entities.end();
+    }
+}
+
+TEST_CASE("RenderScene queries follow entities moved through SetPose", "[RenderScene]")
+{
+    RenderScene scene;
+    TestRenderEntity moving_entity(1, MakeBox(Vector3(0.0f, 0.0f, 0.0f), 1.0f));
+    TestRenderEntity static_entity(2, MakeBox(Vector3(0.0f, 0.0f, 0.0f), 1.0f));
+    scene.AddRenderEntity(&moving_entity);
+    scene.AddRenderEntity(&static_entity);
+
+    const BoundingBox origin_region = MakeBox(Vector3(0.0f, 0.0f, 0.0f), 2.0f);
+    const BoundingBox target_region = MakeBox(Vector3(500.0f, 0.0f, 0.0f), 2.0f);
+
+    // 移动距离远大于树的外扩边距，必须 refit 才能在新位置查到
+    moving_entity.SetPose(Pose(Vector3(500.0f, 0.0f, 0.0f), Quaternion::IDENTITY, Vector3(1.0f, 1.0f, 1.0f)));
+
+    std::vector<RenderEntityID> found;
+    scene.QueryRenderEntities(target_region, found);
+    REQUIRE(ContainsEntity(found, 1));
+    REQUIRE_FALSE(ContainsEntity(found, 2));
+
+    found.clear();
+    scene.QueryRenderEntities(origin_region, found);
+    REQUIRE_FALSE(ContainsEntity(found, 1));
+    REQUIRE(ContainsEntity(found, 2));
+
+    Float distance = 0.0f;
+    REQUIRE(scene.RayCastRenderEntity(Vector3(500.0f, 0.0f, -10.0f), Vector3(0.0f, 0.0f, 1.0f), 100.0f, &distance) == 1);
+    REQUIRE(distance == 9.0f);
+    REQUIRE(scene.GetEntityTree().Validate());
+
+    // 移出 scene 后不再 refit，也不会被查到
+    scene.RemoveRenderEntity(1);
+    moving_entity.SetPose(Pose());
+    found.clear();
+    scene.QueryRenderEntities(origin_region, found);
+    REQUIRE(found == std::vector<RenderEntityID>{ 2 });
+}
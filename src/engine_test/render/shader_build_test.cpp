@@ -0,0 +1,201 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include "dolas_shader_build.h"
+
+using namespace Dolas;
+
+namespace
+{
+    // 与 content/shader 中的真实结构相同：light.hlsli -> clustered_lighting.hlsli -> deferred_shading_ps.hlsl
+    ShaderDependencyGraph MakeDeferredShadingGraph()
+    {
+        ShaderDependencyGraph graph;
+        graph.AddFile("global_constants.hlsli", "cbuffer PerFrame : register(b0) {};\n");
+        graph.AddFile("shade_mode.hlsli", "#define SHADE_MODE_BLINN_PHONG 1\n");
+        graph.AddFile("light.hlsli",
+            "#ifndef LIGHT_HLSLI\n"
+            "#define LIGHT_HLSLI\n"
+            "#include \"global_constants.hlsli\"\n"
+            "#include \"shade_mode.hlsli\"\n"
+            "#endif\n");
+        graph.AddFile("clustered_lighting.hlsli", "#include \"light.hlsli\"\n");
+        graph.AddFile("deferred_shading/deferred_shading_common.hlsli", "struct VS_OUTPUT { float4 position : SV_POSITION; };\n");
+        graph.AddFile("deferred_shading/deferred_shading_ps.hlsl",
+            "#include \"deferred_shading/deferred_shading_common.hlsli\"\n"
+            "#include \"global_constants.hlsli\"\n"
+            "#include \"clustered_lighting.hlsli\"\n"
+            "float4 PS(VS_OUTPUT input) : SV_TARGET { return 0; }\n");
+        graph.AddFile("deferred_shading/deferred_shading_vs.hlsl",
+            "#include \"deferred_shading/deferred_shading_common.hlsli\"\n"
+            "VS_OUTPUT VS() { return (VS_OUTPUT)0; }\n");
+        return graph;
+    }
+
+    std::string GetTempManifestPath(const char* file_name)
+    {
+        return (std::filesystem::temp_directory_path() / file_name).string();
+    }
+}
+
+// ============ Include Parsing Tests ============
+
+TEST_CASE("ParseIncludes skips comments and accepts both include forms", "[ShaderBuild][parse]")
+{
+    const std::string content =
+        "// #include \"commented_line.hlsli\"\n"
+        "/* #include \"commented_block.hlsli\"\n"
+        "   #include \"still_commented.hlsli\" */\n"
+        "  #  include \"spaced.hlsli\"\n"
+        "#include <angled/file.hlsli>\n"
+        "float x; #include \"not_a_directive.hlsli\"\n"
+        "#if FEATURE\n"
+        "#include \"conditional.hlsli\" // trailing comment\n"
+        "#endif\n";
+
+    const std::vector<std::string> includes = ShaderDependencyGraph::ParseIncludes(content);
+    REQUIRE(includes.size() == 3);
+    CHECK(includes[0] == "spaced.hlsli");
+    CHECK(includes[1] == "angled/file.hlsli");
+    CHECK(includes[2] == "conditional.hlsli");
+}
+
+TEST_CASE("NormalizePath produces root-relative forward-slash paths", "[ShaderBuild][parse]")
+{
+    CHECK(ShaderDependencyGraph::NormalizePath("deferred_shading\\deferred_shading_ps.hlsl") == "deferred_shading/deferred_shading_ps.hlsl");
+    CHECK(ShaderDependencyGraph::NormalizePath("./a/./b/../c.hlsli") == "a/c.hlsli");
+    CHECK(ShaderDependencyGraph::NormalizePath("a//b.hlsli") == "a/b.hlsli");
+}
+
+// ============ Dependency Graph Tests ============
+
+TEST_CASE("ShaderDependencyGraph resolves transitive includes and dependents", "[ShaderBuild][graph]")
+{
+    const ShaderDependencyGraph graph = MakeDeferredShadingGraph();
+
+    const std::vector<std::string> includes = graph.GetTransitiveIncludes("deferred_shading/deferred_shading_ps.hlsl");
+    const std::vector<std::string> expected_includes = {
+        "clustered_lighting.hlsli",
+        "deferred_shading/deferred_shading_common.hlsli",
+        "global_constants.hlsli",
+        "light.hlsli",
+        "shade_mode.hlsli",
+    };
+    CHECK(includes == expected_includes);
+
+    // light.hlsli 改动只影响 deferred_shading_ps.hlsl，不影响 VS
+    const std::vector<std::string> dependents = graph.GetDependents("light.hlsli");
+    const std::vector<std::string> expected_dependents = {
+        "clustered_lighting.hlsli",
+        "deferred_shading/deferred_shading_ps.hlsl",
+    };
+    CHECK(dependents == expected_dependents);
+
+    const std::vector<std::string> sources = graph.GetFiles(".hlsl");
+    REQUIRE(sources.size() == 2);
+    CHECK(graph.GetMissingIncludes().empty());
+}
+
+TEST_CASE("ShaderDependencyGraph falls back to includer-relative paths and reports missing includes", "[ShaderBuild][graph]")
+{
+    ShaderDependencyGraph graph;
+    graph.AddFile("sky_box/sky_box_common.hlsli", "");
+    graph.AddFile("sky_box/sky_box_ps.hlsl", "#include \"sky_box_common.hlsli\"\n#include \"missing.hlsli\"\n");
+
+    const std::vector<std::string> includes = graph.GetDirectIncludes("sky_box/sky_box_ps.hlsl");
+    REQUIRE(includes.size() == 1);
+    CHECK(includes[0] == "sky_box/sky_box_common.hlsli");
+
+    const auto missing = graph.GetMissingIncludes();
+    REQUIRE(missing.size() == 1);
+    CHECK(missing[0].first == "sky_box/sky_box_ps.hlsl");
+    CHECK(missing[0].second == "missing.hlsli");
+}
+
+TEST_CASE("ShaderDependencyGraph tolerates include cycles", "[ShaderBuild][graph]")
+{
+    ShaderDependencyGraph graph;
+    graph.AddFile("a.hlsli", "#include \"b.hlsli\"\n");
+    graph.AddFile("b.hlsli", "#include \"a.hlsli\"\n");
+    graph.AddFile("main_ps.hlsl", "#include \"a.hlsli\"\n");
+
+    const std::vector<std::string> expected = { "a.hlsli", "b.hlsli" };
+    CHECK(graph.GetTransitiveIncludes("main_ps.hlsl") == expected);
+    CHECK(graph.GetTransitiveIncludes("a.hlsli") == std::vector<std::string>{ "b.hlsli" });
+}
+
+TEST_CASE("ComputeInputHash changes only when an input of that shader changes", "[ShaderBuild][graph]")
+{
+    ShaderDependencyGraph graph = MakeDeferredShadingGraph();
+    const ULongLong ps_hash = graph.ComputeInputHash("deferred_shading/deferred_shading_ps.hlsl", 1);
+    const ULongLong vs_hash = graph.ComputeInputHash("deferred_shading/deferred_shading_vs.hlsl", 1);
+
+    // 编译参数通过 seed 参与
+    CHECK(graph.ComputeInputHash("deferred_shading/deferred_shading_ps.hlsl", 2) != ps_hash);
+
+    // 修改间接 include 的内容
+    graph.AddFile("shade_mode.hlsli", "#define SHADE_MODE_BLINN_PHONG 2\n");
+    CHECK(graph.ComputeInputHash("deferred_shading/deferred_shading_ps.hlsl", 1) != ps_hash);
+    CHECK(graph.ComputeInputHash("deferred_shading/deferred_shading_vs.hlsl", 1) == vs_hash);
+
+    CHECK(graph.ComputeInputHash("not_in_graph.hlsl", 1) == 0);
+}
+
+// ============ Manifest Tests ============
+
+TEST_CASE("Shader variant seed depends on every compile parameter and not on define order", "[ShaderBuild][manifest]")
+{
+    const std::string defines = MakeShaderDefinesString({ { "B", "2" }, { "A", "1" } });
+    CHECK(defines == "A=1;B=2");
+    CHECK(MakeShaderDefinesString({}).empty());
+
+    const ULongLong seed = ComputeShaderVariantSeed("d3dcompiler", "ps_5_0", "PS", defines);
+    CHECK(ComputeShaderVariantSeed("d3dcompiler", "ps_5_0", "PS", MakeShaderDefinesString({ { "A", "1" }, { "B", "2" } })) == seed);
+    CHECK(ComputeShaderVariantSeed("glslang", "ps_5_0", "PS", defines) != seed);
+    CHECK(ComputeShaderVariantSeed("d3dcompiler", "ps_5_1", "PS", defines) != seed);
+    CHECK(ComputeShaderVariantSeed("d3dcompiler", "ps_5_0", "main", defines) != seed);
+    CHECK(ComputeShaderVariantSeed("d3dcompiler", "ps_5_0", "PS", "") != seed);
+}
+
+TEST_CASE("ShaderBuildManifest round-trips entries and detects stale outputs", "[ShaderBuild][manifest]")
+{
+    ShaderBuildManifest manifest;
+    manifest.SetCompilerIdentity("d3dcompiler;strict;optimization_level3");
+    ShaderBuildManifestEntry entry;
+    entry.source = "deferred_shading/deferred_shading_ps.hlsl";
+    entry.entry_point = "PS";
+    entry.target = "ps_5_1";
+    entry.defines = "DOLAS_BINDLESS_TEXTURES=1";
+    entry.output = "deferred_shading/deferred_shading_ps.bindless.cso";
+    entry.input_hash = 0xFEDCBA9876543210ULL;
+    entry.bytecode_size = 4096;
+    entry.compile_milliseconds = 12.5;
+    manifest.SetEntry(entry);
+
+    const std::string path = GetTempManifestPath("dolas_shader_build_test_manifest.txt");
+    REQUIRE(manifest.Save(path));
+
+    ShaderBuildManifest loaded;
+    REQUIRE(loaded.Load(path));
+    CHECK(loaded.GetCompilerIdentity() == manifest.GetCompilerIdentity());
+    const ShaderBuildManifestEntry* loaded_entry = loaded.FindEntry(entry.output);
+    REQUIRE(loaded_entry != nullptr);
+    CHECK(loaded_entry->source == entry.source);
+    CHECK(loaded_entry->entry_point == entry.entry_point);
+    CHECK(loaded_entry->target == entry.target);
+    CHECK(loaded_entry->defines == entry.defines);
+    CHECK(loaded_entry->input_hash == entry.input_hash);
+    CHECK(loaded_entry->bytecode_size == entry.bytecode_size);
+    CHECK(loaded_entry->compile_milliseconds == 12.5);
+
+    CHECK_FALSE(loaded.IsStale(entry.output, entry.input_hash));
+    CHECK(loaded.IsStale(entry.output, entry.input_hash + 1));
+    CHECK(loaded.IsStale("other.cso", entry.input_hash));
+
+    // 运行时按编译参数查找
+    CHECK(loaded.FindVariant(entry.source, "PS", "ps_5_1", entry.defines) == loaded_entry);
+    CHECK(loaded.FindVariant(entry.source, "PS", "ps_5_0", "") == nullptr);
+
+    std::filesystem::remove(path);
+    CHECK_FALSE(loaded.Load(path));
+    CHECK(loaded.GetEntries().empty());
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dolas_shader_permutation.h"
+
+using namespace Dolas;
+
+TEST_CASE("ShaderKeywordDeclaration parses keyword sets from comment directives", "[ShaderPermutation]")
+{
+    const std::string content =
+        "// #pragma dolas_keywords _ NORMAL_MAP\n"
+        "  //#pragma dolas_keywords _ SHADE_LIT SHADE_UNLIT\n"
+        "#pragma dolas_keywords NOT_A_COMMENT\n"
+        "float x; // #pragma dolas_keywords TRAILING_COMMENT\n"
+        "// #pragma dolas_keywords _ NORMAL_MAP 1INVALID ALPHA_TEST ALPHA_TEST\n"
+        "// #pragma dolas_keywords _\n"
+        "float4 PS() : SV_TARGET { return 0; }\n";
+
+    const ShaderKeywordDeclaration declaration = ShaderKeywordDeclaration::Parse(content);
+    const std::vector<std::vector<std::string>>& sets = declaration.GetKeywordSets();
+    REQUIRE(sets.size() == 3);
+    CHECK(sets[0] == std::vector<std::string>({ "NORMAL_MAP" }));
+    CHECK(sets[1] == std::vector<std::string>({ "SHADE_LIT", "SHADE_UNLIT" }));
+    // 重复声明、非法名字与重复项被丢弃
+    CHECK(sets[2] == std::vector<std::string>({ "ALPHA_TEST" }));
+
+    CHECK(declaration.IsDeclared("SHADE_UNLIT"));
+    CHECK_FALSE(declaration.IsDeclared("NOT_A_COMMENT"));
+    CHECK_FALSE(declaration.IsDeclared("TRAILING_COMMENT"));
+    CHECK(declaration.GetPermutationCount() == 2 * 3 * 2);
+
+    CHECK(ShaderKeywordDeclaration::Parse("float4 PS() : SV_TARGET { return 0; }\n").IsEmpty());
+    CHECK(ShaderKeywordDeclaration::Parse("").GetPermutationCount() == 1);
+}
+
+TEST_CASE("ShaderKeywordDeclaration resolves material keywords per shader", "[ShaderPermutation]")
+{
+    const ShaderKeywordDeclaration declaration = ShaderKeywordDeclaration::Parse(
+        "// #pragma dolas_keywords _ NORMAL_MAP\n"
+        "// #pragma dolas_keywords _ SHADE_LIT SHADE_UNLIT\n");
+
+    std::vector<std::string> keywords;
+    std::string error;
+    REQUIRE(declaration.Resolve({ "SHADE_LIT", "UNKNOWN", "NORMAL_MAP" }, keywords, &error));
+    CHECK(keywords == std::vector<std::string>({ "NORMAL_MAP", "SHADE_LIT" }));
+    CHECK(error.empty());
+
+    // 没有声明 keyword 的 shader（例如同一材质的 VS）得到默认变体
+    REQUIRE(ShaderKeywordDeclaration().Resolve({ "NORMAL_MAP" }, keywords));
+    CHECK(keywords.empty());
+
+    // 同一组只能启用一个，冲突时保留先声明的那个
+    CHECK_FALSE(declaration.Resolve({ "SHADE_UNLIT", "SHADE_LIT" }, keywords, &error));
+    CHECK(keywords == std::vector<std::string>({ "SHADE_LIT" }));
+    CHECK(error.find("SHADE_UNLIT") != std::string::npos);
+}
+
+TEST_CASE("ComputeShaderPermutationKey ignores order and duplicates", "[ShaderPermutation]")
+{
+    CHECK(ComputeShaderPermutationKey({}) == 0);
+
+    const ShaderPermutationKey normal_map = ComputeShaderPermutationKey({ "NORMAL_MAP" });
+    const ShaderPermutationKey both = ComputeShaderPermutationKey({ "NORMAL_MAP", "ALPHA_TEST" });
+    CHECK(normal_map != 0);
+    CHECK(both != normal_map);
+    CHECK(ComputeShaderPermutationKey({ "ALPHA_TEST", "NORMAL_MAP", "ALPHA_TEST" }) == both);
+    CHECK(ComputeShaderPermutationKey({ "AB" }) != ComputeShaderPermutationKey({ "A", "B" }));
+
+    const std::vector<std::pair<std::string, std::string>> defines = MakeShaderKeywordDefines({ "NORMAL_MAP", "ALPHA_TEST", "NORMAL_MAP" });
+    REQUIRE(defines.size() == 2);
+    CHECK((defines[0] == std::pair<std::string, std::string>("ALPHA_TEST", "1")));
+    CHECK((defines[1] == std::pair<std::string, std::string>("NORMAL_MAP", "1")));
+}
@@ -0,0 +1,103 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include "dolas_shader_reflection.h"
+
+using namespace Dolas;
+
+namespace
+{
+    // 与 deferred_shading_ps.hlsl 反射出来的结构类似：一个 GlobalConstants、一个 per-view cbuffer 与若干纹理 / 采样器
+    ShaderReflectionInfo MakeReflectionInfo()
+    {
+        ShaderReflectionInfo info;
+        info.constant_buffer_count = 2;
+        info.bound_resource_count = 4;
+        info.instruction_count = 317;
+
+        ConstantBufferInfo global_constants;
+        global_constants.name = "GlobalConstants";
+        global_constants.size = 32;
+        global_constants.variable_count = 2;
+        global_constants.variable_descs.push_back({ "base_color", 0, 16, 2 });
+        global_constants.variable_descs.push_back({ "albedo_map_index", 16, 4, 2 });
+        info.constant_buffer_descs.push_back(global_constants);
+
+        ConstantBufferInfo per_view;
+        per_view.name = "PerViewConstants";
+        per_view.size = 256;
+        per_view.variable_count = 1;
+        per_view.variable_descs.push_back({ "view_projection", 0, 64, 2 });
+        info.constant_buffer_descs.push_back(per_view);
+
+        info.bound_resource_descs.push_back({ "GlobalConstants", 0, 1, 1, 1 });
+        info.bound_resource_descs.push_back({ "PerViewConstants", 0, 1, 0, 1 });
+        info.bound_resource_descs.push_back({ "gbuffer_textures", 2, 4, 0, 2 });
+        info.bound_resource_descs.push_back({ "point_clamp_sampler", 3, 0, 0, 1 });
+        return info;
+    }
+}
+
+TEST_CASE("ShaderReflectionFile round-trips reflection and bytecode hash", "[ShaderReflection]")
+{
+    const ShaderReflectionInfo info = MakeReflectionInfo();
+    const ULongLong bytecode_hash = 0x0123456789ABCDEFULL;
+
+    std::vector<UByte> bytes;
+    ShaderReflectionFile::Serialize(info, bytecode_hash, bytes);
+
+    ShaderReflectionInfo loaded;
+    ULongLong loaded_hash = 0;
+    REQUIRE(ShaderReflectionFile::Deserialize(bytes.data(), bytes.size(), loaded, loaded_hash));
+    CHECK(loaded_hash == bytecode_hash);
+    CHECK(loaded == info);
+    REQUIRE(loaded.constant_buffer_descs.size() == 2);
+    CHECK(loaded.constant_buffer_descs[0].variable_descs[1].name == "albedo_map_index");
+    CHECK(loaded.constant_buffer_descs[0].variable_descs[1].start_offset == 16);
+
+    // 空反射（没有 cbuffer 的 shader）也能往返
+    std::vector<UByte> empty_bytes;
+    ShaderReflectionFile::Serialize(ShaderReflectionInfo{}, 0, empty_bytes);
+    REQUIRE(ShaderReflectionFile::Deserialize(empty_bytes.data(), empty_bytes.size(), loaded, loaded_hash));
+    CHECK(loaded == ShaderReflectionInfo{});
+}
+
+TEST_CASE("ShaderReflectionFile rejects truncated or corrupted data", "[ShaderReflection]")
+{
+    const ShaderReflectionInfo info = MakeReflectionInfo();
+    std::vector<UByte> bytes;
+    ShaderReflectionFile::Serialize(info, 42, bytes);
+
+    ShaderReflectionInfo loaded;
+    ULongLong loaded_hash = 0;
+    CHECK_FALSE(ShaderReflectionFile::Deserialize(nullptr, 0, loaded, loaded_hash));
+    CHECK_FALSE(ShaderReflectionFile::Deserialize(bytes.data(), bytes.size() - 1, loaded, loaded_hash));
+    CHECK_FALSE(ShaderReflectionFile::Deserialize(bytes.data(), 8, loaded, loaded_hash));
+
+    std::vector<UByte> corrupted = bytes;
+    corrupted.back() ^= 0xFF;
+    CHECK_FALSE(ShaderReflectionFile::Deserialize(corrupted.data(), corrupted.size(), loaded, loaded_hash));
+
+    std::vector<UByte> wrong_magic = bytes;
+    wrong_magic[0] ^= 0xFF;
+    CHECK_FALSE(ShaderReflectionFile::Deserialize(wrong_magic.data(), wrong_magic.size(), loaded, loaded_hash));
+
+    // 失败时不修改输出
+    CHECK(loaded == ShaderReflectionInfo{});
+    CHECK(loaded_hash == 0);
+}
+
+TEST_CASE("ShaderReflectionFile saves and loads from disk", "[ShaderReflection]")
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "dolas_shader_reflection_test.refl").string();
+    const ShaderReflectionInfo info = MakeReflectionInfo();
+    REQUIRE(ShaderReflectionFile::Save(path, info, 7));
+
+    ShaderReflectionInfo loaded;
+    ULongLong loaded_hash = 0;
+    REQUIRE(ShaderReflectionFile::Load(path, loaded, loaded_hash));
+    CHECK(loaded == info);
+    CHECK(loaded_hash == 7);
+
+    std::filesystem::remove(path);
+    CHECK_FALSE(ShaderReflectionFile::Load(path, loaded, loaded_hash));
+}
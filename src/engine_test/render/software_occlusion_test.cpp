@@ -0,0 +1,322 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+#include "dolas_software_occlusion.h"
+#include "bounds_test_helpers.h"
+
+using namespace Dolas;
+
+namespace
+{
+    constexpr UInt kBufferWidth = 256;
+    constexpr UInt kBufferHeight = 128;
+
+    // 位于原点、朝 -Z 看的透视相机，near = 1, far = 100
+    Matrix4x4 MakeViewProjection()
+    {
+        return Matrix4x4::Perspective(MathUtil::PI * 0.5f, 2.0f, -100.0f, -1.0f);
+    }
+
+    Float ProjectDepth(const Matrix4x4& view_projection, const Vector3& point)
+    {
+        const Vector4 clip = view_projection * Vector4(point.x, point.y, point.z, 1.0f);
+        return clip.z / clip.w;
+    }
+
+    Vector2 ProjectToScreen(const Matrix4x4& view_projection, const Vector3& point)
+    {
+        const Vector4 clip = view_projection * Vector4(point.x, point.y, point.z, 1.0f);
+        return Vector2(
+            (clip.x / clip.w * 0.5f + 0.5f) * static_cast<Float>(kBufferWidth),
+            (0.5f - clip.y / clip.w * 0.5f) * static_cast<Float>(kBufferHeight));
+    }
+
+    // 面向相机的矩形，位于 z 平面上
+    void AddWall(SoftwareOcclusionBuffer& buffer, Float min_x, Float min_y, Float max_x, Float max_y, Float z)
+    {
+        const Float positions[] = {
+            min_x, min_y, z,
+            max_x, min_y, z,
+            max_x, max_y, z,
+            min_x, max_y, z,
+        };
+        const UInt indices[] = { 0, 1, 2, 0, 2, 3 };
+        buffer.AddOccluder(Matrix4x4::IDENTITY, positions, 4, 3, indices, 6);
+    }
+
+    void AddCube(SoftwareOcclusionBuffer& buffer, const Vector3& center, Float half_size)
+    {
+        std::vector<Float> positions;
+        for (UInt corner = 0; corner < 8; ++corner)
+        {
+            positions.push_back(center.x + ((corner & 1) ? half_size : -half_size));
+            positions.push_back(center.y + ((corner & 2) ? half_size : -half_size));
+            positions.push_back(center.z + ((corner & 4) ? half_size : -half_size));
+        }
+        const UInt indices[] = {
+            0, 1, 3, 0, 3, 2,  4, 6, 7, 4, 7, 5,
+            0, 4, 5, 0, 5, 1,  2, 3, 7, 2, 7, 6,
+            0, 2, 6, 0, 6, 4,  1, 5, 7, 1, 7, 3,
+        };
+        buffer.AddOccluder(Matrix4x4::IDENTITY, positions.data(), 8, 3, indices, 36);
+    }
+
+    void AddRandomTriangles(SoftwareOcclusionBuffer& buffer, UInt triangle_count, UInt seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<Float> lateral(-30.0f, 30.0f);
+        std::uniform_real_distribution<Float> depth(-60.0f, 2.0f); // 包含跨越近平面与相机后方的三角形
+        std::vector<Float> positions;
+        std::vector<UInt> indices;
+        for (UInt i = 0; i < triangle_count * 3; ++i)
+        {
+            positions.push_back(lateral(generator));
+            positions.push_back(lateral(generator));
+            positions.push_back(depth(generator));
+            indices.push_back(i);
+        }
+        buffer.AddOccluder(Matrix4x4::IDENTITY, positions.data(), triangle_count * 3, 3, indices.data(), triangle_count * 3);
+    }
+}
+
+TEST_CASE("Software rasterized wall matches reference depth", "[SoftwareOcclusion]")
+{
+    const Matrix4x4 view_projection = MakeViewProjection();
+    SoftwareOcclusionBuffer buffer;
+    buffer.Initialize(kBufferWidth, kBufferHeight);
+    buffer.BeginFrame(view_projection);
+    AddWall(buffer, -5.0f, -3.0f, 5.0f, 3.0f, -10.0f);
+    REQUIRE(buffer.GetTriangleCount() == 2);
+    buffer.RasterizeAll();
+
+    const Float reference_depth = ProjectDepth(view_projection, Vector3(0.0f, 0.0f, -10.0f));
+    const Vector2 screen_min = ProjectToScreen(view_projection, Vector3(-5.0f, 3.0f, -10.0f));
+    const Vector2 screen_max = ProjectToScreen(view_projection, Vector3(5.0f, -3.0f, -10.0f));
+
+    UInt covered_count = 0;
+    for (UInt y = 0; y < kBufferHeight; ++y)
+    {
+        for (UInt x = 0; x < kBufferWidth; ++x)
+        {
+            const Float pixel_x = static_cast<Float>(x) + 0.5f;
+            const Float pixel_y = static_cast<Float>(y) + 0.5f;
+            const Bool inside = pixel_x > screen_min.x + 0.01f && pixel_x < screen_max.x - 0.01f && pixel_y > screen_min.y + 0.01f && pixel_y < screen_max.y - 0.01f;
+            const Bool outside = pixel_x < screen_min.x - 0.01f || pixel_x > screen_max.x + 0.01f || pixel_y < screen_min.y - 0.01f || pixel_y > screen_max.y + 0.01f;
+            if (inside)
+            {
+                REQUIRE(std::abs(buffer.GetDepth(0, x, y) - reference_depth) < 1e-5f);
+                ++covered_count;
+            }
+            else if (outside)
+            {
+                REQUIRE(buffer.GetDepth(0, x, y) == 1.0f);
+            }
+        }
+    }
+    REQUIRE(covered_count > 100);
+}
+
+TEST_CASE("Software rasterized slanted floor matches ray-plane reference", "[SoftwareOcclusion]")
+{
+    // y = -2 的地面，从近平面内一直延伸到远平面之外，需要近平面裁剪
+    const Matrix4x4 view_projection = MakeViewProjection();
+    SoftwareOcclusionBuffer buffer;
+    buffer.Initialize(kBufferWidth, kBufferHeight);
+    buffer.BeginFrame(view_projection);
+    const Float positions[] = {
+        -200.0f, -2.0f, 5.0f,
+        200.0f, -2.0f, 5.0f,
+        200.0f, -2.0f, -90.0f,
+        -200.0f, -2.0f, -90.0f,
+    };
+    const UInt indices[] = { 0, 1, 2, 0, 2, 3 };
+    buffer.AddOccluder(Matrix4x4::IDENTITY, positions, 4, 3, indices, 6);
+    buffer.RasterizeAll();
+
+    const Float tan_half_x = 1.0f / view_projection.data[0][0];
+    const Float tan_half_y = 1.0f / view_projection.data[1][1];
+    UInt checked_count = 0;
+    for (UInt y = kBufferHeight / 2 + 1; y < kBufferHeight; ++y)
+    {
+        for (UInt x = 0; x < kBufferWidth; ++x)
+        {
+            const Float ndc_x = ((static_cast<Float>(x) + 0.5f) / kBufferWidth) * 2.0f - 1.0f;
+            const Float ndc_y = 1.0f - ((static_cast<Float>(y) + 0.5f) / kBufferHeight) * 2.0f;
+            // 视线 (ndc_x * tan_x, ndc_y * tan_y, -1) * t 与 y = -2 相交
+            const Float t = -2.0f / (ndc_y * tan_half_y);
+            if (t > 85.0f)
+            {
+                continue; // 远端边缘附近
+            }
+            const Float reference = ProjectDepth(view_projection, Vector3(ndc_x * tan_half_x * t, -2.0f, -t));
+            REQUIRE(std::abs(buffer.GetDepth(0, x, y) - reference) < 1e-4f);
+            ++checked_count;
+        }
+    }
+    REQUIRE(checked_count > 1000);
+    // 地平线以上没有覆盖
+    REQUIRE(buffer.GetDepth(0, 0, 0) == 1.0f);
+}
+
+TEST_CASE("SIMD and band-parallel rasterization match the scalar reference", "[SoftwareOcclusion]")
+{
+    const Matrix4x4 view_projection = MakeViewProjection();
+    SoftwareOcclusionBuffer simd_buffer;
+    SoftwareOcclusionBuffer scalar_buffer;
+    SoftwareOcclusionBuffer parallel_buffer;
+    for (SoftwareOcclusionBuffer* buffer : { &simd_buffer, &scalar_buffer, &parallel_buffer })
+    {
+        buffer->Initialize(kBufferWidth, kBufferHeight);
+        buffer->BeginFrame(view_projection);
+        AddRandomTriangles(*buffer, 500, 17);
+    }
+
+    simd_buffer.RasterizeAll();
+    for (UInt band = 0; band < scalar_buffer.GetBandCount(); ++band)
+    {
+        scalar_buffer.RasterizeBandScalar(band);
+    }
+    std::vector<std::thread> threads;
+    for (UInt band = 0; band < parallel_buffer.GetBandCount(); ++band)
+    {
+        threads.emplace_back([&parallel_buffer, band]() { parallel_buffer.RasterizeBand(band); });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    UInt covered_count = 0;
+    for (UInt y = 0; y < kBufferHeight; ++y)
+    {
+        for (UInt x = 0; x < kBufferWidth; ++x)
+        {
+            REQUIRE(simd_buffer.GetDepth(0, x, y) == scalar_buffer.GetDepth(0, x, y));
+            REQUIRE(parallel_buffer.GetDepth(0, x, y) == scalar_buffer.GetDepth(0, x, y));
+            covered_count += scalar_buffer.GetDepth(0, x, y) < 1.0f ? 1 : 0;
+        }
+    }
+    REQUIRE(covered_count > 0);
+}
+
+TEST_CASE("Hierarchical-Z keeps the farthest depth of each region", "[SoftwareOcclusion]")
+{
+    SoftwareOcclusionBuffer buffer;
+    buffer.Initialize(kBufferWidth, kBufferHeight);
+    buffer.BeginFrame(MakeViewProjection());
+    AddRandomTriangles(buffer, 200, 23);
+    buffer.RasterizeAll();
+    buffer.BuildHierarchicalZ();
+
+    const UInt level_count = buffer.GetHierarchicalZLevelCount();
+    REQUIRE(buffer.GetLevelWidth(level_count - 1) == 1);
+    REQUIRE(buffer.GetLevelHeight(level_count - 1) == 1);
+    for (UInt level = 1; level < level_count; ++level)
+    {
+        for (UInt y = 0; y < buffer.GetLevelHeight(level - 1); ++y)
+        {
+            for (UInt x = 0; x < buffer.GetLevelWidth(level - 1); ++x)
+            {
+                REQUIRE(buffer.GetDepth(level, x / 2, y / 2) >= buffer.GetDepth(level - 1, x, y));
+            }
+        }
+    }
+}
+
+TEST_CASE("Occlusion queries against a wall", "[SoftwareOcclusion]")
+{
+    SoftwareOcclusionBuffer buffer;
+    buffer.Initialize(kBufferWidth, kBufferHeight);
+    buffer.BeginFrame(MakeViewProjection());
+    AddWall(buffer, -5.0f, -5.0f, 5.0f, 5.0f, -10.0f);
+    buffer.RasterizeAll();
+    buffer.BuildHierarchicalZ();
+
+    REQUIRE(buffer.IsOccluded(MakeBox(Vector3(0.0f, 0.0f, -20.0f), 1.0f)));
+    REQUIRE(buffer.IsOccluded(MakeBox(Vector3(6.0f, -6.0f, -40.0f), 3.0f)));
+    REQUIRE_FALSE(buffer.IsOccluded(MakeBox(Vector3(9.0f, 0.0f, -20.0f), 3.0f)));   // 部分露出墙的轮廓
+    REQUIRE_FALSE(buffer.IsOccluded(MakeBox(Vector3(0.0f, 0.0f, -5.0f), 1.0f)));    // 在墙前面
+    REQUIRE_FALSE(buffer.IsOccluded(MakeBox(Vector3(0.0f, 0.0f, -10.5f), 1.0f)));   // 与墙相交
+    REQUIRE_FALSE(buffer.IsOccluded(MakeBox(Vector3(0.0f, 0.0f, 0.0f), 2.0f)));     // 跨越近平面
+    REQUIRE_FALSE(buffer.IsOccluded(MakeBox(Vector3(0.0f, 0.0f, 20.0f), 1.0f)));    // 相机后方
+    REQUIRE_FALSE(buffer.IsOccluded(BoundingBox()));
+
+    CullingBoundsSoA bounds;
+    bounds.Add(MakeBox(Vector3(0.0f, 0.0f, -20.0f), 1.0f));
+    bounds.Add(MakeBox(Vector3(0.0f, 0.0f, -5.0f), 1.0f));
+    bounds.Add(MakeBox(Vector3(1.0f, 1.0f, -30.0f), 1.0f));
+    std::vector<UByte> visibility = { 1, 1, 0 };
+    REQUIRE(buffer.CullOccludedBoxes(bounds, 0, bounds.GetCount(), visibility.data()) == 1);
+    REQUIRE(visibility == std::vector<UByte>({ 0, 1, 0 }));
+}
+
+TEST_CASE("Software occlusion culling timing", "[.][benchmark][SoftwareOcclusion]")
+{
+    constexpr UInt kOccluderCount = 256;
+    constexpr UInt kBoxCount = 100000;
+    const Matrix4x4 view_projection = MakeViewProjection();
+    std::mt19937 generator(9);
+    std::uniform_real_distribution<Float> lateral(-40.0f, 40.0f);
+    std::uniform_real_distribution<Float> depth(-90.0f, -5.0f);
+
+    std::vector<Vector3> occluder_centers;
+    for (UInt i = 0; i < kOccluderCount; ++i)
+    {
+        occluder_centers.push_back(Vector3(lateral(generator), lateral(generator) * 0.5f, depth(generator)));
+    }
+    CullingBoundsSoA bounds;
+    for (UInt i = 0; i < kBoxCount; ++i)
+    {
+        bounds.Add(MakeBox(Vector3(lateral(generator), lateral(generator) * 0.5f, depth(generator)), 0.5f));
+    }
+
+    SoftwareOcclusionBuffer buffer;
+    buffer.Initialize(kBufferWidth, kBufferHeight);
+    auto setup = [&]()
+    {
+        buffer.BeginFrame(view_projection);
+        for (const Vector3& center : occluder_centers)
+        {
+            AddCube(buffer, center, 3.0f);
+        }
+    };
+
+    BENCHMARK("setup + rasterize (1 thread)")
+    {
+        setup();
+        buffer.RasterizeAll();
+        return buffer.GetTriangleCount();
+    };
+
+    BENCHMARK("setup + rasterize (band parallel)")
+    {
+        setup();
+        std::vector<std::thread> threads;
+        for (UInt band = 0; band < buffer.GetBandCount(); ++band)
+        {
+            threads.emplace_back([&buffer, band]() { buffer.RasterizeBand(band); });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        return buffer.GetTriangleCount();
+    };
+
+    BENCHMARK("build hierarchical-z")
+    {
+        buffer.BuildHierarchicalZ();
+        return buffer.GetHierarchicalZLevelCount();
+    };
+
+    std::vector<UByte> visibility(kBoxCount);
+    BENCHMARK("test 100k boxes")
+    {
+        std::fill(visibility.begin(), visibility.end(), UByte(1));
+        return buffer.CullOccludedBoxes(bounds, 0, kBoxCount, visibility.data());
+    };
+}
@@ -0,0 +1,402 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "dolas_block_compression.h"
+#include "dolas_texture_cook.h"
+
+using namespace Dolas;
+
+namespace
+{
+    // 平滑渐变叠加少量噪声，接近真实照片纹理的块内分布
+    TextureImage MakeTestImage(UInt width, UInt height, UInt seed, Bool with_alpha)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<Float> noise(-0.03f, 0.03f);
+        TextureImage image;
+        image.Resize(width, height);
+        for (UInt y = 0; y < height; ++y)
+        {
+            for (UInt x = 0; x < width; ++x)
+            {
+                const Float u = (x + 0.5f) / width;
+                const Float v = (y + 0.5f) / height;
+                Float* pixel = image.GetPixel(x, y);
+                pixel[0] = std::clamp(0.2f + 0.6f * u + noise(generator), 0.0f, 1.0f);
+                pixel[1] = std::clamp(0.5f + 0.4f * std::sin(6.0f * v) + noise(generator), 0.0f, 1.0f);
+                pixel[2] = std::clamp(0.8f - 0.5f * u * v + noise(generator), 0.0f, 1.0f);
+                pixel[3] = with_alpha ? std::clamp(v + noise(generator), 0.0f, 1.0f) : 1.0f;
+            }
+        }
+        return image;
+    }
+
+    std::vector<UByte> Compress(BlockFormat format, const TextureImage& image, Bool scalar)
+    {
+        std::vector<UByte> blocks(static_cast<std::size_t>(ComputeBlockCompressedSize(format, image.width, image.height)));
+        const UInt block_rows = (image.height + 3) / 4;
+        if (scalar)
+        {
+            CompressBlockRowsScalar(format, image.pixels.data(), image.width, image.height, 0, block_rows, blocks.data());
+        }
+        else
+        {
+            CompressBlockRows(format, image.pixels.data(), image.width, image.height, 0, block_rows, blocks.data());
+        }
+        return blocks;
+    }
+
+    // 块数据解码回图像（宽高为 4 的倍数）
+    TextureImage Decompress(BlockFormat format, const std::vector<UByte>& blocks, UInt width, UInt height)
+    {
+        TextureImage image;
+        image.Resize(width, height);
+        const UInt block_columns = width / 4;
+        for (UInt block_y = 0; block_y < height / 4; ++block_y)
+        {
+            for (UInt block_x = 0; block_x < block_columns; ++block_x)
+            {
+                Float texels[BLOCK_TEXEL_COUNT * 4];
+                const UByte* block = blocks.data() + (static_cast<std::size_t>(block_y) * block_columns + block_x) * GetBlockFormatBytes(format);
+                CHECK(DecodeBlock(format, block, texels));
+                for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+                {
+                    std::copy(texels + i * 4, texels + i * 4 + 4, image.GetPixel(block_x * 4 + (i & 3), block_y * 4 + (i >> 2)));
+                }
+            }
+        }
+        return image;
+    }
+
+    Double ComputePSNR(const TextureImage& a, const TextureImage& b, UInt channel_begin, UInt channel_end)
+    {
+        Double error = 0.0;
+        for (std::size_t pixel = 0; pixel < a.pixels.size(); pixel += 4)
+        {
+            for (UInt c = channel_begin; c < channel_end; ++c)
+            {
+                const Double difference = a.pixels[pixel + c] - b.pixels[pixel + c];
+                error += difference * difference;
+            }
+        }
+        const Double mse = error / (a.pixels.size() / 4 * (channel_end - channel_begin));
+        return mse <= 0.0 ? 100.0 : 10.0 * std::log10(1.0 / mse);
+    }
+}
+
+TEST_CASE("Block compression round trips at the expected quality", "[TextureCompression]")
+{
+    const TextureImage image = MakeTestImage(64, 64, 7, true);
+
+    struct Expectation
+    {
+        BlockFormat format;
+        UInt channel_begin;
+        UInt channel_end;
+        Double min_psnr;
+    };
+    const Expectation expectations[] = {
+        { BlockFormat::BC1, 0, 3, 32.0 },
+        { BlockFormat::BC3, 0, 4, 32.0 },
+        { BlockFormat::BC4, 0, 1, 38.0 },
+        { BlockFormat::BC5, 0, 2, 38.0 },
+        { BlockFormat::BC7, 0, 4, 36.0 },
+    };
+    for (const Expectation& expectation : expectations)
+    {
+        const std::vector<UByte> blocks = Compress(expectation.format, image, false);
+        CHECK(blocks.size() == 16ull * 16 * GetBlockFormatBytes(expectation.format));
+        const TextureImage decoded = Decompress(expectation.format, blocks, image.width, image.height);
+        const Double psnr = ComputePSNR(image, decoded, expectation.channel_begin, expectation.channel_end);
+        CHECK(psnr > expectation.min_psnr);
+    }
+
+    // 纯色块：BC4 与 BC7 的端点精度足以精确还原 8 位值
+    Float solid[BLOCK_TEXEL_COUNT * 4];
+    for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+    {
+        solid[i * 4 + 0] = 200.0f / 255.0f;
+        solid[i * 4 + 1] = 17.0f / 255.0f;
+        solid[i * 4 + 2] = 96.0f / 255.0f;
+        solid[i * 4 + 3] = 1.0f;
+    }
+    UByte block[16];
+    Float decoded[BLOCK_TEXEL_COUNT * 4];
+    EncodeBlock(BlockFormat::BC7, solid, block);
+    REQUIRE(DecodeBlock(BlockFormat::BC7, block, decoded));
+    for (UInt i = 0; i < BLOCK_TEXEL_COUNT * 4; ++i)
+    {
+        CHECK(std::fabs(decoded[i] - solid[i]) < 1.0f / 255.0f);
+    }
+    EncodeBlock(BlockFormat::BC4, solid, block);
+    REQUIRE(DecodeBlock(BlockFormat::BC4, block, decoded));
+    CHECK(decoded[0] == 200.0f / 255.0f);
+
+    // 其他 BC7 模式不在解码器的支持范围内
+    std::memset(block, 0, sizeof(block));
+    block[0] = 0x01;
+    CHECK_FALSE(DecodeBlock(BlockFormat::BC7, block, decoded));
+}
+
+TEST_CASE("BC6H keeps HDR values within half-float precision", "[TextureCompression]")
+{
+    CHECK(FloatToHalf(1.0f) == 0x3C00);
+    CHECK(FloatToHalf(65504.0f) == 0x7BFF);
+    CHECK(FloatToHalf(-2.0f) == 0xC000);
+    CHECK(FloatToHalf(1.0e6f) == 0x7C00);
+    CHECK(HalfToFloat(0x3555) == HalfToFloat(FloatToHalf(0.33325195f)));
+    for (UInt half = 0; half < 0x7C00; half += 37)
+    {
+        CHECK(FloatToHalf(HalfToFloat(half)) == half);
+    }
+
+    // 指数分布的亮度（0.01 到 1000），BC6H 在半精度位模式上插值，误差近似为相对误差
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<Float> exponent(-2.0f, 3.0f);
+    Float max_relative_error = 0.0f;
+    for (UInt block_index = 0; block_index < 64; ++block_index)
+    {
+        const Float base = std::pow(10.0f, exponent(generator));
+        Float texels[BLOCK_TEXEL_COUNT * 4];
+        for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+        {
+            const Float t = i / 15.0f;
+            texels[i * 4 + 0] = base * (1.0f + t);
+            texels[i * 4 + 1] = base * (0.8f + 0.4f * t);
+            texels[i * 4 + 2] = base * (1.2f - 0.4f * t);
+            texels[i * 4 + 3] = 1.0f;
+        }
+        UByte block[16];
+        Float decoded[BLOCK_TEXEL_COUNT * 4];
+        EncodeBlock(BlockFormat::BC6H, texels, block);
+        REQUIRE(DecodeBlock(BlockFormat::BC6H, block, decoded));
+        for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+        {
+            for (UInt c = 0; c < 3; ++c)
+            {
+                max_relative_error = std::max(max_relative_error, std::fabs(decoded[i * 4 + c] - texels[i * 4 + c]) / texels[i * 4 + c]);
+            }
+            CHECK(decoded[i * 4 + 3] == 1.0f);
+        }
+    }
+    CHECK(max_relative_error < 0.1f);
+
+    // 超出半精度范围的值截断到最大有限值，负值截断到 0
+    Float extreme[BLOCK_TEXEL_COUNT * 4];
+    for (UInt i = 0; i < BLOCK_TEXEL_COUNT; ++i)
+    {
+        extreme[i * 4 + 0] = 1.0e9f;
+        extreme[i * 4 + 1] = -5.0f;
+        extreme[i * 4 + 2] = 1.0f;
+        extreme[i * 4 + 3] = 1.0f;
+    }
+    UByte block[16];
+    Float decoded[BLOCK_TEXEL_COUNT * 4];
+    EncodeBlock(BlockFormat::BC6H, extreme, block);
+    REQUIRE(DecodeBlock(BlockFormat::BC6H, block, decoded));
+    CHECK(decoded[0] > 60000.0f);
+    CHECK(std::isfinite(decoded[0]));
+    CHECK(decoded[1] == 0.0f);
+    CHECK(std::fabs(decoded[2] - 1.0f) < 0.01f);
+}
+
+TEST_CASE("Block compression SIMD path matches the scalar reference bit for bit", "[TextureCompression]")
+{
+    // 宽高不是 4 的倍数，覆盖边缘块
+    TextureImage image = MakeTestImage(37, 23, 11, true);
+    for (BlockFormat format : { BlockFormat::BC1, BlockFormat::BC3, BlockFormat::BC4, BlockFormat::BC5, BlockFormat::BC7 })
+    {
+        CHECK(Compress(format, image, false) == Compress(format, image, true));
+    }
+
+    TextureImage hdr = image;
+    for (std::size_t i = 0; i < hdr.pixels.size(); ++i)
+    {
+        hdr.pixels[i] = std::pow(2.0f, hdr.pixels[i] * 20.0f - 8.0f);
+    }
+    CHECK(Compress(BlockFormat::BC6H, hdr, false) == Compress(BlockFormat::BC6H, hdr, true));
+
+    // 分段压缩与整体压缩结果相同
+    std::vector<UByte> chunked(static_cast<std::size_t>(ComputeBlockCompressedSize(BlockFormat::BC7, image.width, image.height)));
+    for (UInt block_row = 0; block_row < 6; block_row += 2)
+    {
+        CompressBlockRows(BlockFormat::BC7, image.pixels.data(), image.width, image.height, block_row, std::min(block_row + 2, 6u), chunked.data());
+    }
+    CHECK(chunked == Compress(BlockFormat::BC7, image, false));
+}
+
+TEST_CASE("Texture cook builds the mip chain and DDS container", "[TextureCompression]")
+{
+    CHECK(ComputeFullMipCount(1, 1) == 1);
+    CHECK(ComputeFullMipCount(256, 64) == 9);
+    CHECK(ComputeFullMipCount(100, 37) == 7);
+
+    CHECK(SelectTextureBlockFormat(TextureCookUsage::Albedo, false, false) == BlockFormat::BC1);
+    CHECK(SelectTextureBlockFormat(TextureCookUsage::Albedo, true, false) == BlockFormat::BC3);
+    CHECK(SelectTextureBlockFormat(TextureCookUsage::Albedo, false, true) == BlockFormat::BC7);
+    CHECK(SelectTextureBlockFormat(TextureCookUsage::Normal, false, false) == BlockFormat::BC5);
+    CHECK(SelectTextureBlockFormat(TextureCookUsage::Mask, false, false) == BlockFormat::BC4);
+    CHECK(SelectTextureBlockFormat(TextureCookUsage::HDR, false, false) == BlockFormat::BC6H);
+
+    const TextureImage image = MakeTestImage(64, 32, 5, false);
+    TextureCookSettings settings;
+    CookedTexture serial;
+    REQUIRE(CookTexture(image, settings, serial));
+    CHECK(serial.format == BlockFormat::BC1);
+    REQUIRE(serial.mips.size() == 7);
+    const UInt expected_blocks[7] = { 16 * 8, 8 * 4, 4 * 2, 2 * 1, 1, 1, 1 };
+    for (std::size_t mip = 0; mip < serial.mips.size(); ++mip)
+    {
+        CHECK(serial.mips[mip].size() == expected_blocks[mip] * 8ull);
+    }
+    CHECK(serial.encoded_texel_count == 64 * 32 + 32 * 16 + 16 * 8 + 8 * 4 + 4 * 2 + 2 * 1 + 1);
+    // 相对 RGBA8 的完整 mip 链为 1/8
+    CHECK(serial.GetByteSize() * 8 == ComputeBlockCompressedSize(BlockFormat::BC1, 64, 32) * 8 + (32 + 8 + 2 + 1 + 1 + 1) * 64ull);
+
+    // 结果与分段方式无关
+    CookedTexture parallel;
+    REQUIRE(CookTexture(image, settings, parallel, [](UInt count, const std::function<void(UInt, UInt)>& task)
+    {
+        for (UInt begin = 0; begin < count; begin += 3)
+        {
+            task(begin, std::min(begin + 3, count));
+        }
+    }));
+    CHECK(parallel.mips == serial.mips);
+
+    const std::vector<UByte> dds = BuildCookedTextureDDS(serial);
+    REQUIRE(dds.size() == 4 + 124 + 20 + serial.GetByteSize());
+    auto read_uint = [&dds](std::size_t offset)
+    {
+        return UInt(dds[offset]) | (UInt(dds[offset + 1]) << 8) | (UInt(dds[offset + 2]) << 16) | (UInt(dds[offset + 3]) << 24);
+    };
+    CHECK(std::memcmp(dds.data(), "DDS ", 4) == 0);
+    CHECK(read_uint(4) == 124);
+    CHECK(read_uint(12) == 32);      // height
+    CHECK(read_uint(16) == 64);      // width
+    CHECK(read_uint(28) == 7);       // mip count
+    CHECK(std::memcmp(dds.data() + 84, "DX10", 4) == 0);
+    CHECK(read_uint(128) == 71);     // DXGI_FORMAT_BC1_UNORM
+    CHECK(read_uint(140) == 1);      // array size
+    CHECK(std::equal(serial.mips[0].begin(), serial.mips[0].end(), dds.begin() + 148));
+}
+
+TEST_CASE("Texture mip filtering keeps normals unit length and colors in linear space", "[TextureCompression]")
+{
+    // 黑白棋盘格：线性空间平均为 0.5，对应 sRGB 约 0.735；直接在 sRGB 上平均会得到偏暗的 0.5
+    TextureImage checker;
+    checker.Resize(16, 16);
+    for (UInt y = 0; y < 16; ++y)
+    {
+        for (UInt x = 0; x < 16; ++x)
+        {
+            const Float value = ((x + y) & 1) ? 1.0f : 0.0f;
+            std::fill(checker.GetPixel(x, y), checker.GetPixel(x, y) + 3, value);
+            checker.GetPixel(x, y)[3] = 1.0f;
+        }
+    }
+    TextureImage linear = checker;
+    ConvertImageRowsSRGBToLinear(linear, 0, linear.height);
+    TextureImage half;
+    half.Resize(8, 8);
+    DownsampleImageRows(linear, TextureCookUsage::Albedo, 0, half.height, half);
+    ConvertImageRowsLinearToSRGB(half, 0, half.height);
+    CHECK(std::fabs(half.GetPixel(4, 4)[0] - 0.7354f) < 0.01f);
+    CHECK(half.GetPixel(4, 4)[3] == 1.0f);
+
+    // 两个方向相反的斜向法线平均后重新归一化为朝上的单位法线（边缘按 clamp 处理，只检查内部）
+    TextureImage normals;
+    normals.Resize(32, 4);
+    for (UInt y = 0; y < normals.height; ++y)
+    {
+        for (UInt x = 0; x < normals.width; ++x)
+        {
+            const Float slope = (x & 1) ? 0.6f : -0.6f;
+            Float* pixel = normals.GetPixel(x, y);
+            pixel[0] = slope * 0.5f + 0.5f;
+            pixel[1] = 0.5f;
+            pixel[2] = 0.8f * 0.5f + 0.5f;
+            pixel[3] = 1.0f;
+        }
+    }
+    TextureImage normal_mip;
+    normal_mip.Resize(16, 2);
+    DownsampleImageRows(normals, TextureCookUsage::Normal, 0, normal_mip.height, normal_mip);
+    for (UInt y = 0; y < normal_mip.height; ++y)
+    {
+        for (UInt x = 0; x < normal_mip.width; ++x)
+        {
+            const Float* pixel = normal_mip.GetPixel(x, y);
+            const Float nx = pixel[0] * 2.0f - 1.0f;
+            const Float ny = pixel[1] * 2.0f - 1.0f;
+            const Float nz = pixel[2] * 2.0f - 1.0f;
+            CHECK(std::fabs(nx * nx + ny * ny + nz * nz - 1.0f) < 1.0e-4f);
+            if (x >= 3 && x + 3 < normal_mip.width)
+            {
+                CHECK(nz > 0.999f);
+            }
+        }
+    }
+
+    // HDR 使用帐篷滤波：亮点周围不会出现负值或振铃
+    TextureImage hdr;
+    hdr.Resize(16, 1);
+    for (UInt x = 0; x < 16; ++x)
+    {
+        hdr.GetPixel(x, 0)[0] = x == 8 ? 10000.0f : 0.1f;
+        hdr.GetPixel(x, 0)[3] = 1.0f;
+    }
+    TextureImage hdr_mip;
+    hdr_mip.Resize(8, 1);
+    DownsampleImageRows(hdr, TextureCookUsage::HDR, 0, 1, hdr_mip);
+    for (UInt x = 0; x < 8; ++x)
+    {
+        CHECK(hdr_mip.GetPixel(x, 0)[0] >= 0.1f - 1.0e-4f);
+    }
+    Float energy = 0.0f;
+    for (UInt x = 0; x < 8; ++x)
+    {
+        energy += hdr_mip.GetPixel(x, 0)[0] * 2.0f;
+    }
+    CHECK(std::fabs(energy - (10000.0f + 15 * 0.1f)) < 1.0f);
+}
+
+TEST_CASE("Radiance HDR decoder reads flat and run-length encoded scanlines", "[TextureCompression]")
+{
+    const UInt width = 8;
+    std::vector<UByte> file;
+    const std::string header = "#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y 2 +X 8\n";
+    file.insert(file.end(), header.begin(), header.end());
+    // 第 0 行：RLE，R 为 8 个 128，G 为字面量 0..7，B 为 4 + 4 的游程，E 全为 129（缩放 2^-7）
+    file.insert(file.end(), { 2, 2, 0, UByte(width) });
+    file.insert(file.end(), { 128 + 8, 128 });
+    file.push_back(8);
+    for (UByte g = 0; g < 8; ++g) file.push_back(g);
+    file.insert(file.end(), { 128 + 4, 64, 128 + 4, 0 });
+    file.insert(file.end(), { 128 + 8, 129 });
+    // 第 1 行：平铺的 RGBE
+    for (UInt x = 0; x < width; ++x)
+    {
+        file.insert(file.end(), { 128, 64, 32, UByte(x == 0 ? 0 : 130) });
+    }
+
+    TextureImage image;
+    REQUIRE(DecodeRadianceHDR(file.data(), file.size(), image));
+    REQUIRE(image.width == 8);
+    REQUIRE(image.height == 2);
+    CHECK(image.GetPixel(0, 0)[0] == 1.0f);
+    CHECK(image.GetPixel(5, 0)[1] == 5.0f / 128.0f);
+    CHECK(image.GetPixel(3, 0)[2] == 0.5f);
+    CHECK(image.GetPixel(4, 0)[2] == 0.0f);
+    CHECK(image.GetPixel(0, 1)[0] == 0.0f);
+    CHECK(image.GetPixel(1, 1)[0] == 2.0f);
+    CHECK(image.GetPixel(1, 1)[3] == 1.0f);
+
+    file.resize(file.size() - 5);
+    CHECK_FALSE(DecodeRadianceHDR(file.data(), file.size(), image));
+    const std::string xyze = "#?RADIANCE\nFORMAT=32-bit_rle_xyze\n\n-Y 1 +X 1\n";
+    CHECK_FALSE(DecodeRadianceHDR(reinterpret_cast<const UByte*>(xyze.data()), xyze.size(), image));
+}
@@ -0,0 +1,216 @@
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+#include "dolas_texture_streaming.h"
+
+using namespace Dolas;
+
+namespace
+{
+    // RGBA8 的完整 mip 链
+    std::vector<ULongLong> MakeMipBytes(UInt size)
+    {
+        std::vector<ULongLong> mip_bytes;
+        for (UInt mip_size = size; mip_size > 0; mip_size >>= 1)
+        {
+            mip_bytes.push_back(4ull * mip_size * mip_size);
+        }
+        return mip_bytes;
+    }
+
+    ULongLong BytesFromMip(UInt size, UInt first_mip)
+    {
+        const std::vector<ULongLong> mip_bytes = MakeMipBytes(size);
+        ULongLong bytes = 0;
+        for (std::size_t mip = first_mip; mip < mip_bytes.size(); ++mip)
+        {
+            bytes += mip_bytes[mip];
+        }
+        return bytes;
+    }
+
+    // 模拟一帧：请求在下一帧之前全部完成；返回本帧的请求数
+    std::size_t SimulateFrame(TextureStreamingPolicy& policy, const TextureStreamingFeedback& feedback)
+    {
+        std::vector<TextureStreamingRequest> requests;
+        policy.Update(feedback, requests);
+        for (const TextureStreamingRequest& request : requests)
+        {
+            policy.OnStreamingFinished(request.texture_id, request.first_mip);
+        }
+        return requests.size();
+    }
+}
+
+TEST_CASE("Texture streaming mip selection from screen-space UV density", "[TextureStreaming]")
+{
+    CHECK(ComputeTailFirstMip(1024, 1024, 11, 128) == 3);
+    CHECK(ComputeTailFirstMip(1024, 256, 11, 128) == 3);
+    CHECK(ComputeTailFirstMip(64, 64, 7, 128) == 0);
+    CHECK(ComputeTailFirstMip(4096, 4096, 1, 128) == 0);   // 没有 mip 链时只有 mip 0
+
+    // 一个纹素对应一个像素
+    CHECK(ComputeDesiredMip(1024, 1024, 11, 1024.0f) == 0);
+    CHECK(ComputeDesiredMip(1024, 1024, 11, 4096.0f) == 0);
+    CHECK(ComputeDesiredMip(1024, 1024, 11, 512.0f) == 1);
+    CHECK(ComputeDesiredMip(1024, 1024, 11, 300.0f) == 1);
+    CHECK(ComputeDesiredMip(1024, 1024, 11, 256.0f) == 2);
+    CHECK(ComputeDesiredMip(1024, 1024, 11, 0.5f) == 10);
+    CHECK(ComputeDesiredMip(1024, 1024, 11, 0.0f) == 10);
+    CHECK(ComputeDesiredMip(1024, 1024, 11, 512.0f, 1.0f) == 2);
+
+    // 半径 1、距离 10、[1][1] = 2、720p：直径投影为 0.2 * 360 * 2 = 144 像素
+    CHECK(EstimateScreenPixelsPerUV(1.0f, 10.0f, 2.0f, 720.0f) == 144.0f);
+    CHECK(ComputeDesiredMip(1024, 1024, 11, EstimateScreenPixelsPerUV(1.0f, 0.5f, 2.0f, 720.0f)) == 0);
+
+    TextureStreamingFeedback feedback;
+    feedback.Record(7, 100.0f);
+    feedback.Record(7, 300.0f);
+    feedback.Record(7, 200.0f);
+    CHECK(feedback.Get(7) == 300.0f);
+    CHECK(feedback.Get(8) == 0.0f);
+}
+
+TEST_CASE("Texture streaming streams in visible textures and drops them after the delay", "[TextureStreaming]")
+{
+    TextureStreamingDesc desc;
+    desc.budget_bytes = 64ull << 20;
+    desc.max_stream_in_bytes_per_update = 2ull << 20;
+    desc.tail_mip_size = 128;
+    desc.drop_delay_frames = 5;
+    TextureStreamingPolicy policy;
+    policy.Initialize(desc);
+
+    for (TextureID texture_id = 1; texture_id <= 3; ++texture_id)
+    {
+        policy.RegisterTexture(texture_id, 1024, 1024, MakeMipBytes(1024));
+        CHECK(policy.GetTailFirstMip(texture_id) == 3);
+    }
+    // 只加载尾部
+    std::vector<TextureStreamingRequest> requests;
+    policy.Update(TextureStreamingFeedback{}, requests);
+    CHECK(requests.empty());
+    for (TextureID texture_id = 1; texture_id <= 3; ++texture_id)
+    {
+        policy.OnStreamingFinished(texture_id, 3);
+    }
+    CHECK(policy.GetResidentBytes() == 3 * BytesFromMip(1024, 3));
+
+    // 纹理 1 近处全屏，纹理 2 需要 mip 2，纹理 3 看不到
+    TextureStreamingFeedback feedback;
+    feedback.Record(1, 2000.0f);
+    feedback.Record(2, 256.0f);
+    ULongLong previous_resident = policy.GetResidentBytes();
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        SimulateFrame(policy, feedback);
+        // 每帧新增的常驻字节受限（每次至少前进一级 mip）
+        CHECK(policy.GetResidentBytes() - previous_resident <= 4ull << 20);
+        previous_resident = policy.GetResidentBytes();
+    }
+    CHECK(policy.GetResidentFirstMip(1) == 0);
+    CHECK(policy.GetResidentFirstMip(2) == 2);
+    CHECK(policy.GetResidentFirstMip(3) == 3);
+    CHECK(policy.GetResidentBytes() == BytesFromMip(1024, 0) + BytesFromMip(1024, 2) + BytesFromMip(1024, 3));
+
+    TextureStreamingStatistics statistics = policy.GetStatistics();
+    CHECK(statistics.texture_count == 3);
+    CHECK(statistics.streaming_count == 0);
+    CHECK(statistics.resident_bytes == policy.GetResidentBytes());
+    CHECK(statistics.wanted_bytes == statistics.resident_bytes);
+    CHECK(statistics.tail_bytes == 3 * BytesFromMip(1024, 3));
+
+    // 纹理 1 离开视野：滞后期内保持常驻，之后回到尾部
+    TextureStreamingFeedback far_feedback;
+    far_feedback.Record(2, 256.0f);
+    for (UInt frame = 0; frame + 1 < desc.drop_delay_frames; ++frame)
+    {
+        CHECK(SimulateFrame(policy, far_feedback) == 0);
+    }
+    CHECK(policy.GetResidentFirstMip(1) == 0);
+    CHECK(SimulateFrame(policy, far_feedback) == 1);
+    CHECK(policy.GetResidentFirstMip(1) == 3);
+    CHECK(policy.GetResidentFirstMip(2) == 2);
+
+    // 短暂离开又回来不会流出
+    for (int frame = 0; frame < 20; ++frame)
+    {
+        const Bool visible = frame % 3 != 2;
+        CHECK(SimulateFrame(policy, visible ? far_feedback : TextureStreamingFeedback{}) == 0);
+    }
+    CHECK(policy.GetResidentFirstMip(2) == 2);
+
+    policy.UnregisterTexture(2);
+    CHECK(policy.GetResidentBytes() == 2 * BytesFromMip(1024, 3));
+}
+
+TEST_CASE("Texture streaming stays within budget and keeps recently used mips", "[TextureStreaming]")
+{
+    TextureStreamingDesc desc;
+    desc.budget_bytes = BytesFromMip(1024, 0) + 4 * BytesFromMip(1024, 3);   // 只放得下一个完整的 1024
+    desc.max_stream_in_bytes_per_update = 64ull << 20;
+    desc.drop_delay_frames = 3;
+    TextureStreamingPolicy policy;
+    policy.Initialize(desc);
+
+    for (TextureID texture_id = 1; texture_id <= 4; ++texture_id)
+    {
+        policy.RegisterTexture(texture_id, 1024, 1024, MakeMipBytes(1024));
+        policy.OnStreamingFinished(texture_id, policy.GetTailFirstMip(texture_id));
+    }
+
+    // 合成的使用轨迹：相机依次走近纹理 1、2、3、4，每个停留 10 帧，其余纹理在远处（mip 2）
+    for (TextureID focus = 1; focus <= 4; ++focus)
+    {
+        for (int frame = 0; frame < 10; ++frame)
+        {
+            TextureStreamingFeedback feedback;
+            for (TextureID texture_id = 1; texture_id <= 4; ++texture_id)
+            {
+                feedback.Record(texture_id, texture_id == focus ? 2048.0f : 256.0f);
+            }
+
+            std::vector<TextureStreamingRequest> requests;
+            policy.Update(feedback, requests);
+            // 先完成流出再完成流入，任何时刻都不超过预算
+            for (const TextureStreamingRequest& request : requests)
+            {
+                if (request.first_mip > policy.GetResidentFirstMip(request.texture_id))
+                {
+                    policy.OnStreamingFinished(request.texture_id, request.first_mip);
+                }
+            }
+            for (const TextureStreamingRequest& request : requests)
+            {
+                if (request.first_mip < policy.GetResidentFirstMip(request.texture_id))
+                {
+                    policy.OnStreamingFinished(request.texture_id, request.first_mip);
+                    CHECK(policy.GetResidentBytes() <= desc.budget_bytes);
+                }
+            }
+            CHECK(policy.GetResidentBytes() <= desc.budget_bytes);
+        }
+
+        // 停留足够久之后，正在看的纹理拿到最高精度（被降级的是其他纹理）
+        CHECK(policy.GetResidentFirstMip(focus) == 0);
+        const TextureStreamingStatistics statistics = policy.GetStatistics();
+        CHECK(statistics.wanted_bytes > statistics.budget_bytes);
+        CHECK(statistics.target_bytes <= statistics.budget_bytes);
+        for (TextureID texture_id = 1; texture_id <= 4; ++texture_id)
+        {
+            if (texture_id != focus)
+            {
+                CHECK(policy.GetResidentFirstMip(texture_id) >= 1);
+            }
+        }
+    }
+
+    // 尾部本身超过预算时无法再降低，保持尾部常驻
+    policy.SetBudget(1);
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        SimulateFrame(policy, TextureStreamingFeedback{});
+    }
+    const TextureStreamingStatistics statistics = policy.GetStatistics();
+    CHECK(statistics.resident_bytes == statistics.tail_bytes);
+    CHECK(statistics.target_bytes == statistics.tail_bytes);
+}
@@ -0,0 +1,138 @@
+#include <catch2/catch_test_macros.hpp>
+#include "dolas_texture_upload.h"
+
+using namespace Dolas;
+
+TEST_CASE("UploadRingAllocator wraps around and reclaims retired batches", "[TextureUpload]")
+{
+    UploadRingAllocator ring;
+    ring.Initialize(1024);
+
+    CHECK(ring.Allocate(300, 256) == 0);
+    CHECK(ring.Allocate(300, 256) == 512);
+    ring.Submit(1);
+    CHECK(ring.GetUsedBytes() == 812);
+
+    // 尾部只剩 212 字节，头部还被批次 1 占用
+    CHECK(ring.Allocate(256, 256) == UploadRingAllocator::INVALID_OFFSET);
+    CHECK(ring.Allocate(2048, 1) == UploadRingAllocator::INVALID_OFFSET);
+
+    ring.Retire(0);
+    CHECK(ring.HasPendingBatches());
+    ring.Retire(1);
+    CHECK_FALSE(ring.HasPendingBatches());
+    CHECK(ring.GetUsedBytes() == 0);
+
+    // 空环从头开始；绕回时跳过的尾部字节计入批次，回收后归零
+    CHECK(ring.Allocate(700, 256) == 0);
+    ring.Submit(2);
+    CHECK(ring.Allocate(200, 256) == 768);
+    ring.Submit(3);
+    ring.Retire(2);
+    CHECK(ring.Allocate(600, 256) == 0);
+    CHECK(ring.Allocate(200, 256) == UploadRingAllocator::INVALID_OFFSET);
+    ring.Submit(4);
+    CHECK(ring.GetUsedBytes() == 268 + 56 + 600);
+    ring.Retire(4);
+    CHECK(ring.GetUsedBytes() == 0);
+}
+
+TEST_CASE("TextureLoadScheduler limits decodes and batches copies across textures", "[TextureUpload]")
+{
+    TextureLoadSchedulerDesc desc;
+    desc.max_concurrent_decodes = 2;
+    desc.staging_capacity = 4096;
+    desc.max_batch_bytes = 2048;
+    desc.placement_alignment = 512;
+
+    TextureLoadScheduler scheduler;
+    scheduler.Initialize(desc);
+    const auto a = scheduler.AddRequest();
+    const auto b = scheduler.AddRequest();
+    const auto c = scheduler.AddRequest();
+
+    std::vector<TextureLoadScheduler::RequestID> decode_requests;
+    scheduler.TakeDecodeRequests(decode_requests);
+    CHECK((decode_requests == std::vector<TextureLoadScheduler::RequestID>{ a, b }));
+    CHECK(scheduler.GetState(c) == TextureLoadState::Queued);
+
+    // a 有 3 个 mip，b 只有 1 个；批次预算 2048 字节
+    scheduler.OnDecoded(a, { 1024, 512, 512 });
+    scheduler.OnDecodeFailed(b);
+    CHECK(scheduler.GetState(b) == TextureLoadState::None);
+    scheduler.TakeDecodeRequests(decode_requests);
+    CHECK((decode_requests == std::vector<TextureLoadScheduler::RequestID>{ c }));
+    scheduler.OnDecoded(c, { 1024 });
+
+    std::vector<TextureUploadCopy> copies;
+    scheduler.BuildBatch(copies);
+    REQUIRE(copies.size() == 3);
+    CHECK(copies[0].request == a);
+    CHECK(copies[1].ring_offset == 1024);
+    CHECK(copies[2].ring_offset == 1536);
+    CHECK(scheduler.GetState(a) == TextureLoadState::Uploading);
+    scheduler.SubmitBatch(1);
+
+    scheduler.BuildBatch(copies);
+    REQUIRE(copies.size() == 1);
+    CHECK(copies[0].request == c);
+    scheduler.SubmitBatch(2);
+
+    std::vector<TextureLoadScheduler::RequestID> completed;
+    scheduler.Retire(1, completed);
+    CHECK((completed == std::vector<TextureLoadScheduler::RequestID>{ a }));
+    scheduler.Retire(2, completed);
+    CHECK((completed == std::vector<TextureLoadScheduler::RequestID>{ c }));
+    CHECK(scheduler.IsIdle());
+
+    const TextureLoadSchedulerStatistics statistics = scheduler.GetStatistics();
+    CHECK(statistics.submitted_batches == 2);
+    CHECK(statistics.submitted_bytes == 3072);
+    CHECK(statistics.staging_used_bytes == 0);
+}
+
+TEST_CASE("TextureLoadScheduler handles oversized subresources and cancellation", "[TextureUpload]")
+{
+    TextureLoadSchedulerDesc desc;
+    desc.staging_capacity = 1024;
+    desc.max_batch_bytes = 1024;
+    desc.placement_alignment = 256;
+
+    TextureLoadScheduler scheduler;
+    scheduler.Initialize(desc);
+    const auto large = scheduler.AddRequest();
+    const auto cancelled = scheduler.AddRequest();
+    const auto queued = scheduler.AddRequest();
+
+    std::vector<TextureLoadScheduler::RequestID> decode_requests;
+    scheduler.TakeDecodeRequests(decode_requests);
+    scheduler.Cancel(queued);
+    CHECK(scheduler.GetState(queued) == TextureLoadState::None);
+
+    // 比上传环还大的子资源走单独的上传缓冲，且超过批次预算也能单独成批
+    scheduler.OnDecoded(large, { 4096, 256 });
+    scheduler.OnDecoded(cancelled, { 512 });
+
+    std::vector<TextureUploadCopy> copies;
+    scheduler.BuildBatch(copies);
+    REQUIRE(copies.size() == 1);
+    CHECK(copies[0].dedicated);
+    scheduler.SubmitBatch(1);
+
+    scheduler.BuildBatch(copies);
+    REQUIRE(copies.size() == 2);
+    CHECK_FALSE(copies[0].dedicated);
+    scheduler.SubmitBatch(2);
+
+    // 已在 GPU 上拷贝的请求等批次完成后移除，不报告完成
+    scheduler.Cancel(cancelled);
+    CHECK(scheduler.GetState(cancelled) == TextureLoadState::Uploading);
+
+    std::vector<TextureLoadScheduler::RequestID> completed;
+    scheduler.Retire(1, completed);
+    CHECK(completed.empty());
+    scheduler.Retire(2, completed);
+    CHECK((completed == std::vector<TextureLoadScheduler::RequestID>{ large }));
+    CHECK(scheduler.IsIdle());
+    CHECK(scheduler.GetStatistics().dedicated_copies == 1);
+}
@@ -35,6 +35,9 @@ namespace
     constexpr int kInitialHeight = 720;
     constexpr int kMaxFramesInFlight = 2;
     constexpr float kPi = 3.14159265358979323846f;
+    // 与 Windows 渲染器的紧凑 GBuffer 一致（A2B10G10R10 即 DXGI 的 R10G10B10A2）
+    constexpr VkFormat kGBufferAFormat = VK_FORMAT_A2B10G10R10_UNORM_PACK32;
+    constexpr VkFormat kGBufferBFormat = VK_FORMAT_R8G8B8A8_UNORM;
 
     struct Matrix4
     {
@@ -46,6 +49,7 @@ namespace
         Matrix4 view;
         Matrix4 projection;
         float camera_position[4];
+        Matrix4 inverse_view_projection;
     };
 
     struct PerObjectUniform
@@ -266,8 +270,6 @@ namespace
         VkFormat m_depth_format = VK_FORMAT_UNDEFINED;
         RenderAttachment m_gbuffer_a;
         RenderAttachment m_gbuffer_b;
-        RenderAttachment m_gbuffer_c;
-        RenderAttachment m_gbuffer_d;
         RenderAttachment m_gbuffer_depth;
         RenderAttachment m_scene_result;
         VkFramebuffer m_gbuffer_framebuffer = VK_NULL_HANDLE;
@@ -861,10 +863,12 @@ namespace
         {
             m_depth_format = FindDepthFormat();
 
-            std::array<VkAttachmentDescription, 5> gbuffer_attachments {};
-            for (size_t i = 0; i < 4; ++i)
+            // 紧凑 GBuffer，布局见 content/shader/gbuffer_packing.hlsli
+            std::array<VkAttachmentDescription, 3> gbuffer_attachments {};
+            gbuffer_attachments[0].format = kGBufferAFormat;
+            gbuffer_attachments[1].format = kGBufferBFormat;
+            for (size_t i = 0; i < 2; ++i)
             {
-                gbuffer_attachments[i].format = VK_FORMAT_R8G8B8A8_UNORM;
                 gbuffer_attachments[i].samples = VK_SAMPLE_COUNT_1_BIT;
                 gbuffer_attachments[i].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
                 gbuffer_attachments[i].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
@@ -874,16 +878,16 @@ namespace
                 gbuffer_attachments[i].finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
             }
 
-            gbuffer_attachments[4].format = m_depth_format;
-            gbuffer_attachments[4].samples = VK_SAMPLE_COUNT_1_BIT;
-            gbuffer_attachments[4].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-            gbuffer_attachments[4].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-            gbuffer_attachments[4].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-            gbuffer_attachments[4].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-            gbuffer_attachments[4].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            gbuffer_attachments[4].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+            gbuffer_attachments[2].format = m_depth_format;
+            gbuffer_attachments[2].samples = VK_SAMPLE_COUNT_1_BIT;
+            gbuffer_attachments[2].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            gbuffer_attachments[2].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+            gbuffer_attachments[2].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            gbuffer_attachments[2].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            gbuffer_attachments[2].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            gbuffer_attachments[2].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
 
-            std::array<VkAttachmentReference, 4> color_refs {};
+            std::array<VkAttachmentReference, 2> color_refs {};
             for (uint32_t i = 0; i < static_cast<uint32_t>(color_refs.size()); ++i)
             {
                 color_refs[i].attachment = i;
@@ -891,7 +895,7 @@ namespace
             }
 
             VkAttachmentReference depth_ref {};
-            depth_ref.attachment = 4;
+            depth_ref.attachment = 2;
             depth_ref.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
             VkSubpassDescription gbuffer_subpass {};
@@ -957,10 +961,8 @@ namespace
         void CreateOffscreenResources()
         {
             constexpr VkImageUsageFlags gbuffer_usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-            CreateRenderAttachment(m_gbuffer_a, VK_FORMAT_R8G8B8A8_UNORM, gbuffer_usage, VK_IMAGE_ASPECT_COLOR_BIT);
-            CreateRenderAttachment(m_gbuffer_b, VK_FORMAT_R8G8B8A8_UNORM, gbuffer_usage, VK_IMAGE_ASPECT_COLOR_BIT);
-            CreateRenderAttachment(m_gbuffer_c, VK_FORMAT_R8G8B8A8_UNORM, gbuffer_usage, VK_IMAGE_ASPECT_COLOR_BIT);
-            CreateRenderAttachment(m_gbuffer_d, VK_FORMAT_R8G8B8A8_UNORM, gbuffer_usage, VK_IMAGE_ASPECT_COLOR_BIT);
+            CreateRenderAttachment(m_gbuffer_a, kGBufferAFormat, gbuffer_usage, VK_IMAGE_ASPECT_COLOR_BIT);
+            CreateRenderAttachment(m_gbuffer_b, kGBufferBFormat, gbuffer_usage, VK_IMAGE_ASPECT_COLOR_BIT);
             CreateRenderAttachment(
                 m_gbuffer_depth,
                 m_depth_format,
@@ -975,8 +977,6 @@ namespace
             VkImageView gbuffer_attachments[] = {
                 m_gbuffer_a.view,
                 m_gbuffer_b.view,
-                m_gbuffer_c.view,
-                m_gbuffer_d.view,
                 m_gbuffer_depth.view
             };
 
@@ -1528,7 +1528,7 @@ namespace
             depth_stencil.depthWriteEnable = VK_TRUE;
             depth_stencil.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
 
-            std::array<VkPipelineColorBlendAttachmentState, 4> blend_attachments {};
+            std::array<VkPipelineColorBlendAttachmentState, 2> blend_attachments {};
             for (VkPipelineColorBlendAttachmentState& attachment : blend_attachments)
             {
                 attachment.colorWriteMask =
@@ -1826,6 +1826,7 @@ namespace
             per_view.projection = IdentityMatrix();
             per_view.camera_position[2] = -1.0f;
             per_view.camera_position[3] = 1.0f;
+            per_view.inverse_view_projection = IdentityMatrix();
             CreateBuffer(
                 sizeof(PerViewUniform),
                 VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
@@ -2034,12 +2035,13 @@ namespace
             sampled_image_infos[0].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
             sampled_image_infos[1].imageView = m_gbuffer_b.view;
             sampled_image_infos[1].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            sampled_image_infos[2].imageView = m_gbuffer_c.view;
-            sampled_image_infos[2].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            sampled_image_infos[3].imageView = m_gbuffer_d.view;
+            sampled_image_infos[2].imageView = m_gbuffer_depth.view;
+            sampled_image_infos[2].imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+            // t3 / t4 不再使用，绑定占位纹理保持描述符集完整
+            sampled_image_infos[3].imageView = m_gbuffer_b.view;
             sampled_image_infos[3].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            sampled_image_infos[4].imageView = m_gbuffer_depth.view;
-            sampled_image_infos[4].imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+            sampled_image_infos[4].imageView = m_gbuffer_b.view;
+            sampled_image_infos[4].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
             std::array<VkDescriptorImageInfo, 5> sampler_infos {};
             for (VkDescriptorImageInfo& sampler_info : sampler_infos)
@@ -2507,12 +2509,10 @@ namespace
 
         void RecordGBufferPass(VkCommandBuffer command_buffer)
         {
-            std::array<VkClearValue, 5> clear_values {};
-            clear_values[0].color = { { 0.50f, 0.50f, 1.00f, 1.0f } };
-            clear_values[1].color = { { 0.04f, 0.04f, 0.05f, 1.0f } };
-            clear_values[2].color = { { 0.0f, 0.0f, 0.0f, 0.0f } };
-            clear_values[3].color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
-            clear_values[4].depthStencil = { 1.0f, 0 };
+            std::array<VkClearValue, 3> clear_values {};
+            clear_values[0].color = { { 0.50f, 0.50f, 0.0f, 0.0f } }; // +Z 法线的八面体编码，opaque
+            clear_values[1].color = { { 0.04f, 0.04f, 0.05f, 0.0f } };
+            clear_values[2].depthStencil = { 1.0f, 0 };
 
             VkRenderPassBeginInfo render_pass_info {};
             render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -2530,8 +2530,8 @@ namespace
 
         void BarrierGBufferForDeferred(VkCommandBuffer command_buffer)
         {
-            std::array<VkImageMemoryBarrier, 5> barriers {};
-            RenderAttachment* color_attachments[] = { &m_gbuffer_a, &m_gbuffer_b, &m_gbuffer_c, &m_gbuffer_d };
+            std::array<VkImageMemoryBarrier, 3> barriers {};
+            RenderAttachment* color_attachments[] = { &m_gbuffer_a, &m_gbuffer_b };
             for (size_t i = 0; i < std::size(color_attachments); ++i)
             {
                 barriers[i].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -2547,17 +2547,17 @@ namespace
                 barriers[i].subresourceRange.layerCount = 1;
             }
 
-            barriers[4].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-            barriers[4].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-            barriers[4].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-            barriers[4].oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
-            barriers[4].newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
-            barriers[4].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            barriers[4].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-            barriers[4].image = m_gbuffer_depth.image;
-            barriers[4].subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-            barriers[4].subresourceRange.levelCount = 1;
-            barriers[4].subresourceRange.layerCount = 1;
+            barriers[2].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barriers[2].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            barriers[2].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            barriers[2].oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+            barriers[2].newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+            barriers[2].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barriers[2].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barriers[2].image = m_gbuffer_depth.image;
+            barriers[2].subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+            barriers[2].subresourceRange.levelCount = 1;
+            barriers[2].subresourceRange.layerCount = 1;
 
             vkCmdPipelineBarrier(
                 command_buffer,
@@ -2881,8 +2881,6 @@ namespace
 
             DestroyAttachment(m_gbuffer_a);
             DestroyAttachment(m_gbuffer_b);
-            DestroyAttachment(m_gbuffer_c);
-            DestroyAttachment(m_gbuffer_d);
             DestroyAttachment(m_gbuffer_depth);
             DestroyAttachment(m_scene_result);
         }
@@ -0,0 +1,335 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "asset_types/mesh_asset.h"
+#include "dolas_asset_manager.h"
+#include "dolas_asset_path.h"
+#include "dolas_log_system_manager.h"
+#include "dolas_mesh_lod.h"
+#include "dolas_meshlet.h"
+#include "dolas_paths.h"
+
+using namespace Dolas;
+
+namespace
+{
+    struct CookOptions
+    {
+        MeshLODChainSettings lod_settings;
+        Bool build_meshlets = false;
+        Bool dry_run = false;
+        std::vector<std::string> asset_paths;
+    };
+
+    struct CookReport
+    {
+        UInt mesh_count = 0;
+        UInt skipped_count = 0;
+        UInt failed_count = 0;
+        ULongLong source_triangle_count = 0;
+        ULongLong lod_triangle_count = 0;
+        ULongLong meshlet_count = 0;
+    };
+
+    void PrintUsage(const std::string& program_name)
+    {
+        std::cout << "Dolas Mesh Cooker - generates quadric-error LOD chains and meshlets for .mesh assets" << std::endl;
+        std::cout << "Usage:" << std::endl;
+        std::cout << "  " << program_name << " [options]                      # Cook every .mesh under the engine content directory" << std::endl;
+        std::cout << "  " << program_name << " [options] <asset> [asset...]   # Cook logical paths such as _engine/a/b.mesh" << std::endl;
+        std::cout << "Options:" << std::endl;
+        std::cout << "  --max-lods <n>      Maximum number of generated LODs (default 4)" << std::endl;
+        std::cout << "  --ratio <r>         Target triangle ratio between consecutive LODs (default 0.5)" << std::endl;
+        std::cout << "  --max-error <e>     Maximum error per LOD relative to the mesh extent (default 0.05)" << std::endl;
+        std::cout << "  --meshlets          Split LOD0 into meshlets (<= 64 verts / 124 tris) for cluster culling" << std::endl;
+        std::cout << "  --dry-run           Report LODs without writing assets" << std::endl;
+    }
+
+    Bool ParseOptions(int argc, char* argv[], CookOptions& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string argument = argv[i];
+            const Bool has_value = i + 1 < argc;
+            if (argument == "--max-lods" && has_value)
+            {
+                options.lod_settings.max_lod_count = static_cast<UInt>(std::stoul(argv[++i]));
+            }
+            else if (argument == "--ratio" && has_value)
+            {
+                options.lod_settings.reduction_ratio = std::stof(argv[++i]);
+            }
+            else if (argument == "--max-error" && has_value)
+            {
+                options.lod_settings.max_error = std::stof(argv[++i]);
+            }
+            else if (argument == "--meshlets")
+            {
+                options.build_meshlets = true;
+            }
+            else if (argument == "--dry-run")
+            {
+                options.dry_run = true;
+            }
+            else if (argument.starts_with("--"))
+            {
+                std::cerr << "Unknown or incomplete option: " << argument << std::endl;
+                return false;
+            }
+            else
+            {
+                options.asset_paths.push_back(argument);
+            }
+        }
+        return true;
+    }
+
+    // 没有指定资产时，收集引擎内容目录下的所有 .mesh
+    std::vector<std::string> CollectEngineMeshAssets()
+    {
+        std::vector<std::string> asset_paths;
+        const std::filesystem::path content_dir{PathUtils::GetEngineContentDir()};
+        std::error_code error;
+        for (auto it = std::filesystem::recursive_directory_iterator(content_dir, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+        {
+            if (!it->is_regular_file() || it->path().extension() != MeshAssetDesc::kFileSuffix)
+            {
+                continue;
+            }
+            const std::string relative_path = std::filesystem::relative(it->path(), content_dir).generic_string();
+            asset_paths.push_back("_engine/" + relative_path);
+        }
+        std::sort(asset_paths.begin(), asset_paths.end());
+        return asset_paths;
+    }
+
+    // 合并所有属性都相同的顶点。导入的网格常常按三角形展开（不共享顶点），
+    // 不合并的话每个顶点都会被当作接缝锁定，简化器无法折叠任何边
+    UInt WeldVertices(MeshAssetDesc& mesh)
+    {
+        const UInt vertex_count = static_cast<UInt>(mesh.position.size() / 3);
+        std::vector<std::vector<Float>*> streams;
+        for (std::vector<Float>* stream : { &mesh.position, &mesh.normal, &mesh.tangent, &mesh.uv0, &mesh.uv1, &mesh.color })
+        {
+            if (!stream->empty() && stream->size() % vertex_count == 0)
+            {
+                streams.push_back(stream);
+            }
+        }
+
+        auto compare = [&streams, vertex_count](UInt a, UInt b)
+        {
+            for (const std::vector<Float>* stream : streams)
+            {
+                const std::size_t components = stream->size() / vertex_count;
+                for (std::size_t c = 0; c < components; ++c)
+                {
+                    const Float value_a = (*stream)[a * components + c];
+                    const Float value_b = (*stream)[b * components + c];
+                    if (value_a != value_b) return value_a < value_b ? -1 : 1;
+                }
+            }
+            return 0;
+        };
+
+        std::vector<UInt> order(vertex_count);
+        for (UInt i = 0; i < vertex_count; ++i) order[i] = i;
+        std::sort(order.begin(), order.end(), [&compare](UInt a, UInt b) { return compare(a, b) < 0; });
+
+        // 保持首次出现的顺序，重新编号
+        std::vector<UInt> canonical(vertex_count);
+        for (UInt i = 0; i < vertex_count;)
+        {
+            UInt end = i + 1;
+            UInt first = order[i];
+            while (end < vertex_count && compare(order[i], order[end]) == 0)
+            {
+                first = std::min(first, order[end]);
+                ++end;
+            }
+            for (UInt j = i; j < end; ++j) canonical[order[j]] = first;
+            i = end;
+        }
+
+        std::vector<UInt> remap(vertex_count, ~0u);
+        UInt welded_count = 0;
+        for (UInt i = 0; i < vertex_count; ++i)
+        {
+            if (canonical[i] == i) remap[i] = welded_count++;
+        }
+        if (welded_count == vertex_count)
+        {
+            return vertex_count;
+        }
+
+        for (std::vector<Float>* stream : streams)
+        {
+            const std::size_t components = stream->size() / vertex_count;
+            std::vector<Float> welded(welded_count * components);
+            for (UInt i = 0; i < vertex_count; ++i)
+            {
+                if (canonical[i] != i) continue;
+                std::copy_n(stream->begin() + i * components, components, welded.begin() + remap[i] * components);
+            }
+            *stream = std::move(welded);
+        }
+
+        if (mesh.indices.empty())
+        {
+            for (UInt i = 0; i < vertex_count; ++i) mesh.indices.push_back(remap[canonical[i]]);
+        }
+        else
+        {
+            for (UInt& index : mesh.indices) index = remap[canonical[index]];
+        }
+        return welded_count;
+    }
+
+    void StoreMeshlets(const MeshletData& meshlet_data, MeshAssetDesc& mesh)
+    {
+        mesh.meshlets.clear();
+        for (const Meshlet& meshlet : meshlet_data.meshlets)
+        {
+            MeshletDesc meshlet_desc;
+            meshlet_desc.vertex_offset = meshlet.vertex_offset;
+            meshlet_desc.vertex_count = meshlet.vertex_count;
+            meshlet_desc.triangle_offset = meshlet.triangle_offset;
+            meshlet_desc.triangle_count = meshlet.triangle_count;
+            meshlet_desc.bounding_sphere = { meshlet.bounds.center.x, meshlet.bounds.center.y, meshlet.bounds.center.z, meshlet.bounds.radius };
+            meshlet_desc.cone_apex = { meshlet.cone_apex.x, meshlet.cone_apex.y, meshlet.cone_apex.z };
+            meshlet_desc.cone_axis = { meshlet.cone_axis.x, meshlet.cone_axis.y, meshlet.cone_axis.z };
+            meshlet_desc.cone_cutoff = meshlet.cone_cutoff;
+            mesh.meshlets.push_back(meshlet_desc);
+        }
+        mesh.meshlet_vertices = meshlet_data.vertices;
+        mesh.meshlet_triangles = meshlet_data.triangles;
+    }
+
+    Bool CookMesh(AssetManager& asset_manager, const std::string& path_string, const CookOptions& options, CookReport& report)
+    {
+        const auto asset_path = AssetPath::Parse(path_string);
+        if (!asset_path)
+        {
+            std::cerr << "Invalid asset path: " << path_string << std::endl;
+            return false;
+        }
+
+        const auto load_result = asset_manager.LoadAsset<MeshAssetDesc>(*asset_path);
+        if (!load_result)
+        {
+            std::cerr << "Failed to load " << path_string << ": " << GetAssetLoadErrorName(load_result.GetError()) << std::endl;
+            return false;
+        }
+
+        MeshAssetDesc mesh = *load_result.GetAsset();
+        const UInt source_vertex_count = static_cast<UInt>(mesh.position.size() / 3);
+        if (mesh.topology != TopologyType::TriangleList || source_vertex_count < 3)
+        {
+            std::cout << "  skip   " << path_string << " (no triangle list geometry)" << std::endl;
+            ++report.skipped_count;
+            return true;
+        }
+
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        const UInt welded_vertex_count = WeldVertices(mesh);
+        const std::vector<MeshLOD> lods = GenerateMeshLODChain(mesh.position.data(), welded_vertex_count, 3, mesh.indices, options.lod_settings);
+        MeshletData meshlet_data;
+        if (options.build_meshlets && !BuildMeshlets(mesh.position.data(), welded_vertex_count, 3, mesh.indices, meshlet_data))
+        {
+            std::cerr << "Failed to build meshlets for " << path_string << std::endl;
+            return false;
+        }
+        const Double milliseconds = std::chrono::duration<Double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+        mesh.lods.clear();
+        for (const MeshLOD& lod : lods)
+        {
+            mesh.lods.push_back({ lod.indices, lod.error, lod.screen_size });
+        }
+
+        const UInt triangle_count = static_cast<UInt>(mesh.indices.size() / 3);
+        char line[256];
+        std::snprintf(line, sizeof(line), "  cook   %s  verts %u -> %u  %.1f ms", path_string.c_str(), source_vertex_count, welded_vertex_count, milliseconds);
+        std::cout << line << std::endl;
+        std::snprintf(line, sizeof(line), "         LOD0  %8u tris", triangle_count);
+        std::cout << line << std::endl;
+        for (std::size_t lod_index = 0; lod_index < lods.size(); ++lod_index)
+        {
+            const UInt lod_triangle_count = static_cast<UInt>(lods[lod_index].indices.size() / 3);
+            std::snprintf(line, sizeof(line), "         LOD%zu  %8u tris  %5.1f%%  error %.5f  screen size < %.4f",
+                lod_index + 1, lod_triangle_count, 100.0 * lod_triangle_count / triangle_count, lods[lod_index].error, lods[lod_index].screen_size);
+            std::cout << line << std::endl;
+            report.lod_triangle_count += lod_triangle_count;
+        }
+        if (options.build_meshlets)
+        {
+            UInt cone_count = 0;
+            for (const Meshlet& meshlet : meshlet_data.meshlets)
+            {
+                cone_count += meshlet.HasValidCone() ? 1 : 0;
+            }
+            StoreMeshlets(meshlet_data, mesh);
+            std::snprintf(line, sizeof(line), "         meshlets %5zu  avg %.1f tris  %u with normal cone",
+                meshlet_data.meshlets.size(), meshlet_data.meshlets.empty() ? 0.0 : Double(meshlet_data.GetTriangleCount()) / meshlet_data.meshlets.size(), cone_count);
+            std::cout << line << std::endl;
+            report.meshlet_count += meshlet_data.meshlets.size();
+        }
+        report.source_triangle_count += triangle_count;
+        ++report.mesh_count;
+
+        if (!options.dry_run && !asset_manager.SaveAsset(*asset_path, mesh))
+        {
+            std::cerr << "Failed to save " << path_string << std::endl;
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Dolas::LogSystemManager::GetInstance().Initialize();
+
+    if (argc > 1 && (std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h"))
+    {
+        PrintUsage(argv[0]);
+        return 0;
+    }
+
+    CookOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    if (options.asset_paths.empty())
+    {
+        options.asset_paths = CollectEngineMeshAssets();
+    }
+
+    AssetManager asset_manager;
+    asset_manager.Initialize();
+
+    CookReport report;
+    for (const std::string& asset_path : options.asset_paths)
+    {
+        if (!CookMesh(asset_manager, asset_path, options, report))
+        {
+            ++report.failed_count;
+        }
+    }
+
+    std::cout << std::endl;
+    std::cout << "Cooked " << report.mesh_count << " meshes, skipped " << report.skipped_count << ", failed " << report.failed_count << std::endl;
+    std::cout << "LOD0 triangles " << report.source_triangle_count << ", generated LOD triangles " << report.lod_triangle_count << std::endl;
+    if (options.build_meshlets)
+    {
+        std::cout << "Meshlets " << report.meshlet_count << std::endl;
+    }
+    return report.failed_count == 0 ? 0 : 1;
+}
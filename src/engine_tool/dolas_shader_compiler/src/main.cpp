@@ -7,19 +7,30 @@
 #include "shader_compiler.h"
 #include "dolas_log_system_manager.h"
 #include "file_utils.h"
+#include "material_keywords.h"
 
 void PrintUsage(const std::string& program_name) {
     std::cout << "Dolas Shader Compiler - Continuous Shader File Validity Monitoring Tool" << std::endl;
     std::cout << "Usage:" << std::endl;
     std::cout << "  " << program_name << "                    # Compile all shader files" << std::endl;
     std::cout << "  " << program_name << " <file1> [file2...] # Compile specified files" << std::endl;
+    std::cout << "  " << program_name << " --batch [options]  # Non-interactive incremental build of all shaders" << std::endl;
     std::cout << "  " << program_name << " --help             # Show help information" << std::endl;
     std::cout << std::endl;
+    std::cout << "Batch options:" << std::endl;
+    std::cout << "  --output <dir>   Bytecode, reflection and shader_manifest.txt output directory" << std::endl;
+    std::cout << "                   (default: content/cache/shader/, where the engine looks for them)" << std::endl;
+    std::cout << "  --jobs <n>       Parallel compile threads (default: all hardware threads)" << std::endl;
+    std::cout << "  --force          Ignore the manifest and rebuild every shader" << std::endl;
+    std::cout << std::endl;
     std::cout << "Description:" << std::endl;
     std::cout << "  - Default search directory: content/shader/" << std::endl;
     std::cout << "  - Supported file types: .hlsl" << std::endl;
     std::cout << "  - Log output: Console + logs/ directory" << std::endl;
     std::cout << "  - Error details: logs/compilation_errors.log" << std::endl;
+    std::cout << "  - Batch mode only recompiles shaders whose source or (transitive) includes changed" << std::endl;
+    std::cout << "  - Batch mode builds the default and the bindless (SM5.1) variant of every shader" << std::endl;
+    std::cout << "  - Shader keywords (// #pragma dolas_keywords) are only built for combinations used by .material files" << std::endl;
 }
 
 void PrintHeader() {
@@ -30,6 +41,70 @@ void PrintHeader() {
     std::cout << std::endl;
 }
 
+std::string GetDefaultBytecodeOutputDir() {
+#ifdef SHADER_BYTECODE_OUTPUT_DIR
+    return SHADER_BYTECODE_OUTPUT_DIR;
+#else
+    return "compiled_shaders";
+#endif
+}
+
+bool ParseBatchOptions(int argc, char* argv[], BatchCompileOptions& options) {
+    options.output_directory = GetDefaultBytecodeOutputDir();
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (argument == "--batch") {
+            continue;
+        } else if (argument == "--output" && has_value) {
+            options.output_directory = argv[++i];
+        } else if (argument == "--jobs" && has_value) {
+            try {
+                options.job_count = static_cast<unsigned int>(std::stoul(argv[++i]));
+            } catch (const std::exception&) {
+                std::cerr << "Error: Invalid --jobs value: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (argument == "--force") {
+            options.force = true;
+        } else {
+            std::cerr << "Error: Unknown batch option: " << argument << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int RunBatch(ShaderCompiler& compiler, const std::string& shader_dir, int argc, char* argv[]) {
+    BatchCompileOptions options;
+    if (!ParseBatchOptions(argc, argv, options)) {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+    options.shader_directory = shader_dir;
+
+    std::vector<std::string> material_errors;
+    options.requested_keywords = CollectMaterialShaderKeywords(shader_dir, material_errors);
+    for (const std::string& error : material_errors) {
+        std::cerr << "Error: " << error << std::endl;
+    }
+
+    LOG_INFO("Batch compiling shaders into: " + options.output_directory);
+    std::cout << "Output directory: " << options.output_directory << std::endl;
+
+    const BatchCompileReport report = compiler.CompileBatch(options);
+    compiler.PrintBatchReport(report);
+
+    LOG_INFO("Batch compilation completed - Compiled: " + std::to_string(report.compiled_count)
+        + ", Up to date: " + std::to_string(report.up_to_date_count)
+        + ", Failed: " + std::to_string(report.failed_count)
+        + ", Wall: " + std::to_string(report.wall_time_ms) + " ms"
+        + ", Compile (sum): " + std::to_string(report.total_compile_time_ms) + " ms");
+    // 无法加载的材质与互斥的 keyword 会让运行时退回到别的变体，同样视为失败
+    const bool has_errors = report.failed_count > 0 || !report.keyword_errors.empty() || !material_errors.empty();
+    return has_errors ? 1 : 0;
+}
+
 std::string GetShaderDir() {
     // Set shader directory
 #ifdef SHADER_CONTENT_DIR
@@ -75,6 +150,15 @@ int main(int argc, char* argv[]) {
     ShaderCompiler compiler;
     compiler.SetIncludeDirectory(shader_dir);
 
+    // 批量模式供构建脚本 / CI 调用，失败时返回非零
+    bool batch_mode = false;
+    for (int i = 1; i < argc; ++i) {
+        batch_mode = batch_mode || std::string(argv[i]) == "--batch";
+    }
+    if (batch_mode) {
+        return RunBatch(compiler, shader_dir, argc, argv);
+    }
+
     int command_index = 0;
 
     while (true) {
@@ -0,0 +1,71 @@
+#include "material_keywords.h"
+#include <algorithm>
+#include <filesystem>
+#include "asset_types/material_asset.h"
+#include "dolas_asset_manager.h"
+#include "dolas_asset_path.h"
+#include "dolas_paths.h"
+
+using namespace Dolas;
+
+namespace {
+    // 材质引用的 shader 资产路径 -> 相对 shader 目录的源文件路径；不在 shader 目录下时返回空
+    std::string GetShaderSource(const RawAssetRef& shader_ref, const std::filesystem::path& shader_root) {
+        const auto shader_path = PathUtils::ResolveAssetPath(shader_ref.GetPath());
+        if (!shader_path) {
+            return "";
+        }
+        const std::string relative_path = shader_path->lexically_normal().lexically_relative(shader_root).generic_string();
+        if (relative_path.empty() || relative_path.rfind("..", 0) == 0) {
+            return "";
+        }
+        return relative_path;
+    }
+}
+
+std::map<std::string, std::vector<std::vector<std::string>>> CollectMaterialShaderKeywords(const std::string& shader_directory, std::vector<std::string>& out_errors) {
+    std::map<std::string, std::vector<std::vector<std::string>>> requested_keywords;
+
+    std::vector<std::string> material_paths;
+    const std::filesystem::path content_dir{ PathUtils::GetEngineContentDir() };
+    std::error_code error;
+    for (auto it = std::filesystem::recursive_directory_iterator(content_dir, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+        if (!it->is_regular_file() || it->path().extension() != MaterialAssetDesc::kFileSuffix) {
+            continue;
+        }
+        material_paths.push_back("_engine/" + std::filesystem::relative(it->path(), content_dir).generic_string());
+    }
+    std::sort(material_paths.begin(), material_paths.end());
+
+    AssetManager asset_manager;
+    asset_manager.Initialize();
+
+    const std::filesystem::path shader_root = std::filesystem::path(shader_directory).lexically_normal();
+    for (const std::string& material_path : material_paths) {
+        const auto asset_path = AssetPath::Parse(material_path);
+        if (!asset_path) {
+            out_errors.push_back("Invalid asset path: " + material_path);
+            continue;
+        }
+        const auto load_result = asset_manager.LoadAsset<MaterialAssetDesc>(*asset_path);
+        if (!load_result) {
+            out_errors.push_back("Failed to load " + material_path + ": " + std::string(GetAssetLoadErrorName(load_result.GetError())));
+            continue;
+        }
+
+        const MaterialAssetDesc* material = load_result.GetAsset();
+        if (material->shader_keywords.empty()) {
+            continue;
+        }
+        for (const auto* shader_ref : { &material->vertex_shader, &material->pixel_shader }) {
+            if (!shader_ref->has_value()) {
+                continue;
+            }
+            const std::string source = GetShaderSource(**shader_ref, shader_root);
+            if (!source.empty()) {
+                requested_keywords[source].push_back(material->shader_keywords);
+            }
+        }
+    }
+    return requested_keywords;
+}
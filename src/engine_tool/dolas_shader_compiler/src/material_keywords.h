@@ -0,0 +1,13 @@
+#ifndef MATERIAL_KEYWORDS_H
+#define MATERIAL_KEYWORDS_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+// 扫描引擎内容目录下的所有 .material，收集每个 shader（路径相对 shader_directory）被请求的 keyword 列表，
+// 供 BatchCompileOptions::requested_keywords 使用。同一材质的 keyword 对 VS 与 PS 都会记录，由编译时按声明筛选。
+// 无法加载的材质记录到 out_errors
+std::map<std::string, std::vector<std::vector<std::string>>> CollectMaterialShaderKeywords(const std::string& shader_directory, std::vector<std::string>& out_errors);
+
+#endif // MATERIAL_KEYWORDS_H
@@ -8,6 +8,13 @@
 #include <iomanip>
 #include <fstream>
 #include <filesystem>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "dolas_hash.h"
+#include "dolas_shader_build.h"
+#include "dolas_shader_permutation.h"
+#include "dolas_shader_reflection.h"
 
 #ifdef _WIN32
 #include <d3dcompiler.h>
@@ -138,7 +145,7 @@ std::pair<std::string, std::string> ShaderCompiler::InferShaderTypeAndEntry(cons
     return {"ps_5_0", "PS"};
 }
 
-CompilationResult ShaderCompiler::CompileShader(const std::string& filepath, const std::string& entry_point, const std::string& target) {
+CompilationResult ShaderCompiler::CompileShader(const std::string& filepath, const std::string& entry_point, const std::string& target, const std::string& output_path, const ShaderDefines& defines) {
     CompilationResult result;
     result.filename = FileUtils::GetFilename(filepath);
     result.success = false;
@@ -166,9 +173,9 @@ CompilationResult ShaderCompiler::CompileShader(const std::string& filepath, con
         LOG_DEBUG("Using target: " + actual_target + ", entry point: " + actual_entry);
         
 #ifdef _WIN32
-        result = CompileHLSLShader(filepath, actual_entry, actual_target);
+        result = CompileHLSLShader(filepath, actual_entry, actual_target, output_path, defines);
 #else
-        result = CompileHLSLToSpirvShader(filepath, actual_entry, actual_target);
+        result = CompileHLSLToSpirvShader(filepath, actual_entry, actual_target, output_path, defines);
 #endif
         
     } catch (const std::exception& e) {
@@ -190,7 +197,59 @@ CompilationResult ShaderCompiler::CompileShader(const std::string& filepath, con
 }
 
 #ifdef _WIN32
-CompilationResult ShaderCompiler::CompileHLSLShader(const std::string& filepath, const std::string& entry_point, const std::string& target) {
+namespace
+{
+    // 与引擎运行时 ShaderContext::GenerateReflectionAndDesc 取相同的字段
+    bool ReflectShaderBytecode(ID3DBlob* shader_blob, Dolas::ShaderReflectionInfo& info)
+    {
+        ComPtr<ID3D11ShaderReflection> reflection;
+        if (FAILED(D3DReflect(shader_blob->GetBufferPointer(), shader_blob->GetBufferSize(), IID_ID3D11ShaderReflection, reinterpret_cast<void**>(reflection.GetAddressOf())))) {
+            return false;
+        }
+
+        D3D11_SHADER_DESC shader_desc = {};
+        if (FAILED(reflection->GetDesc(&shader_desc))) {
+            return false;
+        }
+        info.constant_buffer_count = shader_desc.ConstantBuffers;
+        info.bound_resource_count = shader_desc.BoundResources;
+        info.instruction_count = shader_desc.InstructionCount;
+
+        for (UINT cb_index = 0; cb_index < shader_desc.ConstantBuffers; ++cb_index) {
+            ID3D11ShaderReflectionConstantBuffer* constant_buffer = reflection->GetConstantBufferByIndex(cb_index);
+            D3D11_SHADER_BUFFER_DESC cb_desc = {};
+            if (!constant_buffer || FAILED(constant_buffer->GetDesc(&cb_desc))) {
+                return false;
+            }
+
+            Dolas::ConstantBufferInfo cb_info;
+            cb_info.name = cb_desc.Name ? cb_desc.Name : "";
+            cb_info.size = cb_desc.Size;
+            cb_info.variable_count = cb_desc.Variables;
+            for (UINT variable_index = 0; variable_index < cb_desc.Variables; ++variable_index) {
+                ID3D11ShaderReflectionVariable* variable = constant_buffer->GetVariableByIndex(variable_index);
+                D3D11_SHADER_VARIABLE_DESC var_desc = {};
+                if (!variable || FAILED(variable->GetDesc(&var_desc))) {
+                    return false;
+                }
+                cb_info.variable_descs.push_back({ var_desc.Name ? var_desc.Name : "", var_desc.StartOffset, var_desc.Size, var_desc.uFlags });
+            }
+            info.constant_buffer_descs.push_back(std::move(cb_info));
+        }
+
+        for (UINT resource_index = 0; resource_index < shader_desc.BoundResources; ++resource_index) {
+            D3D11_SHADER_INPUT_BIND_DESC bind_desc = {};
+            if (FAILED(reflection->GetResourceBindingDesc(resource_index, &bind_desc))) {
+                return false;
+            }
+            info.bound_resource_descs.push_back({ bind_desc.Name ? bind_desc.Name : "",
+                static_cast<Dolas::UInt>(bind_desc.Type), static_cast<Dolas::UInt>(bind_desc.Dimension), bind_desc.BindPoint, bind_desc.BindCount });
+        }
+        return true;
+    }
+}
+
+CompilationResult ShaderCompiler::CompileHLSLShader(const std::string& filepath, const std::string& entry_point, const std::string& target, const std::string& output_path, const ShaderDefines& defines) {
     CompilationResult result;
     result.filename = FileUtils::GetFilename(filepath);
     result.success = false;
@@ -212,6 +271,16 @@ CompilationResult ShaderCompiler::CompileHLSLShader(const std::string& filepath,
 #else
     compile_flags |= D3DCOMPILE_OPTIMIZATION_LEVEL3;
 #endif
+    // SM5.1 变体是 bindless 版本，使用无界的 descriptor 数组
+    if (target.size() >= 4 && target.compare(target.size() - 4, 4, "_5_1") == 0) {
+        compile_flags |= D3DCOMPILE_ENABLE_UNBOUNDED_DESCRIPTOR_TABLES;
+    }
+
+    std::vector<D3D_SHADER_MACRO> macros;
+    for (const auto& [name, value] : defines) {
+        macros.push_back({ name.c_str(), value.c_str() });
+    }
+    macros.push_back({ nullptr, nullptr });
     
     // 设置包含目录：如果指定了 include 目录，则使用自定义 include handler
     ID3DInclude* include_handler = nullptr;
@@ -228,7 +297,7 @@ CompilationResult ShaderCompiler::CompileHLSLShader(const std::string& filepath,
         source_code.c_str(),           // 源代码
         source_code.length(),          // 源代码长度
         filepath.c_str(),              // 文件名（用于错误报告）
-        nullptr,                       // 宏定义
+        macros.data(),                 // 宏定义
         include_handler,               // include handler
         entry_point.c_str(),           // 入口点函数名
         target.c_str(),                // 目标profile
@@ -263,6 +332,32 @@ CompilationResult ShaderCompiler::CompileHLSLShader(const std::string& filepath,
         result.bytecode_size = std::to_string(shader_blob->GetBufferSize()) + " bytes";
     }
 
+    if (!output_path.empty() && shader_blob) {
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(output_path).parent_path(), ec);
+        std::ofstream output(output_path, std::ios::binary | std::ios::trunc);
+        output.write(static_cast<const char*>(shader_blob->GetBufferPointer()), static_cast<std::streamsize>(shader_blob->GetBufferSize()));
+        if (!output.good()) {
+            result.success = false;
+            result.error_message = "Failed to write bytecode: " + output_path;
+            return result;
+        }
+        result.bytecode_bytes = shader_blob->GetBufferSize();
+        result.output_path = output_path;
+
+        // 反射与 bytecode 一起写出，引擎加载预编译 shader 时不再需要 D3DReflect
+        Dolas::ShaderReflectionInfo reflection_info;
+        const std::string reflection_path = output_path + ".refl";
+        const Dolas::ULongLong bytecode_hash = Dolas::HashConverter::BytesHash64(shader_blob->GetBufferPointer(), shader_blob->GetBufferSize());
+        if (!ReflectShaderBytecode(shader_blob.Get(), reflection_info) ||
+            !Dolas::ShaderReflectionFile::Save(reflection_path, reflection_info, bytecode_hash)) {
+            result.success = false;
+            result.error_message = "Failed to write shader reflection: " + reflection_path;
+            return result;
+        }
+        result.reflection_path = reflection_path;
+    }
+
     return result;
 }
 #endif
@@ -331,7 +426,7 @@ namespace
     }
 }
 
-CompilationResult ShaderCompiler::CompileHLSLToSpirvShader(const std::string& filepath, const std::string& entry_point, const std::string& target)
+CompilationResult ShaderCompiler::CompileHLSLToSpirvShader(const std::string& filepath, const std::string& entry_point, const std::string& target, const std::string& output_path_override, const ShaderDefines& defines)
 {
     CompilationResult result;
     result.filename = FileUtils::GetFilename(filepath);
@@ -346,7 +441,11 @@ CompilationResult ShaderCompiler::CompileHLSLToSpirvShader(const std::string& fi
         return result;
     }
 
-    std::filesystem::path output_dir = GetSpirvOutputDirectory();
+    std::filesystem::path input_path(filepath);
+    std::filesystem::path output_path = output_path_override.empty()
+        ? GetSpirvOutputDirectory() / (input_path.stem().string() + "_" + entry_point + ".spv")
+        : std::filesystem::path(output_path_override);
+    std::filesystem::path output_dir = output_path.parent_path();
     std::error_code ec;
     std::filesystem::create_directories(output_dir, ec);
     if (ec)
@@ -355,8 +454,6 @@ CompilationResult ShaderCompiler::CompileHLSLToSpirvShader(const std::string& fi
         return result;
     }
 
-    std::filesystem::path input_path(filepath);
-    std::filesystem::path output_path = output_dir / (input_path.stem().string() + "_" + entry_point + ".spv");
     const std::string include_dir = m_include_directory.empty()
         ? input_path.parent_path().string()
         : m_include_directory;
@@ -367,8 +464,12 @@ CompilationResult ShaderCompiler::CompileHLSLToSpirvShader(const std::string& fi
             << " --hlsl-offsets --hlsl-iomap"
             << " -S " << ShellQuote(stage)
             << " -e " << ShellQuote(entry_point)
-            << " -I" << ShellQuote(include_dir)
-            << " -o " << ShellQuote(output_path.string())
+            << " -I" << ShellQuote(include_dir);
+    for (const auto& [name, value] : defines)
+    {
+        command << " " << ShellQuote("-D" + name + "=" + value);
+    }
+    command << " -o " << ShellQuote(output_path.string())
             << " " << ShellQuote(filepath)
             << " 2>&1";
 
@@ -399,6 +500,10 @@ CompilationResult ShaderCompiler::CompileHLSLToSpirvShader(const std::string& fi
     result.error_message.clear();
     const size_t bytecode_size = FileUtils::GetFileSize(output_path.string());
     result.bytecode_size = std::to_string(bytecode_size) + " bytes SPIR-V";
+    if (!output_path_override.empty()) {
+        result.bytecode_bytes = bytecode_size;
+        result.output_path = output_path.string();
+    }
     return result;
 }
 #endif
@@ -527,3 +632,273 @@ void ShaderCompiler::PrintCompilationSummary(const std::vector<CompilationResult
         std::cout << "  (None)" << std::endl;
     }
 }
+
+std::string ShaderCompiler::GetCompilerIdentity() {
+#ifdef _WIN32
+#ifdef _DEBUG
+    return "d3dcompiler;strict;debug;skip_optimization";
+#else
+    return "d3dcompiler;strict;optimization_level3";
+#endif
+#else
+    return "glslang;vulkan1.2;hlsl-offsets;hlsl-iomap";
+#endif
+}
+
+std::string ShaderCompiler::GetBytecodeExtension() {
+#ifdef _WIN32
+    return ".cso";
+#else
+    return ".spv";
+#endif
+}
+
+BatchCompileReport ShaderCompiler::CompileBatch(const BatchCompileOptions& options) {
+    BatchCompileReport report;
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    auto elapsed_ms = [](std::chrono::high_resolution_clock::time_point from) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - from).count() / 1000.0;
+    };
+
+    const std::filesystem::path shader_root(options.shader_directory);
+    const std::filesystem::path output_root(options.output_directory);
+    const std::string manifest_path = (output_root / "shader_manifest.txt").string();
+
+    std::error_code ec;
+    std::filesystem::create_directories(output_root, ec);
+    if (ec) {
+        LOG_ERROR("Failed to create output directory: " + output_root.string() + " - " + ec.message());
+        return report;
+    }
+
+    // 依赖图：每个 .hlsl 的输入 = 自身 + 传递 include 的 .hlsli
+    Dolas::ShaderDependencyGraph graph;
+    if (!graph.BuildFromDirectory(options.shader_directory)) {
+        LOG_WARN("Some shader files could not be read under: " + options.shader_directory);
+    }
+    report.missing_includes = graph.GetMissingIncludes();
+
+    Dolas::ShaderBuildManifest manifest;
+    if (!options.force && !manifest.Load(manifest_path)) {
+        LOG_INFO("No valid shader manifest, compiling everything: " + manifest_path);
+    }
+
+    struct BatchJob {
+        Dolas::ShaderBuildManifestEntry entry;
+        ShaderDefines defines;
+        std::string source_path;
+        std::string output_path;
+    };
+    std::vector<BatchJob> jobs;
+    std::vector<std::string> live_outputs;
+
+    // 引擎运行时会用到的变体：默认为 SM5.0；开启 bindless 纹理时为 SM5.1 + DOLAS_BINDLESS_TEXTURES
+    struct ShaderVariant {
+        const char* output_suffix;
+        const char* shader_model;
+        ShaderDefines defines;
+    };
+    const ShaderVariant variants[] = {
+        { "", "_5_0", {} },
+        { ".bindless", "_5_1", { { "DOLAS_BINDLESS_TEXTURES", "1" } } },
+    };
+
+    const std::string compiler_identity = GetCompilerIdentity();
+    const std::string extension = GetBytecodeExtension();
+    const std::vector<std::string> sources = graph.GetFiles(".hlsl");
+    report.source_count = sources.size();
+    for (const std::string& source : sources) {
+        auto [inferred_target, entry_point] = InferShaderTypeAndEntry(source);
+        const std::string output_stem = source.substr(0, source.size() - std::string(".hlsl").size());
+
+        // 默认（没有 keyword）的变体总是需要，其余只编译材质引用过的组合，而不是声明的全部组合
+        const Dolas::ShaderKeywordDeclaration declaration = Dolas::ShaderKeywordDeclaration::Parse(FileUtils::ReadFileContent((shader_root / source).string()));
+        std::vector<std::vector<std::string>> permutations = { {} };
+        const auto requested = options.requested_keywords.find(source);
+        if (requested != options.requested_keywords.end()) {
+            for (const std::vector<std::string>& keywords : requested->second) {
+                std::vector<std::string> resolved;
+                std::string error;
+                if (!declaration.Resolve(keywords, resolved, &error)) {
+                    // 与运行时一致：报告错误，仍编译每组保留第一个 keyword 的变体
+                    report.keyword_errors.emplace_back(source, error);
+                }
+                if (std::find(permutations.begin(), permutations.end(), resolved) == permutations.end()) {
+                    permutations.push_back(resolved);
+                }
+            }
+        }
+        report.declared_permutation_count += declaration.GetPermutationCount() * std::size(variants);
+
+        for (const std::vector<std::string>& keywords : permutations) {
+            // 产物名中带上小写的 keyword：opaque/opaque_ps.normal_map.bindless.cso
+            std::string keyword_suffix;
+            for (const std::string& keyword : keywords) {
+                keyword_suffix += "." + keyword;
+            }
+            std::transform(keyword_suffix.begin(), keyword_suffix.end(), keyword_suffix.begin(), ::tolower);
+
+            for (const ShaderVariant& variant : variants) {
+                ShaderDefines defines = Dolas::MakeShaderKeywordDefines(keywords);
+                defines.insert(defines.end(), variant.defines.begin(), variant.defines.end());
+
+                Dolas::ShaderBuildManifestEntry entry;
+                entry.source = source;
+                entry.entry_point = entry_point;
+                entry.target = inferred_target.substr(0, inferred_target.size() - 4) + variant.shader_model;
+                entry.defines = Dolas::MakeShaderDefinesString(defines);
+                entry.output = output_stem + keyword_suffix + variant.output_suffix + extension;
+                entry.input_hash = graph.ComputeInputHash(source, Dolas::ComputeShaderVariantSeed(compiler_identity, entry.target, entry.entry_point, entry.defines));
+                live_outputs.push_back(entry.output);
+                ++report.variant_count;
+
+                const std::string output_path = (output_root / entry.output).string();
+                if (!options.force && !manifest.IsStale(entry.output, entry.input_hash) && FileUtils::FileExists(output_path)) {
+                    ++report.up_to_date_count;
+                    continue;
+                }
+                jobs.push_back({ entry, defines, (shader_root / source).string(), output_path });
+            }
+        }
+    }
+
+    // 源文件已经删除的产物：从清单移除并删除文件，避免运行时加载到过期的 bytecode
+    std::vector<std::string> removed_outputs;
+    for (const auto& [output, entry] : manifest.GetEntries()) {
+        if (std::find(live_outputs.begin(), live_outputs.end(), output) == live_outputs.end()) {
+            removed_outputs.push_back(output);
+        }
+    }
+    for (const std::string& output : removed_outputs) {
+        std::filesystem::remove(output_root / output, ec);
+        std::filesystem::remove(output_root / (output + ".refl"), ec);
+        manifest.RemoveEntry(output);
+        ++report.removed_count;
+    }
+    report.scan_time_ms = elapsed_ms(start_time);
+
+    // 编译耗时主要在 D3DCompile / glslangValidator 内部，按文件分发到多个线程。
+    // 慢的文件先开始，减少最后只剩一个线程在跑的拖尾
+    std::stable_sort(jobs.begin(), jobs.end(), [&manifest](const BatchJob& a, const BatchJob& b) {
+        const Dolas::ShaderBuildManifestEntry* previous_a = manifest.FindEntry(a.entry.output);
+        const Dolas::ShaderBuildManifestEntry* previous_b = manifest.FindEntry(b.entry.output);
+        return (previous_a ? previous_a->compile_milliseconds : 0.0) > (previous_b ? previous_b->compile_milliseconds : 0.0);
+    });
+
+    const unsigned int hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned int requested_jobs = options.job_count == 0 ? hardware_threads : options.job_count;
+    report.job_count = static_cast<unsigned int>(std::max<size_t>(1, std::min<size_t>(requested_jobs, jobs.size())));
+
+    std::vector<CompilationResult> results(jobs.size());
+    std::atomic<size_t> next_job{ 0 };
+    std::atomic<size_t> finished_jobs{ 0 };
+    std::mutex output_mutex;
+    auto worker = [&]() {
+        for (size_t job_index = next_job++; job_index < jobs.size(); job_index = next_job++) {
+            const BatchJob& job = jobs[job_index];
+            results[job_index] = CompileShader(job.source_path, job.entry.entry_point, job.entry.target, job.output_path, job.defines);
+            results[job_index].filename = job.entry.output;
+
+            const CompilationResult& result = results[job_index];
+            std::lock_guard<std::mutex> lock(output_mutex);
+            std::cout << "[" << ++finished_jobs << "/" << jobs.size() << "] " << job.entry.output;
+            if (result.success) {
+                std::cout << " yes (" << std::fixed << std::setprecision(2) << result.compilation_time_ms << "ms)" << std::endl;
+            } else {
+                std::cout << " x" << std::endl;
+            }
+        }
+    };
+
+    if (!jobs.empty()) {
+        std::vector<std::thread> threads;
+        for (unsigned int thread_index = 1; thread_index < report.job_count; ++thread_index) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    for (size_t job_index = 0; job_index < jobs.size(); ++job_index) {
+        const CompilationResult& result = results[job_index];
+        report.total_compile_time_ms += result.compilation_time_ms;
+        if (result.success) {
+            Dolas::ShaderBuildManifestEntry entry = jobs[job_index].entry;
+            entry.bytecode_size = result.bytecode_bytes;
+            entry.compile_milliseconds = result.compilation_time_ms;
+            manifest.SetEntry(entry);
+            ++report.compiled_count;
+        } else {
+            // 失败的条目不保留，下次批量编译一定会重试
+            manifest.RemoveEntry(jobs[job_index].entry.output);
+            ++report.failed_count;
+        }
+    }
+    report.results = std::move(results);
+
+    manifest.SetCompilerIdentity(compiler_identity);
+    if (!manifest.Save(manifest_path)) {
+        LOG_ERROR("Failed to write shader manifest: " + manifest_path);
+    }
+    report.wall_time_ms = elapsed_ms(start_time);
+    return report;
+}
+
+void ShaderCompiler::PrintBatchReport(const BatchCompileReport& report) {
+    std::cout << std::endl;
+    std::cout << "Sources: " << report.source_count
+              << ", compiled: " << report.compiled_count
+              << ", up to date: " << report.up_to_date_count
+              << ", failed: " << report.failed_count
+              << ", removed: " << report.removed_count << std::endl;
+    std::cout << "Variants: " << report.variant_count << " referenced by materials of "
+              << report.declared_permutation_count << " declared permutations" << std::endl;
+    std::cout << std::fixed << std::setprecision(2)
+              << "Scan: " << report.scan_time_ms << " ms, wall: " << report.wall_time_ms
+              << " ms, compile (sum): " << report.total_compile_time_ms << " ms on " << report.job_count << " thread(s)";
+    if (report.wall_time_ms > 0.0 && report.total_compile_time_ms > 0.0) {
+        std::cout << ", speedup x" << report.total_compile_time_ms / report.wall_time_ms;
+    }
+    std::cout << std::endl;
+
+    // 最慢的几个文件，优化编译时间时先看这里
+    std::vector<const CompilationResult*> slowest;
+    for (const CompilationResult& result : report.results) {
+        if (result.success) {
+            slowest.push_back(&result);
+        }
+    }
+    std::sort(slowest.begin(), slowest.end(), [](const CompilationResult* a, const CompilationResult* b) {
+        return a->compilation_time_ms > b->compilation_time_ms;
+    });
+    if (slowest.size() > 5) {
+        slowest.resize(5);
+    }
+    if (!slowest.empty()) {
+        std::cout << "Slowest:" << std::endl;
+        for (const CompilationResult* result : slowest) {
+            std::cout << "  " << std::setw(48) << std::left << result->filename << std::right
+                      << std::setw(10) << result->compilation_time_ms << " ms  " << result->bytecode_bytes << " bytes" << std::endl;
+        }
+    }
+
+    for (const auto& [includer, include] : report.missing_includes) {
+        std::cout << "Warning: " << includer << " includes missing file \"" << include << "\"" << std::endl;
+    }
+    for (const auto& [source, error] : report.keyword_errors) {
+        std::cout << "Error: " << source << ": " << error << std::endl;
+    }
+
+    if (report.failed_count > 0) {
+        std::cout << std::endl << "================ Failed Details ================" << std::endl;
+        for (const CompilationResult& result : report.results) {
+            if (!result.success) {
+                std::cout << "File: " << result.filename << " [" << result.shader_model << " " << result.entry_point << "]" << std::endl;
+                std::cout << result.error_message << std::endl;
+                std::cout << "-----------------------------------------------" << std::endl;
+            }
+        }
+    }
+}
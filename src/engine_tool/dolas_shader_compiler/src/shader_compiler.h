@@ -5,6 +5,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <utility>
 
 struct CompilationResult {
     std::string filename;
@@ -14,6 +15,41 @@ struct CompilationResult {
     double compilation_time_ms;
     std::string shader_model;
     std::string entry_point;
+    size_t bytecode_bytes = 0;      // 写入 output_path 的字节数，未指定输出时为 0
+    std::string output_path;
+    std::string reflection_path;    // Windows 下与 bytecode 一起写出的反射文件（output_path + ".refl"）
+};
+
+// 宏定义：(名字, 值)
+using ShaderDefines = std::vector<std::pair<std::string, std::string>>;
+
+// 非交互的批量编译：按 include 依赖图只编译输入发生变化的 shader，多线程并行，
+// bytecode、反射与清单（shader_manifest.txt）写入输出目录。每个 shader 编译引擎运行时会用到的全部变体（默认 / bindless），
+// 声明了 keyword 的 shader 另外只编译材质实际引用的 keyword 组合
+struct BatchCompileOptions {
+    std::string shader_directory;
+    std::string output_directory;
+    unsigned int job_count = 0;     // 0 表示使用全部硬件线程
+    bool force = false;             // 忽略清单，全部重新编译
+    // shader 源文件（相对 shader_directory）-> 各材质请求的 keyword 列表，见 CollectMaterialShaderKeywords
+    std::map<std::string, std::vector<std::vector<std::string>>> requested_keywords;
+};
+
+struct BatchCompileReport {
+    size_t source_count = 0;
+    size_t compiled_count = 0;
+    size_t up_to_date_count = 0;
+    size_t failed_count = 0;
+    size_t removed_count = 0;           // 源文件已删除、从清单中移除的产物
+    size_t variant_count = 0;           // 本次需要的变体（含 bindless），编译的与跳过的之和
+    unsigned long long declared_permutation_count = 0;  // 按 keyword 声明全部展开时的变体数（含 bindless）
+    unsigned int job_count = 0;
+    double scan_time_ms = 0.0;          // 扫描源文件、建立依赖图与计算输入哈希
+    double wall_time_ms = 0.0;
+    double total_compile_time_ms = 0.0; // 各文件 compilation_time_ms 之和，与 wall_time_ms 之比即并行加速比
+    std::vector<CompilationResult> results;  // 本次实际编译的文件
+    std::vector<std::pair<std::string, std::string>> missing_includes;
+    std::vector<std::pair<std::string, std::string>> keyword_errors;   // (shader, 错误)：材质请求了互斥的 keyword
 };
 
 class ShaderCompiler {
@@ -21,8 +57,8 @@ public:
     ShaderCompiler();
     ~ShaderCompiler();
 
-    // 编译单个shader文件
-    CompilationResult CompileShader(const std::string& filepath, const std::string& entry_point = "", const std::string& target = "");
+    // 编译单个shader文件；output_path 非空时把 bytecode 写入该文件（D3D 下同时写出反射）。可在多个线程上同时调用
+    CompilationResult CompileShader(const std::string& filepath, const std::string& entry_point = "", const std::string& target = "", const std::string& output_path = "", const ShaderDefines& defines = {});
     
     // 编译目录下所有shader文件
     std::vector<CompilationResult> CompileAllShaders(const std::string& directory);
@@ -36,18 +72,27 @@ public:
     // 获取编译统计信息
     void PrintCompilationSummary(const std::vector<CompilationResult>& results);
 
+    // 批量编译 options.shader_directory 下所有 .hlsl，跳过清单中输入哈希未变且产物存在的文件
+    BatchCompileReport CompileBatch(const BatchCompileOptions& options);
+    void PrintBatchReport(const BatchCompileReport& report);
+
 private:
     std::string m_include_directory;
     std::map<std::string, std::string> m_shader_targets; // 文件扩展名到目标的映射
     
     // 根据文件名推断shader类型和入口点
     std::pair<std::string, std::string> InferShaderTypeAndEntry(const std::string& filename);
+
+    // 编译器后端与编译选项的标识，参与输入哈希：切换 Debug / Release 或后端时全部产物过期
+    static std::string GetCompilerIdentity();
+    // 产物扩展名：D3D 为 .cso，SPIR-V 为 .spv
+    static std::string GetBytecodeExtension();
     
     // Windows特定的D3D编译实现
 #ifdef _WIN32
-    CompilationResult CompileHLSLShader(const std::string& filepath, const std::string& entry_point, const std::string& target);
+    CompilationResult CompileHLSLShader(const std::string& filepath, const std::string& entry_point, const std::string& target, const std::string& output_path, const ShaderDefines& defines);
 #else
-    CompilationResult CompileHLSLToSpirvShader(const std::string& filepath, const std::string& entry_point, const std::string& target);
+    CompilationResult CompileHLSLToSpirvShader(const std::string& filepath, const std::string& entry_point, const std::string& target, const std::string& output_path, const ShaderDefines& defines);
 #endif
 };
 
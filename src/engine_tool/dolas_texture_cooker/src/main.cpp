@@ -0,0 +1,500 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <objbase.h>
+#include "DirectXTex.h"
+#endif
+
+#include "asset_types/material_asset.h"
+#include "dolas_asset_manager.h"
+#include "dolas_asset_path.h"
+#include "dolas_block_compression.h"
+#include "dolas_cubemap.h"
+#include "dolas_log_system_manager.h"
+#include "dolas_paths.h"
+#include "dolas_texture_cook.h"
+
+using namespace Dolas;
+
+namespace
+{
+    struct CookOptions
+    {
+        Bool high_quality = false;
+        Bool dry_run = false;
+        Bool force = false;
+        Bool cubemap = false;   // 命令行指定的 .hdr 转换为立方体
+        UInt job_count = 0;     // 0 为全部硬件线程
+        std::vector<std::string> asset_paths;
+    };
+
+    // 默认收集的资产：材质引用的 2D 纹理与按立方体使用的 equirect 全景图
+    struct CookAssets
+    {
+        std::map<std::string, TextureCookUsage> textures;
+        std::vector<std::string> cubemaps;
+    };
+
+    struct CookReport
+    {
+        UInt texture_count = 0;
+        UInt up_to_date_count = 0;
+        UInt skipped_count = 0;
+        UInt failed_count = 0;
+        ULongLong source_byte_count = 0;
+        ULongLong cooked_byte_count = 0;
+        Double mip_milliseconds = 0.0;
+        Double encode_milliseconds = 0.0;
+        ULongLong encoded_texel_count = 0;
+    };
+
+    void PrintUsage(const std::string& program_name)
+    {
+        std::cout << "Dolas Texture Cooker - generates mip chains and block-compressed DDS files for textures" << std::endl;
+        std::cout << "Usage:" << std::endl;
+        std::cout << "  " << program_name << " [options]                      # Cook textures referenced by .material files and every .hdr as a cubemap" << std::endl;
+        std::cout << "  " << program_name << " [options] <asset> [asset...]   # Cook logical paths such as _engine/a/b.png (usage from the file name)" << std::endl;
+        std::cout << "Options:" << std::endl;
+        std::cout << "  --jobs <n>          Parallel threads per texture (default: all hardware threads)" << std::endl;
+        std::cout << "  --high-quality      Encode color textures as BC7 instead of BC1 / BC3" << std::endl;
+        std::cout << "  --cubemap           Convert the given equirect .hdr assets to BC6H cubemaps" << std::endl;
+        std::cout << "  --force             Cook even if the cooked file is newer than the source" << std::endl;
+        std::cout << "  --dry-run           Report sizes without writing files" << std::endl;
+    }
+
+    Bool ParseOptions(int argc, char* argv[], CookOptions& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string argument = argv[i];
+            const Bool has_value = i + 1 < argc;
+            if (argument == "--jobs" && has_value)
+            {
+                options.job_count = static_cast<UInt>(std::stoul(argv[++i]));
+            }
+            else if (argument == "--high-quality")
+            {
+                options.high_quality = true;
+            }
+            else if (argument == "--cubemap")
+            {
+                options.cubemap = true;
+            }
+            else if (argument == "--force")
+            {
+                options.force = true;
+            }
+            else if (argument == "--dry-run")
+            {
+                options.dry_run = true;
+            }
+            else if (argument.starts_with("--"))
+            {
+                std::cerr << "Unknown or incomplete option: " << argument << std::endl;
+                return false;
+            }
+            else
+            {
+                options.asset_paths.push_back(argument);
+            }
+        }
+        return true;
+    }
+
+    // 材质的纹理槽位决定烘焙方式，未知槽位按颜色贴图处理
+    TextureCookUsage GetSlotUsage(const std::string& slot_name)
+    {
+        if (slot_name.find("normal") != std::string::npos) return TextureCookUsage::Normal;
+        if (slot_name.find("roughness") != std::string::npos || slot_name.find("metallic") != std::string::npos ||
+            slot_name.find("occlusion") != std::string::npos || slot_name.find("mask") != std::string::npos)
+        {
+            return TextureCookUsage::Mask;
+        }
+        return TextureCookUsage::Albedo;
+    }
+
+    // 命令行直接指定的资产没有材质槽位，按扩展名与文件名推断
+    TextureCookUsage GuessUsage(const std::string& path_string)
+    {
+        std::string lower = path_string;
+        std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (std::filesystem::path(lower).extension() == ".hdr") return TextureCookUsage::HDR;
+        return GetSlotUsage(std::filesystem::path(lower).stem().string());
+    }
+
+    // 没有指定资产时，收集引擎内容目录下 .material 引用的纹理，所有 .hdr 按天空盒的立方体纹理烘焙
+    CookAssets CollectEngineTextureAssets(AssetManager& asset_manager)
+    {
+        CookAssets assets;
+        const std::filesystem::path content_dir{PathUtils::GetEngineContentDir()};
+        std::error_code error;
+        for (auto it = std::filesystem::recursive_directory_iterator(content_dir, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+        {
+            if (!it->is_regular_file())
+            {
+                continue;
+            }
+            const std::string relative_path = std::filesystem::relative(it->path(), content_dir).generic_string();
+            if (relative_path.starts_with("cache/"))
+            {
+                continue;
+            }
+            if (it->path().extension() == ".hdr")
+            {
+                assets.cubemaps.push_back("_engine/" + relative_path);
+            }
+            else if (it->path().extension() == MaterialAssetDesc::kFileSuffix)
+            {
+                const auto material_path = AssetPath::Parse("_engine/" + relative_path);
+                if (!material_path)
+                {
+                    continue;
+                }
+                const auto load_result = asset_manager.LoadAsset<MaterialAssetDesc>(*material_path);
+                if (!load_result)
+                {
+                    continue;
+                }
+                for (const auto& [slot_name, texture] : load_result.GetAsset()->pixel_shader_texture)
+                {
+                    const std::string& texture_path = texture.GetPath().GetCanonicalPath();
+                    if (!texture_path.ends_with(".dds"))
+                    {
+                        assets.textures.emplace(texture_path, GetSlotUsage(slot_name));
+                    }
+                }
+            }
+        }
+        std::sort(assets.cubemaps.begin(), assets.cubemaps.end());
+        return assets;
+    }
+
+    Bool LoadSourceImage(const std::filesystem::path& file_path, TextureImage& out_image)
+    {
+#ifdef _WIN32
+        DirectX::ScratchImage loaded;
+        const std::wstring file_path_w = file_path.wstring();
+        HRESULT result = S_OK;
+        if (file_path.extension() == ".hdr")
+        {
+            result = DirectX::LoadFromHDRFile(file_path_w.c_str(), nullptr, loaded);
+        }
+        else
+        {
+            // 与运行时一致：WIC 按原始字节读取，sRGB 编码的值不做转换
+            result = DirectX::LoadFromWICFile(file_path_w.c_str(), DirectX::WIC_FLAGS_IGNORE_SRGB, nullptr, loaded);
+        }
+        if (FAILED(result))
+        {
+            return false;
+        }
+
+        DirectX::ScratchImage converted;
+        const DirectX::Image* image = loaded.GetImage(0, 0, 0);
+        if (image->format != DXGI_FORMAT_R32G32B32A32_FLOAT)
+        {
+            if (FAILED(DirectX::Convert(*image, DXGI_FORMAT_R32G32B32A32_FLOAT, DirectX::TEX_FILTER_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, converted)))
+            {
+                return false;
+            }
+            image = converted.GetImage(0, 0, 0);
+        }
+
+        out_image.Resize(static_cast<UInt>(image->width), static_cast<UInt>(image->height));
+        for (UInt y = 0; y < out_image.height; ++y)
+        {
+            const Float* row = reinterpret_cast<const Float*>(image->pixels + image->rowPitch * y);
+            std::copy_n(row, static_cast<std::size_t>(out_image.width) * 4, out_image.GetPixel(0, y));
+        }
+        return true;
+#else
+        // 没有 WIC，只能读取 Radiance HDR
+        return file_path.extension() == ".hdr" && LoadRadianceHDRFile(file_path, out_image);
+#endif
+    }
+
+    // 每次调用启动 job_count - 1 个线程，加上当前线程按小段领取任务；一张纹理的每级 mip 只调用两次，线程启动的开销可以忽略
+    TextureCookParallelFor MakeParallelFor(UInt job_count)
+    {
+        return [job_count](UInt count, const std::function<void(UInt, UInt)>& task)
+        {
+            const UInt chunk_size = std::max(1u, count / (job_count * 4));
+            const UInt thread_count = std::min(job_count, (count + chunk_size - 1) / chunk_size);
+            std::atomic<UInt> next_begin{ 0 };
+            auto worker = [&]()
+            {
+                for (UInt begin = next_begin.fetch_add(chunk_size); begin < count; begin = next_begin.fetch_add(chunk_size))
+                {
+                    task(begin, std::min(count, begin + chunk_size));
+                }
+            };
+
+            std::vector<std::thread> threads;
+            for (UInt thread_index = 1; thread_index < thread_count; ++thread_index)
+            {
+                threads.emplace_back(worker);
+            }
+            worker();
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+        };
+    }
+
+    Bool CookTextureAsset(const std::string& path_string, TextureCookUsage usage, const CookOptions& options, const TextureCookParallelFor& parallel_for, CookReport& report)
+    {
+        const auto asset_path = AssetPath::Parse(path_string);
+        if (!asset_path)
+        {
+            std::cerr << "Invalid asset path: " << path_string << std::endl;
+            return false;
+        }
+        const auto source_path = PathUtils::ResolveAssetPath(*asset_path);
+        if (!source_path || !std::filesystem::exists(*source_path))
+        {
+            std::cerr << "Texture not found: " << path_string << std::endl;
+            return false;
+        }
+
+        const std::filesystem::path cooked_path = PathUtils::GetCookedTexturePath(*asset_path);
+        std::error_code error;
+        const auto cooked_time = std::filesystem::last_write_time(cooked_path, error);
+        if (!options.force && !error && cooked_time >= std::filesystem::last_write_time(*source_path, error) && !error)
+        {
+            std::cout << "  fresh  " << path_string << std::endl;
+            ++report.up_to_date_count;
+            return true;
+        }
+
+        TextureImage image;
+        if (!LoadSourceImage(*source_path, image))
+        {
+#ifdef _WIN32
+            std::cerr << "Failed to decode " << path_string << std::endl;
+            return false;
+#else
+            std::cout << "  skip   " << path_string << " (only .hdr can be decoded on this platform)" << std::endl;
+            ++report.skipped_count;
+            return true;
+#endif
+        }
+
+        TextureCookSettings settings;
+        settings.usage = usage;
+        settings.high_quality = options.high_quality;
+        CookedTexture cooked;
+        if (!CookTexture(image, settings, cooked, parallel_for))
+        {
+            std::cerr << "Failed to cook " << path_string << std::endl;
+            return false;
+        }
+
+        // 未压缩时运行时的占用：PNG 按 R8G8B8A8 加载且没有 mip，HDR 按 R32G32B32A32_FLOAT 加载
+        const ULongLong source_bytes = static_cast<ULongLong>(image.width) * image.height * (usage == TextureCookUsage::HDR ? 16 : 4);
+        const ULongLong cooked_bytes = cooked.GetByteSize();
+        const Double encode_mpix = cooked.encode_milliseconds > 0.0 ? cooked.encoded_texel_count / (cooked.encode_milliseconds * 1000.0) : 0.0;
+
+        char line[512];
+        std::snprintf(line, sizeof(line), "  cook   %s  %s %s %ux%u  %zu mips", path_string.c_str(), GetTextureCookUsageName(usage),
+            GetBlockFormatName(cooked.format), cooked.width, cooked.height, cooked.mips.size());
+        std::cout << line << std::endl;
+        std::snprintf(line, sizeof(line), "         %llu -> %llu bytes (%.1f%%)  mips %.1f ms  encode %.1f ms (%.1f MPix/s)",
+            source_bytes, cooked_bytes, 100.0 * cooked_bytes / source_bytes, cooked.mip_milliseconds, cooked.encode_milliseconds, encode_mpix);
+        std::cout << line << std::endl;
+
+        ++report.texture_count;
+        report.source_byte_count += source_bytes;
+        report.cooked_byte_count += cooked_bytes;
+        report.mip_milliseconds += cooked.mip_milliseconds;
+        report.encode_milliseconds += cooked.encode_milliseconds;
+        report.encoded_texel_count += cooked.encoded_texel_count;
+
+        if (!options.dry_run && !SaveCookedTextureDDS(cooked, cooked_path))
+        {
+            std::cerr << "Failed to save " << cooked_path.generic_string() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    Bool CookCubemapAsset(const std::string& path_string, const CookOptions& options, const TextureCookParallelFor& parallel_for, CookReport& report)
+    {
+        const auto asset_path = AssetPath::Parse(path_string);
+        if (!asset_path)
+        {
+            std::cerr << "Invalid asset path: " << path_string << std::endl;
+            return false;
+        }
+        const auto source_path = PathUtils::ResolveAssetPath(*asset_path);
+        if (!source_path || !std::filesystem::exists(*source_path))
+        {
+            std::cerr << "Texture not found: " << path_string << std::endl;
+            return false;
+        }
+
+        const std::filesystem::path cooked_path = PathUtils::GetCookedCubemapPath(*asset_path);
+        std::error_code error;
+        const auto cooked_time = std::filesystem::last_write_time(cooked_path, error);
+        if (!options.force && !error && cooked_time >= std::filesystem::last_write_time(*source_path, error) && !error)
+        {
+            std::cout << "  fresh  " << path_string << " (cubemap)" << std::endl;
+            ++report.up_to_date_count;
+            return true;
+        }
+
+        TextureImage equirect;
+        if (source_path->extension() != ".hdr" || !LoadSourceImage(*source_path, equirect))
+        {
+            std::cerr << "Failed to decode " << path_string << std::endl;
+            return false;
+        }
+
+        const auto convert_start_time = std::chrono::high_resolution_clock::now();
+        Cubemap cubemap;
+        CookedTexture cooked;
+        if (!BuildCubemapFromEquirect(equirect, CubemapBuildSettings(), cubemap, parallel_for))
+        {
+            std::cerr << "Failed to convert " << path_string << std::endl;
+            return false;
+        }
+        const Double convert_milliseconds = std::chrono::duration<Double, std::milli>(std::chrono::high_resolution_clock::now() - convert_start_time).count();
+        if (!CookCubemap(cubemap, cooked, parallel_for))
+        {
+            std::cerr << "Failed to cook " << path_string << std::endl;
+            return false;
+        }
+        cooked.mip_milliseconds = convert_milliseconds;
+
+        // 对比原来直接采样的 R32G32B32A32_FLOAT equirect（没有 mip）
+        const ULongLong source_bytes = static_cast<ULongLong>(equirect.width) * equirect.height * 16;
+        const ULongLong cooked_bytes = cooked.GetByteSize();
+        const Double encode_mpix = cooked.encode_milliseconds > 0.0 ? cooked.encoded_texel_count / (cooked.encode_milliseconds * 1000.0) : 0.0;
+
+        char line[512];
+        std::snprintf(line, sizeof(line), "  cook   %s  Cubemap %s 6x%ux%u  %u mips", path_string.c_str(),
+            GetBlockFormatName(cooked.format), cooked.width, cooked.height, cooked.GetMipCount());
+        std::cout << line << std::endl;
+        std::snprintf(line, sizeof(line), "         %llu -> %llu bytes (%.1f%%)  convert %.1f ms  encode %.1f ms (%.1f MPix/s)",
+            source_bytes, cooked_bytes, 100.0 * cooked_bytes / source_bytes, convert_milliseconds, cooked.encode_milliseconds, encode_mpix);
+        std::cout << line << std::endl;
+
+        ++report.texture_count;
+        report.source_byte_count += source_bytes;
+        report.cooked_byte_count += cooked_bytes;
+        report.mip_milliseconds += cooked.mip_milliseconds;
+        report.encode_milliseconds += cooked.encode_milliseconds;
+        report.encoded_texel_count += cooked.encoded_texel_count;
+
+        if (!options.dry_run && !SaveCookedTextureDDS(cooked, cooked_path))
+        {
+            std::cerr << "Failed to save " << cooked_path.generic_string() << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    const char* GetPathName(BlockCompressionPath path)
+    {
+        switch (path)
+        {
+        case BlockCompressionPath::AVX: return "AVX";
+        case BlockCompressionPath::SSE: return "SSE";
+        case BlockCompressionPath::Scalar:
+        default: return "scalar";
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Dolas::LogSystemManager::GetInstance().Initialize();
+
+    if (argc > 1 && (std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h"))
+    {
+        PrintUsage(argv[0]);
+        return 0;
+    }
+
+    CookOptions options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+#ifdef _WIN32
+    CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif
+
+    AssetManager asset_manager;
+    asset_manager.Initialize();
+
+    CookAssets assets;
+    if (options.asset_paths.empty())
+    {
+        assets = CollectEngineTextureAssets(asset_manager);
+    }
+    else
+    {
+        for (const std::string& asset_path : options.asset_paths)
+        {
+            const TextureCookUsage usage = GuessUsage(asset_path);
+            if (options.cubemap && usage == TextureCookUsage::HDR)
+            {
+                assets.cubemaps.push_back(asset_path);
+            }
+            else
+            {
+                assets.textures.emplace(asset_path, usage);
+            }
+        }
+    }
+
+    const UInt hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    const UInt job_count = options.job_count == 0 ? hardware_threads : options.job_count;
+    const TextureCookParallelFor parallel_for = MakeParallelFor(job_count);
+
+    CookReport report;
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    for (const auto& [asset_path, usage] : assets.textures)
+    {
+        if (!CookTextureAsset(asset_path, usage, options, parallel_for, report))
+        {
+            ++report.failed_count;
+        }
+    }
+    for (const std::string& asset_path : assets.cubemaps)
+    {
+        if (!CookCubemapAsset(asset_path, options, parallel_for, report))
+        {
+            ++report.failed_count;
+        }
+    }
+    const Double total_milliseconds = std::chrono::duration<Double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+    std::cout << std::endl;
+    std::cout << "Cooked " << report.texture_count << " textures, up to date " << report.up_to_date_count
+              << ", skipped " << report.skipped_count << ", failed " << report.failed_count << std::endl;
+    if (report.texture_count > 0)
+    {
+        char line[256];
+        std::snprintf(line, sizeof(line), "Bytes %llu -> %llu (%.1f%%), mips %.1f ms, encode %.1f ms (%.1f MPix/s, %s, %u threads), total %.1f ms",
+            report.source_byte_count, report.cooked_byte_count, 100.0 * report.cooked_byte_count / report.source_byte_count,
+            report.mip_milliseconds, report.encode_milliseconds,
+            report.encode_milliseconds > 0.0 ? report.encoded_texel_count / (report.encode_milliseconds * 1000.0) : 0.0,
+            GetPathName(GetBlockCompressionPath()), job_count, total_milliseconds);
+        std::cout << line << std::endl;
+    }
+    return report.failed_count == 0 ? 0 : 1;
+}